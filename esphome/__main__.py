@@ -15,6 +15,7 @@ from esphome.const import (
     CONF_BAUD_RATE,
     CONF_BROKER,
     CONF_DEASSERT_RTS_DTR,
+    CONF_DEFERRED_FORMAT,
     CONF_LOGGER,
     CONF_NAME,
     CONF_OTA,
@@ -25,6 +26,7 @@ from esphome.const import (
     CONF_PORT,
     CONF_ESPHOME,
     CONF_PLATFORMIO_OPTIONS,
+    CONF_STATIC_ALLOCATION,
     CONF_SUBSTITUTIONS,
     PLATFORM_BK72XX,
     PLATFORM_RTL87XX,
@@ -124,6 +126,11 @@ def run_miniterm(config, port):
     _LOGGER.info("Starting log output from %s with baud rate %s", port, baud_rate)
 
     backtrace_state = False
+    decode_deferred = None
+    if config["logger"].get(CONF_DEFERRED_FORMAT):
+        from esphome import log_decoder
+
+        decode_deferred = log_decoder.load_elf_decoder(config)
     ser = serial.Serial()
     ser.baudrate = baud_rate
     ser.port = port
@@ -149,6 +156,8 @@ def run_miniterm(config, port):
                         .replace(b"\n", b"")
                         .decode("utf8", "backslashreplace")
                     )
+                    if decode_deferred is not None:
+                        line = decode_deferred(line) or line
                     time_str = datetime.now().time().strftime("[%H:%M:%S]")
                     message = time_str + line
                     safe_print(message)
@@ -217,7 +226,11 @@ def compile_program(args, config):
     if rc != 0:
         return rc
     idedata = platformio_api.get_idedata(config)
-    return 0 if idedata is not None else 1
+    if idedata is None:
+        return 1
+    if config[CONF_ESPHOME][CONF_STATIC_ALLOCATION]:
+        platformio_api.report_static_allocation(idedata)
+    return 0
 
 
 def upload_using_esptool(config, port, file):
@@ -527,23 +540,26 @@ def command_update_all(args):
         half_line = "=" * ((twidth - width) // 2)
         click.echo(f"{half_line}{middle_text}{half_line}")
 
-    for f in files:
-        print(f"Updating {color(Fore.CYAN, f)}")
-        print("-" * twidth)
-        print()
-        rc = run_external_process(
-            "esphome", "--dashboard", "run", f, "--no-logs", "--device", "OTA"
-        )
-        if rc == 0:
-            print_bar(f"[{color(Fore.BOLD_GREEN, 'SUCCESS')}] {f}")
-            success[f] = True
-        else:
-            print_bar(f"[{color(Fore.BOLD_RED, 'ERROR')}] {f}")
-            success[f] = False
+    if args.jobs > 1:
+        update_all_parallel(files, args.jobs, success, print_bar)
+    else:
+        for f in files:
+            print(f"Updating {color(Fore.CYAN, f)}")
+            print("-" * twidth)
+            print()
+            rc = run_external_process(
+                "esphome", "--dashboard", "run", f, "--no-logs", "--device", "OTA"
+            )
+            if rc == 0:
+                print_bar(f"[{color(Fore.BOLD_GREEN, 'SUCCESS')}] {f}")
+                success[f] = True
+            else:
+                print_bar(f"[{color(Fore.BOLD_RED, 'ERROR')}] {f}")
+                success[f] = False
 
-        print()
-        print()
-        print()
+            print()
+            print()
+            print()
 
     print_bar(f"[{color(Fore.BOLD_WHITE, 'SUMMARY')}]")
     failed = 0
@@ -556,6 +572,61 @@ def command_update_all(args):
     return failed
 
 
+def update_all_parallel(files, jobs, success, print_bar):
+    """Compile every configuration in turn, then upload to up to `jobs` devices at once.
+
+    Compilation stays sequential as it is CPU bound and shares the PlatformIO cache,
+    uploads are network bound and spend most of their time waiting on the devices.
+    """
+    from concurrent.futures import ThreadPoolExecutor, as_completed
+    import hashlib
+    import subprocess
+
+    compiled = {}
+    to_upload = []
+    for f in files:
+        with open(f, "rb") as config_file:
+            digest = hashlib.sha256(config_file.read()).hexdigest()
+        if digest not in compiled:
+            print(f"Compiling {color(Fore.CYAN, f)}")
+            compiled[digest] = (
+                run_external_process("esphome", "--dashboard", "compile", f) == 0
+            )
+        if compiled[digest]:
+            to_upload.append(f)
+        else:
+            print_bar(f"[{color(Fore.BOLD_RED, 'ERROR')}] {f}")
+            success[f] = False
+
+    def upload(f):
+        start = time.perf_counter()
+        # Output is collected so that concurrent uploads don't interleave
+        proc = subprocess.run(
+            ["esphome", "--dashboard", "upload", f, "--device", "OTA"],
+            stdout=subprocess.PIPE,
+            stderr=subprocess.STDOUT,
+            encoding="utf-8",
+            check=False,
+        )
+        return proc.returncode, proc.stdout, time.perf_counter() - start
+
+    print(f"Uploading to {len(to_upload)} devices, {jobs} at a time")
+    with ThreadPoolExecutor(max_workers=jobs) as executor:
+        futures = {executor.submit(upload, f): f for f in to_upload}
+        for future in as_completed(futures):
+            f = futures[future]
+            rc, output, duration = future.result()
+            safe_print(output)
+            success[f] = rc == 0
+            result = (
+                color(Fore.BOLD_GREEN, "SUCCESS")
+                if rc == 0
+                else color(Fore.BOLD_RED, "ERROR")
+            )
+            print_bar(f"[{result}] {f} ({duration:.1f}s)")
+            print()
+
+
 def command_idedata(args, config):
     from esphome import platformio_api
     import json
@@ -875,6 +946,12 @@ def parse_args(argv):
     parser_update.add_argument(
         "configuration", help="Your YAML configuration file directories.", nargs="+"
     )
+    parser_update.add_argument(
+        "--jobs",
+        help="Compile all configurations first, then upload to this many devices at once.",
+        type=int,
+        default=1,
+    )
 
     parser_idedata = subparsers.add_parser("idedata")
     parser_idedata.add_argument(
@@ -160,7 +160,10 @@ async def not_condition_to_code(config, condition_id, template_arg, args):
 
 @register_condition("lambda", LambdaCondition, cv.returning_lambda)
 async def lambda_condition_to_code(config, condition_id, template_arg, args):
-    lambda_ = await cg.process_lambda(config, args, return_type=bool)
+    capture = await cg.lambda_capture(config)
+    lambda_ = await cg.process_lambda(
+        config, args, capture=capture, return_type=bool
+    )
     return cg.new_Pvariable(condition_id, template_arg, lambda_)
 
 
@@ -285,7 +288,10 @@ async def wait_until_action_to_code(config, action_id, template_arg, args):
 
 @register_action("lambda", LambdaAction, cv.lambda_)
 async def lambda_action_to_code(config, action_id, template_arg, args):
-    lambda_ = await cg.process_lambda(config, args, return_type=cg.void)
+    capture = await cg.lambda_capture(config)
+    lambda_ = await cg.process_lambda(
+        config, args, capture=capture, return_type=cg.void
+    )
     return cg.new_Pvariable(action_id, template_arg, lambda_)
 
 
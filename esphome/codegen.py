@@ -35,6 +35,7 @@ from esphome.cpp_generator import (  # noqa
     get_variable,
     get_variable_with_full_id,
     process_lambda,
+    lambda_capture,
     is_template,
     templatable,
     MockObj,
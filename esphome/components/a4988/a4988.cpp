@@ -1,11 +1,149 @@
 #include "a4988.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace a4988 {
 
 static const char *const TAG = "a4988.stepper";
 
+#ifdef USE_ESP32
+/// Timer clock of 10MHz from the 80MHz APB clock
+static const uint32_t TIMER_DIVIDER = 8;
+static const uint32_t TIMER_TICKS_PER_SECOND = 10000000;
+/// Fastest speed the timer generates, the interrupt itself takes a few µs
+static const float TIMER_MAX_SPEED = 50000.0f;
+/// Minimum high time of the step pulse, the A4988 needs 1µs
+static const uint32_t STEP_PULSE_US = 2;
+/// Time between setting the direction and the first step
+static const uint32_t DIR_SETUP_TICKS = TIMER_TICKS_PER_SECOND / 20000;
+
+/// Timers that are free to use, the Arduino framework hands out timer 0 of group 0 first (ac_dimmer uses it)
+static const struct {
+  timer_group_t group;
+  timer_idx_t index;
+} STEP_TIMERS[] = {
+    {TIMER_GROUP_1, TIMER_0},
+#if SOC_TIMER_GROUP_TIMERS_PER_GROUP > 1
+    {TIMER_GROUP_1, TIMER_1},
+    {TIMER_GROUP_0, TIMER_1},
+#endif
+};
+static uint8_t next_step_timer = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static uint32_t IRAM_ATTR isqrt(uint64_t value) {
+  uint64_t result = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > value)
+    bit >>= 2;
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return static_cast<uint32_t>(result);
+}
+
+bool IRAM_ATTR A4988TimerStore::timer_intr(void *arg) {
+  auto *store = static_cast<A4988TimerStore *>(arg);
+  const uint32_t start = micros();
+  store->step_pin.digital_write(true);
+  store->position = store->position + store->direction;
+
+  // steps left in the current direction, negative if the target moved behind the motor
+  const int32_t remaining = (store->target - store->position) * store->direction;
+  uint64_t speed_squared = store->speed_squared;
+  bool stop = false;
+  if (remaining > 0 && static_cast<uint64_t>(remaining) > speed_squared / store->deceleration) {
+    if (store->max_speed_squared - speed_squared <= store->acceleration) {
+      speed_squared = store->max_speed_squared;
+    } else {
+      speed_squared += store->acceleration;
+    }
+  } else if (remaining > 0) {
+    // keep going at the speed of one step from standstill until the target is reached
+    speed_squared = speed_squared > 2 * store->deceleration ? speed_squared - store->deceleration : store->deceleration;
+  } else if (remaining == 0 || speed_squared <= store->deceleration) {
+    stop = true;
+  } else {
+    // brake before the loop reverses the direction
+    speed_squared -= store->deceleration;
+  }
+
+  if (stop) {
+    store->speed_squared = 0;
+    timer_group_set_counter_enable_in_isr(store->timer_group, store->timer_index, TIMER_PAUSE);
+    store->running = false;
+  } else {
+    store->speed_squared = speed_squared;
+    // the speed is in 1/256 steps/s
+    const uint32_t speed = std::max<uint32_t>(isqrt(speed_squared), 1);
+    timer_group_set_alarm_value_in_isr(store->timer_group, store->timer_index,
+                                       (uint64_t(TIMER_TICKS_PER_SECOND) << 8) / speed);
+  }
+
+  while (micros() - start < STEP_PULSE_US) {
+  }
+  store->step_pin.digital_write(false);
+  return false;
+}
+
+bool A4988::setup_timer_() {
+  if (next_step_timer >= sizeof(STEP_TIMERS) / sizeof(STEP_TIMERS[0])) {
+    ESP_LOGE(TAG, "No hardware timer left for the step generation");
+    return false;
+  }
+  this->store_.timer_group = STEP_TIMERS[next_step_timer].group;
+  this->store_.timer_index = STEP_TIMERS[next_step_timer].index;
+  next_step_timer++;
+  this->store_.step_pin = static_cast<InternalGPIOPin *>(this->step_pin_)->to_isr();
+
+  timer_config_t config = {};
+  config.alarm_en = TIMER_ALARM_EN;
+  config.counter_en = TIMER_PAUSE;
+  config.intr_type = TIMER_INTR_LEVEL;
+  config.counter_dir = TIMER_COUNT_UP;
+  config.auto_reload = TIMER_AUTORELOAD_EN;
+  config.divider = TIMER_DIVIDER;
+  if (timer_init(this->store_.timer_group, this->store_.timer_index, &config) != ESP_OK ||
+      timer_isr_callback_add(this->store_.timer_group, this->store_.timer_index, &A4988TimerStore::timer_intr,
+                             &this->store_, 0) != ESP_OK) {
+    ESP_LOGE(TAG, "Setting up the hardware timer failed");
+    return false;
+  }
+  return true;
+}
+
+void A4988::loop_timer_() {
+  // in (1/256 steps/s)^2, a constant acceleration changes the squared speed by twice its value per step
+  this->store_.acceleration = std::max<uint64_t>(static_cast<uint64_t>(2.0f * this->acceleration_ * 65536.0f), 1);
+  this->store_.deceleration = std::max<uint64_t>(static_cast<uint64_t>(2.0f * this->deceleration_ * 65536.0f), 1);
+  const float max_speed = std::min(this->max_speed_, TIMER_MAX_SPEED);
+  this->store_.max_speed_squared = static_cast<uint64_t>(max_speed * max_speed * 65536.0f);
+
+  if (this->current_position != this->timer_position_)
+    this->store_.position = this->current_position;
+  this->store_.target = this->target_position;
+
+  if (!this->store_.running && this->store_.position != this->store_.target) {
+    this->store_.direction = this->store_.target > this->store_.position ? 1 : -1;
+    this->dir_pin_->digital_write(this->store_.direction == 1);
+    this->store_.speed_squared = 0;
+    this->store_.running = true;
+    timer_set_counter_value(this->store_.timer_group, this->store_.timer_index, 0);
+    timer_set_alarm_value(this->store_.timer_group, this->store_.timer_index, DIR_SETUP_TICKS);
+    timer_start(this->store_.timer_group, this->store_.timer_index);
+  }
+
+  this->current_position = this->timer_position_ = this->store_.position;
+}
+#endif
+
 void A4988::setup() {
   ESP_LOGCONFIG(TAG, "Setting up A4988...");
   if (this->sleep_pin_ != nullptr) {
@@ -17,16 +155,29 @@ void A4988::setup() {
   this->step_pin_->digital_write(false);
   this->dir_pin_->setup();
   this->dir_pin_->digital_write(false);
+#ifdef USE_ESP32
+  if (this->hardware_timer_ && !this->setup_timer_())
+    this->mark_failed();
+#endif
 }
 void A4988::dump_config() {
   ESP_LOGCONFIG(TAG, "A4988:");
   LOG_PIN("  Step Pin: ", this->step_pin_);
   LOG_PIN("  Dir Pin: ", this->dir_pin_);
   LOG_PIN("  Sleep Pin: ", this->sleep_pin_);
+#ifdef USE_ESP32
+  if (this->hardware_timer_) {
+    ESP_LOGCONFIG(TAG, "  Hardware Timer: group %d, timer %d", this->store_.timer_group, this->store_.timer_index);
+  }
+#endif
   LOG_STEPPER(this);
 }
 void A4988::loop() {
   bool at_target = this->has_reached_target();
+#ifdef USE_ESP32
+  if (this->hardware_timer_)
+    at_target = at_target && !this->store_.running;
+#endif
   if (this->sleep_pin_ != nullptr) {
     bool sleep_rising_edge = !sleep_pin_state_ & !at_target;
     this->sleep_pin_->digital_write(!at_target);
@@ -35,6 +186,12 @@ void A4988::loop() {
       delayMicroseconds(1000);
     }
   }
+#ifdef USE_ESP32
+  if (this->hardware_timer_) {
+    this->loop_timer_();
+    return;
+  }
+#endif
   if (at_target) {
     this->high_freq_.stop();
   } else {
@@ -4,14 +4,48 @@
 #include "esphome/core/hal.h"
 #include "esphome/components/stepper/stepper.h"
 
+#ifdef USE_ESP32
+#include <driver/timer.h>
+#endif
+
 namespace esphome {
 namespace a4988 {
 
+#ifdef USE_ESP32
+/** Steps generated by a hardware timer instead of the loop.
+ *
+ * Each timer interrupt does one step and sets the alarm for the next one from the speed, which changes by the
+ * acceleration or deceleration on every step. The speed is kept squared in 1/256 steps/s, so that a constant
+ * acceleration is a constant addition per step and the interrupt doesn't need any floating point math.
+ */
+struct A4988TimerStore {
+  ISRInternalGPIOPin step_pin;
+  timer_group_t timer_group;
+  timer_idx_t timer_index;
+
+  volatile int32_t position{0};
+  volatile int32_t target{0};
+  volatile bool running{false};
+  int32_t direction{1};
+  uint64_t speed_squared{0};
+  /// Change of speed_squared per step
+  uint64_t acceleration{0};
+  uint64_t deceleration{0};
+  uint64_t max_speed_squared{0};
+
+  static bool timer_intr(void *arg);
+};
+#endif
+
 class A4988 : public stepper::Stepper, public Component {
  public:
   void set_step_pin(GPIOPin *step_pin) { step_pin_ = step_pin; }
   void set_dir_pin(GPIOPin *dir_pin) { dir_pin_ = dir_pin; }
   void set_sleep_pin(GPIOPin *sleep_pin) { this->sleep_pin_ = sleep_pin; }
+#ifdef USE_ESP32
+  /// Generate the steps with a hardware timer, the step pin has to be an internal pin.
+  void set_hardware_timer(bool hardware_timer) { this->hardware_timer_ = hardware_timer; }
+#endif
   void setup() override;
   void dump_config() override;
   void loop() override;
@@ -23,6 +57,16 @@ class A4988 : public stepper::Stepper, public Component {
   GPIOPin *sleep_pin_{nullptr};
   bool sleep_pin_state_;
   HighFrequencyLoopRequester high_freq_;
+
+#ifdef USE_ESP32
+  bool setup_timer_();
+  void loop_timer_();
+
+  bool hardware_timer_{false};
+  A4988TimerStore store_;
+  /// current_position when the loop last synced it with the timer, a difference means report_position() was called
+  int32_t timer_position_{0};
+#endif
 };
 
 }  // namespace a4988
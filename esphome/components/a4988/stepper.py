@@ -3,19 +3,41 @@ from esphome.components import stepper
 import esphome.config_validation as cv
 import esphome.codegen as cg
 from esphome.const import CONF_DIR_PIN, CONF_ID, CONF_SLEEP_PIN, CONF_STEP_PIN
+from esphome.core import CORE
 
 
 a4988_ns = cg.esphome_ns.namespace("a4988")
 A4988 = a4988_ns.class_("A4988", stepper.Stepper, cg.Component)
 
-CONFIG_SCHEMA = stepper.STEPPER_SCHEMA.extend(
-    {
-        cv.Required(CONF_ID): cv.declare_id(A4988),
-        cv.Required(CONF_STEP_PIN): pins.gpio_output_pin_schema,
-        cv.Required(CONF_DIR_PIN): pins.gpio_output_pin_schema,
-        cv.Optional(CONF_SLEEP_PIN): pins.gpio_output_pin_schema,
-    }
-).extend(cv.COMPONENT_SCHEMA)
+CONF_HARDWARE_TIMER = "hardware_timer"
+
+
+def _validate_hardware_timer(config):
+    # The step pin is driven from the timer interrupt, pins of port expanders can't be
+    if config.get(CONF_HARDWARE_TIMER, False) and any(
+        platform in config[CONF_STEP_PIN]
+        for platform in pins.PIN_SCHEMA_REGISTRY
+        if platform != CORE.target_platform
+    ):
+        raise cv.Invalid(
+            f"{CONF_STEP_PIN} must be an internal pin with {CONF_HARDWARE_TIMER}",
+            path=[CONF_STEP_PIN],
+        )
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    stepper.STEPPER_SCHEMA.extend(
+        {
+            cv.Required(CONF_ID): cv.declare_id(A4988),
+            cv.Required(CONF_STEP_PIN): pins.gpio_output_pin_schema,
+            cv.Required(CONF_DIR_PIN): pins.gpio_output_pin_schema,
+            cv.Optional(CONF_SLEEP_PIN): pins.gpio_output_pin_schema,
+            cv.Optional(CONF_HARDWARE_TIMER): cv.All(cv.boolean, cv.only_on_esp32),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    _validate_hardware_timer,
+)
 
 
 async def to_code(config):
@@ -31,3 +53,6 @@ async def to_code(config):
     if sleep_pin_config := config.get(CONF_SLEEP_PIN):
         sleep_pin = await cg.gpio_pin_expression(sleep_pin_config)
         cg.add(var.set_sleep_pin(sleep_pin))
+
+    if CONF_HARDWARE_TIMER in config:
+        cg.add(var.set_hardware_timer(config[CONF_HARDWARE_TIMER]))
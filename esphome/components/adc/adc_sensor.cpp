@@ -39,6 +39,15 @@ static const int ADC_MAX = (1 << SOC_ADC_RTC_MAX_BITWIDTH) - 1;    // 4095 (12 b
 static const int ADC_HALF = (1 << SOC_ADC_RTC_MAX_BITWIDTH) >> 1;  // 2048 (12 bit) or 4096 (13 bit)
 #endif
 
+#ifdef USE_ADC_SENSOR_CONTINUOUS
+#if defined(USE_ESP32_VARIANT_ESP32) || defined(USE_ESP32_VARIANT_ESP32S2)
+#define ADC_CONTINUOUS_FORMAT_TYPE1
+#endif
+// Bytes the DMA collects per interrupt and the ring buffer the driver keeps them in until loop() reads them
+static const uint32_t ADC_CONTINUOUS_READ_SIZE = 256;
+static const uint32_t ADC_CONTINUOUS_STORE_SIZE = 4096;
+#endif
+
 #ifdef USE_RP2040
 extern "C"
 #endif
@@ -82,6 +91,13 @@ extern "C"
 
 #endif  // USE_ESP32
 
+#ifdef USE_ADC_SENSOR_CONTINUOUS
+  if (this->sample_rate_ != 0 && !this->setup_continuous_()) {
+    this->mark_failed();
+    return;
+  }
+#endif
+
 #ifdef USE_RP2040
   static bool initialized = false;
   if (!initialized) {
@@ -127,6 +143,12 @@ void ADCSensor::dump_config() {
   }
 #endif  // USE_ESP32
 
+#ifdef USE_ADC_SENSOR_CONTINUOUS
+  if (this->sample_rate_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Continuous Sample Rate: %u Hz", this->sample_rate_);
+  }
+#endif
+
 #ifdef USE_RP2040
   if (this->is_temperature_) {
     ESP_LOGCONFIG(TAG, "  Pin: Temperature");
@@ -165,6 +187,11 @@ float ADCSensor::sample() {
 
 #ifdef USE_ESP32
 float ADCSensor::sample() {
+#ifdef USE_ADC_SENSOR_CONTINUOUS
+  if (this->sample_rate_ != 0)
+    return this->continuous_mean_;
+#endif
+
   if (!autorange_) {
     int raw = -1;
     if (channel1_ != ADC1_CHANNEL_MAX) {
@@ -240,6 +267,106 @@ float ADCSensor::sample() {
 }
 #endif  // USE_ESP32
 
+#ifdef USE_ADC_SENSOR_CONTINUOUS
+bool ADCSensor::setup_continuous_() {
+  adc_digi_init_config_t init_config = {};
+  init_config.max_store_buf_size = ADC_CONTINUOUS_STORE_SIZE;
+  init_config.conv_num_each_intr = ADC_CONTINUOUS_READ_SIZE;
+  init_config.adc1_chan_mask = 1u << this->channel1_;
+  init_config.adc2_chan_mask = 0;
+  esp_err_t err = adc_digi_initialize(&init_config);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Initializing continuous ADC failed: %s", esp_err_to_name(err));
+    return false;
+  }
+
+  adc_digi_pattern_config_t pattern = {};
+  pattern.atten = this->attenuation_;
+  pattern.channel = this->channel1_;
+  pattern.unit = 0;  // Index of ADC1
+  pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+  adc_digi_configuration_t config = {};
+#ifdef ADC_CONTINUOUS_FORMAT_TYPE1
+  // These chips require a conversion limit
+  config.conv_limit_en = true;
+  config.conv_limit_num = 250;
+  config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+#else
+  config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+#endif
+  config.pattern_num = 1;
+  config.adc_pattern = &pattern;
+  config.sample_freq_hz = this->sample_rate_;
+  config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  err = adc_digi_controller_configure(&config);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Configuring continuous ADC failed: %s", esp_err_to_name(err));
+    return false;
+  }
+
+  err = adc_digi_start();
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Starting continuous ADC failed: %s", esp_err_to_name(err));
+    return false;
+  }
+  return true;
+}
+
+float ADCSensor::raw_to_voltage_(int raw) {
+  if (this->output_raw_)
+    return raw;
+  // The calibration expects the full width of a one-shot reading
+  raw <<= SOC_ADC_RTC_MAX_BITWIDTH - SOC_ADC_DIGI_MAX_BITWIDTH;
+  uint32_t mv = esp_adc_cal_raw_to_voltage(raw, &this->cal_characteristics_[(int32_t) this->attenuation_]);
+  return mv / 1000.0f;
+}
+
+void ADCSensor::loop() {
+  if (this->sample_rate_ == 0)
+    return;
+
+  uint8_t buffer[ADC_CONTINUOUS_READ_SIZE];
+  float samples[ADC_CONTINUOUS_READ_SIZE / SOC_ADC_DIGI_RESULT_BYTES];
+  // Drain what the DMA collected since the last loop, but don't get stuck here if it keeps up with us
+  for (uint32_t i = 0; i < 2 * ADC_CONTINUOUS_STORE_SIZE / ADC_CONTINUOUS_READ_SIZE; i++) {
+    uint32_t length = 0;
+    esp_err_t err = adc_digi_read_bytes(buffer, sizeof(buffer), &length, 0);
+    // ESP_ERR_INVALID_STATE means the driver dropped samples because we read too slowly, the data is still valid
+    if ((err != ESP_OK && err != ESP_ERR_INVALID_STATE) || length == 0)
+      break;
+
+    size_t count = 0;
+    float sum = 0.0f;
+    for (uint32_t offset = 0; offset + SOC_ADC_DIGI_RESULT_BYTES <= length; offset += SOC_ADC_DIGI_RESULT_BYTES) {
+      auto *data = reinterpret_cast<adc_digi_output_data_t *>(&buffer[offset]);
+#ifdef ADC_CONTINUOUS_FORMAT_TYPE1
+      if (data->type1.channel != this->channel1_)
+        continue;
+      const float value = this->raw_to_voltage_(data->type1.data);
+#else
+      if (data->type2.channel != this->channel1_)
+        continue;
+      const float value = this->raw_to_voltage_(data->type2.data);
+#endif
+      samples[count++] = value;
+      sum += value;
+    }
+    if (count == 0)
+      continue;
+    this->continuous_mean_ = sum / count;
+    this->samples_callback_.call(samples, count);
+  }
+}
+
+bool ADCSensor::add_on_samples_callback(std::function<void(const float *samples, size_t count)> &&callback) {
+  if (this->sample_rate_ == 0)
+    return false;
+  this->samples_callback_.add(std::move(callback));
+  return true;
+}
+#endif  // USE_ADC_SENSOR_CONTINUOUS
+
 #ifdef USE_RP2040
 float ADCSensor::sample() {
   if (this->is_temperature_) {
@@ -30,6 +30,13 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
   void set_autorange(bool autorange) { autorange_ = autorange; }
 #endif
 
+#ifdef USE_ADC_SENSOR_CONTINUOUS
+  /// Sample continuously with DMA at this rate in Hz instead of reading the ADC on demand.
+  void set_sample_rate(uint32_t sample_rate) { this->sample_rate_ = sample_rate; }
+  void loop() override;
+  bool add_on_samples_callback(std::function<void(const float *samples, size_t count)> &&callback) override;
+#endif
+
   /// Update ADC values
   void update() override;
   /// Setup ADC
@@ -68,6 +75,16 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
   esp_adc_cal_characteristics_t cal_characteristics_[ADC_ATTEN_MAX] = {};
 #endif
 #endif
+
+#ifdef USE_ADC_SENSOR_CONTINUOUS
+  bool setup_continuous_();
+  float raw_to_voltage_(int raw);
+
+  uint32_t sample_rate_{0};
+  /// Mean of the most recent block read from the DMA buffer.
+  float continuous_mean_{NAN};
+  CallbackManager<void(const float *, size_t)> samples_callback_;
+#endif
 };
 
 }  // namespace adc
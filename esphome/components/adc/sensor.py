@@ -4,12 +4,20 @@ import esphome.final_validate as fv
 from esphome.core import CORE
 from esphome.components import sensor, voltage_sampler
 from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import (
+    VARIANT_ESP32,
+    VARIANT_ESP32C3,
+    VARIANT_ESP32S2,
+    VARIANT_ESP32S3,
+)
 from esphome.const import (
     CONF_ATTENUATION,
     CONF_ID,
     CONF_NUMBER,
     CONF_PIN,
+    CONF_PLATFORM,
     CONF_RAW,
+    CONF_SENSOR,
     CONF_WIFI,
     DEVICE_CLASS_VOLTAGE,
     STATE_CLASS_MEASUREMENT,
@@ -24,10 +32,24 @@ from . import (
 
 AUTO_LOAD = ["voltage_sampler"]
 
+CONF_SAMPLE_RATE = "sample_rate"
+
+# Variants with DMA sampling support and their sample rate limits in Hz
+CONTINUOUS_SAMPLE_RATES = {
+    VARIANT_ESP32: (20000, 2000000),
+    VARIANT_ESP32S2: (611, 83333),
+    VARIANT_ESP32S3: (611, 83333),
+    VARIANT_ESP32C3: (611, 83333),
+}
+
 
 def validate_config(config):
     if config[CONF_RAW] and config.get(CONF_ATTENUATION, None) == "auto":
         raise cv.Invalid("Automatic attenuation cannot be used when raw output is set")
+    if CONF_SAMPLE_RATE in config and config.get(CONF_ATTENUATION, None) == "auto":
+        raise cv.Invalid(
+            "Automatic attenuation cannot be used with continuous sampling"
+        )
 
     return config
 
@@ -44,6 +66,36 @@ def final_validate_config(config):
                 f"{variant} doesn't support ADC on this pin when Wi-Fi is configured"
             )
 
+    if CONF_SAMPLE_RATE in config:
+        variant = get_esp32_variant()
+        if variant not in CONTINUOUS_SAMPLE_RATES:
+            raise cv.Invalid(
+                f"{variant} doesn't support continuous sampling", [CONF_SAMPLE_RATE]
+            )
+        if (
+            config[CONF_PIN][CONF_NUMBER]
+            not in ESP32_VARIANT_ADC1_PIN_TO_CHANNEL[variant]
+        ):
+            raise cv.Invalid(
+                "Continuous sampling is only supported on ADC1 pins", [CONF_PIN]
+            )
+        min_rate, max_rate = CONTINUOUS_SAMPLE_RATES[variant]
+        if not min_rate <= config[CONF_SAMPLE_RATE] <= max_rate:
+            raise cv.Invalid(
+                f"{variant} supports sample rates from {min_rate} Hz to {max_rate} Hz",
+                [CONF_SAMPLE_RATE],
+            )
+        # There is a single DMA sampling controller
+        continuous = [
+            conf
+            for conf in fv.full_config.get().get(CONF_SENSOR, [])
+            if conf[CONF_PLATFORM] == "adc" and CONF_SAMPLE_RATE in conf
+        ]
+        if len(continuous) > 1:
+            raise cv.Invalid(
+                "Only one ADC sensor can use continuous sampling", [CONF_SAMPLE_RATE]
+            )
+
     return config
 
 
@@ -67,6 +119,7 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(CONF_ATTENUATION, esp32="0db"): cv.All(
                 cv.only_on_esp32, cv.enum(ATTENUATION_MODES, lower=True)
             ),
+            cv.Optional(CONF_SAMPLE_RATE): cv.All(cv.only_on_esp32, cv.frequency),
         }
     )
     .extend(cv.polling_component_schema("60s")),
@@ -112,3 +165,7 @@ async def to_code(config):
         ):
             chan = ESP32_VARIANT_ADC2_PIN_TO_CHANNEL[variant][pin_num]
             cg.add(var.set_channel2(chan))
+
+    if sample_rate := config.get(CONF_SAMPLE_RATE):
+        cg.add_define("USE_ADC_SENSOR_CONTINUOUS")
+        cg.add(var.set_sample_rate(int(sample_rate)))
@@ -3,7 +3,13 @@ import logging
 from esphome import automation, core
 from esphome.components import font
 import esphome.components.image as espImage
-from esphome.components.image import CONF_USE_TRANSPARENCY
+from esphome.components.image import (
+    CONF_COMPRESSION,
+    CONF_USE_TRANSPARENCY,
+    COMPRESSION_NONE,
+    COMPRESSION_RLE,
+    COMPRESSION_SCHEMA,
+)
 import esphome.config_validation as cv
 import esphome.codegen as cg
 from esphome.const import (
@@ -75,6 +81,7 @@ ANIMATION_SCHEMA = cv.Schema(
             # Not setting default here on purpose; the default depends on the image type,
             # and thus will be set in the "validate_cross_dependencies" validator.
             cv.Optional(CONF_USE_TRANSPARENCY): cv.boolean,
+            cv.Optional(CONF_COMPRESSION, default=COMPRESSION_NONE): COMPRESSION_SCHEMA,
             cv.Optional(CONF_LOOP): cv.All(
                 {
                     cv.Optional(CONF_START_FRAME, default=0): cv.positive_int,
@@ -278,6 +285,19 @@ async def to_code(config):
             f"Animation f{config[CONF_ID]} has not supported type {config[CONF_TYPE]}."
         )
 
+    compressed = config[CONF_COMPRESSION] == COMPRESSION_RLE
+    if compressed:
+        # frames get different sizes, each one is prefixed with its length
+        frame_size = len(data) // frames
+        compressed_data = []
+        for start in range(0, len(data), frame_size):
+            frame_data = espImage.rle_encode(
+                data[start : start + frame_size], config[CONF_TYPE], width
+            )
+            compressed_data += list(len(frame_data).to_bytes(4, "little"))
+            compressed_data += frame_data
+        data = compressed_data
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
     var = cg.new_Pvariable(
@@ -289,6 +309,8 @@ async def to_code(config):
         espImage.IMAGE_TYPE[config[CONF_TYPE]],
     )
     cg.add(var.set_transparency(transparent))
+    if compressed:
+        cg.add(var.set_compressed(True))
     if loop_config := config.get(CONF_LOOP):
         start = loop_config[CONF_START_FRAME]
         end = loop_config.get(CONF_END_FRAME, frames)
@@ -1,6 +1,7 @@
 #include "animation.h"
 
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 
 namespace esphome {
 namespace animation {
@@ -62,6 +63,16 @@ void Animation::set_frame(int frame) {
 }
 
 void Animation::update_data_start_() {
+  if (this->compressed_) {
+    // compressed frames differ in size, each one starts with its length as 32-bit little endian
+    const uint8_t *frame = this->animation_data_start_;
+    for (int i = 0; i < this->current_frame_; i++) {
+      frame += 4 + encode_uint32(progmem_read_byte(frame + 3), progmem_read_byte(frame + 2),
+                                 progmem_read_byte(frame + 1), progmem_read_byte(frame));
+    }
+    this->data_start_ = frame + 4;
+    return;
+  }
   const uint32_t image_size = image_type_to_width_stride(this->width_, this->type_) * this->height_;
   this->data_start_ = this->animation_data_start_ + image_size * this->current_frame_;
 }
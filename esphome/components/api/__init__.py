@@ -5,6 +5,7 @@ import esphome.config_validation as cv
 from esphome import automation
 from esphome.automation import Condition
 from esphome.const import (
+    CONF_ADDRESS,
     CONF_DATA,
     CONF_DATA_TEMPLATE,
     CONF_ID,
@@ -45,6 +46,9 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_LIST_ENTITIES_CACHE = "list_entities_cache"
+CONF_MAX_FRAME_SIZE = "max_frame_size"
+CONF_STATE_BROADCAST = "state_broadcast"
 
 
 def validate_encryption_key(value):
@@ -87,6 +91,16 @@ CONFIG_SCHEMA = cv.Schema(
                 cv.Required(CONF_KEY): validate_encryption_key,
             }
         ),
+        cv.Optional(CONF_LIST_ENTITIES_CACHE, default=False): cv.boolean,
+        cv.Optional(CONF_MAX_FRAME_SIZE, default=8192): cv.int_range(
+            min=256, max=65535
+        ),
+        cv.Optional(CONF_STATE_BROADCAST): cv.Schema(
+            {
+                cv.Required(CONF_ADDRESS): cv.ipv4,
+                cv.Optional(CONF_PORT, default=6054): cv.port,
+            }
+        ),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -124,6 +138,17 @@ async def to_code(config):
     else:
         cg.add_define("USE_API_PLAINTEXT")
 
+    cg.add_define("USE_API_MAX_FRAME_SIZE", config[CONF_MAX_FRAME_SIZE])
+    if config[CONF_LIST_ENTITIES_CACHE]:
+        cg.add_define("USE_API_LIST_ENTITIES_CACHE")
+    if broadcast_config := config.get(CONF_STATE_BROADCAST):
+        cg.add(
+            var.set_state_broadcast(
+                str(broadcast_config[CONF_ADDRESS]), broadcast_config[CONF_PORT]
+            )
+        )
+        cg.add_define("USE_API_STATE_BROADCAST")
+
     cg.add_define("USE_API")
     cg.add_global(api_ns.using)
 
@@ -4,7 +4,9 @@
 #include "esphome/components/network/util.h"
 #include "esphome/core/entity_base.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/log.h"
+#include "esphome/core/trace.h"
 #include "esphome/core/version.h"
 
 #ifdef USE_DEEP_SLEEP
@@ -19,12 +21,20 @@
 #ifdef USE_VOICE_ASSISTANT
 #include "esphome/components/voice_assistant/voice_assistant.h"
 #endif
+#ifdef USE_RUNTIME_STATS
+#include "esphome/components/runtime_stats/runtime_stats.h"
+#endif
+#ifdef USE_WIFI
+#include "esphome/components/wifi/wifi_component.h"
+#endif
 
 namespace esphome {
 namespace api {
 
 static const char *const TAG = "api.connection";
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
+// Time each entity iterator may spend per loop() call, it also pauses as soon as the socket is full
+static const uint32_t ITERATOR_BUDGET_US = 8000;
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
@@ -52,6 +62,10 @@ void APIConnection::start() {
 }
 
 APIConnection::~APIConnection() {
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  if (this->building_list_entities_cache_)
+    this->parent_->finish_list_entities_cache(false);
+#endif
 #ifdef USE_BLUETOOTH_PROXY
   if (bluetooth_proxy::global_bluetooth_proxy->get_api_connection() == this) {
     bluetooth_proxy::global_bluetooth_proxy->unsubscribe_api_connection(this);
@@ -71,7 +85,8 @@ void APIConnection::loop() {
     return;
   }
   if (this->next_close_) {
-    // requested a disconnect
+    // requested a disconnect, the response is still queued
+    this->flush_queued_messages_();
     this->helper_->close();
     this->remove_ = true;
     return;
@@ -99,14 +114,36 @@ void APIConnection::loop() {
     return;
   } else {
     this->last_traffic_ = millis();
+#ifdef USE_WIFI
+    // keepalive pings (types 7 and 8) don't mean more requests are coming
+    if (buffer.type != 7 && buffer.type != 8 && wifi::global_wifi_component != nullptr)
+      wifi::global_wifi_component->mark_activity();
+#endif
+    ESPHOME_TRACE_SCOPE(trace::TRACE_CATEGORY_API, "api_receive", buffer.type);
     // read a packet
-    this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
+    this->read_message(buffer.data_len, buffer.type, buffer.container + buffer.data_offset);
     if (this->remove_)
       return;
   }
 
-  this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+  this->refill_lane_credits_();
+  if (!this->deferred_states_.empty() && this->helper_->can_write_without_blocking())
+    this->send_deferred_states_();
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  if (this->list_entities_cache_at_ >= 0)
+    this->send_cached_list_entities_();
+  this->recording_list_entities_ = this->building_list_entities_cache_;
+  this->advance_iterator_(this->list_entities_iterator_, "entities");
+  this->recording_list_entities_ = false;
+  if (this->building_list_entities_cache_ && !this->list_entities_iterator_.is_active()) {
+    this->building_list_entities_cache_ = false;
+    this->parent_->finish_list_entities_cache(true);
+  }
+#else
+  this->advance_iterator_(this->list_entities_iterator_, "entities");
+#endif
+  this->advance_iterator_(this->initial_state_iterator_, "states");
+  this->send_state_sync_();
 
   const uint32_t keepalive = 60000;
   const uint32_t now = millis();
@@ -123,24 +160,10 @@ void APIConnection::loop() {
   }
 
 #ifdef USE_ESP32_CAMERA
-  if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
-    uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
-    // fixed32 key = 1;
-    buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
-    // bytes data = 2;
-    buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
-    // bool done = 3;
-    bool done = this->image_reader_.available() == to_send;
-    buffer.encode_bool(3, done);
-    bool success = this->send_buffer(buffer, 44);
-
-    if (success) {
-      this->image_reader_.consume_data(to_send);
-    }
-    if (success && done) {
-      this->image_reader_.return_image();
-    }
+  // Send as much of the image as the socket takes in this iteration
+  for (uint8_t i = 0; i < CAMERA_MAX_CHUNKS_PER_LOOP && this->image_reader_.available(); i++) {
+    if (!this->helper_->can_write_without_blocking() || !this->send_camera_chunk_())
+      break;
   }
 #endif
 
@@ -158,6 +181,168 @@ void APIConnection::loop() {
       }
     }
   }
+
+  // Everything sent since the last loop, including state updates from other components, goes out in one write
+  this->flush_queued_messages_();
+}
+
+bool APIConnection::flush_queued_messages_() {
+  APIError err = this->helper_->flush();
+  if (err != APIError::OK) {
+    on_fatal_error();
+    ESP_LOGW(TAG, "%s: Packet write failed %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
+    return false;
+  }
+  return true;
+}
+
+MessagePriority get_message_priority(uint32_t message_type) {
+  switch (message_type) {
+    case 67:  // BluetoothLEAdvertisementResponse
+    case 93:  // BluetoothLERawAdvertisementsResponse
+      return MessagePriority::BLUETOOTH;
+    case 29:  // SubscribeLogsResponse
+    case 44:  // CameraImageResponse
+      return MessagePriority::BULK;
+    default:
+      return MessagePriority::INTERACTIVE;
+  }
+}
+
+void APIConnection::refill_lane_credits_() {
+  const bool backed_up = this->helper_->tx_backlog() > 0 || !this->deferred_states_.empty();
+  for (uint8_t i = 1; i < MESSAGE_PRIORITY_COUNT; i++) {
+    // credit left over from an unlimited iteration counts as one quantum
+    this->lane_credits_[i] =
+        backed_up ? std::min(this->lane_credits_[i], LANE_QUANTUM[i]) + LANE_QUANTUM[i] : UINT32_MAX;
+  }
+}
+
+uint32_t APIConnection::get_lane_credit_(MessagePriority priority) const {
+  if (priority == MessagePriority::INTERACTIVE)
+    return UINT32_MAX;
+  if (!this->deferred_states_.empty())
+    return 0;
+  return this->lane_credits_[static_cast<uint8_t>(priority)];
+}
+
+void APIConnection::charge_lane_(MessagePriority priority, uint32_t len) {
+  uint32_t &credit = this->lane_credits_[static_cast<uint8_t>(priority)];
+  if (priority != MessagePriority::INTERACTIVE && credit != UINT32_MAX)
+    credit -= std::min(credit, len);
+}
+
+void APIConnection::subscribe_states(const SubscribeStatesRequest &msg) {
+  this->state_subscription_ = true;
+  this->state_sync_sent_ = false;
+  // a client that has the states of this boot up to a version only needs the ones that changed since
+  if (msg.sync_boot_id == this->parent_->get_state_boot_id() &&
+      msg.sync_version <= this->parent_->get_state_version()) {
+    ESP_LOGD(TAG, "%s: Sending the states changed since version %" PRIu32, this->client_info_.c_str(),
+             msg.sync_version);
+    this->initial_state_iterator_.begin_since(msg.sync_version);
+  } else {
+    this->initial_state_iterator_.begin_since(0);
+  }
+}
+
+void APIConnection::send_state_sync_() {
+  // states still waiting for the socket or the iterator aren't with the client yet
+  if (!this->state_subscription_ || this->initial_state_iterator_.is_active() || !this->deferred_states_.empty())
+    return;
+  if (this->client_api_version_major_ == 1 && this->client_api_version_minor_ < 10)
+    return;
+  const uint32_t version = this->parent_->get_state_version();
+  const uint32_t now = millis();
+  if (this->state_sync_sent_ &&
+      (version == this->state_sync_version_ || now - this->last_state_sync_ < STATE_SYNC_INTERVAL))
+    return;
+  StateSyncResponse resp;
+  resp.boot_id = this->parent_->get_state_boot_id();
+  resp.version = version;
+  if (!this->send_state_sync_response(resp))
+    return;
+  this->state_sync_sent_ = true;
+  this->state_sync_version_ = version;
+  this->last_state_sync_ = now;
+}
+
+void APIConnection::advance_iterator_(ComponentIterator &iterator, const char *what) {
+  if (!iterator.is_active())
+    return;
+  iterator.advance_for(ITERATOR_BUDGET_US);
+  if (!iterator.is_active()) {
+    ESP_LOGD(TAG, "%s: Sent %" PRIu32 " %s in %" PRIu32 "ms", this->client_info_.c_str(), iterator.get_entities_done(),
+             what, iterator.get_elapsed_ms());
+  }
+}
+
+void APIConnection::list_entities(const ListEntitiesRequest &msg) {
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  if (this->parent_->get_list_entities_cache() != nullptr) {
+    this->list_entities_cache_at_ = 0;
+    return;
+  }
+  // a repeated request restarts the iteration, so the partial cache is useless
+  if (this->building_list_entities_cache_)
+    this->parent_->finish_list_entities_cache(false);
+  this->building_list_entities_cache_ = this->parent_->start_list_entities_cache();
+#endif
+  this->list_entities_iterator_.begin();
+}
+
+#ifdef USE_API_LIST_ENTITIES_CACHE
+void APIConnection::send_cached_list_entities_() {
+  const std::vector<uint8_t> &cache = *this->parent_->get_list_entities_cache();
+  const uint32_t start = micros();
+  while (static_cast<size_t>(this->list_entities_cache_at_) < cache.size()) {
+    // each entry is the message type and payload length (both 16 bit little endian) followed by the payload
+    const uint8_t *entry = &cache[this->list_entities_cache_at_];
+    uint16_t type = entry[0] | (entry[1] << 8);
+    uint16_t len = entry[2] | (entry[3] << 8);
+    ProtoWriteBuffer buffer = this->create_buffer(len);
+    buffer.write(entry + 4, len);
+    if (!this->send_buffer(buffer, type))
+      return;
+    this->list_entities_cache_at_ += 4 + len;
+    if (micros() - start >= ITERATOR_BUDGET_US)
+      return;
+  }
+  if (this->send_list_info_done())
+    this->list_entities_cache_at_ = -1;
+}
+#endif
+
+bool APIConnection::is_congested_() {
+  if (this->remove_ || this->helper_->can_write_without_blocking())
+    return false;
+  // give the socket a chance to drain before deferring, errors are reported by send_buffer()
+  if (this->helper_->loop() != APIError::OK)
+    return false;
+  return !this->helper_->can_write_without_blocking();
+}
+
+bool APIConnection::defer_state_(EntityBase *entity, DeferredStateSender sender) {
+  // only the entity is remembered, the state is read again when sending so the latest one wins
+  for (auto &deferred : this->deferred_states_) {
+    if (deferred.entity == entity) {
+      this->parent_->states_coalesced_++;
+      return true;
+    }
+  }
+  this->parent_->states_deferred_++;
+  this->deferred_states_.push_back({entity, sender});
+  return true;
+}
+
+void APIConnection::send_deferred_states_() {
+  // senders re-defer if the socket fills up again, so work on a detached copy
+  std::vector<DeferredState> deferred;
+  deferred.swap(this->deferred_states_);
+  for (auto &state : deferred) {
+    if (!state.sender(this, state.entity) && this->remove_)
+      return;
+  }
 }
 
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
@@ -181,12 +366,22 @@ void APIConnection::on_disconnect_response(const DisconnectResponse &value) {
 bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(binary_sensor, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<binary_sensor::BinarySensor *>(e);
+      return c->send_binary_sensor_state(obj, obj->state);
+    });
+  }
 
+  return this->send_binary_sensor_state_response(APIConnection::make_binary_sensor_state(binary_sensor, state));
+}
+BinarySensorStateResponse APIConnection::make_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor,
+                                                                  bool state) {
   BinarySensorStateResponse resp;
   resp.key = binary_sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !binary_sensor->has_state();
-  return this->send_binary_sensor_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
   ListEntitiesBinarySensorResponse msg;
@@ -208,7 +403,16 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
 bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(cover, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<cover::Cover *>(e);
+      return c->send_cover_state(obj);
+    });
+  }
 
+  return this->send_cover_state_response(APIConnection::make_cover_state(cover));
+}
+CoverStateResponse APIConnection::make_cover_state(cover::Cover *cover) {
   auto traits = cover->get_traits();
   CoverStateResponse resp{};
   resp.key = cover->get_object_id_hash();
@@ -218,7 +422,7 @@ bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (traits.get_supports_tilt())
     resp.tilt = cover->tilt;
   resp.current_operation = static_cast<enums::CoverOperation>(cover->current_operation);
-  return this->send_cover_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_cover_info(cover::Cover *cover) {
   auto traits = cover->get_traits();
@@ -271,7 +475,16 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
 bool APIConnection::send_fan_state(fan::Fan *fan) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(fan, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<fan::Fan *>(e);
+      return c->send_fan_state(obj);
+    });
+  }
 
+  return this->send_fan_state_response(APIConnection::make_fan_state(fan));
+}
+FanStateResponse APIConnection::make_fan_state(fan::Fan *fan) {
   auto traits = fan->get_traits();
   FanStateResponse resp{};
   resp.key = fan->get_object_id_hash();
@@ -283,7 +496,7 @@ bool APIConnection::send_fan_state(fan::Fan *fan) {
   }
   if (traits.supports_direction())
     resp.direction = static_cast<enums::FanDirection>(fan->direction);
-  return this->send_fan_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_fan_info(fan::Fan *fan) {
   auto traits = fan->get_traits();
@@ -326,7 +539,16 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
 bool APIConnection::send_light_state(light::LightState *light) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(light, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<light::LightState *>(e);
+      return c->send_light_state(obj);
+    });
+  }
 
+  return this->send_light_state_response(APIConnection::make_light_state(light));
+}
+LightStateResponse APIConnection::make_light_state(light::LightState *light) {
   auto traits = light->get_traits();
   auto values = light->remote_values;
   auto color_mode = values.get_color_mode();
@@ -346,7 +568,7 @@ bool APIConnection::send_light_state(light::LightState *light) {
   resp.warm_white = values.get_warm_white();
   if (light->supports_effects())
     resp.effect = light->get_effect_name();
-  return this->send_light_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_light_info(light::LightState *light) {
   auto traits = light->get_traits();
@@ -424,12 +646,21 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
 bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(sensor, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<sensor::Sensor *>(e);
+      return c->send_sensor_state(obj, obj->state);
+    });
+  }
 
+  return this->send_sensor_state_response(APIConnection::make_sensor_state(sensor, state));
+}
+SensorStateResponse APIConnection::make_sensor_state(sensor::Sensor *sensor, float state) {
   SensorStateResponse resp{};
   resp.key = sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !sensor->has_state();
-  return this->send_sensor_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   ListEntitiesSensorResponse msg;
@@ -456,11 +687,20 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(a_switch, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<switch_::Switch *>(e);
+      return c->send_switch_state(obj, obj->state);
+    });
+  }
 
+  return this->send_switch_state_response(APIConnection::make_switch_state(a_switch, state));
+}
+SwitchStateResponse APIConnection::make_switch_state(switch_::Switch *a_switch, bool state) {
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
   resp.state = state;
-  return this->send_switch_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   ListEntitiesSwitchResponse msg;
@@ -490,16 +730,32 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
 #endif
 
 #ifdef USE_TEXT_SENSOR
-bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
+bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, const std::string &state) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(text_sensor, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<text_sensor::TextSensor *>(e);
+      return c->send_text_sensor_state(obj, obj->state);
+    });
+  }
 
-  TextSensorStateResponse resp{};
+  // Kept between calls, so copying the state only allocates when it is longer than any state sent before. All
+  // connections send from the main loop, and the message is encoded before this returns.
+  static TextSensorStateResponse resp;
   resp.key = text_sensor->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = state;
   resp.missing_state = !text_sensor->has_state();
   return this->send_text_sensor_state_response(resp);
 }
+TextSensorStateResponse APIConnection::make_text_sensor_state(text_sensor::TextSensor *text_sensor,
+                                                              const std::string &state) {
+  TextSensorStateResponse resp{};
+  resp.key = text_sensor->get_object_id_hash();
+  resp.state = state;
+  resp.missing_state = !text_sensor->has_state();
+  return resp;
+}
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
   ListEntitiesTextSensorResponse msg;
   msg.key = text_sensor->get_object_id_hash();
@@ -519,7 +775,16 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
 bool APIConnection::send_climate_state(climate::Climate *climate) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(climate, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<climate::Climate *>(e);
+      return c->send_climate_state(obj);
+    });
+  }
 
+  return this->send_climate_state_response(APIConnection::make_climate_state(climate));
+}
+ClimateStateResponse APIConnection::make_climate_state(climate::Climate *climate) {
   auto traits = climate->get_traits();
   ClimateStateResponse resp{};
   resp.key = climate->get_object_id_hash();
@@ -544,7 +809,7 @@ bool APIConnection::send_climate_state(climate::Climate *climate) {
     resp.custom_preset = climate->custom_preset.value();
   if (traits.get_supports_swing_modes())
     resp.swing_mode = static_cast<enums::ClimateSwingMode>(climate->swing_mode);
-  return this->send_climate_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_climate_info(climate::Climate *climate) {
   auto traits = climate->get_traits();
@@ -617,12 +882,21 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
 bool APIConnection::send_number_state(number::Number *number, float state) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(number, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<number::Number *>(e);
+      return c->send_number_state(obj, obj->state);
+    });
+  }
 
+  return this->send_number_state_response(APIConnection::make_number_state(number, state));
+}
+NumberStateResponse APIConnection::make_number_state(number::Number *number, float state) {
   NumberStateResponse resp{};
   resp.key = number->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !number->has_state();
-  return this->send_number_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_number_info(number::Number *number) {
   ListEntitiesNumberResponse msg;
@@ -659,12 +933,21 @@ void APIConnection::number_command(const NumberCommandRequest &msg) {
 bool APIConnection::send_select_state(select::Select *select, std::string state) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(select, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<select::Select *>(e);
+      return c->send_select_state(obj, obj->state);
+    });
+  }
 
+  return this->send_select_state_response(APIConnection::make_select_state(select, std::move(state)));
+}
+SelectStateResponse APIConnection::make_select_state(select::Select *select, std::string state) {
   SelectStateResponse resp{};
   resp.key = select->get_object_id_hash();
   resp.state = std::move(state);
   resp.missing_state = !select->has_state();
-  return this->send_select_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_select_info(select::Select *select) {
   ListEntitiesSelectResponse msg;
@@ -720,11 +1003,20 @@ void APIConnection::button_command(const ButtonCommandRequest &msg) {
 bool APIConnection::send_lock_state(lock::Lock *a_lock, lock::LockState state) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(a_lock, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<lock::Lock *>(e);
+      return c->send_lock_state(obj, obj->state);
+    });
+  }
 
+  return this->send_lock_state_response(APIConnection::make_lock_state(a_lock, state));
+}
+LockStateResponse APIConnection::make_lock_state(lock::Lock *a_lock, lock::LockState state) {
   LockStateResponse resp{};
   resp.key = a_lock->get_object_id_hash();
   resp.state = static_cast<enums::LockState>(state);
-  return this->send_lock_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_lock_info(lock::Lock *a_lock) {
   ListEntitiesLockResponse msg;
@@ -764,13 +1056,22 @@ void APIConnection::lock_command(const LockCommandRequest &msg) {
 bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_player) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(media_player, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<media_player::MediaPlayer *>(e);
+      return c->send_media_player_state(obj);
+    });
+  }
 
+  return this->send_media_player_state_response(APIConnection::make_media_player_state(media_player));
+}
+MediaPlayerStateResponse APIConnection::make_media_player_state(media_player::MediaPlayer *media_player) {
   MediaPlayerStateResponse resp{};
   resp.key = media_player->get_object_id_hash();
   resp.state = static_cast<enums::MediaPlayerState>(media_player->state);
   resp.volume = media_player->volume;
   resp.muted = media_player->is_muted();
-  return this->send_media_player_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_media_player_info(media_player::MediaPlayer *media_player) {
   ListEntitiesMediaPlayerResponse msg;
@@ -808,9 +1109,51 @@ void APIConnection::media_player_command(const MediaPlayerCommandRequest &msg) {
 #endif
 
 #ifdef USE_ESP32_CAMERA
+bool APIConnection::send_camera_chunk_() {
+  const size_t available = this->image_reader_.available();
+  // Chunks shrink to what the bulk lane may send, the rest of the socket is kept for states and commands
+  const uint32_t credit = this->get_lane_credit_(MessagePriority::BULK);
+  const uint32_t to_send = std::min((size_t) std::min(this->camera_chunk_size_, credit), available);
+  if (to_send < available && to_send < CAMERA_MIN_CHUNK_SIZE)
+    return false;
+  const bool done = available == to_send;
+
+  // fixed32 key = 1; and the tag and length of bytes data = 2;
+  auto buffer = this->create_buffer(5 + 1 + ProtoSize::varint(to_send));
+  buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
+  buffer.encode_field_raw(2, 2);
+  buffer.encode_varint_raw(to_send);
+  // bool done = 3;
+  static const uint8_t DONE_FIELD[] = {(3 << 3) | 0, 1};
+
+  // The chunk is sent straight from the camera frame buffer
+  APIError err = this->helper_->write_protobuf_packet(44, buffer, this->image_reader_.peek_data_buffer(), to_send,
+                                                      DONE_FIELD, done ? sizeof(DONE_FIELD) : 0);
+  if (err != APIError::OK) {
+    if (err != APIError::WOULD_BLOCK) {
+      on_fatal_error();
+      ESP_LOGW(TAG, "%s: Packet write failed %s errno=%d", client_info_.c_str(), api_error_to_str(err), errno);
+    }
+    return false;
+  }
+
+  this->charge_lane_(MessagePriority::BULK, to_send);
+  this->image_reader_.consume_data(to_send);
+  if (done)
+    this->image_reader_.return_image();
+
+  // Grow the chunks while the socket keeps up, back off once it had to buffer
+  if (this->helper_->tx_backlog() > 0) {
+    this->camera_chunk_size_ = std::max(this->camera_chunk_size_ / 2, CAMERA_MIN_CHUNK_SIZE);
+    return false;
+  }
+  this->camera_chunk_size_ = std::min(this->camera_chunk_size_ * 2, CAMERA_MAX_CHUNK_SIZE);
+  return true;
+}
 void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage> image) {
   if (!this->state_subscription_)
     return;
+  // Frames that arrive while an image is still being sent are skipped, the API holds a single frame buffer
   if (this->image_reader_.available())
     return;
   if (image->was_requested_by(esphome::esp32_camera::API_REQUESTER) ||
@@ -914,6 +1257,8 @@ bool APIConnection::request_voice_assistant(bool start, const std::string &conve
   msg.start = start;
   msg.conversation_id = conversation_id;
   msg.use_vad = use_vad;
+  if (start && voice_assistant::global_voice_assistant != nullptr)
+    msg.audio_format = voice_assistant::global_voice_assistant->get_audio_format();
   return this->send_voice_assistant_request(msg);
 }
 void APIConnection::on_voice_assistant_response(const VoiceAssistantResponse &msg) {
@@ -921,7 +1266,7 @@ void APIConnection::on_voice_assistant_response(const VoiceAssistantResponse &ms
     struct sockaddr_storage storage;
     socklen_t len = sizeof(storage);
     this->helper_->getpeername((struct sockaddr *) &storage, &len);
-    voice_assistant::global_voice_assistant->start(&storage, msg.port);
+    voice_assistant::global_voice_assistant->start(&storage, msg.port, msg.audio_format);
   }
 };
 void APIConnection::on_voice_assistant_event_response(const VoiceAssistantEventResponse &msg) {
@@ -936,11 +1281,22 @@ void APIConnection::on_voice_assistant_event_response(const VoiceAssistantEventR
 bool APIConnection::send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   if (!this->state_subscription_)
     return false;
+  if (this->is_congested_()) {
+    return this->defer_state_(a_alarm_control_panel, [](APIConnection *c, EntityBase *e) {
+      auto *obj = static_cast<alarm_control_panel::AlarmControlPanel *>(e);
+      return c->send_alarm_control_panel_state(obj);
+    });
+  }
 
+  return this->send_alarm_control_panel_state_response(
+      APIConnection::make_alarm_control_panel_state(a_alarm_control_panel));
+}
+AlarmControlPanelStateResponse APIConnection::make_alarm_control_panel_state(
+    alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   AlarmControlPanelStateResponse resp{};
   resp.key = a_alarm_control_panel->get_object_id_hash();
   resp.state = static_cast<enums::AlarmControlPanelState>(a_alarm_control_panel->get_state());
-  return this->send_alarm_control_panel_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_alarm_control_panel_info(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   ListEntitiesAlarmControlPanelResponse msg;
@@ -990,16 +1346,84 @@ void APIConnection::alarm_control_panel_command(const AlarmControlPanelCommandRe
 }
 #endif
 
+#ifdef USE_RUNTIME_STATS
+static RuntimeStatsEntry make_runtime_stats_entry(enums::RuntimeStatsKind kind, const char *source,
+                                                  const runtime_stats::DurationHistogram &histogram) {
+  RuntimeStatsEntry entry;
+  entry.kind = kind;
+  entry.source = source;
+  entry.count = histogram.get_count();
+  entry.total_us = histogram.get_total_us();
+  entry.max_us = histogram.get_max_us();
+  entry.histogram.reserve(runtime_stats::DurationHistogram::BUCKET_COUNT);
+  for (uint8_t i = 0; i < runtime_stats::DurationHistogram::BUCKET_COUNT; i++)
+    entry.histogram.push_back(histogram.get_bucket(i));
+  return entry;
+}
+RuntimeStatsResponse APIConnection::runtime_stats(const RuntimeStatsRequest &msg) {
+  RuntimeStatsResponse resp;
+  auto *stats = runtime_stats::global_runtime_stats;
+  resp.entries.push_back(
+      make_runtime_stats_entry(enums::RUNTIME_STATS_KIND_APP_LOOP, "app", stats->get_app_loop_stats()));
+  resp.entries.push_back(make_runtime_stats_entry(enums::RUNTIME_STATS_KIND_JITTER, "app", stats->get_jitter_stats()));
+  for (auto *component : stats->get_component_stats()) {
+    const char *source = component->component->get_component_source();
+    if (component->loop.get_count() != 0)
+      resp.entries.push_back(make_runtime_stats_entry(enums::RUNTIME_STATS_KIND_LOOP, source, component->loop));
+    if (component->scheduled.get_count() != 0) {
+      resp.entries.push_back(
+          make_runtime_stats_entry(enums::RUNTIME_STATS_KIND_SCHEDULED, source, component->scheduled));
+    }
+  }
+  for (auto *item : stats->get_scheduled_stats()) {
+    const char *source = item->component == nullptr ? "<null>" : item->component->get_component_source();
+    auto entry = make_runtime_stats_entry(enums::RUNTIME_STATS_KIND_SCHEDULED_ITEM, source, item->histogram);
+    entry.name = item->id != 0 ? str_sprintf("0x%08" PRIX32, item->id) : item->name;
+    resp.entries.push_back(std::move(entry));
+  }
+  if (msg.reset)
+    stats->reset();
+  return resp;
+}
+#endif
+
+#ifdef USE_HEAP_TRACKING
+HeapStatsResponse APIConnection::heap_stats(const HeapStatsRequest &msg) {
+  HeapStatsResponse resp;
+  resp.free = get_free_heap();
+  resp.largest_free_block = get_largest_free_heap_block();
+  resp.fragmentation = get_heap_fragmentation();
+  for (uint8_t i = 0; i < HEAP_TAG_COUNT; i++) {
+    auto tag = static_cast<HeapTag>(i);
+    HeapTagStats stats = get_heap_tag_stats(tag);
+    HeapStatsEntry entry;
+    entry.subsystem = heap_tag_to_string(tag);
+    entry.allocated = stats.allocated;
+    entry.peak = stats.peak;
+    entry.allocations = stats.allocations;
+    resp.entries.push_back(std::move(entry));
+  }
+  if (msg.reset_peaks)
+    reset_heap_tag_peaks();
+  return resp;
+}
+#endif
+
 bool APIConnection::send_log_message(int level, const char *tag, const char *line) {
   if (this->log_subscription_ < level)
     return false;
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  size_t line_length = strlen(line);
+  uint32_t msg_size = 0;
+  ProtoSize::add_uint32_field(msg_size, 1, static_cast<uint32_t>(level), false);
+  if (line_length > 0)
+    msg_size += 1 + ProtoSize::varint(static_cast<uint32_t>(line_length)) + line_length;
+  auto buffer = this->create_buffer(msg_size);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_length);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
@@ -1014,7 +1438,7 @@ HelloResponse APIConnection::hello(const HelloRequest &msg) {
 
   HelloResponse resp;
   resp.api_version_major = 1;
-  resp.api_version_minor = 9;
+  resp.api_version_minor = 10;
   resp.server_info = App.get_name() + " (esphome v" ESPHOME_VERSION ")";
   resp.name = App.get_name();
 
@@ -1079,11 +1503,7 @@ DeviceInfoResponse APIConnection::device_info(const DeviceInfoRequest &msg) {
   return resp;
 }
 void APIConnection::on_home_assistant_state_response(const HomeAssistantStateResponse &msg) {
-  for (auto &it : this->parent_->get_state_subs()) {
-    if (it.entity_id == msg.entity_id && it.attribute.value() == msg.attribute) {
-      it.callback(msg.state);
-    }
-  }
+  this->parent_->dispatch_home_assistant_state(msg.entity_id, msg.attribute, msg.state);
 }
 void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
   bool found = false;
@@ -1099,9 +1519,32 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
+bool APIConnection::send_proto_message_(const ProtoMessage &msg, uint32_t message_type) {
+  APIServer::SharedMessage *shared = this->parent_->get_shared_message(message_type);
+  if (shared == nullptr)
+    return ProtoService::send_proto_message_(msg, message_type);
+  if (!shared->encoded) {
+    // the first connection encodes, the others only copy the payload behind their own frame header
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    shared->payload.clear();
+    msg.encode_append(shared->payload, msg_size);
+    shared->encoded = true;
+  }
+  ProtoWriteBuffer buffer = this->create_buffer(shared->payload.size());
+  buffer.write(shared->payload.data(), shared->payload.size());
+  return this->send_buffer(buffer, message_type);
+}
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
   if (this->remove_)
     return false;
+  ESPHOME_TRACE_SCOPE(trace::TRACE_CATEGORY_API, "api_send", message_type);
+  const MessagePriority priority = get_message_priority(message_type);
+  const uint32_t size = buffer.get_buffer()->size();
+  const uint32_t credit = this->get_lane_credit_(priority);
+  // a message larger than the lane can ever hold goes out once the credit is full
+  if (size > credit && (credit == 0 || credit < 2 * LANE_QUANTUM[static_cast<uint8_t>(priority)]))
+    return false;
   if (!this->helper_->can_write_without_blocking()) {
     delay(0);
     APIError err = helper_->loop();
@@ -1120,7 +1563,23 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  // ListEntitiesDoneResponse is sent by APIConnection itself after streaming the cache
+  if (this->recording_list_entities_ && message_type != 19) {
+    const std::vector<uint8_t> &data = *buffer.get_buffer();
+    const size_t header_padding = this->helper_->frame_header_padding();
+    this->parent_->add_to_list_entities_cache(message_type, &data[header_padding], data.size() - header_padding);
+  }
+#endif
+  APIError err = this->helper_->write_protobuf_packet(message_type, buffer);
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  if (this->recording_list_entities_ && err != APIError::OK) {
+    // the iterator retries this entity, the recorded copy would be a duplicate
+    this->recording_list_entities_ = false;
+    this->building_list_entities_cache_ = false;
+    this->parent_->finish_list_entities_cache(false);
+  }
+#endif
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
@@ -1132,6 +1591,8 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
     return false;
   }
+  this->charge_lane_(priority, size);
+  this->parent_->messages_sent_++;
   // Do not set last_traffic_ on send
   return true;
 }
@@ -13,6 +13,30 @@
 namespace esphome {
 namespace api {
 
+#ifdef USE_ESP32_CAMERA
+/// Camera images are sent in chunks that grow between these sizes while the socket keeps up.
+static const uint32_t CAMERA_MIN_CHUNK_SIZE = 1024;
+static const uint32_t CAMERA_MAX_CHUNK_SIZE = 16384;
+static const uint8_t CAMERA_MAX_CHUNKS_PER_LOOP = 8;
+#endif
+/// Least time between two StateSyncResponse messages while states keep changing.
+static const uint32_t STATE_SYNC_INTERVAL = 10000;
+
+/// Classes of outbound messages, a lower one preempts the higher ones while the socket is backed up.
+enum class MessagePriority : uint8_t {
+  /// Command responses, entity states and everything else.
+  INTERACTIVE = 0,
+  /// Bluetooth proxy advertisements.
+  BLUETOOTH,
+  /// Log lines and camera images.
+  BULK,
+};
+static const uint8_t MESSAGE_PRIORITY_COUNT = 3;
+/// Bytes a lane may send per loop iteration while the socket is backed up, Bluetooth gets twice the share of bulk.
+static const uint32_t LANE_QUANTUM[MESSAGE_PRIORITY_COUNT] = {0, 8192, 4096};
+
+MessagePriority get_message_priority(uint32_t message_type);
+
 class APIConnection : public APIServerConnection {
  public:
   APIConnection(std::unique_ptr<socket::Socket> socket, APIServer *parent);
@@ -20,6 +44,8 @@ class APIConnection : public APIServerConnection {
 
   void start();
   void loop();
+  /// Bytes waiting for the socket to accept them.
+  size_t get_tx_backlog() const { return this->helper_->tx_backlog(); }
 
   bool send_list_info_done() {
     ListEntitiesDoneResponse resp;
@@ -27,34 +53,42 @@ class APIConnection : public APIServerConnection {
   }
 #ifdef USE_BINARY_SENSOR
   bool send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state);
+  /// Build the state message of the entity, also used for the state broadcast of the server.
+  static BinarySensorStateResponse make_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state);
   bool send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor);
 #endif
 #ifdef USE_COVER
   bool send_cover_state(cover::Cover *cover);
+  static CoverStateResponse make_cover_state(cover::Cover *cover);
   bool send_cover_info(cover::Cover *cover);
   void cover_command(const CoverCommandRequest &msg) override;
 #endif
 #ifdef USE_FAN
   bool send_fan_state(fan::Fan *fan);
+  static FanStateResponse make_fan_state(fan::Fan *fan);
   bool send_fan_info(fan::Fan *fan);
   void fan_command(const FanCommandRequest &msg) override;
 #endif
 #ifdef USE_LIGHT
   bool send_light_state(light::LightState *light);
+  static LightStateResponse make_light_state(light::LightState *light);
   bool send_light_info(light::LightState *light);
   void light_command(const LightCommandRequest &msg) override;
 #endif
 #ifdef USE_SENSOR
   bool send_sensor_state(sensor::Sensor *sensor, float state);
+  static SensorStateResponse make_sensor_state(sensor::Sensor *sensor, float state);
   bool send_sensor_info(sensor::Sensor *sensor);
 #endif
 #ifdef USE_SWITCH
   bool send_switch_state(switch_::Switch *a_switch, bool state);
+  static SwitchStateResponse make_switch_state(switch_::Switch *a_switch, bool state);
   bool send_switch_info(switch_::Switch *a_switch);
   void switch_command(const SwitchCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT_SENSOR
-  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state);
+  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, const std::string &state);
+  static TextSensorStateResponse make_text_sensor_state(text_sensor::TextSensor *text_sensor, const std::string &state);
   bool send_text_sensor_info(text_sensor::TextSensor *text_sensor);
 #endif
 #ifdef USE_ESP32_CAMERA
@@ -64,16 +98,19 @@ class APIConnection : public APIServerConnection {
 #endif
 #ifdef USE_CLIMATE
   bool send_climate_state(climate::Climate *climate);
+  static ClimateStateResponse make_climate_state(climate::Climate *climate);
   bool send_climate_info(climate::Climate *climate);
   void climate_command(const ClimateCommandRequest &msg) override;
 #endif
 #ifdef USE_NUMBER
   bool send_number_state(number::Number *number, float state);
+  static NumberStateResponse make_number_state(number::Number *number, float state);
   bool send_number_info(number::Number *number);
   void number_command(const NumberCommandRequest &msg) override;
 #endif
 #ifdef USE_SELECT
   bool send_select_state(select::Select *select, std::string state);
+  static SelectStateResponse make_select_state(select::Select *select, std::string state);
   bool send_select_info(select::Select *select);
   void select_command(const SelectCommandRequest &msg) override;
 #endif
@@ -83,11 +120,13 @@ class APIConnection : public APIServerConnection {
 #endif
 #ifdef USE_LOCK
   bool send_lock_state(lock::Lock *a_lock, lock::LockState state);
+  static LockStateResponse make_lock_state(lock::Lock *a_lock, lock::LockState state);
   bool send_lock_info(lock::Lock *a_lock);
   void lock_command(const LockCommandRequest &msg) override;
 #endif
 #ifdef USE_MEDIA_PLAYER
   bool send_media_player_state(media_player::MediaPlayer *media_player);
+  static MediaPlayerStateResponse make_media_player_state(media_player::MediaPlayer *media_player);
   bool send_media_player_info(media_player::MediaPlayer *media_player);
   void media_player_command(const MediaPlayerCommandRequest &msg) override;
 #endif
@@ -131,10 +170,19 @@ class APIConnection : public APIServerConnection {
 
 #ifdef USE_ALARM_CONTROL_PANEL
   bool send_alarm_control_panel_state(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
+  static AlarmControlPanelStateResponse make_alarm_control_panel_state(
+      alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
   bool send_alarm_control_panel_info(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel);
   void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) override;
 #endif
 
+#ifdef USE_RUNTIME_STATS
+  RuntimeStatsResponse runtime_stats(const RuntimeStatsRequest &msg) override;
+#endif
+#ifdef USE_HEAP_TRACKING
+  HeapStatsResponse heap_stats(const HeapStatsRequest &msg) override;
+#endif
+
   void on_disconnect_response(const DisconnectResponse &value) override;
   void on_ping_response(const PingResponse &value) override {
     // we initiated ping
@@ -149,11 +197,8 @@ class APIConnection : public APIServerConnection {
   DisconnectResponse disconnect(const DisconnectRequest &msg) override;
   PingResponse ping(const PingRequest &msg) override { return {}; }
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
-  void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
-  void subscribe_states(const SubscribeStatesRequest &msg) override {
-    this->state_subscription_ = true;
-    this->initial_state_iterator_.begin();
-  }
+  void list_entities(const ListEntitiesRequest &msg) override;
+  void subscribe_states(const SubscribeStatesRequest &msg) override;
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
     if (msg.dump_config)
@@ -176,17 +221,57 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
     // FIXME: ensure no recursive writes can happen
     this->proto_write_buffer_.clear();
+    // Reserve room for the frame header in front of the message and the footer after it, so that the frame helper
+    // sends the message straight from this buffer
+    uint8_t header_padding = this->helper_->frame_header_padding();
+    uint8_t footer_size = this->helper_->frame_footer_size();
+    this->proto_write_buffer_.reserve(header_padding + reserve_size + footer_size);
+    this->proto_write_buffer_.resize(header_padding);
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
+  bool send_proto_message_(const ProtoMessage &msg, uint32_t message_type) override;
 
  protected:
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  /// Write out the messages queued by the frame helper, returns false on a fatal error.
+  bool flush_queued_messages_();
+
+  /** Refill the byte credits of the Bluetooth and bulk lanes, called once per loop iteration.
+   *
+   * While the socket keeps up the lanes are not limited. Once it is backed up, each lane gets its quantum per
+   * iteration, up to two quanta, so interactive messages find room in the socket between the bulk ones.
+   */
+  void refill_lane_credits_();
+  /// Bytes a message of this priority may take now, none while states are waiting for the socket.
+  uint32_t get_lane_credit_(MessagePriority priority) const;
+  void charge_lane_(MessagePriority priority, uint32_t len);
+
+  /// Run an entity iterator for up to one loop budget and log its totals once it is done.
+  void advance_iterator_(ComponentIterator &iterator, const char *what);
+
+  using DeferredStateSender = bool (*)(APIConnection *, EntityBase *);
+  /// A state update that was held back because the socket was backed up.
+  struct DeferredState {
+    EntityBase *entity;
+    DeferredStateSender sender;
+  };
+  /// Returns true if the socket still can't take more data after trying to drain it.
+  bool is_congested_();
+  /// Remember the entity so its state is sent once the socket drains, at most one entry per entity.
+  bool defer_state_(EntityBase *entity, DeferredStateSender sender);
+  void send_deferred_states_();
+  /// Tell the client up to which state version it has every state, for a delta sync after reconnecting.
+  void send_state_sync_();
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  /// Stream the list from APIServer's cache instead of encoding every entity again.
+  void send_cached_list_entities_();
+#endif
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -205,7 +290,11 @@ class APIConnection : public APIServerConnection {
   uint32_t client_api_version_major_{0};
   uint32_t client_api_version_minor_{0};
 #ifdef USE_ESP32_CAMERA
+  /// Send the next chunk of the current image, returns false if the socket can't take more right now.
+  bool send_camera_chunk_();
+
   esp32_camera::CameraImageReader image_reader_;
+  uint32_t camera_chunk_size_{CAMERA_MIN_CHUNK_SIZE};
 #endif
 
   bool state_subscription_{false};
@@ -221,6 +310,20 @@ class APIConnection : public APIServerConnection {
   InitialStateIterator initial_state_iterator_;
   ListEntitiesIterator list_entities_iterator_;
   int state_subs_at_ = -1;
+  std::vector<DeferredState> deferred_states_;
+  /// The last StateSyncResponse sent, only valid once state_sync_sent_ is set.
+  uint32_t state_sync_version_{0};
+  uint32_t last_state_sync_{0};
+  bool state_sync_sent_{false};
+  uint32_t lane_credits_[MESSAGE_PRIORITY_COUNT]{UINT32_MAX, UINT32_MAX, UINT32_MAX};
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  /// Read position in the list entities cache, -1 when not streaming from it.
+  int32_t list_entities_cache_at_ = -1;
+  /// This connection fills the cache with the messages its list iterator sends.
+  bool building_list_entities_cache_{false};
+  /// Set while the list iterator runs, so only its messages are recorded.
+  bool recording_list_entities_{false};
+#endif
 };
 
 }  // namespace api
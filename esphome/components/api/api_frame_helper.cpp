@@ -68,6 +68,8 @@ const char *api_error_to_str(APIError err) {
     return "BAD_HANDSHAKE_ERROR_BYTE";
   } else if (err == APIError::CONNECTION_CLOSED) {
     return "CONNECTION_CLOSED";
+  } else if (err == APIError::BAD_PACKET_SIZE) {
+    return "BAD_PACKET_SIZE";
   }
   return "UNKNOWN";
 }
@@ -76,6 +78,18 @@ const char *api_error_to_str(APIError err) {
 // uncomment to log raw packets
 //#define HELPER_LOG_PACKETS
 
+/// Queued frames are sent once they reach about one TCP segment, even before flush() is called
+static const size_t TX_BATCH_MAX_SIZE = 1436;
+
+APIError APIFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer head, const uint8_t *data,
+                                               size_t data_len, const uint8_t *tail, size_t tail_len) {
+  std::vector<uint8_t> *raw_buffer = head.get_buffer();
+  raw_buffer->reserve(raw_buffer->size() + data_len + tail_len + frame_footer_size_);
+  raw_buffer->insert(raw_buffer->end(), data, data + data_len);
+  raw_buffer->insert(raw_buffer->end(), tail, tail + tail_len);
+  return this->write_protobuf_packet(type, head);
+}
+
 #ifdef USE_API_NOISE
 static const char *const PROLOGUE_INIT = "NoiseAPIInit";
 
@@ -180,6 +194,8 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
     HELPER_LOG("Bad argument for try_read_frame_");
     return APIError::BAD_ARG;
   }
+  if (!socket_->ready())
+    return APIError::WOULD_BLOCK;
 
   // read header
   if (rx_header_buf_len_ < 3) {
@@ -223,9 +239,14 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
     HELPER_LOG("Bad packet len for handshake: %d", msg_size);
     return APIError::BAD_HANDSHAKE_PACKET_LEN;
   }
+  if (msg_size > USE_API_MAX_FRAME_SIZE) {
+    state_ = State::FAILED;
+    HELPER_LOG("Bad packet len: %u exceeds %u", msg_size, (unsigned) USE_API_MAX_FRAME_SIZE);
+    return APIError::BAD_PACKET_SIZE;
+  }
 
-  // reserve space for body
-  if (rx_buf_.size() != msg_size) {
+  // reserve space for body, rx_buf_ keeps its capacity so this only allocates when a bigger frame arrives
+  if (rx_buf_.size() < msg_size) {
     rx_buf_.resize(msg_size);
   }
 
@@ -254,11 +275,11 @@ APIError APINoiseFrameHelper::try_read_frame_(ParsedFrame *frame) {
 
   // uncomment for even more debugging
 #ifdef HELPER_LOG_PACKETS
-  ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
+  ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_.data(), msg_size).c_str());
 #endif
-  frame->msg = std::move(rx_buf_);
-  // consume msg
-  rx_buf_ = {};
+  frame->msg = rx_buf_.data();
+  frame->msg_len = msg_size;
+  // consume msg, the data stays in rx_buf_ until the next frame is read
   rx_buf_len_ = 0;
   rx_header_buf_len_ = 0;
   return APIError::OK;
@@ -295,9 +316,9 @@ APIError APINoiseFrameHelper::state_action_() {
     if (aerr != APIError::OK)
       return aerr;
     // ignore contents, may be used in future for flags
-    prologue_.push_back((uint8_t) (frame.msg.size() >> 8));
-    prologue_.push_back((uint8_t) frame.msg.size());
-    prologue_.insert(prologue_.end(), frame.msg.begin(), frame.msg.end());
+    prologue_.push_back((uint8_t) (frame.msg_len >> 8));
+    prologue_.push_back((uint8_t) frame.msg_len);
+    prologue_.insert(prologue_.end(), frame.msg, frame.msg + frame.msg_len);
 
     state_ = State::SERVER_HELLO;
   }
@@ -340,7 +361,7 @@ APIError APINoiseFrameHelper::state_action_() {
       if (aerr != APIError::OK)
         return aerr;
 
-      if (frame.msg.empty()) {
+      if (frame.msg_len == 0) {
         send_explicit_handshake_reject_("Empty handshake message");
         return APIError::BAD_HANDSHAKE_ERROR_BYTE;
       } else if (frame.msg[0] != 0x00) {
@@ -351,7 +372,7 @@ APIError APINoiseFrameHelper::state_action_() {
 
       NoiseBuffer mbuf;
       noise_buffer_init(mbuf);
-      noise_buffer_set_input(mbuf, frame.msg.data() + 1, frame.msg.size() - 1);
+      noise_buffer_set_input(mbuf, frame.msg + 1, frame.msg_len - 1);
       err = noise_handshakestate_read_message(handshake_, &mbuf, nullptr);
       if (err != 0) {
         state_ = State::FAILED;
@@ -432,7 +453,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, frame.msg.data(), frame.msg.size(), frame.msg.size());
+  noise_buffer_set_inout(mbuf, frame.msg, frame.msg_len, frame.msg_len);
   err = noise_cipherstate_decrypt(recv_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -441,7 +462,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   }
 
   size_t msg_size = mbuf.size;
-  uint8_t *msg_data = frame.msg.data();
+  uint8_t *msg_data = frame.msg;
   if (msg_size < 4) {
     state_ = State::FAILED;
     HELPER_LOG("Bad data packet: size %d too short", msg_size);
@@ -460,14 +481,14 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
     return APIError::BAD_DATA_PACKET;
   }
 
-  buffer->container = std::move(frame.msg);
+  buffer->container = frame.msg;
   buffer->data_offset = 4;
   buffer->data_len = data_len;
   buffer->type = type;
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APINoiseFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -479,31 +500,29 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  // The message was encoded after frame_header_padding_ reserved bytes, the header goes in front of it
+  size_t payload_len = raw_buffer->size() - frame_header_padding_;
   size_t padding = 0;
   size_t msg_len = 4 + payload_len + padding;
-  size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
+  size_t mac_len = noise_cipherstate_get_mac_length(send_cipher_);
+  // Room for the MAC was reserved by create_buffer(), so this normally doesn't reallocate
+  raw_buffer->resize(raw_buffer->size() + padding + mac_len);
+  uint8_t *buf_start = raw_buffer->data();
 
-  tmpbuf[0] = 0x01;  // indicator
-  // tmpbuf[1], tmpbuf[2] to be set later
+  buf_start[0] = 0x01;  // indicator
+  // buf_start[1], buf_start[2] to be set later
   const uint8_t msg_offset = 3;
-  const uint8_t payload_offset = msg_offset + 4;
-  tmpbuf[msg_offset + 0] = (uint8_t) (type >> 8);  // type
-  tmpbuf[msg_offset + 1] = (uint8_t) type;
-  tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
-  tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
+  buf_start[msg_offset + 0] = (uint8_t) (type >> 8);  // type
+  buf_start[msg_offset + 1] = (uint8_t) type;
+  buf_start[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
+  buf_start[msg_offset + 3] = (uint8_t) payload_len;
   // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
+  std::fill(&buf_start[frame_header_padding_ + payload_len], &buf_start[raw_buffer->size()], 0);
 
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
-  noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
+  noise_buffer_set_inout(mbuf, &buf_start[msg_offset], msg_len, raw_buffer->size() - msg_offset);
   err = noise_cipherstate_encrypt(send_cipher_, &mbuf);
   if (err != 0) {
     state_ = State::FAILED;
@@ -512,15 +531,35 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   }
 
   size_t total_len = 3 + mbuf.size;
-  tmpbuf[1] = (uint8_t) (mbuf.size >> 8);
-  tmpbuf[2] = (uint8_t) mbuf.size;
+  buf_start[1] = (uint8_t) (mbuf.size >> 8);
+  buf_start[2] = (uint8_t) mbuf.size;
+
+  // queue the frame, it is written together with the others in flush()
+  tx_batch_.insert(tx_batch_.end(), buf_start, buf_start + total_len);
+  if (tx_batch_.size() >= TX_BATCH_MAX_SIZE)
+    return flush();
+  return APIError::OK;
+}
+APIError APINoiseFrameHelper::flush() {
+  if (tx_batch_.empty())
+    return APIError::OK;
+
+  // Frames queued while writing (e.g. log messages) go into a new batch instead of invalidating this one
+  std::vector<uint8_t> batch;
+  batch.swap(tx_batch_);
 
   struct iovec iov;
-  iov.iov_base = &tmpbuf[0];
-  iov.iov_len = total_len;
+  iov.iov_base = batch.data();
+  iov.iov_len = batch.size();
 
   // write raw to not have two packets sent if NAGLE disabled
-  return write_raw_(&iov, 1);
+  APIError aerr = write_raw_(&iov, 1);
+  if (tx_batch_.empty()) {
+    // keep the capacity for the next batch
+    batch.clear();
+    tx_batch_.swap(batch);
+  }
+  return aerr;
 }
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
@@ -641,6 +680,8 @@ APIError APINoiseFrameHelper::init_handshake_() {
   nid_.hybrid_id = NOISE_DH_NONE;
   nid_.hash_id = NOISE_HASH_SHA256;
   nid_.modifier_ids[0] = NOISE_MODIFIER_PSK0;
+  // Only ChaChaPoly runs per frame, SHA256 is used during the handshake. The ESP32 crypto accelerators implement
+  // AES and SHA but not ChaCha20/Poly1305, so frame encryption stays in software whichever backend is used.
 
   err = noise_handshakestate_new_by_id(&handshake_, &nid_, NOISE_ROLE_RESPONDER);
   if (err != 0) {
@@ -672,6 +713,20 @@ APIError APINoiseFrameHelper::init_handshake_() {
     HELPER_LOG("noise_handshakestate_start failed: %s", noise_err_to_str(err).c_str());
     return APIError::HANDSHAKESTATE_SETUP_FAILED;
   }
+
+  // Use the ephemeral key pair that was generated ahead of time, the handshake copies it instead of generating one.
+  // Otherwise it's generated when the response is written.
+  NoiseDHState *ephemeral = ctx_->take_ephemeral();
+  if (ephemeral != nullptr) {
+    NoiseDHState *fixed = noise_handshakestate_get_fixed_ephemeral_dh(handshake_);
+    err = fixed == nullptr ? NOISE_ERROR_INVALID_STATE : noise_dhstate_copy(fixed, ephemeral);
+    noise_dhstate_free(ephemeral);
+    if (err != 0) {
+      state_ = State::FAILED;
+      HELPER_LOG("noise_dhstate_copy failed: %s", noise_err_to_str(err).c_str());
+      return APIError::HANDSHAKESTATE_SETUP_FAILED;
+    }
+  }
   return APIError::OK;
 }
 
@@ -796,6 +851,8 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
     HELPER_LOG("Bad argument for try_read_frame_");
     return APIError::BAD_ARG;
   }
+  if (!socket_->ready())
+    return APIError::WOULD_BLOCK;
 
   // read header
   while (!rx_header_parsed_) {
@@ -843,8 +900,14 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
   }
   // header reading done
 
-  // reserve space for body
-  if (rx_buf_.size() != rx_header_parsed_len_) {
+  if (rx_header_parsed_len_ > USE_API_MAX_FRAME_SIZE) {
+    state_ = State::FAILED;
+    HELPER_LOG("Bad packet len: %u exceeds %u", (unsigned) rx_header_parsed_len_, (unsigned) USE_API_MAX_FRAME_SIZE);
+    return APIError::BAD_PACKET_SIZE;
+  }
+
+  // reserve space for body, rx_buf_ keeps its capacity so this only allocates when a bigger frame arrives
+  if (rx_buf_.size() < rx_header_parsed_len_) {
     rx_buf_.resize(rx_header_parsed_len_);
   }
 
@@ -873,11 +936,11 @@ APIError APIPlaintextFrameHelper::try_read_frame_(ParsedFrame *frame) {
 
   // uncomment for even more debugging
 #ifdef HELPER_LOG_PACKETS
-  ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_).c_str());
+  ESP_LOGVV(TAG, "Received frame: %s", format_hex_pretty(rx_buf_.data(), rx_header_parsed_len_).c_str());
 #endif
-  frame->msg = std::move(rx_buf_);
-  // consume msg
-  rx_buf_ = {};
+  frame->msg = rx_buf_.data();
+  frame->msg_len = rx_header_parsed_len_;
+  // consume msg, the data stays in rx_buf_ until the next frame is read
   rx_buf_len_ = 0;
   rx_header_buf_.clear();
   rx_header_parsed_ = false;
@@ -896,33 +959,92 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   if (aerr != APIError::OK)
     return aerr;
 
-  buffer->container = std::move(frame.msg);
+  buffer->container = frame.msg;
   buffer->data_offset = 0;
   buffer->data_len = rx_header_parsed_len_;
   buffer->type = rx_header_parsed_type_;
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+uint8_t *APIPlaintextFrameHelper::write_header_(std::vector<uint8_t> *raw_buffer, uint16_t type, size_t payload_len) {
+  uint8_t size_varint_len = ProtoSize::varint(static_cast<uint32_t>(payload_len));
+  uint8_t type_varint_len = ProtoSize::varint(static_cast<uint32_t>(type));
+  uint8_t total_header_len = 1 + size_varint_len + type_varint_len;
+  if (total_header_len > frame_header_padding_) {
+    HELPER_LOG("Packet too large to send: %u bytes", (unsigned) payload_len);
+    return nullptr;
+  }
+
+  uint8_t *buf_start = raw_buffer->data() + (frame_header_padding_ - total_header_len);
+  buf_start[0] = 0x00;  // indicator
+  ProtoVarInt(payload_len).encode_to_buffer_unchecked(buf_start + 1, size_varint_len);
+  ProtoVarInt(type).encode_to_buffer_unchecked(buf_start + 1 + size_varint_len, type_varint_len);
+  return buf_start;
+}
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  // The message was encoded after frame_header_padding_ reserved bytes, the header is written right in front of it
+  size_t payload_len = raw_buffer->size() - frame_header_padding_;
+  uint8_t *buf_start = this->write_header_(raw_buffer, type, payload_len);
+  if (buf_start == nullptr)
+    return APIError::BAD_ARG;
 
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  if (payload_len == 0) {
-    return write_raw_(iov, 1);
+  // queue the frame, it is written together with the others in flush()
+  tx_batch_.insert(tx_batch_.end(), buf_start, raw_buffer->data() + raw_buffer->size());
+  if (tx_batch_.size() >= TX_BATCH_MAX_SIZE)
+    return flush();
+  return APIError::OK;
+}
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer head, const uint8_t *data,
+                                                        size_t data_len, const uint8_t *tail, size_t tail_len) {
+  if (state_ != State::DATA) {
+    return APIError::BAD_STATE;
   }
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
 
-  return write_raw_(iov, 2);
+  std::vector<uint8_t> *raw_buffer = head.get_buffer();
+  size_t head_len = raw_buffer->size() - frame_header_padding_;
+  uint8_t *buf_start = this->write_header_(raw_buffer, type, head_len + data_len + tail_len);
+  if (buf_start == nullptr)
+    return APIError::BAD_ARG;
+
+  // queued frames go first to keep the stream in order
+  APIError aerr = flush();
+  if (aerr != APIError::OK)
+    return aerr;
+
+  // data is only copied if the socket can't take it all right away
+  struct iovec iov[3];
+  iov[0].iov_base = buf_start;
+  iov[0].iov_len = raw_buffer->data() + raw_buffer->size() - buf_start;
+  iov[1].iov_base = const_cast<uint8_t *>(data);
+  iov[1].iov_len = data_len;
+  iov[2].iov_base = const_cast<uint8_t *>(tail);
+  iov[2].iov_len = tail_len;
+  return write_raw_(iov, tail_len == 0 ? 2 : 3);
+}
+APIError APIPlaintextFrameHelper::flush() {
+  if (tx_batch_.empty())
+    return APIError::OK;
+
+  // Frames queued while writing (e.g. log messages) go into a new batch instead of invalidating this one
+  std::vector<uint8_t> batch;
+  batch.swap(tx_batch_);
+
+  struct iovec iov;
+  iov.iov_base = batch.data();
+  iov.iov_len = batch.size();
+
+  APIError aerr = write_raw_(&iov, 1);
+  if (tx_batch_.empty()) {
+    // keep the capacity for the next batch
+    batch.clear();
+    tx_batch_.swap(batch);
+  }
+  return aerr;
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
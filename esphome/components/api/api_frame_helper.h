@@ -12,12 +12,14 @@
 
 #include "api_noise_context.h"
 #include "esphome/components/socket/socket.h"
+#include "proto.h"
 
 namespace esphome {
 namespace api {
 
+/// A received message, the data points into the frame helper's receive buffer and is valid until the next read.
 struct ReadPacketBuffer {
-  std::vector<uint8_t> container;
+  uint8_t *container;
   uint16_t type;
   size_t data_offset;
   size_t data_len;
@@ -54,6 +56,7 @@ enum class APIError : int {
   HANDSHAKESTATE_SPLIT_FAILED = 1020,
   BAD_HANDSHAKE_ERROR_BYTE = 1021,
   CONNECTION_CLOSED = 1022,
+  BAD_PACKET_SIZE = 1023,
 };
 
 const char *api_error_to_str(APIError err);
@@ -65,26 +68,65 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /** Frame and send a message that was encoded into a buffer from ProtoService::create_buffer().
+   *
+   * The first frame_header_padding() bytes of the buffer are reserved for the frame header, so the message is sent
+   * without being copied.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
+  /** Frame and send a message whose encoding is split around a block of bytes owned by the caller.
+   *
+   * `head` is encoded like for write_protobuf_packet() and ends with the tag and length of the bytes field, `data` and
+   * `tail` follow it on the wire. Helpers that can send the pieces with one writev() override this, by default they
+   * are appended to `head`.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer head, const uint8_t *data, size_t data_len,
+                                         const uint8_t *tail, size_t tail_len);
+  /** Send the frames queued by write_protobuf_packet() in a single socket write.
+   *
+   * Frames are queued until this is called or the queue reaches about one TCP segment, so that messages sent in
+   * the same loop iteration share packets.
+   */
+  virtual APIError flush() = 0;
+  /// Bytes the socket couldn't take yet, a growing backlog means the network can't keep up.
+  virtual size_t tx_backlog() const = 0;
+  /// Bytes to reserve in front of an encoded message for the frame header.
+  uint8_t frame_header_padding() const { return this->frame_header_padding_; }
+  /// Bytes to reserve after an encoded message, e.g. for the MAC of an encrypted frame.
+  uint8_t frame_footer_size() const { return this->frame_footer_size_; }
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
   virtual APIError shutdown(int how) = 0;
   // Give this helper a name for logging
   virtual void set_log_info(std::string info) = 0;
+
+ protected:
+  uint8_t frame_header_padding_{0};
+  uint8_t frame_footer_size_{0};
+  /// Complete frames waiting for flush().
+  std::vector<uint8_t> tx_batch_;
 };
 
 #ifdef USE_API_NOISE
 class APINoiseFrameHelper : public APIFrameHelper {
  public:
   APINoiseFrameHelper(std::unique_ptr<socket::Socket> socket, std::shared_ptr<APINoiseContext> ctx)
-      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {}
+      : socket_(std::move(socket)), ctx_(std::move(std::move(ctx))) {
+    // Indicator (1), encrypted size (2), type (2) and data length (2)
+    this->frame_header_padding_ = 7;
+    // MAC of the cipher
+    this->frame_footer_size_ = 16;
+  }
   ~APINoiseFrameHelper() override;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  using APIFrameHelper::write_protobuf_packet;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  APIError flush() override;
+  size_t tx_backlog() const override { return this->tx_buf_.size(); }
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -95,8 +137,10 @@ class APINoiseFrameHelper : public APIFrameHelper {
   void set_log_info(std::string info) override { info_ = std::move(info); }
 
  protected:
+  /// View into rx_buf_, valid until the next try_read_frame_() call.
   struct ParsedFrame {
-    std::vector<uint8_t> msg;
+    uint8_t *msg;
+    size_t msg_len;
   };
 
   APIError state_action_();
@@ -141,13 +185,20 @@ class APINoiseFrameHelper : public APIFrameHelper {
 #ifdef USE_API_PLAINTEXT
 class APIPlaintextFrameHelper : public APIFrameHelper {
  public:
-  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {}
+  APIPlaintextFrameHelper(std::unique_ptr<socket::Socket> socket) : socket_(std::move(socket)) {
+    // Indicator (1), size varint (up to 3) and type varint (up to 2)
+    this->frame_header_padding_ = 6;
+  }
   ~APIPlaintextFrameHelper() override = default;
   APIError init() override;
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer head, const uint8_t *data, size_t data_len,
+                                 const uint8_t *tail, size_t tail_len) override;
+  APIError flush() override;
+  size_t tx_backlog() const override { return this->tx_buf_.size(); }
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -158,10 +209,14 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   void set_log_info(std::string info) override { info_ = std::move(info); }
 
  protected:
+  /// View into rx_buf_, valid until the next try_read_frame_() call.
   struct ParsedFrame {
-    std::vector<uint8_t> msg;
+    uint8_t *msg;
+    size_t msg_len;
   };
 
+  /// Write the frame header in front of a message encoded after frame_header_padding_ bytes, returns its start.
+  uint8_t *write_header_(std::vector<uint8_t> *raw_buffer, uint16_t type, size_t payload_len);
   APIError try_read_frame_(ParsedFrame *frame);
   APIError try_send_tx_buf_();
   APIError write_raw_(const struct iovec *iov, int iovcnt);
@@ -0,0 +1,44 @@
+#include "api_noise_context.h"
+
+#ifdef USE_API_NOISE
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace api {
+
+static const char *const TAG = "api.noise";
+
+APINoiseContext::~APINoiseContext() {
+  if (this->ephemeral_ != nullptr)
+    noise_dhstate_free(this->ephemeral_);
+}
+
+void APINoiseContext::prepare_ephemeral() {
+  if (this->ephemeral_ != nullptr)
+    return;
+  NoiseDHState *dh;
+  int err = noise_dhstate_new_by_id(&dh, NOISE_DH_CURVE25519);
+  if (err != NOISE_ERROR_NONE) {
+    ESP_LOGW(TAG, "noise_dhstate_new_by_id failed: %d", err);
+    return;
+  }
+  err = noise_dhstate_generate_keypair(dh);
+  if (err != NOISE_ERROR_NONE) {
+    ESP_LOGW(TAG, "noise_dhstate_generate_keypair failed: %d", err);
+    noise_dhstate_free(dh);
+    return;
+  }
+  this->ephemeral_ = dh;
+}
+
+NoiseDHState *APINoiseContext::take_ephemeral() {
+  NoiseDHState *dh = this->ephemeral_;
+  this->ephemeral_ = nullptr;
+  return dh;
+}
+
+}  // namespace api
+}  // namespace esphome
+
+#endif  // USE_API_NOISE
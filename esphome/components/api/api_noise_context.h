@@ -3,6 +3,10 @@
 #include <array>
 #include "esphome/core/defines.h"
 
+#ifdef USE_API_NOISE
+#include "noise/protocol.h"
+#endif  // USE_API_NOISE
+
 namespace esphome {
 namespace api {
 
@@ -11,11 +15,22 @@ using psk_t = std::array<uint8_t, 32>;
 
 class APINoiseContext {
  public:
+  ~APINoiseContext();
   void set_psk(psk_t psk) { psk_ = psk; }
   const psk_t &get_psk() const { return psk_; }
 
+  /** Generate the ephemeral key pair for the next handshake, unless one is ready already.
+   *
+   * Generating it is one of the two Curve25519 operations of a handshake and takes tens of milliseconds on chips like
+   * the ESP8266, so it's done while no client is waiting. Every key pair is still only used for a single handshake.
+   */
+  void prepare_ephemeral();
+  /// Take the prepared ephemeral key pair, nullptr if there is none. The caller has to free it.
+  NoiseDHState *take_ephemeral();
+
  protected:
   psk_t psk_;
+  NoiseDHState *ephemeral_{nullptr};
 };
 #endif  // USE_API_NOISE
 
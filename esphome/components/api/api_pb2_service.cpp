@@ -56,6 +56,12 @@ bool APIServerConnectionBase::send_list_entities_done_response(const ListEntitie
 #endif
   return this->send_message_<ListEntitiesDoneResponse>(msg, 19);
 }
+bool APIServerConnectionBase::send_state_sync_response(const StateSyncResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_state_sync_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<StateSyncResponse>(msg, 101);
+}
 #ifdef USE_BINARY_SENSOR
 bool APIServerConnectionBase::send_list_entities_binary_sensor_response(const ListEntitiesBinarySensorResponse &msg) {
 #ifdef HAS_PROTO_MESSAGE_DUMP
@@ -495,6 +501,26 @@ bool APIServerConnectionBase::send_alarm_control_panel_state_response(const Alar
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
 #endif
+#ifdef USE_RUNTIME_STATS
+#endif
+#ifdef USE_RUNTIME_STATS
+bool APIServerConnectionBase::send_runtime_stats_response(const RuntimeStatsResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_runtime_stats_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<RuntimeStatsResponse>(msg, 98);
+}
+#endif
+#ifdef USE_HEAP_TRACKING
+#endif
+#ifdef USE_HEAP_TRACKING
+bool APIServerConnectionBase::send_heap_stats_response(const HeapStatsResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_heap_stats_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<HeapStatsResponse>(msg, 100);
+}
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -913,6 +939,28 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       ESP_LOGVV(TAG, "on_alarm_control_panel_command_request: %s", msg.dump().c_str());
 #endif
       this->on_alarm_control_panel_command_request(msg);
+#endif
+      break;
+    }
+    case 97: {
+#ifdef USE_RUNTIME_STATS
+      RuntimeStatsRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_runtime_stats_request: %s", msg.dump().c_str());
+#endif
+      this->on_runtime_stats_request(msg);
+#endif
+      break;
+    }
+    case 99: {
+#ifdef USE_HEAP_TRACKING
+      HeapStatsRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_heap_stats_request: %s", msg.dump().c_str());
+#endif
+      this->on_heap_stats_request(msg);
 #endif
       break;
     }
@@ -1338,6 +1386,38 @@ void APIServerConnection::on_alarm_control_panel_command_request(const AlarmCont
   this->alarm_control_panel_command(msg);
 }
 #endif
+#ifdef USE_RUNTIME_STATS
+void APIServerConnection::on_runtime_stats_request(const RuntimeStatsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  RuntimeStatsResponse ret = this->runtime_stats(msg);
+  if (!this->send_runtime_stats_response(ret)) {
+    this->on_fatal_error();
+  }
+}
+#endif
+#ifdef USE_HEAP_TRACKING
+void APIServerConnection::on_heap_stats_request(const HeapStatsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  HeapStatsResponse ret = this->heap_stats(msg);
+  if (!this->send_heap_stats_response(ret)) {
+    this->on_fatal_error();
+  }
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -27,6 +27,7 @@ class APIServerConnectionBase : public ProtoService {
   virtual void on_list_entities_request(const ListEntitiesRequest &value){};
   bool send_list_entities_done_response(const ListEntitiesDoneResponse &msg);
   virtual void on_subscribe_states_request(const SubscribeStatesRequest &value){};
+  bool send_state_sync_response(const StateSyncResponse &msg);
 #ifdef USE_BINARY_SENSOR
   bool send_list_entities_binary_sensor_response(const ListEntitiesBinarySensorResponse &msg);
 #endif
@@ -248,6 +249,18 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   virtual void on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &value){};
+#endif
+#ifdef USE_RUNTIME_STATS
+  virtual void on_runtime_stats_request(const RuntimeStatsRequest &value){};
+#endif
+#ifdef USE_RUNTIME_STATS
+  bool send_runtime_stats_response(const RuntimeStatsResponse &msg);
+#endif
+#ifdef USE_HEAP_TRACKING
+  virtual void on_heap_stats_request(const HeapStatsRequest &value){};
+#endif
+#ifdef USE_HEAP_TRACKING
+  bool send_heap_stats_response(const HeapStatsResponse &msg);
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -336,6 +349,12 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   virtual void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) = 0;
+#endif
+#ifdef USE_RUNTIME_STATS
+  virtual RuntimeStatsResponse runtime_stats(const RuntimeStatsRequest &msg) = 0;
+#endif
+#ifdef USE_HEAP_TRACKING
+  virtual HeapStatsResponse heap_stats(const HeapStatsRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -420,6 +439,12 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_ALARM_CONTROL_PANEL
   void on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &msg) override;
 #endif
+#ifdef USE_RUNTIME_STATS
+  void on_runtime_stats_request(const RuntimeStatsRequest &msg) override;
+#endif
+#ifdef USE_HEAP_TRACKING
+  void on_heap_stats_request(const HeapStatsRequest &msg) override;
+#endif
 };
 
 }  // namespace api
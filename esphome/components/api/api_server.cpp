@@ -2,6 +2,7 @@
 #include "api_connection.h"
 #include "esphome/core/application.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 #include "esphome/core/version.h"
@@ -24,6 +25,8 @@ static const char *const TAG = "api";
 void APIServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Home Assistant API server...");
   this->setup_controller();
+  // never 0, that is what a client that never synced sends
+  this->state_boot_id_ = random_uint32() | 1;
   socket_ = socket::socket_ip(SOCK_STREAM, 0);
   if (socket_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket.");
@@ -68,17 +71,28 @@ void APIServer::setup() {
 
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      for (auto &c : this->clients_) {
-        if (!c->remove_)
-          c->send_log_message(level, tag, message);
-      }
-    });
+    // Nobody is subscribed yet, loop() raises the level when a client subscribes
+    this->log_callback_handle_ = logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          for (auto &c : this->clients_) {
+            if (!c->remove_)
+              c->send_log_message(level, tag, message);
+          }
+        },
+        ESPHOME_LOG_LEVEL_NONE);
   }
 #endif
 
   this->last_connected_ = millis();
 
+#ifdef USE_API_STATE_BROADCAST
+#ifdef USE_API_NOISE
+  this->state_broadcast_.set_psk(this->noise_ctx_->get_psk());
+#endif
+  if (!this->state_broadcast_.setup())
+    ESP_LOGW(TAG, "State broadcast could not be set up");
+#endif
+
 #ifdef USE_ESP32_CAMERA
   if (esp32_camera::global_esp32_camera != nullptr && !esp32_camera::global_esp32_camera->is_internal()) {
     esp32_camera::global_esp32_camera->add_image_callback(
@@ -92,8 +106,9 @@ void APIServer::setup() {
 #endif
 }
 void APIServer::loop() {
+  HeapTagScope heap_tag(HeapTag::API);
   // Accept new clients
-  while (true) {
+  while (this->socket_->ready()) {
     struct sockaddr_storage source_addr;
     socklen_t addr_len = sizeof(source_addr);
     auto sock = socket_->accept((struct sockaddr *) &source_addr, &addr_len);
@@ -120,6 +135,29 @@ void APIServer::loop() {
     client->loop();
   }
 
+#ifdef USE_LOGGER
+  if (logger::global_logger != nullptr) {
+    int log_level = ESPHOME_LOG_LEVEL_NONE;
+    for (auto &client : this->clients_) {
+      if (!client->remove_)
+        log_level = std::max(log_level, client->log_subscription_);
+    }
+    if (log_level != this->log_level_) {
+      this->log_level_ = log_level;
+      logger::global_logger->set_log_callback_level(this->log_callback_handle_, log_level);
+    }
+  }
+#endif
+
+#ifdef USE_API_NOISE
+  // Generate the ephemeral key of the next handshake now, so a reconnecting client doesn't have to wait for it
+  this->noise_ctx_->prepare_ephemeral();
+#endif
+#ifdef USE_API_STATE_BROADCAST
+  // everything that changed during this iteration goes out in one datagram
+  this->state_broadcast_.flush();
+#endif
+
   if (this->reboot_timeout_ != 0) {
     const uint32_t now = millis();
     if (!this->is_connected()) {
@@ -142,6 +180,10 @@ void APIServer::dump_config() {
 #else
   ESP_LOGCONFIG(TAG, "  Using noise encryption: NO");
 #endif
+#ifdef USE_API_STATE_BROADCAST
+  ESP_LOGCONFIG(TAG, "  State broadcast: %s:%u", this->state_broadcast_.get_address().c_str(),
+                this->state_broadcast_.get_port());
+#endif
 }
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
@@ -173,12 +215,74 @@ bool APIServer::check_password(const std::string &password) const {
   return result == 0;
 }
 void APIServer::handle_disconnect(APIConnection *conn) {}
+
+#ifdef USE_API_LIST_ENTITIES_CACHE
+bool APIServer::start_list_entities_cache() {
+  if (this->list_entities_cache_building_ || this->list_entities_cache_complete_)
+    return false;
+  this->list_entities_cache_building_ = true;
+  this->list_entities_cache_.clear();
+  return true;
+}
+void APIServer::add_to_list_entities_cache(uint16_t message_type, const uint8_t *data, size_t len) {
+  if (!this->list_entities_cache_building_)
+    return;
+  if (len > 0xFFFF) {
+    // doesn't fit the entry header, finish_list_entities_cache() then discards the cache
+    this->list_entities_cache_building_ = false;
+    return;
+  }
+  auto &cache = this->list_entities_cache_;
+  cache.push_back(message_type & 0xFF);
+  cache.push_back(message_type >> 8);
+  cache.push_back(len & 0xFF);
+  cache.push_back(len >> 8);
+  cache.insert(cache.end(), data, data + len);
+}
+void APIServer::finish_list_entities_cache(bool complete) {
+  this->list_entities_cache_complete_ = complete && this->list_entities_cache_building_;
+  this->list_entities_cache_building_ = false;
+  if (this->list_entities_cache_complete_) {
+    this->list_entities_cache_.shrink_to_fit();
+    ESP_LOGD(TAG, "Cached entity list (%u bytes)", (unsigned) this->list_entities_cache_.size());
+  } else {
+    this->list_entities_cache_.clear();
+    this->list_entities_cache_.shrink_to_fit();
+  }
+}
+#endif
+static bool entity_version_less(const std::pair<EntityBase *, uint32_t> &entry, EntityBase *entity) {
+  return entry.first < entity;
+}
+
+void APIServer::bump_state_version_(EntityBase *entity) {
+  this->state_version_++;
+  auto it = std::lower_bound(this->entity_state_versions_.begin(), this->entity_state_versions_.end(), entity,
+                             entity_version_less);
+  if (it != this->entity_state_versions_.end() && it->first == entity) {
+    it->second = this->state_version_;
+  } else {
+    this->entity_state_versions_.insert(it, {entity, this->state_version_});
+  }
+}
+
+uint32_t APIServer::get_entity_state_version(EntityBase *entity) const {
+  auto it = std::lower_bound(this->entity_state_versions_.begin(), this->entity_state_versions_.end(), entity,
+                             entity_version_less);
+  return it != this->entity_state_versions_.end() && it->first == entity ? it->second : 0;
+}
+
 #ifdef USE_BINARY_SENSOR
 void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 21);  // BinarySensorStateResponse
   for (auto &c : this->clients_)
     c->send_binary_sensor_state(obj, state);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(21, APIConnection::make_binary_sensor_state(obj, state));
+#endif
 }
 #endif
 
@@ -186,8 +290,13 @@ void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool s
 void APIServer::on_cover_update(cover::Cover *obj) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 22);  // CoverStateResponse
   for (auto &c : this->clients_)
     c->send_cover_state(obj);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(22, APIConnection::make_cover_state(obj));
+#endif
 }
 #endif
 
@@ -195,8 +304,13 @@ void APIServer::on_cover_update(cover::Cover *obj) {
 void APIServer::on_fan_update(fan::Fan *obj) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 23);  // FanStateResponse
   for (auto &c : this->clients_)
     c->send_fan_state(obj);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(23, APIConnection::make_fan_state(obj));
+#endif
 }
 #endif
 
@@ -204,8 +318,13 @@ void APIServer::on_fan_update(fan::Fan *obj) {
 void APIServer::on_light_update(light::LightState *obj) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 24);  // LightStateResponse
   for (auto &c : this->clients_)
     c->send_light_state(obj);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(24, APIConnection::make_light_state(obj));
+#endif
 }
 #endif
 
@@ -213,8 +332,13 @@ void APIServer::on_light_update(light::LightState *obj) {
 void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 25);  // SensorStateResponse
   for (auto &c : this->clients_)
     c->send_sensor_state(obj, state);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(25, APIConnection::make_sensor_state(obj, state));
+#endif
 }
 #endif
 
@@ -222,8 +346,13 @@ void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
 void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 26);  // SwitchStateResponse
   for (auto &c : this->clients_)
     c->send_switch_state(obj, state);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(26, APIConnection::make_switch_state(obj, state));
+#endif
 }
 #endif
 
@@ -231,8 +360,13 @@ void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
 void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 27);  // TextSensorStateResponse
   for (auto &c : this->clients_)
     c->send_text_sensor_state(obj, state);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(27, APIConnection::make_text_sensor_state(obj, state));
+#endif
 }
 #endif
 
@@ -240,8 +374,13 @@ void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::s
 void APIServer::on_climate_update(climate::Climate *obj) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 47);  // ClimateStateResponse
   for (auto &c : this->clients_)
     c->send_climate_state(obj);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(47, APIConnection::make_climate_state(obj));
+#endif
 }
 #endif
 
@@ -249,8 +388,13 @@ void APIServer::on_climate_update(climate::Climate *obj) {
 void APIServer::on_number_update(number::Number *obj, float state) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 50);  // NumberStateResponse
   for (auto &c : this->clients_)
     c->send_number_state(obj, state);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(50, APIConnection::make_number_state(obj, state));
+#endif
 }
 #endif
 
@@ -258,8 +402,13 @@ void APIServer::on_number_update(number::Number *obj, float state) {
 void APIServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 53);  // SelectStateResponse
   for (auto &c : this->clients_)
     c->send_select_state(obj, state);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(53, APIConnection::make_select_state(obj, state));
+#endif
 }
 #endif
 
@@ -267,8 +416,13 @@ void APIServer::on_select_update(select::Select *obj, const std::string &state,
 void APIServer::on_lock_update(lock::Lock *obj) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 59);  // LockStateResponse
   for (auto &c : this->clients_)
     c->send_lock_state(obj, obj->state);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(59, APIConnection::make_lock_state(obj, obj->state));
+#endif
 }
 #endif
 
@@ -276,8 +430,13 @@ void APIServer::on_lock_update(lock::Lock *obj) {
 void APIServer::on_media_player_update(media_player::MediaPlayer *obj) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 64);  // MediaPlayerStateResponse
   for (auto &c : this->clients_)
     c->send_media_player_state(obj);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(64, APIConnection::make_media_player_state(obj));
+#endif
 }
 #endif
 
@@ -293,13 +452,40 @@ void APIServer::send_homeassistant_service_call(const HomeassistantServiceRespon
 }
 
 APIServer::APIServer() { global_api_server = this; }
+/// FNV-1 over the entity ID, a separator and the attribute, without building the joined string.
+static uint32_t home_assistant_state_key(const std::string &entity_id, const std::string &attribute) {
+  uint32_t hash = 2166136261UL;
+  for (char c : entity_id)
+    hash = (hash * 16777619UL) ^ static_cast<uint8_t>(c);
+  hash *= 16777619UL;
+  for (char c : attribute)
+    hash = (hash * 16777619UL) ^ static_cast<uint8_t>(c);
+  return hash;
+}
 void APIServer::subscribe_home_assistant_state(std::string entity_id, optional<std::string> attribute,
                                                std::function<void(std::string)> f) {
+  const uint32_t key = home_assistant_state_key(entity_id, attribute.value());
+  const std::pair<uint32_t, uint16_t> entry(key, this->state_subs_.size());
   this->state_subs_.push_back(HomeAssistantStateSubscription{
       .entity_id = std::move(entity_id),
       .attribute = std::move(attribute),
       .callback = std::move(f),
+      .key = key,
   });
+  this->state_subs_index_.insert(
+      std::upper_bound(this->state_subs_index_.begin(), this->state_subs_index_.end(), entry), entry);
+}
+void APIServer::dispatch_home_assistant_state(const std::string &entity_id, const std::string &attribute,
+                                              const std::string &state) {
+  const uint32_t key = home_assistant_state_key(entity_id, attribute);
+  auto it = std::lower_bound(this->state_subs_index_.begin(), this->state_subs_index_.end(),
+                             std::pair<uint32_t, uint16_t>(key, 0));
+  for (; it != this->state_subs_index_.end() && it->first == key; ++it) {
+    auto &sub = this->state_subs_[it->second];
+    // the strings are only compared to rule out hash collisions
+    if (sub.entity_id == entity_id && sub.attribute.value() == attribute)
+      sub.callback(state);
+  }
 }
 const std::vector<APIServer::HomeAssistantStateSubscription> &APIServer::get_state_subs() const {
   return this->state_subs_;
@@ -315,9 +501,32 @@ void APIServer::request_time() {
 }
 #endif
 bool APIServer::is_connected() const { return !this->clients_.empty(); }
+size_t APIServer::get_tx_backlog() const {
+  size_t backlog = 0;
+  for (const auto &client : this->clients_)
+    backlog += client->get_tx_backlog();
+  return backlog;
+}
+size_t APIServer::get_deferred_states() const {
+  size_t deferred = 0;
+  for (const auto &client : this->clients_)
+    deferred += client->deferred_states_.size();
+  return deferred;
+}
+bool APIServer::are_states_sent() const {
+  if (this->clients_.empty())
+    return false;
+  for (const auto &client : this->clients_) {
+    if (!client->state_subscription_ || client->initial_state_iterator_.is_active() ||
+        !client->deferred_states_.empty() || client->get_tx_backlog() != 0)
+      return false;
+  }
+  return true;
+}
 void APIServer::on_shutdown() {
   for (auto &c : this->clients_) {
     c->send_disconnect_request(DisconnectRequest());
+    c->flush_queued_messages_();
   }
   delay(10);
 }
@@ -342,8 +551,13 @@ void APIServer::stop_voice_assistant() {
 void APIServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
   if (obj->is_internal())
     return;
+  this->bump_state_version_(obj);
+  SharedMessageScope shared(this, 95);  // AlarmControlPanelStateResponse
   for (auto &c : this->clients_)
     c->send_alarm_control_panel_state(obj);
+#ifdef USE_API_STATE_BROADCAST
+  this->state_broadcast_.add(95, APIConnection::make_alarm_control_panel_state(obj));
+#endif
 }
 #endif
 
@@ -11,6 +11,7 @@
 #include "subscribe_state.h"
 #include "user_services.h"
 #include "api_noise_context.h"
+#include "api_state_broadcast.h"
 
 #include <vector>
 
@@ -31,6 +32,13 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+#ifdef USE_API_STATE_BROADCAST
+  /// Also push state changes to this UDP address, unicast or multicast, see APIStateBroadcast.
+  void set_state_broadcast(const std::string &address, uint16_t port) {
+    this->state_broadcast_.set_address(address);
+    this->state_broadcast_.set_port(port);
+  }
+#endif
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -90,31 +98,122 @@ class APIServer : public Component, public Controller {
 #endif
 
   bool is_connected() const;
+  /// Bytes all clients' sockets haven't accepted yet.
+  size_t get_tx_backlog() const;
+  /// Whether a client subscribed to states and every state has been handed to the network stack.
+  bool are_states_sent() const;
+  /// Messages written to the sockets of all clients since boot.
+  uint32_t get_messages_sent() const { return this->messages_sent_; }
+  /// States that had to wait for a full socket, and those that then replaced a waiting state of the same entity.
+  uint32_t get_states_deferred() const { return this->states_deferred_; }
+  uint32_t get_states_coalesced() const { return this->states_coalesced_; }
+  /// States waiting for a full socket right now, over all clients.
+  size_t get_deferred_states() const;
+
+  /// Random for every boot, a state version is only meaningful to a client together with the boot id it came with.
+  uint32_t get_state_boot_id() const { return this->state_boot_id_; }
+  /// Counts the state updates since boot.
+  uint32_t get_state_version() const { return this->state_version_; }
+  /// The state version of the last update of the entity, 0 if it wasn't updated since boot.
+  uint32_t get_entity_state_version(EntityBase *entity) const;
 
   struct HomeAssistantStateSubscription {
     std::string entity_id;
     optional<std::string> attribute;
     std::function<void(std::string)> callback;
+    /// Hash of entity_id and attribute, incoming states are looked up by it.
+    uint32_t key;
   };
 
   void subscribe_home_assistant_state(std::string entity_id, optional<std::string> attribute,
                                       std::function<void(std::string)> f);
   const std::vector<HomeAssistantStateSubscription> &get_state_subs() const;
+  /// Hand a state from Home Assistant to the subscriptions of the entity and attribute, found through the index.
+  void dispatch_home_assistant_state(const std::string &entity_id, const std::string &attribute,
+                                     const std::string &state);
   const std::vector<UserServiceDescriptor *> &get_user_services() const { return this->user_services_; }
 
+  /// Encoding of one state message, reused by every connection while a state update is sent to all of them.
+  struct SharedMessage {
+    /// Type of the message being shared, 0 while no update is sent.
+    uint32_t type{0};
+    bool encoded{false};
+    std::vector<uint8_t> payload;
+  };
+  /// Returns the shared encoding if a message of this type is currently sent to all connections.
+  SharedMessage *get_shared_message(uint32_t message_type) {
+    if (this->shared_message_.type == 0 || this->shared_message_.type != message_type)
+      return nullptr;
+    return &this->shared_message_;
+  }
+
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  /// Encoded ListEntities*Response messages shared by all connections, nullptr until one full list was recorded.
+  const std::vector<uint8_t> *get_list_entities_cache() const {
+    return this->list_entities_cache_complete_ ? &this->list_entities_cache_ : nullptr;
+  }
+  /// Returns true if the caller should record its list into the cache, only one connection does at a time.
+  bool start_list_entities_cache();
+  void add_to_list_entities_cache(uint16_t message_type, const uint8_t *data, size_t len);
+  void finish_list_entities_cache(bool complete);
+#endif
+
  protected:
+  friend APIConnection;
+
+  void bump_state_version_(EntityBase *entity);
+
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
+  uint32_t messages_sent_{0};
+  uint32_t states_deferred_{0};
+  uint32_t states_coalesced_{0};
+#ifdef USE_LOGGER
+  size_t log_callback_handle_{0};
+  /// Most verbose level any client subscribed to, the level of our log callback.
+  int log_level_{ESPHOME_LOG_LEVEL_NONE};
+#endif
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
+  /// Pairs of key and index into state_subs_, sorted by key, so an incoming state costs a binary search.
+  std::vector<std::pair<uint32_t, uint16_t>> state_subs_index_;
   std::vector<UserServiceDescriptor *> user_services_;
+  uint32_t state_boot_id_{0};
+  uint32_t state_version_{0};
+  /// Pairs of entity and the state version of its last update, sorted by entity.
+  std::vector<std::pair<EntityBase *, uint32_t>> entity_state_versions_;
+  SharedMessage shared_message_;
+
+  /// Shares the encoding of message_type between the connections until it goes out of scope.
+  class SharedMessageScope {
+   public:
+    SharedMessageScope(APIServer *server, uint32_t message_type) : server_(server) {
+      // a single connection has nothing to share with
+      if (server->clients_.size() < 2)
+        return;
+      server->shared_message_.type = message_type;
+      server->shared_message_.encoded = false;
+    }
+    ~SharedMessageScope() { this->server_->shared_message_.type = 0; }
+
+   protected:
+    APIServer *server_;
+  };
+#ifdef USE_API_LIST_ENTITIES_CACHE
+  std::vector<uint8_t> list_entities_cache_;
+  bool list_entities_cache_building_{false};
+  bool list_entities_cache_complete_{false};
+#endif
 
 #ifdef USE_API_NOISE
   std::shared_ptr<APINoiseContext> noise_ctx_ = std::make_shared<APINoiseContext>();
 #endif  // USE_API_NOISE
+#ifdef USE_API_STATE_BROADCAST
+  APIStateBroadcast state_broadcast_;
+#endif
 };
 
 extern APIServer *global_api_server;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
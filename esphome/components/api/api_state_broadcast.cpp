@@ -0,0 +1,152 @@
+#include "api_state_broadcast.h"
+
+#ifdef USE_API_STATE_BROADCAST
+
+#include <cerrno>
+
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace api {
+
+static const char *const TAG = "api.broadcast";
+
+static const uint8_t BROADCAST_PLAINTEXT = 0x00;
+static const uint8_t BROADCAST_ENCRYPTED = 0x01;
+static const size_t BROADCAST_SALT_SIZE = 16;
+static const size_t BROADCAST_MAC_SIZE = 16;
+
+bool APIStateBroadcast::setup() {
+#ifdef USE_API_NOISE
+  if (!this->rekey_())
+    return false;
+#endif
+  this->destination_len_ = socket::set_sockaddr(reinterpret_cast<struct sockaddr *>(&this->destination_),
+                                                sizeof(this->destination_), this->address_, this->port_);
+  if (this->destination_len_ == 0) {
+    ESP_LOGW(TAG, "Invalid address %s", this->address_.c_str());
+    return false;
+  }
+  auto sock = socket::socket_ip(SOCK_DGRAM, IPPROTO_IP);
+  if (sock == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket");
+    return false;
+  }
+  if (sock->setblocking(false) != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", errno);
+    return false;
+  }
+  this->socket_ = std::move(sock);
+  this->payload_.reserve(MAX_DATAGRAM_SIZE);
+  this->payload_.resize(this->header_size_());
+  return true;
+}
+
+size_t APIStateBroadcast::header_size_() const {
+#ifdef USE_API_NOISE
+  return 1 + BROADCAST_SALT_SIZE + 4;
+#else
+  return 1 + 4;
+#endif
+}
+
+size_t APIStateBroadcast::trailer_size_() const {
+#ifdef USE_API_NOISE
+  return BROADCAST_MAC_SIZE;
+#else
+  return 0;
+#endif
+}
+
+void APIStateBroadcast::write_header_() {
+  uint8_t *header = this->payload_.data();
+#ifdef USE_API_NOISE
+  *header++ = BROADCAST_ENCRYPTED;
+  memcpy(header, this->salt_, BROADCAST_SALT_SIZE);
+  header += BROADCAST_SALT_SIZE;
+#else
+  *header++ = BROADCAST_PLAINTEXT;
+#endif
+  *header++ = this->sequence_ >> 24;
+  *header++ = this->sequence_ >> 16;
+  *header++ = this->sequence_ >> 8;
+  *header++ = this->sequence_;
+}
+
+void APIStateBroadcast::flush() {
+  const size_t header_size = this->header_size_();
+  if (this->socket_ == nullptr || this->payload_.size() == header_size)
+    return;
+  this->write_header_();
+
+#ifdef USE_API_NOISE
+  size_t len = this->payload_.size() - header_size;
+  this->payload_.resize(this->payload_.size() + BROADCAST_MAC_SIZE);
+  NoiseBuffer mbuf;
+  noise_buffer_init(mbuf);
+  noise_buffer_set_inout(mbuf, this->payload_.data() + header_size, len, len + BROADCAST_MAC_SIZE);
+  noise_cipherstate_set_nonce(this->cipher_, this->sequence_);
+  int err = noise_cipherstate_encrypt_with_ad(this->cipher_, this->payload_.data(), header_size, &mbuf);
+  if (err != NOISE_ERROR_NONE) {
+    ESP_LOGW(TAG, "noise_cipherstate_encrypt_with_ad failed: %d", err);
+    this->payload_.resize(header_size);
+    return;
+  }
+#endif
+
+  ssize_t sent = this->socket_->sendto(this->payload_.data(), this->payload_.size(), 0,
+                                       reinterpret_cast<struct sockaddr *>(&this->destination_),
+                                       this->destination_len_);
+  if (sent < 0)
+    ESP_LOGV(TAG, "sendto failed: errno %d", errno);
+  this->payload_.resize(header_size);
+
+  this->sequence_++;
+#ifdef USE_API_NOISE
+  // Used up every nonce of this key
+  if (this->sequence_ == 0 && !this->rekey_())
+    this->socket_ = nullptr;
+#endif
+}
+
+#ifdef USE_API_NOISE
+bool APIStateBroadcast::rekey_() {
+  if (!random_bytes(this->salt_, BROADCAST_SALT_SIZE)) {
+    ESP_LOGW(TAG, "Failed to acquire random bytes");
+    return false;
+  }
+  NoiseHashState *hash;
+  int err = noise_hashstate_new_by_id(&hash, NOISE_HASH_SHA256);
+  if (err != NOISE_ERROR_NONE) {
+    ESP_LOGW(TAG, "noise_hashstate_new_by_id failed: %d", err);
+    return false;
+  }
+  uint8_t key[32];
+  uint8_t unused[32];
+  noise_hashstate_hkdf(hash, this->psk_.data(), this->psk_.size(), this->salt_, BROADCAST_SALT_SIZE, key, sizeof(key),
+                       unused, sizeof(unused));
+  noise_hashstate_free(hash);
+
+  if (this->cipher_ == nullptr) {
+    err = noise_cipherstate_new_by_id(&this->cipher_, NOISE_CIPHER_CHACHAPOLY);
+    if (err != NOISE_ERROR_NONE) {
+      ESP_LOGW(TAG, "noise_cipherstate_new_by_id failed: %d", err);
+      return false;
+    }
+  }
+  err = noise_cipherstate_init_key(this->cipher_, key, sizeof(key));
+  memset(key, 0, sizeof(key));
+  memset(unused, 0, sizeof(unused));
+  if (err != NOISE_ERROR_NONE) {
+    ESP_LOGW(TAG, "noise_cipherstate_init_key failed: %d", err);
+    return false;
+  }
+  return true;
+}
+#endif
+
+}  // namespace api
+}  // namespace esphome
+
+#endif  // USE_API_STATE_BROADCAST
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_API_STATE_BROADCAST
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "esphome/components/socket/socket.h"
+#include "api_noise_context.h"
+#include "proto.h"
+
+namespace esphome {
+namespace api {
+
+/** Pushes state messages to a UDP address, for any number of listeners that only receive.
+ *
+ * The messages are the *StateResponse messages connections get. The ones added during a loop iteration are sent
+ * together by flush(), in more than one datagram only when they don't fit into one:
+ *
+ *   plaintext: 0x00, sequence number (4 bytes), messages
+ *   encrypted: 0x01, salt (16 bytes), sequence number (4 bytes), encrypted messages, MAC (16 bytes)
+ *
+ * Every message is a varint size, a varint message type and the encoded message, like in a plaintext frame. The
+ * sequence number is big endian and counts the datagrams, so listeners can tell when some got lost. With an
+ * encryption key, the messages are encrypted with ChaChaPoly, the sequence number as nonce and the header as
+ * associated data. The key is derived from the API encryption key and a salt picked at boot, so a nonce is never used
+ * twice with the same key.
+ */
+class APIStateBroadcast {
+ public:
+  void set_address(const std::string &address) { this->address_ = address; }
+  void set_port(uint16_t port) { this->port_ = port; }
+  const std::string &get_address() const { return this->address_; }
+  uint16_t get_port() const { return this->port_; }
+
+#ifdef USE_API_NOISE
+  void set_psk(const psk_t &psk) { this->psk_ = psk; }
+#endif
+
+  /// Open the socket, returns false if broadcasting isn't possible.
+  bool setup();
+
+  /// Queue a message for the next flush().
+  template<class T> void add(uint32_t message_type, const T &msg) {
+    if (this->socket_ == nullptr)
+      return;
+    uint32_t size = 0;
+    msg.calculate_size(size);
+    uint32_t total = ProtoSize::varint(size) + ProtoSize::varint(message_type) + size;
+    if (this->payload_.size() + total + this->trailer_size_() > MAX_DATAGRAM_SIZE)
+      this->flush();
+    ProtoWriteBuffer buffer(&this->payload_);
+    buffer.encode_varint_raw(size);
+    buffer.encode_varint_raw(message_type);
+    msg.encode(buffer);
+  }
+  /// Send the queued messages.
+  void flush();
+
+ protected:
+  /// Datagrams are kept below the usual MTU, a single message that is larger is still sent on its own.
+  static const size_t MAX_DATAGRAM_SIZE = 1400;
+
+  size_t header_size_() const;
+  size_t trailer_size_() const;
+  void write_header_();
+
+  std::string address_;
+  uint16_t port_;
+  std::unique_ptr<socket::Socket> socket_;
+  struct sockaddr_storage destination_;
+  socklen_t destination_len_{0};
+  /// The datagram being assembled, starting with room for the header.
+  std::vector<uint8_t> payload_;
+  uint32_t sequence_{0};
+
+#ifdef USE_API_NOISE
+  bool rekey_();
+
+  psk_t psk_;
+  uint8_t salt_[16];
+  NoiseCipherState *cipher_{nullptr};
+#endif
+};
+
+}  // namespace api
+}  // namespace esphome
+
+#endif  // USE_API_STATE_BROADCAST
@@ -3,7 +3,9 @@
 #include "esphome/core/component.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/string_ref.h"
 
+#include <cstring>
 #include <vector>
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
@@ -26,10 +28,24 @@ class ProtoVarInt {
     if (len == 0)
       return {};
 
+    // Tags, booleans, enums and short lengths take one byte, most sizes two
+    if ((buffer[0] & 0x80) == 0) {
+      if (consumed != nullptr)
+        *consumed = 1;
+      return ProtoVarInt(buffer[0]);
+    }
+    if (len >= 2 && (buffer[1] & 0x80) == 0) {
+      if (consumed != nullptr)
+        *consumed = 2;
+      return ProtoVarInt((buffer[0] & 0x7F) | (uint32_t(buffer[1]) << 7));
+    }
+
     uint64_t result = 0;
     uint8_t bitpos = 0;
+    // A varint has at most 10 bytes, a longer one is malformed
+    const uint32_t max_len = len < 10 ? len : 10;
 
-    for (uint32_t i = 0; i < len; i++) {
+    for (uint32_t i = 0; i < max_len; i++) {
       uint8_t val = buffer[i];
       result |= uint64_t(val & 0x7F) << uint64_t(bitpos);
       bitpos += 7;
@@ -71,21 +87,63 @@ class ProtoVarInt {
       return static_cast<int64_t>(this->value_ >> 1);
     }
   }
-  void encode(std::vector<uint8_t> &out) {
-    uint64_t val = this->value_;
-    if (val <= 0x7F) {
-      out.push_back(val);
-      return;
+  /** Encode a 32 bit value, unrolled for each size.
+   *
+   * @param buffer Must have room for ProtoSize::varint(value) bytes.
+   * @return The number of bytes written.
+   */
+  static size_t encode_varint32(uint8_t *buffer, uint32_t value) {
+    if (value < (1u << 7)) {
+      buffer[0] = value;
+      return 1;
     }
-    while (val) {
+    buffer[0] = value | 0x80;
+    if (value < (1u << 14)) {
+      buffer[1] = value >> 7;
+      return 2;
+    }
+    buffer[1] = (value >> 7) | 0x80;
+    if (value < (1u << 21)) {
+      buffer[2] = value >> 14;
+      return 3;
+    }
+    buffer[2] = (value >> 14) | 0x80;
+    if (value < (1u << 28)) {
+      buffer[3] = value >> 21;
+      return 4;
+    }
+    buffer[3] = (value >> 21) | 0x80;
+    buffer[4] = value >> 28;
+    return 5;
+  }
+  /** Encode into a buffer that is known to have room for len bytes, see ProtoSize::varint().
+   *
+   * @return The number of bytes written.
+   */
+  size_t encode_to_buffer_unchecked(uint8_t *buffer, size_t len) {
+    uint64_t val = this->value_;
+    if (val <= UINT32_MAX)
+      return encode_varint32(buffer, val);
+    size_t i = 0;
+    while (val && i < len) {
       uint8_t temp = val & 0x7F;
       val >>= 7;
       if (val) {
-        out.push_back(temp | 0x80);
+        buffer[i] = temp | 0x80;
       } else {
-        out.push_back(temp);
+        buffer[i] = temp;
       }
+      i++;
     }
+    return i;
+  }
+  void encode(std::vector<uint8_t> &out) {
+    if (this->value_ <= 0x7F) {
+      out.push_back(this->value_);
+      return;
+    }
+    uint8_t buffer[10];
+    out.insert(out.end(), buffer, buffer + this->encode_to_buffer_unchecked(buffer, sizeof(buffer)));
   }
 
  protected:
@@ -96,6 +154,10 @@ class ProtoLengthDelimited {
  public:
   explicit ProtoLengthDelimited(const uint8_t *value, size_t length) : value_(value), length_(length) {}
   std::string as_string() const { return std::string(reinterpret_cast<const char *>(this->value_), this->length_); }
+  /// A view into the buffer the message is decoded from, only valid until that buffer is reused.
+  StringRef as_string_ref() const {
+    return StringRef(reinterpret_cast<const char *>(this->value_), this->length_);
+  }
   template<class C> C as_message() const {
     auto msg = C();
     msg.decode(this->value_, this->length_);
@@ -146,9 +208,46 @@ class Proto64Bit {
 class ProtoWriteBuffer {
  public:
   ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
-  void write(uint8_t value) { this->buffer_->push_back(value); }
-  void encode_varint_raw(ProtoVarInt value) { value.encode(*this->buffer_); }
-  void encode_varint_raw(uint32_t value) { this->encode_varint_raw(ProtoVarInt(value)); }
+  /** Write into a raw span instead of a vector.
+   *
+   * The span must have room for the whole message, see ProtoMessage::calculate_size() and the MAX_ENCODED_SIZE
+   * constant of fixed-size messages. *pos is advanced as data is written, so nested messages share the cursor.
+   */
+  ProtoWriteBuffer(uint8_t **pos) : pos_(pos) {}
+  void write(uint8_t value) {
+    if (this->buffer_ != nullptr) {
+      this->buffer_->push_back(value);
+    } else {
+      *(*this->pos_)++ = value;
+    }
+  }
+  void write(const uint8_t *data, size_t len) {
+    if (this->buffer_ != nullptr) {
+      this->buffer_->insert(this->buffer_->end(), data, data + len);
+    } else {
+      std::memcpy(*this->pos_, data, len);
+      *this->pos_ += len;
+    }
+  }
+  void encode_varint_raw(ProtoVarInt value) {
+    if (value.as_uint64() <= UINT32_MAX) {
+      this->encode_varint_raw(value.as_uint32());
+    } else if (this->buffer_ != nullptr) {
+      value.encode(*this->buffer_);
+    } else {
+      *this->pos_ += value.encode_to_buffer_unchecked(*this->pos_, 10);
+    }
+  }
+  void encode_varint_raw(uint32_t value) {
+    if (this->buffer_ == nullptr) {
+      *this->pos_ += ProtoVarInt::encode_varint32(*this->pos_, value);
+    } else if (value < 128) {
+      this->buffer_->push_back(value);
+    } else {
+      uint8_t bytes[5];
+      this->write(bytes, ProtoVarInt::encode_varint32(bytes, value));
+    }
+  }
   void encode_field_raw(uint32_t field_id, uint32_t type) {
     uint32_t val = (field_id << 3) | (type & 0b111);
     this->encode_varint_raw(val);
@@ -159,12 +258,13 @@ class ProtoWriteBuffer {
 
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
-    auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->write(reinterpret_cast<const uint8_t *>(string), len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    this->encode_string(field_id, value.data(), value.size(), force);
+  }
+  void encode_string(uint32_t field_id, const StringRef &value, bool force = false) {
+    this->encode_string(field_id, value.c_str(), value.size(), force);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -192,24 +292,14 @@ class ProtoWriteBuffer {
       return;
 
     this->encode_field_raw(field_id, 5);
-    this->write((value >> 0) & 0xFF);
-    this->write((value >> 8) & 0xFF);
-    this->write((value >> 16) & 0xFF);
-    this->write((value >> 24) & 0xFF);
+    this->write_little_endian_(value);
   }
   void encode_fixed64(uint32_t field_id, uint64_t value, bool force = false) {
     if (value == 0 && !force)
       return;
 
-    this->encode_field_raw(field_id, 5);
-    this->write((value >> 0) & 0xFF);
-    this->write((value >> 8) & 0xFF);
-    this->write((value >> 16) & 0xFF);
-    this->write((value >> 24) & 0xFF);
-    this->write((value >> 32) & 0xFF);
-    this->write((value >> 40) & 0xFF);
-    this->write((value >> 48) & 0xFF);
-    this->write((value >> 56) & 0xFF);
+    this->encode_field_raw(field_id, 1);
+    this->write_little_endian_(value);
   }
   template<typename T> void encode_enum(uint32_t field_id, T value, bool force = false) {
     this->encode_uint32(field_id, static_cast<uint32_t>(value), force);
@@ -223,7 +313,7 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, force);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -239,7 +329,7 @@ class ProtoWriteBuffer {
   void encode_sint32(uint32_t field_id, int32_t value, bool force = false) {
     uint32_t uvalue;
     if (value < 0) {
-      uvalue = ~(value << 1);
+      uvalue = ~(static_cast<uint32_t>(value) << 1);
     } else {
       uvalue = value << 1;
     }
@@ -248,7 +338,7 @@ class ProtoWriteBuffer {
   void encode_sint64(uint32_t field_id, int64_t value, bool force = false) {
     uint64_t uvalue;
     if (value < 0) {
-      uvalue = ~(value << 1);
+      uvalue = ~(static_cast<uint64_t>(value) << 1);
     } else {
       uvalue = value << 1;
     }
@@ -256,26 +346,53 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // Write the length up front so the nested message is encoded in place
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
+  /// The vector this buffer writes into, nullptr when writing into a raw span.
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
  protected:
-  std::vector<uint8_t> *buffer_;
+  /// Write a fixed32 or fixed64 value, with a single store on little endian targets.
+  template<typename T> void write_little_endian_(T value) {
+    uint8_t bytes[sizeof(T)];
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    std::memcpy(bytes, &value, sizeof(T));
+#else
+    for (size_t i = 0; i < sizeof(T); i++)
+      bytes[i] = value >> (i * 8);
+#endif
+    this->write(bytes, sizeof(T));
+  }
+
+  std::vector<uint8_t> *buffer_{nullptr};
+  uint8_t **pos_{nullptr};
 };
 
 class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the number of bytes encode() writes to total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
+  /** Encode into out without allocating, which must have room for calculate_size() or MAX_ENCODED_SIZE bytes.
+   *
+   * @return The number of bytes written.
+   */
+  size_t encode_into(uint8_t *out) const {
+    uint8_t *pos = out;
+    this->encode(ProtoWriteBuffer(&pos));
+    return pos - out;
+  }
+  /// Append the encoding to out, grown by size bytes up front so that the fields are written through a raw pointer.
+  void encode_append(std::vector<uint8_t> &out, uint32_t size) const {
+    const size_t offset = out.size();
+    out.resize(offset + size);
+    this->encode_into(out.data() + offset);
+  }
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -289,6 +406,117 @@ class ProtoMessage {
   virtual bool decode_64bit(uint32_t field_id, Proto64Bit value) { return false; }
 };
 
+/** Size calculation for the fields of a message, mirroring the encode functions of ProtoWriteBuffer.
+ *
+ * field_id_size is the size of the field tag, which is precomputed by the code generator.
+ */
+class ProtoSize {
+ public:
+  static uint32_t varint(uint32_t value) {
+    if (value < 128)
+      return 1;
+    if (value < 16384)
+      return 2;
+    if (value < 2097152)
+      return 3;
+    if (value < 268435456)
+      return 4;
+    return 5;
+  }
+  static uint32_t varint(uint64_t value) {
+    if (value <= UINT32_MAX)
+      return varint(static_cast<uint32_t>(value));
+    uint32_t size = 5;
+    value >>= 35;
+    while (value) {
+      size++;
+      value >>= 7;
+    }
+    return size;
+  }
+
+  static void add_int32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force) {
+    if (value == 0 && !force)
+      return;
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      total_size += field_id_size + 10;
+    } else {
+      total_size += field_id_size + varint(static_cast<uint32_t>(value));
+    }
+  }
+  static void add_uint32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value, bool force) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static void add_int64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force) {
+    add_uint64_field(total_size, field_id_size, static_cast<uint64_t>(value), force);
+  }
+  static void add_uint64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value, bool force) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + varint(value);
+  }
+  static void add_sint32_field(uint32_t &total_size, uint32_t field_id_size, int32_t value, bool force) {
+    uint32_t uvalue;
+    if (value < 0) {
+      uvalue = ~(static_cast<uint32_t>(value) << 1);
+    } else {
+      uvalue = value << 1;
+    }
+    add_uint32_field(total_size, field_id_size, uvalue, force);
+  }
+  static void add_sint64_field(uint32_t &total_size, uint32_t field_id_size, int64_t value, bool force) {
+    uint64_t uvalue;
+    if (value < 0) {
+      uvalue = ~(static_cast<uint64_t>(value) << 1);
+    } else {
+      uvalue = value << 1;
+    }
+    add_uint64_field(total_size, field_id_size, uvalue, force);
+  }
+  template<typename T> static void add_enum_field(uint32_t &total_size, uint32_t field_id_size, T value, bool force) {
+    add_uint32_field(total_size, field_id_size, static_cast<uint32_t>(value), force);
+  }
+  static void add_bool_field(uint32_t &total_size, uint32_t field_id_size, bool value, bool force) {
+    if (!value && !force)
+      return;
+    total_size += field_id_size + 1;
+  }
+  static void add_fixed32_field(uint32_t &total_size, uint32_t field_id_size, uint32_t value, bool force) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + 4;
+  }
+  static void add_fixed64_field(uint32_t &total_size, uint32_t field_id_size, uint64_t value, bool force) {
+    if (value == 0 && !force)
+      return;
+    total_size += field_id_size + 8;
+  }
+  static void add_float_field(uint32_t &total_size, uint32_t field_id_size, float value, bool force) {
+    if (value == 0.0f && !force)
+      return;
+    total_size += field_id_size + 4;
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id_size, const std::string &value, bool force) {
+    if (value.empty() && !force)
+      return;
+    total_size += field_id_size + varint(static_cast<uint32_t>(value.size())) + value.size();
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id_size, const StringRef &value, bool force) {
+    if (value.empty() && !force)
+      return;
+    total_size += field_id_size + varint(static_cast<uint32_t>(value.size())) + value.size();
+  }
+  /// Nested messages are always encoded, even when empty.
+  static void add_message_object(uint32_t &total_size, uint32_t field_id_size, const ProtoMessage &value) {
+    uint32_t nested_size = 0;
+    value.calculate_size(nested_size);
+    total_size += field_id_size + varint(nested_size) + nested_size;
+  }
+};
+
 template<typename T> const char *proto_enum_to_string(T value);
 
 class ProtoService {
@@ -299,15 +527,26 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /** Create a buffer to encode a message of reserve_size bytes into.
+   *
+   * The buffer may already contain room for the frame header, which the frame helper fills in before sending.
+   */
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
-  template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
-    msg.encode(buffer);
+  /// Encode and send a message, connections can override this to reuse an encoding shared with other connections.
+  virtual bool send_proto_message_(const ProtoMessage &msg, uint32_t message_type) {
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    auto buffer = this->create_buffer(msg_size);
+    msg.encode_append(*buffer.get_buffer(), msg_size);
     return this->send_buffer(buffer, message_type);
   }
+
+  template<class C> bool send_message_(const C &msg, uint32_t message_type) {
+    return this->send_proto_message_(msg, message_type);
+  }
 };
 
 }  // namespace api
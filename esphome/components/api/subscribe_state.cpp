@@ -1,5 +1,6 @@
 #include "subscribe_state.h"
 #include "api_connection.h"
+#include "api_server.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -7,60 +8,105 @@ namespace api {
 
 #ifdef USE_BINARY_SENSOR
 bool InitialStateIterator::on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
+  if (!this->changed_(binary_sensor))
+    return true;
   return this->client_->send_binary_sensor_state(binary_sensor, binary_sensor->state);
 }
 #endif
 #ifdef USE_COVER
-bool InitialStateIterator::on_cover(cover::Cover *cover) { return this->client_->send_cover_state(cover); }
+bool InitialStateIterator::on_cover(cover::Cover *cover) {
+  if (!this->changed_(cover))
+    return true;
+  return this->client_->send_cover_state(cover);
+}
 #endif
 #ifdef USE_FAN
-bool InitialStateIterator::on_fan(fan::Fan *fan) { return this->client_->send_fan_state(fan); }
+bool InitialStateIterator::on_fan(fan::Fan *fan) {
+  if (!this->changed_(fan))
+    return true;
+  return this->client_->send_fan_state(fan);
+}
 #endif
 #ifdef USE_LIGHT
-bool InitialStateIterator::on_light(light::LightState *light) { return this->client_->send_light_state(light); }
+bool InitialStateIterator::on_light(light::LightState *light) {
+  if (!this->changed_(light))
+    return true;
+  return this->client_->send_light_state(light);
+}
 #endif
 #ifdef USE_SENSOR
 bool InitialStateIterator::on_sensor(sensor::Sensor *sensor) {
+  if (!this->changed_(sensor))
+    return true;
   return this->client_->send_sensor_state(sensor, sensor->state);
 }
 #endif
 #ifdef USE_SWITCH
 bool InitialStateIterator::on_switch(switch_::Switch *a_switch) {
+  if (!this->changed_(a_switch))
+    return true;
   return this->client_->send_switch_state(a_switch, a_switch->state);
 }
 #endif
 #ifdef USE_TEXT_SENSOR
 bool InitialStateIterator::on_text_sensor(text_sensor::TextSensor *text_sensor) {
+  if (!this->changed_(text_sensor))
+    return true;
   return this->client_->send_text_sensor_state(text_sensor, text_sensor->state);
 }
 #endif
 #ifdef USE_CLIMATE
-bool InitialStateIterator::on_climate(climate::Climate *climate) { return this->client_->send_climate_state(climate); }
+bool InitialStateIterator::on_climate(climate::Climate *climate) {
+  if (!this->changed_(climate))
+    return true;
+  return this->client_->send_climate_state(climate);
+}
 #endif
 #ifdef USE_NUMBER
 bool InitialStateIterator::on_number(number::Number *number) {
+  if (!this->changed_(number))
+    return true;
   return this->client_->send_number_state(number, number->state);
 }
 #endif
 #ifdef USE_SELECT
 bool InitialStateIterator::on_select(select::Select *select) {
+  if (!this->changed_(select))
+    return true;
   return this->client_->send_select_state(select, select->state);
 }
 #endif
 #ifdef USE_LOCK
-bool InitialStateIterator::on_lock(lock::Lock *a_lock) { return this->client_->send_lock_state(a_lock, a_lock->state); }
+bool InitialStateIterator::on_lock(lock::Lock *a_lock) {
+  if (!this->changed_(a_lock))
+    return true;
+  return this->client_->send_lock_state(a_lock, a_lock->state);
+}
 #endif
 #ifdef USE_MEDIA_PLAYER
 bool InitialStateIterator::on_media_player(media_player::MediaPlayer *media_player) {
+  if (!this->changed_(media_player))
+    return true;
   return this->client_->send_media_player_state(media_player);
 }
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
 bool InitialStateIterator::on_alarm_control_panel(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
+  if (!this->changed_(a_alarm_control_panel))
+    return true;
   return this->client_->send_alarm_control_panel_state(a_alarm_control_panel);
 }
 #endif
 InitialStateIterator::InitialStateIterator(APIConnection *client) : client_(client) {}
 
+void InitialStateIterator::begin_since(uint32_t version) {
+  this->since_version_ = version;
+  this->begin();
+}
+
+bool InitialStateIterator::changed_(EntityBase *entity) const {
+  return this->since_version_ == 0 || global_api_server->get_entity_state_version(entity) > this->since_version_;
+}
+
 }  // namespace api
 }  // namespace esphome
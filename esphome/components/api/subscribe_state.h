@@ -13,6 +13,8 @@ class APIConnection;
 class InitialStateIterator : public ComponentIterator {
  public:
   InitialStateIterator(APIConnection *client);
+  /// Only send the entities updated after the state version, all of them for 0.
+  void begin_since(uint32_t version);
 #ifdef USE_BINARY_SENSOR
   bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override;
 #endif
@@ -56,7 +58,10 @@ class InitialStateIterator : public ComponentIterator {
   bool on_alarm_control_panel(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) override;
 #endif
  protected:
+  bool changed_(EntityBase *entity) const;
+
   APIConnection *client_;
+  uint32_t since_version_{0};
 };
 
 }  // namespace api
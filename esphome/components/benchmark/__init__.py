@@ -0,0 +1,64 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import automation, pins
+from esphome.automation import maybe_simple_id
+from esphome.components import i2c
+from esphome.const import CONF_ADDRESS, CONF_I2C_ID, CONF_ID, CONF_PIN
+from esphome.core import CORE
+
+CODEOWNERS = ["@esphome/core"]
+AUTO_LOAD = ["display", "json", "sensor"]
+
+CONF_ITERATIONS = "iterations"
+CONF_RUN_AT_BOOT = "run_at_boot"
+
+benchmark_ns = cg.esphome_ns.namespace("benchmark")
+BenchmarkComponent = benchmark_ns.class_("BenchmarkComponent", cg.Component)
+RunAction = benchmark_ns.class_("RunAction", automation.Action)
+
+
+def _default_run_at_boot(config):
+    # The host build is a benchmark run by itself, on devices it is started by an action
+    config = config.copy()
+    if CONF_RUN_AT_BOOT not in config:
+        config[CONF_RUN_AT_BOOT] = CORE.is_host
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(BenchmarkComponent),
+            cv.Optional(CONF_ITERATIONS, default=10000): cv.int_range(min=1),
+            cv.Optional(CONF_RUN_AT_BOOT): cv.boolean,
+            cv.Inclusive(CONF_I2C_ID, "i2c"): cv.use_id(i2c.I2CBus),
+            cv.Inclusive(CONF_ADDRESS, "i2c"): cv.i2c_address,
+            cv.Optional(CONF_PIN): pins.internal_gpio_output_pin_schema,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    _default_run_at_boot,
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_iterations(config[CONF_ITERATIONS]))
+    cg.add(var.set_run_at_boot(config[CONF_RUN_AT_BOOT]))
+    if CONF_I2C_ID in config:
+        bus = await cg.get_variable(config[CONF_I2C_ID])
+        cg.add(var.set_i2c_bus(bus, config[CONF_ADDRESS]))
+    if CONF_PIN in config:
+        pin = await cg.gpio_pin_expression(config[CONF_PIN])
+        cg.add(var.set_gpio_pin(pin))
+
+
+@automation.register_action(
+    "benchmark.run",
+    RunAction,
+    maybe_simple_id({cv.GenerateID(): cv.use_id(BenchmarkComponent)}),
+)
+async def benchmark_run_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
@@ -0,0 +1,367 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "esphome/core/application.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+#include "esphome/core/scheduler.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/filter.h"
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_API
+#include "esphome/components/api/api_pb2.h"
+#endif
+#ifdef USE_API_NOISE
+#include "noise/protocol.h"
+#endif
+#ifdef USE_JSON
+#include "esphome/components/json/json_util.h"
+#endif
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display/display_color_utils.h"
+
+namespace esphome {
+namespace benchmark {
+
+static const char *const TAG = "benchmark";
+
+/// Keeps the compiler from optimizing away the work of a benchmark loop.
+static volatile uint32_t sink;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void BenchmarkComponent::setup() {
+  if (!this->run_at_boot_)
+    return;
+  this->run();
+#ifdef USE_HOST
+  fflush(stdout);
+  exit(0);  // NOLINT(concurrency-mt-unsafe)
+#endif
+}
+
+void BenchmarkComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Benchmark:");
+  ESP_LOGCONFIG(TAG, "  Iterations: %" PRIu32, this->iterations_);
+  ESP_LOGCONFIG(TAG, "  Run At Boot: %s", YESNO(this->run_at_boot_));
+#ifdef USE_I2C
+  if (this->i2c_bus_ != nullptr)
+    ESP_LOGCONFIG(TAG, "  I2C Address: 0x%02X", this->i2c_address_);
+#endif
+  LOG_PIN("  GPIO Pin: ", this->gpio_pin_);
+}
+
+void BenchmarkComponent::run() {
+  ESP_LOGI(TAG, "Running benchmarks with %" PRIu32 " iterations...", this->iterations_);
+  this->bench_scheduler_();
+  this->bench_sensor_filters_();
+  this->bench_publish_fanout_();
+  this->bench_proto_encode_();
+  this->bench_noise_();
+  this->bench_json_();
+  this->bench_display_();
+  this->bench_preferences_();
+  this->bench_i2c_();
+  this->bench_gpio_();
+  ESP_LOGI(TAG, "Benchmarks done");
+}
+
+void BenchmarkComponent::report_(const char *name, uint32_t n, uint32_t iterations, uint32_t elapsed_us) {
+  double ns_per_op = elapsed_us * 1000.0 / iterations;
+#ifdef USE_HOST
+  printf("{\"benchmark\":\"%s\",\"n\":%" PRIu32 ",\"iterations\":%" PRIu32 ",\"ns_per_op\":%.1f}\n", name, n,
+         iterations, ns_per_op);
+#else
+  ESP_LOGI(TAG, "{\"benchmark\":\"%s\",\"n\":%" PRIu32 ",\"iterations\":%" PRIu32 ",\"ns_per_op\":%.1f}", name, n,
+           iterations, ns_per_op);
+#endif
+  // A whole run takes longer than the watchdog timeout
+  App.feed_wdt();
+}
+
+void BenchmarkComponent::bench_scheduler_() {
+  // Timers far in the future, so call() only has to look at them
+  for (uint32_t n : {1, 16, 128}) {
+    Scheduler scheduler;
+    for (uint32_t i = 0; i < n; i++)
+      scheduler.set_interval(this, i + 1, 3600000 + i, []() {});
+    scheduler.call();
+
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < this->iterations_; i++)
+      scheduler.call();
+    this->report_("scheduler_call", n, this->iterations_, micros() - start);
+
+    // Re-arming a pending timeout, the pattern of debounce style filters
+    start = micros();
+    for (uint32_t i = 0; i < this->iterations_; i++)
+      scheduler.set_timeout(this, 1 + (i % n), 1000, []() {});
+    this->report_("scheduler_rearm", n, this->iterations_, micros() - start);
+  }
+}
+
+void BenchmarkComponent::bench_sensor_filters_() {
+#ifdef USE_SENSOR
+  struct Chain {
+    const char *name;
+    std::vector<sensor::Filter *> filters;
+  };
+  std::vector<Chain> chains = {
+      {"sensor_publish_no_filters", {}},
+      {"sensor_publish_offset_multiply", {new sensor::OffsetFilter(0.5f), new sensor::MultiplyFilter(1.8f)}},
+      {"sensor_publish_sliding_window_average", {new sensor::SlidingWindowMovingAverageFilter(15, 1, 1)}},
+      {"sensor_publish_median_delta",
+       {new sensor::MedianFilter(5, 1, 1), new sensor::DeltaFilter(0.1f, false)}},
+      {"sensor_publish_exponential_average", {new sensor::ExponentialMovingAverageFilter(0.1f, 1, 1)}},
+  };
+  for (auto &chain : chains) {
+    sensor::Sensor sens;
+    sens.add_filters(chain.filters);
+    sens.add_on_state_callback([](float state) { sink = sink + (state > 0.0f); });
+
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < this->iterations_; i++)
+      sens.publish_state(20.0f + (i % 64) * 0.25f);
+    this->report_(chain.name, chain.filters.size(), this->iterations_, micros() - start);
+  }
+#endif
+}
+
+void BenchmarkComponent::bench_publish_fanout_() {
+#ifdef USE_SENSOR
+  // A sensor that the API, MQTT, web server and a few automations all listen to
+  for (uint32_t n : {1, 4, 8}) {
+    sensor::Sensor sens;
+    for (uint32_t i = 0; i < n; i++)
+      sens.add_on_state_callback([](float state) { sink = sink + (state > 0.0f); });
+
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < this->iterations_; i++)
+      sens.publish_state(20.0f + (i % 64) * 0.25f);
+    this->report_("sensor_publish_fanout", n, this->iterations_, micros() - start);
+  }
+#endif
+}
+
+void BenchmarkComponent::bench_proto_encode_() {
+#ifdef USE_API
+  api::SensorStateResponse state;
+  state.key = 0x12345678;
+  state.state = 21.5f;
+  uint8_t raw[api::SensorStateResponse::MAX_ENCODED_SIZE];
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    state.state += 0.25f;
+    sink = sink + state.encode_into(raw);
+  }
+  this->report_("proto_encode_sensor_state", 1, this->iterations_, micros() - start);
+
+  api::ListEntitiesSensorResponse info;
+  info.object_id = "living_room_temperature";
+  info.key = 0x12345678;
+  info.name = "Living Room Temperature";
+  info.unique_id = "aabbccddeeffsensorliving_room_temperature";
+  info.unit_of_measurement = "°C";
+  info.accuracy_decimals = 1;
+  info.device_class = "temperature";
+  info.state_class = api::enums::STATE_CLASS_MEASUREMENT;
+  std::vector<uint8_t> buffer;
+  start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    buffer.clear();
+    uint32_t size = 0;
+    info.calculate_size(size);
+    info.encode_append(buffer, size);
+    sink = sink + buffer.size();
+  }
+  this->report_("proto_encode_list_entities_sensor", 1, this->iterations_, micros() - start);
+
+  // A key, a small enum and a large value, the mix of varint sizes the messages of a client carry
+  const uint8_t varints[] = {0x78, 0x03, 0xB4, 0x60, 0xF8, 0xAC, 0xD1, 0x91, 0x01};
+  start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    for (size_t pos = 0; pos < sizeof(varints);) {
+      uint32_t consumed = 0;
+      auto value = api::ProtoVarInt::parse(varints + pos, sizeof(varints) - pos, &consumed);
+      if (!value.has_value())
+        break;
+      sink = sink + value->as_uint32();
+      pos += consumed;
+    }
+  }
+  this->report_("proto_decode_varint", 4, this->iterations_, micros() - start);
+#endif
+}
+
+void BenchmarkComponent::bench_noise_() {
+#ifdef USE_API_NOISE
+  // Two cipher states with the same key stand in for the two ends of a connection, so every frame that is encrypted
+  // can be decrypted again with the matching nonce.
+  const uint8_t key[32] = {0x42};
+  NoiseCipherState *send_cipher = nullptr;
+  NoiseCipherState *recv_cipher = nullptr;
+  if (noise_cipherstate_new_by_id(&send_cipher, NOISE_CIPHER_CHACHAPOLY) != NOISE_ERROR_NONE ||
+      noise_cipherstate_new_by_id(&recv_cipher, NOISE_CIPHER_CHACHAPOLY) != NOISE_ERROR_NONE) {
+    ESP_LOGE(TAG, "Could not create noise cipher states");
+    return;
+  }
+  noise_cipherstate_init_key(send_cipher, key, sizeof(key));
+  noise_cipherstate_init_key(recv_cipher, key, sizeof(key));
+  size_t mac_len = noise_cipherstate_get_mac_length(send_cipher);
+
+  // A sensor state frame and a larger list entities frame, including the type and length header
+  for (uint32_t msg_len : {16, 256}) {
+    std::vector<uint8_t> frame(msg_len + mac_len, 0x5A);
+    NoiseBuffer mbuf;
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < this->iterations_; i++) {
+      noise_buffer_init(mbuf);
+      noise_buffer_set_inout(mbuf, frame.data(), msg_len, frame.size());
+      noise_cipherstate_encrypt(send_cipher, &mbuf);
+      noise_cipherstate_decrypt(recv_cipher, &mbuf);
+      sink = sink + mbuf.size;
+    }
+    this->report_("noise_encrypt_decrypt", msg_len, this->iterations_, micros() - start);
+  }
+
+  noise_cipherstate_free(send_cipher);
+  noise_cipherstate_free(recv_cipher);
+#endif
+}
+
+void BenchmarkComponent::bench_json_() {
+#ifdef USE_JSON
+  // The state of a sensor as sent by the web server
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    std::string json = json::build_json([i](JsonObject root) {
+      root["id"] = "sensor-living_room_temperature";
+      root["state"] = "21.5 °C";
+      root["value"] = 21.5f + i;
+    });
+    sink = sink + json.size();
+  }
+  this->report_("build_json_sensor_state", 3, this->iterations_, micros() - start);
+#endif
+}
+
+/// A 16 bit color display that only draws into its buffer, small enough to fit into the heap of an ESP8266.
+class BenchmarkDisplay : public display::DisplayBuffer {
+ public:
+  static const int WIDTH = 128;
+  static const int HEIGHT = 64;
+
+  BenchmarkDisplay() { this->init_internal_(WIDTH * HEIGHT * 2); }
+  ~BenchmarkDisplay() {
+    ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    allocator.deallocate(this->buffer_, WIDTH * HEIGHT * 2);
+  }
+  bool has_buffer() const { return this->buffer_ != nullptr; }
+  display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_COLOR; }
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+
+ protected:
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    uint16_t color565 = display::ColorUtil::color_to_565(color);
+    uint32_t pos = (y * WIDTH + x) * 2;
+    this->buffer_[pos] = color565 >> 8;
+    this->buffer_[pos + 1] = color565 & 0xFF;
+    this->mark_dirty_(x, y);
+  }
+};
+
+void BenchmarkComponent::bench_display_() {
+  BenchmarkDisplay disp;
+  if (!disp.has_buffer())
+    return;
+  // Drawing whole frames is a lot slower than the other benchmarks, so run fewer of them
+  uint32_t iterations = std::max<uint32_t>(this->iterations_ / 100, 1);
+  Color color(0x20, 0x80, 0xF0);
+
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < iterations; i++)
+    disp.fill(color);
+  this->report_("display_fill", BenchmarkDisplay::WIDTH * BenchmarkDisplay::HEIGHT, iterations, micros() - start);
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; i++)
+    disp.filled_rectangle(8, 8, 100, 48, color);
+  this->report_("display_filled_rectangle", 100 * 48, iterations, micros() - start);
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; i++)
+    disp.filled_circle(64, 32, 24, color);
+  this->report_("display_filled_circle", 24, iterations, micros() - start);
+
+  start = micros();
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (int x = 0; x < BenchmarkDisplay::WIDTH; x += 8)
+      disp.line(x, 0, BenchmarkDisplay::WIDTH - 1 - x, BenchmarkDisplay::HEIGHT - 1, color);
+  }
+  this->report_("display_line", BenchmarkDisplay::WIDTH / 8, iterations, micros() - start);
+}
+
+void BenchmarkComponent::bench_preferences_() {
+  // save() only updates the cache, the flash is written once by sync() to spare it
+  auto pref = global_preferences->make_preference<uint32_t>(fnv1_hash("benchmark"), true);
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++)
+    pref.save(&i);
+  this->report_("preferences_save", 1, this->iterations_, micros() - start);
+
+  start = micros();
+  global_preferences->sync();
+  this->report_("preferences_sync", 1, 1, micros() - start);
+}
+
+void BenchmarkComponent::bench_i2c_() {
+#ifdef USE_I2C
+  if (this->i2c_bus_ == nullptr)
+    return;
+  // Transactions are bound by the bus clock, so a few are enough
+  uint32_t iterations = std::max<uint32_t>(this->iterations_ / 100, 1);
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < iterations; i++)
+    this->i2c_bus_->write(this->i2c_address_, nullptr, 0);
+  this->report_("i2c_address_probe", 0, iterations, micros() - start);
+
+  uint8_t data[16];
+  start = micros();
+  for (uint32_t i = 0; i < iterations; i++)
+    this->i2c_bus_->read(this->i2c_address_, data, sizeof(data));
+  this->report_("i2c_read", sizeof(data), iterations, micros() - start);
+#endif
+}
+
+void BenchmarkComponent::bench_gpio_() {
+  if (this->gpio_pin_ == nullptr)
+    return;
+  this->gpio_pin_->setup();
+  // One iteration is a full period, a high and a low write
+  uint32_t start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    this->gpio_pin_->digital_write(true);
+    this->gpio_pin_->digital_write(false);
+  }
+  this->report_("gpio_toggle", 1, this->iterations_, micros() - start);
+
+  FastGPIOPin fast = FastGPIOPin::from(this->gpio_pin_);
+  start = micros();
+  for (uint32_t i = 0; i < this->iterations_; i++) {
+    fast.digital_write(true);
+    fast.digital_write(false);
+  }
+  this->report_("gpio_toggle_fast", 1, this->iterations_, micros() - start);
+}
+
+}  // namespace benchmark
+}  // namespace esphome
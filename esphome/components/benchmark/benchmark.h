@@ -0,0 +1,76 @@
+#pragma once
+
+#include "esphome/core/automation.h"
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
+
+#ifdef USE_I2C
+#include "esphome/components/i2c/i2c_bus.h"
+#endif
+
+namespace esphome {
+namespace benchmark {
+
+/** Times the hot paths of the core on the device it runs on.
+ *
+ * Every result is logged as a single line JSON object, for example
+ * `{"benchmark":"scheduler_call","n":16,"iterations":10000,"ns_per_op":41.2}`, so that runs on different chips and
+ * releases can be collected and compared by a script. On the host platform the results are printed to stdout
+ * instead and the process exits after the run at boot. Benchmarks of components that aren't part of the build are
+ * skipped.
+ *
+ * A run blocks the main loop until it is done, which takes a few seconds with the default number of iterations.
+ */
+class BenchmarkComponent : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::LATE; }
+
+  /// Run all benchmarks now.
+  void run();
+
+  void set_iterations(uint32_t iterations) { this->iterations_ = iterations; }
+  void set_run_at_boot(bool run_at_boot) { this->run_at_boot_ = run_at_boot; }
+  /// Also time toggling this output pin, it is driven while the benchmarks run.
+  void set_gpio_pin(InternalGPIOPin *gpio_pin) { this->gpio_pin_ = gpio_pin; }
+#ifdef USE_I2C
+  /// Also time transactions with the device at the address on this bus.
+  void set_i2c_bus(i2c::I2CBus *bus, uint8_t address) {
+    this->i2c_bus_ = bus;
+    this->i2c_address_ = address;
+  }
+#endif
+
+ protected:
+  /// Report the result of one benchmark, elapsed_us is the time all iterations took together.
+  void report_(const char *name, uint32_t n, uint32_t iterations, uint32_t elapsed_us);
+
+  void bench_scheduler_();
+  void bench_sensor_filters_();
+  void bench_publish_fanout_();
+  void bench_proto_encode_();
+  void bench_noise_();
+  void bench_json_();
+  void bench_display_();
+  void bench_preferences_();
+  void bench_i2c_();
+  void bench_gpio_();
+
+  uint32_t iterations_{10000};
+  bool run_at_boot_{false};
+  InternalGPIOPin *gpio_pin_{nullptr};
+#ifdef USE_I2C
+  i2c::I2CBus *i2c_bus_{nullptr};
+  uint8_t i2c_address_{0};
+#endif
+};
+
+template<typename... Ts> class RunAction : public Action<Ts...>, public Parented<BenchmarkComponent> {
+ public:
+  void play(Ts... x) override { this->parent_->run(); }
+};
+
+}  // namespace benchmark
+}  // namespace esphome
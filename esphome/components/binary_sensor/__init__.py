@@ -57,7 +57,7 @@ from esphome.const import (
     DEVICE_CLASS_VIBRATION,
     DEVICE_CLASS_WINDOW,
 )
-from esphome.core import CORE, coroutine_with_priority
+from esphome.core import CORE, ID, coroutine_with_priority
 from esphome.util import Registry
 
 CODEOWNERS = ["@esphome/core"]
@@ -135,14 +135,17 @@ BinarySensorCondition = binary_sensor_ns.class_("BinarySensorCondition", Conditi
 
 # Filters
 Filter = binary_sensor_ns.class_("Filter")
-DelayedOnOffFilter = binary_sensor_ns.class_("DelayedOnOffFilter", Filter, cg.Component)
-DelayedOnFilter = binary_sensor_ns.class_("DelayedOnFilter", Filter, cg.Component)
-DelayedOffFilter = binary_sensor_ns.class_("DelayedOffFilter", Filter, cg.Component)
+FilterTimers = binary_sensor_ns.class_("FilterTimers", cg.Component)
+TimedFilter = binary_sensor_ns.class_("TimedFilter", Filter)
+DelayedOnOffFilter = binary_sensor_ns.class_("DelayedOnOffFilter", TimedFilter)
+DelayedOnFilter = binary_sensor_ns.class_("DelayedOnFilter", TimedFilter)
+DelayedOffFilter = binary_sensor_ns.class_("DelayedOffFilter", TimedFilter)
 InvertFilter = binary_sensor_ns.class_("InvertFilter", Filter)
-AutorepeatFilter = binary_sensor_ns.class_("AutorepeatFilter", Filter, cg.Component)
+AutorepeatFilter = binary_sensor_ns.class_("AutorepeatFilter", TimedFilter)
 LambdaFilter = binary_sensor_ns.class_("LambdaFilter", Filter)
 
 FILTER_REGISTRY = Registry()
+KEY_FILTER_TIMERS = "binary_sensor_filter_timers"
 validate_filters = cv.validate_registry("filter", FILTER_REGISTRY)
 
 
@@ -150,6 +153,18 @@ def register_filter(name, filter_type, schema):
     return FILTER_REGISTRY.register(name, filter_type, schema)
 
 
+async def get_filter_timers():
+    """The FilterTimers shared by all timed filters, created along with the first of them."""
+    if KEY_FILTER_TIMERS not in CORE.data:
+        timers_id = ID(
+            "binary_sensor_filter_timers", is_declaration=True, type=FilterTimers
+        )
+        timers = cg.new_Pvariable(timers_id)
+        await cg.register_component(timers, {})
+        CORE.data[KEY_FILTER_TIMERS] = timers
+    return CORE.data[KEY_FILTER_TIMERS]
+
+
 @register_filter("invert", InvertFilter, {})
 async def invert_filter_to_code(config, filter_id):
     return cg.new_Pvariable(filter_id)
@@ -176,8 +191,7 @@ async def invert_filter_to_code(config, filter_id):
     ),
 )
 async def delayed_on_off_filter_to_code(config, filter_id):
-    var = cg.new_Pvariable(filter_id)
-    await cg.register_component(var, {})
+    var = cg.new_Pvariable(filter_id, await get_filter_timers())
     if isinstance(config, dict):
         template_ = await cg.templatable(config[CONF_TIME_ON], [], cg.uint32)
         cg.add(var.set_on_delay(template_))
@@ -194,8 +208,7 @@ async def delayed_on_off_filter_to_code(config, filter_id):
     "delayed_on", DelayedOnFilter, cv.templatable(cv.positive_time_period_milliseconds)
 )
 async def delayed_on_filter_to_code(config, filter_id):
-    var = cg.new_Pvariable(filter_id)
-    await cg.register_component(var, {})
+    var = cg.new_Pvariable(filter_id, await get_filter_timers())
     template_ = await cg.templatable(config, [], cg.uint32)
     cg.add(var.set_delay(template_))
     return var
@@ -207,8 +220,7 @@ async def delayed_on_filter_to_code(config, filter_id):
     cv.templatable(cv.positive_time_period_milliseconds),
 )
 async def delayed_off_filter_to_code(config, filter_id):
-    var = cg.new_Pvariable(filter_id)
-    await cg.register_component(var, {})
+    var = cg.new_Pvariable(filter_id, await get_filter_timers())
     template_ = await cg.templatable(config, [], cg.uint32)
     cg.add(var.set_delay(template_))
     return var
@@ -246,8 +258,7 @@ async def autorepeat_filter_to_code(config, filter_id):
                 cv.time_period_str_unit(DEFAULT_TIME_ON).total_milliseconds,
             )
         )
-    var = cg.new_Pvariable(filter_id, timings)
-    await cg.register_component(var, {})
+    var = cg.new_Pvariable(filter_id, await get_filter_timers(), timings)
     return var
 
 
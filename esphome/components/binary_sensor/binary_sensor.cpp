@@ -1,5 +1,6 @@
 #include "binary_sensor.h"
 #include "esphome/core/log.h"
+#include "esphome/core/worker.h"
 
 namespace esphome {
 
@@ -7,11 +8,13 @@ namespace binary_sensor {
 
 static const char *const TAG = "binary_sensor";
 
-void BinarySensor::add_on_state_callback(std::function<void(bool)> &&callback) {
-  this->state_callback_.add(std::move(callback));
-}
-
 void BinarySensor::publish_state(bool state) {
+#ifdef USE_COMPONENT_WORKER
+  if (worker::in_worker()) {
+    worker::run_in_main([this, state]() { this->publish_state(state); });
+    return;
+  }
+#endif
   if (!this->publish_dedup_.next(state))
     return;
   if (this->filter_list_ == nullptr) {
@@ -1,6 +1,8 @@
 #include "filter.h"
 
 #include "binary_sensor.h"
+#include "esphome/core/hal.h"
+#include <algorithm>
 #include <utility>
 
 namespace esphome {
@@ -26,44 +28,92 @@ void Filter::input(bool value, bool is_initial) {
   }
 }
 
-optional<bool> DelayedOnOffFilter::new_value(bool value, bool is_initial) {
-  if (value) {
-    this->set_timeout("ON_OFF", this->on_delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
-  } else {
-    this->set_timeout("ON_OFF", this->off_delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
+void FilterTimers::setup() {
+  if (this->armed_ == nullptr)
+    this->disable_loop();
+}
+
+void FilterTimers::loop() {
+  // Timers armed from a callback have a deadline after now, so they wait for the next iteration
+  const uint32_t now = millis();
+  while (this->armed_ != nullptr && int32_t(now - this->armed_->deadline) >= 0) {
+    FilterTimer *timer = this->armed_;
+    this->armed_ = timer->next;
+    timer->next = nullptr;
+    timer->armed = false;
+    timer->owner->on_timeout_(timer->id);
+  }
+  if (this->armed_ == nullptr)
+    this->disable_loop();
+}
+
+float FilterTimers::get_setup_priority() const { return setup_priority::HARDWARE; }
+
+void FilterTimers::start(FilterTimer *timer, uint32_t delay) {
+  this->cancel(timer);
+  // at least 1 ms, so a timer re-armed from its callback can't fire again in the same loop()
+  timer->deadline = millis() + std::max<uint32_t>(delay, 1);
+  timer->armed = true;
+  FilterTimer **pos = &this->armed_;
+  while (*pos != nullptr && int32_t((*pos)->deadline - timer->deadline) <= 0)
+    pos = &(*pos)->next;
+  timer->next = *pos;
+  *pos = timer;
+  this->enable_loop();
+}
+
+void FilterTimers::cancel(FilterTimer *timer) {
+  if (!timer->armed)
+    return;
+  for (FilterTimer **pos = &this->armed_; *pos != nullptr; pos = &(*pos)->next) {
+    if (*pos == timer) {
+      *pos = timer->next;
+      break;
+    }
   }
+  timer->next = nullptr;
+  timer->armed = false;
+}
+
+optional<bool> DelayedOnOffFilter::new_value(bool value, bool is_initial) {
+  this->pending_value_ = value;
+  this->pending_initial_ = is_initial;
+  this->timers_->start(&this->timer_, value ? this->on_delay_.value() : this->off_delay_.value());
   return {};
 }
 
-float DelayedOnOffFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+void DelayedOnOffFilter::on_timeout_(uint8_t id) { this->output(this->pending_value_, this->pending_initial_); }
 
 optional<bool> DelayedOnFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON", this->delay_.value(), [this, is_initial]() { this->output(true, is_initial); });
+    this->pending_initial_ = is_initial;
+    this->timers_->start(&this->timer_, this->delay_.value());
     return {};
   } else {
-    this->cancel_timeout("ON");
+    this->timers_->cancel(&this->timer_);
     return false;
   }
 }
 
-float DelayedOnFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+void DelayedOnFilter::on_timeout_(uint8_t id) { this->output(true, this->pending_initial_); }
 
 optional<bool> DelayedOffFilter::new_value(bool value, bool is_initial) {
   if (!value) {
-    this->set_timeout("OFF", this->delay_.value(), [this, is_initial]() { this->output(false, is_initial); });
+    this->pending_initial_ = is_initial;
+    this->timers_->start(&this->timer_, this->delay_.value());
     return {};
   } else {
-    this->cancel_timeout("OFF");
+    this->timers_->cancel(&this->timer_);
     return true;
   }
 }
 
-float DelayedOffFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+void DelayedOffFilter::on_timeout_(uint8_t id) { this->output(false, this->pending_initial_); }
 
 optional<bool> InvertFilter::new_value(bool value, bool is_initial) { return !value; }
 
-AutorepeatFilter::AutorepeatFilter(std::vector<AutorepeatFilterTiming> timings) : timings_(std::move(timings)) {}
+AutorepeatFilter::AutorepeatFilter(FilterTimers *timers, std::vector<AutorepeatFilterTiming> timings)
+    : TimedFilter(timers), timings_(std::move(timings)) {}
 
 optional<bool> AutorepeatFilter::new_value(bool value, bool is_initial) {
   if (value) {
@@ -74,20 +124,28 @@ optional<bool> AutorepeatFilter::new_value(bool value, bool is_initial) {
     this->next_timing_();
     return true;
   } else {
-    this->cancel_timeout("TIMING");
-    this->cancel_timeout("ON_OFF");
+    this->timers_->cancel(&this->timing_timer_);
+    this->timers_->cancel(&this->toggle_timer_);
     this->active_timing_ = 0;
     return false;
   }
 }
 
+void AutorepeatFilter::on_timeout_(uint8_t id) {
+  if (id == TIMING_TIMER) {
+    this->next_timing_();
+  } else {
+    this->next_value_(this->toggle_value_);
+  }
+}
+
 void AutorepeatFilter::next_timing_() {
   // Entering this method
   // 1st time: starts waiting the first delay
   // 2nd time: starts waiting the second delay and starts toggling with the first time_off / _on
   // last time: no delay to start but have to bump the index to reflect the last
   if (this->active_timing_ < this->timings_.size())
-    this->set_timeout("TIMING", this->timings_[this->active_timing_].delay, [this]() { this->next_timing_(); });
+    this->timers_->start(&this->timing_timer_, this->timings_[this->active_timing_].delay);
 
   if (this->active_timing_ <= this->timings_.size()) {
     this->active_timing_++;
@@ -102,11 +160,10 @@ void AutorepeatFilter::next_timing_() {
 void AutorepeatFilter::next_value_(bool val) {
   const AutorepeatFilterTiming &timing = this->timings_[this->active_timing_ - 2];
   this->output(val, false);  // This is at least the second one so not initial
-  this->set_timeout("ON_OFF", val ? timing.time_on : timing.time_off, [this, val]() { this->next_value_(!val); });
+  this->toggle_value_ = !val;
+  this->timers_->start(&this->toggle_timer_, val ? timing.time_on : timing.time_off);
 }
 
-float AutorepeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
-
 LambdaFilter::LambdaFilter(std::function<optional<bool>(bool)> f) : f_(std::move(f)) {}
 
 optional<bool> LambdaFilter::new_value(bool value, bool is_initial) { return this->f_(value); }
@@ -28,42 +28,102 @@ class Filter {
   Deduplicator<bool> dedup_;
 };
 
-class DelayedOnOffFilter : public Filter, public Component {
- public:
-  optional<bool> new_value(bool value, bool is_initial) override;
+class TimedFilter;
+
+/// A timeout of a filter, armed and cancelled through FilterTimers.
+struct FilterTimer {
+  FilterTimer(TimedFilter *owner, uint8_t id) : owner(owner), id(id) {}
+
+  TimedFilter *owner;
+  /// Next armed timer, the armed timers are linked through themselves in the order of their deadlines.
+  FilterTimer *next{nullptr};
+  uint32_t deadline{0};
+  /// Passed to TimedFilter::on_timeout_(), for filters with more than one timer.
+  uint8_t id;
+  bool armed{false};
+};
 
+/** Runs the timeouts of all filters of binary sensors.
+ *
+ * A filter only holds its FilterTimer, so it needs neither to be a Component nor a scheduler item per timeout, and
+ * arming a timer doesn't allocate. loop() is only enabled while a timer is armed.
+ */
+class FilterTimers : public Component {
+ public:
+  void setup() override;
+  void loop() override;
   float get_setup_priority() const override;
 
+  /// Arm the timer to fire after delay ms, re-arming it if it already is.
+  void start(FilterTimer *timer, uint32_t delay);
+  void cancel(FilterTimer *timer);
+
+ protected:
+  FilterTimer *armed_{nullptr};
+};
+
+/// A filter with timeouts, run by the FilterTimers shared by all filters.
+class TimedFilter : public Filter {
+ public:
+  explicit TimedFilter(FilterTimers *timers) : timers_(timers) {}
+
+ protected:
+  friend FilterTimers;
+
+  virtual void on_timeout_(uint8_t id) = 0;
+
+  FilterTimers *timers_;
+};
+
+class DelayedOnOffFilter : public TimedFilter {
+ public:
+  explicit DelayedOnOffFilter(FilterTimers *timers) : TimedFilter(timers) {}
+
+  optional<bool> new_value(bool value, bool is_initial) override;
+
   template<typename T> void set_on_delay(T delay) { this->on_delay_ = delay; }
   template<typename T> void set_off_delay(T delay) { this->off_delay_ = delay; }
 
  protected:
+  void on_timeout_(uint8_t id) override;
+
   TemplatableValue<uint32_t> on_delay_{};
   TemplatableValue<uint32_t> off_delay_{};
+  FilterTimer timer_{this, 0};
+  bool pending_value_{false};
+  bool pending_initial_{false};
 };
 
-class DelayedOnFilter : public Filter, public Component {
+class DelayedOnFilter : public TimedFilter {
  public:
-  optional<bool> new_value(bool value, bool is_initial) override;
+  explicit DelayedOnFilter(FilterTimers *timers) : TimedFilter(timers) {}
 
-  float get_setup_priority() const override;
+  optional<bool> new_value(bool value, bool is_initial) override;
 
   template<typename T> void set_delay(T delay) { this->delay_ = delay; }
 
  protected:
+  void on_timeout_(uint8_t id) override;
+
   TemplatableValue<uint32_t> delay_{};
+  FilterTimer timer_{this, 0};
+  bool pending_initial_{false};
 };
 
-class DelayedOffFilter : public Filter, public Component {
+class DelayedOffFilter : public TimedFilter {
  public:
-  optional<bool> new_value(bool value, bool is_initial) override;
+  explicit DelayedOffFilter(FilterTimers *timers) : TimedFilter(timers) {}
 
-  float get_setup_priority() const override;
+  optional<bool> new_value(bool value, bool is_initial) override;
 
   template<typename T> void set_delay(T delay) { this->delay_ = delay; }
 
  protected:
+  void on_timeout_(uint8_t id) override;
+
   TemplatableValue<uint32_t> delay_{};
+  FilterTimer timer_{this, 0};
+  bool pending_initial_{false};
 };
 
 class InvertFilter : public Filter {
@@ -82,20 +142,25 @@ struct AutorepeatFilterTiming {
   uint32_t time_on;
 };
 
-class AutorepeatFilter : public Filter, public Component {
+class AutorepeatFilter : public TimedFilter {
  public:
-  explicit AutorepeatFilter(std::vector<AutorepeatFilterTiming> timings);
+  AutorepeatFilter(FilterTimers *timers, std::vector<AutorepeatFilterTiming> timings);
 
   optional<bool> new_value(bool value, bool is_initial) override;
 
-  float get_setup_priority() const override;
-
  protected:
+  enum : uint8_t { TIMING_TIMER, TOGGLE_TIMER };
+
+  void on_timeout_(uint8_t id) override;
   void next_timing_();
   void next_value_(bool val);
 
   std::vector<AutorepeatFilterTiming> timings_;
   uint8_t active_timing_{0};
+  FilterTimer timing_timer_{this, TIMING_TIMER};
+  FilterTimer toggle_timer_{this, TOGGLE_TIMER};
+  /// Value output when toggle_timer_ fires.
+  bool toggle_value_{false};
 };
 
 class LambdaFilter : public Filter {
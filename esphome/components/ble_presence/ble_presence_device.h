@@ -50,7 +50,11 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
       this->publish_state(false);
     this->found_ = false;
   }
-  bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override {
+  esp32_ble_tracker::AdvertisementParserType get_advertisement_parser_type() override {
+    return esp32_ble_tracker::AdvertisementParserType::VIEW_ADVERTISEMENTS;
+  }
+  bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override { return false; }
+  bool parse_device_view(const esp32_ble_tracker::ESPBTDeviceView &device) override {
     if (this->check_minimum_rssi_ && this->minimum_rssi_ > device.get_rssi()) {
       return false;
     }
@@ -63,20 +67,19 @@ class BLEPresenceDevice : public binary_sensor::BinarySensorInitiallyOff,
         }
         break;
       case MATCH_BY_SERVICE_UUID:
-        for (auto uuid : device.get_service_uuids()) {
-          if (this->uuid_ == uuid) {
-            this->publish_state(true);
-            this->found_ = true;
-            return true;
-          }
+        if (device.has_service_uuid(this->uuid_)) {
+          this->publish_state(true);
+          this->found_ = true;
+          return true;
         }
         break;
       case MATCH_BY_IBEACON_UUID:
-        if (!device.get_ibeacon().has_value()) {
+        auto beacon = device.get_ibeacon();
+        if (!beacon.has_value()) {
           return false;
         }
 
-        auto ibeacon = device.get_ibeacon().value();
+        auto ibeacon = *beacon;
 
         if (this->ibeacon_uuid_ != ibeacon.get_uuid()) {
           return false;
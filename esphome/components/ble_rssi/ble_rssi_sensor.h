@@ -44,7 +44,11 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
       this->publish_state(NAN);
     this->found_ = false;
   }
-  bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override {
+  esp32_ble_tracker::AdvertisementParserType get_advertisement_parser_type() override {
+    return esp32_ble_tracker::AdvertisementParserType::VIEW_ADVERTISEMENTS;
+  }
+  bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override { return false; }
+  bool parse_device_view(const esp32_ble_tracker::ESPBTDeviceView &device) override {
     switch (this->match_by_) {
       case MATCH_BY_MAC_ADDRESS:
         if (device.address_uint64() == this->address_) {
@@ -54,20 +58,19 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
         }
         break;
       case MATCH_BY_SERVICE_UUID:
-        for (auto uuid : device.get_service_uuids()) {
-          if (this->uuid_ == uuid) {
-            this->publish_state(device.get_rssi());
-            this->found_ = true;
-            return true;
-          }
+        if (device.has_service_uuid(this->uuid_)) {
+          this->publish_state(device.get_rssi());
+          this->found_ = true;
+          return true;
         }
         break;
       case MATCH_BY_IBEACON_UUID:
-        if (!device.get_ibeacon().has_value()) {
+        auto beacon = device.get_ibeacon();
+        if (!beacon.has_value()) {
           return false;
         }
 
-        auto ibeacon = device.get_ibeacon().value();
+        auto ibeacon = *beacon;
 
         if (this->ibeacon_uuid_ != ibeacon.get_uuid()) {
           return false;
@@ -8,6 +8,7 @@ AUTO_LOAD = ["esp32_ble_client", "esp32_ble_tracker"]
 DEPENDENCIES = ["api", "esp32"]
 CODEOWNERS = ["@jesserockz"]
 
+CONF_BATCH_INTERVAL = "batch_interval"
 CONF_CACHE_SERVICES = "cache_services"
 CONF_CONNECTIONS = "connections"
 MAX_CONNECTIONS = 3
@@ -49,6 +50,9 @@ CONFIG_SCHEMA = cv.All(
         {
             cv.GenerateID(): cv.declare_id(BluetoothProxy),
             cv.Optional(CONF_ACTIVE, default=False): cv.boolean,
+            cv.Optional(
+                CONF_BATCH_INTERVAL, default="0ms"
+            ): cv.positive_time_period_milliseconds,
             cv.SplitDefault(CONF_CACHE_SERVICES, esp32_idf=True): cv.All(
                 cv.only_with_esp_idf, cv.boolean
             ),
@@ -69,6 +73,7 @@ async def to_code(config):
     await cg.register_component(var, config)
 
     cg.add(var.set_active(config[CONF_ACTIVE]))
+    cg.add(var.set_batch_interval(config[CONF_BATCH_INTERVAL]))
     await esp32_ble_tracker.register_ble_device(var, config)
 
     for connection_conf in config.get(CONF_CONNECTIONS, []):
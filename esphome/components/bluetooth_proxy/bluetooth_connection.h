@@ -3,6 +3,7 @@
 #ifdef USE_ESP32
 
 #include "esphome/components/esp32_ble_client/ble_client_base.h"
+#include "esphome/core/string_ref.h"
 
 namespace esphome {
 namespace bluetooth_proxy {
@@ -17,9 +18,9 @@ class BluetoothConnection : public esp32_ble_client::BLEClientBase {
   esp32_ble_tracker::AdvertisementParserType get_advertisement_parser_type() override;
 
   esp_err_t read_characteristic(uint16_t handle);
-  esp_err_t write_characteristic(uint16_t handle, const std::string &data, bool response);
+  esp_err_t write_characteristic(uint16_t handle, const StringRef &data, bool response);
   esp_err_t read_descriptor(uint16_t handle);
-  esp_err_t write_descriptor(uint16_t handle, const std::string &data, bool response);
+  esp_err_t write_descriptor(uint16_t handle, const StringRef &data, bool response);
 
   esp_err_t notify_characteristic(uint16_t handle, bool enable);
 
@@ -28,6 +29,8 @@ class BluetoothConnection : public esp32_ble_client::BLEClientBase {
   bool seen_mtu_or_services_{false};
 
   int16_t send_service_{-2};
+  /// When the pending connection was requested, 0 once it's connected or failed.
+  uint32_t request_time_{0};
   BluetoothProxy *proxy_;
 };
 
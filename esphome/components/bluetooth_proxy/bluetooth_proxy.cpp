@@ -1,8 +1,13 @@
 #include "bluetooth_proxy.h"
 
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/macros.h"
 
+#include <cinttypes>
+#include <cstring>
+#include <iterator>
+
 #ifdef USE_ESP32
 
 namespace esphome {
@@ -39,26 +44,61 @@ bool BluetoothProxy::parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_p
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr || !this->raw_advertisements_)
     return false;
 
-  api::BluetoothLERawAdvertisementsResponse resp;
+  auto &batch = this->raw_advertisements_batch_.advertisements;
   for (size_t i = 0; i < count; i++) {
     auto &result = advertisements[i];
-    api::BluetoothLERawAdvertisement adv;
-    adv.address = esp32_ble::ble_addr_to_uint64(result.bda);
+    const uint64_t address = esp32_ble::ble_addr_to_uint64(result.bda);
+    const char *data = reinterpret_cast<const char *>(result.ble_adv);
+    const uint8_t length = result.adv_data_len + result.scan_rsp_len;
+
+    // the same packet from the same device is only sent once per batch
+    bool duplicate = false;
+    for (size_t j = 0; j < this->raw_advertisements_count_; j++) {
+      if (batch[j].address == address && batch[j].data.size() == length &&
+          memcmp(batch[j].data.data(), data, length) == 0) {
+        duplicate = true;
+        break;
+      }
+    }
+    if (duplicate)
+      continue;
+
+    if (this->raw_advertisements_count_ == 0)
+      this->raw_advertisements_batch_start_ = millis();
+    if (this->raw_advertisements_count_ == batch.size())
+      batch.emplace_back();
+    // reuse the storage of the entries sent in earlier batches
+    auto &adv = batch[this->raw_advertisements_count_++];
+    adv.address = address;
     adv.rssi = result.rssi;
     adv.address_type = result.ble_addr_type;
+    adv.data.assign(data, length);
 
-    uint8_t length = result.adv_data_len + result.scan_rsp_len;
-    adv.data.reserve(length);
-    for (uint16_t i = 0; i < length; i++) {
-      adv.data.push_back(result.ble_adv[i]);
-    }
-
-    resp.advertisements.push_back(std::move(adv));
+    if (this->raw_advertisements_count_ >= MAX_RAW_ADVERTISEMENTS_BATCH)
+      this->flush_raw_advertisements_();
   }
-  ESP_LOGV(TAG, "Proxying %d packets", count);
-  this->api_connection_->send_bluetooth_le_raw_advertisements_response(resp);
+  if (this->batch_interval_ == 0)
+    this->flush_raw_advertisements_();
   return true;
 }
+
+void BluetoothProxy::flush_raw_advertisements_() {
+  if (this->raw_advertisements_count_ == 0)
+    return;
+  auto &batch = this->raw_advertisements_batch_.advertisements;
+  auto &spare = this->raw_advertisements_spare_;
+  // entries beyond the count are leftovers from a larger batch, park them while sending to keep their storage
+  spare.insert(spare.end(), std::make_move_iterator(batch.begin() + this->raw_advertisements_count_),
+               std::make_move_iterator(batch.end()));
+  batch.resize(this->raw_advertisements_count_);
+  ESP_LOGV(TAG, "Proxying %u packets", (unsigned) this->raw_advertisements_count_);
+  if (this->api_connection_ != nullptr)
+    this->api_connection_->send_bluetooth_le_raw_advertisements_response(this->raw_advertisements_batch_);
+  batch.insert(batch.end(), std::make_move_iterator(spare.begin()), std::make_move_iterator(spare.end()));
+  spare.clear();
+  this->raw_advertisements_count_ = 0;
+}
+
 void BluetoothProxy::send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device) {
   api::BluetoothLEAdvertisementResponse resp;
   resp.address = device.address_uint64();
@@ -87,6 +127,8 @@ void BluetoothProxy::send_api_packet_(const esp32_ble_tracker::ESPBTDevice &devi
 void BluetoothProxy::dump_config() {
   ESP_LOGCONFIG(TAG, "Bluetooth Proxy:");
   ESP_LOGCONFIG(TAG, "  Active: %s", YESNO(this->active_));
+  if (this->batch_interval_ > 0)
+    ESP_LOGCONFIG(TAG, "  Batch Interval: %" PRIu32 " ms", this->batch_interval_);
 }
 
 int BluetoothProxy::get_bluetooth_connections_free() {
@@ -105,6 +147,8 @@ int BluetoothProxy::get_bluetooth_connections_free() {
 
 void BluetoothProxy::loop() {
   if (!api::global_api_server->is_connected() || this->api_connection_ == nullptr) {
+    this->raw_advertisements_count_ = 0;
+    this->connection_queue_.clear();
     for (auto *connection : this->connections_) {
       if (connection->get_address() != 0) {
         connection->disconnect();
@@ -112,6 +156,11 @@ void BluetoothProxy::loop() {
     }
     return;
   }
+  if (this->raw_advertisements_count_ > 0 &&
+      millis() - this->raw_advertisements_batch_start_ >= this->batch_interval_) {
+    this->flush_raw_advertisements_();
+  }
+  this->process_connection_queue_();
   for (auto *connection : this->connections_) {
     if (connection->send_service_ == connection->service_count_) {
       connection->send_service_ = DONE_SENDING_SERVICES;
@@ -121,83 +170,90 @@ void BluetoothProxy::loop() {
         connection->release_services();
       }
     } else if (connection->send_service_ >= 0) {
-      esp_gattc_service_elem_t service_result;
-      uint16_t service_count = 1;
-      esp_gatt_status_t service_status =
-          esp_ble_gattc_get_service(connection->get_gattc_if(), connection->get_conn_id(), nullptr, &service_result,
-                                    &service_count, connection->send_service_);
-      connection->send_service_++;
-      if (service_status != ESP_GATT_OK) {
-        ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_service error at offset=%d, status=%d",
-                 connection->get_connection_index(), connection->address_str().c_str(), connection->send_service_ - 1,
-                 service_status);
-        continue;
-      }
-      if (service_count == 0) {
-        ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_service missing, service_count=%d",
-                 connection->get_connection_index(), connection->address_str().c_str(), service_count);
-        continue;
-      }
+      // send a few services per loop, so discovering a large device doesn't hold up the other connections
       api::BluetoothGATTGetServicesResponse resp;
       resp.address = connection->get_address();
-      api::BluetoothGATTService service_resp;
-      service_resp.uuid = get_128bit_uuid_vec(service_result.uuid);
-      service_resp.handle = service_result.start_handle;
-      uint16_t char_offset = 0;
-      esp_gattc_char_elem_t char_result;
-      while (true) {  // characteristics
-        uint16_t char_count = 1;
-        esp_gatt_status_t char_status = esp_ble_gattc_get_all_char(
-            connection->get_gattc_if(), connection->get_conn_id(), service_result.start_handle,
-            service_result.end_handle, &char_result, &char_count, char_offset);
-        if (char_status == ESP_GATT_INVALID_OFFSET || char_status == ESP_GATT_NOT_FOUND) {
-          break;
-        }
-        if (char_status != ESP_GATT_OK) {
-          ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_all_char error, status=%d", connection->get_connection_index(),
-                   connection->address_str().c_str(), char_status);
-          break;
-        }
-        if (char_count == 0) {
-          break;
-        }
-        api::BluetoothGATTCharacteristic characteristic_resp;
-        characteristic_resp.uuid = get_128bit_uuid_vec(char_result.uuid);
-        characteristic_resp.handle = char_result.char_handle;
-        characteristic_resp.properties = char_result.properties;
-        char_offset++;
-        uint16_t desc_offset = 0;
-        esp_gattc_descr_elem_t desc_result;
-        while (true) {  // descriptors
-          uint16_t desc_count = 1;
-          esp_gatt_status_t desc_status =
-              esp_ble_gattc_get_all_descr(connection->get_gattc_if(), connection->get_conn_id(),
-                                          char_result.char_handle, &desc_result, &desc_count, desc_offset);
-          if (desc_status == ESP_GATT_INVALID_OFFSET || desc_status == ESP_GATT_NOT_FOUND) {
-            break;
-          }
-          if (desc_status != ESP_GATT_OK) {
-            ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_all_descr error, status=%d", connection->get_connection_index(),
-                     connection->address_str().c_str(), desc_status);
-            break;
-          }
-          if (desc_count == 0) {
-            break;
-          }
-          api::BluetoothGATTDescriptor descriptor_resp;
-          descriptor_resp.uuid = get_128bit_uuid_vec(desc_result.uuid);
-          descriptor_resp.handle = desc_result.handle;
-          characteristic_resp.descriptors.push_back(std::move(descriptor_resp));
-          desc_offset++;
-        }
-        service_resp.characteristics.push_back(std::move(characteristic_resp));
+      for (int i = 0; i < MAX_SERVICES_PER_LOOP && connection->send_service_ < connection->service_count_; i++) {
+        api::BluetoothGATTService service_resp;
+        if (this->get_gatt_service_(connection, connection->send_service_++, service_resp))
+          resp.services.push_back(std::move(service_resp));
       }
-      resp.services.push_back(std::move(service_resp));
-      this->api_connection_->send_bluetooth_gatt_get_services_response(resp);
+      if (!resp.services.empty())
+        this->api_connection_->send_bluetooth_gatt_get_services_response(resp);
     }
   }
 }
 
+bool BluetoothProxy::get_gatt_service_(BluetoothConnection *connection, uint16_t offset,
+                                       api::BluetoothGATTService &service_resp) {
+  esp_gattc_service_elem_t service_result;
+  uint16_t service_count = 1;
+  esp_gatt_status_t service_status = esp_ble_gattc_get_service(connection->get_gattc_if(), connection->get_conn_id(),
+                                                               nullptr, &service_result, &service_count, offset);
+  if (service_status != ESP_GATT_OK) {
+    ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_service error at offset=%d, status=%d",
+             connection->get_connection_index(), connection->address_str().c_str(), offset, service_status);
+    return false;
+  }
+  if (service_count == 0) {
+    ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_service missing, service_count=%d", connection->get_connection_index(),
+             connection->address_str().c_str(), service_count);
+    return false;
+  }
+  service_resp.uuid = get_128bit_uuid_vec(service_result.uuid);
+  service_resp.handle = service_result.start_handle;
+  uint16_t char_offset = 0;
+  esp_gattc_char_elem_t char_result;
+  while (true) {  // characteristics
+    uint16_t char_count = 1;
+    esp_gatt_status_t char_status =
+        esp_ble_gattc_get_all_char(connection->get_gattc_if(), connection->get_conn_id(), service_result.start_handle,
+                                   service_result.end_handle, &char_result, &char_count, char_offset);
+    if (char_status == ESP_GATT_INVALID_OFFSET || char_status == ESP_GATT_NOT_FOUND) {
+      break;
+    }
+    if (char_status != ESP_GATT_OK) {
+      ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_all_char error, status=%d", connection->get_connection_index(),
+               connection->address_str().c_str(), char_status);
+      break;
+    }
+    if (char_count == 0) {
+      break;
+    }
+    api::BluetoothGATTCharacteristic characteristic_resp;
+    characteristic_resp.uuid = get_128bit_uuid_vec(char_result.uuid);
+    characteristic_resp.handle = char_result.char_handle;
+    characteristic_resp.properties = char_result.properties;
+    char_offset++;
+    uint16_t desc_offset = 0;
+    esp_gattc_descr_elem_t desc_result;
+    while (true) {  // descriptors
+      uint16_t desc_count = 1;
+      esp_gatt_status_t desc_status = esp_ble_gattc_get_all_descr(connection->get_gattc_if(), connection->get_conn_id(),
+                                                                  char_result.char_handle, &desc_result, &desc_count,
+                                                                  desc_offset);
+      if (desc_status == ESP_GATT_INVALID_OFFSET || desc_status == ESP_GATT_NOT_FOUND) {
+        break;
+      }
+      if (desc_status != ESP_GATT_OK) {
+        ESP_LOGE(TAG, "[%d] [%s] esp_ble_gattc_get_all_descr error, status=%d", connection->get_connection_index(),
+                 connection->address_str().c_str(), desc_status);
+        break;
+      }
+      if (desc_count == 0) {
+        break;
+      }
+      api::BluetoothGATTDescriptor descriptor_resp;
+      descriptor_resp.uuid = get_128bit_uuid_vec(desc_result.uuid);
+      descriptor_resp.handle = desc_result.handle;
+      characteristic_resp.descriptors.push_back(std::move(descriptor_resp));
+      desc_offset++;
+    }
+    service_resp.characteristics.push_back(std::move(characteristic_resp));
+  }
+  return true;
+}
+
 esp32_ble_tracker::AdvertisementParserType BluetoothProxy::get_advertisement_parser_type() {
   if (this->raw_advertisements_)
     return esp32_ble_tracker::AdvertisementParserType::RAW_ADVERTISEMENTS;
@@ -229,72 +285,122 @@ BluetoothConnection *BluetoothProxy::get_connection_(uint64_t address, bool rese
   return nullptr;
 }
 
+void BluetoothProxy::connect_device_(const api::BluetoothDeviceRequest &msg, uint32_t request_time) {
+  auto *connection = this->get_connection_(msg.address, true);
+  if (connection == nullptr) {
+    this->queue_connection_request_(msg, request_time);
+    return;
+  }
+  if (connection->state() == espbt::ClientState::CONNECTED ||
+      connection->state() == espbt::ClientState::ESTABLISHED) {
+    ESP_LOGW(TAG, "[%d] [%s] Connection already established", connection->get_connection_index(),
+             connection->address_str().c_str());
+    this->send_device_connection(msg.address, true);
+    this->send_connections_free();
+    return;
+  } else if (connection->state() == espbt::ClientState::SEARCHING) {
+    ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, already searching for device",
+             connection->get_connection_index(), connection->address_str().c_str());
+    return;
+  } else if (connection->state() == espbt::ClientState::DISCOVERED) {
+    ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, device already discovered",
+             connection->get_connection_index(), connection->address_str().c_str());
+    return;
+  } else if (connection->state() == espbt::ClientState::READY_TO_CONNECT) {
+    ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, waiting in line to connect",
+             connection->get_connection_index(), connection->address_str().c_str());
+    return;
+  } else if (connection->state() == espbt::ClientState::CONNECTING) {
+    ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, already connecting", connection->get_connection_index(),
+             connection->address_str().c_str());
+    return;
+  } else if (connection->state() == espbt::ClientState::DISCONNECTING) {
+    ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, device is disconnecting",
+             connection->get_connection_index(), connection->address_str().c_str());
+    return;
+  } else if (connection->state() != espbt::ClientState::INIT) {
+    ESP_LOGW(TAG, "[%d] [%s] Connection already in progress", connection->get_connection_index(),
+             connection->address_str().c_str());
+    return;
+  }
+  if (msg.request_type == api::enums::BLUETOOTH_DEVICE_REQUEST_TYPE_CONNECT_V3_WITH_CACHE) {
+    connection->set_connection_type(espbt::ConnectionType::V3_WITH_CACHE);
+    ESP_LOGI(TAG, "[%d] [%s] Connecting v3 with cache", connection->get_connection_index(),
+             connection->address_str().c_str());
+  } else if (msg.request_type == api::enums::BLUETOOTH_DEVICE_REQUEST_TYPE_CONNECT_V3_WITHOUT_CACHE) {
+    connection->set_connection_type(espbt::ConnectionType::V3_WITHOUT_CACHE);
+    ESP_LOGI(TAG, "[%d] [%s] Connecting v3 without cache", connection->get_connection_index(),
+             connection->address_str().c_str());
+  } else {
+    connection->set_connection_type(espbt::ConnectionType::V1);
+    ESP_LOGI(TAG, "[%d] [%s] Connecting v1", connection->get_connection_index(), connection->address_str().c_str());
+  }
+  connection->request_time_ = request_time;
+  if (msg.has_address_type) {
+    uint64_to_bd_addr(msg.address, connection->remote_bda_);
+    connection->set_remote_addr_type(static_cast<esp_ble_addr_type_t>(msg.address_type));
+    connection->set_state(espbt::ClientState::DISCOVERED);
+  } else {
+    connection->set_state(espbt::ClientState::SEARCHING);
+  }
+  this->send_connections_free();
+}
+
+void BluetoothProxy::queue_connection_request_(const api::BluetoothDeviceRequest &msg, uint32_t request_time) {
+  for (auto &pending : this->connection_queue_) {
+    if (pending.request.address == msg.address) {
+      // keep the place in line, but connect the way the latest request asked for
+      pending.request = msg;
+      return;
+    }
+  }
+  if (this->connection_queue_.size() >= MAX_QUEUED_CONNECTIONS) {
+    ESP_LOGW(TAG, "No free connections available");
+    this->send_device_connection(msg.address, false);
+    return;
+  }
+  this->connection_queue_.push_back(PendingConnection{msg, request_time});
+  ESP_LOGD(TAG, "No free connections available, request %u in line", (unsigned) this->connection_queue_.size());
+}
+
+bool BluetoothProxy::remove_connection_request_(uint64_t address) {
+  for (auto it = this->connection_queue_.begin(); it != this->connection_queue_.end(); it++) {
+    if (it->request.address == address) {
+      this->connection_queue_.erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void BluetoothProxy::process_connection_queue_() {
+  const uint32_t now = millis();
+  // the client gives up on a connection after a while, don't connect to devices nobody waits for anymore
+  while (!this->connection_queue_.empty() &&
+         now - this->connection_queue_.front().request_time >= CONNECTION_QUEUE_TIMEOUT) {
+    const uint64_t address = this->connection_queue_.front().request.address;
+    this->connection_queue_.erase(this->connection_queue_.begin());
+    ESP_LOGW(TAG, "Timed out waiting for a free connection");
+    this->send_device_connection(address, false);
+  }
+  // requests are served in the order they came in, one per loop
+  if (!this->connection_queue_.empty() && this->get_bluetooth_connections_free() > 0) {
+    PendingConnection pending = this->connection_queue_.front();
+    this->connection_queue_.erase(this->connection_queue_.begin());
+    this->connect_device_(pending.request, pending.request_time);
+  }
+}
+
 void BluetoothProxy::bluetooth_device_request(const api::BluetoothDeviceRequest &msg) {
   switch (msg.request_type) {
     case api::enums::BLUETOOTH_DEVICE_REQUEST_TYPE_CONNECT_V3_WITH_CACHE:
     case api::enums::BLUETOOTH_DEVICE_REQUEST_TYPE_CONNECT_V3_WITHOUT_CACHE:
     case api::enums::BLUETOOTH_DEVICE_REQUEST_TYPE_CONNECT: {
-      auto *connection = this->get_connection_(msg.address, true);
-      if (connection == nullptr) {
-        ESP_LOGW(TAG, "No free connections available");
-        this->send_device_connection(msg.address, false);
-        return;
-      }
-      if (connection->state() == espbt::ClientState::CONNECTED ||
-          connection->state() == espbt::ClientState::ESTABLISHED) {
-        ESP_LOGW(TAG, "[%d] [%s] Connection already established", connection->get_connection_index(),
-                 connection->address_str().c_str());
-        this->send_device_connection(msg.address, true);
-        this->send_connections_free();
-        return;
-      } else if (connection->state() == espbt::ClientState::SEARCHING) {
-        ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, already searching for device",
-                 connection->get_connection_index(), connection->address_str().c_str());
-        return;
-      } else if (connection->state() == espbt::ClientState::DISCOVERED) {
-        ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, device already discovered",
-                 connection->get_connection_index(), connection->address_str().c_str());
-        return;
-      } else if (connection->state() == espbt::ClientState::READY_TO_CONNECT) {
-        ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, waiting in line to connect",
-                 connection->get_connection_index(), connection->address_str().c_str());
-        return;
-      } else if (connection->state() == espbt::ClientState::CONNECTING) {
-        ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, already connecting", connection->get_connection_index(),
-                 connection->address_str().c_str());
-        return;
-      } else if (connection->state() == espbt::ClientState::DISCONNECTING) {
-        ESP_LOGW(TAG, "[%d] [%s] Connection request ignored, device is disconnecting",
-                 connection->get_connection_index(), connection->address_str().c_str());
-        return;
-      } else if (connection->state() != espbt::ClientState::INIT) {
-        ESP_LOGW(TAG, "[%d] [%s] Connection already in progress", connection->get_connection_index(),
-                 connection->address_str().c_str());
-        return;
-      }
-      if (msg.request_type == api::enums::BLUETOOTH_DEVICE_REQUEST_TYPE_CONNECT_V3_WITH_CACHE) {
-        connection->set_connection_type(espbt::ConnectionType::V3_WITH_CACHE);
-        ESP_LOGI(TAG, "[%d] [%s] Connecting v3 with cache", connection->get_connection_index(),
-                 connection->address_str().c_str());
-      } else if (msg.request_type == api::enums::BLUETOOTH_DEVICE_REQUEST_TYPE_CONNECT_V3_WITHOUT_CACHE) {
-        connection->set_connection_type(espbt::ConnectionType::V3_WITHOUT_CACHE);
-        ESP_LOGI(TAG, "[%d] [%s] Connecting v3 without cache", connection->get_connection_index(),
-                 connection->address_str().c_str());
-      } else {
-        connection->set_connection_type(espbt::ConnectionType::V1);
-        ESP_LOGI(TAG, "[%d] [%s] Connecting v1", connection->get_connection_index(), connection->address_str().c_str());
-      }
-      if (msg.has_address_type) {
-        uint64_to_bd_addr(msg.address, connection->remote_bda_);
-        connection->set_remote_addr_type(static_cast<esp_ble_addr_type_t>(msg.address_type));
-        connection->set_state(espbt::ClientState::DISCOVERED);
-      } else {
-        connection->set_state(espbt::ClientState::SEARCHING);
-      }
-      this->send_connections_free();
+      this->connect_device_(msg, millis());
       break;
     }
     case api::enums::BLUETOOTH_DEVICE_REQUEST_TYPE_DISCONNECT: {
+      this->remove_connection_request_(msg.address);
       auto *connection = this->get_connection_(msg.address, false);
       if (connection == nullptr) {
         this->send_device_connection(msg.address, false);
@@ -451,10 +557,25 @@ void BluetoothProxy::unsubscribe_api_connection(api::APIConnection *api_connecti
   }
   this->api_connection_ = nullptr;
   this->raw_advertisements_ = false;
+  this->raw_advertisements_count_ = 0;
+  this->connection_queue_.clear();
   this->parent_->recalculate_advertisement_parser_types();
 }
 
 void BluetoothProxy::send_device_connection(uint64_t address, bool connected, uint16_t mtu, esp_err_t error) {
+  auto *connection = this->get_connection_(address, false);
+  if (connection != nullptr && connection->request_time_ != 0) {
+    if (connected) {
+      const uint32_t setup_time = millis() - connection->request_time_;
+      ESP_LOGD(TAG, "[%d] [%s] Connected %" PRIu32 " ms after the request", connection->get_connection_index(),
+               connection->address_str().c_str(), setup_time);
+#ifdef USE_SENSOR
+      if (this->connection_setup_time_sensor_ != nullptr)
+        this->connection_setup_time_sensor_->publish_state(setup_time);
+#endif
+    }
+    connection->request_time_ = 0;
+  }
   if (this->api_connection_ == nullptr)
     return;
   api::BluetoothDeviceConnectionResponse call;
@@ -13,6 +13,10 @@
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
 #include "bluetooth_connection.h"
 
 namespace esphome {
@@ -30,6 +34,13 @@ using namespace esp32_ble_client;
 // Version 5: Cache clear support
 static const uint32_t LEGACY_ACTIVE_CONNECTIONS_VERSION = 5;
 static const uint32_t LEGACY_PASSIVE_ONLY_VERSION = 1;
+/// Raw advertisements sent in one message at most, a full batch is sent before the interval is over.
+static const size_t MAX_RAW_ADVERTISEMENTS_BATCH = 16;
+/// GATT services sent per connection and loop while discovering a device.
+static const int MAX_SERVICES_PER_LOOP = 4;
+/// Connection requests waiting for a free slot at most, and how long each may wait.
+static const size_t MAX_QUEUED_CONNECTIONS = 8;
+static const uint32_t CONNECTION_QUEUE_TIMEOUT = 20000;
 
 enum BluetoothProxyFeature : uint32_t {
   FEATURE_PASSIVE_SCAN = 1 << 0,
@@ -91,6 +102,11 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   }
 
   void set_active(bool active) { this->active_ = active; }
+  /// Collect raw advertisements for this long before sending them, 0 sends them once per scan result batch.
+  void set_batch_interval(uint32_t batch_interval) { this->batch_interval_ = batch_interval; }
+#ifdef USE_SENSOR
+  void set_connection_setup_time_sensor(sensor::Sensor *sensor) { this->connection_setup_time_sensor_ = sensor; }
+#endif
   bool has_active() { return this->active_; }
 
   uint32_t get_legacy_version() const {
@@ -116,6 +132,14 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
 
  protected:
   void send_api_packet_(const esp32_ble_tracker::ESPBTDevice &device);
+  void flush_raw_advertisements_();
+  bool get_gatt_service_(BluetoothConnection *connection, uint16_t offset, api::BluetoothGATTService &service_resp);
+
+  void connect_device_(const api::BluetoothDeviceRequest &msg, uint32_t request_time);
+  /// Wait for a free connection, the requests are served first come first served.
+  void queue_connection_request_(const api::BluetoothDeviceRequest &msg, uint32_t request_time);
+  bool remove_connection_request_(uint64_t address);
+  void process_connection_queue_();
 
   BluetoothConnection *get_connection_(uint64_t address, bool reserve);
 
@@ -124,6 +148,22 @@ class BluetoothProxy : public esp32_ble_tracker::ESPBTDeviceListener, public Com
   std::vector<BluetoothConnection *> connections_{};
   api::APIConnection *api_connection_{nullptr};
   bool raw_advertisements_{false};
+
+  uint32_t batch_interval_{0};
+  /// The batch is kept between sends so its entries' storage is reused, only the first count entries are pending.
+  api::BluetoothLERawAdvertisementsResponse raw_advertisements_batch_;
+  std::vector<api::BluetoothLERawAdvertisement> raw_advertisements_spare_;
+  size_t raw_advertisements_count_{0};
+  uint32_t raw_advertisements_batch_start_{0};
+
+  struct PendingConnection {
+    api::BluetoothDeviceRequest request;
+    uint32_t request_time;
+  };
+  std::vector<PendingConnection> connection_queue_;
+#ifdef USE_SENSOR
+  sensor::Sensor *connection_setup_time_sensor_{nullptr};
+#endif
 };
 
 extern BluetoothProxy *global_bluetooth_proxy;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -0,0 +1,34 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    DEVICE_CLASS_DURATION,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+)
+from . import BluetoothProxy
+
+DEPENDENCIES = ["bluetooth_proxy"]
+
+CONF_BLUETOOTH_PROXY_ID = "bluetooth_proxy_id"
+CONF_CONNECTION_SETUP_TIME = "connection_setup_time"
+
+CONFIG_SCHEMA = {
+    cv.GenerateID(CONF_BLUETOOTH_PROXY_ID): cv.use_id(BluetoothProxy),
+    cv.Optional(CONF_CONNECTION_SETUP_TIME): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        accuracy_decimals=0,
+        device_class=DEVICE_CLASS_DURATION,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+}
+
+
+async def to_code(config):
+    proxy = await cg.get_variable(config[CONF_BLUETOOTH_PROXY_ID])
+
+    if setup_time_conf := config.get(CONF_CONNECTION_SETUP_TIME):
+        sens = await sensor.new_sensor(setup_time_conf)
+        cg.add(proxy.set_connection_setup_time_sensor(sens))
@@ -39,7 +39,11 @@ canbus_ns = cg.esphome_ns.namespace("canbus")
 CanbusComponent = canbus_ns.class_("CanbusComponent", cg.Component)
 CanbusTrigger = canbus_ns.class_(
     "CanbusTrigger",
-    automation.Trigger.template(cg.std_vector.template(cg.uint8), cg.uint32),
+    automation.Trigger.template(
+        cg.std_vector.template(cg.uint8).operator("ref").operator("const"),
+        cg.uint32,
+        cg.bool_,
+    ),
     cg.Component,
 )
 CanSpeed = canbus_ns.enum("CAN_SPEED")
@@ -114,7 +118,10 @@ async def setup_canbus_core_(var, config):
         await automation.build_automation(
             trigger,
             [
-                (cg.std_vector.template(cg.uint8), "x"),
+                (
+                    cg.std_vector.template(cg.uint8).operator("ref").operator("const"),
+                    "x",
+                ),
                 (cg.uint32, "can_id"),
                 (cg.bool_, "remote_transmission_request"),
             ],
@@ -53,9 +53,52 @@ void Canbus::add_trigger(CanbusTrigger *trigger) {
   } else {
     ESP_LOGVV(TAG, "add trigger for std canid=0x%03x", trigger->can_id_);
   }
-  this->triggers_.push_back(trigger);
+  // a mask that covers all bits of the id only matches that id
+  const uint32_t width = can_id_width_(trigger->use_extended_id_);
+  if ((trigger->can_id_mask_ & width) == width) {
+    this->exact_triggers_.emplace(can_id_key_(trigger->can_id_, trigger->use_extended_id_), trigger);
+  } else {
+    this->masked_triggers_.push_back(trigger);
+  }
 };
 
+void Canbus::trigger_(CanbusTrigger *trigger, const struct CanFrame &frame) {
+  if (!trigger->remote_transmission_request_.has_value() ||
+      trigger->remote_transmission_request_.value() == frame.remote_transmission_request) {
+    trigger->trigger(this->data_, frame.can_id, frame.remote_transmission_request);
+  }
+}
+
+bool Canbus::get_acceptance_filter_(bool *use_extended_id, uint32_t *can_id, uint32_t *can_id_mask) const {
+  bool first = true;
+  uint32_t width = 0;
+  auto add = [&](const CanbusTrigger *trigger) {
+    if (first) {
+      first = false;
+      *use_extended_id = trigger->use_extended_id_;
+      width = can_id_width_(*use_extended_id);
+      *can_id_mask = trigger->can_id_mask_ & width;
+      *can_id = trigger->can_id_ & *can_id_mask;
+      return true;
+    }
+    if (trigger->use_extended_id_ != *use_extended_id)
+      return false;
+    // only the bits that all triggers care about and agree on are left
+    *can_id_mask &= trigger->can_id_mask_ & ~(trigger->can_id_ ^ *can_id);
+    *can_id &= *can_id_mask;
+    return true;
+  };
+  for (const auto &entry : this->exact_triggers_) {
+    if (!add(entry.second))
+      return false;
+  }
+  for (const auto *trigger : this->masked_triggers_) {
+    if (!add(trigger))
+      return false;
+  }
+  return !first;
+}
+
 void Canbus::loop() {
   struct CanFrame can_message;
   // read all messages until queue is empty
@@ -70,21 +113,20 @@ void Canbus::loop() {
                can_message.can_data_length_code);
     }
 
-    std::vector<uint8_t> data;
-
     // show data received
     for (int i = 0; i < can_message.can_data_length_code; i++) {
       ESP_LOGV(TAG, "  can_message.data[%d]=%02x", i, can_message.data[i]);
-      data.push_back(can_message.data[i]);
     }
+    this->data_.assign(can_message.data, can_message.data + can_message.can_data_length_code);
 
     // fire all triggers
-    for (auto *trigger : this->triggers_) {
+    auto range = this->exact_triggers_.equal_range(can_id_key_(can_message.can_id, can_message.use_extended_id));
+    for (auto it = range.first; it != range.second; ++it)
+      this->trigger_(it->second, can_message);
+    for (auto *trigger : this->masked_triggers_) {
       if ((trigger->can_id_ == (can_message.can_id & trigger->can_id_mask_)) &&
-          (trigger->use_extended_id_ == can_message.use_extended_id) &&
-          (!trigger->remote_transmission_request_.has_value() ||
-           trigger->remote_transmission_request_.value() == can_message.remote_transmission_request)) {
-        trigger->trigger(data, can_message.can_id, can_message.remote_transmission_request);
+          (trigger->use_extended_id_ == can_message.use_extended_id)) {
+        this->trigger_(trigger, can_message);
       }
     }
   }
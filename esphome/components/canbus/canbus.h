@@ -4,6 +4,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/optional.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace esphome {
@@ -47,6 +48,9 @@ template<typename... Ts> class CanbusSendAction;
 
 /* CAN payload length definitions according to ISO 11898-1 */
 static const uint8_t CAN_MAX_DATA_LENGTH = 8;
+/* Bits of a standard (11 bit) and an extended (29 bit) CAN id */
+static const uint32_t CAN_STANDARD_ID_MASK = 0x7FF;
+static const uint32_t CAN_EXTENDED_ID_MASK = 0x1FFFFFFF;
 
 /*
 Can Frame describes a normative CAN Frame
@@ -83,7 +87,12 @@ class Canbus : public Component {
 
  protected:
   template<typename... Ts> friend class CanbusSendAction;
-  std::vector<CanbusTrigger *> triggers_{};
+  /// Triggers for one exact CAN id, looked up by can_id_key_() so a frame doesn't need to be compared with all of them
+  std::unordered_multimap<uint32_t, CanbusTrigger *> exact_triggers_{};
+  /// Triggers with a CAN id mask, these are checked for every frame
+  std::vector<CanbusTrigger *> masked_triggers_{};
+  /// Payload of the frame being dispatched, reused so receiving a frame doesn't allocate
+  std::vector<uint8_t> data_{};
   uint32_t can_id_;
   bool use_extended_id_;
   CanSpeed bit_rate_;
@@ -91,6 +100,20 @@ class Canbus : public Component {
   virtual bool setup_internal();
   virtual Error send_message(struct CanFrame *frame);
   virtual Error read_message(struct CanFrame *frame);
+
+  static uint32_t can_id_key_(uint32_t can_id, bool use_extended_id) {
+    return use_extended_id ? can_id | 0x80000000UL : can_id;
+  }
+  static uint32_t can_id_width_(bool use_extended_id) {
+    return use_extended_id ? CAN_EXTENDED_ID_MASK : CAN_STANDARD_ID_MASK;
+  }
+  void trigger_(CanbusTrigger *trigger, const struct CanFrame &frame);
+  /** Combine the ids of all triggers into a single id and mask for the acceptance filter of the hardware.
+   *
+   * Every frame a trigger wants matches the result, some others may too. Returns false if the filter has to accept
+   * all frames, which is the case without triggers or when they mix standard and extended ids.
+   */
+  bool get_acceptance_filter_(bool *use_extended_id, uint32_t *can_id, uint32_t *can_id_mask) const;
 };
 
 template<typename... Ts> class CanbusSendAction : public Action<Ts...>, public Parented<Canbus> {
@@ -133,20 +156,21 @@ template<typename... Ts> class CanbusSendAction : public Action<Ts...>, public P
   std::vector<uint8_t> data_static_{};
 };
 
-class CanbusTrigger : public Trigger<std::vector<uint8_t>, uint32_t, bool>, public Component {
+class CanbusTrigger : public Trigger<const std::vector<uint8_t> &, uint32_t, bool>, public Component {
   friend class Canbus;
 
  public:
+  /// Registers with the parent right away, so the parent knows all the ids it has to receive before its setup().
   explicit CanbusTrigger(Canbus *parent, const std::uint32_t can_id, const std::uint32_t can_id_mask,
                          const bool use_extended_id)
-      : parent_(parent), can_id_(can_id), can_id_mask_(can_id_mask), use_extended_id_(use_extended_id){};
+      : parent_(parent), can_id_(can_id), can_id_mask_(can_id_mask), use_extended_id_(use_extended_id) {
+    this->parent_->add_trigger(this);
+  };
 
   void set_remote_transmission_request(bool remote_transmission_request) {
     this->remote_transmission_request_ = remote_transmission_request;
   }
 
-  void setup() override { this->parent_->add_trigger(this); }
-
  protected:
   Canbus *parent_;
   uint32_t can_id_;
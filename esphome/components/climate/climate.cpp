@@ -1,5 +1,6 @@
 #include "climate.h"
 #include "esphome/core/macros.h"
+#include "esphome/core/preference_saver.h"
 
 namespace esphome {
 namespace climate {
@@ -372,7 +373,7 @@ void Climate::save_state_() {
     state.swing_mode = this->swing_mode;
   }
 
-  this->rtc_.save(&state);
+  global_preference_saver.save(&this->rtc_, &state);
 }
 void Climate::publish_state() {
   ESP_LOGD(TAG, "'%s' - Sending state:", this->name_.c_str());
@@ -13,6 +13,8 @@ from esphome.const import CONF_SUPPORTS_COOL, CONF_SUPPORTS_HEAT, CONF_SENSOR
 AUTO_LOAD = ["sensor", "remote_base"]
 CODEOWNERS = ["@glmnet"]
 
+CONF_TRANSMIT_DELAY = "transmit_delay"
+
 climate_ir_ns = cg.esphome_ns.namespace("climate_ir")
 ClimateIR = climate_ir_ns.class_(
     "ClimateIR", climate.Climate, cg.Component, remote_base.RemoteReceiverListener
@@ -26,6 +28,9 @@ CLIMATE_IR_SCHEMA = climate.CLIMATE_SCHEMA.extend(
         cv.Optional(CONF_SUPPORTS_COOL, default=True): cv.boolean,
         cv.Optional(CONF_SUPPORTS_HEAT, default=True): cv.boolean,
         cv.Optional(CONF_SENSOR): cv.use_id(sensor.Sensor),
+        cv.Optional(
+            CONF_TRANSMIT_DELAY, default="0ms"
+        ): cv.positive_time_period_milliseconds,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -44,6 +49,8 @@ async def register_climate_ir(var, config):
 
     cg.add(var.set_supports_cool(config[CONF_SUPPORTS_COOL]))
     cg.add(var.set_supports_heat(config[CONF_SUPPORTS_HEAT]))
+    if config[CONF_TRANSMIT_DELAY].total_milliseconds != 0:
+        cg.add(var.set_transmit_delay(config[CONF_TRANSMIT_DELAY]))
     if sensor_id := config.get(CONF_SENSOR):
         sens = await cg.get_variable(sensor_id)
         cg.add(var.set_sensor(sens))
@@ -1,11 +1,16 @@
 #include "climate_ir.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace climate_ir {
 
 static const char *const TAG = "climate_ir";
 
+static const uint32_t TRANSMIT_ID = fnv1_hash_constexpr("transmit");
+
 climate::ClimateTraits ClimateIR::traits() {
   auto traits = climate::ClimateTraits();
   traits.set_supports_current_temperature(this->sensor_ != nullptr);
@@ -56,6 +61,11 @@ void ClimateIR::setup() {
   // Never send nan to HA
   if (std::isnan(this->target_temperature))
     this->target_temperature = 24;
+
+  this->add_on_state_callback([this](climate::Climate & /*unused*/) {
+    if (this->sent_state_valid_ && !this->transmit_pending_ && !(this->current_state_() == this->sent_state_))
+      this->sent_state_valid_ = false;
+  });
 }
 
 void ClimateIR::control(const climate::ClimateCall &call) {
@@ -69,15 +79,58 @@ void ClimateIR::control(const climate::ClimateCall &call) {
     this->swing_mode = *call.get_swing_mode();
   if (call.get_preset().has_value())
     this->preset = *call.get_preset();
-  this->transmit_state();
+  this->request_transmit_();
   this->publish_state();
 }
+
+void ClimateIR::request_transmit_() {
+  if (this->transmit_delay_ == 0) {
+    this->transmit_now_();
+    return;
+  }
+  if (this->transmit_pending_) {
+    this->coalesced_count_++;
+    this->transmit_coalesced_ = true;
+  }
+  this->transmit_pending_ = true;
+  this->set_timeout(TRANSMIT_ID, this->transmit_delay_, [this]() { this->transmit_now_(); });
+}
+
+void ClimateIR::flush_transmit_() {
+  if (!this->transmit_pending_)
+    return;
+  this->cancel_timeout(TRANSMIT_ID);
+  this->transmit_now_();
+}
+
+void ClimateIR::transmit_now_() {
+  const bool coalesced = this->transmit_coalesced_;
+  this->transmit_pending_ = false;
+  this->transmit_coalesced_ = false;
+  // a single call with the same state is sent again, that is how a unit that missed a frame is brought back in sync
+  if (coalesced && this->sent_state_valid_ && this->current_state_() == this->sent_state_) {
+    this->skipped_count_++;
+    ESP_LOGV(TAG, "'%s' - Back to the state last sent, not sending", this->get_name().c_str());
+    return;
+  }
+  this->transmit_state();
+  this->transmit_count_++;
+  // after transmit_state(), some implementations adjust the state while sending
+  this->sent_state_ = this->current_state_();
+  this->sent_state_valid_ = true;
+}
+
+ClimateIR::SentState ClimateIR::current_state_() const {
+  return {this->mode, this->target_temperature, this->fan_mode, this->swing_mode, this->preset};
+}
 void ClimateIR::dump_config() {
   LOG_CLIMATE("", "IR Climate", this);
   ESP_LOGCONFIG(TAG, "  Min. Temperature: %.1f°C", this->minimum_temperature_);
   ESP_LOGCONFIG(TAG, "  Max. Temperature: %.1f°C", this->maximum_temperature_);
   ESP_LOGCONFIG(TAG, "  Supports HEAT: %s", YESNO(this->supports_heat_));
   ESP_LOGCONFIG(TAG, "  Supports COOL: %s", YESNO(this->supports_cool_));
+  if (this->transmit_delay_ != 0)
+    ESP_LOGCONFIG(TAG, "  Transmit Delay: %" PRIu32 " ms", this->transmit_delay_);
 }
 
 }  // namespace climate_ir
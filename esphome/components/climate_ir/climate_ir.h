@@ -17,6 +17,10 @@ namespace climate_ir {
 
     Likewise to decode a IR into the AC state, implement
       bool RemoteReceiverListener::on_receive(remote_base::RemoteReceiveData data) and return true
+
+    With a transmit delay, control() waits that long for further calls and sends only the latest state, so dragging a
+    slider sends one frame instead of one per step. A burst that ends in the state last sent sends nothing.
+    Implementations that send toggle commands call flush_transmit_() around them, toggles must not be merged.
 */
 class ClimateIR : public climate::Climate, public Component, public remote_base::RemoteReceiverListener {
  public:
@@ -41,6 +45,15 @@ class ClimateIR : public climate::Climate, public Component, public remote_base:
   void set_supports_cool(bool supports_cool) { this->supports_cool_ = supports_cool; }
   void set_supports_heat(bool supports_heat) { this->supports_heat_ = supports_heat; }
   void set_sensor(sensor::Sensor *sensor) { this->sensor_ = sensor; }
+  void set_transmit_delay(uint32_t transmit_delay) { this->transmit_delay_ = transmit_delay; }
+
+  /// Frames sent.
+  uint32_t get_transmit_count() const { return this->transmit_count_; }
+  /// States replaced by a later one while waiting for the transmit delay.
+  uint32_t get_coalesced_count() const { return this->coalesced_count_; }
+  /// Bursts not sent because they ended in the state last sent.
+  uint32_t get_skipped_count() const { return this->skipped_count_; }
+  bool is_transmit_pending() const { return this->transmit_pending_; }
 
  protected:
   float minimum_temperature_, maximum_temperature_, temperature_step_;
@@ -53,6 +66,26 @@ class ClimateIR : public climate::Climate, public Component, public remote_base:
   /// Transmit via IR the state of this climate controller.
   virtual void transmit_state() = 0;
 
+  /// Transmit the state now or after the transmit delay.
+  void request_transmit_();
+  /// Transmit a pending state right away.
+  void flush_transmit_();
+  void transmit_now_();
+
+  struct SentState {
+    climate::ClimateMode mode;
+    float target_temperature;
+    optional<climate::ClimateFanMode> fan_mode;
+    climate::ClimateSwingMode swing_mode;
+    optional<climate::ClimatePreset> preset;
+
+    bool operator==(const SentState &other) const {
+      return this->mode == other.mode && this->target_temperature == other.target_temperature &&
+             this->fan_mode == other.fan_mode && this->swing_mode == other.swing_mode && this->preset == other.preset;
+    }
+  };
+  SentState current_state_() const;
+
   // Dummy implement on_receive so implementation is optional for inheritors
   bool on_receive(remote_base::RemoteReceiveData data) override { return false; };
 
@@ -66,6 +99,17 @@ class ClimateIR : public climate::Climate, public Component, public remote_base:
 
   remote_transmitter::RemoteTransmitterComponent *transmitter_;
   sensor::Sensor *sensor_{nullptr};
+
+  uint32_t transmit_delay_{0};
+  bool transmit_pending_{false};
+  /// Whether the pending state replaced another one.
+  bool transmit_coalesced_{false};
+  /// The state of the last frame, invalid once the state changed otherwise, for example from a received frame.
+  SentState sent_state_{};
+  bool sent_state_valid_{false};
+  uint32_t transmit_count_{0};
+  uint32_t coalesced_count_{0};
+  uint32_t skipped_count_{0};
 };
 
 }  // namespace climate_ir
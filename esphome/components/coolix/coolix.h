@@ -19,11 +19,16 @@ class CoolixClimate : public climate_ir::ClimateIR {
 
   /// Override control to change settings of the climate device.
   void control(const climate::ClimateCall &call) override {
+    // the swing command toggles, send it on its own and right away
+    if (call.get_swing_mode().has_value())
+      this->flush_transmit_();
     send_swing_cmd_ = call.get_swing_mode().has_value();
     // swing resets after unit powered off
     if (call.get_mode().has_value() && *call.get_mode() == climate::CLIMATE_MODE_OFF)
       this->swing_mode = climate::CLIMATE_SWING_OFF;
     climate_ir::ClimateIR::control(call);
+    if (send_swing_cmd_)
+      this->flush_transmit_();
   }
 
   /// This static method can be used in other climate components that accept the Coolix protocol. See midea_ir for
@@ -8,6 +8,15 @@ namespace ct_clamp {
 
 static const char *const TAG = "ct_clamp";
 
+void CTClampSensor::setup() {
+  this->continuous_ = this->source_->add_on_samples_callback([this](const float *samples, size_t count) {
+    if (!this->is_sampling_)
+      return;
+    for (size_t i = 0; i < count; i++)
+      this->add_sample_(samples[i]);
+  });
+}
+
 void CTClampSensor::dump_config() {
   LOG_SENSOR("", "CT Clamp Sensor", this);
   ESP_LOGCONFIG(TAG, "  Sample Duration: %.2fs", this->sample_duration_ / 1e3f);
@@ -17,8 +26,9 @@ void CTClampSensor::dump_config() {
 void CTClampSensor::update() {
   // Update only starts the sampling phase, in loop() the actual sampling is happening.
 
-  // Request a high loop() execution interval during sampling phase.
-  this->high_freq_.start();
+  // Request a high loop() execution interval during sampling phase, unless the source streams its samples.
+  if (!this->continuous_)
+    this->high_freq_.start();
 
   // Set timeout for ending sampling phase
   this->set_timeout("read", this->sample_duration_, [this]() {
@@ -51,7 +61,7 @@ void CTClampSensor::update() {
 }
 
 void CTClampSensor::loop() {
-  if (!this->is_sampling_)
+  if (!this->is_sampling_ || this->continuous_)
     return;
 
   // Perform a single sample
@@ -64,6 +74,10 @@ void CTClampSensor::loop() {
     return;
   this->last_value_ = value;
 
+  this->add_sample_(value);
+}
+
+void CTClampSensor::add_sample_(float value) {
   this->num_samples_++;
   this->sample_sum_ += value;
   this->sample_squared_sum_ += value * value;
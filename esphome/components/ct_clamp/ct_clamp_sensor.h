@@ -10,6 +10,7 @@ namespace ct_clamp {
 
 class CTClampSensor : public sensor::Sensor, public PollingComponent {
  public:
+  void setup() override;
   void update() override;
   void loop() override;
   void dump_config() override;
@@ -29,6 +30,11 @@ class CTClampSensor : public sensor::Sensor, public PollingComponent {
   uint32_t sample_duration_;
   /// The sampling source to read values from.
   voltage_sampler::VoltageSampler *source_;
+  /// Whether the source streams its samples to us, so loop() doesn't need to poll it.
+  bool continuous_ = false;
+
+  /// Accumulate \p value into the sums of the current sampling phase.
+  void add_sample_(float value);
 
   /** The DC offset of the circuit.
    *
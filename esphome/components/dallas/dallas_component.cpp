@@ -1,6 +1,8 @@
 #include "dallas_component.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace dallas {
 
@@ -103,12 +105,7 @@ void DallasComponent::register_sensor(DallasTemperatureSensor *sensor) { this->s
 void DallasComponent::update() {
   this->status_clear_warning();
 
-  bool result;
-  {
-    InterruptLock lock;
-    result = this->one_wire_->reset();
-  }
-  if (!result) {
+  if (!this->one_wire_->reset()) {
     ESP_LOGE(TAG, "Requesting conversion failed");
     this->status_set_warning();
     for (auto *sensor : this->sensors_) {
@@ -117,33 +114,39 @@ void DallasComponent::update() {
     return;
   }
 
-  {
-    InterruptLock lock;
-    this->one_wire_->skip();
-    this->one_wire_->write8(DALLAS_COMMAND_START_CONVERSION);
-  }
+  this->one_wire_->skip();
+  this->one_wire_->write8(DALLAS_COMMAND_START_CONVERSION);
 
-  for (auto *sensor : this->sensors_) {
-    this->set_timeout(sensor->get_address_name(), sensor->millis_to_wait_for_conversion(), [this, sensor] {
-      bool res = sensor->read_scratch_pad();
-
-      if (!res) {
-        ESP_LOGW(TAG, "'%s' - Resetting bus for read failed!", sensor->get_name().c_str());
-        sensor->publish_state(NAN);
-        this->status_set_warning();
-        return;
-      }
-      if (!sensor->check_scratch_pad()) {
-        sensor->publish_state(NAN);
-        this->status_set_warning();
-        return;
-      }
+  uint16_t wait = 0;
+  for (auto *sensor : this->sensors_)
+    wait = std::max(wait, sensor->millis_to_wait_for_conversion());
+  this->set_timeout("read", wait, [this]() { this->read_sensor_(0); });
+}
 
-      float tempc = sensor->get_temp_c();
-      ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
-      sensor->publish_state(tempc);
-    });
+void DallasComponent::read_sensor_(size_t index) {
+  if (index >= this->sensors_.size())
+    return;
+  // Read the next sensor in the next loop iteration, so a long bus doesn't block the loop for all sensors at once
+  this->defer("read", [this, index]() { this->read_sensor_(index + 1); });
+
+  auto *sensor = this->sensors_[index];
+  bool res = sensor->read_scratch_pad();
+
+  if (!res) {
+    ESP_LOGW(TAG, "'%s' - Resetting bus for read failed!", sensor->get_name().c_str());
+    sensor->publish_state(NAN);
+    this->status_set_warning();
+    return;
+  }
+  if (!sensor->check_scratch_pad()) {
+    sensor->publish_state(NAN);
+    this->status_set_warning();
+    return;
   }
+
+  float tempc = sensor->get_temp_c();
+  ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
+  sensor->publish_state(tempc);
 }
 
 void DallasTemperatureSensor::set_address(uint64_t address) { this->address_ = address; }
@@ -162,23 +165,15 @@ const std::string &DallasTemperatureSensor::get_address_name() {
 bool IRAM_ATTR DallasTemperatureSensor::read_scratch_pad() {
   auto *wire = this->parent_->one_wire_;
 
-  {
-    InterruptLock lock;
-
-    if (!wire->reset()) {
-      return false;
-    }
+  if (!wire->reset()) {
+    return false;
   }
 
-  {
-    InterruptLock lock;
+  wire->select(this->address_);
+  wire->write8(DALLAS_COMMAND_READ_SCRATCH_PAD);
 
-    wire->select(this->address_);
-    wire->write8(DALLAS_COMMAND_READ_SCRATCH_PAD);
-
-    for (unsigned char &i : this->scratch_pad_) {
-      i = wire->read8();
-    }
+  for (unsigned char &i : this->scratch_pad_) {
+    i = wire->read8();
   }
 
   return true;
@@ -219,20 +214,17 @@ bool DallasTemperatureSensor::setup_sensor() {
   }
 
   auto *wire = this->parent_->one_wire_;
-  {
-    InterruptLock lock;
-    if (wire->reset()) {
-      wire->select(this->address_);
-      wire->write8(DALLAS_COMMAND_WRITE_SCRATCH_PAD);
-      wire->write8(this->scratch_pad_[2]);  // high alarm temp
-      wire->write8(this->scratch_pad_[3]);  // low alarm temp
-      wire->write8(this->scratch_pad_[4]);  // resolution
-      wire->reset();
-
-      // write value to EEPROM
-      wire->select(this->address_);
-      wire->write8(0x48);
-    }
+  if (wire->reset()) {
+    wire->select(this->address_);
+    wire->write8(DALLAS_COMMAND_WRITE_SCRATCH_PAD);
+    wire->write8(this->scratch_pad_[2]);  // high alarm temp
+    wire->write8(this->scratch_pad_[3]);  // low alarm temp
+    wire->write8(this->scratch_pad_[4]);  // resolution
+    wire->reset();
+
+    // write value to EEPROM
+    wire->select(this->address_);
+    wire->write8(0x48);
   }
 
   delay(20);  // allow it to finish operation
@@ -25,6 +25,9 @@ class DallasComponent : public PollingComponent {
  protected:
   friend DallasTemperatureSensor;
 
+  /// Read the sensor at index after a conversion, and schedule reading the next one.
+  void read_sensor_(size_t index);
+
   InternalGPIOPin *pin_;
   ESPOneWire *one_wire_;
   std::vector<DallasTemperatureSensor *> sensors_;
@@ -24,23 +24,32 @@ bool HOT IRAM_ATTR ESPOneWire::reset() {
     delayMicroseconds(2);
   } while (!pin_.digital_read());
 
-  // Send 480µs LOW TX reset pulse (drive bus low, delay H)
+  // Send 480µs LOW TX reset pulse (drive bus low, delay H). It has no upper limit, so interrupts may stretch it.
   pin_.pin_mode(gpio::FLAG_OUTPUT);
   pin_.digital_write(false);
   delayMicroseconds(480);
 
-  // Release the bus, delay I
-  pin_.pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
-  delayMicroseconds(70);
+  bool r;
+  {
+    // The presence pulse has to be sampled within its window
+    InterruptLock lock;
 
-  // sample bus, 0=device(s) present, 1=no device present
-  bool r = !pin_.digital_read();
+    // Release the bus, delay I
+    pin_.pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
+    delayMicroseconds(70);
+
+    // sample bus, 0=device(s) present, 1=no device present
+    r = !pin_.digital_read();
+  }
   // delay J
   delayMicroseconds(410);
   return r;
 }
 
 void HOT IRAM_ATTR ESPOneWire::write_bit(bool bit) {
+  // Only the slot itself is timing critical, the recovery time between slots has no upper limit
+  InterruptLock lock;
+
   // drive bus low
   pin_.pin_mode(gpio::FLAG_OUTPUT);
   pin_.digital_write(false);
@@ -63,6 +72,8 @@ void HOT IRAM_ATTR ESPOneWire::write_bit(bool bit) {
 }
 
 bool HOT IRAM_ATTR ESPOneWire::read_bit() {
+  InterruptLock lock;
+
   // drive bus low
   pin_.pin_mode(gpio::FLAG_OUTPUT);
   pin_.digital_write(false);
@@ -147,13 +158,10 @@ uint64_t IRAM_ATTR ESPOneWire::search() {
     return 0u;
   }
 
-  {
-    InterruptLock lock;
-    if (!this->reset()) {
-      // Reset failed or no devices present
-      this->reset_search();
-      return 0u;
-    }
+  if (!this->reset()) {
+    // Reset failed or no devices present
+    this->reset_search();
+    return 0u;
   }
 
   uint8_t id_bit_number = 1;
@@ -162,58 +170,55 @@ uint64_t IRAM_ATTR ESPOneWire::search() {
   bool search_result = false;
   uint8_t rom_byte_mask = 1;
 
-  {
-    InterruptLock lock;
-    // Initiate search
-    this->write8(ONE_WIRE_ROM_SEARCH);
-    do {
-      // read bit
-      bool id_bit = this->read_bit();
-      // read its complement
-      bool cmp_id_bit = this->read_bit();
-
-      if (id_bit && cmp_id_bit) {
-        // No devices participating in search
-        break;
-      }
+  // Initiate search
+  this->write8(ONE_WIRE_ROM_SEARCH);
+  do {
+    // read bit
+    bool id_bit = this->read_bit();
+    // read its complement
+    bool cmp_id_bit = this->read_bit();
+
+    if (id_bit && cmp_id_bit) {
+      // No devices participating in search
+      break;
+    }
 
-      bool branch;
+    bool branch;
 
-      if (id_bit != cmp_id_bit) {
-        // only chose one branch, the other one doesn't have any devices.
-        branch = id_bit;
+    if (id_bit != cmp_id_bit) {
+      // only chose one branch, the other one doesn't have any devices.
+      branch = id_bit;
+    } else {
+      // there are devices with both 0s and 1s at this bit
+      if (id_bit_number < this->last_discrepancy_) {
+        branch = (this->rom_number8_()[rom_byte_number] & rom_byte_mask) > 0;
       } else {
-        // there are devices with both 0s and 1s at this bit
-        if (id_bit_number < this->last_discrepancy_) {
-          branch = (this->rom_number8_()[rom_byte_number] & rom_byte_mask) > 0;
-        } else {
-          branch = id_bit_number == this->last_discrepancy_;
-        }
-
-        if (!branch) {
-          last_zero = id_bit_number;
-        }
+        branch = id_bit_number == this->last_discrepancy_;
       }
 
-      if (branch) {
-        // set bit
-        this->rom_number8_()[rom_byte_number] |= rom_byte_mask;
-      } else {
-        // clear bit
-        this->rom_number8_()[rom_byte_number] &= ~rom_byte_mask;
+      if (!branch) {
+        last_zero = id_bit_number;
       }
+    }
 
-      // choose/announce branch
-      this->write_bit(branch);
-      id_bit_number++;
-      rom_byte_mask <<= 1;
-      if (rom_byte_mask == 0u) {
-        // go to next byte
-        rom_byte_number++;
-        rom_byte_mask = 1;
-      }
-    } while (rom_byte_number < 8);  // loop through all bytes
-  }
+    if (branch) {
+      // set bit
+      this->rom_number8_()[rom_byte_number] |= rom_byte_mask;
+    } else {
+      // clear bit
+      this->rom_number8_()[rom_byte_number] &= ~rom_byte_mask;
+    }
+
+    // choose/announce branch
+    this->write_bit(branch);
+    id_bit_number++;
+    rom_byte_mask <<= 1;
+    if (rom_byte_mask == 0u) {
+      // go to next byte
+      rom_byte_number++;
+      rom_byte_mask = 1;
+    }
+  } while (rom_byte_number < 8);  // loop through all bytes
 
   if (id_bit_number >= 65) {
     this->last_discrepancy_ = last_zero;
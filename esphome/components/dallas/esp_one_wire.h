@@ -9,6 +9,12 @@ namespace dallas {
 extern const uint8_t ONE_WIRE_ROM_SELECT;
 extern const int ONE_WIRE_ROM_SEARCH;
 
+/** Bit-banged 1-Wire bus on a GPIO pin.
+ *
+ * Interrupts are only disabled for a single time slot, at most about 70µs, as the time between slots has no upper
+ * limit. Longer transfers therefore don't stall Wi-Fi or other interrupt driven code, they only take a bit longer when
+ * interrupts come in between slots.
+ */
 class ESPOneWire {
  public:
   explicit ESPOneWire(InternalGPIOPin *pin);
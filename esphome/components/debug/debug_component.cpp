@@ -3,6 +3,7 @@
 #include <algorithm>
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/version.h"
 #include <cinttypes>
@@ -40,18 +41,6 @@ namespace debug {
 
 static const char *const TAG = "debug";
 
-static uint32_t get_free_heap() {
-#if defined(USE_ESP8266)
-  return ESP.getFreeHeap();  // NOLINT(readability-static-accessed-through-instance)
-#elif defined(USE_ESP32)
-  return heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
-#elif defined(USE_RP2040)
-  return rp2040.getFreeHeap();
-#elif defined(USE_LIBRETINY)
-  return lt_heap_get_free();
-#endif
-}
-
 void DebugComponent::dump_config() {
 #ifndef ESPHOME_LOG_HAS_DEBUG
   return;  // Can't log below if debug logging is disabled
@@ -68,9 +57,13 @@ void DebugComponent::dump_config() {
 #ifdef USE_SENSOR
   LOG_SENSOR("  ", "Free space on heap", this->free_sensor_);
   LOG_SENSOR("  ", "Largest free heap block", this->block_sensor_);
-#if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   LOG_SENSOR("  ", "Heap fragmentation", this->fragmentation_sensor_);
-#endif  // defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
+#ifdef USE_HEAP_TRACKING
+  for (uint8_t i = 0; i < HEAP_TAG_COUNT; i++) {
+    if (this->heap_allocated_sensors_[i] != nullptr || this->heap_peak_sensors_[i] != nullptr)
+      ESP_LOGCONFIG(TAG, "  Heap tracking: %s", heap_tag_to_string(static_cast<HeapTag>(i)));
+  }
+#endif  // USE_HEAP_TRACKING
 #endif  // USE_SENSOR
 
   ESP_LOGD(TAG, "ESPHome version %s", ESPHOME_VERSION);
@@ -412,22 +405,17 @@ void DebugComponent::update() {
   }
 
   if (this->block_sensor_ != nullptr) {
-#if defined(USE_ESP8266)
-    // NOLINTNEXTLINE(readability-static-accessed-through-instance)
-    this->block_sensor_->publish_state(ESP.getMaxFreeBlockSize());
-#elif defined(USE_ESP32)
-    this->block_sensor_->publish_state(heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL));
-#elif defined(USE_LIBRETINY)
-    this->block_sensor_->publish_state(lt_heap_get_max_alloc());
-#endif
+    this->block_sensor_->publish_state(get_largest_free_heap_block());
   }
 
-#if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   if (this->fragmentation_sensor_ != nullptr) {
+#if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
     // NOLINTNEXTLINE(readability-static-accessed-through-instance)
     this->fragmentation_sensor_->publish_state(ESP.getHeapFragmentation());
-  }
+#else
+    this->fragmentation_sensor_->publish_state(get_heap_fragmentation());
 #endif
+  }
 
   if (this->loop_time_sensor_ != nullptr) {
     this->loop_time_sensor_->publish_state(this->max_loop_time_);
@@ -439,6 +427,18 @@ void DebugComponent::update() {
     this->psram_sensor_->publish_state(heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
   }
 #endif  // USE_ESP32
+
+#ifdef USE_HEAP_TRACKING
+  for (uint8_t i = 0; i < HEAP_TAG_COUNT; i++) {
+    if (this->heap_allocated_sensors_[i] == nullptr && this->heap_peak_sensors_[i] == nullptr)
+      continue;
+    HeapTagStats stats = get_heap_tag_stats(static_cast<HeapTag>(i));
+    if (this->heap_allocated_sensors_[i] != nullptr)
+      this->heap_allocated_sensors_[i]->publish_state(stats.allocated);
+    if (this->heap_peak_sensors_[i] != nullptr)
+      this->heap_peak_sensors_[i]->publish_state(stats.peak);
+  }
+#endif  // USE_HEAP_TRACKING
 #endif  // USE_SENSOR
 }
 
@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/macros.h"
 #include "esphome/core/helpers.h"
 
@@ -29,13 +30,19 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_SENSOR
   void set_free_sensor(sensor::Sensor *free_sensor) { free_sensor_ = free_sensor; }
   void set_block_sensor(sensor::Sensor *block_sensor) { block_sensor_ = block_sensor; }
-#if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   void set_fragmentation_sensor(sensor::Sensor *fragmentation_sensor) { fragmentation_sensor_ = fragmentation_sensor; }
-#endif
   void set_loop_time_sensor(sensor::Sensor *loop_time_sensor) { loop_time_sensor_ = loop_time_sensor; }
 #ifdef USE_ESP32
   void set_psram_sensor(sensor::Sensor *psram_sensor) { this->psram_sensor_ = psram_sensor; }
 #endif  // USE_ESP32
+#ifdef USE_HEAP_TRACKING
+  void set_heap_allocated_sensor(HeapTag tag, sensor::Sensor *sensor) {
+    this->heap_allocated_sensors_[static_cast<uint8_t>(tag)] = sensor;
+  }
+  void set_heap_peak_sensor(HeapTag tag, sensor::Sensor *sensor) {
+    this->heap_peak_sensors_[static_cast<uint8_t>(tag)] = sensor;
+  }
+#endif  // USE_HEAP_TRACKING
 #endif  // USE_SENSOR
  protected:
   uint32_t free_heap_{};
@@ -46,13 +53,15 @@ class DebugComponent : public PollingComponent {
 
   sensor::Sensor *free_sensor_{nullptr};
   sensor::Sensor *block_sensor_{nullptr};
-#if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   sensor::Sensor *fragmentation_sensor_{nullptr};
-#endif
   sensor::Sensor *loop_time_sensor_{nullptr};
 #ifdef USE_ESP32
   sensor::Sensor *psram_sensor_{nullptr};
 #endif  // USE_ESP32
+#ifdef USE_HEAP_TRACKING
+  sensor::Sensor *heap_allocated_sensors_[HEAP_TAG_COUNT]{};
+  sensor::Sensor *heap_peak_sensors_[HEAP_TAG_COUNT]{};
+#endif  // USE_HEAP_TRACKING
 #endif  // USE_SENSOR
 
 #ifdef USE_TEXT_SENSOR
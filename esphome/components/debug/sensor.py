@@ -18,6 +18,30 @@ from . import CONF_DEBUG_ID, DebugComponent
 DEPENDENCIES = ["debug"]
 
 CONF_PSRAM = "psram"
+CONF_HEAP_ALLOCATED = "heap_allocated"
+CONF_HEAP_PEAK = "heap_peak"
+
+HeapTag = cg.esphome_ns.enum("HeapTag", is_class=True)
+HEAP_TAGS = {
+    "other": HeapTag.OTHER,
+    "api": HeapTag.API,
+    "ble": HeapTag.BLE,
+    "json": HeapTag.JSON,
+    "display": HeapTag.DISPLAY,
+    "mqtt": HeapTag.MQTT,
+    "light": HeapTag.LIGHT,
+    "audio": HeapTag.AUDIO,
+}
+
+HEAP_TAG_SENSOR_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_BYTES,
+    icon=ICON_COUNTER,
+    accuracy_decimals=0,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+HEAP_TAGS_SCHEMA = cv.Schema(
+    {cv.Optional(tag): HEAP_TAG_SENSOR_SCHEMA for tag in HEAP_TAGS}
+)
 
 CONFIG_SCHEMA = {
     cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -33,15 +57,11 @@ CONFIG_SCHEMA = {
         accuracy_decimals=0,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
-    cv.Optional(CONF_FRAGMENTATION): cv.All(
-        cv.only_on_esp8266,
-        cv.require_framework_version(esp8266_arduino=cv.Version(2, 5, 2)),
-        sensor.sensor_schema(
-            unit_of_measurement=UNIT_PERCENT,
-            icon=ICON_COUNTER,
-            accuracy_decimals=1,
-            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
-        ),
+    cv.Optional(CONF_FRAGMENTATION): sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        icon=ICON_COUNTER,
+        accuracy_decimals=1,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
     cv.Optional(CONF_LOOP_TIME): sensor.sensor_schema(
         unit_of_measurement=UNIT_MILLISECOND,
@@ -59,6 +79,8 @@ CONFIG_SCHEMA = {
             entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
         ),
     ),
+    cv.Optional(CONF_HEAP_ALLOCATED): HEAP_TAGS_SCHEMA,
+    cv.Optional(CONF_HEAP_PEAK): HEAP_TAGS_SCHEMA,
 }
 
 
@@ -84,3 +106,13 @@ async def to_code(config):
     if psram_conf := config.get(CONF_PSRAM):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
+
+    # Accounting per subsystem adds a header to every allocation, so it is opt-in
+    for key, setter in (
+        (CONF_HEAP_ALLOCATED, debug_component.set_heap_allocated_sensor),
+        (CONF_HEAP_PEAK, debug_component.set_heap_peak_sensor),
+    ):
+        for tag, tag_conf in config.get(key, {}).items():
+            cg.add_define("USE_HEAP_TRACKING")
+            sens = await sensor.new_sensor(tag_conf)
+            cg.add(setter(HEAP_TAGS[tag], sens))
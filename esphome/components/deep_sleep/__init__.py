@@ -154,6 +154,7 @@ CONF_DEFAULT = "default"
 CONF_GPIO_WAKEUP_REASON = "gpio_wakeup_reason"
 CONF_TOUCH_WAKEUP_REASON = "touch_wakeup_reason"
 CONF_UNTIL = "until"
+CONF_SLEEP_WHEN_PUBLISHED = "sleep_when_published"
 
 WAKEUP_CAUSES_SCHEMA = cv.Schema(
     {
@@ -189,6 +190,7 @@ CONFIG_SCHEMA = cv.Schema(
             ),
         ),
         cv.Optional(CONF_TOUCH_WAKEUP): cv.All(cv.only_on_esp32, cv.boolean),
+        cv.Optional(CONF_SLEEP_WHEN_PUBLISHED, default=False): cv.boolean,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -241,6 +243,9 @@ async def to_code(config):
     if CONF_TOUCH_WAKEUP in config:
         cg.add(var.set_touch_wakeup(config[CONF_TOUCH_WAKEUP]))
 
+    if config[CONF_SLEEP_WHEN_PUBLISHED]:
+        cg.add(var.set_sleep_when_published(True))
+
     cg.add_define("USE_DEEP_SLEEP")
 
 
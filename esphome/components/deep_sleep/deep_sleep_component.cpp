@@ -7,6 +7,13 @@
 #include <Esp.h>
 #endif
 
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
+#ifdef USE_MQTT
+#include "esphome/components/mqtt/mqtt_client.h"
+#endif
+
 namespace esphome {
 namespace deep_sleep {
 
@@ -54,6 +61,9 @@ void DeepSleepComponent::dump_config() {
   if (this->run_duration_.has_value()) {
     ESP_LOGCONFIG(TAG, "  Run Duration: %u ms", *this->run_duration_);
   }
+  if (this->sleep_when_published_) {
+    ESP_LOGCONFIG(TAG, "  Sleep When Published: YES");
+  }
 #ifdef USE_ESP32
   if (wakeup_pin_ != nullptr) {
     LOG_PIN("  Wakeup Pin: ", this->wakeup_pin_);
@@ -66,8 +76,48 @@ void DeepSleepComponent::dump_config() {
 #endif
 }
 void DeepSleepComponent::loop() {
-  if (this->next_enter_deep_sleep_)
+  if (this->next_enter_deep_sleep_) {
+    this->begin_sleep();
+  } else if (this->sleep_when_published_ && !this->published_ && this->are_states_published_()) {
+    this->published_ = true;
+    ESP_LOGI(TAG, "All states published after %u ms", millis());
     this->begin_sleep();
+  }
+}
+bool DeepSleepComponent::are_states_published_() const {
+#ifdef USE_SENSOR
+  for (auto *obj : App.get_sensors()) {
+    if (!obj->is_internal() && !obj->has_state())
+      return false;
+  }
+#endif
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors()) {
+    if (!obj->is_internal() && !obj->has_state())
+      return false;
+  }
+#endif
+#ifdef USE_TEXT_SENSOR
+  for (auto *obj : App.get_text_sensors()) {
+    if (!obj->is_internal() && !obj->has_state())
+      return false;
+  }
+#endif
+
+  // the states only count as delivered once one of the transports took all of them
+#ifdef USE_MQTT
+  if (mqtt::global_mqtt_client != nullptr && mqtt::global_mqtt_client->is_publish_complete())
+    return true;
+#endif
+#ifdef USE_API
+  if (api::global_api_server != nullptr && api::global_api_server->are_states_sent())
+    return true;
+#endif
+#if defined(USE_MQTT) || defined(USE_API)
+  return false;
+#else
+  return true;
+#endif
 }
 float DeepSleepComponent::get_loop_priority() const {
   return -100.0f;  // run after everything else is ready
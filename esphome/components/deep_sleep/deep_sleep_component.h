@@ -87,6 +87,11 @@ class DeepSleepComponent : public Component {
   /// Set a duration in ms for how long the code should run before entering deep sleep mode.
   void set_run_duration(uint32_t time_ms);
 
+  /** Enter deep sleep as soon as every sensor has a state and all states were delivered, instead of waiting for
+   * the run duration, which then only bounds the awake time.
+   */
+  void set_sleep_when_published(bool sleep_when_published) { this->sleep_when_published_ = sleep_when_published; }
+
   void setup() override;
   void dump_config() override;
   void loop() override;
@@ -103,6 +108,8 @@ class DeepSleepComponent : public Component {
   // Returns nullopt if no run duration is set. Otherwise, returns the run
   // duration before entering deep sleep.
   optional<uint32_t> get_run_duration_() const;
+  /// Whether every sensor has a state and the connected MQTT broker or API client received all of them.
+  bool are_states_published_() const;
 
   optional<uint64_t> sleep_duration_;
 #ifdef USE_ESP32
@@ -115,6 +122,8 @@ class DeepSleepComponent : public Component {
   optional<uint32_t> run_duration_;
   bool next_enter_deep_sleep_{false};
   bool prevent_{false};
+  bool sleep_when_published_{false};
+  bool published_{false};
 };
 
 extern bool global_has_deep_sleep;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
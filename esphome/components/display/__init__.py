@@ -4,6 +4,7 @@ from esphome import core, automation
 from esphome.automation import maybe_simple_id
 from esphome.const import (
     CONF_AUTO_CLEAR_ENABLED,
+    CONF_DEFERRABLE,
     CONF_ID,
     CONF_LAMBDA,
     CONF_PAGES,
@@ -87,6 +88,10 @@ FULL_DISPLAY_SCHEMA = BASIC_DISPLAY_SCHEMA.extend(
 
 
 async def setup_display_core_(var, config):
+    # Redrawing can wait for the next loop iteration, unless configured otherwise
+    if CONF_DEFERRABLE not in config:
+        cg.add(var.set_deferrable(True))
+
     if CONF_ROTATION in config:
         cg.add(var.set_rotation(DISPLAY_ROTATIONS[config[CONF_ROTATION]]))
 
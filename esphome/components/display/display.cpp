@@ -2,6 +2,9 @@
 
 #include <utility>
 
+#include "display_color_utils.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -35,11 +38,20 @@ void HOT Display::line(int x1, int y1, int x2, int y2, Color color) {
     }
   }
 }
-void HOT Display::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
+void HOT Display::horizontal_line(int x, int y, int width, Color color) { this->fill_span(x, y, width, color); }
+void HOT Display::fill_span(int x, int y, int width, Color color) {
   for (int i = x; i < x + width; i++)
     this->draw_pixel_at(i, y, color);
 }
+void HOT Display::blit_rgb565(int x, int y, int width, int height, const uint8_t *data) {
+  for (int img_y = 0; img_y < height; img_y++) {
+    for (int img_x = 0; img_x < width; img_x++) {
+      const uint8_t *pixel = data + (img_y * width + img_x) * 2;
+      uint16_t rgb565 = progmem_read_byte(pixel) << 8 | progmem_read_byte(pixel + 1);
+      this->draw_pixel_at(x + img_x, y + img_y, ColorUtil::rgb565_to_color(rgb565));
+    }
+  }
+}
 void HOT Display::vertical_line(int x, int y, int height, Color color) {
   // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
   for (int i = y; i < y + height; i++)
@@ -52,9 +64,8 @@ void Display::rectangle(int x1, int y1, int width, int height, Color color) {
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
 void Display::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
   for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
+    this->fill_span(x1, i, width, color);
   }
 }
 void HOT Display::circle(int center_x, int center_xy, int radius, Color color) {
@@ -107,11 +118,11 @@ void Display::filled_circle(int center_x, int center_y, int radius, Color color)
   } while (dx <= 0);
 }
 
-void Display::print(int x, int y, BaseFont *font, Color color, TextAlign align, const char *text) {
+void Display::print(int x, int y, BaseFont *font, Color color, TextAlign align, const char *text, Color background) {
   int x_start, y_start;
   int width, height;
   this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
-  font->print(x_start, y_start, this, color, text);
+  font->print(x_start, y_start, this, color, text, background);
 }
 void Display::vprintf_(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, va_list arg) {
   char buffer[256];
@@ -204,8 +215,8 @@ void Display::get_text_bounds(int x, int y, const char *text, BaseFont *font, Te
       break;
   }
 }
-void Display::print(int x, int y, BaseFont *font, Color color, const char *text) {
-  this->print(x, y, font, color, TextAlign::TOP_LEFT, text);
+void Display::print(int x, int y, BaseFont *font, Color color, const char *text, Color background) {
+  this->print(x, y, font, color, TextAlign::TOP_LEFT, text, background);
 }
 void Display::print(int x, int y, BaseFont *font, TextAlign align, const char *text) {
   this->print(x, y, font, COLOR_ON, align, text);
@@ -261,6 +272,7 @@ void Display::show_page(DisplayPage *page) {
 void Display::show_next_page() { this->page_->show_next(); }
 void Display::show_prev_page() { this->page_->show_prev(); }
 void Display::do_update_() {
+  HeapTagScope heap_tag(HeapTag::DISPLAY);
   if (this->auto_clear_enabled_) {
     this->clear();
   }
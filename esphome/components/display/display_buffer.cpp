@@ -3,25 +3,125 @@
 #include <utility>
 
 #include "esphome/core/application.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
 namespace display {
 
 static const char *const TAG = "display";
+/// Pixels a region may grow by before a separate region is cheaper, roughly the cost of addressing another window.
+static const int32_t DISPLAY_DIRTY_MERGE_AREA = 64;
 
 void DisplayBuffer::init_internal_(uint32_t buffer_length) {
-  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  ExternalRAMAllocator<uint8_t> allocator(HeapTag::DISPLAY, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   this->buffer_ = allocator.allocate(buffer_length);
   if (this->buffer_ == nullptr) {
     ESP_LOGE(TAG, "Could not allocate buffer for display!");
     return;
   }
   this->clear();
+  // The display's memory doesn't hold what the buffer was cleared to yet
+  this->mark_all_dirty_();
+}
+
+void DisplayBuffer::mark_dirty_(Rect rect) {
+  if (rect.w <= 0 || rect.h <= 0)
+    return;
+  this->extend_dirty_(rect);
+}
+
+void DisplayBuffer::mark_all_dirty_() {
+  this->dirty_rects_[0] = Rect(0, 0, this->get_width_internal(), this->get_height_internal());
+  this->dirty_count_ = 1;
+  this->dirty_last_ = 0;
+}
+
+static inline int32_t area(const Rect &rect) { return int32_t(rect.w) * rect.h; }
+static inline bool overlap(const Rect &a, const Rect &b) {
+  return a.x < b.x2() && b.x < a.x2() && a.y < b.y2() && b.y < a.y2();
+}
+static inline bool touch(const Rect &a, const Rect &b) {
+  return a.x <= b.x2() && b.x <= a.x2() && a.y <= b.y2() && b.y <= a.y2();
+}
+static inline Rect merged(Rect a, const Rect &b) {
+  a.extend(b);
+  return a;
+}
+
+void DisplayBuffer::extend_dirty_(Rect rect) {
+  // Grow a region it overlaps or borders, or the one that gets the least bigger by it...
+  uint8_t best = 0;
+  int32_t best_growth = INT32_MAX;
+  for (uint8_t i = 0; i < this->dirty_count_; i++) {
+    const Rect &dirty = this->dirty_rects_[i];
+    int32_t growth = touch(dirty, rect) ? INT32_MIN : area(merged(dirty, rect)) - area(dirty);
+    if (growth < best_growth) {
+      best = i;
+      best_growth = growth;
+    }
+  }
+  // ...unless it is far enough away to be worth a separate transfer
+  if (this->dirty_count_ < DISPLAY_MAX_DIRTY_RECTS && best_growth > DISPLAY_DIRTY_MERGE_AREA + area(rect)) {
+    this->dirty_last_ = this->dirty_count_;
+    this->dirty_rects_[this->dirty_count_++] = rect;
+    return;
+  }
+  this->dirty_rects_[best].extend(rect);
+
+  // Growing may have made it overlap others, fold those in so nothing is transferred twice
+  bool merged_any;
+  do {
+    merged_any = false;
+    for (uint8_t i = 0; i < this->dirty_count_; i++) {
+      if (i == best || !overlap(this->dirty_rects_[i], this->dirty_rects_[best]))
+        continue;
+      this->dirty_rects_[best].extend(this->dirty_rects_[i]);
+      this->dirty_rects_[i] = this->dirty_rects_[--this->dirty_count_];
+      if (best == this->dirty_count_)
+        best = i;
+      merged_any = true;
+      break;
+    }
+  } while (merged_any);
+  this->dirty_last_ = best;
+}
+
+uint8_t rotate_madctl(uint8_t madctl, DisplayRotation rotation) {
+  // Every rotation is a swap of the axes (MV) followed by mirroring some of them, so it can be folded into the mirror
+  // and exchange bits: when it swaps the axes, the existing mirror bits trade places before its own are applied.
+  uint8_t mirror;
+  bool swap;
+  switch (rotation) {
+    case DISPLAY_ROTATION_90_DEGREES:
+      mirror = DISPLAY_MADCTL_MY;
+      swap = true;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      mirror = DISPLAY_MADCTL_MX | DISPLAY_MADCTL_MY;
+      swap = false;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      mirror = DISPLAY_MADCTL_MX;
+      swap = true;
+      break;
+    case DISPLAY_ROTATION_0_DEGREES:
+    default:
+      return madctl;
+  }
+  if (swap) {
+    uint8_t swapped = madctl & ~(DISPLAY_MADCTL_MX | DISPLAY_MADCTL_MY);
+    if (madctl & DISPLAY_MADCTL_MX)
+      swapped |= DISPLAY_MADCTL_MY;
+    if (madctl & DISPLAY_MADCTL_MY)
+      swapped |= DISPLAY_MADCTL_MX;
+    madctl = swapped ^ DISPLAY_MADCTL_MV;
+  }
+  return madctl ^ mirror;
 }
 
 int DisplayBuffer::get_width() {
-  switch (this->rotation_) {
+  switch (this->get_software_rotation_()) {
     case DISPLAY_ROTATION_90_DEGREES:
     case DISPLAY_ROTATION_270_DEGREES:
       return this->get_height_internal();
@@ -33,7 +133,7 @@ int DisplayBuffer::get_width() {
 }
 
 int DisplayBuffer::get_height() {
-  switch (this->rotation_) {
+  switch (this->get_software_rotation_()) {
     case DISPLAY_ROTATION_0_DEGREES:
     case DISPLAY_ROTATION_180_DEGREES:
       return this->get_height_internal();
@@ -48,7 +148,7 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
   if (!this->get_clipping().inside(x, y))
     return;  // NOLINT
 
-  switch (this->rotation_) {
+  switch (this->get_software_rotation_()) {
     case DISPLAY_ROTATION_0_DEGREES:
       break;
     case DISPLAY_ROTATION_90_DEGREES:
@@ -68,5 +168,57 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
   App.feed_wdt();
 }
 
+void HOT DisplayBuffer::fill_span(int x, int y, int width, Color color) {
+  int min_x, max_x, min_y, max_y;
+  if (!this->clamp_x_(x, width, min_x, max_x) || !this->clamp_y_(y, 1, min_y, max_y))
+    return;
+  width = max_x - min_x;
+
+  switch (this->get_software_rotation_()) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      this->fill_absolute_rect_internal(min_x, y, width, 1, color);
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      this->fill_absolute_rect_internal(this->get_width_internal() - y - 1, min_x, 1, width, color);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      this->fill_absolute_rect_internal(this->get_width_internal() - max_x, this->get_height_internal() - y - 1, width,
+                                        1, color);
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      this->fill_absolute_rect_internal(y, this->get_height_internal() - max_x, 1, width, color);
+      break;
+  }
+  App.feed_wdt();
+}
+
+void HOT DisplayBuffer::blit_rgb565(int x, int y, int width, int height, const uint8_t *data) {
+  if (this->get_software_rotation_() != DISPLAY_ROTATION_0_DEGREES) {
+    Display::blit_rgb565(x, y, width, height, data);
+    return;
+  }
+  int min_x, max_x, min_y, max_y;
+  if (!this->clamp_x_(x, width, min_x, max_x) || !this->clamp_y_(y, height, min_y, max_y))
+    return;
+  for (int row = min_y; row < max_y; row++) {
+    this->draw_absolute_rgb565_internal(min_x, row, max_x - min_x, data + ((row - y) * width + (min_x - x)) * 2);
+    App.feed_wdt();
+  }
+}
+
+void HOT DisplayBuffer::fill_absolute_rect_internal(int x, int y, int w, int h, Color color) {
+  for (int row = y; row < y + h; row++) {
+    for (int col = x; col < x + w; col++)
+      this->draw_absolute_pixel_internal(col, row, color);
+  }
+}
+
+void HOT DisplayBuffer::draw_absolute_rgb565_internal(int x, int y, int width, const uint8_t *data) {
+  for (int i = 0; i < width; i++) {
+    uint16_t rgb565 = progmem_read_byte(data + i * 2) << 8 | progmem_read_byte(data + i * 2 + 1);
+    this->draw_absolute_pixel_internal(x + i, y, ColorUtil::rgb565_to_color(rgb565));
+  }
+}
+
 }  // namespace display
 }  // namespace esphome
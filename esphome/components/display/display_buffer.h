@@ -12,6 +12,22 @@
 namespace esphome {
 namespace display {
 
+/// Number of separate regions tracked as changed before the closest ones get merged.
+static const uint8_t DISPLAY_MAX_DIRTY_RECTS = 4;
+
+/// Memory access control bits of MIPI DCS controllers (ILI9341, ST7789, ...), used to rotate in hardware.
+static const uint8_t DISPLAY_MADCTL_MY = 0x80;
+static const uint8_t DISPLAY_MADCTL_MX = 0x40;
+static const uint8_t DISPLAY_MADCTL_MV = 0x20;
+
+/** Add a rotation to the memory access control (MADCTL) value a controller was initialized with.
+ *
+ * Writing the result makes the controller lay out incoming pixels like the software rotation would, so the driver can
+ * keep its buffer in the rotated orientation and use set_hardware_rotation_(). The row and column address ranges of the
+ * controller are swapped for 90 and 270 degrees.
+ */
+uint8_t rotate_madctl(uint8_t madctl, DisplayRotation rotation);
+
 class DisplayBuffer : public Display {
  public:
   /// Get the width of the image in pixels with rotation applied.
@@ -21,16 +37,63 @@ class DisplayBuffer : public Display {
 
   /// Set a single pixel at the specified coordinates to the given color.
   void draw_pixel_at(int x, int y, Color color) override;
+  /// Clip the span once and fill it in absolute coordinates instead of going through draw_pixel_at per pixel.
+  void fill_span(int x, int y, int width, Color color) override;
+  /// Clip the block once and draw it row by row when not rotated.
+  void blit_rgb565(int x, int y, int width, int height, const uint8_t *data) override;
 
   virtual int get_height_internal() = 0;
   virtual int get_width_internal() = 0;
 
  protected:
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
+  /// Fill a region in absolute (unrotated) coordinates that lies within the display, override for direct fills.
+  virtual void fill_absolute_rect_internal(int x, int y, int w, int h, Color color);
+  /// Draw a row of big endian RGB565 pixels from PROGMEM at absolute coordinates that lie within the display.
+  virtual void draw_absolute_rgb565_internal(int x, int y, int width, const uint8_t *data);
 
   void init_internal_(uint32_t buffer_length);
 
+  /** Call from setup() when the controller applies rotation_ itself.
+   *
+   * get_width_internal() and get_height_internal() must then return the rotated size, and drawing passes coordinates
+   * to the *_internal methods as they are instead of transforming every pixel.
+   */
+  void set_hardware_rotation_() { this->hardware_rotation_ = true; }
+  /// The rotation that is left to apply in software.
+  DisplayRotation get_software_rotation_() const {
+    return this->hardware_rotation_ ? DISPLAY_ROTATION_0_DEGREES : this->rotation_;
+  }
+
+  /// Mark the pixel at the absolute (unrotated) coordinates as changed since the last transfer.
+  inline void mark_dirty_(int16_t x, int16_t y) ALWAYS_INLINE {
+    // Consecutive pixels mostly fall into the region that was extended last
+    if (this->dirty_count_ != 0) {
+      const Rect &last = this->dirty_rects_[this->dirty_last_];
+      if (x >= last.x && x < last.x2() && y >= last.y && y < last.y2())
+        return;
+    }
+    this->extend_dirty_(Rect(x, y, 1, 1));
+  }
+  /// Mark the region in absolute (unrotated) coordinates as changed since the last transfer.
+  void mark_dirty_(Rect rect);
+  /// Mark the whole buffer as changed.
+  void mark_all_dirty_();
+  /// Forget the changed regions, call after they've been transferred.
+  void clear_dirty_() { this->dirty_count_ = 0; }
+  /// The changed regions in absolute coordinates, they don't overlap.
+  const Rect *get_dirty_rects_() const { return this->dirty_rects_; }
+  uint8_t get_dirty_count_() const { return this->dirty_count_; }
+
   uint8_t *buffer_{nullptr};
+  bool hardware_rotation_{false};
+
+ private:
+  void extend_dirty_(Rect rect);
+
+  Rect dirty_rects_[DISPLAY_MAX_DIRTY_RECTS];
+  uint8_t dirty_count_{0};
+  uint8_t dirty_last_{0};
 };
 
 }  // namespace display
@@ -66,6 +66,12 @@ class ColorUtil {
     }
     return color_return;
   }
+  static inline Color rgb565_to_color(uint16_t rgb565_color) {
+    uint8_t r = (rgb565_color & 0xF800) >> 11;
+    uint8_t g = (rgb565_color & 0x07E0) >> 5;
+    uint8_t b = rgb565_color & 0x001F;
+    return Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+  }
   static inline Color rgb332_to_color(uint8_t rgb332_color) {
     return to_color((uint32_t) rgb332_color, COLOR_ORDER_RGB, COLOR_BITNESS_332);
   }
@@ -140,6 +146,8 @@ class ColorUtil {
       if (dist2 < minimum_dist2) {
         minimum_dist2 = dist2;
         closest_index = (uint8_t) i;
+        if (dist2 == 0)
+          break;
       }
     }
     return closest_index;
@@ -155,5 +163,34 @@ class ColorUtil {
     return color;
   }
 };
+
+/** Remembers the palette index found for recently used colors.
+ *
+ * The RGB cube is split into 8x8x8 cells by the top three bits of each channel, and every cell holds the last color
+ * looked up in it with its index. A hit returns exactly what color_to_index8_palette888() would, so gradients keep
+ * every palette entry, while drawing with a few colors no longer searches the whole palette per pixel.
+ */
+class PaletteIndexCache {
+ public:
+  explicit PaletteIndexCache(const uint8_t *palette) : palette_(palette) {}
+
+  uint8_t lookup(Color color) {
+    const uint32_t key = VALID | (uint32_t(color.r) << 16) | (uint32_t(color.g) << 8) | color.b;
+    const uint16_t cell = ((color.r >> 5) << 6) | ((color.g >> 5) << 3) | (color.b >> 5);
+    if (this->colors_[cell] != key) {
+      this->colors_[cell] = key;
+      this->indices_[cell] = ColorUtil::color_to_index8_palette888(color, this->palette_);
+    }
+    return this->indices_[cell];
+  }
+
+ protected:
+  static const uint32_t VALID = 1 << 24;
+  static const uint16_t CELLS = 8 * 8 * 8;
+
+  const uint8_t *palette_;
+  uint32_t colors_[CELLS]{};
+  uint8_t indices_[CELLS];
+};
 }  // namespace display
 }  // namespace esphome
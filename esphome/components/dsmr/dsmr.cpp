@@ -120,6 +120,7 @@ void Dsmr::stop_requesting_data_() {
     while (this->available()) {
       this->read();
     }
+    this->read_buf_pos_ = this->read_buf_len_ = 0;
     this->requesting_data_ = false;
   }
 }
@@ -133,122 +134,138 @@ void Dsmr::reset_telegram_() {
   this->last_read_time_ = 0;
 }
 
-void Dsmr::receive_telegram_() {
-  while (this->available_within_timeout_()) {
-    const char c = this->read();
+bool Dsmr::read_chunk_() {
+  if (!this->available_within_timeout_())
+    return false;
+  this->read_buf_len_ = this->read_available(this->read_buf_, sizeof(this->read_buf_));
+  this->read_buf_pos_ = 0;
+  return this->read_buf_len_ > 0;
+}
 
-    // Find a new telegram header, i.e. forward slash.
-    if (c == '/') {
-      ESP_LOGV(TAG, "Header of telegram found");
-      this->reset_telegram_();
-      this->header_found_ = true;
-    }
-    if (!this->header_found_)
-      continue;
+void Dsmr::receive_telegram_() {
+  while (this->read_buf_pos_ < this->read_buf_len_ || this->read_chunk_()) {
+    while (this->read_buf_pos_ < this->read_buf_len_) {
+      const char c = this->read_buf_[this->read_buf_pos_++];
+
+      // Find a new telegram header, i.e. forward slash.
+      if (c == '/') {
+        ESP_LOGV(TAG, "Header of telegram found");
+        this->reset_telegram_();
+        this->header_found_ = true;
+      }
+      if (!this->header_found_)
+        continue;
 
-    // Check for buffer overflow.
-    if (this->bytes_read_ >= this->max_telegram_len_) {
-      this->reset_telegram_();
-      ESP_LOGE(TAG, "Error: telegram larger than buffer (%d bytes)", this->max_telegram_len_);
-      return;
-    }
+      // Check for buffer overflow.
+      if (this->bytes_read_ >= this->max_telegram_len_) {
+        this->reset_telegram_();
+        ESP_LOGE(TAG, "Error: telegram larger than buffer (%d bytes)", this->max_telegram_len_);
+        // look at this byte again on the next call, it may start the next telegram
+        this->read_buf_pos_--;
+        return;
+      }
 
-    // Some v2.2 or v3 meters will send a new value which starts with '('
-    // in a new line, while the value belongs to the previous ObisId. For
-    // proper parsing, remove these new line characters.
-    if (c == '(') {
-      while (true) {
-        auto previous_char = this->telegram_[this->bytes_read_ - 1];
-        if (previous_char == '\n' || previous_char == '\r') {
-          this->bytes_read_--;
-        } else {
-          break;
+      // Some v2.2 or v3 meters will send a new value which starts with '('
+      // in a new line, while the value belongs to the previous ObisId. For
+      // proper parsing, remove these new line characters.
+      if (c == '(') {
+        while (true) {
+          auto previous_char = this->telegram_[this->bytes_read_ - 1];
+          if (previous_char == '\n' || previous_char == '\r') {
+            this->bytes_read_--;
+          } else {
+            break;
+          }
         }
       }
-    }
 
-    // Store the byte in the buffer.
-    this->telegram_[this->bytes_read_] = c;
-    this->bytes_read_++;
+      // Store the byte in the buffer.
+      this->telegram_[this->bytes_read_] = c;
+      this->bytes_read_++;
 
-    // Check for a footer, i.e. exclamation mark, followed by a hex checksum.
-    if (c == '!') {
-      ESP_LOGV(TAG, "Footer of telegram found");
-      this->footer_found_ = true;
-      continue;
-    }
-    // Check for the end of the hex checksum, i.e. a newline.
-    if (this->footer_found_ && c == '\n') {
-      // Parse the telegram and publish sensor values.
-      this->parse_telegram();
-      this->reset_telegram_();
-      return;
+      // Check for a footer, i.e. exclamation mark, followed by a hex checksum.
+      if (c == '!') {
+        ESP_LOGV(TAG, "Footer of telegram found");
+        this->footer_found_ = true;
+        continue;
+      }
+      // Check for the end of the hex checksum, i.e. a newline.
+      if (this->footer_found_ && c == '\n') {
+        // Parse the telegram and publish sensor values.
+        this->parse_telegram();
+        this->reset_telegram_();
+        return;
+      }
     }
   }
 }
 
 void Dsmr::receive_encrypted_telegram_() {
-  while (this->available_within_timeout_()) {
-    const char c = this->read();
-
-    // Find a new telegram start byte.
-    if (!this->header_found_) {
-      if ((uint8_t) c != 0xDB) {
-        continue;
+  while (this->read_buf_pos_ < this->read_buf_len_ || this->read_chunk_()) {
+    while (this->read_buf_pos_ < this->read_buf_len_) {
+      const char c = this->read_buf_[this->read_buf_pos_++];
+
+      // Find a new telegram start byte.
+      if (!this->header_found_) {
+        if ((uint8_t) c != 0xDB) {
+          continue;
+        }
+        ESP_LOGV(TAG, "Start byte 0xDB of encrypted telegram found");
+        this->reset_telegram_();
+        this->header_found_ = true;
       }
-      ESP_LOGV(TAG, "Start byte 0xDB of encrypted telegram found");
-      this->reset_telegram_();
-      this->header_found_ = true;
-    }
 
-    // Check for buffer overflow.
-    if (this->crypt_bytes_read_ >= this->max_telegram_len_) {
-      this->reset_telegram_();
-      ESP_LOGE(TAG, "Error: encrypted telegram larger than buffer (%d bytes)", this->max_telegram_len_);
-      return;
-    }
+      // Check for buffer overflow.
+      if (this->crypt_bytes_read_ >= this->max_telegram_len_) {
+        this->reset_telegram_();
+        ESP_LOGE(TAG, "Error: encrypted telegram larger than buffer (%d bytes)", this->max_telegram_len_);
+        // look at this byte again on the next call, it may start the next telegram
+        this->read_buf_pos_--;
+        return;
+      }
 
-    // Store the byte in the buffer.
-    this->crypt_telegram_[this->crypt_bytes_read_] = c;
-    this->crypt_bytes_read_++;
+      // Store the byte in the buffer.
+      this->crypt_telegram_[this->crypt_bytes_read_] = c;
+      this->crypt_bytes_read_++;
 
-    // Read the length of the incoming encrypted telegram.
-    if (this->crypt_telegram_len_ == 0 && this->crypt_bytes_read_ > 20) {
-      // Complete header + data bytes
-      this->crypt_telegram_len_ = 13 + (this->crypt_telegram_[11] << 8 | this->crypt_telegram_[12]);
-      ESP_LOGV(TAG, "Encrypted telegram length: %d bytes", this->crypt_telegram_len_);
-    }
+      // Read the length of the incoming encrypted telegram.
+      if (this->crypt_telegram_len_ == 0 && this->crypt_bytes_read_ > 20) {
+        // Complete header + data bytes
+        this->crypt_telegram_len_ = 13 + (this->crypt_telegram_[11] << 8 | this->crypt_telegram_[12]);
+        ESP_LOGV(TAG, "Encrypted telegram length: %d bytes", this->crypt_telegram_len_);
+      }
 
-    // Check for the end of the encrypted telegram.
-    if (this->crypt_telegram_len_ == 0 || this->crypt_bytes_read_ != this->crypt_telegram_len_) {
-      continue;
+      // Check for the end of the encrypted telegram.
+      if (this->crypt_telegram_len_ == 0 || this->crypt_bytes_read_ != this->crypt_telegram_len_) {
+        continue;
+      }
+      ESP_LOGV(TAG, "End of encrypted telegram found");
+
+      // Decrypt the encrypted telegram.
+      GCM<AES128> *gcmaes128{new GCM<AES128>()};
+      gcmaes128->setKey(this->decryption_key_.data(), gcmaes128->keySize());
+      // the iv is 8 bytes of the system title + 4 bytes frame counter
+      // system title is at byte 2 and frame counter at byte 15
+      for (int i = 10; i < 14; i++)
+        this->crypt_telegram_[i] = this->crypt_telegram_[i + 4];
+      constexpr uint16_t iv_size{12};
+      gcmaes128->setIV(&this->crypt_telegram_[2], iv_size);
+      gcmaes128->decrypt(reinterpret_cast<uint8_t *>(this->telegram_),
+                         // the ciphertext start at byte 18
+                         &this->crypt_telegram_[18],
+                         // cipher size
+                         this->crypt_bytes_read_ - 17);
+      delete gcmaes128;  // NOLINT(cppcoreguidelines-owning-memory)
+
+      this->bytes_read_ = strnlen(this->telegram_, this->max_telegram_len_);
+      ESP_LOGV(TAG, "Decrypted telegram size: %d bytes", this->bytes_read_);
+      ESP_LOGVV(TAG, "Decrypted telegram: %s", this->telegram_);
+
+      // Parse the decrypted telegram and publish sensor values.
+      this->parse_telegram();
+      this->reset_telegram_();
+      return;
     }
-    ESP_LOGV(TAG, "End of encrypted telegram found");
-
-    // Decrypt the encrypted telegram.
-    GCM<AES128> *gcmaes128{new GCM<AES128>()};
-    gcmaes128->setKey(this->decryption_key_.data(), gcmaes128->keySize());
-    // the iv is 8 bytes of the system title + 4 bytes frame counter
-    // system title is at byte 2 and frame counter at byte 15
-    for (int i = 10; i < 14; i++)
-      this->crypt_telegram_[i] = this->crypt_telegram_[i + 4];
-    constexpr uint16_t iv_size{12};
-    gcmaes128->setIV(&this->crypt_telegram_[2], iv_size);
-    gcmaes128->decrypt(reinterpret_cast<uint8_t *>(this->telegram_),
-                       // the ciphertext start at byte 18
-                       &this->crypt_telegram_[18],
-                       // cipher size
-                       this->crypt_bytes_read_ - 17);
-    delete gcmaes128;  // NOLINT(cppcoreguidelines-owning-memory)
-
-    this->bytes_read_ = strnlen(this->telegram_, this->max_telegram_len_);
-    ESP_LOGV(TAG, "Decrypted telegram size: %d bytes", this->bytes_read_);
-    ESP_LOGVV(TAG, "Decrypted telegram: %s", this->telegram_);
-
-    // Parse the decrypted telegram and publish sensor values.
-    this->parse_telegram();
-    this->reset_telegram_();
-    return;
   }
 }
 
@@ -100,6 +100,8 @@ class Dsmr : public Component, public uart::UARTDevice {
   /// time that the UART RX buffer overflows and bytes of the telegram get
   /// lost in the process.
   bool available_within_timeout_();
+  /// Read the next chunk of UART data into read_buf_, waiting like available_within_timeout_().
+  bool read_chunk_();
 
   // Request telegram
   uint32_t request_interval_;
@@ -121,6 +123,10 @@ class Dsmr : public Component, public uart::UARTDevice {
   size_t crypt_telegram_len_{0};
   size_t crypt_bytes_read_{0};
   uint32_t last_read_time_{0};
+  // Chunk read from the UART, bytes after a telegram end or overflow are kept for the next call
+  uint8_t read_buf_[64];
+  uint8_t read_buf_pos_{0};
+  uint8_t read_buf_len_{0};
   bool header_found_{false};
   bool footer_found_{false};
 
@@ -1,3 +1,4 @@
+#include <cinttypes>
 #include "e131.h"
 #include "e131_addressable_light_effect.h"
 #include "esphome/core/log.h"
@@ -7,6 +8,7 @@ namespace e131 {
 
 static const char *const TAG = "e131";
 static const int PORT = 5568;
+static const int DDP_PORT = 4048;
 
 E131Component::E131Component() {}
 
@@ -14,64 +16,93 @@ E131Component::~E131Component() {
   if (this->socket_) {
     this->socket_->close();
   }
+  if (this->ddp_socket_) {
+    this->ddp_socket_->close();
+  }
 }
 
 void E131Component::setup() {
-  this->socket_ = socket::socket_ip(SOCK_DGRAM, IPPROTO_IP);
+  this->socket_ = this->open_socket_(PORT);
+  if (this->socket_ == nullptr) {
+    this->mark_failed();
+    return;
+  }
+
+  if (this->ddp_) {
+    this->ddp_socket_ = this->open_socket_(DDP_PORT);
+    if (this->ddp_socket_ == nullptr) {
+      this->mark_failed();
+      return;
+    }
+  }
+
+  join_igmp_groups_();
+}
+
+std::unique_ptr<socket::Socket> E131Component::open_socket_(uint16_t port) {
+  auto sock = socket::socket_ip(SOCK_DGRAM, IPPROTO_IP);
 
   int enable = 1;
-  int err = this->socket_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  int err = sock->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
   if (err != 0) {
     ESP_LOGW(TAG, "Socket unable to set reuseaddr: errno %d", err);
     // we can still continue
   }
-  err = this->socket_->setblocking(false);
+  err = sock->setblocking(false);
   if (err != 0) {
     ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
-    this->mark_failed();
-    return;
+    return nullptr;
   }
 
   struct sockaddr_storage server;
 
-  socklen_t sl = socket::set_sockaddr_any((struct sockaddr *) &server, sizeof(server), PORT);
+  socklen_t sl = socket::set_sockaddr_any((struct sockaddr *) &server, sizeof(server), port);
   if (sl == 0) {
     ESP_LOGW(TAG, "Socket unable to set sockaddr: errno %d", errno);
-    this->mark_failed();
-    return;
+    return nullptr;
   }
   server.ss_family = AF_INET;
 
-  err = this->socket_->bind((struct sockaddr *) &server, sizeof(server));
+  err = sock->bind((struct sockaddr *) &server, sizeof(server));
   if (err != 0) {
     ESP_LOGW(TAG, "Socket unable to bind: errno %d", errno);
-    this->mark_failed();
-    return;
+    return nullptr;
   }
-
-  join_igmp_groups_();
+  return sock;
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
   E131Packet packet;
   int universe = 0;
   uint8_t buf[1460];
-
-  ssize_t len = this->socket_->read(buf, sizeof(buf));
-  if (len == -1) {
-    return;
+  ssize_t len;
+
+  // Drain every pending packet, a frame spanning many universes arrives as a burst of packets
+  if (this->socket_->ready()) {
+    while ((len = this->socket_->read(buf, sizeof(buf))) > 0) {
+      if (!this->packet_(buf, len, universe, packet)) {
+        ESP_LOGV(TAG, "Invalid packet received of size %zd.", len);
+        continue;
+      }
+
+      if (!this->process_(universe, packet)) {
+        ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
+      }
+    }
   }
-  payload.resize(len);
-  memmove(&payload[0], buf, len);
 
-  if (!this->packet_(payload, universe, packet)) {
-    ESP_LOGV(TAG, "Invalid packet received of size %zu.", payload.size());
-    return;
-  }
-
-  if (!this->process_(universe, packet)) {
-    ESP_LOGV(TAG, "Ignored packet for %d universe of size %d.", universe, packet.count);
+  if (this->ddp_socket_ != nullptr && this->ddp_socket_->ready()) {
+    DDPPacket ddp_packet;
+    while ((len = this->ddp_socket_->read(buf, sizeof(buf))) > 0) {
+      if (!this->ddp_packet_(buf, len, ddp_packet)) {
+        ESP_LOGV(TAG, "Invalid DDP packet received of size %zd.", len);
+        continue;
+      }
+
+      if (!this->process_ddp_(ddp_packet)) {
+        ESP_LOGV(TAG, "Ignored DDP packet for offset %" PRIu32 " of size %u.", ddp_packet.offset, ddp_packet.length);
+      }
+    }
   }
 }
 
@@ -117,5 +148,17 @@ bool E131Component::process_(int universe, const E131Packet &packet) {
   return handled;
 }
 
+bool E131Component::process_ddp_(const DDPPacket &packet) {
+  bool handled = false;
+
+  ESP_LOGV(TAG, "Received DDP packet for offset %" PRIu32 ", with %u bytes", packet.offset, packet.length);
+
+  for (auto *light_effect : light_effects_) {
+    handled = light_effect->process_ddp_(packet) || handled;
+  }
+
+  return handled;
+}
+
 }  // namespace e131
 }  // namespace esphome
@@ -22,6 +22,15 @@ struct E131Packet {
   uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
 };
 
+struct DDPPacket {
+  /// Byte offset of data in the output.
+  uint32_t offset;
+  uint16_t length;
+  /// Show the data received so far.
+  bool push;
+  const uint8_t *data;
+};
+
 class E131Component : public esphome::Component {
  public:
   E131Component();
@@ -35,16 +44,23 @@ class E131Component : public esphome::Component {
   void remove_effect(E131AddressableLightEffect *light_effect);
 
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
+  /// Also accept DDP (Distributed Display Protocol) packets on port 4048.
+  void set_ddp(bool ddp) { this->ddp_ = ddp; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  std::unique_ptr<socket::Socket> open_socket_(uint16_t port);
+  bool packet_(const uint8_t *data, size_t len, int &universe, E131Packet &packet);
   bool process_(int universe, const E131Packet &packet);
+  bool ddp_packet_(const uint8_t *data, size_t len, DDPPacket &packet);
+  bool process_ddp_(const DDPPacket &packet);
   bool join_igmp_groups_();
   void join_(int universe);
   void leave_(int universe);
 
   E131ListenMethod listen_method_{E131_MULTICAST};
   std::unique_ptr<socket::Socket> socket_;
+  bool ddp_{false};
+  std::unique_ptr<socket::Socket> ddp_socket_;
   std::set<E131AddressableLightEffect *> light_effects_;
   std::map<int, int> universe_consumers_;
   std::map<int, E131Packet> universe_packets_;
@@ -60,6 +60,38 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %d-%d.", get_name().c_str(), universe, output_offset,
            output_end);
 
+  this->apply_data_(output_offset, output_end, input_data);
+
+  it->schedule_show();
+  return true;
+}
+
+bool E131AddressableLightEffect::process_ddp_(const DDPPacket &packet) {
+  auto *it = get_addressable_();
+
+  if (packet.offset / channels_ >= uint32_t(it->size()))
+    return false;
+
+  // Skip the rest of a light that started in an earlier packet
+  int32_t output_offset = (packet.offset + channels_ - 1) / channels_;
+  size_t skip = output_offset * channels_ - packet.offset;
+  if (skip > packet.length)
+    return false;
+  int32_t output_end = std::min(it->size(), int32_t(output_offset + (packet.length - skip) / channels_));
+
+  ESP_LOGV(TAG, "Applying DDP data for '%s', for %d-%d.", get_name().c_str(), output_offset, output_end);
+
+  this->apply_data_(output_offset, output_end, packet.data + skip);
+
+  // Senders set push on the last packet of a frame
+  if (packet.push)
+    it->schedule_show();
+  return true;
+}
+
+void E131AddressableLightEffect::apply_data_(int32_t output_offset, int32_t output_end, const uint8_t *input_data) {
+  auto *it = get_addressable_();
+
   switch (channels_) {
     case E131_MONO:
       for (; output_offset < output_end; output_offset++, input_data++) {
@@ -83,9 +115,6 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
       }
       break;
   }
-
-  it->schedule_show();
-  return true;
 }
 
 }  // namespace e131
@@ -8,6 +8,7 @@ namespace e131 {
 
 class E131Component;
 struct E131Packet;
+struct DDPPacket;
 
 enum E131LightChannels { E131_MONO = 1, E131_RGB = 3, E131_RGBW = 4 };
 
@@ -31,6 +32,9 @@ class E131AddressableLightEffect : public light::AddressableLightEffect {
 
  protected:
   bool process_(int universe, const E131Packet &packet);
+  bool process_ddp_(const DDPPacket &packet);
+  /// Set the lights from \p output_offset up to \p output_end from \p input_data, channels_ bytes per light.
+  void apply_data_(int32_t output_offset, int32_t output_end, const uint8_t *input_data);
 
   int first_universe_{0};
   int last_universe_{0};
@@ -53,6 +53,24 @@ union E131RawPacket {
   uint8_t raw[638];
 };
 
+// DDP Packet Header, followed by the data
+struct DDPRawHeader {
+  uint8_t flags;
+  uint8_t sequence_number;
+  uint8_t data_type;
+  uint8_t id;
+  uint32_t offset;
+  uint16_t length;
+} __attribute__((packed));
+
+static const uint8_t DDP_VERSION_MASK = 0xC0;
+static const uint8_t DDP_VERSION_1 = 0x40;
+static const uint8_t DDP_FLAG_TIMECODE = 0x10;
+static const uint8_t DDP_FLAG_QUERY = 0x02;
+static const uint8_t DDP_FLAG_PUSH = 0x01;
+static const uint8_t DDP_ID_DISPLAY = 1;
+static const uint8_t DDP_ID_ALL = 255;
+
 // We need to have at least one `1` value
 // Get the offset of `property_values[1]`
 const size_t E131_MIN_PACKET_SIZE = reinterpret_cast<size_t>(&((E131RawPacket *) nullptr)->property_values[1]);
@@ -110,11 +128,11 @@ void E131Component::leave_(int universe) {
   ESP_LOGD(TAG, "Left %d universe for E1.31.", universe);
 }
 
-bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet) {
-  if (data.size() < E131_MIN_PACKET_SIZE)
+bool E131Component::packet_(const uint8_t *data, size_t len, int &universe, E131Packet &packet) {
+  if (len < E131_MIN_PACKET_SIZE)
     return false;
 
-  auto *sbuff = reinterpret_cast<const E131RawPacket *>(&data[0]);
+  auto *sbuff = reinterpret_cast<const E131RawPacket *>(data);
 
   if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
     return false;
@@ -132,9 +150,38 @@ bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E13
   if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
     return false;
 
+  if (len < E131_MIN_PACKET_SIZE - 1 + packet.count)
+    return false;
+
   memcpy(packet.values, sbuff->property_values, packet.count);
   return true;
 }
 
+bool E131Component::ddp_packet_(const uint8_t *data, size_t len, DDPPacket &packet) {
+  if (len < sizeof(DDPRawHeader))
+    return false;
+
+  auto *header = reinterpret_cast<const DDPRawHeader *>(data);
+
+  if ((header->flags & DDP_VERSION_MASK) != DDP_VERSION_1)
+    return false;
+  if (header->flags & DDP_FLAG_QUERY)
+    return false;
+  if (header->id != DDP_ID_DISPLAY && header->id != DDP_ID_ALL)
+    return false;
+
+  // The data is right after the header, or after the timecode following it
+  size_t data_offset = sizeof(DDPRawHeader) + (header->flags & DDP_FLAG_TIMECODE ? 4 : 0);
+  packet.offset = htonl(header->offset);
+  packet.length = htons(header->length);
+  packet.push = header->flags & DDP_FLAG_PUSH;
+  if (len < data_offset + packet.length)
+    return false;
+
+  // Point into the receive buffer instead of copying, the data is applied before the next read
+  packet.data = data + data_offset;
+  return true;
+}
+
 }  // namespace e131
 }  // namespace esphome
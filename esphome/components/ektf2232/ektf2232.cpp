@@ -61,6 +61,7 @@ void EKTF2232Touchscreen::setup() {
 }
 
 void EKTF2232Touchscreen::loop() {
+  this->flush_touches_();
   if (!this->store_.touch)
     return;
   this->store_.touch = false;
@@ -76,8 +77,7 @@ void EKTF2232Touchscreen::loop() {
   }
 
   if (touch_count == 0) {
-    for (auto *listener : this->touch_listeners_)
-      listener->release();
+    this->release_touches_();
     return;
   }
 
@@ -113,7 +113,7 @@ void EKTF2232Touchscreen::loop() {
         break;
     }
 
-    this->defer([this, tp]() { this->send_touch_(tp); });
+    this->add_touch_(tp);
   }
 }
 
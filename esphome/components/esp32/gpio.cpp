@@ -4,6 +4,8 @@
 #include "esphome/core/log.h"
 #include <cinttypes>
 
+#include <soc/gpio_reg.h>
+
 namespace esphome {
 namespace esp32 {
 
@@ -41,6 +43,20 @@ ISRInternalGPIOPin ESP32InternalGPIOPin::to_isr() const {
   return ISRInternalGPIOPin((void *) arg);
 }
 
+FastGPIOPin ESP32InternalGPIOPin::to_fast() {
+  // the registers are 32 bit wide, pins from 32 on are in a second set of registers
+#if SOC_GPIO_PIN_COUNT > 32
+  if (pin_ >= 32) {
+    return FastGPIOPin(reinterpret_cast<volatile uint32_t *>(GPIO_OUT1_W1TS_REG),
+                       reinterpret_cast<volatile uint32_t *>(GPIO_OUT1_W1TC_REG),
+                       reinterpret_cast<const volatile uint32_t *>(GPIO_IN1_REG), 1UL << (pin_ - 32), inverted_);
+  }
+#endif
+  return FastGPIOPin(reinterpret_cast<volatile uint32_t *>(GPIO_OUT_W1TS_REG),
+                     reinterpret_cast<volatile uint32_t *>(GPIO_OUT_W1TC_REG),
+                     reinterpret_cast<const volatile uint32_t *>(GPIO_IN_REG), 1UL << pin_, inverted_);
+}
+
 void ESP32InternalGPIOPin::attach_interrupt(void (*func)(void *), void *arg, gpio::InterruptType type) const {
   gpio_int_type_t idf_type = GPIO_INTR_ANYEDGE;
   switch (type) {
@@ -20,6 +20,7 @@ class ESP32InternalGPIOPin : public InternalGPIOPin {
   std::string dump_summary() const override;
   void detach_interrupt() const override;
   ISRInternalGPIOPin to_isr() const override;
+  FastGPIOPin to_fast() override;
   uint8_t get_pin() const override { return (uint8_t) pin_; }
   bool is_inverted() const override { return inverted_; }
 
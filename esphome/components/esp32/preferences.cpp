@@ -14,27 +14,46 @@ namespace esp32 {
 
 static const char *const TAG = "esp32.preferences";
 
+class ESP32PreferenceBackend;
+
 struct NVSData {
-  std::string key;
+  ESP32PreferenceBackend *pref;
   std::vector<uint8_t> data;
 };
 
 static std::vector<NVSData> s_pending_save;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
+/// Counters to judge how much flash traffic the preferences cause, logged on every sync.
+struct NVSStats {
+  uint32_t saves;      ///< save() calls
+  uint32_t coalesced;  ///< save() calls that replaced a pending save before it was written
+  uint32_t unchanged;  ///< pending saves dropped because flash already had the data
+  uint32_t written;    ///< blobs written to flash
+  uint32_t bytes_written;
+};
+
+static NVSStats s_stats{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 class ESP32PreferenceBackend : public ESPPreferenceBackend {
  public:
   std::string key;
   uint32_t nvs_handle;
+  /// Copy of what is in flash for this key, valid if stored_known. Lets sync skip unchanged data without reading NVS.
+  std::vector<uint8_t> stored;
+  bool stored_known{false};
+
   bool save(const uint8_t *data, size_t len) override {
+    s_stats.saves++;
     // try find in pending saves and update that
     for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
+      if (obj.pref == this) {
         obj.data.assign(data, data + len);
+        s_stats.coalesced++;
         return true;
       }
     }
     NVSData save{};
-    save.key = key;
+    save.pref = this;
     save.data.assign(data, data + len);
     s_pending_save.emplace_back(save);
     ESP_LOGVV(TAG, "s_pending_save: key: %s, len: %d", key.c_str(), len);
@@ -43,7 +62,7 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
   bool load(uint8_t *data, size_t len) override {
     // try find in pending saves and load from that
     for (auto &obj : s_pending_save) {
-      if (obj.key == key) {
+      if (obj.pref == this) {
         if (obj.data.size() != len) {
           // size mismatch
           return false;
@@ -70,6 +89,8 @@ class ESP32PreferenceBackend : public ESPPreferenceBackend {
     } else {
       ESP_LOGVV(TAG, "nvs_get_blob: key: %s, len: %d", key.c_str(), len);
     }
+    this->stored.assign(data, data + len);
+    this->stored_known = true;
     return true;
   }
 };
@@ -98,11 +119,18 @@ class ESP32Preferences : public ESPPreferences {
     return make_preference(length, type);
   }
   ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    uint32_t keyval = type;
+    std::string key = str_sprintf("%" PRIu32, keyval);
+    // share the backend between objects for the same key, so pending saves and the flash copy stay in one place
+    for (auto *pref : this->prefs_) {
+      if (pref->key == key)
+        return ESPPreferenceObject(pref);
+    }
+
     auto *pref = new ESP32PreferenceBackend();  // NOLINT(cppcoreguidelines-owning-memory)
     pref->nvs_handle = nvs_handle;
-
-    uint32_t keyval = type;
-    pref->key = str_sprintf("%" PRIu32, keyval);
+    pref->key = std::move(key);
+    this->prefs_.push_back(pref);
 
     return ESPPreferenceObject(pref);
   }
@@ -119,28 +147,43 @@ class ESP32Preferences : public ESPPreferences {
 
     // go through vector from back to front (makes erase easier/more efficient)
     for (ssize_t i = s_pending_save.size() - 1; i >= 0; i--) {
-      const auto &save = s_pending_save[i];
-      ESP_LOGVV(TAG, "Checking if NVS data %s has changed", save.key.c_str());
+      auto &save = s_pending_save[i];
+      auto *pref = save.pref;
+      ESP_LOGVV(TAG, "Checking if NVS data %s has changed", pref->key.c_str());
       if (is_changed(nvs_handle, save)) {
-        esp_err_t err = nvs_set_blob(nvs_handle, save.key.c_str(), save.data.data(), save.data.size());
-        ESP_LOGV(TAG, "sync: key: %s, len: %d", save.key.c_str(), save.data.size());
+        esp_err_t err = nvs_set_blob(nvs_handle, pref->key.c_str(), save.data.data(), save.data.size());
+        ESP_LOGV(TAG, "sync: key: %s, len: %d", pref->key.c_str(), save.data.size());
         if (err != 0) {
-          ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", save.key.c_str(), save.data.size(),
+          ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", pref->key.c_str(), save.data.size(),
                    esp_err_to_name(err));
+          // flash contents are unknown after a failed write
+          pref->stored_known = false;
           failed++;
           last_err = err;
-          last_key = save.key;
+          last_key = pref->key;
           continue;
         }
         written++;
+        s_stats.written++;
+        s_stats.bytes_written += save.data.size();
       } else {
-        ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", save.key.c_str(), save.data.size());
+        ESP_LOGV(TAG, "NVS data not changed skipping %s  len=%u", pref->key.c_str(), save.data.size());
         cached++;
+        s_stats.unchanged++;
       }
+      pref->stored.swap(save.data);
+      pref->stored_known = true;
       s_pending_save.erase(s_pending_save.begin() + i);
     }
     ESP_LOGD(TAG, "Saving %d preferences to flash: %d cached, %d written, %d failed", cached + written + failed, cached,
              written, failed);
+    nvs_stats_t nvs_stats;
+    if (nvs_get_stats(nullptr, &nvs_stats) == ESP_OK) {
+      ESP_LOGD(TAG, "Since boot: %" PRIu32 " saves, %" PRIu32 " coalesced, %" PRIu32 " unchanged, %" PRIu32
+               " written (%" PRIu32 " bytes); NVS entries used %u/%u",
+               s_stats.saves, s_stats.coalesced, s_stats.unchanged, s_stats.written, s_stats.bytes_written,
+               (unsigned) nvs_stats.used_entries, (unsigned) nvs_stats.total_entries);
+    }
     if (failed > 0) {
       ESP_LOGE(TAG, "Error saving %d preferences to flash. Last error=%s for key=%s", failed, esp_err_to_name(last_err),
                last_key.c_str());
@@ -156,17 +199,21 @@ class ESP32Preferences : public ESPPreferences {
     return failed == 0;
   }
   bool is_changed(const uint32_t nvs_handle, const NVSData &to_save) {
+    const auto *pref = to_save.pref;
+    if (pref->stored_known)
+      return to_save.data != pref->stored;
+
     NVSData stored_data{};
     size_t actual_len;
-    esp_err_t err = nvs_get_blob(nvs_handle, to_save.key.c_str(), nullptr, &actual_len);
+    esp_err_t err = nvs_get_blob(nvs_handle, pref->key.c_str(), nullptr, &actual_len);
     if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", to_save.key.c_str(), esp_err_to_name(err));
+      ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", pref->key.c_str(), esp_err_to_name(err));
       return true;
     }
     stored_data.data.resize(actual_len);
-    err = nvs_get_blob(nvs_handle, to_save.key.c_str(), stored_data.data.data(), &actual_len);
+    err = nvs_get_blob(nvs_handle, pref->key.c_str(), stored_data.data.data(), &actual_len);
     if (err != 0) {
-      ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", to_save.key.c_str(), esp_err_to_name(err));
+      ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", pref->key.c_str(), esp_err_to_name(err));
       return true;
     }
     return to_save.data != stored_data.data;
@@ -182,6 +229,9 @@ class ESP32Preferences : public ESPPreferences {
     nvs_handle = 0;
     return true;
   }
+
+ protected:
+  std::vector<ESP32PreferenceBackend *> prefs_;
 };
 
 void setup_preferences() {
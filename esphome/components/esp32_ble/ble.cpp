@@ -2,6 +2,7 @@
 
 #include "ble.h"
 #include "esphome/core/application.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/log.h"
 
 #include <esp_bt.h>
@@ -26,6 +27,17 @@ void ESP32BLE::setup() {
   global_ble = this;
   ESP_LOGCONFIG(TAG, "Setting up BLE...");
 
+  // only scanning, which a GAP event handler starts, produces scan results
+  if (!this->gap_event_handlers_.empty()) {
+    ExternalRAMAllocator<ScanResult> allocator(HeapTag::BLE, ExternalRAMAllocator<ScanResult>::ALLOW_FAILURE);
+    this->scan_result_buffer_ = allocator.allocate(SCAN_RESULT_BUFFER_SIZE);
+    if (this->scan_result_buffer_ == nullptr) {
+      ESP_LOGE(TAG, "Could not allocate the scan result buffer");
+      this->mark_failed();
+      return;
+    }
+  }
+
   if (!ble_setup_()) {
     ESP_LOGE(TAG, "BLE could not be set up");
     this->mark_failed();
@@ -147,6 +159,7 @@ bool ESP32BLE::ble_setup_() {
 }
 
 void ESP32BLE::loop() {
+  HeapTagScope heap_tag(HeapTag::BLE);
   BLEEvent *ble_event = this->ble_events_.pop();
   while (ble_event != nullptr) {
     switch (ble_event->type_) {
@@ -170,10 +183,26 @@ void ESP32BLE::loop() {
 }
 
 void ESP32BLE::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
+  if (event == ESP_GAP_BLE_SCAN_RESULT_EVT && param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT &&
+      global_ble->scan_result_buffer_ != nullptr) {
+    global_ble->push_scan_result_(param->scan_rst);
+    return;
+  }
+  HeapTagScope heap_tag(HeapTag::BLE);
   BLEEvent *new_event = new BLEEvent(event, param);  // NOLINT(cppcoreguidelines-owning-memory)
   global_ble->ble_events_.push(new_event);
 }  // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
 
+void ESP32BLE::push_scan_result_(const ScanResult &result) {
+  const uint32_t head = this->scan_result_head_.load(std::memory_order_relaxed);
+  if (head - this->scan_result_tail_.load(std::memory_order_acquire) >= SCAN_RESULT_BUFFER_SIZE) {
+    this->scan_result_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  this->scan_result_buffer_[head % SCAN_RESULT_BUFFER_SIZE] = result;
+  this->scan_result_head_.store(head + 1, std::memory_order_release);
+}
+
 void ESP32BLE::real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param) {
   ESP_LOGV(TAG, "(BLE) gap_event_handler - %d", event);
   for (auto *gap_handler : this->gap_event_handlers_) {
@@ -183,6 +212,7 @@ void ESP32BLE::real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_ble_gap
 
 void ESP32BLE::gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if,
                                    esp_ble_gatts_cb_param_t *param) {
+  HeapTagScope heap_tag(HeapTag::BLE);
   BLEEvent *new_event = new BLEEvent(event, gatts_if, param);  // NOLINT(cppcoreguidelines-owning-memory)
   global_ble->ble_events_.push(new_event);
 }  // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
@@ -197,6 +227,7 @@ void ESP32BLE::real_gatts_event_handler_(esp_gatts_cb_event_t event, esp_gatt_if
 
 void ESP32BLE::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
                                    esp_ble_gattc_cb_param_t *param) {
+  HeapTagScope heap_tag(HeapTag::BLE);
   BLEEvent *new_event = new BLEEvent(event, gattc_if, param);  // NOLINT(cppcoreguidelines-owning-memory)
   global_ble->ble_events_.push(new_event);
 }  // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
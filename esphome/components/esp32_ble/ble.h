@@ -11,6 +11,8 @@
 
 #ifdef USE_ESP32
 
+#include <atomic>
+
 #include <esp_gap_ble_api.h>
 #include <esp_gatts_api.h>
 #include <esp_gattc_api.h>
@@ -54,6 +56,13 @@ class GATTsEventHandler {
 
 class ESP32BLE : public Component {
  public:
+  using ScanResult = esp_ble_gap_cb_param_t::ble_scan_result_evt_param;
+#if CONFIG_SPIRAM
+  static const uint8_t SCAN_RESULT_BUFFER_SIZE = 32;
+#else
+  static const uint8_t SCAN_RESULT_BUFFER_SIZE = 16;
+#endif  // CONFIG_SPIRAM
+
   void set_io_capability(IoCapability io_capability) { this->io_cap_ = (esp_ble_io_cap_t) io_capability; }
 
   void setup() override;
@@ -67,6 +76,17 @@ class ESP32BLE : public Component {
   void register_gattc_event_handler(GATTcEventHandler *handler) { this->gattc_event_handlers_.push_back(handler); }
   void register_gatts_event_handler(GATTsEventHandler *handler) { this->gatts_event_handlers_.push_back(handler); }
 
+  /** Scan results are passed from the BT task in a ring instead of the event queue, without a lock or an allocation
+   * per advertisement. The results from get_scan_result_tail() up to get_scan_result_head() are valid until
+   * release_scan_results() hands their slots back. The ESP32BLETracker is the only consumer.
+   */
+  uint32_t get_scan_result_head() const { return this->scan_result_head_.load(std::memory_order_acquire); }
+  uint32_t get_scan_result_tail() const { return this->scan_result_tail_.load(std::memory_order_relaxed); }
+  ScanResult *get_scan_result_buffer() const { return this->scan_result_buffer_; }
+  void release_scan_results(uint32_t head) { this->scan_result_tail_.store(head, std::memory_order_release); }
+  /// Number of scan results dropped because the ring was full.
+  uint32_t get_dropped_scan_results() const { return this->scan_result_dropped_.load(std::memory_order_relaxed); }
+
  protected:
   static void gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param);
   static void gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if, esp_ble_gattc_cb_param_t *param);
@@ -77,12 +97,19 @@ class ESP32BLE : public Component {
   void real_gap_event_handler_(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param);
 
   bool ble_setup_();
+  /// Runs in the BT task, never waits for the loop.
+  void push_scan_result_(const ScanResult &result);
 
   std::vector<GAPEventHandler *> gap_event_handlers_;
   std::vector<GATTcEventHandler *> gattc_event_handlers_;
   std::vector<GATTsEventHandler *> gatts_event_handlers_;
 
   Queue<BLEEvent> ble_events_;
+  /// Only the BT task advances the head and only the loop the tail.
+  ScanResult *scan_result_buffer_{nullptr};
+  std::atomic<uint32_t> scan_result_head_{0};
+  std::atomic<uint32_t> scan_result_tail_{0};
+  std::atomic<uint32_t> scan_result_dropped_{0};
   BLEAdvertising *advertising_;
   esp_ble_io_cap_t io_cap_{ESP_IO_CAP_NONE};
 };
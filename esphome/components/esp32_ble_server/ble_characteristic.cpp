@@ -4,6 +4,8 @@
 
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 #ifdef USE_ESP32
 
 namespace esphome {
@@ -31,10 +33,13 @@ void BLECharacteristic::set_value(std::vector<uint8_t> value) {
   xSemaphoreGive(this->set_value_lock_);
 }
 void BLECharacteristic::set_value(const std::string &value) {
-  this->set_value(std::vector<uint8_t>(value.begin(), value.end()));
+  this->set_value(reinterpret_cast<const uint8_t *>(value.data()), value.size());
 }
 void BLECharacteristic::set_value(const uint8_t *data, size_t length) {
-  this->set_value(std::vector<uint8_t>(data, data + length));
+  // Into the existing buffer, which only allocates when the value grows
+  xSemaphoreTake(this->set_value_lock_, 0L);
+  this->value_.assign(data, data + length);
+  xSemaphoreGive(this->set_value_lock_);
 }
 void BLECharacteristic::set_value(uint8_t &data) {
   uint8_t temp[1];
@@ -85,17 +90,36 @@ void BLECharacteristic::notify(bool notification) {
   if (this->service_->get_server()->get_connected_client_count() == 0)
     return;
 
-  for (auto &client : this->service_->get_server()->get_clients()) {
-    size_t length = this->value_.size();
-    esp_err_t err = esp_ble_gatts_send_indicate(this->service_->get_server()->get_gatts_if(), client.first,
-                                                this->handle_, length, this->value_.data(), false);
-    if (err != ESP_OK) {
-      ESP_LOGE(TAG, "esp_ble_gatts_send_indicate failed %d", err);
-      return;
-    }
+  BLEServer *server = this->service_->get_server();
+  for (auto &client : server->get_clients()) {
+    // 3 bytes of the MTU go to the opcode and handle
+    const size_t max_length = server->get_client_mtu(client.first) - 3;
+    size_t offset = 0;
+    do {
+      size_t length = std::min(this->value_.size() - offset, max_length);
+      esp_err_t err = esp_ble_gatts_send_indicate(server->get_gatts_if(), client.first, this->handle_, length,
+                                                  this->value_.data() + offset, false);
+      if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_ble_gatts_send_indicate failed %d", err);
+        return;
+      }
+      offset += length;
+    } while (offset < this->value_.size());
   }
 }
 
+void BLECharacteristic::queue_notify() {
+  if (this->notify_queued_)
+    return;
+  this->notify_queued_ = true;
+  this->service_->get_server()->queue_notification(this);
+}
+
+void BLECharacteristic::send_queued_notify() {
+  this->notify_queued_ = false;
+  this->notify();
+}
+
 void BLECharacteristic::add_descriptor(BLEDescriptor *descriptor) { this->descriptors_.push_back(descriptor); }
 
 void BLECharacteristic::do_create(BLEService *service) {
@@ -211,7 +235,8 @@ void BLECharacteristic::gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt
       if (!param->read.need_rsp)
         break;  // For some reason you can request a read but not want a response
 
-      uint16_t max_offset = 22;
+      // As much as fits into a response at the MTU, 1 byte goes to the opcode
+      uint16_t max_offset = this->service_->get_server()->get_client_mtu(param->read.conn_id) - 1;
 
       esp_gatt_rsp_t response;
       if (param->read.is_long) {
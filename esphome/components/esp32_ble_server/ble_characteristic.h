@@ -44,7 +44,19 @@ class BLECharacteristic {
   void set_write_property(bool value);
   void set_write_no_response_property(bool value);
 
+  /** Send the value to all connected clients right away.
+   *
+   * Values longer than fit into one notification at the MTU of a client are sent in several, in order.
+   */
   void notify(bool notification = true);
+  /** Notify the value in the next loop() of the server instead of right away.
+   *
+   * Calls until then are coalesced into a single notification of the latest value, which keeps the number of
+   * notifications down when the value changes faster than clients need to see every step.
+   */
+  void queue_notify();
+  /// Called by the server for a queue_notify().
+  void send_queued_notify();
 
   void do_create(BLEService *service);
   void gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t *param);
@@ -76,6 +88,7 @@ class BLECharacteristic {
 
   uint16_t value_read_offset_{0};
   std::vector<uint8_t> value_;
+  bool notify_queued_{false};
   SemaphoreHandle_t set_value_lock_;
 
   std::vector<BLEDescriptor *> descriptors_;
@@ -39,6 +39,11 @@ void BLEServer::setup() {
 void BLEServer::loop() {
   switch (this->state_) {
     case RUNNING:
+      if (!this->pending_notifications_.empty()) {
+        for (auto *characteristic : this->pending_notifications_)
+          characteristic->send_queued_notify();
+        this->pending_notifications_.clear();
+      }
       return;
 
     case INIT: {
@@ -150,6 +155,11 @@ void BLEServer::gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t ga
       }
       break;
     }
+    case ESP_GATTS_MTU_EVT: {
+      ESP_LOGV(TAG, "MTU of client %u is %u", param->mtu.conn_id, param->mtu.mtu);
+      this->client_mtus_[param->mtu.conn_id] = param->mtu.mtu;
+      break;
+    }
     case ESP_GATTS_REG_EVT: {
       this->gatts_if_ = gatts_if;
       this->registered_ = true;
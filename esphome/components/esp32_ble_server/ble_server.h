@@ -59,6 +59,14 @@ class BLEServer : public Component, public GATTsEventHandler, public Parented<ES
   esp_gatt_if_t get_gatts_if() { return this->gatts_if_; }
   uint32_t get_connected_client_count() { return this->connected_clients_; }
   const std::map<uint16_t, void *> &get_clients() { return this->clients_; }
+  /// MTU negotiated with the client, the default of 23 if it didn't ask for more.
+  uint16_t get_client_mtu(uint16_t conn_id) const {
+    auto it = this->client_mtus_.find(conn_id);
+    return it != this->client_mtus_.end() ? it->second : ESP_GATT_DEF_BLE_MTU_SIZE;
+  }
+
+  /// Notify the value of the characteristic in the next loop(), see BLECharacteristic::queue_notify().
+  void queue_notification(BLECharacteristic *characteristic) { this->pending_notifications_.push_back(characteristic); }
 
   void gatts_event_handler(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if,
                            esp_ble_gatts_cb_param_t *param) override;
@@ -72,7 +80,10 @@ class BLEServer : public Component, public GATTsEventHandler, public Parented<ES
   void add_client_(uint16_t conn_id, void *client) {
     this->clients_.insert(std::pair<uint16_t, void *>(conn_id, client));
   }
-  bool remove_client_(uint16_t conn_id) { return this->clients_.erase(conn_id) > 0; }
+  bool remove_client_(uint16_t conn_id) {
+    this->client_mtus_.erase(conn_id);
+    return this->clients_.erase(conn_id) > 0;
+  }
 
   bool can_proceed_{false};
 
@@ -84,6 +95,8 @@ class BLEServer : public Component, public GATTsEventHandler, public Parented<ES
 
   uint32_t connected_clients_{0};
   std::map<uint16_t, void *> clients_;
+  std::map<uint16_t, uint16_t> client_mtus_;
+  std::vector<BLECharacteristic *> pending_notifications_;
 
   std::vector<std::shared_ptr<BLEService>> services_;
   std::shared_ptr<BLEService> device_information_service_;
@@ -26,6 +26,7 @@ CONF_ESP32_BLE_ID = "esp32_ble_id"
 CONF_SCAN_PARAMETERS = "scan_parameters"
 CONF_WINDOW = "window"
 CONF_CONTINUOUS = "continuous"
+CONF_ADAPTIVE = "adaptive"
 CONF_ON_SCAN_END = "on_scan_end"
 esp32_ble_tracker_ns = cg.esphome_ns.namespace("esp32_ble_tracker")
 ESP32BLETracker = esp32_ble_tracker_ns.class_(
@@ -160,6 +161,7 @@ CONFIG_SCHEMA = cv.Schema(
                     ): cv.positive_time_period_milliseconds,
                     cv.Optional(CONF_ACTIVE, default=True): cv.boolean,
                     cv.Optional(CONF_CONTINUOUS, default=True): cv.boolean,
+                    cv.Optional(CONF_ADAPTIVE, default=False): cv.boolean,
                 }
             ),
             validate_scan_parameters,
@@ -220,6 +222,7 @@ async def to_code(config):
     cg.add(var.set_scan_window(int(params[CONF_WINDOW].total_milliseconds / 0.625)))
     cg.add(var.set_scan_active(params[CONF_ACTIVE]))
     cg.add(var.set_scan_continuous(params[CONF_CONTINUOUS]))
+    cg.add(var.set_scan_adaptive(params[CONF_ADAPTIVE]))
     for conf in config.get(CONF_ON_BLE_ADVERTISE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         if CONF_MAC_ADDRESS in conf:
@@ -316,6 +319,9 @@ async def esp32_ble_tracker_stop_scan_action_to_code(
 async def register_ble_device(var, config):
     paren = await cg.get_variable(config[CONF_ESP32_BLE_ID])
     cg.add(paren.register_listener(var))
+    if CONF_MAC_ADDRESS in config:
+        # lets the tracker skip parsing advertisements from other devices
+        cg.add(var.set_address_filter(config[CONF_MAC_ADDRESS].as_hex))
     return var
 
 
@@ -31,22 +31,27 @@ class ESPBTAdvertiseTrigger : public Trigger<const ESPBTDevice &>, public ESPBTD
 class BLEServiceDataAdvertiseTrigger : public Trigger<const adv_data_t &>, public ESPBTDeviceListener {
  public:
   explicit BLEServiceDataAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
-  void set_address(uint64_t address) { this->address_ = address; }
+  void set_address(uint64_t address) {
+    this->address_ = address;
+    this->set_address_filter(address);
+  }
   void set_service_uuid16(uint16_t uuid) { this->uuid_ = ESPBTUUID::from_uint16(uuid); }
   void set_service_uuid32(uint32_t uuid) { this->uuid_ = ESPBTUUID::from_uint32(uuid); }
   void set_service_uuid128(uint8_t *uuid) { this->uuid_ = ESPBTUUID::from_raw(uuid); }
 
-  bool parse_device(const ESPBTDevice &device) override {
-    if (this->address_ && device.address_uint64() != this->address_) {
+  AdvertisementParserType get_advertisement_parser_type() override {
+    return AdvertisementParserType::VIEW_ADVERTISEMENTS;
+  }
+  bool parse_device(const ESPBTDevice &device) override { return false; }
+  bool parse_device_view(const ESPBTDeviceView &view) override {
+    if (this->address_ && view.address_uint64() != this->address_) {
       return false;
     }
-    for (auto &service_data : device.get_service_datas()) {
-      if (service_data.uuid == this->uuid_) {
-        this->trigger(service_data.data);
-        return true;
-      }
-    }
-    return false;
+    AdvDataView data;
+    if (!view.get_service_data(this->uuid_, &data))
+      return false;
+    this->trigger(adv_data_t(data.data, data.data + data.size));
+    return true;
   }
 
  protected:
@@ -57,22 +62,27 @@ class BLEServiceDataAdvertiseTrigger : public Trigger<const adv_data_t &>, publi
 class BLEManufacturerDataAdvertiseTrigger : public Trigger<const adv_data_t &>, public ESPBTDeviceListener {
  public:
   explicit BLEManufacturerDataAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
-  void set_address(uint64_t address) { this->address_ = address; }
+  void set_address(uint64_t address) {
+    this->address_ = address;
+    this->set_address_filter(address);
+  }
   void set_manufacturer_uuid16(uint16_t uuid) { this->uuid_ = ESPBTUUID::from_uint16(uuid); }
   void set_manufacturer_uuid32(uint32_t uuid) { this->uuid_ = ESPBTUUID::from_uint32(uuid); }
   void set_manufacturer_uuid128(uint8_t *uuid) { this->uuid_ = ESPBTUUID::from_raw(uuid); }
 
-  bool parse_device(const ESPBTDevice &device) override {
-    if (this->address_ && device.address_uint64() != this->address_) {
+  AdvertisementParserType get_advertisement_parser_type() override {
+    return AdvertisementParserType::VIEW_ADVERTISEMENTS;
+  }
+  bool parse_device(const ESPBTDevice &device) override { return false; }
+  bool parse_device_view(const ESPBTDeviceView &view) override {
+    if (this->address_ && view.address_uint64() != this->address_) {
       return false;
     }
-    for (auto &manufacturer_data : device.get_manufacturer_datas()) {
-      if (manufacturer_data.uuid == this->uuid_) {
-        this->trigger(manufacturer_data.data);
-        return true;
-      }
-    }
-    return false;
+    AdvDataView data;
+    if (!view.get_manufacturer_data(this->uuid_, &data))
+      return false;
+    this->trigger(adv_data_t(data.data, data.data + data.size));
+    return true;
   }
 
  protected:
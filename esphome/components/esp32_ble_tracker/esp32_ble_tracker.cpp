@@ -15,12 +15,17 @@
 #include <freertos/FreeRTOSConfig.h>
 #include <freertos/task.h>
 #include <nvs_flash.h>
+#include <algorithm>
 #include <cinttypes>
 
 #ifdef USE_OTA
 #include "esphome/components/ota/ota_component.h"
 #endif
 
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
+
 #ifdef USE_ARDUINO
 #include <esp32-hal-bt.h>
 #endif
@@ -33,27 +38,26 @@ namespace esp32_ble_tracker {
 
 static const char *const TAG = "esp32_ble_tracker";
 
+/// How often the adaptive scan window checks the network.
+static const uint32_t ADAPTIVE_CHECK_INTERVAL = 2000;
+/// Idle checks in a row before the window grows again.
+static const uint8_t ADAPTIVE_IDLE_CHECKS = 5;
+/// The smallest window allowed by the Bluetooth spec, 2.5 ms.
+static const uint32_t MIN_SCAN_WINDOW = 0x0004;
+
 ESP32BLETracker *global_esp32_ble_tracker = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 float ESP32BLETracker::get_setup_priority() const { return setup_priority::AFTER_BLUETOOTH; }
 
+static bool address_listener_less(const AddressListener &a, const AddressListener &b) { return a.first < b.first; }
+
 void ESP32BLETracker::setup() {
   if (this->parent_->is_failed()) {
     this->mark_failed();
     ESP_LOGE(TAG, "BLE Tracker was marked failed by ESP32BLE");
     return;
   }
-  ExternalRAMAllocator<esp_ble_gap_cb_param_t::ble_scan_result_evt_param> allocator(
-      ExternalRAMAllocator<esp_ble_gap_cb_param_t::ble_scan_result_evt_param>::ALLOW_FAILURE);
-  this->scan_result_buffer_ = allocator.allocate(ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE);
-
-  if (this->scan_result_buffer_ == nullptr) {
-    ESP_LOGE(TAG, "Could not allocate buffer for BLE Tracker!");
-    this->mark_failed();
-  }
-
   global_esp32_ble_tracker = this;
-  this->scan_result_lock_ = xSemaphoreCreateMutex();
   this->scan_end_lock_ = xSemaphoreCreateMutex();
   this->scanner_idle_ = true;
 
@@ -101,29 +105,62 @@ void ESP32BLETracker::loop() {
   bool promote_to_connecting = discovered && !searching && !connecting;
 
   if (!this->scanner_idle_) {
-    if (this->scan_result_index_ &&  // if it looks like we have a scan result we will take the lock
-        xSemaphoreTake(this->scan_result_lock_, 5L / portTICK_PERIOD_MS)) {
-      uint32_t index = this->scan_result_index_;
-      if (index >= ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
-        ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
-      }
-
+    const uint32_t head = this->parent_->get_scan_result_head();
+    const uint32_t tail = this->parent_->get_scan_result_tail();
+    auto *scan_results = this->parent_->get_scan_result_buffer();
+    if (head != tail) {
       if (this->raw_advertisements_) {
+        // the results may wrap around the end of the ring, pass both contiguous parts
+        const size_t count = head - tail;
+        const size_t start = tail % esp32_ble::ESP32BLE::SCAN_RESULT_BUFFER_SIZE;
+        const size_t first = std::min<size_t>(count, esp32_ble::ESP32BLE::SCAN_RESULT_BUFFER_SIZE - start);
         for (auto *listener : this->listeners_) {
-          listener->parse_devices(this->scan_result_buffer_, this->scan_result_index_);
+          listener->parse_devices(scan_results + start, first);
+          if (count > first)
+            listener->parse_devices(scan_results, count - first);
         }
         for (auto *client : this->clients_) {
-          client->parse_devices(this->scan_result_buffer_, this->scan_result_index_);
+          client->parse_devices(scan_results + start, first);
+          if (count > first)
+            client->parse_devices(scan_results, count - first);
         }
       }
 
-      if (this->parse_advertisements_) {
-        for (size_t i = 0; i < index; i++) {
-          ESPBTDevice device;
-          device.parse_scan_rst(this->scan_result_buffer_[i]);
+      if (this->parse_advertisements_ || this->view_advertisements_) {
+        if (this->listener_index_dirty_)
+          this->build_listener_index_();
+        // unless something wants every advertisement, skip parsing those no listener filters for
+        const bool parse_all = this->parse_all_advertisements_ || !this->scan_continuous_;
+        for (uint32_t i = tail; i != head; i++) {
+          const auto &result = scan_results[i % esp32_ble::ESP32BLE::SCAN_RESULT_BUFFER_SIZE];
+          const uint64_t address = esp32_ble::ble_addr_to_uint64(result.bda);
 
           bool found = false;
-          for (auto *listener : this->listeners_) {
+          if (!this->view_listeners_.empty()) {
+            const ESPBTDeviceView view(result);
+            for (auto *listener : this->view_listeners_) {
+              auto filter = listener->get_address_filter();
+              if ((!filter.has_value() || *filter == address) && listener->parse_device_view(view))
+                found = true;
+            }
+          }
+          if (!this->parse_advertisements_)
+            continue;
+
+          auto it = std::lower_bound(this->address_listeners_.begin(), this->address_listeners_.end(),
+                                     AddressListener(address, nullptr), address_listener_less);
+          const bool matched = it != this->address_listeners_.end() && it->first == address;
+          if (!parse_all && !matched)
+            continue;
+
+          ESPBTDevice device;
+          device.parse_scan_rst(result);
+
+          for (; it != this->address_listeners_.end() && it->first == address; it++) {
+            if (it->second->parse_device(device))
+              found = true;
+          }
+          for (auto *listener : this->unfiltered_listeners_) {
             if (listener->parse_device(device))
               found = true;
           }
@@ -142,10 +179,26 @@ void ESP32BLETracker::loop() {
           }
         }
       }
-      this->scan_result_index_ = 0;
-      xSemaphoreGive(this->scan_result_lock_);
+      // hand the slots back to the BT task only once they've been processed
+      this->parent_->release_scan_results(head);
     }
 
+    const uint32_t dropped = this->parent_->get_dropped_scan_results();
+    const uint32_t now = millis();
+    if (dropped != this->dropped_reported_ && now - this->dropped_report_time_ >= 1000) {
+      ESP_LOGW(TAG, "Too many BLE events to process, %" PRIu32 " advertisements dropped. Some devices may not show up.",
+               dropped - this->dropped_reported_);
+      this->dropped_reported_ = dropped;
+      this->dropped_report_time_ = now;
+#ifdef USE_SENSOR
+      if (this->dropped_advertisements_sensor_ != nullptr)
+        this->dropped_advertisements_sensor_->publish_state(dropped);
+#endif
+    }
+
+    if (this->scan_adaptive_ && this->scan_continuous_ && !connecting && !disconnecting && !promote_to_connecting)
+      this->adapt_scan_window_(now);
+
     /*
 
       Avoid starting the scanner if:
@@ -221,6 +274,43 @@ void ESP32BLETracker::loop() {
   }
 }
 
+void ESP32BLETracker::adapt_scan_window_(uint32_t now) {
+  if (now - this->adaptive_check_time_ < ADAPTIVE_CHECK_INTERVAL)
+    return;
+  this->adaptive_check_time_ = now;
+
+  size_t backlog = 0;
+#ifdef USE_API
+  if (api::global_api_server != nullptr)
+    backlog = api::global_api_server->get_tx_backlog();
+#endif
+  const uint32_t min_window = std::max(MIN_SCAN_WINDOW, this->scan_window_ / 8);
+  uint32_t window = this->current_scan_window_;
+  if (backlog > 0) {
+    // the socket can't get rid of its data, give the radio back to Wi-Fi quickly
+    this->adaptive_idle_checks_ = 0;
+    window = std::max(min_window, window / 2);
+  } else if (++this->adaptive_idle_checks_ >= ADAPTIVE_IDLE_CHECKS) {
+    // and only take it back gradually once the link stayed idle for a while
+    this->adaptive_idle_checks_ = 0;
+    window = std::min(this->scan_window_, window * 2);
+  }
+  if (window == this->current_scan_window_)
+    return;
+
+  ESP_LOGD(TAG, "Scan window %.1f ms, TX backlog %u bytes", window * 0.625f, (unsigned) backlog);
+  this->current_scan_window_ = window;
+  if (xSemaphoreTake(this->scan_end_lock_, 0L)) {
+    // not scanning, the next scan starts with the new window
+    xSemaphoreGive(this->scan_end_lock_);
+    return;
+  }
+  // restart the running scan for the new window to take effect, it continues as the same scan for the listeners
+  this->scan_restart_ = true;
+  esp_ble_gap_stop_scanning();
+  this->cancel_timeout("scan");
+}
+
 void ESP32BLETracker::start_scan() {
   if (xSemaphoreTake(this->scan_end_lock_, 0L)) {
     this->start_scan_(true);
@@ -244,17 +334,20 @@ void ESP32BLETracker::start_scan_(bool first) {
   }
 
   ESP_LOGD(TAG, "Starting scan...");
-  if (!first) {
-    for (auto *listener : this->listeners_)
-      listener->on_scan_end();
+  if (!this->scan_restart_) {
+    if (!first) {
+      for (auto *listener : this->listeners_)
+        listener->on_scan_end();
+    }
+    this->already_discovered_.clear();
   }
-  this->already_discovered_.clear();
+  this->scan_restart_ = false;
   this->scanner_idle_ = false;
   this->scan_params_.scan_type = this->scan_active_ ? BLE_SCAN_TYPE_ACTIVE : BLE_SCAN_TYPE_PASSIVE;
   this->scan_params_.own_addr_type = BLE_ADDR_TYPE_PUBLIC;
   this->scan_params_.scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL;
   this->scan_params_.scan_interval = this->scan_interval_;
-  this->scan_params_.scan_window = this->scan_window_;
+  this->scan_params_.scan_window = this->current_scan_window_;
 
   esp_ble_gap_set_scan_params(&this->scan_params_);
   esp_ble_gap_start_scanning(this->scan_duration_);
@@ -294,14 +387,49 @@ void ESP32BLETracker::register_listener(ESPBTDeviceListener *listener) {
   this->recalculate_advertisement_parser_types();
 }
 
+void ESP32BLETracker::build_listener_index_() {
+  this->address_listeners_.clear();
+  this->unfiltered_listeners_.clear();
+  this->view_listeners_.clear();
+  for (auto *listener : this->listeners_) {
+    const AdvertisementParserType type = listener->get_advertisement_parser_type();
+    if (type == AdvertisementParserType::VIEW_ADVERTISEMENTS)
+      this->view_listeners_.push_back(listener);
+    if (type != AdvertisementParserType::PARSED_ADVERTISEMENTS)
+      continue;
+    auto filter = listener->get_address_filter();
+    if (filter.has_value()) {
+      this->address_listeners_.emplace_back(*filter, listener);
+    } else {
+      this->unfiltered_listeners_.push_back(listener);
+    }
+  }
+  std::stable_sort(this->address_listeners_.begin(), this->address_listeners_.end(), address_listener_less);
+
+  this->parse_all_advertisements_ = !this->unfiltered_listeners_.empty();
+  for (auto *client : this->clients_) {
+    if (client->get_advertisement_parser_type() == AdvertisementParserType::PARSED_ADVERTISEMENTS)
+      this->parse_all_advertisements_ = true;
+  }
+  this->listener_index_dirty_ = false;
+}
+
 void ESP32BLETracker::recalculate_advertisement_parser_types() {
+  this->listener_index_dirty_ = true;
   this->raw_advertisements_ = false;
   this->parse_advertisements_ = false;
+  this->view_advertisements_ = false;
   for (auto *listener : this->listeners_) {
-    if (listener->get_advertisement_parser_type() == AdvertisementParserType::PARSED_ADVERTISEMENTS) {
-      this->parse_advertisements_ = true;
-    } else {
-      this->raw_advertisements_ = true;
+    switch (listener->get_advertisement_parser_type()) {
+      case AdvertisementParserType::PARSED_ADVERTISEMENTS:
+        this->parse_advertisements_ = true;
+        break;
+      case AdvertisementParserType::VIEW_ADVERTISEMENTS:
+        this->view_advertisements_ = true;
+        break;
+      default:
+        this->raw_advertisements_ = true;
+        break;
     }
   }
   for (auto *client : this->clients_) {
@@ -354,16 +482,8 @@ void ESP32BLETracker::gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_
 }
 
 void ESP32BLETracker::gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  if (param.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
-    if (xSemaphoreTake(this->scan_result_lock_, 0L)) {
-      if (this->scan_result_index_ < ESP32BLETracker::SCAN_RESULT_BUFFER_SIZE) {
-        this->scan_result_buffer_[this->scan_result_index_++] = param;
-      }
-      xSemaphoreGive(this->scan_result_lock_);
-    }
-  } else if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
+  if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT)
     xSemaphoreGive(this->scan_end_lock_);
-  }
 }
 
 void ESP32BLETracker::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_if_t gattc_if,
@@ -373,6 +493,98 @@ void ESP32BLETracker::gattc_event_handler(esp_gattc_cb_event_t event, esp_gatt_i
   }
 }
 
+AdvDataView ESPBTDeviceView::get_name() const {
+  AdvDataView name{};
+  this->for_each_record([&name](uint8_t type, const uint8_t *record, uint8_t size) {
+    if ((type == ESP_BLE_AD_TYPE_NAME_SHORT || type == ESP_BLE_AD_TYPE_NAME_CMPL) && size > name.size)
+      name = AdvDataView{record, size};
+    return true;
+  });
+  return name;
+}
+
+bool ESPBTDeviceView::has_service_uuid(const ESPBTUUID &uuid) const {
+  bool found = false;
+  this->for_each_record([&uuid, &found](uint8_t type, const uint8_t *record, uint8_t size) {
+    switch (type) {
+      case ESP_BLE_AD_TYPE_16SRV_CMPL:
+      case ESP_BLE_AD_TYPE_16SRV_PART:
+        for (uint8_t i = 0; i + 2 <= size && !found; i += 2)
+          found = uuid == ESPBTUUID::from_uint16(encode_uint16(record[i + 1], record[i]));
+        break;
+      case ESP_BLE_AD_TYPE_32SRV_CMPL:
+      case ESP_BLE_AD_TYPE_32SRV_PART:
+        for (uint8_t i = 0; i + 4 <= size && !found; i += 4)
+          found = uuid == ESPBTUUID::from_uint32(encode_uint32(record[i + 3], record[i + 2], record[i + 1], record[i]));
+        break;
+      case ESP_BLE_AD_TYPE_128SRV_CMPL:
+      case ESP_BLE_AD_TYPE_128SRV_PART:
+        found = size >= 16 && uuid == ESPBTUUID::from_raw(record);
+        break;
+      default:
+        break;
+    }
+    return !found;
+  });
+  return found;
+}
+
+bool ESPBTDeviceView::find_uuid_data_(const ESPBTUUID &uuid, bool manufacturer, AdvDataView *data) const {
+  bool found = false;
+  this->for_each_record([&](uint8_t type, const uint8_t *record, uint8_t size) {
+    uint8_t uuid_size;
+    if (manufacturer) {
+      if (type != ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE)
+        return true;
+      uuid_size = 2;
+    } else if (type == ESP_BLE_AD_TYPE_SERVICE_DATA) {
+      uuid_size = 2;
+    } else if (type == ESP_BLE_AD_TYPE_32SERVICE_DATA) {
+      uuid_size = 4;
+    } else if (type == ESP_BLE_AD_TYPE_128SERVICE_DATA) {
+      uuid_size = 16;
+    } else {
+      return true;
+    }
+    if (size < uuid_size)
+      return true;
+    ESPBTUUID record_uuid;
+    if (uuid_size == 2) {
+      record_uuid = ESPBTUUID::from_uint16(encode_uint16(record[1], record[0]));
+    } else if (uuid_size == 4) {
+      record_uuid = ESPBTUUID::from_uint32(encode_uint32(record[3], record[2], record[1], record[0]));
+    } else {
+      record_uuid = ESPBTUUID::from_raw(record);
+    }
+    if (!(record_uuid == uuid))
+      return true;
+    *data = AdvDataView{record + uuid_size, uint8_t(size - uuid_size)};
+    found = true;
+    return false;
+  });
+  return found;
+}
+
+bool ESPBTDeviceView::get_service_data(const ESPBTUUID &uuid, AdvDataView *data) const {
+  return this->find_uuid_data_(uuid, false, data);
+}
+
+bool ESPBTDeviceView::get_manufacturer_data(const ESPBTUUID &uuid, AdvDataView *data) const {
+  return this->find_uuid_data_(uuid, true, data);
+}
+
+optional<ESPBLEiBeacon> ESPBTDeviceView::get_ibeacon() const {
+  optional<ESPBLEiBeacon> beacon{};
+  this->for_each_record([&beacon](uint8_t type, const uint8_t *record, uint8_t size) {
+    // Apple's company identifier followed by the 23 bytes of beacon data
+    if (type != ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE || size != 25 || record[0] != 0x4C || record[1] != 0x00)
+      return true;
+    beacon = ESPBLEiBeacon(record + 2);
+    return false;
+  });
+  return beacon;
+}
+
 ESPBLEiBeacon::ESPBLEiBeacon(const uint8_t *data) { memcpy(&this->beacon_data_, data, sizeof(beacon_data_)); }
 optional<ESPBLEiBeacon> ESPBLEiBeacon::from_manufacturer_data(const ServiceData &data) {
   if (!data.uuid.contains(0x4C, 0x00))
@@ -446,22 +658,7 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
 #endif
 }
 void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
-  size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len + param.scan_rsp_len;
-
-  while (offset + 2 < len) {
-    const uint8_t field_length = payload[offset++];  // First byte is length of adv record
-    if (field_length == 0) {
-      continue;  // Possible zero padded advertisement data
-    }
-
-    // first byte of adv record is adv record type
-    const uint8_t record_type = payload[offset++];
-    const uint8_t *record = &payload[offset];
-    const uint8_t record_length = field_length - 1;
-    offset += record_length;
-
+  ESPBTDeviceView(param).for_each_record([this](uint8_t record_type, const uint8_t *record, uint8_t record_length) {
     // See also Generic Access Profile Assigned Numbers:
     // https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
     // RESPONSE DATA FORMAT: https://www.bluetooth.com/specifications/bluetooth-core-specification/ (vol 3, part C, 11)
@@ -486,7 +683,7 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         // CSS 1.5 TX POWER LEVEL
         // "The TX Power Level data type indicates the transmitted power level of the packet containing the data type."
         // CSS 1: Optional in this context (may appear more than once in a block).
-        this->tx_powers_.push_back(*payload);
+        this->tx_powers_.push_back(*record);
         break;
       }
       case ESP_BLE_AD_TYPE_APPEARANCE: {
@@ -603,7 +800,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         break;
       }
     }
-  }
+    return true;
+  });
 }
 std::string ESPBTDevice::address_str() const {
   char mac[24];
@@ -618,6 +816,7 @@ void ESP32BLETracker::dump_config() {
   ESP_LOGCONFIG(TAG, "  Scan Duration: %" PRIu32 " s", this->scan_duration_);
   ESP_LOGCONFIG(TAG, "  Scan Interval: %.1f ms", this->scan_interval_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Window: %.1f ms", this->scan_window_ * 0.625f);
+  ESP_LOGCONFIG(TAG, "  Adaptive Scan Window: %s", YESNO(this->scan_adaptive_));
   ESP_LOGCONFIG(TAG, "  Scan Type: %s", this->scan_active_ ? "ACTIVE" : "PASSIVE");
   ESP_LOGCONFIG(TAG, "  Continuous Scanning: %s", this->scan_continuous_ ? "True" : "False");
 }
@@ -5,6 +5,7 @@
 #include "esphome/core/helpers.h"
 
 #include <array>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,10 @@
 #include "esphome/components/esp32_ble/ble.h"
 #include "esphome/components/esp32_ble/ble_uuid.h"
 
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
 namespace esphome {
 namespace esp32_ble_tracker {
 
@@ -30,6 +35,8 @@ using adv_data_t = std::vector<uint8_t>;
 enum AdvertisementParserType {
   PARSED_ADVERTISEMENTS,
   RAW_ADVERTISEMENTS,
+  /// The listener reads advertisements through an ESPBTDeviceView.
+  VIEW_ADVERTISEMENTS,
 };
 
 struct ServiceData {
@@ -59,6 +66,62 @@ class ESPBLEiBeacon {
   } PACKED beacon_data_;
 };
 
+/// Non-owning reference to the payload of one advertisement record.
+struct AdvDataView {
+  const uint8_t *data{nullptr};
+  uint8_t size{0};
+};
+
+/** Allocation-free view of a scan result.
+ *
+ * Unlike ESPBTDevice nothing is copied up front, each accessor walks the raw advertisement records when it's
+ * called. The view and the data it returns are only valid during the listener call.
+ */
+class ESPBTDeviceView {
+ public:
+  explicit ESPBTDeviceView(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) : param_(param) {}
+
+  uint64_t address_uint64() const { return esp32_ble::ble_addr_to_uint64(this->param_.bda); }
+  const uint8_t *address() const { return this->param_.bda; }
+  esp_ble_addr_type_t get_address_type() const { return this->param_.ble_addr_type; }
+  int get_rssi() const { return this->param_.rssi; }
+  const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &get_scan_result() const { return this->param_; }
+
+  /// The longest of the complete and shortened local names, empty if none is advertised.
+  AdvDataView get_name() const;
+  bool has_service_uuid(const ESPBTUUID &uuid) const;
+  /// Find the first service data record for uuid, without the uuid itself.
+  bool get_service_data(const ESPBTUUID &uuid, AdvDataView *data) const;
+  /// Find the first manufacturer data record for the company uuid, without the uuid itself.
+  bool get_manufacturer_data(const ESPBTUUID &uuid, AdvDataView *data) const;
+  optional<ESPBLEiBeacon> get_ibeacon() const;
+
+  /// Call callback(type, data, size) for each advertisement record until it returns false.
+  template<typename F> void for_each_record(F &&callback) const {
+    const uint8_t *payload = this->param_.ble_adv;
+    const size_t len = this->param_.adv_data_len + this->param_.scan_rsp_len;
+    size_t offset = 0;
+    while (offset + 2 < len) {
+      const uint8_t field_length = payload[offset++];  // First byte is length of adv record
+      if (field_length == 0)
+        continue;  // Possible zero padded advertisement data
+      if (offset + field_length > len)
+        return;  // Truncated record
+      // first byte of adv record is adv record type
+      const uint8_t record_type = payload[offset++];
+      const uint8_t *record = &payload[offset];
+      offset += field_length - 1;
+      if (!callback(record_type, record, uint8_t(field_length - 1)))
+        return;
+    }
+  }
+
+ protected:
+  bool find_uuid_data_(const ESPBTUUID &uuid, bool manufacturer, AdvDataView *data) const;
+
+  const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param_;
+};
+
 class ESPBTDevice {
  public:
   void parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
@@ -121,15 +184,23 @@ class ESPBTDeviceListener {
   virtual bool parse_devices(esp_ble_gap_cb_param_t::ble_scan_result_evt_param *advertisements, size_t count) {
     return false;
   };
+  /// Called instead of parse_device() by listeners of type VIEW_ADVERTISEMENTS.
+  virtual bool parse_device_view(const ESPBTDeviceView &view) { return false; }
   virtual AdvertisementParserType get_advertisement_parser_type() {
     return AdvertisementParserType::PARSED_ADVERTISEMENTS;
   };
   void set_parent(ESP32BLETracker *parent) { parent_ = parent; }
+  /// Only pass advertisements from this address to parse_device().
+  void set_address_filter(uint64_t address) { this->address_filter_ = address; }
+  optional<uint64_t> get_address_filter() const { return this->address_filter_; }
 
  protected:
   ESP32BLETracker *parent_{nullptr};
+  optional<uint64_t> address_filter_{};
 };
 
+using AddressListener = std::pair<uint64_t, ESPBTDeviceListener *>;
+
 enum class ClientState {
   // Connection is allocated
   INIT,
@@ -181,9 +252,17 @@ class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEv
  public:
   void set_scan_duration(uint32_t scan_duration) { scan_duration_ = scan_duration; }
   void set_scan_interval(uint32_t scan_interval) { scan_interval_ = scan_interval; }
-  void set_scan_window(uint32_t scan_window) { scan_window_ = scan_window; }
+  void set_scan_window(uint32_t scan_window) {
+    scan_window_ = scan_window;
+    current_scan_window_ = scan_window;
+  }
+  /// Shrink the scan window while the API can't send its data fast enough, the configured window is the maximum.
+  void set_scan_adaptive(bool scan_adaptive) { scan_adaptive_ = scan_adaptive; }
   void set_scan_active(bool scan_active) { scan_active_ = scan_active; }
   void set_scan_continuous(bool scan_continuous) { scan_continuous_ = scan_continuous; }
+#ifdef USE_SENSOR
+  void set_dropped_advertisements_sensor(sensor::Sensor *sensor) { this->dropped_advertisements_sensor_ = sensor; }
+#endif
 
   /// Setup the FreeRTOS task and the Bluetooth stack.
   void setup() override;
@@ -198,6 +277,9 @@ class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEv
 
   void print_bt_device_info(const ESPBTDevice &device);
 
+  /// Number of advertisements dropped because the loop couldn't keep up with the scan results.
+  uint32_t get_dropped_advertisements() const { return this->parent_->get_dropped_scan_results(); }
+
   void start_scan();
   void stop_scan();
 
@@ -210,7 +292,8 @@ class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEv
   void start_scan_(bool first);
   /// Called when a scan ends
   void end_of_scan_();
-  /// Called when a `ESP_GAP_BLE_SCAN_RESULT_EVT` event is received.
+  /// Called when a `ESP_GAP_BLE_SCAN_RESULT_EVT` event other than an advertisement is received, those go through the
+  /// scan result ring of ESP32BLE.
   void gap_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT` event is received.
   void gap_scan_set_param_complete_(const esp_ble_gap_cb_param_t::ble_scan_param_cmpl_evt_param &param);
@@ -218,12 +301,25 @@ class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEv
   void gap_scan_start_complete_(const esp_ble_gap_cb_param_t::ble_scan_start_cmpl_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT` event is received.
   void gap_scan_stop_complete_(const esp_ble_gap_cb_param_t::ble_scan_stop_cmpl_evt_param &param);
+  /// Adjust the scan window to the network backlog, restarting the scan when it changed.
+  void adapt_scan_window_(uint32_t now);
+  /// Sort the parsed advertisement listeners into the address index and the unfiltered list.
+  void build_listener_index_();
 
   int app_id_;
 
   /// Vector of addresses that have already been printed in print_bt_device_info
   std::vector<uint64_t> already_discovered_;
   std::vector<ESPBTDeviceListener *> listeners_;
+  /// Parsed advertisement listeners with an address filter, sorted by address.
+  std::vector<AddressListener> address_listeners_;
+  /// Parsed advertisement listeners that want every advertisement.
+  std::vector<ESPBTDeviceListener *> unfiltered_listeners_;
+  /// Listeners reading advertisements through an ESPBTDeviceView.
+  std::vector<ESPBTDeviceListener *> view_listeners_;
+  /// Whether an unfiltered listener or a client needs every advertisement parsed.
+  bool parse_all_advertisements_{true};
+  bool listener_index_dirty_{true};
   /// Client parameters.
   std::vector<ESPBTClient *> clients_;
   /// A structure holding the ESP BLE scan parameters.
@@ -232,21 +328,26 @@ class ESP32BLETracker : public Component, public GAPEventHandler, public GATTcEv
   uint32_t scan_duration_;
   uint32_t scan_interval_;
   uint32_t scan_window_;
+  /// The window the scanner is set up with, only differs from scan_window_ in adaptive mode.
+  uint32_t current_scan_window_;
+  uint32_t adaptive_check_time_{0};
+  uint8_t adaptive_idle_checks_{0};
+  bool scan_adaptive_{false};
+  /// The next scan start continues the current scan with new parameters.
+  bool scan_restart_{false};
   uint8_t scan_start_fail_count_;
   bool scan_continuous_;
   bool scan_active_;
   bool scanner_idle_;
   bool raw_advertisements_{false};
   bool parse_advertisements_{false};
-  SemaphoreHandle_t scan_result_lock_;
+  bool view_advertisements_{false};
   SemaphoreHandle_t scan_end_lock_;
-  size_t scan_result_index_{0};
-#if CONFIG_SPIRAM
-  const static u_int8_t SCAN_RESULT_BUFFER_SIZE = 32;
-#else
-  const static u_int8_t SCAN_RESULT_BUFFER_SIZE = 16;
-#endif  // CONFIG_SPIRAM
-  esp_ble_gap_cb_param_t::ble_scan_result_evt_param *scan_result_buffer_;
+  uint32_t dropped_reported_{0};
+  uint32_t dropped_report_time_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *dropped_advertisements_sensor_{nullptr};
+#endif
   esp_bt_status_t scan_start_failed_{ESP_BT_STATUS_SUCCESS};
   esp_bt_status_t scan_set_param_failed_{ESP_BT_STATUS_SUCCESS};
 };
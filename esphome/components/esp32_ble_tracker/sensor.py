@@ -0,0 +1,31 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+    STATE_CLASS_TOTAL_INCREASING,
+)
+from . import CONF_ESP32_BLE_ID, ESP32BLETracker
+
+DEPENDENCIES = ["esp32_ble_tracker"]
+
+CONF_DROPPED_ADVERTISEMENTS = "dropped_advertisements"
+
+CONFIG_SCHEMA = {
+    cv.GenerateID(CONF_ESP32_BLE_ID): cv.use_id(ESP32BLETracker),
+    cv.Optional(CONF_DROPPED_ADVERTISEMENTS): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+}
+
+
+async def to_code(config):
+    tracker = await cg.get_variable(config[CONF_ESP32_BLE_ID])
+
+    if dropped_conf := config.get(CONF_DROPPED_ADVERTISEMENTS):
+        sens = await sensor.new_sensor(dropped_conf)
+        cg.add(tracker.set_dropped_advertisements_sensor(sens))
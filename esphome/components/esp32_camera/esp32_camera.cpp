@@ -32,7 +32,7 @@ void ESP32Camera::setup() {
 
   /* initialize RTOS */
   this->framebuffer_get_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
-  this->framebuffer_return_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
+  this->framebuffer_return_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
   xTaskCreatePinnedToCore(&ESP32Camera::framebuffer_task,
                           "framebuffer_task",  // name
                           1024,                // stack size
@@ -127,7 +127,7 @@ void ESP32Camera::dump_config() {
   sensor_t *s = esp_camera_sensor_get();
   auto st = s->status;
   ESP_LOGCONFIG(TAG, "  JPEG Quality: %u", st.quality);
-  // ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
+  ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", (unsigned) conf.fb_count);
   ESP_LOGCONFIG(TAG, "  Contrast: %d", st.contrast);
   ESP_LOGCONFIG(TAG, "  Brightness: %d", st.brightness);
   ESP_LOGCONFIG(TAG, "  Saturation: %d", st.saturation);
@@ -153,12 +153,15 @@ void ESP32Camera::dump_config() {
 }
 
 void ESP32Camera::loop() {
-  // check if we can return the image
-  if (this->can_return_image_()) {
-    // return image
-    auto *fb = this->current_image_->get_raw_buffer();
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    this->current_image_.reset();
+  // return the images all consumers are done with to the pool
+  for (auto it = this->images_.begin(); it != this->images_.end();) {
+    if (it->use_count() == 1) {
+      auto *fb = (*it)->get_raw_buffer();
+      xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+      it = this->images_.erase(it);
+    } else {
+      ++it;
+    }
   }
 
   // request idle image every idle_update_interval
@@ -171,8 +174,8 @@ void ESP32Camera::loop() {
   // Check if we should fetch a new image
   if (!this->has_requested_image_())
     return;
-  if (this->current_image_.use_count() > 1) {
-    // image is still in use
+  if (this->images_.size() >= this->config_.fb_count) {
+    // every frame buffer is still held by a consumer
     return;
   }
   if (now - this->last_update_ <= this->max_update_interval_)
@@ -191,10 +194,11 @@ void ESP32Camera::loop() {
     xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
     return;
   }
-  this->current_image_ = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  auto image = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  this->images_.push_back(image);
 
   ESP_LOGD(TAG, "Got Image: len=%u", fb->len);
-  this->new_image_callback_.call(this->current_image_);
+  this->new_image_callback_.call(image);
   this->last_update_ = now;
   this->single_requesters_ = 0;
 }
@@ -330,6 +334,7 @@ void ESP32Camera::set_test_pattern(bool test_pattern) { this->test_pattern_ = te
 void ESP32Camera::set_max_update_interval(uint32_t max_update_interval) {
   this->max_update_interval_ = max_update_interval;
 }
+void ESP32Camera::set_frame_buffer_count(uint8_t fb_count) { this->config_.fb_count = fb_count; }
 void ESP32Camera::set_idle_update_interval(uint32_t idle_update_interval) {
   this->idle_update_interval_ = idle_update_interval;
 }
@@ -379,14 +384,24 @@ void ESP32Camera::update_camera_parameters() {
 
 /* ---------------- Internal methods ---------------- */
 bool ESP32Camera::has_requested_image_() const { return this->single_requesters_ || this->stream_requesters_; }
-bool ESP32Camera::can_return_image_() const { return this->current_image_.use_count() == 1; }
 void ESP32Camera::framebuffer_task(void *pv) {
+  const uint8_t fb_count = global_esp32_camera->config_.fb_count;
+  uint8_t in_use = 0;
+  camera_fb_t *framebuffer;
   while (true) {
-    camera_fb_t *framebuffer = esp_camera_fb_get();
-    xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
-    // return is no-op for config with 1 fb
-    xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
-    esp_camera_fb_return(framebuffer);
+    // capture while the pool has a free buffer, otherwise wait for one to be returned
+    if (in_use < fb_count) {
+      framebuffer = esp_camera_fb_get();
+      xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
+      in_use++;
+    }
+    TickType_t wait = in_use < fb_count ? 0 : portMAX_DELAY;
+    while (xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, wait) == pdTRUE) {
+      // return is no-op for config with 1 fb
+      esp_camera_fb_return(framebuffer);
+      in_use--;
+      wait = 0;
+    }
   }
 }
 
@@ -140,6 +140,8 @@ class ESP32Camera : public Component, public EntityBase {
   /* -- framerates */
   void set_max_update_interval(uint32_t max_update_interval);
   void set_idle_update_interval(uint32_t idle_update_interval);
+  /* -- frame buffers */
+  void set_frame_buffer_count(uint8_t fb_count);
 
   /* public API (derivated) */
   void setup() override;
@@ -159,7 +161,6 @@ class ESP32Camera : public Component, public EntityBase {
  protected:
   /* internal methods */
   bool has_requested_image_() const;
-  bool can_return_image_() const;
 
   static void framebuffer_task(void *pv);
 
@@ -191,7 +192,9 @@ class ESP32Camera : public Component, public EntityBase {
   uint32_t idle_update_interval_{15000};
 
   esp_err_t init_error_{ESP_OK};
-  std::shared_ptr<CameraImage> current_image_;
+  /// Images handed to consumers, at most one per frame buffer. A buffer goes back to the camera once every
+  /// consumer dropped its reference, so a slow consumer only holds up the buffers it keeps.
+  std::vector<std::shared_ptr<CameraImage>> images_;
   uint8_t single_requesters_{0};
   uint8_t stream_requesters_{0};
   QueueHandle_t framebuffer_get_queue_;
@@ -11,6 +11,10 @@
 #include <esp_http_server.h>
 #include <utility>
 
+#ifdef USE_WIFI
+#include "esphome/components/wifi/wifi_component.h"
+#endif
+
 namespace esphome {
 namespace esp32_camera_web_server {
 
@@ -31,9 +35,14 @@ static const char *const STREAM_ERROR = "Content-Type: text/plain\r\n"
                                         "\r\n"
                                         "No frames send.\r\n"
                                         "--" PART_BOUNDARY "\r\n";
-static const char *const STREAM_PART = "Content-Type: " CONTENT_TYPE "\r\n" CONTENT_LENGTH ": %u\r\n\r\n";
-static const char *const STREAM_BOUNDARY = "\r\n"
-                                           "--" PART_BOUNDARY "\r\n";
+/// Boundary that ends the previous part followed by the headers of the next one, sent as one piece before each frame.
+static const char STREAM_PART_PREFIX[] = "\r\n"
+                                         "--" PART_BOUNDARY "\r\n"
+                                         "Content-Type: " CONTENT_TYPE "\r\n" CONTENT_LENGTH ": ";
+static const size_t STREAM_PART_PREFIX_LEN = sizeof(STREAM_PART_PREFIX) - 1;
+/// The first part follows the boundary in STREAM_HEADER, so it skips the leading boundary of the prefix.
+static const size_t STREAM_BOUNDARY_LEN = sizeof("\r\n--" PART_BOUNDARY "\r\n") - 1;
+static const uint32_t STREAM_STATS_INTERVAL = 10000;
 
 CameraWebServer::CameraWebServer() {}
 
@@ -69,6 +78,8 @@ void CameraWebServer::setup() {
 
   esp32_camera::global_esp32_camera->add_image_callback([this](std::shared_ptr<esp32_camera::CameraImage> image) {
     if (this->running_ && image->was_requested_by(esp32_camera::WEB_REQUESTER)) {
+      // Latest only: a newer image replaces the one the client hasn't picked up yet, so a slow client holds at most
+      // the frame it is sending and the next one
       this->image_ = std::move(image);
       xSemaphoreGive(this->semaphore_);
     }
@@ -156,7 +167,9 @@ static esp_err_t httpd_send_all(httpd_req_t *r, const char *buf, size_t buf_len)
 
 esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
   esp_err_t res = ESP_OK;
-  char part_buf[64];
+  // boundary, part headers and room for the content length digits
+  char part_buf[STREAM_PART_PREFIX_LEN + 16];
+  memcpy(part_buf, STREAM_PART_PREFIX, STREAM_PART_PREFIX_LEN);
 
   // This manually constructs HTTP response to avoid chunked encoding
   // which is not supported by some clients
@@ -167,11 +180,19 @@ esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
     return res;
   }
 
-  uint32_t last_frame = millis();
+  uint32_t last_stats = millis();
   uint32_t frames = 0;
+  uint32_t stats_frames = 0;
+  uint32_t stats_bytes = 0;
 
   esp32_camera::global_esp32_camera->start_stream(esphome::esp32_camera::WEB_REQUESTER);
+#ifdef USE_WIFI
+  if (wifi::global_wifi_component != nullptr)
+    wifi::global_wifi_component->acquire_high_performance();
+#endif
 
+  // Frames are sent as fast as the client takes them. While one is being sent the camera keeps only the latest
+  // for this client, so a slow connection gets fewer but current frames instead of a growing delay.
   while (res == ESP_OK && this->running_) {
     auto image = this->wait_for_image_();
 
@@ -180,22 +201,27 @@ esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
       res = ESP_FAIL;
     }
     if (res == ESP_OK) {
-      size_t hlen = snprintf(part_buf, 64, STREAM_PART, image->get_data_length());
-      res = httpd_send_all(req, part_buf, hlen);
+      // boundary and headers go out in one send, the image straight from the frame buffer
+      size_t len = STREAM_PART_PREFIX_LEN;
+      len += snprintf(part_buf + len, sizeof(part_buf) - len, "%u\r\n\r\n", (unsigned) image->get_data_length());
+      const size_t skip = frames == 0 ? STREAM_BOUNDARY_LEN : 0;
+      res = httpd_send_all(req, part_buf + skip, len - skip);
     }
     if (res == ESP_OK) {
       res = httpd_send_all(req, (const char *) image->get_data_buffer(), image->get_data_length());
     }
-    if (res == ESP_OK) {
-      res = httpd_send_all(req, STREAM_BOUNDARY, strlen(STREAM_BOUNDARY));
-    }
     if (res == ESP_OK) {
       frames++;
-      int64_t frame_time = millis() - last_frame;
-      last_frame = millis();
-
-      ESP_LOGD(TAG, "MJPG: %uB %ums (%.1ffps)", (uint32_t) image->get_data_length(), (uint32_t) frame_time,
-               1000.0 / (uint32_t) frame_time);
+      stats_frames++;
+      stats_bytes += image->get_data_length();
+      const uint32_t now = millis();
+      if (now - last_stats >= STREAM_STATS_INTERVAL) {
+        ESP_LOGD(TAG, "MJPG: %u frames, %ukB in %ums (%.1ffps)", stats_frames, stats_bytes / 1024, now - last_stats,
+                 stats_frames * 1000.0f / (now - last_stats));
+        last_stats = now;
+        stats_frames = 0;
+        stats_bytes = 0;
+      }
     }
   }
 
@@ -204,6 +230,10 @@ esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
   }
 
   esp32_camera::global_esp32_camera->stop_stream(esphome::esp32_camera::WEB_REQUESTER);
+#ifdef USE_WIFI
+  if (wifi::global_wifi_component != nullptr)
+    wifi::global_wifi_component->release_high_performance();
+#endif
 
   ESP_LOGI(TAG, "STREAM: closed. Frames: %u", frames);
 
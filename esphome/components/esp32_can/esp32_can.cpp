@@ -2,6 +2,8 @@
 #include "esp32_can.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 #include <driver/twai.h>
 
 // WORKAROUND, because CAN_IO_UNUSED is just defined as (-1) in this version
@@ -72,6 +74,21 @@ bool ESP32Can::setup_internal() {
   twai_filter_config_t f_config = TWAI_FILTER_CONFIG_ACCEPT_ALL();
   twai_timing_config_t t_config;
 
+  // Let the controller drop the frames no trigger wants. In single filter mode the id is left aligned in the 32 bit
+  // acceptance code, followed by the RTR bit (and the first two data bytes for standard frames), set mask bits are
+  // ignored.
+  bool use_extended_id;
+  uint32_t can_id;
+  uint32_t can_id_mask;
+  if (this->get_acceptance_filter_(&use_extended_id, &can_id, &can_id_mask)) {
+    const uint8_t shift = use_extended_id ? 3 : 21;
+    const uint32_t width = use_extended_id ? canbus::CAN_EXTENDED_ID_MASK : canbus::CAN_STANDARD_ID_MASK;
+    f_config.acceptance_code = can_id << shift;
+    f_config.acceptance_mask = ((~can_id_mask & width) << shift) | ((1UL << shift) - 1);
+    ESP_LOGD(TAG, "Acceptance filter code=0x%08" PRIx32 " mask=0x%08" PRIx32, f_config.acceptance_code,
+             f_config.acceptance_mask);
+  }
+
   if (!get_bitrate(this->bit_rate_, &t_config)) {
     // invalid bit rate
     this->mark_failed();
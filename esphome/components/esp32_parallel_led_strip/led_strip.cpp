@@ -0,0 +1,245 @@
+#include <cinttypes>
+#include "led_strip.h"
+
+#ifdef USE_ESP_IDF
+
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <esp_heap_caps.h>
+#include <esp_lcd_panel_io.h>
+
+namespace esphome {
+namespace esp32_parallel_led_strip {
+
+static const char *const TAG = "esp32_parallel_led_strip";
+
+/// Every bit is sent as three samples: high, the bit itself and low, so a sample lasts a third of a 1.25µs bit.
+static const uint32_t PCLK_HZ = 2400000;
+static const uint8_t SAMPLES_PER_BIT = 3;
+/// 300µs of low samples after the frame latch it, even on strips that need a long reset.
+static const size_t RESET_SAMPLES = 720;
+
+void ESP32ParallelLEDStripLightOutput::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up ESP32 Parallel LED Strip...");
+
+  const size_t strip_size = this->get_strip_size_();
+  const size_t word_size = this->data_pins_.size() > 8 ? 2 : 1;
+
+  ExternalRAMAllocator<uint8_t> allocator(HeapTag::LIGHT, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  this->buf_ = allocator.allocate(strip_size * this->data_pins_.size());
+  if (this->buf_ == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate LED buffer!");
+    this->mark_failed();
+    return;
+  }
+
+  this->effect_data_ = allocator.allocate(this->size());
+  if (this->effect_data_ == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate effect data!");
+    this->mark_failed();
+    return;
+  }
+
+  // One bus word per sample for all strips' bytes at once, followed by the reset
+  this->dma_size_ = (strip_size * 8 * SAMPLES_PER_BIT + RESET_SAMPLES) * word_size;
+  this->dma_buf_ = static_cast<uint8_t *>(heap_caps_calloc(1, this->dma_size_, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL));
+  if (this->dma_buf_ == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate DMA buffer of %zu bytes!", this->dma_size_);
+    this->mark_failed();
+    return;
+  }
+  // The first sample of every bit is high on all strips and the last low, only the middle one changes per frame
+  for (size_t i = 0; i < strip_size * 8; i++) {
+    if (word_size == 2) {
+      reinterpret_cast<uint16_t *>(this->dma_buf_)[i * SAMPLES_PER_BIT] = 0xFFFF;
+    } else {
+      this->dma_buf_[i * SAMPLES_PER_BIT] = 0xFF;
+    }
+  }
+
+  esp_lcd_i80_bus_config_t bus_config{};
+  bus_config.dc_gpio_num = this->dc_pin_;
+  bus_config.wr_gpio_num = this->clock_pin_;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  bus_config.clk_src = LCD_CLK_SRC_DEFAULT;
+#endif
+  for (size_t i = 0; i < this->data_pins_.size(); i++)
+    bus_config.data_gpio_nums[i] = this->data_pins_[i];
+  bus_config.bus_width = this->data_pins_.size();
+  bus_config.max_transfer_bytes = this->dma_size_;
+  if (esp_lcd_new_i80_bus(&bus_config, &this->bus_) != ESP_OK) {
+    ESP_LOGE(TAG, "Cannot initialize parallel bus!");
+    this->mark_failed();
+    return;
+  }
+
+  esp_lcd_panel_io_i80_config_t io_config{};
+  io_config.cs_gpio_num = -1;
+  io_config.pclk_hz = PCLK_HZ;
+  io_config.trans_queue_depth = 2;
+  io_config.on_color_trans_done = ESP32ParallelLEDStripLightOutput::on_trans_done;
+  io_config.user_ctx = this;
+  // No command phase, the whole transfer is pixel data
+  io_config.lcd_cmd_bits = 0;
+  io_config.lcd_param_bits = 0;
+  io_config.dc_levels.dc_idle_level = 0;
+  io_config.dc_levels.dc_cmd_level = 0;
+  io_config.dc_levels.dc_dummy_level = 0;
+  io_config.dc_levels.dc_data_level = 1;
+  if (esp_lcd_new_panel_io_i80(this->bus_, &io_config, &this->io_) != ESP_OK) {
+    ESP_LOGE(TAG, "Cannot initialize parallel bus IO!");
+    this->mark_failed();
+    return;
+  }
+}
+
+void ESP32ParallelLEDStripLightOutput::write_state(light::LightState *state) {
+  if (this->tx_busy_) {
+    // The previous frame is still being sent, pick up this change next loop iteration
+    this->schedule_show();
+    return;
+  }
+
+  // protect from refreshing too often
+  uint32_t now = micros();
+  if (*this->max_refresh_rate_ != 0 && (now - this->last_refresh_) < *this->max_refresh_rate_) {
+    // try again next loop iteration, so that this change won't get lost
+    this->schedule_show();
+    return;
+  }
+  this->last_refresh_ = now;
+  this->mark_shown_();
+
+  ESP_LOGVV(TAG, "Writing RGB values to bus...");
+
+  if (this->data_pins_.size() > 8) {
+    this->encode_<uint16_t>();
+  } else {
+    this->encode_<uint8_t>();
+  }
+
+  this->tx_busy_ = true;
+  if (esp_lcd_panel_io_tx_color(this->io_, -1, this->dma_buf_, this->dma_size_) != ESP_OK) {
+    ESP_LOGE(TAG, "Parallel bus TX error");
+    this->tx_busy_ = false;
+    this->status_set_warning();
+    return;
+  }
+  this->status_clear_warning();
+}
+
+template<typename T> void ESP32ParallelLEDStripLightOutput::encode_() {
+  const size_t strip_size = this->get_strip_size_();
+  const size_t strips = this->data_pins_.size();
+  T *pdest = reinterpret_cast<T *>(this->dma_buf_) + 1;
+  for (size_t pos = 0; pos < strip_size; pos++) {
+    T words[8] = {0};
+    for (size_t strip = 0; strip < strips; strip++) {
+      uint8_t b = this->buf_[strip * strip_size + pos];
+      for (int i = 0; i < 8; i++)
+        words[i] |= T((b >> (7 - i)) & 1) << strip;
+    }
+    for (int i = 0; i < 8; i++) {
+      *pdest = words[i];
+      pdest += SAMPLES_PER_BIT;
+    }
+  }
+}
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+bool ESP32ParallelLEDStripLightOutput::on_trans_done(esp_lcd_panel_io_handle_t io,
+                                                     esp_lcd_panel_io_event_data_t *edata, void *user_ctx) {
+#else
+bool ESP32ParallelLEDStripLightOutput::on_trans_done(esp_lcd_panel_io_handle_t io, void *user_ctx,
+                                                     void *event_data) {
+#endif
+  static_cast<ESP32ParallelLEDStripLightOutput *>(user_ctx)->tx_busy_ = false;
+  return false;
+}
+
+light::ESPColorView ESP32ParallelLEDStripLightOutput::get_view_internal(int32_t index) const {
+  int32_t r = 0, g = 0, b = 0;
+  switch (this->rgb_order_) {
+    case ORDER_RGB:
+      r = 0;
+      g = 1;
+      b = 2;
+      break;
+    case ORDER_RBG:
+      r = 0;
+      g = 2;
+      b = 1;
+      break;
+    case ORDER_GRB:
+      r = 1;
+      g = 0;
+      b = 2;
+      break;
+    case ORDER_GBR:
+      r = 2;
+      g = 0;
+      b = 1;
+      break;
+    case ORDER_BGR:
+      r = 2;
+      g = 1;
+      b = 0;
+      break;
+    case ORDER_BRG:
+      r = 1;
+      g = 2;
+      b = 0;
+      break;
+  }
+  // The strips are stored one after another, so the LEDs are in buf_ in index order
+  uint8_t multiplier = this->is_rgbw_ ? 4 : 3;
+  return {this->buf_ + (index * multiplier) + r,
+          this->buf_ + (index * multiplier) + g,
+          this->buf_ + (index * multiplier) + b,
+          this->is_rgbw_ ? this->buf_ + (index * multiplier) + 3 : nullptr,
+          &this->effect_data_[index],
+          &this->correction_};
+}
+
+void ESP32ParallelLEDStripLightOutput::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP32 Parallel LED Strip:");
+  for (size_t i = 0; i < this->data_pins_.size(); i++)
+    ESP_LOGCONFIG(TAG, "  Data Pin %zu: %u", i, this->data_pins_[i]);
+  ESP_LOGCONFIG(TAG, "  Clock Pin: %u", this->clock_pin_);
+  ESP_LOGCONFIG(TAG, "  DC Pin: %u", this->dc_pin_);
+  const char *rgb_order;
+  switch (this->rgb_order_) {
+    case ORDER_RGB:
+      rgb_order = "RGB";
+      break;
+    case ORDER_RBG:
+      rgb_order = "RBG";
+      break;
+    case ORDER_GRB:
+      rgb_order = "GRB";
+      break;
+    case ORDER_GBR:
+      rgb_order = "GBR";
+      break;
+    case ORDER_BGR:
+      rgb_order = "BGR";
+      break;
+    case ORDER_BRG:
+      rgb_order = "BRG";
+      break;
+    default:
+      rgb_order = "UNKNOWN";
+      break;
+  }
+  ESP_LOGCONFIG(TAG, "  RGB Order: %s", rgb_order);
+  ESP_LOGCONFIG(TAG, "  Max refresh rate: %" PRIu32, *this->max_refresh_rate_);
+  ESP_LOGCONFIG(TAG, "  LEDs per strip: %u", this->num_leds_);
+}
+
+float ESP32ParallelLEDStripLightOutput::get_setup_priority() const { return setup_priority::HARDWARE; }
+
+}  // namespace esp32_parallel_led_strip
+}  // namespace esphome
+
+#endif  // USE_ESP_IDF
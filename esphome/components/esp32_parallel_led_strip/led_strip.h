@@ -0,0 +1,106 @@
+#pragma once
+
+#ifdef USE_ESP_IDF
+
+#include "esphome/components/light/addressable_light.h"
+#include "esphome/components/light/light_output.h"
+#include "esphome/core/color.h"
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+#include <esp_idf_version.h>
+#include <esp_lcd_panel_io.h>
+
+#include <atomic>
+#include <vector>
+
+namespace esphome {
+namespace esp32_parallel_led_strip {
+
+enum RGBOrder : uint8_t {
+  ORDER_RGB,
+  ORDER_RBG,
+  ORDER_GRB,
+  ORDER_GBR,
+  ORDER_BGR,
+  ORDER_BRG,
+};
+
+/// Drives 8 or 16 WS2812-style strips at once through the I2S/LCD peripheral in 8080 parallel mode.
+///
+/// Every data line carries one strip, the light addresses them one after another: LED `i` of strip `s` is at
+/// index `s * num_leds + i`. Use partition lights to split them up.
+class ESP32ParallelLEDStripLightOutput : public light::AddressableLight {
+ public:
+  void setup() override;
+  void write_state(light::LightState *state) override;
+  float get_setup_priority() const override;
+
+  int32_t size() const override { return this->num_leds_ * this->data_pins_.size(); }
+  light::LightTraits get_traits() override {
+    auto traits = light::LightTraits();
+    if (this->is_rgbw_) {
+      traits.set_supported_color_modes({light::ColorMode::RGB_WHITE, light::ColorMode::WHITE});
+    } else {
+      traits.set_supported_color_modes({light::ColorMode::RGB});
+    }
+    return traits;
+  }
+
+  void set_data_pins(const std::vector<uint8_t> &data_pins) { this->data_pins_ = data_pins; }
+  void set_clock_pin(uint8_t clock_pin) { this->clock_pin_ = clock_pin; }
+  void set_dc_pin(uint8_t dc_pin) { this->dc_pin_ = dc_pin; }
+  /// Set the number of LEDs of each strip.
+  void set_num_leds(uint16_t num_leds) { this->num_leds_ = num_leds; }
+  void set_is_rgbw(bool is_rgbw) { this->is_rgbw_ = is_rgbw; }
+  void set_rgb_order(RGBOrder rgb_order) { this->rgb_order_ = rgb_order; }
+
+  /// Set a maximum refresh rate in µs as some lights do not like being updated too often.
+  void set_max_refresh_rate(uint32_t interval_us) { this->max_refresh_rate_ = interval_us; }
+
+  void clear_effect_data() override {
+    for (int i = 0; i < this->size(); i++)
+      this->effect_data_[i] = 0;
+  }
+
+  void dump_config() override;
+
+ protected:
+  light::ESPColorView get_view_internal(int32_t index) const override;
+
+  /// Bytes of one strip.
+  size_t get_strip_size_() const { return this->num_leds_ * (3 + this->is_rgbw_); }
+  /// Interleave the strips' bits into the DMA buffer, one bus word per sample.
+  template<typename T> void encode_();
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+  static bool on_trans_done(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
+#else
+  static bool on_trans_done(esp_lcd_panel_io_handle_t io, void *user_ctx, void *event_data);
+#endif
+
+  uint8_t *buf_{nullptr};
+  uint8_t *effect_data_{nullptr};
+  uint8_t *dma_buf_{nullptr};
+  size_t dma_size_{0};
+
+  esp_lcd_i80_bus_handle_t bus_{nullptr};
+  esp_lcd_panel_io_handle_t io_{nullptr};
+  /// Set from queueing a frame until the DMA is done reading dma_buf_.
+  std::atomic<bool> tx_busy_{false};
+
+  std::vector<uint8_t> data_pins_;
+  uint8_t clock_pin_;
+  uint8_t dc_pin_;
+  uint16_t num_leds_;
+  bool is_rgbw_;
+  RGBOrder rgb_order_;
+
+  uint32_t last_refresh_{0};
+  optional<uint32_t> max_refresh_rate_{};
+};
+
+}  // namespace esp32_parallel_led_strip
+}  // namespace esphome
+
+#endif  // USE_ESP_IDF
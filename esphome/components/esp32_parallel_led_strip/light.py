@@ -0,0 +1,91 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import pins
+from esphome.components import esp32, light
+from esphome.const import (
+    CONF_CLOCK_PIN,
+    CONF_DATA_PINS,
+    CONF_DC_PIN,
+    CONF_MAX_REFRESH_RATE,
+    CONF_NUM_LEDS,
+    CONF_OUTPUT_ID,
+    CONF_RGB_ORDER,
+)
+
+DEPENDENCIES = ["esp32"]
+
+esp32_parallel_led_strip_ns = cg.esphome_ns.namespace("esp32_parallel_led_strip")
+ESP32ParallelLEDStripLightOutput = esp32_parallel_led_strip_ns.class_(
+    "ESP32ParallelLEDStripLightOutput", light.AddressableLight
+)
+
+RGBOrder = esp32_parallel_led_strip_ns.enum("RGBOrder")
+
+RGB_ORDERS = {
+    "RGB": RGBOrder.ORDER_RGB,
+    "RBG": RGBOrder.ORDER_RBG,
+    "GRB": RGBOrder.ORDER_GRB,
+    "GBR": RGBOrder.ORDER_GBR,
+    "BGR": RGBOrder.ORDER_BGR,
+    "BRG": RGBOrder.ORDER_BRG,
+}
+
+CONF_IS_RGBW = "is_rgbw"
+
+
+def _validate_data_pins(value):
+    # The parallel bus is either 8 or 16 bits wide and every data line must be connected
+    if len(value) not in (8, 16):
+        raise cv.Invalid(
+            f"Exactly 8 or 16 data pins are required, got {len(value)}. "
+            "Leave the data lines of missing strips unconnected."
+        )
+    if len(set(value)) != len(value):
+        raise cv.Invalid("Data pins must be unique")
+    return value
+
+
+CONFIG_SCHEMA = cv.All(
+    light.ADDRESSABLE_LIGHT_SCHEMA.extend(
+        {
+            cv.GenerateID(CONF_OUTPUT_ID): cv.declare_id(
+                ESP32ParallelLEDStripLightOutput
+            ),
+            cv.Required(CONF_DATA_PINS): cv.All(
+                cv.ensure_list(pins.internal_gpio_output_pin_number),
+                _validate_data_pins,
+            ),
+            cv.Required(CONF_CLOCK_PIN): pins.internal_gpio_output_pin_number,
+            cv.Required(CONF_DC_PIN): pins.internal_gpio_output_pin_number,
+            cv.Required(CONF_NUM_LEDS): cv.positive_not_null_int,
+            cv.Required(CONF_RGB_ORDER): cv.enum(RGB_ORDERS, upper=True),
+            cv.Optional(CONF_MAX_REFRESH_RATE): cv.positive_time_period_microseconds,
+            cv.Optional(CONF_IS_RGBW, default=False): cv.boolean,
+        }
+    ),
+    cv.only_with_esp_idf,
+    esp32.only_on_variant(
+        supported=[
+            esp32.const.VARIANT_ESP32,
+            esp32.const.VARIANT_ESP32S2,
+            esp32.const.VARIANT_ESP32S3,
+        ]
+    ),
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_OUTPUT_ID])
+    await light.register_light(var, config)
+    await cg.register_component(var, config)
+
+    cg.add(var.set_data_pins(config[CONF_DATA_PINS]))
+    cg.add(var.set_clock_pin(config[CONF_CLOCK_PIN]))
+    cg.add(var.set_dc_pin(config[CONF_DC_PIN]))
+    cg.add(var.set_num_leds(config[CONF_NUM_LEDS]))
+
+    if CONF_MAX_REFRESH_RATE in config:
+        cg.add(var.set_max_refresh_rate(config[CONF_MAX_REFRESH_RATE]))
+
+    cg.add(var.set_rgb_order(config[CONF_RGB_ORDER]))
+    cg.add(var.set_is_rgbw(config[CONF_IS_RGBW]))
@@ -20,7 +20,7 @@ void ESP32RMTLEDStripLightOutput::setup() {
 
   size_t buffer_size = this->get_buffer_size_();
 
-  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  ExternalRAMAllocator<uint8_t> allocator(HeapTag::LIGHT, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   this->buf_ = allocator.allocate(buffer_size);
   if (this->buf_ == nullptr) {
     ESP_LOGE(TAG, "Cannot allocate LED buffer!");
@@ -35,8 +35,22 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 
-  ExternalRAMAllocator<rmt_item32_t> rmt_allocator(ExternalRAMAllocator<rmt_item32_t>::ALLOW_FAILURE);
-  this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8);  // 8 bits per byte, 1 rmt_item32_t per bit
+  this->frame_buf_ = allocator.allocate(buffer_size);
+  if (this->frame_buf_ == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate frame buffer!");
+    this->mark_failed();
+    return;
+  }
+
+  if (!this->stream_encoding_) {
+    ExternalRAMAllocator<rmt_item32_t> rmt_allocator(HeapTag::LIGHT, ExternalRAMAllocator<rmt_item32_t>::ALLOW_FAILURE);
+    this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8);  // 8 bits per byte, 1 rmt_item32_t per bit
+    if (this->rmt_buf_ == nullptr) {
+      ESP_LOGE(TAG, "Cannot allocate RMT buffer!");
+      this->mark_failed();
+      return;
+    }
+  }
 
   rmt_config_t config;
   memset(&config, 0, sizeof(config));
@@ -61,6 +75,29 @@ void ESP32RMTLEDStripLightOutput::setup() {
     this->mark_failed();
     return;
   }
+  if (this->stream_encoding_) {
+    if (rmt_translator_init(config.channel, ESP32RMTLEDStripLightOutput::rmt_translate) != ESP_OK ||
+        rmt_translator_set_context(config.channel, this) != ESP_OK) {
+      ESP_LOGE(TAG, "Cannot initialize RMT translator!");
+      this->mark_failed();
+      return;
+    }
+  }
+
+  if (this->async_write_) {
+#if portNUM_PROCESSORS > 1
+    // Keep the encoding away from the core running the main loop
+    const BaseType_t core = 1 - xPortGetCoreID();
+#else
+    const BaseType_t core = tskNO_AFFINITY;
+#endif
+    if (xTaskCreatePinnedToCore(ESP32RMTLEDStripLightOutput::write_task, "led_strip", 2048, this, 1,
+                                &this->write_task_handle_, core) != pdPASS) {
+      ESP_LOGE(TAG, "Cannot create write task!");
+      this->mark_failed();
+      return;
+    }
+  }
 }
 
 void ESP32RMTLEDStripLightOutput::set_led_params(uint32_t bit0_high, uint32_t bit0_low, uint32_t bit1_high,
@@ -80,6 +117,33 @@ void ESP32RMTLEDStripLightOutput::set_led_params(uint32_t bit0_high, uint32_t bi
 }
 
 void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
+  if (this->frame_pending_) {
+    // The write task is still sending the previous frame, pick up this change next loop iteration
+    this->schedule_show();
+    return;
+  }
+
+  const bool frame_error = this->frame_error_.exchange(false);
+  if (frame_error) {
+    ESP_LOGE(TAG, "RMT TX error");
+    this->status_set_warning();
+    // The strip may not have received the last frame, send all of the next one
+    this->frame_sent_ = false;
+  }
+
+  // Find the bytes that changed since the last frame, skip the frame entirely if nothing did
+  const size_t buffer_size = this->get_buffer_size_();
+  size_t begin = 0;
+  size_t end = buffer_size;
+  if (this->frame_sent_) {
+    while (begin < end && this->buf_[begin] == this->frame_buf_[begin])
+      begin++;
+    if (begin == end)
+      return;
+    while (this->buf_[end - 1] == this->frame_buf_[end - 1])
+      end--;
+  }
+
   // protect from refreshing too often
   uint32_t now = micros();
   if (*this->max_refresh_rate_ != 0 && (now - this->last_refresh_) < *this->max_refresh_rate_) {
@@ -92,6 +156,19 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
 
   ESP_LOGVV(TAG, "Writing RGB values to bus...");
 
+  if (this->async_write_) {
+    // Hand a snapshot to the write task, so effects rendering the next frame can't tear this one
+    memcpy(this->frame_buf_ + begin, this->buf_ + begin, end - begin);
+    this->frame_sent_ = true;
+    this->dirty_begin_ = begin;
+    this->dirty_end_ = end;
+    this->frame_pending_ = true;
+    xTaskNotifyGive(this->write_task_handle_);
+    if (!frame_error)
+      this->status_clear_warning();
+    return;
+  }
+
   if (rmt_wait_tx_done(this->channel_, pdMS_TO_TICKS(1000)) != ESP_OK) {
     ESP_LOGE(TAG, "RMT TX timeout");
     this->status_set_warning();
@@ -99,29 +176,80 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
   }
   delayMicroseconds(50);
 
-  size_t buffer_size = this->get_buffer_size_();
+  memcpy(this->frame_buf_ + begin, this->buf_ + begin, end - begin);
+  this->frame_sent_ = true;
+  if (!this->stream_encoding_)
+    this->encode_(begin, end);
+  if (this->transmit_(false) != ESP_OK) {
+    ESP_LOGE(TAG, "RMT TX error");
+    this->status_set_warning();
+    this->frame_sent_ = false;
+    return;
+  }
+  this->status_clear_warning();
+}
 
-  size_t size = 0;
-  size_t len = 0;
-  uint8_t *psrc = this->buf_;
-  rmt_item32_t *pdest = this->rmt_buf_;
-  while (size < buffer_size) {
+void ESP32RMTLEDStripLightOutput::encode_(size_t begin, size_t end) {
+  // The RMT items of the other bytes still hold the previous frame
+  const uint8_t *psrc = this->frame_buf_ + begin;
+  rmt_item32_t *pdest = this->rmt_buf_ + begin * 8;
+  for (size_t size = begin; size < end; size++) {
     uint8_t b = *psrc;
     for (int i = 0; i < 8; i++) {
       pdest->val = b & (1 << (7 - i)) ? this->bit1_.val : this->bit0_.val;
       pdest++;
-      len++;
     }
-    size++;
     psrc++;
   }
+}
 
-  if (rmt_write_items(this->channel_, this->rmt_buf_, len, false) != ESP_OK) {
-    ESP_LOGE(TAG, "RMT TX error");
-    this->status_set_warning();
+esp_err_t ESP32RMTLEDStripLightOutput::transmit_(bool wait_tx_done) {
+  // frame_buf_ isn't touched again before the transmission is done, so the translator can read from it directly
+  if (this->stream_encoding_)
+    return rmt_write_sample(this->channel_, this->frame_buf_, this->get_buffer_size_(), wait_tx_done);
+  return rmt_write_items(this->channel_, this->rmt_buf_, this->get_buffer_size_() * 8, wait_tx_done);
+}
+
+void IRAM_ATTR ESP32RMTLEDStripLightOutput::rmt_translate(const void *src, rmt_item32_t *dest, size_t src_size,
+                                                          size_t wanted_num, size_t *translated_size,
+                                                          size_t *item_num) {
+  // Runs in the RMT interrupt each time the channel memory needs refilling
+  ESP32RMTLEDStripLightOutput *light;
+  if (src == nullptr || dest == nullptr || rmt_translator_get_context(item_num, (void **) &light) != ESP_OK) {
+    *translated_size = 0;
+    *item_num = 0;
     return;
   }
-  this->status_clear_warning();
+  const uint32_t bit0 = light->bit0_.val;
+  const uint32_t bit1 = light->bit1_.val;
+  const uint8_t *psrc = static_cast<const uint8_t *>(src);
+  size_t size = 0;
+  size_t num = 0;
+  while (size < src_size && num + 8 <= wanted_num) {
+    uint8_t b = psrc[size++];
+    for (int i = 0; i < 8; i++) {
+      dest->val = b & (1 << (7 - i)) ? bit1 : bit0;
+      dest++;
+    }
+    num += 8;
+  }
+  *translated_size = size;
+  *item_num = num;
+}
+
+void ESP32RMTLEDStripLightOutput::write_task(void *param) {
+  auto *light = static_cast<ESP32RMTLEDStripLightOutput *>(param);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (!light->stream_encoding_)
+      light->encode_(light->dirty_begin_, light->dirty_end_);
+    // Blocks until the strip has received the whole frame
+    if (light->transmit_(true) != ESP_OK)
+      light->frame_error_ = true;
+    // Reset time so the strip latches the frame before the next one starts
+    delayMicroseconds(50);
+    light->frame_pending_ = false;
+  }
 }
 
 light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
@@ -198,6 +326,8 @@ void ESP32RMTLEDStripLightOutput::dump_config() {
   ESP_LOGCONFIG(TAG, "  RGB Order: %s", rgb_order);
   ESP_LOGCONFIG(TAG, "  Max refresh rate: %" PRIu32, *this->max_refresh_rate_);
   ESP_LOGCONFIG(TAG, "  Number of LEDs: %u", this->num_leds_);
+  ESP_LOGCONFIG(TAG, "  Async Write: %s", YESNO(this->async_write_));
+  ESP_LOGCONFIG(TAG, "  Stream Encoding: %s", YESNO(this->stream_encoding_));
 }
 
 float ESP32RMTLEDStripLightOutput::get_setup_priority() const { return setup_priority::HARDWARE; }
@@ -11,6 +11,10 @@
 #include <driver/gpio.h>
 #include <driver/rmt.h>
 #include <esp_err.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
 
 namespace esphome {
 namespace esp32_rmt_led_strip {
@@ -52,6 +56,10 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
 
   void set_rgb_order(RGBOrder rgb_order) { this->rgb_order_ = rgb_order; }
   void set_rmt_channel(rmt_channel_t channel) { this->channel_ = channel; }
+  /// Encode and transmit frames in a task on the other core, so the main loop doesn't wait for the strip.
+  void set_async_write(bool async_write) { this->async_write_ = async_write; }
+  /// Convert the pixel bytes to RMT items while transmitting instead of keeping a buffer of 32 bytes per pixel byte.
+  void set_stream_encoding(bool stream_encoding) { this->stream_encoding_ = stream_encoding; }
 
   void clear_effect_data() override {
     for (int i = 0; i < this->size(); i++)
@@ -64,11 +72,32 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
   light::ESPColorView get_view_internal(int32_t index) const override;
 
   size_t get_buffer_size_() const { return this->num_leds_ * (3 + this->is_rgbw_); }
+  /// Encode bytes \p begin to \p end of frame_buf_ into their RMT items.
+  void encode_(size_t begin, size_t end);
+  /// Transmit frame_buf_, waiting for the strip to receive it if \p wait_tx_done is set.
+  esp_err_t transmit_(bool wait_tx_done);
+  static void write_task(void *param);
+  static void rmt_translate(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num,
+                            size_t *translated_size, size_t *item_num);
 
   uint8_t *buf_{nullptr};
   uint8_t *effect_data_{nullptr};
   rmt_item32_t *rmt_buf_{nullptr};
 
+  /// Copy of the last frame handed to the RMT, to find the bytes that changed since.
+  uint8_t *frame_buf_{nullptr};
+  bool frame_sent_{false};
+
+  bool stream_encoding_{false};
+  bool async_write_{false};
+  TaskHandle_t write_task_handle_{nullptr};
+  /// Bytes of frame_buf_ the write task has to encode.
+  size_t dirty_begin_{0};
+  size_t dirty_end_{0};
+  /// Set while the write task owns frame_buf_ and rmt_buf_.
+  std::atomic<bool> frame_pending_{false};
+  std::atomic<bool> frame_error_{false};
+
   uint8_t pin_;
   uint16_t num_leds_;
   bool is_rgbw_;
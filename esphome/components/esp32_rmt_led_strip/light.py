@@ -57,6 +57,8 @@ CONF_BIT0_LOW = "bit0_low"
 CONF_BIT1_HIGH = "bit1_high"
 CONF_BIT1_LOW = "bit1_low"
 CONF_RMT_CHANNEL = "rmt_channel"
+CONF_ASYNC_WRITE = "async_write"
+CONF_STREAM_ENCODING = "stream_encoding"
 
 RMT_CHANNELS = {
     esp32.const.VARIANT_ESP32: [0, 1, 2, 3, 4, 5, 6, 7],
@@ -89,6 +91,8 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_MAX_REFRESH_RATE): cv.positive_time_period_microseconds,
             cv.Optional(CONF_CHIPSET): cv.one_of(*CHIPSETS, upper=True),
             cv.Optional(CONF_IS_RGBW, default=False): cv.boolean,
+            cv.Optional(CONF_ASYNC_WRITE, default=False): cv.boolean,
+            cv.Optional(CONF_STREAM_ENCODING, default=False): cv.boolean,
             cv.Inclusive(
                 CONF_BIT0_HIGH,
                 "custom",
@@ -144,6 +148,8 @@ async def to_code(config):
 
     cg.add(var.set_rgb_order(config[CONF_RGB_ORDER]))
     cg.add(var.set_is_rgbw(config[CONF_IS_RGBW]))
+    cg.add(var.set_async_write(config[CONF_ASYNC_WRITE]))
+    cg.add(var.set_stream_encoding(config[CONF_STREAM_ENCODING]))
 
     cg.add(
         var.set_rmt_channel(
@@ -4,6 +4,7 @@ from esphome.const import (
     CONF_HIGH_VOLTAGE_REFERENCE,
     CONF_ID,
     CONF_IIR_FILTER,
+    CONF_INTERRUPT,
     CONF_LOW_VOLTAGE_REFERENCE,
     CONF_MEASUREMENT_DURATION,
     CONF_SETUP_MODE,
@@ -204,6 +205,7 @@ CONFIG_SCHEMA = cv.All(
         {
             cv.GenerateID(): cv.declare_id(ESP32TouchComponent),
             cv.Optional(CONF_SETUP_MODE, default=False): cv.boolean,
+            cv.Optional(CONF_INTERRUPT, default=False): cv.boolean,
             # common options
             cv.Optional(CONF_SLEEP_DURATION, default="27306us"): cv.All(
                 cv.positive_time_period, cv.Range(max=TimePeriod(microseconds=436906))
@@ -269,6 +271,7 @@ async def to_code(config):
     await cg.register_component(touch, config)
 
     cg.add(touch.set_setup_mode(config[CONF_SETUP_MODE]))
+    cg.add(touch.set_interrupt(config[CONF_INTERRUPT]))
 
     sleep_duration = int(round(config[CONF_SLEEP_DURATION].total_microseconds * 0.15))
     cg.add(touch.set_sleep_duration(sleep_duration))
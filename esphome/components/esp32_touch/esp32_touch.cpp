@@ -12,6 +12,12 @@ namespace esp32_touch {
 
 static const char *const TAG = "esp32_touch";
 
+#if defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3)
+// Interrupts when a pad gets touched and when it is released
+static const touch_pad_intr_mask_t TOUCH_INTR_MASK =
+    static_cast<touch_pad_intr_mask_t>(TOUCH_PAD_INTR_MASK_ACTIVE | TOUCH_PAD_INTR_MASK_INACTIVE);
+#endif
+
 void ESP32TouchComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 Touch Hub...");
   touch_pad_init();
@@ -59,16 +65,58 @@ void ESP32TouchComponent::setup() {
 #if defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3)
     touch_pad_config(child->get_touch_pad());
 #else
-    // Disable interrupt threshold
-    touch_pad_config(child->get_touch_pad(), 0);
+    // The interrupt triggers while the raw value is below the threshold, 0 disables it
+    touch_pad_config(child->get_touch_pad(), this->interrupt_ ? child->get_threshold() : 0);
 #endif
   }
 #if defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3)
   touch_pad_set_fsm_mode(TOUCH_FSM_MODE_TIMER);
   touch_pad_fsm_start();
+  if (this->interrupt_) {
+    touch_pad_isr_register(ESP32TouchComponent::touch_isr_, this, TOUCH_INTR_MASK);
+  }
+#else
+  if (this->interrupt_) {
+    touch_pad_isr_register(ESP32TouchComponent::touch_isr_, this);
+    touch_pad_intr_enable();
+    this->interrupt_enabled_ = true;
+  }
 #endif
 }
 
+void IRAM_ATTR ESP32TouchComponent::touch_isr_(void *arg) {
+  auto *component = static_cast<ESP32TouchComponent *>(arg);
+#if defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3)
+  touch_pad_read_intr_status_mask();
+#else
+  touch_pad_clear_status();
+#endif
+  component->interrupt_pending_ = true;
+}
+
+#if defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3)
+void ESP32TouchComponent::configure_interrupt_thresholds_() {
+  for (auto *child : this->children_) {
+    uint32_t benchmark = 0;
+    touch_pad_read_benchmark(child->get_touch_pad(), &benchmark);
+    if (benchmark == 0) {
+      // First measurement isn't done yet, try again in the next loop
+      return;
+    }
+  }
+  for (auto *child : this->children_) {
+    uint32_t benchmark = 0;
+    touch_pad_read_benchmark(child->get_touch_pad(), &benchmark);
+    uint32_t threshold = child->get_threshold() > benchmark ? child->get_threshold() - benchmark : 1;
+    touch_pad_set_thresh(child->get_touch_pad(), threshold);
+    ESP_LOGV(TAG, "Touch Pad T%" PRIu32 ": benchmark %" PRIu32 ", interrupt threshold %" PRIu32,
+             (uint32_t) child->get_touch_pad(), benchmark, threshold);
+  }
+  touch_pad_intr_enable(TOUCH_INTR_MASK);
+  this->interrupt_enabled_ = true;
+}
+#endif
+
 void ESP32TouchComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Config for ESP32 Touch Hub:");
   ESP_LOGCONFIG(TAG, "  Meas cycle: %.2fms", this->meas_cycle_ / (8000000.0f / 1000.0f));
@@ -255,6 +303,9 @@ void ESP32TouchComponent::dump_config() {
   if (this->setup_mode_) {
     ESP_LOGCONFIG(TAG, "  Setup Mode ENABLED");
   }
+  if (this->interrupt_) {
+    ESP_LOGCONFIG(TAG, "  Interrupt Mode ENABLED");
+  }
 
   for (auto *child : this->children_) {
     LOG_BINARY_SENSOR("  ", "Touch Pad", child);
@@ -285,13 +336,27 @@ uint32_t ESP32TouchComponent::component_touch_pad_read(touch_pad_t tp) {
 void ESP32TouchComponent::loop() {
   const uint32_t now = millis();
   bool should_print = this->setup_mode_ && now - this->setup_mode_last_log_print_ > 250;
+#if defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3)
+  if (this->interrupt_ && !this->interrupt_enabled_)
+    this->configure_interrupt_thresholds_();
+#endif
+  if (this->interrupt_enabled_ && !this->setup_mode_) {
+    // Nothing can have changed when no pad was touched and no interrupt came in since the last read
+    if (!this->interrupt_pending_ && !this->any_touched_)
+      return;
+    this->interrupt_pending_ = false;
+  }
+
+  bool any_touched = false;
   for (auto *child : this->children_) {
     child->value_ = this->component_touch_pad_read(child->get_touch_pad());
 #if !(defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3))
-    child->publish_state(child->value_ < child->get_threshold());
+    bool touched = child->value_ < child->get_threshold();
 #else
-    child->publish_state(child->value_ > child->get_threshold());
+    bool touched = child->value_ > child->get_threshold();
 #endif
+    child->publish_state(touched);
+    any_touched |= touched;
 
     if (should_print) {
       ESP_LOGD(TAG, "Touch Pad '%s' (T%" PRIu32 "): %" PRIu32, child->get_name().c_str(),
@@ -300,6 +365,7 @@ void ESP32TouchComponent::loop() {
 
     App.feed_wdt();
   }
+  this->any_touched_ = any_touched;
 
   if (should_print) {
     // Avoid spamming logs
@@ -310,6 +376,16 @@ void ESP32TouchComponent::loop() {
 void ESP32TouchComponent::on_shutdown() {
   bool is_wakeup_source = false;
 
+  if (this->interrupt_enabled_) {
+#if defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3)
+    touch_pad_intr_disable(TOUCH_INTR_MASK);
+#else
+    touch_pad_intr_disable();
+#endif
+    touch_pad_isr_deregister(ESP32TouchComponent::touch_isr_, this);
+    this->interrupt_enabled_ = false;
+  }
+
 #if !(defined(USE_ESP32_VARIANT_ESP32S2) || defined(USE_ESP32_VARIANT_ESP32S3))
   if (this->iir_filter_enabled_()) {
     touch_pad_filter_stop();
@@ -20,6 +20,7 @@ class ESP32TouchComponent : public Component {
   void register_touch_pad(ESP32TouchBinarySensor *pad) { this->children_.push_back(pad); }
 
   void set_setup_mode(bool setup_mode) { this->setup_mode_ = setup_mode; }
+  void set_interrupt(bool interrupt) { this->interrupt_ = interrupt; }
   void set_sleep_duration(uint16_t sleep_duration) { this->sleep_cycle_ = sleep_duration; }
   void set_measurement_duration(uint16_t meas_cycle) { this->meas_cycle_ = meas_cycle; }
   void set_low_voltage_reference(touch_low_volt_t low_voltage_reference) {
@@ -68,12 +69,21 @@ class ESP32TouchComponent : public Component {
     return (this->waterproof_guard_ring_pad_ != TOUCH_PAD_MAX) &&
            (this->waterproof_shield_driver_ != TOUCH_PAD_SHIELD_DRV_MAX);
   }
+  /// Hardware thresholds are relative to the benchmark on these variants, so they can only be set after it is known.
+  void configure_interrupt_thresholds_();
 #else
   bool iir_filter_enabled_() const { return this->iir_filter_ > 0; }
 #endif
 
+  static void touch_isr_(void *arg);
+
   std::vector<ESP32TouchBinarySensor *> children_;
   bool setup_mode_{false};
+  /// Only read the pads after a threshold interrupt, or while one of them is touched to catch its release.
+  bool interrupt_{false};
+  bool interrupt_enabled_{false};
+  volatile bool interrupt_pending_{false};
+  bool any_touched_{false};
   uint32_t setup_mode_last_log_print_{0};
   // common parameters
   uint16_t sleep_cycle_{4095};
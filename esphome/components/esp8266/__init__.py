@@ -20,6 +20,7 @@ from esphome.helpers import copy_file_if_changed
 from .const import (
     CONF_RESTORE_FROM_FLASH,
     CONF_EARLY_PIN_INIT,
+    CONF_PREFERENCES_SECTORS,
     KEY_BOARD,
     KEY_ESP8266,
     KEY_FLASH_SIZE,
@@ -161,6 +162,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_BOARD): cv.string_strict,
             cv.Optional(CONF_FRAMEWORK, default={}): ARDUINO_FRAMEWORK_SCHEMA,
             cv.Optional(CONF_RESTORE_FROM_FLASH, default=False): cv.boolean,
+            cv.Optional(CONF_PREFERENCES_SECTORS, default=2): cv.int_range(
+                min=1, max=16
+            ),
             cv.Optional(CONF_EARLY_PIN_INIT, default=True): cv.boolean,
             cv.Optional(CONF_BOARD_FLASH_MODE, default="dout"): cv.one_of(
                 *BUILD_FLASH_MODES, lower=True
@@ -210,6 +214,7 @@ async def to_code(config):
 
     if config[CONF_RESTORE_FROM_FLASH]:
         cg.add_define("USE_ESP8266_PREFERENCES_FLASH")
+    cg.add_define("USE_ESP8266_PREFERENCES_SECTORS", config[CONF_PREFERENCES_SECTORS])
 
     if config[CONF_EARLY_PIN_INIT]:
         cg.add_define("USE_ESP8266_EARLY_PIN_INIT")
@@ -78,6 +78,12 @@ std::string ESP8266GPIOPin::dump_summary() const {
 bool ESP8266GPIOPin::digital_read() {
   return bool(digitalRead(pin_)) != inverted_;  // NOLINT
 }
+FastGPIOPin ESP8266GPIOPin::to_fast() {
+  // GPIO16 is in the RTC block and doesn't have set and clear registers
+  if (pin_ >= 16)
+    return FastGPIOPin(this);
+  return FastGPIOPin(&GPOS, &GPOC, &GPI, 1UL << pin_, inverted_);
+}
 void ESP8266GPIOPin::digital_write(bool value) {
   digitalWrite(pin_, value != inverted_ ? 1 : 0);  // NOLINT
 }
@@ -21,6 +21,7 @@ class ESP8266GPIOPin : public InternalGPIOPin {
   std::string dump_summary() const override;
   void detach_interrupt() const override;
   ISRInternalGPIOPin to_isr() const override;
+  FastGPIOPin to_fast() override;
   uint8_t get_pin() const override { return pin_; }
   bool is_inverted() const override { return inverted_; }
 
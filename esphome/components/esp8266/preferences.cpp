@@ -11,6 +11,7 @@ extern "C" {
 #include "esphome/core/preferences.h"
 #include "preferences.h"
 
+#include <algorithm>
 #include <cstring>
 #include <vector>
 
@@ -34,6 +35,43 @@ static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 128;
 static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 64;
 #endif
 
+/*
+ * The flash preferences are kept in RAM in s_flash_storage and stored in flash as a log. Every sync() appends a
+ * record for each run of changed words to the active sector: a header word with the offset and length in words, the
+ * words and a CRC. Such an append only programs erased flash, so a save costs a small write instead of a sector erase.
+ * On boot the records of the active sector are replayed over an empty image, up to the first erased header or the
+ * first record with a bad CRC, which is where power was lost during a write.
+ *
+ * Once the active sector is full, the whole image is compacted into a single record at the start of the next sector,
+ * which then becomes the active one. Its header, a magic word and a sequence number, is programmed last, so a
+ * compaction that is cut short leaves the previous sector active. The sectors other than the one the framework
+ * reserves are taken from the end of the (otherwise unused) filesystem area right below it, and the erases go round
+ * them. Without a filesystem area, or with preferences_sectors set to 1, there is only one sector: compacting then
+ * erases the only copy before writing it again, and a power cut in between loses the preferences, as a plain
+ * rewrite of the image would.
+ */
+#ifdef USE_ESP8266_PREFERENCES_SECTORS
+static const uint32_t MAX_PREFERENCES_SECTORS = USE_ESP8266_PREFERENCES_SECTORS;
+#else
+static const uint32_t MAX_PREFERENCES_SECTORS = 2;
+#endif
+static const uint32_t PREFERENCES_MAGIC = 0x50524546;  // "PREF"
+static const uint32_t SECTOR_SIZE_WORDS = SPI_FLASH_SEC_SIZE / 4;
+static const uint32_t SECTOR_HEADER_WORDS = 2;
+static const uint32_t ERASED_WORD = 0xFFFFFFFF;
+/// Header and CRC around the words of every record.
+static const uint32_t RECORD_OVERHEAD_WORDS = 2;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t s_sector_count = 1;
+static uint32_t s_active_sector = 0;
+static uint32_t s_sequence = 0;
+/// Where the next record goes in the active sector, in words. 0 when the next sync() has to compact.
+static uint32_t s_write_offset = 0;
+/// Words of s_flash_storage changed since the last sync().
+static uint32_t s_flash_dirty_words[(ESP8266_FLASH_STORAGE_SIZE + 31) / 32] = {};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
 static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -55,17 +93,22 @@ static inline bool esp_rtc_user_mem_write(uint32_t index, uint32_t value) {
   return true;
 }
 
-extern "C" uint32_t _SPIFFS_end;  // NOLINT
+extern "C" uint32_t _SPIFFS_start;  // NOLINT
+extern "C" uint32_t _SPIFFS_end;    // NOLINT
 
-static uint32_t get_esp8266_flash_sector() {
+static uint32_t get_flash_sector_of(uint32_t *symbol) {
   union {
     uint32_t *ptr;
     uint32_t uint;
   } data{};
-  data.ptr = &_SPIFFS_end;
+  data.ptr = symbol;
   return (data.uint - 0x40200000) / SPI_FLASH_SEC_SIZE;
 }
+static uint32_t get_esp8266_flash_sector() { return get_flash_sector_of(&_SPIFFS_end); }
 static uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
+/// The preferences sector reserved by the framework is the first one, the others lie right below it.
+static uint32_t get_preferences_sector(uint32_t index) { return get_esp8266_flash_sector() - index; }
+static uint32_t get_preferences_address(uint32_t index) { return get_preferences_sector(index) * SPI_FLASH_SEC_SIZE; }
 
 template<class It> uint32_t calculate_crc(It first, It last, uint32_t type) {
   uint32_t crc = type;
@@ -82,8 +125,10 @@ static bool save_to_flash(size_t offset, const uint32_t *data, size_t len) {
       return false;
     uint32_t v = data[i];
     uint32_t *ptr = &s_flash_storage[j];
-    if (*ptr != v)
+    if (*ptr != v) {
       s_flash_dirty = true;
+      s_flash_dirty_words[j / 32] |= 1UL << (j % 32);
+    }
     *ptr = v;
   }
   return true;
@@ -99,6 +144,41 @@ static bool load_from_flash(size_t offset, uint32_t *data, size_t len) {
   return true;
 }
 
+static bool is_word_dirty(uint32_t index) { return s_flash_dirty_words[index / 32] & (1UL << (index % 32)); }
+
+/// Append a record of the words [offset, offset + len) of the image to buffer.
+static void append_record(std::vector<uint32_t> &buffer, uint32_t offset, uint32_t len) {
+  const uint32_t header = (offset << 16) | len;
+  buffer.push_back(header);
+  buffer.insert(buffer.end(), s_flash_storage + offset, s_flash_storage + offset + len);
+  buffer.push_back(calculate_crc(s_flash_storage + offset, s_flash_storage + offset + len, header));
+}
+
+/// Replay the records of a sector over the image, returns the offset after the last one or 0 if one is damaged.
+static uint32_t replay_sector(uint32_t index) {
+  const uint32_t address = get_preferences_address(index);
+  std::vector<uint32_t> record(ESP8266_FLASH_STORAGE_SIZE + 1);
+  uint32_t offset = SECTOR_HEADER_WORDS;
+  while (offset < SECTOR_SIZE_WORDS) {
+    uint32_t header;
+    spi_flash_read(address + offset * 4, &header, 4);
+    if (header == ERASED_WORD)
+      return offset;
+    const uint32_t start = header >> 16;
+    const uint32_t len = header & 0xFFFF;
+    if (len == 0 || start + len > ESP8266_FLASH_STORAGE_SIZE ||
+        offset + len + RECORD_OVERHEAD_WORDS > SECTOR_SIZE_WORDS)
+      break;
+    spi_flash_read(address + (offset + 1) * 4, record.data(), (len + 1) * 4);
+    if (record[len] != calculate_crc(record.begin(), record.begin() + len, header))
+      break;
+    memcpy(s_flash_storage + start, record.data(), len * 4);
+    offset += len + RECORD_OVERHEAD_WORDS;
+  }
+  // A torn or corrupt record, nothing can be appended after it
+  return 0;
+}
+
 static bool save_to_rtc(size_t offset, const uint32_t *data, size_t len) {
   for (uint32_t i = 0; i < len; i++) {
     if (!esp_rtc_user_mem_write(offset + i, data[i]))
@@ -171,10 +251,32 @@ class ESP8266Preferences : public ESPPreferences {
     s_flash_storage = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];  // NOLINT
     ESP_LOGVV(TAG, "Loading preferences from flash...");
 
+    const uint32_t fs_sectors = get_esp8266_flash_sector() - get_flash_sector_of(&_SPIFFS_start);
+    s_sector_count = std::min(MAX_PREFERENCES_SECTORS, fs_sectors + 1);
+
+    bool found = false;
     {
       InterruptLock lock;
-      spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+      for (uint32_t i = 0; i < s_sector_count; i++) {
+        uint32_t header[SECTOR_HEADER_WORDS];
+        spi_flash_read(get_preferences_address(i), header, sizeof(header));
+        if (header[0] == PREFERENCES_MAGIC && (!found || int32_t(header[1] - s_sequence) > 0)) {
+          found = true;
+          s_active_sector = i;
+          s_sequence = header[1];
+        }
+      }
+      if (found) {
+        memset(s_flash_storage, 0, ESP8266_FLASH_STORAGE_SIZE * 4);
+        s_write_offset = replay_sector(s_active_sector);
+      } else {
+        // Not written as a log yet, the sector holds the plain image, the first sync() turns it into a log
+        spi_flash_read(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+        s_write_offset = 0;
+      }
     }
+    if (found && s_write_offset == 0)
+      ESP_LOGW(TAG, "Preferences in flash sector %u are damaged, keeping what could be read", s_active_sector);
   }
 
   ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
@@ -206,8 +308,9 @@ class ESP8266Preferences : public ESPPreferences {
     }
 
     if (end > 128) {
-      // Doesn't fit in data, return uninitialized preference obj.
-      return {};
+      // Doesn't fit in RTC memory, flash is better than losing the value
+      ESP_LOGW(TAG, "RTC memory is full, storing preference 0x%08X in flash instead", type);
+      return make_preference(length, type, true);
     }
 
     uint32_t rtc_offset = in_normal ? start + 32 : start - 96;
@@ -235,34 +338,54 @@ class ESP8266Preferences : public ESPPreferences {
     if (s_prevent_write)
       return false;
 
-    ESP_LOGD(TAG, "Saving preferences to flash...");
-    SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
-    {
-      InterruptLock lock;
-      erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
-      if (erase_res == SPI_FLASH_RESULT_OK) {
-        write_res = spi_flash_write(get_esp8266_flash_address(), s_flash_storage, ESP8266_FLASH_STORAGE_SIZE * 4);
+    // All changed runs of words go out in a single write
+    std::vector<uint32_t> records;
+    for (uint32_t i = 0; i < ESP8266_FLASH_STORAGE_SIZE;) {
+      if (!is_word_dirty(i)) {
+        i++;
+        continue;
       }
+      uint32_t end = i + 1;
+      while (end < ESP8266_FLASH_STORAGE_SIZE && is_word_dirty(end))
+        end++;
+      append_record(records, i, end - i);
+      i = end;
     }
-    if (erase_res != SPI_FLASH_RESULT_OK) {
-      ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
-      return false;
+
+    bool ok;
+    if (s_write_offset != 0 && s_write_offset + records.size() <= SECTOR_SIZE_WORDS) {
+      ESP_LOGD(TAG, "Saving preferences to flash (%u words)...", records.size());
+      SpiFlashOpResult write_res;
+      {
+        InterruptLock lock;
+        write_res = spi_flash_write(get_preferences_address(s_active_sector) + s_write_offset * 4, records.data(),
+                                    records.size() * 4);
+      }
+      ok = write_res == SPI_FLASH_RESULT_OK;
+      if (ok) {
+        s_write_offset += records.size();
+      } else {
+        ESP_LOGE(TAG, "Write ESP8266 flash failed!");
+        s_write_offset = 0;  // compact on the next attempt
+      }
+    } else {
+      ok = this->compact_();
     }
-    if (write_res != SPI_FLASH_RESULT_OK) {
-      ESP_LOGE(TAG, "Write ESP8266 flash failed!");
+    if (!ok)
       return false;
-    }
 
+    memset(s_flash_dirty_words, 0, sizeof(s_flash_dirty_words));
     s_flash_dirty = false;
     return true;
   }
 
   bool reset() override {
     ESP_LOGD(TAG, "Cleaning up preferences in flash...");
-    SpiFlashOpResult erase_res;
+    SpiFlashOpResult erase_res = SPI_FLASH_RESULT_OK;
     {
       InterruptLock lock;
-      erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
+      for (uint32_t i = 0; i < s_sector_count && erase_res == SPI_FLASH_RESULT_OK; i++)
+        erase_res = spi_flash_erase_sector(get_preferences_sector(i));
     }
     if (erase_res != SPI_FLASH_RESULT_OK) {
       ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
@@ -273,6 +396,41 @@ class ESP8266Preferences : public ESPPreferences {
     s_prevent_write = true;
     return true;
   }
+
+ protected:
+  /// Write the whole image as the first record of the next sector and make that the active one.
+  bool compact_() {
+    const uint32_t sector = (s_active_sector + 1) % s_sector_count;
+    const uint32_t address = get_preferences_address(sector);
+    std::vector<uint32_t> record;
+    append_record(record, 0, ESP8266_FLASH_STORAGE_SIZE);
+    const uint32_t header[SECTOR_HEADER_WORDS] = {PREFERENCES_MAGIC, s_sequence + 1};
+
+    ESP_LOGD(TAG, "Compacting preferences into flash sector %u...", sector);
+    SpiFlashOpResult erase_res;
+    SpiFlashOpResult write_res = SPI_FLASH_RESULT_OK;
+    {
+      InterruptLock lock;
+      erase_res = spi_flash_erase_sector(get_preferences_sector(sector));
+      if (erase_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address + SECTOR_HEADER_WORDS * 4, record.data(), record.size() * 4);
+      // The header goes last, until it is written the previous sector, if there is another one, stays the active one
+      if (erase_res == SPI_FLASH_RESULT_OK && write_res == SPI_FLASH_RESULT_OK)
+        write_res = spi_flash_write(address, const_cast<uint32_t *>(header), sizeof(header));
+    }
+    if (erase_res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGE(TAG, "Erase ESP8266 flash failed!");
+      return false;
+    }
+    if (write_res != SPI_FLASH_RESULT_OK) {
+      ESP_LOGE(TAG, "Write ESP8266 flash failed!");
+      return false;
+    }
+    s_active_sector = sector;
+    s_sequence++;
+    s_write_offset = SECTOR_HEADER_WORDS + record.size();
+    return true;
+  }
 };
 
 void setup_preferences() {
@@ -1,5 +1,6 @@
 #include "fan.h"
 #include "esphome/core/log.h"
+#include "esphome/core/preference_saver.h"
 
 namespace esphome {
 namespace fan {
@@ -143,7 +144,7 @@ void Fan::save_state_() {
   state.oscillating = this->oscillating;
   state.speed = this->speed;
   state.direction = this->direction;
-  this->rtc_.save(&state);
+  global_preference_saver.save(&this->rtc_, &state);
 }
 
 void Fan::dump_traits_(const char *tag, const char *prefix) {
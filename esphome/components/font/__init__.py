@@ -244,6 +244,7 @@ DEFAULT_GLYPHS = (
     ' !"%()+=,-.:/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz°'
 )
 CONF_RAW_GLYPH_ID = "raw_glyph_id"
+CONF_BPP = "bpp"
 
 FONT_SCHEMA = cv.Schema(
     {
@@ -251,6 +252,7 @@ FONT_SCHEMA = cv.Schema(
         cv.Required(CONF_FILE): FILE_SCHEMA,
         cv.Optional(CONF_GLYPHS, default=DEFAULT_GLYPHS): validate_glyphs,
         cv.Optional(CONF_SIZE, default=20): cv.int_range(min=1),
+        cv.Optional(CONF_BPP, default=1): cv.one_of(1, 2, 4, int=True),
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         cv.GenerateID(CONF_RAW_GLYPH_ID): cv.declare_id(GlyphData),
     }
@@ -368,20 +370,24 @@ async def to_code(config):
 
     ascent, descent = font.getmetrics(config[CONF_GLYPHS])
 
+    bpp = config[CONF_BPP]
     glyph_args = {}
     data = []
     for glyph in config[CONF_GLYPHS]:
-        mask = font.getmask(glyph, mode="1")
+        # anti-aliased fonts keep the top bpp bits of the coverage of each pixel
+        mask = font.getmask(glyph, mode="1" if bpp == 1 else "L")
         offset_x, offset_y = font.getoffset(glyph)
         width, height = mask.size
-        width8 = ((width + 7) // 8) * 8
-        glyph_data = [0] * (height * width8 // 8)
+        row_bits = ((width * bpp + 7) // 8) * 8
+        glyph_data = [0] * (height * row_bits // 8)
         for y in range(height):
             for x in range(width):
-                if not mask.getpixel((x, y)):
+                pixel = mask.getpixel((x, y))
+                value = (1 if pixel else 0) if bpp == 1 else pixel >> (8 - bpp)
+                if not value:
                     continue
-                pos = x + y * width8
-                glyph_data[pos // 8] |= 0x80 >> (pos % 8)
+                pos = x * bpp + y * row_bits
+                glyph_data[pos // 8] |= value << (8 - bpp - pos % 8)
         glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
         data += glyph_data
 
@@ -408,5 +414,10 @@ async def to_code(config):
     glyphs = cg.static_const_array(config[CONF_RAW_GLYPH_ID], glyph_initializer)
 
     cg.new_Pvariable(
-        config[CONF_ID], glyphs, len(glyph_initializer), ascent, ascent + descent
+        config[CONF_ID],
+        glyphs,
+        len(glyph_initializer),
+        ascent,
+        ascent + descent,
+        bpp,
     )
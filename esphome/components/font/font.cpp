@@ -19,16 +19,54 @@ void Glyph::draw(int x_at, int y_start, display::Display *display, Color color)
   const int max_y = y_start + scan_y1 + scan_height;
 
   for (int glyph_y = y_start + scan_y1; glyph_y < max_y; glyph_y++) {
+    // draw each run of lit pixels in a row at once
+    int run_x = -1;
     for (int glyph_x = x_at + scan_x1; glyph_x < max_x; data++, glyph_x += 8) {
       uint8_t pixel_data = progmem_read_byte(data);
+      if (pixel_data == (run_x < 0 ? 0x00 : 0xFF) && glyph_x + 8 <= max_x)
+        continue;
       const int pixel_max_x = std::min(max_x, glyph_x + 8);
 
-      for (int pixel_x = glyph_x; pixel_x < pixel_max_x && pixel_data; pixel_x++, pixel_data <<= 1) {
+      for (int pixel_x = glyph_x; pixel_x < pixel_max_x; pixel_x++, pixel_data <<= 1) {
         if (pixel_data & 0x80) {
-          display->draw_pixel_at(pixel_x, glyph_y, color);
+          if (run_x < 0)
+            run_x = pixel_x;
+        } else if (run_x >= 0) {
+          display->horizontal_line(run_x, glyph_y, pixel_x - run_x, color);
+          run_x = -1;
         }
       }
     }
+    if (run_x >= 0)
+      display->horizontal_line(run_x, glyph_y, max_x - run_x, color);
+  }
+}
+void Glyph::draw(int x_at, int y_start, display::Display *display, const Color *levels, uint8_t bpp) const {
+  int scan_x1, scan_y1, scan_width, scan_height;
+  this->scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
+
+  const unsigned char *data = this->glyph_data_->data;
+  const int row_bytes = (scan_width * bpp + 7) / 8;
+  const uint8_t max_level = (1 << bpp) - 1;
+  const int x_start = x_at + scan_x1;
+
+  for (int row = 0; row < scan_height; row++, data += row_bytes) {
+    const int glyph_y = y_start + scan_y1 + row;
+    // draw each run of pixels with the same value at once
+    int run_x = 0;
+    uint8_t run_level = 0;
+    for (int col = 0; col < scan_width; col++) {
+      const int bit = col * bpp;
+      uint8_t level = (progmem_read_byte(data + bit / 8) >> (8 - bpp - bit % 8)) & max_level;
+      if (level == run_level)
+        continue;
+      if (run_level != 0)
+        display->horizontal_line(x_start + run_x, glyph_y, col - run_x, levels[run_level]);
+      run_x = col;
+      run_level = level;
+    }
+    if (run_level != 0)
+      display->horizontal_line(x_start + run_x, glyph_y, scan_width - run_x, levels[run_level]);
   }
 }
 const char *Glyph::get_char() const { return this->glyph_data_->a_char; }
@@ -65,12 +103,56 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *height = this->glyph_data_->height;
 }
 
-Font::Font(const GlyphData *data, int data_nr, int baseline, int height) : baseline_(baseline), height_(height) {
+/// Decode an ASCII or Latin-1 code point from UTF-8, returns the number of bytes used or 0 for anything else.
+static int decode_latin1(const char *str, uint16_t *code_point) {
+  auto first = (uint8_t) str[0];
+  if (first < 0x80) {
+    *code_point = first;
+    return 1;
+  }
+  auto second = (uint8_t) str[1];
+  if ((first == 0xC2 || first == 0xC3) && (second & 0xC0) == 0x80) {
+    *code_point = ((first & 0x1F) << 6) | (second & 0x3F);
+    return 2;
+  }
+  return 0;
+}
+
+Font::Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp)
+    : baseline_(baseline), height_(height), bpp_(bpp) {
   glyphs_.reserve(data_nr);
   for (int i = 0; i < data_nr; ++i)
     glyphs_.emplace_back(&data[i]);
+
+  this->latin1_index_.assign(FONT_DIRECT_GLYPHS, FONT_GLYPH_MISSING);
+  for (int i = 0; i < data_nr; ++i) {
+    const char *a_char = data[i].a_char;
+    uint16_t code_point;
+    int len = decode_latin1(a_char, &code_point);
+    if (len == 0 || code_point == 0)
+      continue;
+    // glyphs of several characters need the longest match of the search
+    if (a_char[len] != '\0' || this->latin1_index_[code_point] != FONT_GLYPH_MISSING) {
+      this->latin1_index_[code_point] = FONT_GLYPH_SEARCH;
+    } else {
+      this->latin1_index_[code_point] = i;
+    }
+  }
 }
 int Font::match_next_glyph(const char *str, int *match_length) {
+  uint16_t code_point;
+  int len = decode_latin1(str, &code_point);
+  if (len != 0) {
+    int16_t index = this->latin1_index_[code_point];
+    if (index >= 0) {
+      *match_length = len;
+      return index;
+    }
+    if (index == FONT_GLYPH_MISSING) {
+      *match_length = 0;
+      return -1;
+    }
+  }
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -118,7 +200,15 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   *x_offset = min_x;
   *width = x - min_x;
 }
-void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text) {
+void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text,
+                 Color background) {
+  // blend the colors of all pixel values once instead of per pixel
+  Color levels[1 << FONT_MAX_BPP];
+  if (this->bpp_ > 1) {
+    const uint8_t max_level = (1 << this->bpp_) - 1;
+    for (uint8_t level = 1; level <= max_level; level++)
+      levels[level] = background.gradient(color, level * 255 / max_level);
+  }
   int i = 0;
   int x_at = x_start;
   while (text[i] != '\0') {
@@ -138,7 +228,11 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
     }
 
     const Glyph &glyph = this->get_glyphs()[glyph_n];
-    glyph.draw(x_at, y_start, display, color);
+    if (this->bpp_ > 1) {
+      glyph.draw(x_at, y_start, display, levels, this->bpp_);
+    } else {
+      glyph.draw(x_at, y_start, display, color);
+    }
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
 
     i += match_length;
@@ -9,6 +9,13 @@ namespace font {
 
 class Font;
 
+/// Number of code points (ASCII and Latin-1) looked up directly instead of searching the glyphs.
+static const uint16_t FONT_DIRECT_GLYPHS = 256;
+static const int16_t FONT_GLYPH_MISSING = -1;
+static const int16_t FONT_GLYPH_SEARCH = -2;
+/// Highest number of bits per pixel glyphs can be stored with.
+static const uint8_t FONT_MAX_BPP = 4;
+
 struct GlyphData {
   const char *a_char;
   const uint8_t *data;
@@ -23,6 +30,8 @@ class Glyph {
   Glyph(const GlyphData *data) : glyph_data_(data) {}
 
   void draw(int x, int y, display::Display *display, Color color) const;
+  /// Draw a glyph stored with bpp bits per pixel, levels holds the color of every non-zero pixel value.
+  void draw(int x, int y, display::Display *display, const Color *levels, uint8_t bpp) const;
 
   const char *get_char() const;
 
@@ -45,22 +54,28 @@ class Font : public display::BaseFont {
    * @param glyphs A vector of glyphs, must be sorted lexicographically.
    * @param baseline The y-offset from the top of the text to the baseline.
    * @param bottom The y-offset from the top of the text to the bottom (i.e. height).
+   * @param bpp The bits per pixel of the glyph data, more than 1 for anti-aliased fonts.
    */
-  Font(const GlyphData *data, int data_nr, int baseline, int height);
+  Font(const GlyphData *data, int data_nr, int baseline, int height, uint8_t bpp = 1);
 
   int match_next_glyph(const char *str, int *match_length);
 
-  void print(int x_start, int y_start, display::Display *display, Color color, const char *text) override;
+  void print(int x_start, int y_start, display::Display *display, Color color, const char *text,
+             Color background) override;
   void measure(const char *str, int *width, int *x_offset, int *baseline, int *height) override;
   inline int get_baseline() { return this->baseline_; }
   inline int get_height() { return this->height_; }
+  inline uint8_t get_bpp() { return this->bpp_; }
 
   const std::vector<Glyph, ExternalRAMAllocator<Glyph>> &get_glyphs() const { return glyphs_; }
 
  protected:
-  std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
+  std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_{ExternalRAMAllocator<Glyph>(HeapTag::DISPLAY)};
+  /// Glyph index per Latin-1 code point, FONT_GLYPH_SEARCH where the binary search is needed.
+  std::vector<int16_t> latin1_index_;
   int baseline_;
   int height_;
+  uint8_t bpp_;
 };
 
 }  // namespace font
@@ -34,7 +34,15 @@ template<typename T> class RestoringGlobalsComponent : public Component {
     memcpy(this->value_, initial_value.data(), sizeof(T));
   }
 
-  T &value() { return this->value_; }
+  /** Access the value for reading or writing.
+   *
+   * Lambdas and actions can only get at the value through here, so every call may be a write. It schedules a single
+   * loop() that saves the value if it changed, instead of comparing it on every loop iteration.
+   */
+  T &value() {
+    this->mark_dirty_();
+    return this->value_;
+  }
 
   void setup() override {
     this->rtc_ = global_preferences->make_preference<T>(1944399030U ^ this->name_hash_);
@@ -44,7 +52,11 @@ template<typename T> class RestoringGlobalsComponent : public Component {
 
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
-  void loop() override { store_value_(); }
+  void loop() override {
+    this->dirty_ = false;
+    this->store_value_();
+    this->disable_loop();
+  }
 
   void on_shutdown() override { store_value_(); }
 
@@ -59,10 +71,19 @@ template<typename T> class RestoringGlobalsComponent : public Component {
     }
   }
 
+  void mark_dirty_() {
+    if (this->dirty_)
+      return;
+    this->dirty_ = true;
+    this->enable_loop_soon_any_context();
+  }
+
   T value_{};
   T prev_value_{};
   uint32_t name_hash_{};
   ESPPreferenceObject rtc_;
+  /// Set when the value was handed out since the last loop(), which is pending then.
+  volatile bool dirty_{false};
 };
 
 // Use with string or subclasses of strings
@@ -76,7 +97,11 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
     memcpy(this->value_, initial_value.data(), sizeof(T));
   }
 
-  T &value() { return this->value_; }
+  /// Access the value for reading or writing, see RestoringGlobalsComponent::value().
+  T &value() {
+    this->mark_dirty_();
+    return this->value_;
+  }
 
   void setup() override {
     char temp[SZ];
@@ -90,7 +115,11 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
 
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
-  void loop() override { store_value_(); }
+  void loop() override {
+    this->dirty_ = false;
+    this->store_value_();
+    this->disable_loop();
+  }
 
   void on_shutdown() override { store_value_(); }
 
@@ -117,10 +146,19 @@ template<typename T, uint8_t SZ> class RestoringGlobalStringComponent : public C
     }
   }
 
+  void mark_dirty_() {
+    if (this->dirty_)
+      return;
+    this->dirty_ = true;
+    this->enable_loop_soon_any_context();
+  }
+
   T value_{};
   T prev_value_{};
   uint32_t name_hash_{};
   ESPPreferenceObject rtc_;
+  /// Set when the value was handed out since the last loop(), which is pending then.
+  volatile bool dirty_{false};
 };
 
 template<class C, typename... Ts> class GlobalVarSetAction : public Action<Ts...> {
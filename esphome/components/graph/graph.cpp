@@ -28,24 +28,42 @@ void HistoryData::take_sample(float data) {
 
   // Step data based on time
   this->period_ += dt;
+  bool rescan = false;
   while (this->period_ >= this->update_time_) {
+    // Only when the sample that drops out was the minimum or maximum all samples need to be looked at again
+    float dropped = this->samples_[this->count_];
+    if (dropped == this->samples_min_ || dropped == this->samples_max_)
+      rescan = true;
     this->samples_[this->count_] = data;
+    if (!std::isnan(data)) {
+      if (std::isnan(this->samples_min_) || data < this->samples_min_)
+        this->samples_min_ = data;
+      if (std::isnan(this->samples_max_) || data > this->samples_max_)
+        this->samples_max_ = data;
+    }
     this->period_ -= this->update_time_;
     this->count_ = (this->count_ + 1) % this->length_;
+    this->sample_count_++;
     ESP_LOGV(TAG, "Updating trace with value: %f", data);
   }
+  if (rescan)
+    this->rescan_min_max_();
   if (!std::isnan(data)) {
-    // Recalc recent max/min
-    this->recent_min_ = data;
-    this->recent_max_ = data;
-    for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
-    }
+    this->recent_min_ = std::isnan(this->samples_min_) ? data : std::min(data, this->samples_min_);
+    this->recent_max_ = std::isnan(this->samples_max_) ? data : std::max(data, this->samples_max_);
+  }
+}
+
+void HistoryData::rescan_min_max_() {
+  this->samples_min_ = NAN;
+  this->samples_max_ = NAN;
+  for (float sample : this->samples_) {
+    if (std::isnan(sample))
+      continue;
+    if (std::isnan(this->samples_min_) || sample < this->samples_min_)
+      this->samples_min_ = sample;
+    if (std::isnan(this->samples_max_) || sample > this->samples_max_)
+      this->samples_max_ = sample;
   }
 }
 
@@ -54,6 +72,27 @@ void GraphTrace::init(Graph *g) {
   this->data_.init(g->get_width());
   sensor_->add_on_state_callback([this](float state) { this->data_.take_sample(state); });
   this->data_.set_update_time_ms(g->get_duration() * 1000 / g->get_width());
+  this->pixels_.resize(g->get_width(), PIXEL_NONE);
+}
+
+void GraphTrace::update_pixels_(float ymin, float yrange, uint32_t height) {
+  const uint32_t length = this->pixels_.size();
+  const uint32_t sample_count = this->data_.get_sample_count();
+  // NaN never compares equal, so a graph without a scale yet is recomputed every time
+  uint32_t todo = sample_count - this->pixels_count_;
+  if (ymin != this->pixels_ymin_ || yrange != this->pixels_yrange_ || height != this->pixels_height_ ||
+      todo > length) {
+    todo = length;
+    this->pixels_ymin_ = ymin;
+    this->pixels_yrange_ = yrange;
+    this->pixels_height_ = height;
+  }
+  this->pixels_count_ = sample_count;
+  for (uint32_t i = 0; i < todo; i++) {
+    float v = (this->data_.get_value(i) - ymin) / yrange;
+    int16_t &pixel = this->pixels_[this->pixel_slot_(sample_count, i)];
+    pixel = std::isnan(v) ? PIXEL_NONE : (int16_t) roundf((height - 1) * (1.0 - v));
+  }
 }
 
 void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color color) {
@@ -165,13 +204,15 @@ void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color colo
   for (auto *trace : traces_) {
     Color c = trace->get_line_color();
     uint16_t thick = trace->get_line_thickness();
+    // Only the samples added since the last frame need to be scaled, unless the scale changed
+    trace->update_pixels_(ymin, yrange, this->height_);
     for (uint32_t i = 0; i < this->width_; i++) {
-      float v = (trace->get_tracedata()->get_value(i) - ymin) / yrange;
-      if (!std::isnan(v) && (thick > 0)) {
+      int16_t pixel = trace->get_pixel_(i);
+      if (pixel != GraphTrace::PIXEL_NONE && (thick > 0)) {
         int16_t x = this->width_ - 1 - i;
         uint8_t b = (i % (thick * LineType::PATTERN_LENGTH)) / thick;
         if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
-          int16_t y = (int16_t) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2;
+          int16_t y = pixel - thick / 2;
           for (uint16_t t = 0; t < thick; t++) {
             buff->draw_pixel_at(x_offset + x, y_offset + y + t, c);
           }
@@ -93,15 +93,24 @@ class HistoryData {
   float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
   float get_recent_max() const { return recent_max_; }
   float get_recent_min() const { return recent_min_; }
+  /// Number of samples stored since boot, get_value() shifts by one whenever this increases.
+  uint32_t get_sample_count() const { return sample_count_; }
 
  protected:
+  /// Recompute the minimum and maximum of all stored samples.
+  void rescan_min_max_();
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
   int length_;
   int count_{0};
+  uint32_t sample_count_{0};
   float recent_min_{NAN};
   float recent_max_{NAN};
+  /// Minimum and maximum of the stored samples, kept up to date as samples are added.
+  float samples_min_{NAN};
+  float samples_max_{NAN};
   std::vector<float> samples_;
 };
 
@@ -120,12 +129,29 @@ class GraphTrace {
   const HistoryData *get_tracedata() { return &data_; }
 
  protected:
+  /// Update the cached y coordinate of every sample for the given scale, only new samples if it didn't change.
+  void update_pixels_(float ymin, float yrange, uint32_t height);
+  /// Cached y coordinate of the sample at the given age, PIXEL_NONE if there is no value.
+  int16_t get_pixel_(uint32_t idx) const { return this->pixels_[this->pixel_slot_(this->pixels_count_, idx)]; }
+  uint32_t pixel_slot_(uint32_t sample_count, uint32_t idx) const {
+    const uint32_t length = this->pixels_.size();
+    return (sample_count % length + length - 1 - idx) % length;
+  }
+
+  static const int16_t PIXEL_NONE = INT16_MIN;
+
   sensor::Sensor *sensor_{nullptr};
   std::string name_{""};
   uint8_t line_thickness_{3};
   enum LineType line_type_ { LINE_TYPE_SOLID };
   Color line_color_{COLOR_ON};
   HistoryData data_;
+  /// y coordinates of the samples as last drawn, in a ring buffer like the samples.
+  std::vector<int16_t> pixels_;
+  uint32_t pixels_count_{0};
+  float pixels_ymin_{NAN};
+  float pixels_yrange_{NAN};
+  uint32_t pixels_height_{0};
 
   friend Graph;
   friend GraphLegend;
@@ -0,0 +1,37 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_ID, CONF_SENSORS, CONF_TOPIC
+
+DEPENDENCIES = ["mqtt"]
+AUTO_LOAD = ["json"]
+
+CONF_BUFFER_SIZE = "buffer_size"
+
+history_ns = cg.esphome_ns.namespace("history")
+History = history_ns.class_("History", cg.Component)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(History),
+        cv.Required(CONF_SENSORS): cv.All(
+            cv.ensure_list(cv.use_id(sensor.Sensor)), cv.Length(min=1, max=255)
+        ),
+        cv.Optional(CONF_BUFFER_SIZE, default="4kB"): cv.All(
+            cv.validate_bytes, cv.int_range(min=256)
+        ),
+        cv.Optional(CONF_TOPIC): cv.publish_topic,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    for sensor_id in config[CONF_SENSORS]:
+        sens = await cg.get_variable(sensor_id)
+        cg.add(var.add_sensor(sens))
+    cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
+    if CONF_TOPIC in config:
+        cg.add(var.set_topic(config[CONF_TOPIC]))
@@ -0,0 +1,153 @@
+#include "history.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+
+#include "esphome/components/mqtt/mqtt_client.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace history {
+
+static const char *const TAG = "history";
+
+static uint8_t *encode_varint(uint8_t *data, uint32_t value) {
+  while (value > 0x7F) {
+    *data++ = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  *data++ = value;
+  return data;
+}
+
+static const uint8_t *decode_varint(const uint8_t *data, uint32_t *value) {
+  uint32_t result = 0;
+  uint8_t shift = 0;
+  uint8_t byte;
+  do {
+    byte = *data++;
+    result |= uint32_t(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  *value = result;
+  return data;
+}
+
+static uint32_t zigzag_encode(int32_t value) { return (uint32_t(value) << 1) ^ uint32_t(value >> 31); }
+static int32_t zigzag_decode(uint32_t value) { return int32_t(value >> 1) ^ -int32_t(value & 1); }
+
+void History::setup() {
+  this->block_count_ = std::max<size_t>(this->buffer_size_ / BLOCK_SIZE, 1);
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  this->buffer_ = allocator.allocate(this->block_count_ * BLOCK_SIZE);
+  if (this->buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate the history buffer!");
+    this->mark_failed();
+    return;
+  }
+  this->block_used_.resize(this->block_count_);
+  this->last_values_.resize(this->sensors_.size());
+  if (this->topic_.empty())
+    this->topic_ = mqtt::global_mqtt_client->get_topic_prefix() + "/history";
+
+  for (size_t i = 0; i < this->sensors_.size(); i++) {
+    sensor::Sensor *sens = this->sensors_[i];
+    this->object_ids_.push_back(sens->get_object_id());
+    int8_t decimals = clamp<int8_t>(sens->get_accuracy_decimals(), 0, 6);
+    this->scales_.push_back(powf(10.0f, decimals));
+    sens->add_on_state_callback([this, i](float state) {
+      if (this->recording_)
+        this->record_(i, state);
+    });
+  }
+}
+
+void History::loop() {
+  bool connected = mqtt::global_mqtt_client->is_connected();
+  this->was_connected_ |= connected;
+  this->recording_ = this->was_connected_ && !connected;
+  if (!connected || this->used_blocks_ == 0)
+    return;
+
+  // one block per iteration, so the upload doesn't hold up everything else
+  if (!this->publish_block_(this->first_block_))
+    return;
+  this->first_block_ = (this->first_block_ + 1) % this->block_count_;
+  this->used_blocks_--;
+}
+
+void History::dump_config() {
+  ESP_LOGCONFIG(TAG, "History:");
+  ESP_LOGCONFIG(TAG, "  Buffer: %u blocks of %u bytes", (unsigned) this->block_count_, (unsigned) BLOCK_SIZE);
+  ESP_LOGCONFIG(TAG, "  Topic: %s", this->topic_.c_str());
+  for (auto *sens : this->sensors_)
+    ESP_LOGCONFIG(TAG, "  Sensor: %s", sens->get_name().c_str());
+}
+
+void History::next_block_() {
+  if (this->used_blocks_ == this->block_count_) {
+    this->first_block_ = (this->first_block_ + 1) % this->block_count_;
+    this->used_blocks_--;
+    this->dropped_blocks_++;
+    ESP_LOGW(TAG, "Buffer full, dropped the oldest values (%" PRIu32 " blocks so far)", this->dropped_blocks_);
+  }
+  size_t block = (this->first_block_ + this->used_blocks_) % this->block_count_;
+  this->block_used_[block] = 0;
+  this->used_blocks_++;
+  this->last_time_ = 0;
+  std::fill(this->last_values_.begin(), this->last_values_.end(), 0);
+}
+
+void History::record_(uint8_t index, float value) {
+  if (std::isnan(value))
+    return;
+  size_t block = (this->first_block_ + this->used_blocks_ + this->block_count_ - 1) % this->block_count_;
+  if (this->used_blocks_ == 0 || this->block_used_[block] + MAX_RECORD_SIZE > BLOCK_SIZE) {
+    this->next_block_();
+    block = (this->first_block_ + this->used_blocks_ - 1) % this->block_count_;
+  }
+
+  const uint32_t now = millis();
+  const float scaled = clamp(roundf(value * this->scales_[index]), -1e9f, 1e9f);
+  const int32_t scaled_value = static_cast<int32_t>(scaled);
+
+  uint8_t *start = this->buffer_ + block * BLOCK_SIZE + this->block_used_[block];
+  uint8_t *data = encode_varint(start, index);
+  data = encode_varint(data, now - this->last_time_);
+  data = encode_varint(data, zigzag_encode(scaled_value - this->last_values_[index]));
+  this->block_used_[block] += data - start;
+  this->last_time_ = now;
+  this->last_values_[index] = scaled_value;
+}
+
+bool History::publish_block_(size_t block) {
+  const uint8_t *data = this->buffer_ + block * BLOCK_SIZE;
+  const uint8_t *end = data + this->block_used_[block];
+  return mqtt::global_mqtt_client->publish_json(this->topic_, [this, data, end](JsonObject root) {
+    root["uptime"] = millis();
+    JsonArray points = root.createNestedArray("points");
+    std::vector<int32_t> values(this->sensors_.size());
+    uint32_t recorded = 0;
+    const uint8_t *pos = data;
+    while (pos < end) {
+      uint32_t index, delta_time, delta_value;
+      pos = decode_varint(pos, &index);
+      pos = decode_varint(pos, &delta_time);
+      pos = decode_varint(pos, &delta_value);
+      if (index >= values.size())
+        break;
+      recorded += delta_time;
+      values[index] += zigzag_decode(delta_value);
+      JsonArray point = points.createNestedArray();
+      point.add(this->object_ids_[index].c_str());
+      point.add(recorded);
+      point.add(values[index] / this->scales_[index]);
+    }
+  });
+}
+
+}  // namespace history
+}  // namespace esphome
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/sensor/sensor.h"
+
+namespace esphome {
+namespace history {
+
+/** Keeps the values of sensors while MQTT is disconnected and publishes them once it is back.
+ *
+ * Values are recorded into a ring of fixed size blocks, in PSRAM when there is some. Every record is the index of the
+ * sensor, the milliseconds since the previous record and the change from the previous value of the same sensor in
+ * units of its accuracy, all as varints, so a typical record takes 3 to 5 bytes. Every block starts from zero again
+ * so it can be decoded on its own, and when the ring is full the oldest block is dropped as a whole.
+ *
+ * After reconnecting, one block per loop iteration is published to the history topic as
+ * `{"uptime": <millis() now>, "points": [[<sensor object id>, <millis() when recorded>, <value>], ...]}`, from which
+ * the receiver can work out when the values were recorded.
+ */
+class History : public Component {
+ public:
+  void add_sensor(sensor::Sensor *sensor) { this->sensors_.push_back(sensor); }
+  void set_buffer_size(size_t buffer_size) { this->buffer_size_ = buffer_size; }
+  void set_topic(const std::string &topic) { this->topic_ = topic; }
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+
+ protected:
+  static const size_t BLOCK_SIZE = 256;
+  /// Largest encoded record, index, time delta and value delta.
+  static const size_t MAX_RECORD_SIZE = 5 + 5 + 5;
+
+  void record_(uint8_t index, float value);
+  /// Start writing the next block, dropping the oldest one if the ring is full.
+  void next_block_();
+  /// Publish the oldest block, returns false if MQTT didn't take it.
+  bool publish_block_(size_t block);
+
+  std::vector<sensor::Sensor *> sensors_;
+  std::vector<std::string> object_ids_;
+  /// Multiplier to turn a value of each sensor into an integer, from its accuracy.
+  std::vector<float> scales_;
+  size_t buffer_size_;
+  std::string topic_;
+
+  uint8_t *buffer_{nullptr};
+  /// Bytes used in each block.
+  std::vector<uint16_t> block_used_;
+  size_t block_count_{0};
+  /// Oldest block that wasn't published yet.
+  size_t first_block_{0};
+  /// Number of blocks holding records, the block being written is the last of them.
+  size_t used_blocks_{0};
+  /// Time and value of the previous record in the block being written, the delta encoding is relative to them.
+  uint32_t last_time_{0};
+  std::vector<int32_t> last_values_;
+  /// Only values recorded after the first connection are kept, the ones before it are no news to anybody.
+  bool was_connected_{false};
+  bool recording_{false};
+  uint32_t dropped_blocks_{0};
+};
+
+}  // namespace history
+}  // namespace esphome
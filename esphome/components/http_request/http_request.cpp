@@ -2,28 +2,167 @@
 
 #include "http_request.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/log.h"
 #include "esphome/components/network/util.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace http_request {
 
 static const char *const TAG = "http_request";
 
+/// Scheme, host and port of url, requests to the same origin can reuse the connection.
+static std::string url_origin(const std::string &url) {
+  size_t start = url.find("://");
+  start = start == std::string::npos ? 0 : start + 3;
+  return url.substr(0, url.find('/', start));
+}
+
+/// Passes what HTTPClient::writeToStream() writes on to a callback, nothing can be read from it.
+class BodyChunkStream : public Stream {
+ public:
+  explicit BodyChunkStream(const body_chunk_t &callback) : callback_(callback) {}
+
+  size_t write(uint8_t data) override {
+    this->callback_(&data, 1);
+    return 1;
+  }
+  size_t write(const uint8_t *buffer, size_t size) override {
+    this->callback_(buffer, size);
+    return size;
+  }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  void flush() override {}
+
+ protected:
+  const body_chunk_t &callback_;
+};
+
+// Headers of the response that are needed to read the body
+static const char *COLLECT_HEADERS[] = {"Transfer-Encoding"};  // NOLINT
+
+#ifdef USE_ESP32
+static const uint8_t ASYNC_QUEUE_LENGTH = 8;
+
+void HttpRequestComponent::setup() {
+  if (!this->async_)
+    return;
+
+  this->jobs_ = xQueueCreate(ASYNC_QUEUE_LENGTH, sizeof(HttpRequestJob *));
+  this->results_ = xQueueCreate(ASYNC_QUEUE_LENGTH, sizeof(HttpRequestJob *));
+  if (this->jobs_ == nullptr || this->results_ == nullptr ||
+      xTaskCreate(HttpRequestComponent::worker_task, "http_request", 8192, this, 1, nullptr) != pdPASS) {
+    ESP_LOGE(TAG, "Could not start the worker task, requests are sent synchronously");
+    this->async_ = false;
+  }
+}
+
+void HttpRequestComponent::loop() {
+  if (!this->async_)
+    return;
+
+  HttpRequestJob *job;
+  while (xQueueReceive(this->results_, &job, 0) == pdTRUE) {
+    if (!job->begin_status) {
+      this->status_set_warning();
+      ESP_LOGW(TAG, "HTTP Request failed at the begin phase. Please check the configuration");
+    } else {
+      this->async_response_ = &job->response;
+      for (auto *trigger : *job->response_triggers)
+        trigger->process(job->http_code, job->duration);
+      this->async_response_ = nullptr;
+      this->log_result_(job->url, job->http_code, job->duration);
+    }
+    delete job;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+}
+
+void HttpRequestComponent::send_async_(const std::vector<HttpRequestResponseTrigger *> &response_triggers) {
+  auto *job = new HttpRequestJob();  // NOLINT(cppcoreguidelines-owning-memory)
+  job->url = this->url_;
+  job->method = this->method_;
+  job->body = this->body_;
+  if (this->useragent_ != nullptr)
+    job->useragent = this->useragent_;
+  // The header values may not outlive the action, so they are copied
+  for (const auto &header : this->headers_)
+    job->headers.emplace_back(header.name, header.value);
+  job->timeout = this->timeout_;
+  job->response_triggers = &response_triggers;
+
+  if (xQueueSend(this->jobs_, &job, 0) != pdTRUE) {
+    delete job;  // NOLINT(cppcoreguidelines-owning-memory)
+    this->status_set_warning();
+    ESP_LOGW(TAG, "HTTP Request dropped, %u requests are already waiting; URL: %s", ASYNC_QUEUE_LENGTH,
+             this->url_.c_str());
+  }
+}
+
+void HttpRequestComponent::worker_task(void *params) {
+  auto *parent = static_cast<HttpRequestComponent *>(params);
+  // Owned by the worker, so the connection stays open between requests to the same origin
+  HTTPClient client;
+  std::string origin;
+  HttpRequestJob *job;
+  while (true) {
+    if (xQueueReceive(parent->jobs_, &job, portMAX_DELAY) != pdTRUE)
+      continue;
+
+    std::string job_origin = url_origin(job->url);
+    if (job_origin != origin) {
+      client.setReuse(false);
+      client.end();
+      origin = job_origin;
+    }
+    client.setReuse(true);
+    client.setFollowRedirects(parent->follow_redirects_ ? HTTPC_FORCE_FOLLOW_REDIRECTS
+                                                        : HTTPC_DISABLE_FOLLOW_REDIRECTS);
+    client.setRedirectLimit(parent->redirect_limit_);
+
+    job->begin_status = client.begin(job->url.c_str());
+    if (job->begin_status) {
+      client.setTimeout(job->timeout);
+      client.setConnectTimeout(job->timeout);
+      if (!job->useragent.empty())
+        client.setUserAgent(job->useragent.c_str());
+      for (const auto &header : job->headers)
+        client.addHeader(header.first.c_str(), header.second.c_str(), false, true);
+
+      uint32_t start_time = millis();
+      job->http_code = client.sendRequest(job->method, job->body.c_str());
+      if (job->http_code > 0 && !job->response_triggers->empty())
+        job->response = client.getString().c_str();
+      job->duration = millis() - start_time;
+    }
+    // Keeps the connection open if the server allows it
+    client.end();
+
+    xQueueSend(parent->results_, &job, portMAX_DELAY);
+  }
+}
+#endif
+
 void HttpRequestComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "HTTP Request:");
   ESP_LOGCONFIG(TAG, "  Timeout: %ums", this->timeout_);
   ESP_LOGCONFIG(TAG, "  User-Agent: %s", this->useragent_);
   ESP_LOGCONFIG(TAG, "  Follow Redirects: %d", this->follow_redirects_);
   ESP_LOGCONFIG(TAG, "  Redirect limit: %d", this->redirect_limit_);
+#ifdef USE_ESP32
+  ESP_LOGCONFIG(TAG, "  Async: %s", YESNO(this->async_));
+#endif
 }
 
 void HttpRequestComponent::set_url(std::string url) {
   this->url_ = std::move(url);
   this->secure_ = this->url_.compare(0, 6, "https:") == 0;
 
-  if (!this->last_url_.empty() && this->url_ != this->last_url_) {
-    // Close connection if url has been changed
+  if (!this->last_url_.empty() && url_origin(this->url_) != url_origin(this->last_url_)) {
+    // Close connection if the host has been changed
     this->client_.setReuse(false);
     this->client_.end();
   }
@@ -38,6 +177,13 @@ void HttpRequestComponent::send(const std::vector<HttpRequestResponseTrigger *>
     return;
   }
 
+#ifdef USE_ESP32
+  if (this->async_) {
+    this->send_async_(response_triggers);
+    return;
+  }
+#endif
+
   bool begin_status = false;
   const String url = this->url_.c_str();
 #if defined(USE_ESP32) || (defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 6, 0))
@@ -75,28 +221,32 @@ void HttpRequestComponent::send(const std::vector<HttpRequestResponseTrigger *>
   for (const auto &header : this->headers_) {
     this->client_.addHeader(header.name, header.value, false, true);
   }
+  this->client_.collectHeaders(COLLECT_HEADERS, 1);
 
   uint32_t start_time = millis();
   int http_code = this->client_.sendRequest(this->method_, this->body_.c_str());
   uint32_t duration = millis() - start_time;
   for (auto *trigger : response_triggers)
     trigger->process(http_code, duration);
+  this->log_result_(this->url_, http_code, duration);
+}
 
+void HttpRequestComponent::log_result_(const std::string &url, int http_code, uint32_t duration) {
   if (http_code < 0) {
-    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Error: %s; Duration: %u ms", this->url_.c_str(),
+    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Error: %s; Duration: %u ms", url.c_str(),
              HTTPClient::errorToString(http_code).c_str(), duration);
     this->status_set_warning();
     return;
   }
 
   if (http_code < 200 || http_code >= 300) {
-    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Code: %d; Duration: %u ms", this->url_.c_str(), http_code, duration);
+    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Code: %d; Duration: %u ms", url.c_str(), http_code, duration);
     this->status_set_warning();
     return;
   }
 
   this->status_clear_warning();
-  ESP_LOGD(TAG, "HTTP Request completed; URL: %s; Code: %d; Duration: %u ms", this->url_.c_str(), http_code, duration);
+  ESP_LOGD(TAG, "HTTP Request completed; URL: %s; Code: %d; Duration: %u ms", url.c_str(), http_code, duration);
 }
 
 #ifdef USE_ESP8266
@@ -125,6 +275,10 @@ void HttpRequestComponent::close() {
 }
 
 const char *HttpRequestComponent::get_string() {
+#ifdef USE_ESP32
+  if (this->async_response_ != nullptr)
+    return this->async_response_->c_str();
+#endif
 #if defined(ESP32)
   // The static variable is here because HTTPClient::getString() returns a String on ESP32,
   // and we need something to keep a buffer alive.
@@ -138,6 +292,65 @@ const char *HttpRequestComponent::get_string() {
   return str.c_str();
 }
 
+bool HttpRequestComponent::read_body(const body_chunk_t &callback) {
+#ifdef USE_ESP32
+  if (this->async_response_ != nullptr) {
+    callback(reinterpret_cast<const uint8_t *>(this->async_response_->data()), this->async_response_->size());
+    return true;
+  }
+#endif
+  // HTTPClient reads the body through a fixed size buffer, and decodes chunked responses
+  BodyChunkStream stream(callback);
+  int result = this->client_.writeToStream(&stream);
+  if (result < 0) {
+    ESP_LOGW(TAG, "Reading the response body failed: %s", HTTPClient::errorToString(result).c_str());
+    return false;
+  }
+  return true;
+}
+
+template<typename Input>
+static DeserializationError deserialize_json_body(JsonDocument &document, Input &&input, const JsonDocument *filter) {
+  if (filter != nullptr)
+    return deserializeJson(document, input, DeserializationOption::Filter(filter->as<JsonVariantConst>()));
+  return deserializeJson(document, input);
+}
+
+bool HttpRequestComponent::parse_json_body(const json::json_parse_t &f, const JsonDocument *filter, size_t capacity) {
+  HeapTagScope heap_tag(HeapTag::JSON);
+  const char *body = nullptr;
+#ifdef USE_ESP32
+  if (this->async_response_ != nullptr)
+    body = this->async_response_->c_str();
+#endif
+  // The stream of chunked responses still contains the chunk sizes, those are read into a string by HTTPClient
+  if (body == nullptr && this->client_.header(COLLECT_HEADERS[0]).equalsIgnoreCase("chunked"))
+    body = this->get_string();
+
+  if (capacity == 0) {
+    const int size = body != nullptr ? strlen(body) : this->client_.getSize();
+    if (size < 0) {
+      ESP_LOGW(TAG, "Can't size the JSON document for a response without Content-Length, set a capacity");
+      return false;
+    }
+    capacity = size * 3 / 2;
+  }
+  DynamicJsonDocument document(capacity);
+  if (document.capacity() == 0) {
+    ESP_LOGE(TAG, "Could not allocate memory for JSON document! Requested %u bytes", capacity);
+    return false;
+  }
+
+  DeserializationError err = body != nullptr ? deserialize_json_body(document, body, filter)
+                                             : deserialize_json_body(document, this->client_.getStream(), filter);
+  if (err != DeserializationError::Ok) {
+    ESP_LOGW(TAG, "JSON parse error: %s", err.c_str());
+    return false;
+  }
+  f(document.as<JsonObject>());
+  return true;
+}
+
 }  // namespace http_request
 }  // namespace esphome
 
@@ -15,6 +15,8 @@
 
 #ifdef USE_ESP32
 #include <HTTPClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 #endif
 #ifdef USE_ESP8266
 #include <ESP8266HTTPClient.h>
@@ -31,13 +33,39 @@ struct Header {
   const char *value;
 };
 
+/// Callback function typedef for consuming the response body, the data is only valid during the call.
+using body_chunk_t = std::function<void(const uint8_t *data, size_t length)>;
+
 class HttpRequestResponseTrigger : public Trigger<int32_t, uint32_t> {
  public:
   void process(int32_t status_code, uint32_t duration_ms) { this->trigger(status_code, duration_ms); }
 };
 
+#ifdef USE_ESP32
+/// A request handed to the worker task in async mode, which fills in the result and hands it back to the loop.
+struct HttpRequestJob {
+  std::string url;
+  const char *method;
+  std::string body;
+  std::string useragent;
+  std::vector<std::pair<std::string, std::string>> headers;
+  uint16_t timeout;
+  const std::vector<HttpRequestResponseTrigger *> *response_triggers;
+
+  bool begin_status{false};
+  int http_code{0};
+  uint32_t duration{0};
+  /// The response body, only read when there are triggers that can get it with get_string().
+  std::string response;
+};
+#endif
+
 class HttpRequestComponent : public Component {
  public:
+#ifdef USE_ESP32
+  void setup() override;
+  void loop() override;
+#endif
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
@@ -49,9 +77,30 @@ class HttpRequestComponent : public Component {
   void set_redirect_limit(uint16_t limit) { this->redirect_limit_ = limit; }
   void set_body(const std::string &body) { this->body_ = body; }
   void set_headers(std::list<Header> headers) { this->headers_ = std::move(headers); }
+#ifdef USE_ESP32
+  /** Perform the requests on a worker task instead of blocking the loop until they are done.
+   *
+   * The response triggers run in the loop once the request is done, the worker keeps the connection open for the next
+   * request to the same host.
+   */
+  void set_async(bool async) { this->async_ = async; }
+#endif
   void send(const std::vector<HttpRequestResponseTrigger *> &response_triggers);
   void close();
   const char *get_string();
+  /** Pass the response body to callback in chunks while it is received, instead of reading all of it into memory like
+   * get_string() does. Only valid in the response triggers, returns false if the body couldn't be read completely.
+   *
+   * In async mode the body has already been read by the worker, it is passed as a single chunk.
+   */
+  bool read_body(const body_chunk_t &callback);
+  /** Parse the response body as JSON while it is received, without reading it into a string first.
+   *
+   * With a filter, only the fields it selects are kept (see DeserializationOption::Filter of ArduinoJson), which
+   * together with a fixed capacity parses large responses in constant memory. Without a capacity, the document is
+   * sized from the Content-Length like json::parse_json() does. Chunked responses are read into a string first.
+   */
+  bool parse_json_body(const json::json_parse_t &f, const JsonDocument *filter = nullptr, size_t capacity = 0);
 
  protected:
   HTTPClient client_{};
@@ -71,6 +120,17 @@ class HttpRequestComponent : public Component {
   std::shared_ptr<BearSSL::WiFiClientSecure> wifi_client_secure_;
 #endif
   std::shared_ptr<WiFiClient> get_wifi_client_();
+#endif
+  void log_result_(const std::string &url, int http_code, uint32_t duration);
+#ifdef USE_ESP32
+  void send_async_(const std::vector<HttpRequestResponseTrigger *> &response_triggers);
+  static void worker_task(void *params);
+
+  bool async_{false};
+  QueueHandle_t jobs_{nullptr};
+  QueueHandle_t results_{nullptr};
+  /// Body of the async response whose triggers are running, for get_string().
+  const std::string *async_response_{nullptr};
 #endif
 };
 
@@ -1,6 +1,7 @@
 #include "hx711.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include <cinttypes>
 
 namespace esphome {
 namespace hx711 {
@@ -13,6 +14,15 @@ void HX711Sensor::setup() {
   this->dout_pin_->setup();
   this->sck_pin_->digital_write(false);
 
+  if (this->continuous_) {
+    // Validation only allows internal pins in continuous mode
+    auto *dout_pin = static_cast<InternalGPIOPin *>(this->dout_pin_);
+    this->store_.dout_pin = dout_pin->to_isr();
+    this->store_.sck_pin = static_cast<InternalGPIOPin *>(this->sck_pin_)->to_isr();
+    this->store_.gain = this->gain_;
+    dout_pin->attach_interrupt(HX711Store::gpio_intr, &this->store_, gpio::INTERRUPT_FALLING_EDGE);
+  }
+
   // Read sensor once without publishing to set the gain
   this->read_sensor_(nullptr);
 }
@@ -21,10 +31,17 @@ void HX711Sensor::dump_config() {
   LOG_SENSOR("", "HX711", this);
   LOG_PIN("  DOUT Pin: ", this->dout_pin_);
   LOG_PIN("  SCK Pin: ", this->sck_pin_);
+  if (this->continuous_)
+    ESP_LOGCONFIG(TAG, "  Continuous: YES");
   LOG_UPDATE_INTERVAL(this);
 }
 float HX711Sensor::get_setup_priority() const { return setup_priority::DATA; }
 void HX711Sensor::update() {
+  if (this->continuous_) {
+    this->update_continuous_();
+    return;
+  }
+
   uint32_t result;
   if (this->read_sensor_(&result)) {
     int32_t value = static_cast<int32_t>(result);
@@ -32,6 +49,30 @@ void HX711Sensor::update() {
     this->publish_state(value);
   }
 }
+void HX711Sensor::update_continuous_() {
+  int64_t sum;
+  uint32_t count;
+  {
+    InterruptLock lock;
+    sum = this->store_.sum;
+    count = this->store_.count;
+    this->store_.sum = 0;
+    this->store_.count = 0;
+  }
+
+  if (count == 0) {
+    // A falling edge may have been missed, which leaves DOUT low until the pending sample is read
+    this->read_sensor_(nullptr);
+    ESP_LOGW(TAG, "'%s': No samples since the last update!", this->name_.c_str());
+    this->status_set_warning();
+    return;
+  }
+
+  this->status_clear_warning();
+  float value = static_cast<float>(sum) / count;
+  ESP_LOGD(TAG, "'%s': Got value %.1f (average of %" PRIu32 " samples)", this->name_.c_str(), value, count);
+  this->publish_state(value);
+}
 bool HX711Sensor::read_sensor_(uint32_t *result) {
   if (this->dout_pin_->digital_read()) {
     ESP_LOGW(TAG, "HX711 is not ready for new measurements yet!");
@@ -42,21 +83,26 @@ bool HX711Sensor::read_sensor_(uint32_t *result) {
   this->status_clear_warning();
   uint32_t data = 0;
 
-  {
+  if (this->continuous_) {
+    InterruptLock lock;
+    data = this->store_.read_sample();
+  } else {
+    auto sck_pin = FastGPIOPin::from(this->sck_pin_);
+    auto dout_pin = FastGPIOPin::from(this->dout_pin_);
     InterruptLock lock;
     for (uint8_t i = 0; i < 24; i++) {
-      this->sck_pin_->digital_write(true);
+      sck_pin.digital_write(true);
       delayMicroseconds(1);
-      data |= uint32_t(this->dout_pin_->digital_read()) << (23 - i);
-      this->sck_pin_->digital_write(false);
+      data |= uint32_t(dout_pin.digital_read()) << (23 - i);
+      sck_pin.digital_write(false);
       delayMicroseconds(1);
     }
 
     // Cycle clock pin for gain setting
     for (uint8_t i = 0; i < this->gain_; i++) {
-      this->sck_pin_->digital_write(true);
+      sck_pin.digital_write(true);
       delayMicroseconds(1);
-      this->sck_pin_->digital_write(false);
+      sck_pin.digital_write(false);
       delayMicroseconds(1);
     }
   }
@@ -70,5 +116,32 @@ bool HX711Sensor::read_sensor_(uint32_t *result) {
   return true;
 }
 
+int32_t IRAM_ATTR HX711Store::read_sample() {
+  uint32_t data = 0;
+  for (uint8_t i = 0; i < 24; i++) {
+    this->sck_pin.digital_write(true);
+    delayMicroseconds(1);
+    data |= uint32_t(this->dout_pin.digital_read()) << (23 - i);
+    this->sck_pin.digital_write(false);
+    delayMicroseconds(1);
+  }
+  for (uint8_t i = 0; i < this->gain; i++) {
+    this->sck_pin.digital_write(true);
+    delayMicroseconds(1);
+    this->sck_pin.digital_write(false);
+    delayMicroseconds(1);
+  }
+  // Sign extend the 24 bit two's complement value
+  return static_cast<int32_t>(data << 8) >> 8;
+}
+
+void IRAM_ATTR HX711Store::gpio_intr(HX711Store *arg) {
+  // Clocking the bits out toggles DOUT too, it stays high after the last one until the next conversion is done
+  if (arg->dout_pin.digital_read())
+    return;
+  arg->sum += arg->read_sample();
+  arg->count++;
+}
+
 }  // namespace hx711
 }  // namespace esphome
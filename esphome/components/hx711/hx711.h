@@ -13,11 +13,30 @@ enum HX711Gain {
   HX711_GAIN_64 = 3,
 };
 
+/// State shared with the DOUT interrupt in continuous mode.
+struct HX711Store {
+  ISRInternalGPIOPin dout_pin;
+  ISRInternalGPIOPin sck_pin;
+  uint8_t gain;
+  /// Sum and number of the samples read since the last update(), 64 bits as a minute at 80 SPS overflows 32 bits.
+  volatile int64_t sum{0};
+  volatile uint32_t count{0};
+
+  /// Shift out one sample, DOUT must be low. Interrupts must be disabled or this must run in the interrupt handler.
+  int32_t read_sample();
+  static void gpio_intr(HX711Store *arg);
+};
+
 class HX711Sensor : public sensor::Sensor, public PollingComponent {
  public:
   void set_dout_pin(GPIOPin *dout_pin) { dout_pin_ = dout_pin; }
   void set_sck_pin(GPIOPin *sck_pin) { sck_pin_ = sck_pin; }
   void set_gain(HX711Gain gain) { gain_ = gain; }
+  /** Read every sample the HX711 converts from the DOUT falling edge interrupt and publish their average on update.
+   *
+   * The pins must be internal pins, this is checked when validating the config.
+   */
+  void set_continuous(bool continuous) { continuous_ = continuous; }
 
   void setup() override;
   void dump_config() override;
@@ -26,10 +45,13 @@ class HX711Sensor : public sensor::Sensor, public PollingComponent {
 
  protected:
   bool read_sensor_(uint32_t *result);
+  void update_continuous_();
 
   GPIOPin *dout_pin_;
   GPIOPin *sck_pin_;
   HX711Gain gain_{HX711_GAIN_128};
+  bool continuous_{false};
+  HX711Store store_{};
 };
 
 }  // namespace hx711
@@ -8,11 +8,13 @@ from esphome.const import (
     ICON_SCALE,
     STATE_CLASS_MEASUREMENT,
 )
+from esphome.core import CORE
 
 hx711_ns = cg.esphome_ns.namespace("hx711")
 HX711Sensor = hx711_ns.class_("HX711Sensor", sensor.Sensor, cg.PollingComponent)
 
 CONF_DOUT_PIN = "dout_pin"
+CONF_CONTINUOUS = "continuous"
 
 HX711Gain = hx711_ns.enum("HX711Gain")
 GAINS = {
@@ -21,7 +23,24 @@ GAINS = {
     64: HX711Gain.HX711_GAIN_64,
 }
 
-CONFIG_SCHEMA = (
+
+
+def _validate_continuous(config):
+    # The pins are driven from the DOUT interrupt in continuous mode, pins of port expanders can't be
+    if config[CONF_CONTINUOUS]:
+        for key in (CONF_DOUT_PIN, CONF_CLK_PIN):
+            if any(
+                platform in config[key]
+                for platform in pins.PIN_SCHEMA_REGISTRY
+                if platform != CORE.target_platform
+            ):
+                raise cv.Invalid(
+                    f"{key} must be an internal pin in continuous mode", path=[key]
+                )
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
     sensor.sensor_schema(
         HX711Sensor,
         icon=ICON_SCALE,
@@ -33,9 +52,11 @@ CONFIG_SCHEMA = (
             cv.Required(CONF_DOUT_PIN): pins.gpio_input_pin_schema,
             cv.Required(CONF_CLK_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_GAIN, default=128): cv.enum(GAINS, int=True),
+            cv.Optional(CONF_CONTINUOUS, default=False): cv.boolean,
         }
     )
-    .extend(cv.polling_component_schema("60s"))
+    .extend(cv.polling_component_schema("60s")),
+    _validate_continuous,
 )
 
 
@@ -48,3 +69,4 @@ async def to_code(config):
     sck_pin = await cg.gpio_pin_expression(config[CONF_CLK_PIN])
     cg.add(var.set_sck_pin(sck_pin))
     cg.add(var.set_gain(config[CONF_GAIN]))
+    cg.add(var.set_continuous(config[CONF_CONTINUOUS]))
@@ -73,6 +73,18 @@ class I2CDevice {
   ErrorCode write_register(uint8_t a_register, const uint8_t *data, size_t len, bool stop = true);
   ErrorCode write_register16(uint16_t a_register, const uint8_t *data, size_t len, bool stop = true);
 
+  /// Non-blocking versions of read() and read_register(), see I2CBus::transfer_async()
+  void read_async(uint8_t *data, size_t len, I2CBus::TransactionCallback &&callback) {
+    this->bus_->transfer_async(this->address_, nullptr, 0, data, len, std::move(callback));
+  }
+  void read_register_async(uint8_t a_register, uint8_t *data, size_t len, I2CBus::TransactionCallback &&callback) {
+    this->bus_->transfer_async(this->address_, &a_register, 1, data, len, std::move(callback));
+  }
+  /// Non-blocking version of write(), the data is copied before this returns
+  void write_async(const uint8_t *data, size_t len, I2CBus::TransactionCallback &&callback) {
+    this->bus_->transfer_async(this->address_, data, len, nullptr, 0, std::move(callback));
+  }
+
   // Compat APIs
 
   bool read_bytes(uint8_t a_register, uint8_t *data, uint8_t len) {
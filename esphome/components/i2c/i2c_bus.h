@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -29,6 +30,9 @@ struct WriteBuffer {
 
 class I2CBus {
  public:
+  /// Called from the main loop with the result of an asynchronous transaction
+  using TransactionCallback = std::function<void(ErrorCode)>;
+
   virtual ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) {
     ReadBuffer buf;
     buf.data = buffer;
@@ -50,7 +54,26 @@ class I2CBus {
   }
   virtual ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) = 0;
 
+  /** Write write_len bytes and then read read_len bytes, without blocking the main loop on the bus.
+   *
+   * The write data is copied, read_data must stay valid until the callback has been called. Buses that can't run
+   * transactions in the background perform it right away and call the callback before returning.
+   */
+  virtual void transfer_async(uint8_t address, const uint8_t *write_data, size_t write_len, uint8_t *read_data,
+                              size_t read_len, TransactionCallback &&callback) {
+    callback(this->transfer_(address, write_data, write_len, read_data, read_len));
+  }
+
  protected:
+  ErrorCode transfer_(uint8_t address, const uint8_t *write_data, size_t write_len, uint8_t *read_data,
+                      size_t read_len) {
+    ErrorCode err = ERROR_OK;
+    if (write_len > 0)
+      err = this->write(address, write_data, write_len, true);
+    if (err == ERROR_OK && read_len > 0)
+      err = this->read(address, read_data, read_len);
+    return err;
+  }
   void i2c_scan_() {
     for (uint8_t address = 8; address < 120; address++) {
       auto err = writev(address, nullptr, 0);
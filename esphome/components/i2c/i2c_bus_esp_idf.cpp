@@ -12,6 +12,8 @@ namespace esphome {
 namespace i2c {
 
 static const char *const TAG = "i2c.idf";
+static const size_t ASYNC_QUEUE_LENGTH = 16;
+static const uint32_t ASYNC_TASK_STACK_SIZE = 3072;
 
 void IDFI2CBus::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2C bus...");
@@ -226,6 +228,69 @@ ErrorCode IDFI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt, b
   return ERROR_OK;
 }
 
+void IDFI2CBus::loop() {
+  if (this->async_done_ == nullptr)
+    return;
+  AsyncTransaction *transaction;
+  while (xQueueReceive(this->async_done_, &transaction, 0) == pdTRUE) {
+    transaction->callback(transaction->result);
+    delete transaction;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+}
+
+void IDFI2CBus::transfer_async(uint8_t address, const uint8_t *write_data, size_t write_len, uint8_t *read_data,
+                               size_t read_len, TransactionCallback &&callback) {
+  if (!this->initialized_) {
+    callback(ERROR_NOT_INITIALIZED);
+    return;
+  }
+  if (this->async_task_handle_ == nullptr && !this->start_async_task_()) {
+    callback(this->transfer_(address, write_data, write_len, read_data, read_len));
+    return;
+  }
+  auto *transaction = new AsyncTransaction{  // NOLINT(cppcoreguidelines-owning-memory)
+      address, std::vector<uint8_t>(write_data, write_data + write_len), read_data, read_len, std::move(callback),
+      ERROR_OK};
+  if (xQueueSend(this->async_pending_, &transaction, 0) != pdTRUE) {
+    // queue is full, don't lose the transaction but run it in the caller
+    ESP_LOGV(TAG, "Async queue full, running transaction synchronously");
+    transaction->callback(this->transfer_(address, write_data, write_len, read_data, read_len));
+    delete transaction;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+}
+
+bool IDFI2CBus::start_async_task_() {
+  this->async_pending_ = xQueueCreate(ASYNC_QUEUE_LENGTH, sizeof(AsyncTransaction *));
+  this->async_done_ = xQueueCreate(ASYNC_QUEUE_LENGTH, sizeof(AsyncTransaction *));
+  if (this->async_pending_ == nullptr || this->async_done_ == nullptr ||
+      xTaskCreate(IDFI2CBus::async_task, "i2c_async", ASYNC_TASK_STACK_SIZE, this, 1, &this->async_task_handle_) !=
+          pdPASS) {
+    ESP_LOGW(TAG, "Could not start the async transaction task");
+    if (this->async_pending_ != nullptr)
+      vQueueDelete(this->async_pending_);
+    if (this->async_done_ != nullptr)
+      vQueueDelete(this->async_done_);
+    this->async_pending_ = nullptr;
+    this->async_done_ = nullptr;
+    this->async_task_handle_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void IDFI2CBus::async_task(void *param) {
+  auto *bus = static_cast<IDFI2CBus *>(param);
+  AsyncTransaction *transaction;
+  while (true) {
+    if (xQueueReceive(bus->async_pending_, &transaction, portMAX_DELAY) != pdTRUE)
+      continue;
+    // the driver serializes this with transactions from the main loop
+    transaction->result = bus->transfer_(transaction->address, transaction->write_data.data(),
+                                         transaction->write_data.size(), transaction->read_data, transaction->read_len);
+    xQueueSend(bus->async_done_, &transaction, portMAX_DELAY);
+  }
+}
+
 /// Perform I2C bus recovery, see:
 /// https://www.nxp.com/docs/en/user-guide/UM10204.pdf
 /// https://www.analog.com/media/en/technical-documentation/application-notes/54305147357414AN686_0.pdf
@@ -5,6 +5,10 @@
 #include "i2c_bus.h"
 #include "esphome/core/component.h"
 #include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <vector>
 
 namespace esphome {
 namespace i2c {
@@ -19,8 +23,11 @@ class IDFI2CBus : public I2CBus, public Component {
  public:
   void setup() override;
   void dump_config() override;
+  void loop() override;
   ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
   ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) override;
+  void transfer_async(uint8_t address, const uint8_t *write_data, size_t write_len, uint8_t *read_data,
+                      size_t read_len, TransactionCallback &&callback) override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
   void set_scan(bool scan) { scan_ = scan; }
@@ -42,6 +49,21 @@ class IDFI2CBus : public I2CBus, public Component {
   bool scl_pullup_enabled_;
   uint32_t frequency_;
   bool initialized_ = false;
+
+  struct AsyncTransaction {
+    uint8_t address;
+    std::vector<uint8_t> write_data;
+    uint8_t *read_data;
+    size_t read_len;
+    TransactionCallback callback;
+    ErrorCode result;
+  };
+  static void async_task(void *param);
+  bool start_async_task_();
+  /// Transactions waiting for the worker task, and those waiting for their callback in loop()
+  QueueHandle_t async_pending_{nullptr};
+  QueueHandle_t async_done_{nullptr};
+  TaskHandle_t async_task_handle_{nullptr};
 };
 
 }  // namespace i2c
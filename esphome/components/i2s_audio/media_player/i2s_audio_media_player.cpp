@@ -4,12 +4,26 @@
 
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 namespace esphome {
 namespace i2s_audio {
 
 static const char *const TAG = "audio";
 
 void I2SAudioMediaPlayer::control(const media_player::MediaPlayerCall &call) {
+  bool changed;
+  {
+    LockGuard lock(this->audio_lock_);
+    changed = this->control_(call);
+  }
+  // Outside of the lock, state callbacks may control the player again
+  if (changed)
+    this->publish_state();
+}
+
+bool I2SAudioMediaPlayer::control_(const media_player::MediaPlayerCall &call) {
   if (call.get_media_url().has_value()) {
     this->current_url_ = call.get_media_url();
 
@@ -28,7 +42,7 @@ void I2SAudioMediaPlayer::control(const media_player::MediaPlayerCall &call) {
     this->unmute_();
   }
   if (this->i2s_state_ != I2S_STATE_RUNNING) {
-    return;
+    return false;
   }
   if (call.get_command().has_value()) {
     switch (call.get_command().value()) {
@@ -77,7 +91,7 @@ void I2SAudioMediaPlayer::control(const media_player::MediaPlayerCall &call) {
       }
     }
   }
-  this->publish_state();
+  return true;
 }
 
 void I2SAudioMediaPlayer::mute_() {
@@ -105,9 +119,53 @@ void I2SAudioMediaPlayer::set_volume_(float volume, bool publish) {
 
 void I2SAudioMediaPlayer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Audio...");
+  // Above the main loop, the task sleeps in between and only needs a fraction of the core
+  const UBaseType_t priority = uxTaskPriorityGet(nullptr) + 1;
+#if portNUM_PROCESSORS > 1
+  const BaseType_t core = 1 - xPortGetCoreID();
+#else
+  const BaseType_t core = tskNO_AFFINITY;
+#endif
+  if (xTaskCreatePinnedToCore(I2SAudioMediaPlayer::audio_task, "audio", 8192, this, priority,
+                              &this->audio_task_handle_, core) != pdPASS) {
+    ESP_LOGE(TAG, "Could not create the audio task");
+    this->mark_failed();
+    return;
+  }
   this->state = media_player::MEDIA_PLAYER_STATE_IDLE;
 }
 
+void I2SAudioMediaPlayer::audio_task(void *params) {
+  auto *player = static_cast<I2SAudioMediaPlayer *>(params);
+  while (true) {
+    if (!player->run_audio_loop_()) {
+      // Woken up by start_()
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    // Audio::loop() returns once it would block on I2S or the network
+    vTaskDelay(1);
+  }
+}
+
+bool I2SAudioMediaPlayer::run_audio_loop_() {
+  LockGuard lock(this->audio_lock_);
+  if (this->audio_ == nullptr)
+    return false;
+  this->audio_->loop();
+
+  const uint32_t fill = this->audio_->inBufferFilled();
+  if (this->audio_->isRunning() && this->min_buffer_fill_ != UINT32_MAX) {
+    if (fill == 0 && this->buffer_fill_ != 0)
+      this->underruns_++;
+    this->min_buffer_fill_ = std::min(this->min_buffer_fill_, fill);
+  } else if (fill > 0 && this->min_buffer_fill_ == UINT32_MAX) {
+    this->min_buffer_fill_ = fill;
+  }
+  this->buffer_fill_ = fill;
+  return true;
+}
+
 void I2SAudioMediaPlayer::loop() {
   switch (this->i2s_state_) {
     case I2S_STATE_STARTING:
@@ -125,10 +183,13 @@ void I2SAudioMediaPlayer::loop() {
 }
 
 void I2SAudioMediaPlayer::play_() {
-  this->audio_->loop();
-  if (this->state == media_player::MEDIA_PLAYER_STATE_PLAYING && !this->audio_->isRunning()) {
+  // Don't wait for the audio task, just check again next time
+  if (!this->audio_lock_.try_lock())
+    return;
+  const bool ended = this->state == media_player::MEDIA_PLAYER_STATE_PLAYING && !this->audio_->isRunning();
+  this->audio_lock_.unlock();
+  if (ended)
     this->stop();
-  }
 }
 
 void I2SAudioMediaPlayer::start() { this->i2s_state_ = I2S_STATE_STARTING; }
@@ -136,6 +197,7 @@ void I2SAudioMediaPlayer::start_() {
   if (!this->parent_->try_lock()) {
     return;  // Waiting for another i2s to return lock
   }
+  LockGuard lock(this->audio_lock_);
 
 #if SOC_I2S_SUPPORTS_DAC
   if (this->internal_dac_mode_ != I2S_DAC_CHANNEL_DISABLE) {
@@ -159,12 +221,16 @@ void I2SAudioMediaPlayer::start_() {
 #endif
 
   this->i2s_state_ = I2S_STATE_RUNNING;
-  this->high_freq_.start();
+  this->underruns_ = 0;
+  this->buffer_fill_ = 0;
+  this->min_buffer_fill_ = UINT32_MAX;
+  xTaskNotifyGive(this->audio_task_handle_);
   this->audio_->setVolume(remap<uint8_t, float>(this->volume, 0.0f, 1.0f, 0, 21));
   if (this->current_url_.has_value()) {
     this->audio_->connecttohost(this->current_url_.value().c_str());
     this->state = media_player::MEDIA_PLAYER_STATE_PLAYING;
-    this->publish_state();
+    // Publish outside of the lock, state callbacks may control the player again
+    this->defer([this]() { this->publish_state(); });
   }
 }
 void I2SAudioMediaPlayer::stop() {
@@ -178,17 +244,23 @@ void I2SAudioMediaPlayer::stop() {
   this->i2s_state_ = I2S_STATE_STOPPING;
 }
 void I2SAudioMediaPlayer::stop_() {
-  if (this->audio_->isRunning()) {
-    this->audio_->stopSong();
-    return;
+  {
+    LockGuard lock(this->audio_lock_);
+    if (this->audio_->isRunning()) {
+      this->audio_->stopSong();
+      return;
+    }
+    this->audio_ = nullptr;
+  }
+  if (this->min_buffer_fill_ != UINT32_MAX) {
+    ESP_LOGD(TAG, "Playback ended, %" PRIu32 " underruns, lowest buffer fill %" PRIu32 " bytes", this->underruns_,
+             this->min_buffer_fill_);
   }
 
-  this->audio_ = nullptr;
   this->current_url_ = {};
   this->parent_->unlock();
   this->i2s_state_ = I2S_STATE_STOPPED;
 
-  this->high_freq_.stop();
   this->state = media_player::MEDIA_PLAYER_STATE_IDLE;
   this->publish_state();
 }
@@ -5,6 +5,8 @@
 #include "../i2s_audio.h"
 
 #include <driver/i2s.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 #include "esphome/components/media_player/media_player.h"
 #include "esphome/core/component.h"
@@ -23,6 +25,12 @@ enum I2SState : uint8_t {
   I2S_STATE_STOPPING,
 };
 
+/** Plays URLs with the ESP32-audioI2S library.
+ *
+ * The library fetches, buffers (in PSRAM when there is some), decodes and writes to I2S from Audio::loop(). That runs
+ * on a task of its own on the other core, so stalls of the main loop don't starve I2S. Everything else that touches
+ * the Audio object does so under audio_lock_.
+ */
 class I2SAudioMediaPlayer : public Component, public media_player::MediaPlayer, public I2SAudioOut {
  public:
   void setup() override;
@@ -48,8 +56,15 @@ class I2SAudioMediaPlayer : public Component, public media_player::MediaPlayer,
   void start();
   void stop();
 
+  /// Times the input buffer ran empty during playback of the current or last stream, the end of a file counts too.
+  uint32_t get_underruns() const { return this->underruns_; }
+  /// Bytes of the current stream in the input buffer.
+  uint32_t get_buffer_fill() const { return this->buffer_fill_; }
+
  protected:
   void control(const media_player::MediaPlayerCall &call) override;
+  /// Apply the call with audio_lock_ held, returns whether the state has to be published.
+  bool control_(const media_player::MediaPlayerCall &call);
 
   void mute_();
   void unmute_();
@@ -59,8 +74,19 @@ class I2SAudioMediaPlayer : public Component, public media_player::MediaPlayer,
   void stop_();
   void play_();
 
+  static void audio_task(void *params);
+  /// Called by the audio task, returns false while there is nothing to play.
+  bool run_audio_loop_();
+
   I2SState i2s_state_{I2S_STATE_STOPPED};
   std::unique_ptr<Audio> audio_;
+  Mutex audio_lock_;
+  TaskHandle_t audio_task_handle_{nullptr};
+
+  uint32_t underruns_{0};
+  uint32_t buffer_fill_{0};
+  /// Lowest buffer fill since the buffer first filled up, UINT32_MAX before that.
+  uint32_t min_buffer_fill_{UINT32_MAX};
 
   uint8_t dout_pin_{0};
 
@@ -75,8 +101,6 @@ class I2SAudioMediaPlayer : public Component, public media_player::MediaPlayer,
 
   bool i2s_comm_fmt_lsb_;
 
-  HighFrequencyLoopRequester high_freq_;
-
   optional<std::string> current_url_{};
 };
 
@@ -5,12 +5,15 @@
 #include <driver/i2s.h>
 
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
 namespace i2s_audio {
 
 static const size_t BUFFER_SIZE = 512;
+/// Half a second of 16 kHz 16 bit mono audio, enough to ride out a slow main loop.
+static const size_t RING_BUFFER_SIZE = 16000;
 
 static const char *const TAG = "i2s_audio.microphone";
 
@@ -80,10 +83,50 @@ void I2SAudioMicrophone::start_() {
 #if SOC_I2S_SUPPORTS_ADC
   }
 #endif
+
+  if (this->ring_buffer_ == nullptr) {
+    ExternalRAMAllocator<uint8_t> allocator(HeapTag::AUDIO, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    uint8_t *storage = allocator.allocate(RING_BUFFER_SIZE);
+    if (storage != nullptr) {
+      this->ring_buffer_ =
+          xRingbufferCreateStatic(RING_BUFFER_SIZE, RINGBUF_TYPE_BYTEBUF, storage, &this->ring_buffer_struct_);
+    }
+  }
+  this->reader_running_ = true;
+  this->reader_active_ = true;
+  if (this->ring_buffer_ == nullptr ||
+      xTaskCreate(I2SAudioMicrophone::reader_task, "mic_reader", 4096, (void *) this, 10,
+                  &this->reader_task_handle_) != pdPASS) {
+    ESP_LOGE(TAG, "Could not start the microphone reader task");
+    this->reader_running_ = false;
+    this->reader_active_ = false;
+    i2s_driver_uninstall(this->parent_->get_port());
+    this->parent_->unlock();
+    this->state_ = microphone::STATE_STOPPED;
+    this->mark_failed();
+    return;
+  }
   this->state_ = microphone::STATE_RUNNING;
   this->high_freq_.start();
 }
 
+void I2SAudioMicrophone::reader_task(void *params) {
+  I2SAudioMicrophone *this_mic = (I2SAudioMicrophone *) params;
+  // room for BUFFER_SIZE bytes of 32 bit samples, which shrink to 16 bit in place
+  int16_t buffer[BUFFER_SIZE / sizeof(int16_t)];
+
+  while (this_mic->reader_running_) {
+    size_t bytes_read = this_mic->read_i2s_(buffer, BUFFER_SIZE);
+    if (bytes_read == 0)
+      continue;
+    if (xRingbufferSend(this_mic->ring_buffer_, buffer, bytes_read, 0) != pdTRUE)
+      this_mic->overrun_count_++;
+  }
+
+  this_mic->reader_active_ = false;
+  vTaskDelete(nullptr);
+}
+
 void I2SAudioMicrophone::stop() {
   if (this->state_ == microphone::STATE_STOPPED || this->is_failed())
     return;
@@ -95,6 +138,18 @@ void I2SAudioMicrophone::stop() {
 }
 
 void I2SAudioMicrophone::stop_() {
+  // the reader task is blocked in i2s_read for at most one read timeout
+  this->reader_running_ = false;
+  while (this->reader_active_)
+    delay(1);
+  this->reader_task_handle_ = nullptr;
+
+  // drop what was captured but not read
+  size_t len;
+  void *item;
+  while ((item = xRingbufferReceive(this->ring_buffer_, &len, 0)) != nullptr)
+    vRingbufferReturnItem(this->ring_buffer_, item);
+
   i2s_stop(this->parent_->get_port());
   i2s_driver_uninstall(this->parent_->get_port());
   this->parent_->unlock();
@@ -103,14 +158,31 @@ void I2SAudioMicrophone::stop_() {
 }
 
 size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
+  if (this->ring_buffer_ == nullptr || !this->is_running())
+    return 0;
+  auto *out = reinterpret_cast<uint8_t *>(buf);
+  size_t total = 0;
+  // the captured data may wrap around the end of the ring buffer, which takes a second receive
+  while (total < len) {
+    size_t received = 0;
+    auto *item = static_cast<uint8_t *>(xRingbufferReceiveUpTo(this->ring_buffer_, &received, 0, len - total));
+    if (item == nullptr)
+      break;
+    memcpy(out + total, item, received);
+    vRingbufferReturnItem(this->ring_buffer_, item);
+    total += received;
+  }
+  return total;
+}
+
+size_t I2SAudioMicrophone::read_i2s_(int16_t *buf, size_t len) {
   size_t bytes_read = 0;
   esp_err_t err = i2s_read(this->parent_->get_port(), buf, len, &bytes_read, (100 / portTICK_PERIOD_MS));
   if (err != ESP_OK) {
-    ESP_LOGW(TAG, "Error reading from I2S microphone: %s", esp_err_to_name(err));
-    this->status_set_warning();
+    // logged from the main loop, the logger must not be used from this task
+    this->read_error_ = err;
     return 0;
   }
-  this->status_clear_warning();
   if (this->bits_per_sample_ == I2S_BITS_PER_SAMPLE_16BIT) {
     return bytes_read;
   } else if (this->bits_per_sample_ == I2S_BITS_PER_SAMPLE_32BIT) {
@@ -131,8 +203,10 @@ size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
 
 void I2SAudioMicrophone::read_() {
   std::vector<int16_t> samples;
-  samples.resize(BUFFER_SIZE);
-  size_t bytes_read = this->read(samples.data(), BUFFER_SIZE / sizeof(int16_t));
+  samples.resize(BUFFER_SIZE / sizeof(int16_t));
+  size_t bytes_read = this->read(samples.data(), BUFFER_SIZE);
+  if (bytes_read == 0)
+    return;
   samples.resize(bytes_read / sizeof(int16_t));
   this->data_callbacks_.call(samples);
 }
@@ -148,6 +222,18 @@ void I2SAudioMicrophone::loop() {
       if (this->data_callbacks_.size() > 0) {
         this->read_();
       }
+      if (this->read_error_ != ESP_OK) {
+        ESP_LOGW(TAG, "Error reading from I2S microphone: %s", esp_err_to_name(this->read_error_));
+        this->read_error_ = ESP_OK;
+        this->status_set_warning();
+      } else {
+        this->status_clear_warning();
+      }
+      if (this->overrun_count_ != this->logged_overruns_) {
+        this->logged_overruns_ = this->overrun_count_;
+        ESP_LOGW(TAG, "Samples were dropped as they were not read in time, %u overruns so far",
+                 (unsigned) this->logged_overruns_);
+      }
       break;
     case microphone::STATE_STOPPING:
       this->stop_();
@@ -4,6 +4,12 @@
 
 #include "../i2s_audio.h"
 
+#include <atomic>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/ringbuf.h>
+#include <freertos/task.h>
+
 #include "esphome/components/microphone/microphone.h"
 #include "esphome/core/component.h"
 
@@ -37,6 +43,19 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
   void start_();
   void stop_();
   void read_();
+  /// Read from the I2S driver and convert to 16 bit samples, called from the reader task.
+  size_t read_i2s_(int16_t *buf, size_t len);
+
+  static void reader_task(void *params);
+
+  TaskHandle_t reader_task_handle_{nullptr};
+  /// Cleared by stop_() to ask the reader task to exit, the task clears reader_active_ once it is done with I2S.
+  std::atomic<bool> reader_running_{false};
+  std::atomic<bool> reader_active_{false};
+  RingbufHandle_t ring_buffer_{nullptr};
+  StaticRingbuffer_t ring_buffer_struct_;
+  std::atomic<esp_err_t> read_error_{ESP_OK};
+  uint32_t logged_overruns_{0};
 
   int8_t din_pin_{I2S_PIN_NO_CHANGE};
 #if SOC_I2S_SUPPORTS_ADC
@@ -23,6 +23,8 @@ i2s_dac_mode_t = cg.global_ns.enum("i2s_dac_mode_t")
 
 CONF_MUTE_PIN = "mute_pin"
 CONF_DAC_TYPE = "dac_type"
+CONF_DMA_BUFFER_COUNT = "dma_buffer_count"
+CONF_DMA_BUFFER_LENGTH = "dma_buffer_length"
 
 INTERNAL_DAC_OPTIONS = {
     "left": i2s_dac_mode_t.I2S_DAC_CHANNEL_LEFT_EN,
@@ -44,6 +46,15 @@ def validate_esp32_variant(config):
     return config
 
 
+DMA_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_DMA_BUFFER_COUNT, default=8): cv.int_range(min=2, max=128),
+        cv.Optional(CONF_DMA_BUFFER_LENGTH, default=1024): cv.int_range(
+            min=8, max=1024
+        ),
+    }
+)
+
 CONFIG_SCHEMA = cv.All(
     cv.typed_schema(
         {
@@ -53,7 +64,9 @@ CONFIG_SCHEMA = cv.All(
                     cv.GenerateID(CONF_I2S_AUDIO_ID): cv.use_id(I2SAudioComponent),
                     cv.Required(CONF_MODE): cv.enum(INTERNAL_DAC_OPTIONS, lower=True),
                 }
-            ).extend(cv.COMPONENT_SCHEMA),
+            )
+            .extend(DMA_SCHEMA)
+            .extend(cv.COMPONENT_SCHEMA),
             "external": speaker.SPEAKER_SCHEMA.extend(
                 {
                     cv.GenerateID(): cv.declare_id(I2SAudioSpeaker),
@@ -65,7 +78,9 @@ CONFIG_SCHEMA = cv.All(
                         *EXTERNAL_DAC_OPTIONS, lower=True
                     ),
                 }
-            ).extend(cv.COMPONENT_SCHEMA),
+            )
+            .extend(DMA_SCHEMA)
+            .extend(cv.COMPONENT_SCHEMA),
         },
         key=CONF_DAC_TYPE,
     ),
@@ -79,6 +94,8 @@ async def to_code(config):
     await speaker.register_speaker(var, config)
 
     await cg.register_parented(var, config[CONF_I2S_AUDIO_ID])
+    cg.add(var.set_dma_buffer_count(config[CONF_DMA_BUFFER_COUNT]))
+    cg.add(var.set_dma_buffer_length(config[CONF_DMA_BUFFER_LENGTH]))
 
     if config[CONF_DAC_TYPE] == "internal":
         cg.add(var.set_internal_dac_mode(config[CONF_MODE]))
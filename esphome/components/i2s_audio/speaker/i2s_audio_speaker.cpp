@@ -6,20 +6,31 @@
 
 #include "esphome/core/application.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
 namespace i2s_audio {
 
-static const size_t BUFFER_COUNT = 10;
+/// Bytes of 16 bit mono samples that can be queued ahead of the player task.
+static const size_t RING_BUFFER_SIZE = 10 * BUFFER_SIZE;
 
 static const char *const TAG = "i2s_audio.speaker";
 
 void I2SAudioSpeaker::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2S Audio Speaker...");
 
-  this->buffer_queue_ = xQueueCreate(BUFFER_COUNT, sizeof(DataEvent));
+  ExternalRAMAllocator<uint8_t> allocator(HeapTag::AUDIO, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  uint8_t *storage = allocator.allocate(RING_BUFFER_SIZE);
+  if (storage != nullptr) {
+    this->ring_buffer_ =
+        xRingbufferCreateStatic(RING_BUFFER_SIZE, RINGBUF_TYPE_BYTEBUF, storage, &this->ring_buffer_struct_);
+  }
   this->event_queue_ = xQueueCreate(20, sizeof(TaskEvent));
+  if (this->ring_buffer_ == nullptr || this->event_queue_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate the audio buffers");
+    this->mark_failed();
+  }
 }
 
 void I2SAudioSpeaker::start() { this->state_ = speaker::STATE_STARTING; }
@@ -28,6 +39,7 @@ void I2SAudioSpeaker::start_() {
     return;  // Waiting for another i2s component to return lock
   }
   this->state_ = speaker::STATE_RUNNING;
+  this->stop_requested_ = false;
 
   xTaskCreate(I2SAudioSpeaker::player_task, "speaker_task", 8192, (void *) this, 0, &this->player_task_handle_);
 }
@@ -46,8 +58,8 @@ void I2SAudioSpeaker::player_task(void *params) {
       .channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT,
       .communication_format = I2S_COMM_FORMAT_STAND_I2S,
       .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
-      .dma_buf_count = 8,
-      .dma_buf_len = 1024,
+      .dma_buf_count = this_speaker->dma_buffer_count_,
+      .dma_buf_len = this_speaker->dma_buffer_length_,
       .use_apll = false,
       .tx_desc_auto_clear = true,
       .fixed_mclk = I2S_PIN_NO_CHANGE,
@@ -75,48 +87,47 @@ void I2SAudioSpeaker::player_task(void *params) {
   }
 #endif
 
-  DataEvent data_event;
-
   event.type = TaskEventType::STARTED;
   xQueueSend(this_speaker->event_queue_, &event, portMAX_DELAY);
 
-  int16_t buffer[BUFFER_SIZE / 2];
+  // one 32 bit left/right frame per 16 bit mono sample
+  uint32_t frames[BUFFER_SIZE / sizeof(int16_t)];
 
-  while (true) {
-    if (xQueueReceive(this_speaker->buffer_queue_, &data_event, 100 / portTICK_PERIOD_MS) != pdTRUE) {
+  while (!this_speaker->stop_requested_) {
+    size_t len = 0;
+    auto *samples = static_cast<int16_t *>(
+        xRingbufferReceiveUpTo(this_speaker->ring_buffer_, &len, 100 / portTICK_PERIOD_MS, BUFFER_SIZE));
+    if (samples == nullptr) {
       break;  // End of audio from main thread
     }
-    if (data_event.stop) {
-      // Stop signal from main thread
-      while (xQueueReceive(this_speaker->buffer_queue_, &data_event, 0) == pdTRUE) {
-        // Flush queue
-      }
-      break;
+
+    const size_t count = len / sizeof(int16_t);
+    for (size_t i = 0; i < count; i++) {
+      const uint32_t sample = static_cast<uint16_t>(samples[i]);
+      frames[i] = (sample << 16) | sample;
     }
-    size_t bytes_written;
+    vRingbufferReturnItem(this_speaker->ring_buffer_, samples);
 
-    memmove(buffer, data_event.data, data_event.len);
-    size_t remaining = data_event.len / 2;
-    size_t current = 0;
-
-    while (remaining > 0) {
-      uint32_t sample = (buffer[current] << 16) | (buffer[current] & 0xFFFF);
-
-      esp_err_t err = i2s_write(this_speaker->parent_->get_port(), &sample, sizeof(sample), &bytes_written,
-                                (100 / portTICK_PERIOD_MS));
-      if (err != ESP_OK) {
-        event = {.type = TaskEventType::WARNING, .err = err};
-        xQueueSend(this_speaker->event_queue_, &event, portMAX_DELAY);
-        continue;
-      }
-      remaining--;
-      current++;
+    size_t bytes_written;
+    esp_err_t err = i2s_write(this_speaker->parent_->get_port(), frames, count * sizeof(uint32_t), &bytes_written,
+                              portMAX_DELAY);
+    if (err != ESP_OK) {
+      event = {.type = TaskEventType::WARNING, .err = err};
+      xQueueSend(this_speaker->event_queue_, &event, portMAX_DELAY);
+      continue;
     }
 
     event.type = TaskEventType::PLAYING;
     xQueueSend(this_speaker->event_queue_, &event, portMAX_DELAY);
   }
 
+  // Flush what was not played
+  size_t len;
+  void *item;
+  while ((item = xRingbufferReceive(this_speaker->ring_buffer_, &len, 0)) != nullptr) {
+    vRingbufferReturnItem(this_speaker->ring_buffer_, item);
+  }
+
   i2s_zero_dma_buffer(this_speaker->parent_->get_port());
 
   event.type = TaskEventType::STOPPING;
@@ -141,9 +152,7 @@ void I2SAudioSpeaker::stop() {
     return;
   }
   this->state_ = speaker::STATE_STOPPING;
-  DataEvent data;
-  data.stop = true;
-  xQueueSendToFront(this->buffer_queue_, &data, portMAX_DELAY);
+  this->stop_requested_ = true;
 }
 
 void I2SAudioSpeaker::watch_() {
@@ -186,24 +195,17 @@ void I2SAudioSpeaker::loop() {
 }
 
 size_t I2SAudioSpeaker::play(const uint8_t *data, size_t length) {
+  if (this->is_failed())
+    return 0;
   if (this->state_ != speaker::STATE_RUNNING && this->state_ != speaker::STATE_STARTING) {
     this->start();
   }
-  size_t remaining = length;
-  size_t index = 0;
-  while (remaining > 0) {
-    DataEvent event;
-    event.stop = false;
-    size_t to_send_length = std::min(remaining, BUFFER_SIZE);
-    event.len = to_send_length;
-    memcpy(event.data, data + index, to_send_length);
-    if (xQueueSend(this->buffer_queue_, &event, 0) != pdTRUE) {
-      return index;
-    }
-    remaining -= to_send_length;
-    index += to_send_length;
+  // Only whole samples, the player task reads 16 bit values straight from the buffer
+  length = std::min(length, xRingbufferGetCurFreeSize(this->ring_buffer_)) & ~size_t(1);
+  if (length == 0 || xRingbufferSend(this->ring_buffer_, data, length, 0) != pdTRUE) {
+    return 0;
   }
-  return index;
+  return length;
 }
 
 }  // namespace i2s_audio
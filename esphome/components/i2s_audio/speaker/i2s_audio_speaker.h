@@ -4,9 +4,12 @@
 
 #include "../i2s_audio.h"
 
+#include <atomic>
+
 #include <driver/i2s.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <freertos/ringbuf.h>
 
 #include "esphome/components/speaker/speaker.h"
 #include "esphome/core/component.h"
@@ -32,12 +35,6 @@ struct TaskEvent {
   esp_err_t err;
 };
 
-struct DataEvent {
-  bool stop;
-  size_t len;
-  uint8_t data[BUFFER_SIZE];
-};
-
 class I2SAudioSpeaker : public Component, public speaker::Speaker, public I2SAudioOut {
  public:
   float get_setup_priority() const override { return esphome::setup_priority::LATE; }
@@ -50,6 +47,8 @@ class I2SAudioSpeaker : public Component, public speaker::Speaker, public I2SAud
   void set_internal_dac_mode(i2s_dac_mode_t mode) { this->internal_dac_mode_ = mode; }
 #endif
   void set_external_dac_channels(uint8_t channels) { this->external_dac_channels_ = channels; }
+  void set_dma_buffer_count(uint8_t count) { this->dma_buffer_count_ = count; }
+  void set_dma_buffer_length(uint16_t length) { this->dma_buffer_length_ = length; }
 
   void start() override;
   void stop() override;
@@ -64,8 +63,14 @@ class I2SAudioSpeaker : public Component, public speaker::Speaker, public I2SAud
   static void player_task(void *params);
 
   TaskHandle_t player_task_handle_{nullptr};
-  QueueHandle_t buffer_queue_;
+  /// Samples written by play() and consumed by the player task straight from the buffer memory.
+  RingbufHandle_t ring_buffer_{nullptr};
+  StaticRingbuffer_t ring_buffer_struct_;
   QueueHandle_t event_queue_;
+  std::atomic<bool> stop_requested_{false};
+
+  uint8_t dma_buffer_count_{8};
+  uint16_t dma_buffer_length_{1024};
 
   uint8_t dout_pin_{0};
 
@@ -4,6 +4,7 @@ from esphome import core, pins
 from esphome.components import display, spi
 from esphome.core import CORE, HexInt
 from esphome.const import (
+    CONF_AUTO_CLEAR_ENABLED,
     CONF_COLOR_PALETTE,
     CONF_DC_PIN,
     CONF_ID,
@@ -54,6 +55,7 @@ COLOR_PALETTE = cv.one_of("NONE", "GRAYSCALE", "IMAGE_ADAPTIVE")
 
 CONF_LED_PIN = "led_pin"
 CONF_COLOR_PALETTE_IMAGES = "color_palette_images"
+CONF_BAND_HEIGHT = "band_height"
 
 
 def _validate(config):
@@ -70,6 +72,10 @@ def _validate(config):
         raise cv.Invalid(
             "Providing color palette images requires palette mode to be 'IMAGE_ADAPTIVE'"
         )
+    if CONF_BAND_HEIGHT in config and not config[CONF_AUTO_CLEAR_ENABLED]:
+        raise cv.Invalid(
+            "'band_height' only buffers part of the display and requires 'auto_clear_enabled'"
+        )
     if CORE.is_esp8266 and config.get(CONF_MODEL) not in [
         "M5STACK",
         "TFT_2.4",
@@ -100,6 +106,7 @@ CONFIG_SCHEMA = cv.All(
                 cv.file_
             ),
             cv.Optional(CONF_DATA_RATE, default="40MHz"): spi.SPI_DATA_RATE_SCHEMA,
+            cv.Optional(CONF_BAND_HEIGHT): cv.int_range(min=1, max=1024),
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -134,6 +141,9 @@ async def to_code(config):
             var.set_dimentions(config[CONF_DIMENSIONS][0], config[CONF_DIMENSIONS][1])
         )
 
+    if CONF_BAND_HEIGHT in config:
+        cg.add(var.set_band_height(config[CONF_BAND_HEIGHT]))
+
     rhs = None
     if config[CONF_COLOR_PALETTE] == "GRAYSCALE":
         cg.add(var.set_buffer_color_mode(ILI9XXXColorMode.BITS_8_INDEXED))
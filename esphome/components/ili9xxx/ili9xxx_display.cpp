@@ -1,4 +1,7 @@
 #include "ili9xxx_display.h"
+
+#include <utility>
+
 #include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -12,11 +15,10 @@ static const char *const TAG = "ili9xxx";
 void ILI9XXXDisplay::setup() {
   this->setup_pins_();
   this->initialize();
+  this->apply_rotation_();
 
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  if (this->band_height_ >= this->get_height_internal())
+    this->band_height_ = 0;
   if (this->buffer_color_mode_ == BITS_16) {
     this->init_internal_(this->get_buffer_length_() * 2);
     if (this->buffer_ != nullptr) {
@@ -27,9 +29,43 @@ void ILI9XXXDisplay::setup() {
   this->init_internal_(this->get_buffer_length_());
   if (this->buffer_ == nullptr) {
     this->mark_failed();
+    return;
+  }
+  this->init_color_tables_();
+}
+
+void ILI9XXXDisplay::init_color_tables_() {
+  this->last_native_valid_ = false;
+  if (this->buffer_color_mode_ == BITS_8_INDEXED)
+    this->palette_cache_ = make_unique<display::PaletteIndexCache>(this->palette_);
+  this->rgb565_lut_ = make_unique<uint16_t[]>(256);
+  for (uint16_t i = 0; i < 256; i++) {
+    Color color = this->buffer_color_mode_ == BITS_8_INDEXED
+                      ? display::ColorUtil::index8_to_color_palette888(i, this->palette_)
+                      : display::ColorUtil::rgb332_to_color(i);
+    this->rgb565_lut_[i] = display::ColorUtil::color_to_565(color);
   }
 }
 
+uint16_t HOT ILI9XXXDisplay::native_color_(Color color) {
+  if (this->last_native_valid_ && color == this->last_color_)
+    return this->last_native_color_;
+  switch (this->buffer_color_mode_) {
+    case BITS_8_INDEXED:
+      this->last_native_color_ = this->palette_cache_->lookup(color);
+      break;
+    case BITS_16:
+      this->last_native_color_ = display::ColorUtil::color_to_565(color, display::ColorOrder::COLOR_ORDER_RGB);
+      break;
+    default:
+      this->last_native_color_ = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
+      break;
+  }
+  this->last_color_ = color;
+  this->last_native_valid_ = true;
+  return this->last_native_color_;
+}
+
 void ILI9XXXDisplay::setup_pins_() {
   this->dc_pin_->setup();  // OUTPUT
   this->dc_pin_->digital_write(false);
@@ -59,6 +95,9 @@ void ILI9XXXDisplay::dump_config() {
   if (this->is_18bitdisplay_) {
     ESP_LOGCONFIG(TAG, "  18-Bit Mode: YES");
   }
+  if (this->band_height_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Band Height: %u", this->band_height_);
+  }
 
   LOG_PIN("  Reset Pin: ", this->reset_pin_);
   LOG_PIN("  DC Pin: ", this->dc_pin_);
@@ -73,34 +112,24 @@ void ILI9XXXDisplay::dump_config() {
 float ILI9XXXDisplay::get_setup_priority() const { return setup_priority::HARDWARE; }
 
 void ILI9XXXDisplay::fill(Color color) {
-  uint16_t new_color = 0;
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  uint16_t new_color = this->native_color_(color);
+  this->mark_all_dirty_();
   switch (this->buffer_color_mode_) {
-    case BITS_8_INDEXED:
-      new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
-      break;
-    case BITS_16:
-      new_color = display::ColorUtil::color_to_565(color);
-      {
-        const uint32_t buffer_length_16_bits = this->get_buffer_length_() * 2;
-        if (((uint8_t) (new_color >> 8)) == ((uint8_t) new_color)) {
-          // Upper and lower is equal can use quicker memset operation. Takes ~20ms.
-          memset(this->buffer_, (uint8_t) new_color, buffer_length_16_bits);
-        } else {
-          // Slower set of both buffers. Takes ~30ms.
-          for (uint32_t i = 0; i < buffer_length_16_bits; i = i + 2) {
-            this->buffer_[i] = (uint8_t) (new_color >> 8);
-            this->buffer_[i + 1] = (uint8_t) new_color;
-          }
+    case BITS_16: {
+      const uint32_t buffer_length_16_bits = this->get_buffer_length_() * 2;
+      if (((uint8_t) (new_color >> 8)) == ((uint8_t) new_color)) {
+        // Upper and lower is equal can use quicker memset operation. Takes ~20ms.
+        memset(this->buffer_, (uint8_t) new_color, buffer_length_16_bits);
+      } else {
+        // Slower set of both buffers. Takes ~30ms.
+        for (uint32_t i = 0; i < buffer_length_16_bits; i = i + 2) {
+          this->buffer_[i] = (uint8_t) (new_color >> 8);
+          this->buffer_[i + 1] = (uint8_t) new_color;
         }
       }
       return;
-      break;
+    }
     default:
-      new_color = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
       break;
   }
   memset(this->buffer_, (uint8_t) new_color, this->get_buffer_length_());
@@ -110,16 +139,15 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0) {
     return;
   }
-  uint32_t pos = (y * width_) + x;
-  uint16_t new_color;
+  if (this->band_height_ != 0 && (y < this->band_start_ || y >= this->band_start_ + this->band_height_)) {
+    return;
+  }
+  uint32_t pos = ((y - this->band_start_) * width_) + x;
+  uint16_t new_color = this->native_color_(color);
   bool updated = false;
   switch (this->buffer_color_mode_) {
-    case BITS_8_INDEXED:
-      new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
-      break;
     case BITS_16:
       pos = pos * 2;
-      new_color = display::ColorUtil::color_to_565(color, display::ColorOrder::COLOR_ORDER_RGB);
       if (this->buffer_[pos] != (uint8_t) (new_color >> 8)) {
         this->buffer_[pos] = (uint8_t) (new_color >> 8);
         updated = true;
@@ -128,7 +156,6 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
       new_color = new_color & 0xFF;
       break;
     default:
-      new_color = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
       break;
   }
 
@@ -137,16 +164,72 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
     updated = true;
   }
   if (updated) {
-    // low and high watermark may speed up drawing from buffer
-    this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-    this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-    this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-    this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
-    // ESP_LOGVV(TAG, "=>>> pixel (x:%d, y:%d) (xl:%d, xh:%d, yl:%d, yh:%d", x, y, this->x_low_, this->x_high_,
-    //           this->y_low_, this->y_high_);
+    // only the changed regions are sent to the display
+    this->mark_dirty_(x, y);
   }
 }
 
+void HOT ILI9XXXDisplay::fill_absolute_rect_internal(int x, int y, int w, int h, Color color) {
+  if (this->band_height_ != 0) {
+    int band_end = this->band_start_ + this->band_height_;
+    h = std::min(y + h, band_end) - std::max(y, (int) this->band_start_);
+    y = std::max(y, (int) this->band_start_);
+    if (h <= 0)
+      return;
+  }
+  // convert the color once and write it straight into the buffer
+  bool updated = false;
+  if (this->buffer_color_mode_ == BITS_16) {
+    uint16_t new_color = this->native_color_(color);
+    uint8_t hi = new_color >> 8, lo = new_color;
+    for (int row = y; row < y + h; row++) {
+      uint8_t *pos = this->buffer_ + (((row - this->band_start_) * this->width_) + x) * 2;
+      for (int i = 0; i < w; i++, pos += 2) {
+        if (pos[0] != hi || pos[1] != lo) {
+          pos[0] = hi;
+          pos[1] = lo;
+          updated = true;
+        }
+      }
+    }
+  } else {
+    uint8_t new_color = this->native_color_(color);
+    for (int row = y; row < y + h; row++) {
+      uint8_t *pos = this->buffer_ + ((row - this->band_start_) * this->width_) + x;
+      for (int i = 0; i < w; i++) {
+        if (pos[i] != new_color) {
+          pos[i] = new_color;
+          updated = true;
+        }
+      }
+    }
+  }
+  if (updated)
+    this->mark_dirty_(display::Rect(x, y, w, h));
+}
+
+void HOT ILI9XXXDisplay::draw_absolute_rgb565_internal(int x, int y, int width, const uint8_t *data) {
+  if (this->buffer_color_mode_ != BITS_16) {
+    DisplayBuffer::draw_absolute_rgb565_internal(x, y, width, data);
+    return;
+  }
+  if (this->band_height_ != 0 && (y < this->band_start_ || y >= this->band_start_ + this->band_height_))
+    return;
+  // the buffer holds big endian RGB565 as well, copy the row and only mark the part that changed
+  uint8_t *pos = this->buffer_ + (((y - this->band_start_) * this->width_) + x) * 2;
+  int first = width, last = -1;
+  for (int i = 0; i < width * 2; i++) {
+    uint8_t value = progmem_read_byte(data + i);
+    if (pos[i] != value) {
+      pos[i] = value;
+      first = std::min(first, i / 2);
+      last = i / 2;
+    }
+  }
+  if (last >= first)
+    this->mark_dirty_(display::Rect(x + first, y, last - first + 1, 1));
+}
+
 void ILI9XXXDisplay::update() {
   if (this->prossing_update_) {
     this->need_update_ = true;
@@ -155,32 +238,83 @@ void ILI9XXXDisplay::update() {
   this->prossing_update_ = true;
   do {
     this->need_update_ = false;
-    this->do_update_();
+    if (this->band_height_ != 0) {
+      this->display_bands_();
+    } else {
+      this->do_update_();
+    }
   } while (this->need_update_);
   this->prossing_update_ = false;
-  this->display_();
+  if (this->band_height_ == 0)
+    this->display_();
 }
 
 void ILI9XXXDisplay::display_() {
-  // we will only update the changed window to the display
-  uint16_t w = this->x_high_ - this->x_low_ + 1;  // NOLINT
-  uint16_t h = this->y_high_ - this->y_low_ + 1;  // NOLINT
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
-
   // check if something was displayed
-  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
+  if (this->get_dirty_count_() == 0) {
     ESP_LOGV(TAG, "Nothing to display");
     return;
   }
 
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
+  // we will only update the changed windows to the display
+  for (uint8_t i = 0; i < this->get_dirty_count_(); i++)
+    this->display_window_(this->get_dirty_rects_()[i]);
+
+  this->clear_dirty_();
+}
+
+void ILI9XXXDisplay::display_bands_() {
+  // the writer runs once per band, drawing outside of the band is clipped and sending a band waits for its DMA
+  // transfers before the buffer is reused for the next one
+  for (int16_t start = 0; start < this->height_; start += this->band_height_) {
+    int16_t rows = std::min<int16_t>(this->band_height_, this->height_ - start);
+    this->band_start_ = start;
+    this->start_clipping(this->band_clipping_(start, rows));
+    this->do_update_();
+    this->display_window_(display::Rect(0, start, this->width_, rows));
+  }
+  this->band_start_ = 0;
+  this->clear_dirty_();
+}
+
+display::Rect ILI9XXXDisplay::band_clipping_(int16_t start, int16_t rows) {
+  // the band is a range of display rows, convert it to the rotated coordinates the writer draws in
+  switch (this->get_software_rotation_()) {
+    case display::DISPLAY_ROTATION_90_DEGREES:
+      return display::Rect(start, 0, rows, this->get_height());
+    case display::DISPLAY_ROTATION_180_DEGREES:
+      return display::Rect(0, this->height_ - start - rows, this->get_width(), rows);
+    case display::DISPLAY_ROTATION_270_DEGREES:
+      return display::Rect(this->height_ - start - rows, 0, rows, this->get_height());
+    default:
+      return display::Rect(0, start, this->get_width(), rows);
+  }
+}
+
+void ILI9XXXDisplay::display_window_(const display::Rect &window) {
+  uint16_t w = window.w;  // NOLINT
+  uint16_t h = window.h;  // NOLINT
+  uint32_t start_pos = (((window.y - this->band_start_) * this->width_) + window.x);
+
+  set_addr_window_(window.x, window.y, w, h);
 
   ESP_LOGV(TAG,
            "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%d, "
            "heigth:%d, start_pos:%d)",
-           this->x_low_, this->y_low_, this->x_high_, this->y_high_, w, h, start_pos);
+           window.x, window.y, window.x2() - 1, window.y2() - 1, w, h, start_pos);
 
   this->start_data_();
+  if (this->buffer_color_mode_ == BITS_16 && !this->is_18bitdisplay_) {
+    // the buffer already holds the pixels as the display expects them, let the DMA send them from there
+    if (w == this->width_) {
+      this->write_array_async(this->buffer_ + start_pos * 2, uint32_t(w) * h * 2);
+    } else {
+      for (uint16_t row = 0; row < h; row++)
+        this->write_array_async(this->buffer_ + (start_pos + row * width_) * 2, w * 2);
+    }
+    this->end_data_();
+    return;
+  }
   for (uint16_t row = 0; row < h; row++) {
     uint32_t pos = start_pos + (row * width_);
     uint32_t rem = w;
@@ -206,7 +340,15 @@ void ILI9XXXDisplay::display_() {
           this->write_array(pass_buff, sizeof(pass_buff));
         }
       } else {
-        this->write_array16(transfer_buffer_, sz);
+        // fill one half of the send buffer while the other one is being sent
+        this->wait_async(1);
+        uint8_t *send_buffer = this->send_buffer_[this->send_index_];
+        this->send_index_ ^= 1;
+        for (uint32_t i = 0; i < sz; ++i) {
+          send_buffer[i * 2] = transfer_buffer_[i] >> 8;
+          send_buffer[i * 2 + 1] = transfer_buffer_[i];
+        }
+        this->write_array_async(send_buffer, sz * 2);
       }
       pos += sz;
       rem -= sz;
@@ -214,37 +356,26 @@ void ILI9XXXDisplay::display_() {
     App.feed_wdt();
   }
   this->end_data_();
-
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
 }
 
 uint32_t ILI9XXXDisplay::buffer_to_transfer_(uint32_t pos, uint32_t sz) {
-  for (uint32_t i = 0; i < sz; ++i) {
-    switch (this->buffer_color_mode_) {
-      case BITS_8_INDEXED:
-        transfer_buffer_[i] = display::ColorUtil::color_to_565(
-            display::ColorUtil::index8_to_color_palette888(this->buffer_[pos + i], this->palette_));
-        break;
-      case BITS_16:
-        transfer_buffer_[i] = ((uint16_t) this->buffer_[(pos + i) * 2] << 8) | this->buffer_[((pos + i) * 2) + 1];
-        continue;
-        break;
-      default:
-        transfer_buffer_[i] =
-            display::ColorUtil::color_to_565(display::ColorUtil::rgb332_to_color(this->buffer_[pos + i]));
-        break;
-    }
+  if (this->buffer_color_mode_ == BITS_16) {
+    for (uint32_t i = 0; i < sz; ++i)
+      transfer_buffer_[i] = ((uint16_t) this->buffer_[(pos + i) * 2] << 8) | this->buffer_[((pos + i) * 2) + 1];
+  } else {
+    for (uint32_t i = 0; i < sz; ++i)
+      transfer_buffer_[i] = this->rgb565_lut_[this->buffer_[pos + i]];
   }
   return sz;
 }
 
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
 // values per bit is huge
-uint32_t ILI9XXXDisplay::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal(); }
+uint32_t ILI9XXXDisplay::get_buffer_length_() {
+  if (this->band_height_ != 0)
+    return this->get_width_internal() * this->band_height_;
+  return this->get_width_internal() * this->get_height_internal();
+}
 
 void ILI9XXXDisplay::command(uint8_t value) {
   this->start_command_();
@@ -306,6 +437,8 @@ void ILI9XXXDisplay::init_lcd_(const uint8_t *init_cmd) {
   while ((cmd = progmem_read_byte(addr++)) > 0) {
     x = progmem_read_byte(addr++);
     num_args = x & 0x7F;
+    if (cmd == ILI9XXX_MADCTL && num_args == 1)
+      this->madctl_ = progmem_read_byte(addr);
     send_command(cmd, addr, num_args);
     addr += num_args;
     if (x & 0x80)
@@ -313,6 +446,19 @@ void ILI9XXXDisplay::init_lcd_(const uint8_t *init_cmd) {
   }
 }
 
+void ILI9XXXDisplay::apply_rotation_() {
+  // Let the controller rotate, so the buffer is kept in the rotated orientation and pixels aren't transformed one by
+  // one. The configured size is the unrotated one.
+  if (this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES) {
+    uint8_t madctl = display::rotate_madctl(this->madctl_, this->rotation_);
+    this->send_command(ILI9XXX_MADCTL, &madctl, 1);
+  }
+  if (this->rotation_ == display::DISPLAY_ROTATION_90_DEGREES ||
+      this->rotation_ == display::DISPLAY_ROTATION_270_DEGREES)
+    std::swap(this->width_, this->height_);
+  this->set_hardware_rotation_();
+}
+
 void ILI9XXXDisplay::set_addr_window_(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h) {
   uint16_t x2 = (x1 + w - 1), y2 = (y1 + h - 1);
   this->command(ILI9XXX_CASET);  // Column address set
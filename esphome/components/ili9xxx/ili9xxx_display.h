@@ -4,6 +4,8 @@
 #include "ili9xxx_defines.h"
 #include "ili9xxx_init.h"
 
+#include <memory>
+
 namespace esphome {
 namespace ili9xxx {
 
@@ -33,6 +35,8 @@ class ILI9XXXDisplay : public PollingComponent,
     this->height_ = height;
     this->width_ = width;
   }
+  /// Only buffer this many rows at a time, the display is then drawn in bands from top to bottom.
+  void set_band_height(uint16_t band_height) { this->band_height_ = band_height; }
   void command(uint8_t value);
   void data(uint8_t value);
   void send_command(uint8_t command_byte, const uint8_t *data_bytes, uint8_t num_data_bytes);
@@ -49,26 +53,42 @@ class ILI9XXXDisplay : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int w, int h, Color color) override;
+  void draw_absolute_rgb565_internal(int x, int y, int width, const uint8_t *data) override;
   void setup_pins_();
   virtual void initialize() = 0;
 
   void display_();
+  void display_bands_();
+  void display_window_(const display::Rect &window);
+  display::Rect band_clipping_(int16_t start, int16_t rows);
   void init_lcd_(const uint8_t *init_cmd);
+  void apply_rotation_();
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
   void invert_display_(bool invert);
   void reset_();
 
   int16_t width_{0};   ///< Display width as modified by current rotation
   int16_t height_{0};  ///< Display height as modified by current rotation
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
+  uint8_t madctl_{0};  ///< Memory access control the init sequence left the controller in
   const uint8_t *palette_;
+  /// Index lookups for BITS_8_INDEXED.
+  std::unique_ptr<display::PaletteIndexCache> palette_cache_;
+  /// RGB565 for every value of an 8 bit buffer, so sending it is a table lookup per pixel.
+  std::unique_ptr<uint16_t[]> rgb565_lut_;
+  /// The last color converted to the buffer format, pixels of a line or glyph mostly share one.
+  Color last_color_;
+  uint16_t last_native_color_{0};
+  bool last_native_valid_{false};
+  uint16_t band_height_{0};  ///< Rows held by the buffer, 0 buffers the whole display
+  int16_t band_start_{0};    ///< First display row held by the buffer
 
   ILI9XXXColorMode buffer_color_mode_{BITS_16};
 
   uint32_t get_buffer_length_();
+  /// Convert a color to the buffer format, RGB565, RGB332 or a palette index.
+  uint16_t native_color_(Color color);
+  void init_color_tables_();
   int get_width_internal() override;
   int get_height_internal() override;
 
@@ -78,6 +98,9 @@ class ILI9XXXDisplay : public PollingComponent,
   void end_data_();
 
   uint16_t transfer_buffer_[ILI9XXX_TRANSFER_BUFFER_SIZE];
+  /// Big endian copies of transfer_buffer_, one is filled while the other is being sent.
+  uint8_t send_buffer_[2][ILI9XXX_TRANSFER_BUFFER_SIZE * 2];
+  uint8_t send_index_{0};
 
   uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz);
 
@@ -41,6 +41,21 @@ IMAGE_TYPE = {
 }
 
 CONF_USE_TRANSPARENCY = "use_transparency"
+CONF_COMPRESSION = "compression"
+
+COMPRESSION_NONE = "NONE"
+COMPRESSION_RLE = "RLE"
+COMPRESSION_SCHEMA = cv.one_of(COMPRESSION_NONE, COMPRESSION_RLE, upper=True)
+
+# Bytes per pixel and the length of a row in bytes for every image type
+IMAGE_TYPE_PIXEL_SIZE = {
+    "BINARY": 1,
+    "TRANSPARENT_BINARY": 1,
+    "GRAYSCALE": 1,
+    "RGB565": 2,
+    "RGB24": 3,
+    "RGBA": 4,
+}
 
 # If the MDI file cannot be downloaded within this time, abort.
 MDI_DOWNLOAD_TIMEOUT = 30  # seconds
@@ -94,6 +109,49 @@ def validate_cairosvg_installed(value):
     return value
 
 
+def get_row_size(image_type, width):
+    if image_type in ["BINARY", "TRANSPARENT_BINARY"]:
+        return (width + 7) // 8
+    return width * IMAGE_TYPE_PIXEL_SIZE[image_type]
+
+
+def rle_encode(data, image_type, width):
+    """Run-length encode image data row by row, the way Image::decode_row_ reads it.
+
+    Every packet is a header byte holding the number of pixels minus one in the
+    lower 7 bits. With bit 7 set a single pixel follows that is repeated,
+    otherwise the pixels follow as they are. Binary images use bytes of 8 pixels.
+    """
+    unit = IMAGE_TYPE_PIXEL_SIZE[image_type]
+    row_size = get_row_size(image_type, width)
+    # a repeat packet has to save at least the header of the literal packet it splits
+    min_run = 3 if unit == 1 else 2
+    out = []
+    for start in range(0, len(data), row_size):
+        pixels = [data[i : i + unit] for i in range(start, start + row_size, unit)]
+        literal = []
+        i = 0
+        while i < len(pixels):
+            run = 1
+            while i + run < len(pixels) and run < 128 and pixels[i + run] == pixels[i]:
+                run += 1
+            if run < min_run:
+                literal.append(pixels[i])
+                i += 1
+                if len(literal) < 128 and i < len(pixels):
+                    continue
+            if literal:
+                out.append(len(literal) - 1)
+                for pixel in literal:
+                    out += pixel
+                literal = []
+            if run >= min_run:
+                out.append(0x80 | (run - 1))
+                out += pixels[i]
+                i += run
+    return out
+
+
 def validate_cross_dependencies(config):
     """
     Validate fields whose possible values depend on other fields.
@@ -192,6 +250,7 @@ IMAGE_SCHEMA = cv.Schema(
             cv.Optional(CONF_DITHER, default="NONE"): cv.one_of(
                 "NONE", "FLOYDSTEINBERG", upper=True
             ),
+            cv.Optional(CONF_COMPRESSION, default=COMPRESSION_NONE): COMPRESSION_SCHEMA,
             cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         },
         validate_cross_dependencies,
@@ -352,9 +411,15 @@ async def to_code(config):
             f"Image f{config[CONF_ID]} has an unsupported type: {config[CONF_TYPE]}."
         )
 
+    compressed = config[CONF_COMPRESSION] == COMPRESSION_RLE
+    if compressed:
+        data = rle_encode(data, config[CONF_TYPE], width)
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
     var = cg.new_Pvariable(
         config[CONF_ID], prog_arr, width, height, IMAGE_TYPE[config[CONF_TYPE]]
     )
     cg.add(var.set_transparency(transparent))
+    if compressed:
+        cg.add(var.set_compressed(True))
@@ -1,98 +1,128 @@
 #include "image.h"
 
+#include <memory>
+
 #include "esphome/core/hal.h"
 
 namespace esphome {
 namespace image {
 
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
-  switch (type_) {
+  if (!this->compressed_) {
+    if (this->type_ == IMAGE_TYPE_RGB565 && !this->transparent_) {
+      // the data is already laid out the way blit_rgb565 takes it
+      display->blit_rgb565(x, y, this->width_, this->height_, this->data_start_);
+      return;
+    }
+    for (int img_y = 0; img_y < this->height_; img_y++)
+      this->draw_row_(x, y + img_y, this->get_row_(img_y, nullptr), display, color_on, color_off);
+    return;
+  }
+
+  // decode one row at a time, the whole image never has to be held in RAM
+  std::unique_ptr<uint8_t[]> row(new uint8_t[this->get_row_size_()]);
+  const uint8_t *src = this->data_start_;
+  for (int img_y = 0; img_y < this->height_; img_y++) {
+    src = this->decode_row_(src, row.get());
+    this->draw_row_(x, y + img_y, row.get(), display, color_on, color_off);
+  }
+}
+void Image::draw_row_(int x, int y, const uint8_t *row, display::Display *display, Color color_on,
+                      Color color_off) const {
+  switch (this->type_) {
     case IMAGE_TYPE_BINARY: {
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          if (this->get_binary_pixel_(img_x, img_y)) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_on);
-          } else if (!this->transparent_) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_off);
-          }
+      for (int img_x = 0; img_x < this->width_; img_x++) {
+        if (this->get_binary_pixel_(row, img_x)) {
+          display->draw_pixel_at(x + img_x, y, color_on);
+        } else if (!this->transparent_) {
+          display->draw_pixel_at(x + img_x, y, color_off);
         }
       }
-      break;
+      return;
     }
-    case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_grayscale_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
-      break;
     case IMAGE_TYPE_RGB565:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb565_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
-      break;
-    case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb24_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
+      if (!this->transparent_) {
+        display->blit_rgb565(x, y, this->width_, 1, row);
+        return;
       }
       break;
-    case IMAGE_TYPE_RGBA:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgba_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+    default:
       break;
   }
+  for (int img_x = 0; img_x < this->width_; img_x++) {
+    auto color = this->get_color_pixel_(row, img_x);
+    if (color.w >= 0x80) {
+      display->draw_pixel_at(x + img_x, y, color);
+    }
+  }
 }
 Color Image::get_pixel(int x, int y, Color color_on, Color color_off) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return color_off;
+  std::unique_ptr<uint8_t[]> buffer;
+  if (this->compressed_)
+    buffer.reset(new uint8_t[this->get_row_size_()]);
+  const uint8_t *row = this->get_row_(y, buffer.get());
+  if (this->type_ == IMAGE_TYPE_BINARY)
+    return this->get_binary_pixel_(row, x) ? color_on : color_off;
+  return this->get_color_pixel_(row, x);
+}
+size_t Image::get_row_size_() const { return image_type_to_width_stride(this->width_, this->type_); }
+const uint8_t *Image::get_row_(int y, uint8_t *buffer) const {
+  if (!this->compressed_)
+    return this->data_start_ + y * this->get_row_size_();
+  const uint8_t *src = this->data_start_;
+  for (int row = 0; row <= y; row++)
+    src = this->decode_row_(src, buffer);
+  return buffer;
+}
+const uint8_t *Image::decode_row_(const uint8_t *src, uint8_t *row) const {
+  // every row is a series of packets, a header byte with the length in pixels and either one pixel to repeat
+  // (bit 7 set) or the pixels to copy
+  const size_t row_size = this->get_row_size_();
+  const size_t unit = this->type_ == IMAGE_TYPE_BINARY ? 1 : image_type_to_bpp(this->type_) / 8;
+  size_t pos = 0;
+  while (pos < row_size) {
+    const uint8_t header = progmem_read_byte(src++);
+    const size_t len = std::min<size_t>(((header & 0x7F) + 1) * unit, row_size - pos);
+    if (header & 0x80) {
+      for (size_t i = 0; i < len; i++)
+        row[pos + i] = progmem_read_byte(src + i % unit);
+      src += unit;
+    } else {
+      for (size_t i = 0; i < len; i++)
+        row[pos + i] = progmem_read_byte(src + i);
+      src += len;
+    }
+    pos += len;
+  }
+  return src;
+}
+Color Image::get_color_pixel_(const uint8_t *row, int x) const {
   switch (this->type_) {
-    case IMAGE_TYPE_BINARY:
-      return this->get_binary_pixel_(x, y) ? color_on : color_off;
     case IMAGE_TYPE_GRAYSCALE:
-      return this->get_grayscale_pixel_(x, y);
+      return this->get_grayscale_pixel_(row, x);
     case IMAGE_TYPE_RGB565:
-      return this->get_rgb565_pixel_(x, y);
+      return this->get_rgb565_pixel_(row, x);
     case IMAGE_TYPE_RGB24:
-      return this->get_rgb24_pixel_(x, y);
+      return this->get_rgb24_pixel_(row, x);
     case IMAGE_TYPE_RGBA:
-      return this->get_rgba_pixel_(x, y);
+      return this->get_rgba_pixel_(row, x);
     default:
-      return color_off;
+      return display::COLOR_OFF;
   }
 }
-bool Image::get_binary_pixel_(int x, int y) const {
-  const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
-  const uint32_t pos = x + y * width_8;
-  return progmem_read_byte(this->data_start_ + (pos / 8u)) & (0x80 >> (pos % 8u));
+bool Image::get_binary_pixel_(const uint8_t *row, int x) const {
+  return progmem_read_byte(row + (x / 8u)) & (0x80 >> (x % 8u));
 }
-Color Image::get_rgba_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_) * 4;
-  return Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-               progmem_read_byte(this->data_start_ + pos + 2), progmem_read_byte(this->data_start_ + pos + 3));
+Color Image::get_rgba_pixel_(const uint8_t *row, int x) const {
+  const uint8_t *pixel = row + x * 4;
+  return Color(progmem_read_byte(pixel + 0), progmem_read_byte(pixel + 1), progmem_read_byte(pixel + 2),
+               progmem_read_byte(pixel + 3));
 }
-Color Image::get_rgb24_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_) * 3;
-  Color color = Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-                      progmem_read_byte(this->data_start_ + pos + 2));
+Color Image::get_rgb24_pixel_(const uint8_t *row, int x) const {
+  const uint8_t *pixel = row + x * 3;
+  Color color = Color(progmem_read_byte(pixel + 0), progmem_read_byte(pixel + 1), progmem_read_byte(pixel + 2));
   if (color.b == 1 && color.r == 0 && color.g == 0 && transparent_) {
     // (0, 0, 1) has been defined as transparent color for non-alpha images.
     // putting blue == 1 as a first condition for performance reasons (least likely value to short-cut the if)
@@ -102,14 +132,10 @@ Color Image::get_rgb24_pixel_(int x, int y) const {
   }
   return color;
 }
-Color Image::get_rgb565_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_) * 2;
-  uint16_t rgb565 =
-      progmem_read_byte(this->data_start_ + pos + 0) << 8 | progmem_read_byte(this->data_start_ + pos + 1);
-  auto r = (rgb565 & 0xF800) >> 11;
-  auto g = (rgb565 & 0x07E0) >> 5;
-  auto b = rgb565 & 0x001F;
-  Color color = Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+Color Image::get_rgb565_pixel_(const uint8_t *row, int x) const {
+  const uint8_t *pixel = row + x * 2;
+  uint16_t rgb565 = progmem_read_byte(pixel + 0) << 8 | progmem_read_byte(pixel + 1);
+  Color color = display::ColorUtil::rgb565_to_color(rgb565);
   if (rgb565 == 0x0020 && transparent_) {
     // darkest green has been defined as transparent color for transparent RGB565 images.
     color.w = 0;
@@ -118,9 +144,8 @@ Color Image::get_rgb565_pixel_(int x, int y) const {
   }
   return color;
 }
-Color Image::get_grayscale_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_);
-  const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
+Color Image::get_grayscale_pixel_(const uint8_t *row, int x) const {
+  const uint8_t gray = progmem_read_byte(row + x);
   uint8_t alpha = (gray == 1 && transparent_) ? 0 : 0xFF;
   return Color(gray, gray, gray, alpha);
 }
@@ -43,19 +43,30 @@ class Image : public display::BaseImage {
 
   void set_transparency(bool transparent) { transparent_ = transparent; }
   bool has_transparency() const { return transparent_; }
+  /// The rows are run-length encoded and get decoded while drawing.
+  void set_compressed(bool compressed) { compressed_ = compressed; }
+  bool is_compressed() const { return compressed_; }
 
  protected:
-  bool get_binary_pixel_(int x, int y) const;
-  Color get_rgb24_pixel_(int x, int y) const;
-  Color get_rgba_pixel_(int x, int y) const;
-  Color get_rgb565_pixel_(int x, int y) const;
-  Color get_grayscale_pixel_(int x, int y) const;
+  void draw_row_(int x, int y, const uint8_t *row, display::Display *display, Color color_on, Color color_off) const;
+  size_t get_row_size_() const;
+  /// Get the pixel data of row y, compressed images are decoded into buffer which must hold a row.
+  const uint8_t *get_row_(int y, uint8_t *buffer) const;
+  /// Decode the row starting at src into row, returns where the next row starts.
+  const uint8_t *decode_row_(const uint8_t *src, uint8_t *row) const;
+  Color get_color_pixel_(const uint8_t *row, int x) const;
+  bool get_binary_pixel_(const uint8_t *row, int x) const;
+  Color get_rgb24_pixel_(const uint8_t *row, int x) const;
+  Color get_rgba_pixel_(const uint8_t *row, int x) const;
+  Color get_rgb565_pixel_(const uint8_t *row, int x) const;
+  Color get_grayscale_pixel_(const uint8_t *row, int x) const;
 
   int width_;
   int height_;
   ImageType type_;
   const uint8_t *data_start_;
   bool transparent_;
+  bool compressed_{false};
 };
 
 }  // namespace image
@@ -14,6 +14,7 @@ from esphome.const import (
 DEPENDENCIES = ["i2c", "esp32"]
 AUTO_LOAD = ["psram"]
 
+CONF_BACKGROUND_REFRESH = "background_refresh"
 CONF_DISPLAY_DATA_0_PIN = "display_data_0_pin"
 CONF_DISPLAY_DATA_1_PIN = "display_data_1_pin"
 CONF_DISPLAY_DATA_2_PIN = "display_data_2_pin"
@@ -57,6 +58,7 @@ CONFIG_SCHEMA = cv.All(
             cv.GenerateID(): cv.declare_id(Inkplate6),
             cv.Optional(CONF_GREYSCALE, default=False): cv.boolean,
             cv.Optional(CONF_PARTIAL_UPDATING, default=True): cv.boolean,
+            cv.Optional(CONF_BACKGROUND_REFRESH, default=False): cv.boolean,
             cv.Optional(CONF_FULL_UPDATE_EVERY, default=10): cv.uint32_t,
             cv.Optional(CONF_MODEL, default="inkplate_6"): cv.enum(
                 MODELS, lower=True, space="_"
@@ -122,6 +124,7 @@ async def to_code(config):
 
     cg.add(var.set_greyscale(config[CONF_GREYSCALE]))
     cg.add(var.set_partial_updating(config[CONF_PARTIAL_UPDATING]))
+    cg.add(var.set_background_refresh(config[CONF_BACKGROUND_REFRESH]))
     cg.add(var.set_full_update_every(config[CONF_FULL_UPDATE_EVERY]))
 
     cg.add(var.set_model(config[CONF_MODEL]))
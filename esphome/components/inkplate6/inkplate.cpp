@@ -53,11 +53,43 @@ void Inkplate6::setup() {
                           });
   delay(1);
   this->wakeup_pin_->digital_write(false);
+
+  if (this->background_refresh_) {
+#if portNUM_PROCESSORS > 1
+    // Keep the waveforms away from the core running the main loop
+    const BaseType_t core = 1 - xPortGetCoreID();
+#else
+    const BaseType_t core = tskNO_AFFINITY;
+#endif
+    if (xTaskCreatePinnedToCore(Inkplate6::refresh_task, "inkplate", 4096, this, 1, &this->refresh_task_handle_,
+                                core) != pdPASS) {
+      ESP_LOGE(TAG, "Cannot create refresh task!");
+      this->mark_failed();
+      return;
+    }
+  }
+}
+
+void Inkplate6::loop() {
+  if (!this->refresh_started_ || this->refresh_pending_)
+    return;
+  this->refresh_started_ = false;
+  this->eink_off_();
+  ESP_LOGV(TAG, "Background refresh finished (%ums)", millis() - this->refresh_start_time_);
+}
+
+void Inkplate6::refresh_task(void *param) {
+  auto *inkplate = static_cast<Inkplate6 *>(param);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    inkplate->refresh_();
+    inkplate->refresh_pending_ = false;
+  }
 }
 
 void Inkplate6::initialize_() {
-  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  ExternalRAMAllocator<uint32_t> allocator32(ExternalRAMAllocator<uint32_t>::ALLOW_FAILURE);
+  ExternalRAMAllocator<uint8_t> allocator(HeapTag::DISPLAY, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  ExternalRAMAllocator<uint32_t> allocator32(HeapTag::DISPLAY, ExternalRAMAllocator<uint32_t>::ALLOW_FAILURE);
   uint32_t buffer_size = this->get_buffer_length_();
   if (buffer_size == 0)
     return;
@@ -140,6 +172,10 @@ size_t Inkplate6::get_buffer_length_() {
 }
 
 void Inkplate6::update() {
+  if (this->refresh_started_) {
+    ESP_LOGW(TAG, "Still refreshing, skipping update");
+    return;
+  }
   this->do_update_();
 
   if (this->full_update_every_ > 0 && this->partial_updates_ >= this->full_update_every_) {
@@ -301,18 +337,37 @@ void Inkplate6::fill(Color color) {
 
 void Inkplate6::display() {
   ESP_LOGV(TAG, "Display called");
+  if (this->refresh_task_handle_ != nullptr) {
+    if (this->refresh_started_) {
+      ESP_LOGW(TAG, "Still refreshing, skipping display");
+      return;
+    }
+    // The PMIC shares the I2C bus with other devices, so it's only switched from the main loop
+    this->eink_on_();
+    if (!this->panel_on_)
+      return;
+    this->refresh_start_time_ = millis();
+    this->refresh_started_ = true;
+    this->refresh_pending_ = true;
+    xTaskNotifyGive(this->refresh_task_handle_);
+    return;
+  }
+
   uint32_t start_time = millis();
+  bool partial = this->refresh_();
+  this->eink_off_();
+  ESP_LOGV(TAG, "Display finished (%s) (%ums)", partial ? "partial" : "full", millis() - start_time);
+}
 
+bool Inkplate6::refresh_() {
   if (this->greyscale_) {
     this->display3b_();
-  } else {
-    if (this->partial_updating_ && this->partial_update_()) {
-      ESP_LOGV(TAG, "Display finished (partial) (%ums)", millis() - start_time);
-      return;
-    }
-    this->display1b_();
+    return false;
   }
-  ESP_LOGV(TAG, "Display finished (full) (%ums)", millis() - start_time);
+  if (this->partial_updating_ && this->partial_update_())
+    return true;
+  this->display1b_();
+  return false;
 }
 
 void Inkplate6::display1b_() {
@@ -321,9 +376,10 @@ void Inkplate6::display1b_() {
 
   memcpy(this->buffer_, this->partial_buffer_, this->get_buffer_length_());
 
-  uint8_t data;
   uint8_t buffer_value;
   const uint8_t *buffer_ptr;
+  // The bus words for each nibble of a phase, so every clock only needs a single lookup
+  uint32_t phase_lut[16];
   eink_on_();
   if (this->model_ == INKPLATE_6_PLUS) {
     clean_fast_(0, 1);
@@ -350,24 +406,25 @@ void Inkplate6::display1b_() {
 
   int rep = (this->model_ == INKPLATE_6_V2) ? 5 : 4;
 
+  // The 6PLUS drives the inverted image to white first, the others drive the image to black
+  const uint8_t invert = this->model_ == INKPLATE_6_PLUS ? 0xFF : 0x00;
+  for (uint8_t n = 0; n < 16; n++)
+    phase_lut[n] = this->pin_lut_[this->model_ == INKPLATE_6_PLUS ? LUTW[n] : LUTB[n]];
+
   for (int k = 0; k < rep; k++) {
     buffer_ptr = &this->buffer_[this->get_buffer_length_() - 1];
     vscan_start_();
     for (int i = 0, im = this->get_height_internal(); i < im; i++) {
-      buffer_value = *(buffer_ptr--);
-      data = this->model_ == INKPLATE_6_PLUS ? LUTW[(~buffer_value >> 4) & 0x0F] : LUTB[(buffer_value >> 4) & 0x0F];
-      hscan_start_(this->pin_lut_[data]);
-      data = this->model_ == INKPLATE_6_PLUS ? LUTW[(~buffer_value) & 0x0F] : LUTB[buffer_value & 0x0F];
-      GPIO.out_w1ts = this->pin_lut_[data] | clock;
+      buffer_value = *(buffer_ptr--) ^ invert;
+      hscan_start_(phase_lut[buffer_value >> 4]);
+      GPIO.out_w1ts = phase_lut[buffer_value & 0x0F] | clock;
       GPIO.out_w1tc = data_mask | clock;
 
       for (int j = 0, jm = (this->get_width_internal() / 8) - 1; j < jm; j++) {
-        buffer_value = *(buffer_ptr--);
-        data = this->model_ == INKPLATE_6_PLUS ? LUTW[(~buffer_value >> 4) & 0x0F] : LUTB[(buffer_value >> 4) & 0x0F];
-        GPIO.out_w1ts = this->pin_lut_[data] | clock;
+        buffer_value = *(buffer_ptr--) ^ invert;
+        GPIO.out_w1ts = phase_lut[buffer_value >> 4] | clock;
         GPIO.out_w1tc = data_mask | clock;
-        data = this->model_ == INKPLATE_6_PLUS ? LUTW[(~buffer_value) & 0x0F] : LUTB[buffer_value & 0x0F];
-        GPIO.out_w1ts = this->pin_lut_[data] | clock;
+        GPIO.out_w1ts = phase_lut[buffer_value & 0x0F] | clock;
         GPIO.out_w1tc = data_mask | clock;
       }
       // New Inkplate6 panel doesn't need last clock
@@ -381,23 +438,22 @@ void Inkplate6::display1b_() {
   }
   ESP_LOGV(TAG, "Display1b first loop x %d (%ums)", 4, millis() - start_time);
 
+  for (uint8_t n = 0; n < 16; n++)
+    phase_lut[n] = this->pin_lut_[this->model_ == INKPLATE_6_PLUS ? LUTB[n] : LUT2[n]];
+
   buffer_ptr = &this->buffer_[this->get_buffer_length_() - 1];
   vscan_start_();
   for (int i = 0, im = this->get_height_internal(); i < im; i++) {
     buffer_value = *(buffer_ptr--);
-    data = this->model_ == INKPLATE_6_PLUS ? LUTB[(buffer_value >> 4) & 0x0F] : LUT2[(buffer_value >> 4) & 0x0F];
-    hscan_start_(this->pin_lut_[data] | clock);
-    data = this->model_ == INKPLATE_6_PLUS ? LUTB[buffer_value & 0x0F] : LUT2[buffer_value & 0x0F];
-    GPIO.out_w1ts = this->pin_lut_[data] | clock;
+    hscan_start_(phase_lut[buffer_value >> 4] | clock);
+    GPIO.out_w1ts = phase_lut[buffer_value & 0x0F] | clock;
     GPIO.out_w1tc = data_mask | clock;
 
     for (int j = 0, jm = (this->get_width_internal() / 8) - 1; j < jm; j++) {
       buffer_value = *(buffer_ptr--);
-      data = this->model_ == INKPLATE_6_PLUS ? LUTB[(buffer_value >> 4) & 0x0F] : LUT2[(buffer_value >> 4) & 0x0F];
-      GPIO.out_w1ts = this->pin_lut_[data] | clock;
+      GPIO.out_w1ts = phase_lut[buffer_value >> 4] | clock;
       GPIO.out_w1tc = data_mask | clock;
-      data = this->model_ == INKPLATE_6_PLUS ? LUTB[buffer_value & 0x0F] : LUT2[buffer_value & 0x0F];
-      GPIO.out_w1ts = this->pin_lut_[data] | clock;
+      GPIO.out_w1ts = phase_lut[buffer_value & 0x0F] | clock;
       GPIO.out_w1tc = data_mask | clock;
     }
     // New Inkplate6 panel doesn't need last clock
@@ -437,7 +493,6 @@ void Inkplate6::display1b_() {
     ESP_LOGV(TAG, "Display1b third loop (%ums)", millis() - start_time);
   }
   vscan_start_();
-  eink_off_();
   this->block_partial_ = false;
   this->partial_updates_ = 0;
   ESP_LOGV(TAG, "Display1b finished (%ums)", millis() - start_time);
@@ -473,24 +528,26 @@ void Inkplate6::display3b_() {
   uint32_t data;
   uint8_t glut_size = 9;
   for (int k = 0; k < glut_size; k++) {
+    const uint32_t *glut = &this->glut_[k * 256];
+    const uint32_t *glut2 = &this->glut2_[k * 256];
     pos = this->get_buffer_length_();
     vscan_start_();
-    for (int i = 0; i < this->get_height_internal(); i++) {
-      data = this->glut2_[k * 256 + this->buffer_[--pos]];
-      data |= this->glut_[k * 256 + this->buffer_[--pos]];
+    for (int i = 0, im = this->get_height_internal(); i < im; i++) {
+      data = glut2[this->buffer_[--pos]];
+      data |= glut[this->buffer_[--pos]];
       hscan_start_(data);
-      data = this->glut2_[k * 256 + this->buffer_[--pos]];
-      data |= this->glut_[k * 256 + this->buffer_[--pos]];
+      data = glut2[this->buffer_[--pos]];
+      data |= glut[this->buffer_[--pos]];
       GPIO.out_w1ts = data | clock;
       GPIO.out_w1tc = data_mask | clock;
 
-      for (int j = 0; j < (this->get_width_internal() / 8) - 1; j++) {
-        data = this->glut2_[k * 256 + this->buffer_[--pos]];
-        data |= this->glut_[k * 256 + this->buffer_[--pos]];
+      for (int j = 0, jm = (this->get_width_internal() / 8) - 1; j < jm; j++) {
+        data = glut2[this->buffer_[--pos]];
+        data |= glut[this->buffer_[--pos]];
         GPIO.out_w1ts = data | clock;
         GPIO.out_w1tc = data_mask | clock;
-        data = this->glut2_[k * 256 + this->buffer_[--pos]];
-        data |= this->glut_[k * 256 + this->buffer_[--pos]];
+        data = glut2[this->buffer_[--pos]];
+        data |= glut[this->buffer_[--pos]];
         GPIO.out_w1ts = data | clock;
         GPIO.out_w1tc = data_mask | clock;
       }
@@ -505,7 +562,6 @@ void Inkplate6::display3b_() {
   }
   clean_fast_(3, 1);
   vscan_start_();
-  eink_off_();
   ESP_LOGV(TAG, "Display3b finished (%ums)", millis() - start_time);
 }
 
@@ -564,7 +620,6 @@ bool Inkplate6::partial_update_() {
   clean_fast_(2, 2);
   clean_fast_(3, 1);
   vscan_start_();
-  eink_off_();
 
   memcpy(this->buffer_, this->partial_buffer_, this->get_buffer_length_());
   ESP_LOGV(TAG, "Partial update finished (%ums)", millis() - start_time);
@@ -596,7 +651,7 @@ void Inkplate6::vscan_start_() {
 }
 
 void Inkplate6::hscan_start_(uint32_t d) {
-  uint8_t clock = (1 << this->cl_pin_->get_pin());
+  uint32_t clock = (1 << this->cl_pin_->get_pin());
   this->sph_pin_->digital_write(false);
   GPIO.out_w1ts = d | clock;
   GPIO.out_w1tc = this->get_data_pin_mask_() | clock;
@@ -613,6 +668,10 @@ void Inkplate6::vscan_end_() {
 
 void Inkplate6::clean() {
   ESP_LOGV(TAG, "Clean called");
+  if (this->refresh_started_) {
+    ESP_LOGW(TAG, "Still refreshing, skipping clean");
+    return;
+  }
   uint32_t start_time = millis();
 
   eink_on_();
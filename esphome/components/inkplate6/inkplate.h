@@ -5,8 +5,13 @@
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/display/display_buffer.h"
 
+#include <atomic>
+
 #ifdef USE_ESP32_FRAMEWORK_ARDUINO
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
 namespace esphome {
 namespace inkplate6 {
 
@@ -75,6 +80,8 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
   void set_full_update_every(uint32_t full_update_every) { this->full_update_every_ = full_update_every; }
 
   void set_model(InkplateModel model) { this->model_ = model; }
+  /// Run the waveforms of a refresh in a task on the other core, so the main loop keeps running during a refresh.
+  void set_background_refresh(bool background_refresh) { this->background_refresh_ = background_refresh; }
 
   void set_display_data_0_pin(InternalGPIOPin *data) { this->display_data_0_pin_ = data; }
   void set_display_data_1_pin(InternalGPIOPin *data) { this->display_data_1_pin_ = data; }
@@ -108,6 +115,7 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
   void update() override;
 
   void setup() override;
+  void loop() override;
 
   uint8_t get_panel_state() { return this->panel_on_; }
   bool get_greyscale() { return this->greyscale_; }
@@ -122,6 +130,9 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  /// Drive the panel with the current buffers, returns true for a partial update. The panel must be on.
+  bool refresh_();
+  static void refresh_task(void *param);
   void display1b_();
   void display3b_();
   void initialize_();
@@ -196,6 +207,14 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
 
   InkplateModel model_;
 
+  bool background_refresh_{false};
+  TaskHandle_t refresh_task_handle_{nullptr};
+  /// Set while the refresh task drives the panel, the buffers must not change until it's cleared.
+  std::atomic<bool> refresh_pending_{false};
+  /// The main loop still has to turn the panel off after a background refresh.
+  bool refresh_started_{false};
+  uint32_t refresh_start_time_{0};
+
   InternalGPIOPin *display_data_0_pin_;
   InternalGPIOPin *display_data_1_pin_;
   InternalGPIOPin *display_data_2_pin_;
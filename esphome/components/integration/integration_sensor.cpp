@@ -18,10 +18,15 @@ void IntegrationSensor::setup() {
 
   this->last_update_ = millis();
 
-  this->publish_and_save_(this->result_);
+  this->publish_state(this->result_);
   this->sensor_->add_on_state_callback([this](float state) { this->process_sensor_value_(state); });
 }
-void IntegrationSensor::dump_config() { LOG_SENSOR("", "Integration Sensor", this); }
+void IntegrationSensor::dump_config() {
+  LOG_SENSOR("", "Integration Sensor", this);
+  if (this->restore_ && this->save_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Save Interval: %ums", this->save_interval_);
+}
+void IntegrationSensor::on_shutdown() { this->save_(); }
 void IntegrationSensor::process_sensor_value_(float value) {
   if (std::isnan(value))
     return;
@@ -44,7 +49,7 @@ void IntegrationSensor::process_sensor_value_(float value) {
   }
   this->last_value_ = new_value;
   this->last_update_ = now;
-  this->publish_and_save_(this->result_ + area);
+  this->publish_and_save_(this->result_ + area, false);
 }
 
 }  // namespace integration
@@ -32,7 +32,10 @@ class IntegrationSensor : public sensor::Sensor, public Component {
   void set_time(IntegrationSensorTime time) { time_ = time; }
   void set_method(IntegrationMethod method) { method_ = method; }
   void set_restore(bool restore) { restore_ = restore; }
-  void reset() { this->publish_and_save_(0.0f); }
+  /// Save the result at most this often, 0 saves on every update.
+  void set_save_interval(uint32_t save_interval) { save_interval_ = save_interval; }
+  void on_shutdown() override;
+  void reset() { this->publish_and_save_(0.0, true); }
 
  protected:
   void process_sensor_value_(float value);
@@ -52,19 +55,27 @@ class IntegrationSensor : public sensor::Sensor, public Component {
         return 0.0f;
     }
   }
-  void publish_and_save_(double result) {
+  void publish_and_save_(double result, bool force_save) {
     this->result_ = result;
     this->publish_state(result);
-    if (this->restore_) {
-      float result_f = result;
-      this->pref_.save(&result_f);
-    }
+    if (force_save || millis() - this->last_save_ >= this->save_interval_)
+      this->save_();
+  }
+  /// Stored as float like before, the running sum stays in double precision.
+  void save_() {
+    if (!this->restore_)
+      return;
+    float result_f = this->result_;
+    this->pref_.save(&result_f);
+    this->last_save_ = millis();
   }
 
   sensor::Sensor *sensor_;
   IntegrationSensorTime time_;
   IntegrationMethod method_;
   bool restore_;
+  uint32_t save_interval_{0};
+  uint32_t last_save_{0};
   ESPPreferenceObject pref_;
 
   uint32_t last_update_;
@@ -2,6 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.const import CONF_ID, CONF_INTERVAL
+from esphome.core import CORE
 
 CODEOWNERS = ["@esphome/core"]
 interval_ns = cg.esphome_ns.namespace("interval")
@@ -9,13 +10,36 @@ IntervalTrigger = interval_ns.class_(
     "IntervalTrigger", automation.Trigger.template(), cg.PollingComponent
 )
 
+CONF_HIGH_RESOLUTION = "high_resolution"
+
+
+def validate_interval(config):
+    if config[CONF_HIGH_RESOLUTION]:
+        if not CORE.is_esp32:
+            raise cv.Invalid(
+                f"'{CONF_HIGH_RESOLUTION}' is only available on ESP32",
+                path=[CONF_HIGH_RESOLUTION],
+            )
+        return config
+    if config[CONF_INTERVAL].total_microseconds % 1000 != 0:
+        raise cv.Invalid(
+            f"Sub-millisecond intervals need '{CONF_HIGH_RESOLUTION}: true'",
+            path=[CONF_INTERVAL],
+        )
+    return config
+
+
 CONFIG_SCHEMA = automation.validate_automation(
-    cv.Schema(
-        {
-            cv.GenerateID(): cv.declare_id(IntervalTrigger),
-            cv.Required(CONF_INTERVAL): cv.positive_time_period_milliseconds,
-        }
-    ).extend(cv.COMPONENT_SCHEMA)
+    cv.All(
+        cv.Schema(
+            {
+                cv.GenerateID(): cv.declare_id(IntervalTrigger),
+                cv.Required(CONF_INTERVAL): cv.positive_time_period_microseconds,
+                cv.Optional(CONF_HIGH_RESOLUTION, default=False): cv.boolean,
+            }
+        ).extend(cv.COMPONENT_SCHEMA),
+        validate_interval,
+    )
 )
 
 
@@ -25,4 +49,15 @@ async def to_code(config):
         await cg.register_component(var, conf)
         await automation.build_automation(var, [], conf)
 
-        cg.add(var.set_update_interval(conf[CONF_INTERVAL]))
+        if conf[CONF_HIGH_RESOLUTION]:
+            cg.add_define("USE_HIRES_INTERVAL")
+            cg.add(var.set_update_interval(4294967295))  # SCHEDULER_DONT_RUN
+            cg.add(
+                var.set_high_resolution_interval(
+                    conf[CONF_INTERVAL].total_microseconds
+                )
+            )
+        else:
+            cg.add(
+                var.set_update_interval(conf[CONF_INTERVAL].total_milliseconds)
+            )
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <memory>
+
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/hires_interval.h"
 
 namespace esphome {
 namespace interval {
@@ -10,6 +13,22 @@ class IntervalTrigger : public Trigger<>, public PollingComponent {
  public:
   void update() override { this->trigger(); }
   float get_setup_priority() const override { return setup_priority::DATA; }
+
+#ifdef USE_HIRES_INTERVAL
+  /// Run on a phase locked esp_timer interval in microseconds instead of the update interval.
+  void set_high_resolution_interval(uint64_t interval_us) { this->high_resolution_interval_us_ = interval_us; }
+  void setup() override {
+    if (this->high_resolution_interval_us_ == 0)
+      return;
+    this->high_resolution_interval_ = make_unique<HighResolutionInterval>([this]() { this->trigger(); });
+    if (!this->high_resolution_interval_->start(this->high_resolution_interval_us_))
+      this->mark_failed();
+  }
+
+ protected:
+  uint64_t high_resolution_interval_us_{0};
+  std::unique_ptr<HighResolutionInterval> high_resolution_interval_;
+#endif
 };
 
 }  // namespace interval
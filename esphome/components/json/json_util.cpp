@@ -1,4 +1,5 @@
 #include "json_util.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/log.h"
 
 #ifdef USE_ESP8266
@@ -16,53 +17,94 @@ namespace json {
 
 static const char *const TAG = "json";
 
-static std::vector<char> global_json_build_buffer;  // NOLINT
+static const size_t JSON_DOCUMENT_INITIAL_SIZE = 512;
+// Shared buffers that grew beyond this are freed after use rather than held on to.
+static const size_t JSON_SHARED_KEEP_SIZE = 2048;
 
-std::string build_json(const json_build_t &f) {
-  // Here we are allocating up to 5kb of memory,
-  // with the heap size minus 2kb to be safe if less than 5kb
-  // as we can not have a true dynamic sized document.
-  // The excess memory is freed below with `shrinkToFit()`
-#ifdef USE_ESP8266
-  const size_t free_heap = ESP.getMaxFreeBlockSize();  // NOLINT(readability-static-accessed-through-instance)
-#elif defined(USE_ESP32)
-  const size_t free_heap = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
-#elif defined(USE_RP2040)
-  const size_t free_heap = rp2040.getFreeHeap();
-#elif defined(USE_LIBRETINY)
-  const size_t free_heap = lt_heap_get_free();
-#endif
+// The document and output buffer are kept between builds, so that once they have grown large enough building a
+// message doesn't allocate. Builds from another task, or nested in a build function, fall back to their own.
+static Mutex global_json_lock;                       // NOLINT
+static bool global_json_in_use = false;              // NOLINT
+static DynamicJsonDocument global_json_document(0);  // NOLINT
+static std::vector<char> global_json_build_buffer;   // NOLINT
 
-  size_t request_size = std::min(free_heap, (size_t) 512);
+// Run the build function on an empty document, growing the document until everything fits.
+static void fill_document(DynamicJsonDocument &document, const json_build_t &f) {
+  if (document.capacity() == 0)
+    document = DynamicJsonDocument(JSON_DOCUMENT_INITIAL_SIZE);
   while (true) {
-    ESP_LOGV(TAG, "Attempting to allocate %u bytes for JSON serialization", request_size);
-    DynamicJsonDocument json_document(request_size);
-    if (json_document.capacity() == 0) {
-      ESP_LOGE(TAG,
-               "Could not allocate memory for JSON document! Requested %u bytes, largest free heap block: %u bytes",
-               request_size, free_heap);
-      return "{}";
+    document.clear();
+    JsonObject root = document.to<JsonObject>();
+    if (document.capacity() == 0) {
+      ESP_LOGE(TAG, "Could not allocate memory for JSON document!");
+      return;
     }
-    JsonObject root = json_document.to<JsonObject>();
     f(root);
-    if (json_document.overflowed()) {
-      if (request_size == free_heap) {
-        ESP_LOGE(TAG, "Could not allocate memory for JSON document! Overflowed largest free heap block: %u bytes",
-                 free_heap);
-        return "{}";
-      }
-      request_size = std::min(request_size * 2, free_heap);
-      continue;
+    if (!document.overflowed())
+      return;
+    const size_t request_size = document.capacity() * 2;
+    ESP_LOGV(TAG, "Attempting to allocate %u bytes for JSON serialization", request_size);
+    // free the old pool first, so that both don't have to fit in the heap at once
+    document = DynamicJsonDocument(0);
+    document = DynamicJsonDocument(request_size);
+    if (document.capacity() == 0) {
+      ESP_LOGE(TAG, "Could not allocate memory for JSON document! Requested %u bytes", request_size);
+      return;
     }
-    json_document.shrinkToFit();
-    ESP_LOGV(TAG, "Size after shrink %u bytes", json_document.capacity());
-    std::string output;
-    serializeJson(json_document, output);
-    return output;
   }
 }
 
+template<typename F> static void with_document(const json_build_t &f, F &&output) {
+  if (global_json_lock.try_lock()) {
+    if (!global_json_in_use) {
+      global_json_in_use = true;
+      fill_document(global_json_document, f);
+      output(global_json_document, global_json_build_buffer);
+      if (global_json_document.capacity() > JSON_SHARED_KEEP_SIZE)
+        global_json_document = DynamicJsonDocument(0);
+      if (global_json_build_buffer.capacity() > JSON_SHARED_KEEP_SIZE)
+        std::vector<char>().swap(global_json_build_buffer);
+      global_json_in_use = false;
+      global_json_lock.unlock();
+      return;
+    }
+    global_json_lock.unlock();
+  }
+  DynamicJsonDocument document(0);
+  std::vector<char> buffer;
+  fill_document(document, f);
+  output(document, buffer);
+}
+
+std::string build_json(const json_build_t &f) {
+  HeapTagScope heap_tag(HeapTag::JSON);
+  std::string output;
+  with_document(f, [&output](DynamicJsonDocument &document, std::vector<char> &buffer) {
+    if (document.capacity() == 0) {
+      output = "{}";
+      return;
+    }
+    output.reserve(measureJson(document));
+    serializeJson(document, output);
+  });
+  return output;
+}
+
+void build_json(const json_build_t &f, const json_write_t &write) {
+  HeapTagScope heap_tag(HeapTag::JSON);
+  with_document(f, [&write](DynamicJsonDocument &document, std::vector<char> &buffer) {
+    if (document.capacity() == 0) {
+      write("{}", 2);
+      return;
+    }
+    buffer.resize(measureJson(document) + 1);
+    const size_t length = serializeJson(document, buffer.data(), buffer.size());
+    write(buffer.data(), length);
+  });
+}
+
 void parse_json(const std::string &data, const json_parse_t &f) {
+  HeapTagScope heap_tag(HeapTag::JSON);
   // Here we are allocating 1.5 times the data size,
   // with the heap size minus 2kb to be safe if less than that
   // as we can not have a true dynamic sized document.
@@ -19,9 +19,15 @@ using json_parse_t = std::function<void(JsonObject)>;
 /// Callback function typedef for building JsonObjects.
 using json_build_t = std::function<void(JsonObject)>;
 
+/// Callback function typedef for consuming serialized JSON, the data is only valid during the call.
+using json_write_t = std::function<void(const char *data, size_t length)>;
+
 /// Build a JSON string with the provided json build function.
 std::string build_json(const json_build_t &f);
 
+/// Build JSON with the provided json build function and pass it to the write function, without creating a string.
+void build_json(const json_build_t &f, const json_write_t &write);
+
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
 
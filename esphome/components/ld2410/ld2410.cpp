@@ -108,11 +108,18 @@ void LD2410Component::restart_and_read_all_info() {
 }
 
 void LD2410Component::loop() {
-  const int max_line_length = 80;
-  static uint8_t buffer[max_line_length];
-
-  while (available()) {
-    this->readline_(read(), buffer, max_line_length);
+  uint8_t buf[64];
+  size_t len;
+  while ((len = this->read_available(buf, sizeof(buf))) > 0) {
+    this->parser_.feed(buf, len, [this](const uint8_t *frame, size_t frame_len) {
+      if (frame[0] == DATA_FRAME_HEADER[0]) {
+        ESP_LOGV(TAG, "Will handle Periodic Data");
+        this->handle_periodic_data_(frame, frame_len);
+      } else {
+        ESP_LOGV(TAG, "Will handle ACK Data");
+        this->handle_ack_data_(frame, frame_len);
+      }
+    });
   }
 }
 
@@ -143,7 +150,7 @@ void LD2410Component::send_command_(uint8_t command, const uint8_t *command_valu
   delay(50);  // NOLINT
 }
 
-void LD2410Component::handle_periodic_data_(uint8_t *buffer, int len) {
+void LD2410Component::handle_periodic_data_(const uint8_t *buffer, int len) {
   if (len < 12)
     return;  // 4 frame start bytes + 2 length bytes + 1 data end byte + 1 crc byte + 4 frame end bytes
   if (buffer[0] != 0xF4 || buffer[1] != 0xF3 || buffer[2] != 0xF2 || buffer[3] != 0xF1)  // check 4 frame start bytes
@@ -283,7 +290,7 @@ void LD2410Component::handle_periodic_data_(uint8_t *buffer, int len) {
 
 const char VERSION_FMT[] = "%u.%02X.%02X%02X%02X%02X";
 
-std::string format_version(uint8_t *buffer) {
+std::string format_version(const uint8_t *buffer) {
   std::string::size_type version_size = 256;
   std::string version;
   do {
@@ -300,7 +307,7 @@ const char MAC_FMT[] = "%02X:%02X:%02X:%02X:%02X:%02X";
 const std::string UNKNOWN_MAC("unknown");
 const std::string NO_MAC("08:05:04:03:02:01");
 
-std::string format_mac(uint8_t *buffer) {
+std::string format_mac(const uint8_t *buffer) {
   std::string::size_type mac_size = 256;
   std::string mac;
   do {
@@ -326,7 +333,7 @@ std::function<void(void)> set_number_value(number::Number *n, float value) {
 }
 #endif
 
-bool LD2410Component::handle_ack_data_(uint8_t *buffer, int len) {
+bool LD2410Component::handle_ack_data_(const uint8_t *buffer, int len) {
   ESP_LOGV(TAG, "Handling ACK DATA for COMMAND %02X", buffer[COMMAND]);
   if (len < 10) {
     ESP_LOGE(TAG, "Error with last command : incorrect length");
@@ -475,34 +482,6 @@ bool LD2410Component::handle_ack_data_(uint8_t *buffer, int len) {
   return true;
 }
 
-void LD2410Component::readline_(int readch, uint8_t *buffer, int len) {
-  static int pos = 0;
-
-  if (readch >= 0) {
-    if (pos < len - 1) {
-      buffer[pos++] = readch;
-      buffer[pos] = 0;
-    } else {
-      pos = 0;
-    }
-    if (pos >= 4) {
-      if (buffer[pos - 4] == 0xF8 && buffer[pos - 3] == 0xF7 && buffer[pos - 2] == 0xF6 && buffer[pos - 1] == 0xF5) {
-        ESP_LOGV(TAG, "Will handle Periodic Data");
-        this->handle_periodic_data_(buffer, pos);
-        pos = 0;  // Reset position index ready for next time
-      } else if (buffer[pos - 4] == 0x04 && buffer[pos - 3] == 0x03 && buffer[pos - 2] == 0x02 &&
-                 buffer[pos - 1] == 0x01) {
-        ESP_LOGV(TAG, "Will handle ACK Data");
-        if (this->handle_ack_data_(buffer, pos)) {
-          pos = 0;  // Reset position index ready for next time
-        } else {
-          ESP_LOGV(TAG, "ACK Data incomplete");
-        }
-      }
-    }
-  }
-}
-
 void LD2410Component::set_config_mode_(bool enable) {
   uint8_t cmd = enable ? CMD_ENABLE_CONF : CMD_DISABLE_CONF;
   uint8_t cmd_value[2] = {0x01, 0x00};
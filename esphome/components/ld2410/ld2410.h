@@ -22,6 +22,7 @@
 #ifdef USE_TEXT_SENSOR
 #include "esphome/components/text_sensor/text_sensor.h"
 #endif
+#include "esphome/components/uart/frame_parser.h"
 #include "esphome/components/uart/uart.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
@@ -104,6 +105,12 @@ static const uint8_t CMD_FRAME_END[4] = {0x04, 0x03, 0x02, 0x01};
 // Data Header & Footer
 static const uint8_t DATA_FRAME_HEADER[4] = {0xF4, 0xF3, 0xF2, 0xF1};
 static const uint8_t DATA_FRAME_END[4] = {0xF8, 0xF7, 0xF6, 0xF5};
+static const uint8_t MAX_FRAME_LENGTH = 80;
+/// Periodic data frames and command ACKs, both 4 header bytes, 2 bytes of length, the payload and 4 end bytes.
+static const uart::FrameFormat FRAME_FORMATS[2] = {
+    {DATA_FRAME_HEADER, 4, 4, 2, false, 10, DATA_FRAME_END, 4, nullptr},
+    {CMD_FRAME_HEADER, 4, 4, 2, false, 10, CMD_FRAME_END, 4, nullptr},
+};
 /*
 Data Type: 6th byte
 Target states: 9th byte
@@ -205,9 +212,8 @@ class LD2410Component : public Component, public uart::UARTDevice {
   int two_byte_to_int_(char firstbyte, char secondbyte) { return (int16_t) (secondbyte << 8) + firstbyte; }
   void send_command_(uint8_t command_str, const uint8_t *command_value, int command_value_len);
   void set_config_mode_(bool enable);
-  void handle_periodic_data_(uint8_t *buffer, int len);
-  bool handle_ack_data_(uint8_t *buffer, int len);
-  void readline_(int readch, uint8_t *buffer, int len);
+  void handle_periodic_data_(const uint8_t *buffer, int len);
+  bool handle_ack_data_(const uint8_t *buffer, int len);
   void query_parameters_();
   void get_version_();
   void get_mac_();
@@ -215,6 +221,7 @@ class LD2410Component : public Component, public uart::UARTDevice {
   void get_light_control_();
   void restart_();
 
+  uart::FrameParser<MAX_FRAME_LENGTH> parser_{FRAME_FORMATS, 2};
   int32_t last_periodic_millis_ = millis();
   int32_t last_engineering_mode_change_millis_ = millis();
   uint16_t throttle_;
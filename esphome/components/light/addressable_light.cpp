@@ -23,6 +23,17 @@ void AddressableLight::call_setup() {
 #endif
 }
 
+float AddressableLight::get_frame_rate() {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->frame_rate_last_time_;
+  const uint32_t frames = this->frame_count_ - this->frame_rate_last_count_;
+  this->frame_rate_last_time_ = now;
+  this->frame_rate_last_count_ = this->frame_count_;
+  if (elapsed == 0)
+    return 0.0f;
+  return frames * 1000.0f / elapsed;
+}
+
 std::unique_ptr<LightTransformer> AddressableLight::create_default_transition() {
   return make_unique<AddressableLightTransformer>(*this);
 }
@@ -68,12 +68,17 @@ class AddressableLight : public LightOutput, public Component {
     this->correction_.set_max_brightness(
         Color(to_uint8_scale(red), to_uint8_scale(green), to_uint8_scale(blue), to_uint8_scale(white)));
   }
+  const ESPColorCorrection &get_correction() const { return this->correction_; }
   void setup_state(LightState *state) override {
     this->correction_.calculate_gamma_table(state->get_gamma_correct());
     this->state_parent_ = state;
   }
   void update_state(LightState *state) override;
   void schedule_show() { this->state_parent_->next_write_ = true; }
+  /// Number of frames shown since boot.
+  uint32_t get_frame_count() const { return this->frame_count_; }
+  /// Frames shown per second since the previous call, to show the frame rate effects achieve with a template sensor.
+  float get_frame_rate();
 
 #ifdef USE_POWER_SUPPLY
   void set_power_supply(power_supply::PowerSupply *power_supply) { this->power_.set_parent(power_supply); }
@@ -85,6 +90,7 @@ class AddressableLight : public LightOutput, public Component {
   friend class AddressableLightTransformer;
 
   void mark_shown_() {
+    this->frame_count_++;
 #ifdef USE_POWER_SUPPLY
     for (const auto &c : *this) {
       if (c.get_red_raw() > 0 || c.get_green_raw() > 0 || c.get_blue_raw() > 0 || c.get_white_raw() > 0) {
@@ -98,6 +104,9 @@ class AddressableLight : public LightOutput, public Component {
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
 
   bool effect_active_{false};
+  uint32_t frame_count_{0};
+  uint32_t frame_rate_last_count_{0};
+  uint32_t frame_rate_last_time_{0};
   ESPColorCorrection correction_{};
 #ifdef USE_POWER_SUPPLY
   power_supply::PowerSupplyRequester power_;
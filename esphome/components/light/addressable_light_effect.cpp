@@ -0,0 +1,18 @@
+#include "addressable_light_effect.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+
+namespace esphome {
+namespace light {
+
+static const char *const TAG = "light.addressable_effect";
+
+void AddressableLambdaLightEffect::stop() {
+  AddressableLightEffect::stop();
+  ESP_LOGD(TAG, "'%s' rendered %" PRIu32 " frames, %" PRIu32 " were skipped as the loop was late", this->name_.c_str(),
+           this->frames_, this->skipped_frames_);
+}
+
+}  // namespace light
+}  // namespace esphome
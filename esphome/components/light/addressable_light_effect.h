@@ -54,21 +54,41 @@ class AddressableLambdaLightEffect : public AddressableLightEffect {
                                std::function<void(AddressableLight &, Color, bool initial_run)> f,
                                uint32_t update_interval)
       : AddressableLightEffect(name), f_(std::move(f)), update_interval_(update_interval) {}
-  void start() override { this->initial_run_ = true; }
+  void start() override {
+    this->initial_run_ = true;
+    this->frames_ = 0;
+    this->skipped_frames_ = 0;
+  }
+  void stop() override;
   void apply(AddressableLight &it, const Color &current_color) override {
     const uint32_t now = millis();
-    if (now - this->last_run_ >= this->update_interval_) {
+    if (now - this->last_run_ < this->update_interval_)
+      return;
+    if (this->initial_run_ || this->update_interval_ == 0) {
       this->last_run_ = now;
-      this->f_(it, current_color, this->initial_run_);
-      this->initial_run_ = false;
-      it.schedule_show();
+    } else {
+      // Keep the frames on the cadence of the update interval, frames the loop was too late for are skipped
+      const uint32_t late_frames = (now - this->last_run_) / this->update_interval_ - 1;
+      this->skipped_frames_ += late_frames;
+      this->last_run_ += (late_frames + 1) * this->update_interval_;
     }
+    this->f_(it, current_color, this->initial_run_);
+    this->initial_run_ = false;
+    this->frames_++;
+    it.schedule_show();
   }
 
+  /// Frames rendered since the effect was started.
+  uint32_t get_frames() const { return this->frames_; }
+  /// Frames that were due since the effect was started, but skipped as the loop didn't get to them in time.
+  uint32_t get_skipped_frames() const { return this->skipped_frames_; }
+
  protected:
   std::function<void(AddressableLight &, Color, bool initial_run)> f_;
   uint32_t update_interval_;
   uint32_t last_run_{0};
+  uint32_t frames_{0};
+  uint32_t skipped_frames_{0};
   bool initial_run_;
 };
 
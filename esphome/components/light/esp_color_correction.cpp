@@ -2,6 +2,8 @@
 #include "light_color_values.h"
 #include "esphome/core/log.h"
 
+#include <cstring>
+
 namespace esphome {
 namespace light {
 
@@ -23,5 +25,17 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
   }
 }
 
+void HOT ESPColorCorrection::correct_range(uint8_t *rgbw, size_t n) const {
+  // Load and store each pixel as one word instead of four bytes, all supported platforms are little endian
+  for (size_t i = 0; i < n; i++, rgbw += 4) {
+    uint32_t in;
+    memcpy(&in, rgbw, sizeof(in));
+    uint32_t out = uint32_t(this->color_correct_red(in)) | uint32_t(this->color_correct_green(in >> 8)) << 8 |
+                   uint32_t(this->color_correct_blue(in >> 16)) << 16 |
+                   uint32_t(this->color_correct_white(in >> 24)) << 24;
+    memcpy(rgbw, &out, sizeof(out));
+  }
+}
+
 }  // namespace light
 }  // namespace esphome
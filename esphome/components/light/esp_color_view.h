@@ -62,6 +62,14 @@ class ESPColorView : public ESPColorSettable {
       return;
     *this->white_ = this->color_correction_->color_correct_white(white);
   }
+  /// Write \p color as is, it must already be corrected, e.g. with ESPColorCorrection::correct_range().
+  void set_corrected(const Color &color) {
+    *this->red_ = color.red;
+    *this->green_ = color.green;
+    *this->blue_ = color.blue;
+    if (this->white_ != nullptr)
+      *this->white_ = color.white;
+  }
   void set_effect_data(uint8_t effect_data) override {
     if (this->effect_data_ == nullptr)
       return;
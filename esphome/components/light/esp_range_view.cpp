@@ -18,8 +18,10 @@ ESPRangeIterator ESPRangeView::begin() { return {*this, this->begin_}; }
 ESPRangeIterator ESPRangeView::end() { return {*this, this->end_}; }
 
 void ESPRangeView::set(const Color &color) {
+  // Every LED gets the same value, so correct it only once
+  const Color corrected = this->parent_->get_correction().color_correct(color);
   for (int32_t i = this->begin_; i < this->end_; i++) {
-    (*this->parent_)[i] = color;
+    (*this->parent_)[i].set_corrected(corrected);
   }
 }
 
@@ -0,0 +1,33 @@
+#include "gamma_table.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace light {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static const GammaTable *gamma_tables = nullptr;
+
+const GammaTable *GammaTable::get(float gamma) {
+  // Beyond a gamma of 16, the difference between the last two points would overflow the interpolation
+  if (gamma <= 0.0f || gamma > 16.0f)
+    return nullptr;
+  for (const GammaTable *table = gamma_tables; table != nullptr; table = table->next_) {
+    if (table->gamma_ == gamma)
+      return table;
+  }
+  auto *table = new GammaTable(gamma);  // NOLINT(cppcoreguidelines-owning-memory)
+  table->next_ = gamma_tables;
+  gamma_tables = table;
+  return table;
+}
+
+GammaTable::GammaTable(float gamma) : gamma_(gamma) {
+  for (uint16_t i = 0; i <= 256; i++) {
+    // corrected = val ^ gamma
+    this->table_[i] = static_cast<uint32_t>(lroundf(gamma_correct(i / 256.0f, gamma) * ONE));
+  }
+}
+
+}  // namespace light
+}  // namespace esphome
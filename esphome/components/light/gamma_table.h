@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace light {
+
+/** Lookup table for gamma_correct(), so the output levels of a light don't need a powf() per channel on every write.
+ *
+ * On chips without an FPU like the ESP8266, powf() is slow enough that a few lights in a transition at the same time
+ * noticeably increase the loop time. The table holds 257 points of the gamma curve in 8.24 fixed point, values in
+ * between are interpolated linearly in integer math, which stays within 1e-5 of powf() for the usual gamma values.
+ *
+ * Tables are computed on first use and shared between all lights with the same gamma.
+ */
+class GammaTable {
+ public:
+  /// Get the table for gamma, nullptr if gamma doesn't apply any correction or is too steep for the interpolation.
+  static const GammaTable *get(float gamma);
+
+  float get_gamma() const { return this->gamma_; }
+
+  /// Same as gamma_correct(value, gamma).
+  float correct(float value) const {
+    if (value <= 0.0f)
+      return 0.0f;
+    if (value >= 1.0f)
+      return 1.0f;
+    // 8 bits for the index in the table and 12 bits for the position between two points
+    const uint32_t position = static_cast<uint32_t>(value * 1048576.0f);
+    const uint32_t index = position >> 12;
+    const uint32_t fraction = position & 0xFFF;
+    const uint32_t low = this->table_[index];
+    const uint32_t high = this->table_[index + 1];
+    return (low + (((high - low) * fraction) >> 12)) * (1.0f / ONE);
+  }
+
+ protected:
+  static const uint32_t ONE = 1UL << 24;
+
+  explicit GammaTable(float gamma);
+
+  float gamma_;
+  uint32_t table_[257];
+  const GammaTable *next_{nullptr};
+};
+
+/** Gamma correction to apply to the values of a light, either with gamma_correct() or with a GammaTable.
+ *
+ * Implicitly constructible from the gamma factor, so the LightColorValues::as_* methods still accept a float.
+ */
+class GammaCorrection {
+ public:
+  GammaCorrection(float gamma) : gamma_(gamma) {}  // NOLINT(google-explicit-constructor)
+  explicit GammaCorrection(const GammaTable &table) : gamma_(table.get_gamma()), table_(&table) {}
+
+  float correct(float value) const {
+    if (this->table_ != nullptr)
+      return this->table_->correct(value);
+    return gamma_correct(value, this->gamma_);
+  }
+
+ protected:
+  float gamma_;
+  const GammaTable *table_{nullptr};
+};
+
+}  // namespace light
+}  // namespace esphome
@@ -1,6 +1,7 @@
 #include <cinttypes>
 #include "light_call.h"
 #include "light_state.h"
+#include "light_output.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -29,6 +30,11 @@ static const LogString *color_mode_to_human(ColorMode color_mode) {
 }
 
 void LightCall::perform() {
+  this->start_();
+  this->finish_();
+}
+
+void LightCall::start_() {
   const char *name = this->parent_->get_name().c_str();
   LightColorValues v = this->validate_();
 
@@ -118,7 +124,9 @@ void LightCall::perform() {
     // INSTANT CHANGE
     this->parent_->set_immediately_(v, this->publish_);
   }
+}
 
+void LightCall::finish_() {
   if (!this->has_transition_()) {
     this->parent_->target_state_reached_callback_.call();
   }
@@ -130,6 +138,28 @@ void LightCall::perform() {
   }
 }
 
+LightGroupCall &LightGroupCall::add(LightCall call) {
+  this->calls_.push_back(std::move(call));
+  return *this;
+}
+
+void LightGroupCall::perform() {
+  for (auto &call : this->calls_)
+    call.start_();
+
+  // Write all outputs now instead of in the loop of each light, so they change at the same moment
+  for (auto &call : this->calls_) {
+    LightState *state = call.parent_;
+    if (state->next_write_) {
+      state->next_write_ = false;
+      state->output_->write_state(state);
+    }
+  }
+
+  for (auto &call : this->calls_)
+    call.finish_();
+}
+
 LightColorValues LightCall::validate_() {
   auto *name = this->parent_->get_name().c_str();
   auto traits = this->parent_->get_traits();
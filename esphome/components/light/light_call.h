@@ -3,6 +3,7 @@
 #include "esphome/core/optional.h"
 #include "light_color_values.h"
 #include <set>
+#include <vector>
 
 namespace esphome {
 namespace light {
@@ -157,6 +158,13 @@ class LightCall {
   void perform();
 
  protected:
+  friend class LightGroupCall;
+
+  /// Validate the call and start the change of the light, without writing the output or notifying anyone of it.
+  void start_();
+  /// Notify the callbacks about the change, publish it and save the new values.
+  void finish_();
+
   /// Get the currently targeted, or active if none set, color mode.
   ColorMode get_active_color_mode_();
 
@@ -193,5 +201,30 @@ class LightCall {
   bool save_{true};
 };
 
+/** Change the state of multiple lights together, for example for a scene.
+ *
+ * Performing separate calls for every light writes each output in the loop of its own light, and the publishing of
+ * the new state of one light delays the change of the next one. A group call starts all changes first, then writes
+ * all outputs right after each other, and only then publishes and saves the new states. Transitions of all lights
+ * compute their values on the same loop iterations, so lights that are changed together stay in step.
+ *
+ * \code
+ * LightGroupCall group;
+ * group.add(id(kitchen).turn_on().set_brightness(0.8f));
+ * group.add(id(hallway).turn_off());
+ * group.perform();
+ * \endcode
+ */
+class LightGroupCall {
+ public:
+  /// Add the change of a light to this group.
+  LightGroupCall &add(LightCall call);
+
+  void perform();
+
+ protected:
+  std::vector<LightCall> calls_;
+};
+
 }  // namespace light
 }  // namespace esphome
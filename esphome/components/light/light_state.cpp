@@ -1,4 +1,5 @@
 #include "esphome/core/log.h"
+#include "esphome/core/preference_saver.h"
 #include "light_state.h"
 #include "light_output.h"
 #include "transformers.h"
@@ -171,7 +172,10 @@ void LightState::set_flash_transition_length(uint32_t flash_transition_length) {
   this->flash_transition_length_ = flash_transition_length;
 }
 uint32_t LightState::get_flash_transition_length() const { return this->flash_transition_length_; }
-void LightState::set_gamma_correct(float gamma_correct) { this->gamma_correct_ = gamma_correct; }
+void LightState::set_gamma_correct(float gamma_correct) {
+  this->gamma_correct_ = gamma_correct;
+  this->gamma_table_ = nullptr;
+}
 void LightState::set_restore_mode(LightRestoreMode restore_mode) { this->restore_mode_ = restore_mode; }
 bool LightState::supports_effects() { return !this->effects_.empty(); }
 const std::vector<LightEffect *> &LightState::get_effects() const { return this->effects_; }
@@ -184,34 +188,44 @@ void LightState::add_effects(const std::vector<LightEffect *> &effects) {
 
 void LightState::current_values_as_binary(bool *binary) { this->current_values.as_binary(binary); }
 void LightState::current_values_as_brightness(float *brightness) {
-  this->current_values.as_brightness(brightness, this->gamma_correct_);
+  this->current_values.as_brightness(brightness, this->gamma_correction_());
 }
 void LightState::current_values_as_rgb(float *red, float *green, float *blue, bool color_interlock) {
   auto traits = this->get_traits();
-  this->current_values.as_rgb(red, green, blue, this->gamma_correct_, false);
+  this->current_values.as_rgb(red, green, blue, this->gamma_correction_(), false);
 }
 void LightState::current_values_as_rgbw(float *red, float *green, float *blue, float *white, bool color_interlock) {
   auto traits = this->get_traits();
-  this->current_values.as_rgbw(red, green, blue, white, this->gamma_correct_, false);
+  this->current_values.as_rgbw(red, green, blue, white, this->gamma_correction_(), false);
 }
 void LightState::current_values_as_rgbww(float *red, float *green, float *blue, float *cold_white, float *warm_white,
                                          bool constant_brightness) {
-  this->current_values.as_rgbww(red, green, blue, cold_white, warm_white, this->gamma_correct_, constant_brightness);
+  this->current_values.as_rgbww(red, green, blue, cold_white, warm_white, this->gamma_correction_(),
+                                constant_brightness);
 }
 void LightState::current_values_as_rgbct(float *red, float *green, float *blue, float *color_temperature,
                                          float *white_brightness) {
   auto traits = this->get_traits();
   this->current_values.as_rgbct(traits.get_min_mireds(), traits.get_max_mireds(), red, green, blue, color_temperature,
-                                white_brightness, this->gamma_correct_);
+                                white_brightness, this->gamma_correction_());
 }
 void LightState::current_values_as_cwww(float *cold_white, float *warm_white, bool constant_brightness) {
   auto traits = this->get_traits();
-  this->current_values.as_cwww(cold_white, warm_white, this->gamma_correct_, constant_brightness);
+  this->current_values.as_cwww(cold_white, warm_white, this->gamma_correction_(), constant_brightness);
 }
 void LightState::current_values_as_ct(float *color_temperature, float *white_brightness) {
   auto traits = this->get_traits();
   this->current_values.as_ct(traits.get_min_mireds(), traits.get_max_mireds(), color_temperature, white_brightness,
-                             this->gamma_correct_);
+                             this->gamma_correction_());
+}
+
+GammaCorrection LightState::gamma_correction_() {
+  // Only computed when the light is written to the first time, lights without gamma correction never have a table
+  if (this->gamma_table_ == nullptr)
+    this->gamma_table_ = GammaTable::get(this->gamma_correct_);
+  if (this->gamma_table_ == nullptr)
+    return this->gamma_correct_;
+  return GammaCorrection(*this->gamma_table_);
 }
 
 void LightState::start_effect_(uint32_t effect_index) {
@@ -294,7 +308,7 @@ void LightState::save_remote_values_() {
   saved.cold_white = this->remote_values.get_cold_white();
   saved.warm_white = this->remote_values.get_warm_white();
   saved.effect = this->active_effect_index_;
-  this->rtc_.save(&saved);
+  global_preference_saver.save(&this->rtc_, &saved);
 }
 
 }  // namespace light
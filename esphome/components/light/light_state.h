@@ -147,6 +147,7 @@ class LightState : public EntityBase, public Component {
  protected:
   friend LightOutput;
   friend LightCall;
+  friend LightGroupCall;
   friend class AddressableLight;
 
   /// Internal method to start an effect with the given index
@@ -164,6 +165,9 @@ class LightState : public EntityBase, public Component {
   /// Internal method to set the color values to target immediately (with no transition).
   void set_immediately_(const LightColorValues &target, bool set_remote_values);
 
+  /// Internal method to get the gamma correction to apply to current_values, from the lookup table if there is one.
+  GammaCorrection gamma_correction_();
+
   /// Internal method to save the current remote_values to the preferences
   void save_remote_values_();
 
@@ -199,6 +203,8 @@ class LightState : public EntityBase, public Component {
   uint32_t flash_transition_length_{};
   /// Gamma correction factor for the light.
   float gamma_correct_{};
+  /// Lookup table for gamma_correct_, computed on first use.
+  const GammaTable *gamma_table_{nullptr};
   /// Restore mode of the light.
   LightRestoreMode restore_mode_;
   /// List of effects for this light.
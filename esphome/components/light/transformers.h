@@ -11,7 +11,12 @@ namespace light {
 
 class LightTransitionTransformer : public LightTransformer {
  public:
+  /// Interval in ms at which new values are computed during a transition, about the refresh rate of a screen.
+  static const uint32_t TICK_INTERVAL = 16;
+
   void start() override {
+    this->last_tick_ = this->start_time_ / TICK_INTERVAL - 1;
+
     // When turning light on from off state, use target state and only increase brightness from zero.
     if (!this->start_values_.is_on() && this->target_values_.is_on()) {
       this->start_values_ = LightColorValues(this->target_values_);
@@ -38,6 +43,14 @@ class LightTransitionTransformer : public LightTransformer {
   optional<LightColorValues> apply() override {
     float p = this->get_progress_();
 
+    // Computing and writing new values on every loop iteration only costs time, the steps wouldn't be visible anyway.
+    // Ticks are aligned to the clock, so all lights in a transition change on the same loop iteration. The final values
+    // are always applied.
+    const uint32_t tick = millis() / TICK_INTERVAL;
+    if (p < 1.0f && tick == this->last_tick_)
+      return {};
+    this->last_tick_ = tick;
+
     // Halfway through, when intermediate state (off) is reached, flip it to the target, but remain off.
     if (this->changing_color_mode_ && p > 0.5f &&
         this->intermediate_values_.get_color_mode() != this->target_values_.get_color_mode()) {
@@ -59,6 +72,7 @@ class LightTransitionTransformer : public LightTransformer {
   // transition from 0 to 1 on x = [0, 1]
   static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
 
+  uint32_t last_tick_{0};
   bool changing_color_mode_{false};
   LightColorValues end_values_{};
   LightColorValues intermediate_values_{};
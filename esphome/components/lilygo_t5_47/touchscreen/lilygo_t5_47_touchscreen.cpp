@@ -45,8 +45,7 @@ void LilygoT547Touchscreen::setup() {
 
 void LilygoT547Touchscreen::loop() {
   if (!this->store_.touch) {
-    for (auto *listener : this->touch_listeners_)
-      listener->release();
+    this->release_touches_();
     return;
   }
   this->store_.touch = false;
@@ -70,8 +69,7 @@ void LilygoT547Touchscreen::loop() {
   point = buffer[5] & 0xF;
 
   if (point == 0) {
-    for (auto *listener : this->touch_listeners_)
-      listener->release();
+    this->release_touches_();
     return;
   } else if (point == 1) {
     err = this->write_register(TOUCH_REGISTER, READ_TOUCH, 1);
@@ -135,7 +133,7 @@ void LilygoT547Touchscreen::loop() {
           break;
       }
 
-      this->defer([this, tp]() { this->send_touch_(tp); });
+      this->add_touch_(tp);
     }
   } else {
     TouchPoint tp;
@@ -164,7 +162,7 @@ void LilygoT547Touchscreen::loop() {
         break;
     }
 
-    this->defer([this, tp]() { this->send_touch_(tp); });
+    this->add_touch_(tp);
   }
 
   this->status_clear_warning();
@@ -0,0 +1,65 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import web_server
+from esphome.const import (
+    CONF_ID,
+    CONF_SENSORS,
+    CONF_SWITCHES,
+    CONF_TEXT_SENSORS,
+    CONF_UPDATE_INTERVAL,
+)
+
+CODEOWNERS = ["@esphome/core"]
+AUTO_LOAD = ["sensor", "switch", "text_sensor"]
+
+CONF_PATTERN = "pattern"
+CONF_REPORT_INTERVAL = "report_interval"
+CONF_WEB_SERVER_ID = "web_server_id"
+
+load_generator_ns = cg.esphome_ns.namespace("load_generator")
+LoadGenerator = load_generator_ns.class_("LoadGenerator", cg.Component)
+
+LoadPattern = load_generator_ns.enum("LoadPattern")
+PATTERNS = {
+    "SINE": LoadPattern.LOAD_PATTERN_SINE,
+    "RAMP": LoadPattern.LOAD_PATTERN_RAMP,
+    "RANDOM": LoadPattern.LOAD_PATTERN_RANDOM,
+    "CONSTANT": LoadPattern.LOAD_PATTERN_CONSTANT,
+}
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(LoadGenerator),
+        cv.Optional(CONF_SENSORS, default=100): cv.int_range(min=0, max=2000),
+        cv.Optional(CONF_SWITCHES, default=0): cv.int_range(min=0, max=2000),
+        cv.Optional(CONF_TEXT_SENSORS, default=0): cv.int_range(min=0, max=2000),
+        cv.Optional(
+            CONF_UPDATE_INTERVAL, default="1s"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_PATTERN, default="SINE"): cv.enum(PATTERNS, upper=True),
+        cv.Optional(
+            CONF_REPORT_INTERVAL, default="10s"
+        ): cv.positive_time_period_milliseconds,
+        cv.OnlyWith(CONF_WEB_SERVER_ID, "web_server"): cv.use_id(
+            web_server.WebServer
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(
+        var.set_counts(
+            config[CONF_SENSORS], config[CONF_SWITCHES], config[CONF_TEXT_SENSORS]
+        )
+    )
+    cg.add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+    cg.add(var.set_pattern(config[CONF_PATTERN]))
+    cg.add(var.set_report_interval(config[CONF_REPORT_INTERVAL]))
+    if CONF_WEB_SERVER_ID in config:
+        server = await cg.get_variable(config[CONF_WEB_SERVER_ID])
+        cg.add(var.set_web_server(server))
+    # Before the API and the web server are set up, so they see the entities like any other
+    cg.add(var.create_entities())
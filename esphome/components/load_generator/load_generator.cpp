@@ -0,0 +1,121 @@
+#include "load_generator.h"
+
+#include <cinttypes>
+#include <cmath>
+
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
+
+namespace esphome {
+namespace load_generator {
+
+static const char *const TAG = "load_generator";
+
+void LoadGenerator::name_entity_(EntityBase *entity, const char *kind, size_t index) {
+  this->names_.push_back(str_sprintf("Load %s %u", kind, (unsigned) index));
+  entity->set_name(this->names_.back().c_str());
+  this->names_.push_back(str_sanitize(str_snake_case(this->names_.back())));
+  entity->set_object_id(this->names_.back().c_str());
+}
+
+void LoadGenerator::create_entities() {
+  for (size_t i = 0; i < this->sensor_count_; i++) {
+    auto *sens = new sensor::Sensor();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->name_entity_(sens, "Sensor", i);
+    sens->set_accuracy_decimals(2);
+    App.register_sensor(sens);
+    this->sensors_.push_back(sens);
+  }
+  for (size_t i = 0; i < this->switch_count_; i++) {
+    auto *sw = new LoadSwitch();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->name_entity_(sw, "Switch", i);
+    App.register_switch(sw);
+    this->switches_.push_back(sw);
+  }
+  for (size_t i = 0; i < this->text_sensor_count_; i++) {
+    auto *sens = new text_sensor::TextSensor();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->name_entity_(sens, "Text Sensor", i);
+    App.register_text_sensor(sens);
+    this->text_sensors_.push_back(sens);
+  }
+}
+
+void LoadGenerator::setup() {
+  this->set_interval("update", this->update_interval_, [this]() { this->publish_all_(); });
+  this->last_report_ = millis();
+  this->set_interval("report", this->report_interval_, [this]() { this->report_(); });
+}
+
+void LoadGenerator::dump_config() {
+  ESP_LOGCONFIG(TAG, "Load Generator:");
+  ESP_LOGCONFIG(TAG, "  Sensors: %u, switches: %u, text sensors: %u", this->sensor_count_, this->switch_count_,
+                this->text_sensor_count_);
+  ESP_LOGCONFIG(TAG, "  Update interval: %" PRIu32 " ms", this->update_interval_);
+  ESP_LOGCONFIG(TAG, "  Report interval: %" PRIu32 " ms", this->report_interval_);
+}
+
+float LoadGenerator::next_value_(size_t index) {
+  switch (this->pattern_) {
+    case LOAD_PATTERN_SINE:
+      // Phase shifted per sensor, so the values don't all move together
+      return 50.0f + 50.0f * sinf((this->step_ + index) * 0.1f);
+    case LOAD_PATTERN_RAMP:
+      return (this->step_ + index) % 100;
+    case LOAD_PATTERN_RANDOM:
+      return random_float() * 100.0f;
+    case LOAD_PATTERN_CONSTANT:
+    default:
+      return index;
+  }
+}
+
+void LoadGenerator::publish_all_() {
+  for (size_t i = 0; i < this->sensors_.size(); i++)
+    this->sensors_[i]->publish_state(this->next_value_(i));
+  for (auto *sw : this->switches_)
+    sw->publish_state(!sw->state);
+  if (!this->text_sensors_.empty()) {
+    const std::string value = str_sprintf("step %" PRIu32, this->step_);
+    for (auto *sens : this->text_sensors_)
+      sens->publish_state(value);
+  }
+  this->published_ += this->sensors_.size() + this->switches_.size() + this->text_sensors_.size();
+  this->step_++;
+}
+
+void LoadGenerator::report_() {
+  const uint32_t now = millis();
+  const float seconds = std::max(now - this->last_report_, uint32_t(1)) / 1000.0f;
+  this->last_report_ = now;
+
+  ESP_LOGI(TAG, "Published %.0f states/s", (this->published_ - this->last_published_) / seconds);
+  this->last_published_ = this->published_;
+#ifdef USE_API
+  if (api::global_api_server != nullptr) {
+    const uint32_t sent = api::global_api_server->get_messages_sent();
+    ESP_LOGI(TAG, "  API: %.0f messages/s, %" PRIu32 " deferred, %" PRIu32 " coalesced, %u waiting, %u bytes backlog",
+             (sent - this->last_api_sent_) / seconds, api::global_api_server->get_states_deferred(),
+             api::global_api_server->get_states_coalesced(), (unsigned) api::global_api_server->get_deferred_states(),
+             (unsigned) api::global_api_server->get_tx_backlog());
+    this->last_api_sent_ = sent;
+  }
+#endif
+#ifdef USE_WEBSERVER
+  if (this->web_server_ != nullptr) {
+    const uint32_t sent = this->web_server_->get_states_sent();
+    ESP_LOGI(TAG, "  Web server: %.0f events/s, %" PRIu32 " deferred, %" PRIu32 " coalesced, %u waiting",
+             (sent - this->last_web_sent_) / seconds, this->web_server_->get_states_deferred(),
+             this->web_server_->get_states_coalesced(), (unsigned) this->web_server_->get_pending_states());
+    this->last_web_sent_ = sent;
+  }
+#endif
+}
+
+}  // namespace load_generator
+}  // namespace esphome
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/switch/switch.h"
+#include "esphome/components/text_sensor/text_sensor.h"
+
+#ifdef USE_WEBSERVER
+#include "esphome/components/web_server/web_server.h"
+#endif
+
+namespace esphome {
+namespace load_generator {
+
+enum LoadPattern : uint8_t {
+  LOAD_PATTERN_SINE,
+  LOAD_PATTERN_RAMP,
+  LOAD_PATTERN_RANDOM,
+  LOAD_PATTERN_CONSTANT,
+};
+
+/// A switch that only reports back what it was set to.
+class LoadSwitch : public switch_::Switch {
+ protected:
+  void write_state(bool state) override { this->publish_state(state); }
+};
+
+/** Creates lots of entities and publishes them at a fixed rate, to measure how the API and the web server keep up.
+ *
+ * The entities are registered like configured ones, so clients list and subscribe to them as usual. Every update
+ * interval each sensor publishes the next value of the pattern, each switch toggles and each text sensor publishes a
+ * new string. Every report interval the rate of published states is logged, along with the rate the API and the web
+ * server sent them at and how many states had to wait for a congested client or were replaced while waiting.
+ */
+class LoadGenerator : public Component {
+ public:
+  void set_counts(uint16_t sensors, uint16_t switches, uint16_t text_sensors) {
+    this->sensor_count_ = sensors;
+    this->switch_count_ = switches;
+    this->text_sensor_count_ = text_sensors;
+  }
+  void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+  void set_pattern(LoadPattern pattern) { this->pattern_ = pattern; }
+  void set_report_interval(uint32_t report_interval) { this->report_interval_ = report_interval; }
+#ifdef USE_WEBSERVER
+  void set_web_server(web_server::WebServer *web_server) { this->web_server_ = web_server; }
+#endif
+
+  /// Create and register the entities, has to run before the API and the web server are set up.
+  void create_entities();
+
+  void setup() override;
+  void dump_config() override;
+
+ protected:
+  /// Name and object ID for the index-th entity of a kind, kept for as long as the entity.
+  void name_entity_(EntityBase *entity, const char *kind, size_t index);
+  void publish_all_();
+  void report_();
+  float next_value_(size_t index);
+
+  uint16_t sensor_count_{0};
+  uint16_t switch_count_{0};
+  uint16_t text_sensor_count_{0};
+  uint32_t update_interval_{1000};
+  LoadPattern pattern_{LOAD_PATTERN_SINE};
+  uint32_t report_interval_{10000};
+#ifdef USE_WEBSERVER
+  web_server::WebServer *web_server_{nullptr};
+#endif
+
+  /// Entities point into the strings, a deque doesn't move them when it grows.
+  std::deque<std::string> names_;
+  std::vector<sensor::Sensor *> sensors_;
+  std::vector<LoadSwitch *> switches_;
+  std::vector<text_sensor::TextSensor *> text_sensors_;
+
+  uint32_t step_{0};
+  uint32_t published_{0};
+  /// Totals at the previous report, to turn them into rates.
+  uint32_t last_report_{0};
+  uint32_t last_published_{0};
+  uint32_t last_api_sent_{0};
+  uint32_t last_web_sent_{0};
+};
+
+}  // namespace load_generator
+}  // namespace esphome
@@ -8,6 +8,7 @@ from esphome.const import (
     CONF_ARGS,
     CONF_BAUD_RATE,
     CONF_DEASSERT_RTS_DTR,
+    CONF_DEFERRED_FORMAT,
     CONF_FORMAT,
     CONF_HARDWARE_UART,
     CONF_ID,
@@ -158,6 +159,7 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_ASYNC_BUFFER_SIZE = "async_buffer_size"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -165,6 +167,10 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
             cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
             cv.Optional(CONF_DEASSERT_RTS_DTR, default=False): cv.boolean,
+            cv.Optional(CONF_DEFERRED_FORMAT): cv.All(cv.only_on_esp32, cv.boolean),
+            cv.Optional(CONF_ASYNC_BUFFER_SIZE): cv.All(
+                cv.only_on_esp32, cv.validate_bytes, cv.int_range(min=256)
+            ),
             cv.SplitDefault(
                 CONF_HARDWARE_UART,
                 esp8266=UART0,
@@ -215,6 +221,11 @@ async def to_code(config):
                 HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]]
             )
         )
+    if config.get(CONF_DEFERRED_FORMAT):
+        cg.add_define("USE_LOGGER_DEFERRED_FORMAT")
+    if CONF_ASYNC_BUFFER_SIZE in config:
+        cg.add_define("USE_LOGGER_ASYNC")
+        cg.add(log.set_async_buffer_size(config[CONF_ASYNC_BUFFER_SIZE]))
     cg.add(log.pre_setup())
 
     for tag, level in config[CONF_LOGS].items():
@@ -1,4 +1,5 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
 
 #ifdef USE_ESP_IDF
@@ -7,6 +8,15 @@
 #include "esp_idf_version.h"
 #endif  // USE_ESP_IDF
 
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include <esp_memory_utils.h>
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+#endif  // USE_LOGGER_DEFERRED_FORMAT
+
 #if defined(USE_ESP32_FRAMEWORK_ARDUINO) || defined(USE_ESP_IDF)
 #include <esp_log.h>
 #endif  // USE_ESP32_FRAMEWORK_ARDUINO || USE_ESP_IDF
@@ -51,21 +61,43 @@ void Logger::write_header_(int level, const char *tag, int line) {
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag) || !this->has_listener_(level))
     return;
-
-  recursion_guard_ = true;
-  this->reset_buffer_();
-  this->write_header_(level, tag, line);
-  this->vprintf_to_buffer_(format, args);
-  this->write_footer_();
-  this->log_message_(level, tag);
-  recursion_guard_ = false;
+#ifdef USE_LOGGER_ASYNC
+  // never wait here, the task holding the lock may itself wait for the caller (e.g. the lwIP task)
+  if (this->async_lock_ != nullptr && xSemaphoreTakeRecursive(this->async_lock_, 0) != pdTRUE) {
+    this->async_dropped_++;
+    return;
+  }
+#endif
+  if (!recursion_guard_) {
+    recursion_guard_ = true;
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+    if (this->baud_rate_ > 0 && this->write_deferred_(level, tag, line, format, args)) {
+      // the serial port got the compact record, only format text if someone else wants it
+      if (level <= this->log_callback_level_) {
+        this->format_message_(level, tag, line, format, args);
+        this->log_message_(level, tag, 0, false);
+      }
+    } else {
+      this->format_message_(level, tag, line, format, args);
+      this->log_message_(level, tag);
+    }
+#else
+    this->format_message_(level, tag, line, format, args);
+    this->log_message_(level, tag);
+#endif
+    recursion_guard_ = false;
+  }
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_lock_ != nullptr)
+    xSemaphoreGiveRecursive(this->async_lock_);
+#endif
 }
 #ifdef USE_STORE_LOG_STR_IN_FLASH
 void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStringHelper *format,
                           va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag) || !this->has_listener_(level) || recursion_guard_)
     return;
 
   recursion_guard_ = true;
@@ -93,7 +125,17 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 }
 #endif
 
+/// One bit per tag derived from its first two characters, a cheap filter in front of the override lookup.
+static inline uint32_t tag_filter_bit(const char *tag) {
+  if (tag[0] == '\0')
+    return 1;
+  return 1u << ((tag[0] + 3 * tag[1]) & 31);
+}
+
 int HOT Logger::level_for(const char *tag) {
+  // Most tags have no override, the filter rejects them without comparing any strings.
+  if ((this->log_level_filter_ & tag_filter_bit(tag)) == 0)
+    return ESPHOME_LOG_LEVEL;
   // Uses std::vector<> for low memory footprint, though the vector
   // could be sorted to minimize lookup times. This feature isn't used that
   // much anyway so it doesn't matter too much.
@@ -104,7 +146,14 @@ int HOT Logger::level_for(const char *tag) {
   }
   return ESPHOME_LOG_LEVEL;
 }
-void HOT Logger::log_message_(int level, const char *tag, int offset) {
+void HOT Logger::format_message_(int level, const char *tag, int line, const char *format, va_list args) {
+  this->reset_buffer_();
+  this->write_header_(level, tag, line);
+  this->vprintf_to_buffer_(format, args);
+  this->write_footer_();
+}
+
+void HOT Logger::log_message_(int level, const char *tag, int offset, bool serial) {
   // remove trailing newline
   if (this->tx_buffer_[this->tx_buffer_at_ - 1] == '\n') {
     this->tx_buffer_at_--;
@@ -113,29 +162,8 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   this->set_null_terminator_();
 
   const char *msg = this->tx_buffer_ + offset;
-  if (this->baud_rate_ > 0) {
-#ifdef USE_ARDUINO
-    this->hw_serial_->println(msg);
-#endif  // USE_ARDUINO
-#ifdef USE_ESP_IDF
-    if (
-#if defined(USE_ESP32_VARIANT_ESP32S2)
-        uart_ == UART_SELECTION_USB_CDC
-#elif defined(USE_ESP32_VARIANT_ESP32C3) || defined(USE_ESP32_VARIANT_ESP32C6)
-        uart_ == UART_SELECTION_USB_SERIAL_JTAG
-#elif defined(USE_ESP32_VARIANT_ESP32S3)
-        uart_ == UART_SELECTION_USB_CDC || uart_ == UART_SELECTION_USB_SERIAL_JTAG
-#else
-        /* DISABLES CODE */ (false)  // NOLINT
-#endif
-    ) {
-      puts(msg);
-    } else {
-      uart_write_bytes(uart_num_, msg, strlen(msg));
-      uart_write_bytes(uart_num_, "\n", 1);
-    }
-#endif
-  }
+  if (this->baud_rate_ > 0 && serial)
+    this->send_serial_(msg);
 
 #ifdef USE_ESP32
   // Suppress network-logging if memory constrained, but still log to serial
@@ -153,6 +181,226 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   this->log_callback_.call(level, tag, msg);
 }
 
+void HOT Logger::send_serial_(const char *msg) {
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_buffer_ != nullptr) {
+    if (xRingbufferSend(this->async_buffer_, msg, strlen(msg) + 1, 0) != pdTRUE)
+      this->async_dropped_++;
+    return;
+  }
+#endif
+  this->write_msg_(msg);
+}
+
+void HOT Logger::write_msg_(const char *msg) {
+#ifdef USE_ARDUINO
+  this->hw_serial_->println(msg);
+#endif  // USE_ARDUINO
+#ifdef USE_ESP_IDF
+  if (
+#if defined(USE_ESP32_VARIANT_ESP32S2)
+      uart_ == UART_SELECTION_USB_CDC
+#elif defined(USE_ESP32_VARIANT_ESP32C3) || defined(USE_ESP32_VARIANT_ESP32C6)
+      uart_ == UART_SELECTION_USB_SERIAL_JTAG
+#elif defined(USE_ESP32_VARIANT_ESP32S3)
+      uart_ == UART_SELECTION_USB_CDC || uart_ == UART_SELECTION_USB_SERIAL_JTAG
+#else
+      /* DISABLES CODE */ (false)  // NOLINT
+#endif
+  ) {
+    puts(msg);
+  } else {
+    uart_write_bytes(uart_num_, msg, strlen(msg));
+    uart_write_bytes(uart_num_, "\n", 1);
+  }
+#endif
+}
+
+#ifdef USE_LOGGER_ASYNC
+void Logger::async_task_(void *arg) {
+  auto *logger = static_cast<Logger *>(arg);
+  uint32_t reported_dropped = 0;
+  while (true) {
+    size_t len;
+    auto *msg = static_cast<char *>(xRingbufferReceive(logger->async_buffer_, &len, portMAX_DELAY));
+    if (msg == nullptr)
+      continue;
+    logger->write_msg_(msg);
+    vRingbufferReturnItem(logger->async_buffer_, msg);
+
+    uint32_t dropped = logger->async_dropped_;
+    if (dropped != reported_dropped) {
+      char buf[64];
+      snprintf(buf, sizeof(buf), "%s[W][logger]: %" PRIu32 " log lines dropped%s", LOG_LEVEL_COLORS[2],
+               dropped - reported_dropped, ESPHOME_LOG_RESET_COLOR);
+      logger->write_msg_(buf);
+      reported_dropped = dropped;
+    }
+  }
+}
+#endif
+
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+// Record layout, all little endian: level (u8), line (u16), tag address (u32), format address (u32),
+// then one entry per argument consumed by the format: 4 or 8 byte integers, 8 byte doubles and
+// strings as length (u8) + bytes. Sent base64 encoded after DEFERRED_MARKER so it stays one line.
+static const char DEFERRED_MARKER = '\x02';
+static const size_t DEFERRED_RECORD_SIZE = 192;
+static const char *const BASE64_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+struct DeferredRecord {
+  uint8_t data[DEFERRED_RECORD_SIZE];
+  size_t len{0};
+  bool overflow{false};
+
+  void put(uint64_t value, size_t size) {
+    if (this->len + size > sizeof(this->data)) {
+      this->overflow = true;
+      return;
+    }
+    for (size_t i = 0; i < size; i++)
+      this->data[this->len++] = static_cast<uint8_t>(value >> (i * 8));
+  }
+};
+
+bool HOT Logger::write_deferred_(int level, const char *tag, int line, const char *format, va_list args) {
+  if (!esp_ptr_in_drom(tag) || !esp_ptr_in_drom(format))
+    return false;
+
+  DeferredRecord record;
+  record.put(level, 1);
+  record.put(line, 2);
+  record.put(reinterpret_cast<uintptr_t>(tag), 4);
+  record.put(reinterpret_cast<uintptr_t>(format), 4);
+
+  va_list arg;
+  va_copy(arg, args);
+  bool ok = true;
+  for (const char *p = format; ok && !record.overflow && *p != '\0'; p++) {
+    if (*p != '%')
+      continue;
+    p++;
+    if (*p == '%')
+      continue;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+      p++;
+    if (*p == '*') {
+      record.put(va_arg(arg, int), 4);
+      p++;
+    }
+    while (*p >= '0' && *p <= '9')
+      p++;
+    int precision = -1;
+    if (*p == '.') {
+      p++;
+      precision = 0;
+      if (*p == '*') {
+        precision = va_arg(arg, int);
+        record.put(precision, 4);
+        p++;
+      }
+      while (*p >= '0' && *p <= '9')
+        precision = precision * 10 + (*p++ - '0');
+    }
+    int longs = 0;
+    while (*p == 'h' || *p == 'l' || *p == 'j' || *p == 'z' || *p == 't') {
+      if (*p == 'l')
+        longs++;
+      if (*p == 'j')
+        longs = 2;
+      p++;
+    }
+    switch (*p) {
+      case 'd':
+      case 'i':
+        if (longs >= 2) {
+          record.put(va_arg(arg, long long), 8);
+        } else if (longs == 1) {
+          record.put(va_arg(arg, long), 4);
+        } else {
+          record.put(va_arg(arg, int), 4);
+        }
+        break;
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+        if (longs >= 2) {
+          record.put(va_arg(arg, unsigned long long), 8);
+        } else if (longs == 1) {
+          record.put(va_arg(arg, unsigned long), 4);
+        } else {
+          record.put(va_arg(arg, unsigned int), 4);
+        }
+        break;
+      case 'c':
+        record.put(va_arg(arg, int), 4);
+        break;
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A': {
+        double value = va_arg(arg, double);
+        uint64_t raw;
+        memcpy(&raw, &value, sizeof(raw));
+        record.put(raw, 8);
+        break;
+      }
+      case 's': {
+        const char *str = va_arg(arg, const char *);
+        if (str == nullptr)
+          str = "(null)";
+        size_t len = 0;
+        while (len < 255 && (precision < 0 || len < (size_t) precision) && str[len] != '\0')
+          len++;
+        if (len == 255 && (precision < 0 || precision > 255) && str[len] != '\0') {
+          // doesn't fit the length byte, let vsnprintf format it in full
+          ok = false;
+          break;
+        }
+        record.put(len, 1);
+        for (size_t i = 0; i < len; i++)
+          record.put(static_cast<uint8_t>(str[i]), 1);
+        break;
+      }
+      case 'p':
+        record.put(reinterpret_cast<uintptr_t>(va_arg(arg, void *)), 4);
+        break;
+      default:
+        // %n, long double or a malformed format, leave those to vsnprintf
+        ok = false;
+        break;
+    }
+  }
+  va_end(arg);
+  if (!ok || record.overflow)
+    return false;
+
+  if (1 + (record.len + 2) / 3 * 4 >= (size_t) this->tx_buffer_size_)
+    return false;
+  this->reset_buffer_();
+  this->write_to_buffer_(DEFERRED_MARKER);
+  for (size_t i = 0; i < record.len; i += 3) {
+    uint32_t chunk = record.data[i] << 16;
+    if (i + 1 < record.len)
+      chunk |= record.data[i + 1] << 8;
+    if (i + 2 < record.len)
+      chunk |= record.data[i + 2];
+    this->write_to_buffer_(BASE64_CHARS[(chunk >> 18) & 0x3F]);
+    this->write_to_buffer_(BASE64_CHARS[(chunk >> 12) & 0x3F]);
+    this->write_to_buffer_(i + 1 < record.len ? BASE64_CHARS[(chunk >> 6) & 0x3F] : '=');
+    this->write_to_buffer_(i + 2 < record.len ? BASE64_CHARS[chunk & 0x3F] : '=');
+  }
+  this->set_null_terminator_();
+  this->send_serial_(this->tx_buffer_);
+  return true;
+}
+#endif  // USE_LOGGER_DEFERRED_FORMAT
+
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size) {
   // add 1 to buffer size for null terminator
   this->tx_buffer_ = new char[this->tx_buffer_size_ + 1];  // NOLINT
@@ -257,6 +505,20 @@ void Logger::pre_setup() {
   }
 #endif  // USE_ESP8266
 
+#ifdef USE_LOGGER_ASYNC
+  if (this->baud_rate_ > 0 && this->async_buffer_size_ > 0) {
+    this->async_lock_ = xSemaphoreCreateRecursiveMutex();
+    this->async_buffer_ = xRingbufferCreate(this->async_buffer_size_, RINGBUF_TYPE_NOSPLIT);
+    if (this->async_lock_ == nullptr || this->async_buffer_ == nullptr ||
+        xTaskCreate(Logger::async_task_, "logger", 3072, this, 1, nullptr) != pdPASS) {
+      // fall back to writing synchronously, the lock is harmless
+      if (this->async_buffer_ != nullptr)
+        vRingbufferDelete(this->async_buffer_);
+      this->async_buffer_ = nullptr;
+    }
+  }
+#endif  // USE_LOGGER_ASYNC
+
   global_logger = this;
 #if defined(USE_ESP_IDF) || defined(USE_ESP32_FRAMEWORK_ARDUINO)
   esp_log_set_vprintf(esp_idf_log_vprintf_);
@@ -316,14 +578,25 @@ void Logger::pre_setup() {
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
   this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  this->log_level_filter_ |= tag_filter_bit(tag.c_str());
 }
 
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
 UARTSelection Logger::get_uart() const { return this->uart_; }
 #endif
 
-void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
+size_t Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback, int level) {
   this->log_callback_.add(std::move(callback));
+  this->log_callback_levels_.push_back(ESPHOME_LOG_LEVEL_NONE);
+  size_t handle = this->log_callback_levels_.size() - 1;
+  this->set_log_callback_level(handle, level);
+  return handle;
+}
+void Logger::set_log_callback_level(size_t handle, int level) {
+  this->log_callback_levels_[handle] = level;
+  this->log_callback_level_ = ESPHOME_LOG_LEVEL_NONE;
+  for (int callback_level : this->log_callback_levels_)
+    this->log_callback_level_ = std::max(this->log_callback_level_, callback_level);
 }
 float Logger::get_setup_priority() const { return setup_priority::BUS + 500.0f; }
 const char *const LOG_LEVELS[] = {"NONE", "ERROR", "WARN", "INFO", "CONFIG", "DEBUG", "VERBOSE", "VERY_VERBOSE"};
@@ -360,6 +633,15 @@ void Logger::dump_config() {
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
 #endif
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+  ESP_LOGCONFIG(TAG, "  Deferred Format: YES");
+#endif
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_buffer_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Async Buffer Size: %u", (unsigned) this->async_buffer_size_);
+    ESP_LOGCONFIG(TAG, "  Async Lines Dropped: %" PRIu32, this->get_async_dropped());
+  }
+#endif
 
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
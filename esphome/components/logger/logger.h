@@ -6,6 +6,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
 
 #ifdef USE_ARDUINO
 #if defined(USE_ESP8266) || defined(USE_ESP32)
@@ -21,6 +22,13 @@
 #include <driver/uart.h>
 #endif  // USE_ESP_IDF
 
+#ifdef USE_LOGGER_ASYNC
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/ringbuf.h>
+#include <freertos/semphr.h>
+#endif  // USE_LOGGER_ASYNC
+
 namespace esphome {
 
 namespace logger {
@@ -84,6 +92,15 @@ class Logger : public Component {
 
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
+#ifdef USE_LOGGER_ASYNC
+  /** Queue serial output in a ring buffer of this size, written out by a low priority task.
+   *
+   * Must be called before pre_setup(). Lines that don't fit are dropped and counted.
+   */
+  void set_async_buffer_size(size_t async_buffer_size) { this->async_buffer_size_ = async_buffer_size; }
+  /// Number of lines dropped because the ring buffer was full or another task was logging.
+  uint32_t get_async_dropped() const { return this->async_dropped_; }
+#endif
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -93,8 +110,15 @@ class Logger : public Component {
 
   int level_for(const char *tag);
 
-  /// Register a callback that will be called for every log message sent
-  void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+  /** Register a callback that will be called for every log message sent.
+   *
+   * level is the most verbose level the callback uses, it can be changed later with set_log_callback_level() using
+   * the returned handle. Messages more verbose than what any callback and the serial port want are not formatted.
+   */
+  size_t add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback,
+                             int level = ESPHOME_LOG_LEVEL_VERY_VERBOSE);
+  /// Change the level of a callback, for sinks like API connections that subscribe and unsubscribe at runtime.
+  void set_log_callback_level(size_t handle, int level);
 
   float get_setup_priority() const override;
 
@@ -104,9 +128,34 @@ class Logger : public Component {
 #endif
 
  protected:
+  /// Whether the serial port or any callback wants messages of this level, otherwise formatting can be skipped.
+  inline bool has_listener_(int level) const {
+#ifdef USE_HOST
+    // always printed to stdout
+    return true;
+#else
+    return this->baud_rate_ > 0 || level <= this->log_callback_level_;
+#endif
+  }
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
-  void log_message_(int level, const char *tag, int offset = 0);
+  void format_message_(int level, const char *tag, int line, const char *format, va_list args);
+  void log_message_(int level, const char *tag, int offset = 0, bool serial = true);
+  /// Send a line to the serial port, through the async buffer if there is one.
+  void send_serial_(const char *msg);
+  /// Write a line to the serial port, blocks until the hardware took it.
+  void write_msg_(const char *msg);
+#ifdef USE_LOGGER_DEFERRED_FORMAT
+  /** Send a compact record with the format string address and raw arguments to the serial port.
+   *
+   * `esphome logs` rebuilds the text from the firmware ELF. Returns false if the message can't be
+   * deferred (format or tag not in flash, unsupported conversion, too long), it must be sent as text then.
+   */
+  bool write_deferred_(int level, const char *tag, int line, const char *format, va_list args);
+#endif
+#ifdef USE_LOGGER_ASYNC
+  static void async_task_(void *arg);
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -167,9 +216,22 @@ class Logger : public Component {
     int level;
   };
   std::vector<LogLevelOverride> log_levels_;
+  /// Bits of all tags in log_levels_, see tag_filter_bit().
+  uint32_t log_level_filter_{0};
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
+  /// Level of every callback in log_callback_, by handle.
+  std::vector<int> log_callback_levels_;
+  /// Most verbose level of all callbacks.
+  int log_callback_level_{ESPHOME_LOG_LEVEL_NONE};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
+#ifdef USE_LOGGER_ASYNC
+  size_t async_buffer_size_{0};
+  RingbufHandle_t async_buffer_{nullptr};
+  /// Guards tx_buffer_ once other tasks can log concurrently, recursive for callbacks that log.
+  SemaphoreHandle_t async_lock_{nullptr};
+  std::atomic<uint32_t> async_dropped_{0};
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -178,11 +240,13 @@ class LoggerMessageTrigger : public Trigger<int, const char *, const char *> {
  public:
   explicit LoggerMessageTrigger(Logger *parent, int level) {
     this->level_ = level;
-    parent->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      if (level <= this->level_) {
-        this->trigger(level, tag, message);
-      }
-    });
+    parent->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          if (level <= this->level_) {
+            this->trigger(level, tag, message);
+          }
+        },
+        level);
   }
 
  protected:
@@ -160,28 +160,26 @@ void MAX31865Sensor::write_config_(uint8_t mask, uint8_t bits, uint8_t start_pos
 
 void MAX31865Sensor::write_register_(uint8_t reg, uint8_t value) {
   this->enable();
-  this->write_byte(reg |= SPI_WRITE_M);
-  this->write_byte(value);
+  this->transfer_cmd_addr(8, reg |= SPI_WRITE_M, 0, 0, &value, nullptr, 1);
   this->disable();
   ESP_LOGVV(TAG, "write_register_ 0x%02X: 0x%02X", reg, value);
 }
 
 uint8_t MAX31865Sensor::read_register_(uint8_t reg) {
+  uint8_t value;
   this->enable();
-  this->write_byte(reg);
-  const uint8_t value(this->read_byte());
+  this->transfer_cmd_addr(8, reg, 0, 0, nullptr, &value, 1);
   this->disable();
   ESP_LOGVV(TAG, "read_register_ 0x%02X: 0x%02X", reg, value);
   return value;
 }
 
 uint16_t MAX31865Sensor::read_register_16_(uint8_t reg) {
+  uint8_t data[2];
   this->enable();
-  this->write_byte(reg);
-  const uint8_t msb(this->read_byte());
-  const uint8_t lsb(this->read_byte());
+  this->transfer_cmd_addr(8, reg, 0, 0, nullptr, data, 2);
   this->disable();
-  const uint16_t value((msb << 8) | lsb);
+  const uint16_t value((data[0] << 8) | data[1]);
   ESP_LOGVV(TAG, "read_register_16_ 0x%02X: 0x%04X", reg, value);
   return value;
 }
@@ -1,7 +1,8 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+from esphome import pins
 from esphome.components import spi, canbus
-from esphome.const import CONF_ID, CONF_MODE
+from esphome.const import CONF_ID, CONF_INTERRUPT_PIN, CONF_MODE
 from esphome.components.canbus import CanbusComponent
 
 CODEOWNERS = ["@mvturnho", "@danielschramm"]
@@ -32,6 +33,7 @@ CONFIG_SCHEMA = canbus.CANBUS_SCHEMA.extend(
         cv.GenerateID(): cv.declare_id(mcp2515),
         cv.Optional(CONF_CLOCK, default="8MHZ"): cv.enum(CAN_CLOCK, upper=True),
         cv.Optional(CONF_MODE, default="NORMAL"): cv.enum(MCP_MODE, upper=True),
+        cv.Optional(CONF_INTERRUPT_PIN): pins.internal_gpio_input_pin_schema,
     }
 ).extend(spi.spi_device_schema(True))
 
@@ -46,5 +48,8 @@ async def to_code(config):
     if CONF_MODE in config:
         mode = MCP_MODE[config[CONF_MODE]]
         cg.add(var.set_mcp_mode(mode))
+    if CONF_INTERRUPT_PIN in config:
+        pin = await cg.gpio_pin_expression(config[CONF_INTERRUPT_PIN])
+        cg.add(var.set_interrupt_pin(pin))
 
     await spi.register_spi_device(var, config)
@@ -15,6 +15,8 @@ const struct MCP2515::RxBnRegs MCP2515::RXB[N_RXBUFFERS] = {{MCP_RXB0CTRL, MCP_R
 
 bool MCP2515::setup_internal() {
   this->spi_setup();
+  if (this->interrupt_pin_ != nullptr)
+    this->interrupt_pin_->setup();
 
   if (this->reset_() != canbus::ERROR_OK)
     return false;
@@ -303,7 +305,75 @@ canbus::Error MCP2515::read_message_(RXBn rxbn, struct canbus::CanFrame *frame)
   return canbus::ERROR_OK;
 }
 
+void MCP2515::read_rx_buffer_(RXBn rxbn, struct canbus::CanFrame *frame) {
+  uint8_t tbufdata[5];
+
+  // READ RX BUFFER starts at RXBnSIDH and clears RXnIF when CS goes high, so one transfer reads and releases the buffer
+  this->enable();
+  this->transfer_byte(rxbn == RXB0 ? INSTRUCTION_READ_RX0 : INSTRUCTION_READ_RX1);
+  for (auto &value : tbufdata)
+    value = this->transfer_byte(0x00);
+  uint8_t dlc = (tbufdata[MCP_DLC] & DLC_MASK);
+  if (dlc > canbus::CAN_MAX_DATA_LENGTH)
+    dlc = canbus::CAN_MAX_DATA_LENGTH;
+  for (uint8_t i = 0; i < dlc; i++)
+    frame->data[i] = this->transfer_byte(0x00);
+  this->disable();
+
+  uint32_t id = (tbufdata[MCP_SIDH] << 3) + (tbufdata[MCP_SIDL] >> 5);
+  bool use_extended_id = false;
+  bool remote_transmission_request;
+
+  if ((tbufdata[MCP_SIDL] & TXB_EXIDE_MASK) == TXB_EXIDE_MASK) {
+    id = (id << 2) + (tbufdata[MCP_SIDL] & 0x03);
+    id = (id << 8) + tbufdata[MCP_EID8];
+    id = (id << 8) + tbufdata[MCP_EID0];
+    use_extended_id = true;
+    remote_transmission_request = tbufdata[MCP_DLC] & RTR_MASK;
+  } else {
+    remote_transmission_request = tbufdata[MCP_SIDL] & SIDL_SRR_MASK;
+  }
+
+  frame->can_id = id;
+  frame->can_data_length_code = dlc;
+  frame->use_extended_id = use_extended_id;
+  frame->remote_transmission_request = remote_transmission_request;
+}
+
+void MCP2515::read_rx_buffers_() {
+  this->rx_frames_count_ = 0;
+  this->rx_frames_index_ = 0;
+
+  uint8_t stat = get_status_();
+  // with rollover RXB0 holds the older frame
+  if (stat & STAT_RX0IF)
+    this->read_rx_buffer_(RXB0, &this->rx_frames_[this->rx_frames_count_++]);
+  if (stat & STAT_RX1IF)
+    this->read_rx_buffer_(RXB1, &this->rx_frames_[this->rx_frames_count_++]);
+
+  if ((stat & STAT_RXIF_MASK) == 0) {
+    // INT is low for an error, clear it so the pin is released again
+    ESP_LOGW(TAG, "Interrupt without a received frame, error_flags = %02X", this->get_error_flags_());
+    this->clear_rx_n_ovr_flags_();
+    this->clear_errif_();
+    this->clear_merr_();
+  }
+}
+
 canbus::Error MCP2515::read_message(struct canbus::CanFrame *frame) {
+  if (this->interrupt_pin_ != nullptr) {
+    if (this->rx_frames_index_ == this->rx_frames_count_) {
+      // INT is high while both receive buffers are empty
+      if (this->interrupt_pin_->digital_read())
+        return canbus::ERROR_NOMSG;
+      this->read_rx_buffers_();
+      if (this->rx_frames_count_ == 0)
+        return canbus::ERROR_NOMSG;
+    }
+    *frame = this->rx_frames_[this->rx_frames_index_++];
+    return canbus::ERROR_OK;
+  }
+
   canbus::Error rc;
   uint8_t stat = get_status_();
 
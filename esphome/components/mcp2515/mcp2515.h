@@ -59,6 +59,12 @@ class MCP2515 : public canbus::Canbus,
   MCP2515(){};
   void set_mcp_clock(CanClock clock) { this->mcp_clock_ = clock; };
   void set_mcp_mode(const CanctrlReqopMode mode) { this->mcp_mode_ = mode; }
+  /** Set the pin connected to INT of the MCP2515.
+   *
+   * INT is held low while a receive buffer holds a frame, so with it connected an idle bus costs no SPI transfer
+   * and both receive buffers are read in one go with READ RX BUFFER when it is low.
+   */
+  void set_interrupt_pin(InternalGPIOPin *interrupt_pin) { this->interrupt_pin_ = interrupt_pin; }
   static const struct TxBnRegs {
     REGISTER CTRL;
     REGISTER SIDH;
@@ -75,6 +81,11 @@ class MCP2515 : public canbus::Canbus,
  protected:
   CanClock mcp_clock_{MCP_8MHZ};
   CanctrlReqopMode mcp_mode_ = CANCTRL_REQOP_NORMAL;
+  InternalGPIOPin *interrupt_pin_{nullptr};
+  /// Frames read from the receive buffers that weren't passed on yet
+  struct canbus::CanFrame rx_frames_[N_RXBUFFERS];
+  uint8_t rx_frames_count_{0};
+  uint8_t rx_frames_index_{0};
   bool setup_internal() override;
   canbus::Error set_mode_(CanctrlReqopMode mode);
 
@@ -95,6 +106,8 @@ class MCP2515 : public canbus::Canbus,
   canbus::Error send_message(struct canbus::CanFrame *frame) override;
   canbus::Error read_message_(RXBn rxbn, struct canbus::CanFrame *frame);
   canbus::Error read_message(struct canbus::CanFrame *frame) override;
+  void read_rx_buffer_(RXBn rxbn, struct canbus::CanFrame *frame);
+  void read_rx_buffers_();
   bool check_receive_();
   bool check_error_();
   uint8_t get_error_flags_();
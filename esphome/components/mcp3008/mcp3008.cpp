@@ -19,20 +19,16 @@ void MCP3008::dump_config() {
 }
 
 float MCP3008::read_data(uint8_t pin) {
-  uint8_t data_msb, data_lsb = 0;
-
   uint8_t command = ((0x01 << 7) |          // start bit
                      ((pin & 0x07) << 4));  // channel number
+  const uint8_t txbuf[2] = {command, 0x00};
+  uint8_t rxbuf[2];
 
   this->enable();
-  this->transfer_byte(0x01);
-
-  data_msb = this->transfer_byte(command) & 0x03;
-  data_lsb = this->transfer_byte(0x00);
-
+  this->transfer_cmd_addr(8, 0x01, 0, 0, txbuf, rxbuf, 2);
   this->disable();
 
-  int data = data_msb << 8 | data_lsb;
+  int data = (rxbuf[0] & 0x03) << 8 | rxbuf[1];
 
   return data / 1023.0f;
 }
@@ -16,6 +16,13 @@ from esphome.components.esp32 import add_idf_component
 CODEOWNERS = ["@esphome/core"]
 DEPENDENCIES = ["network"]
 
+
+def AUTO_LOAD():
+    if CORE.is_esp32:
+        return ["socket"]
+    return []
+
+
 mdns_ns = cg.esphome_ns.namespace("mdns")
 MDNSComponent = mdns_ns.class_("MDNSComponent", cg.Component)
 MDNSTXTRecord = mdns_ns.struct("MDNSTXTRecord")
@@ -30,6 +37,18 @@ def _remove_id_if_disabled(value):
 
 
 CONF_TXT = "txt"
+CONF_RESPONDER = "responder"
+
+RESPONDER_FRAMEWORK = "framework"
+RESPONDER_BUILTIN = "builtin"
+
+
+def _validate_responder(value):
+    value = cv.one_of(RESPONDER_FRAMEWORK, RESPONDER_BUILTIN, lower=True)(value)
+    if value == RESPONDER_BUILTIN and not CORE.is_esp32:
+        raise cv.Invalid("The builtin responder is only available on ESP32")
+    return value
+
 
 SERVICE_SCHEMA = cv.Schema(
     {
@@ -46,6 +65,9 @@ CONFIG_SCHEMA = cv.All(
             cv.GenerateID(): cv.declare_id(MDNSComponent),
             cv.Optional(CONF_DISABLED, default=False): cv.boolean,
             cv.Optional(CONF_SERVICES, default=[]): cv.ensure_list(SERVICE_SCHEMA),
+            cv.Optional(
+                CONF_RESPONDER, default=RESPONDER_FRAMEWORK
+            ): _validate_responder,
         }
     ),
     _remove_id_if_disabled,
@@ -74,7 +96,12 @@ def mdns_service(
 
 @coroutine_with_priority(55.0)
 async def to_code(config):
-    if CORE.using_arduino:
+    builtin = (
+        not config[CONF_DISABLED] and config[CONF_RESPONDER] == RESPONDER_BUILTIN
+    )
+    if builtin:
+        cg.add_define("USE_MDNS_BUILTIN_RESPONDER")
+    elif CORE.using_arduino:
         if CORE.is_esp32:
             cg.add_library("ESPmDNS", None)
         elif CORE.is_esp8266:
@@ -82,8 +109,10 @@ async def to_code(config):
         elif CORE.is_rp2040:
             cg.add_library("LEAmDNS", None)
 
-    if CORE.using_esp_idf and CORE.data[KEY_CORE][KEY_FRAMEWORK_VERSION] >= cv.Version(
-        5, 0, 0
+    if (
+        not builtin
+        and CORE.using_esp_idf
+        and CORE.data[KEY_CORE][KEY_FRAMEWORK_VERSION] >= cv.Version(5, 0, 0)
     ):
         add_idf_component(
             name="mdns",
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 
 namespace esphome {
 namespace mdns {
@@ -12,6 +13,8 @@ struct MDNSTXTRecord {
   std::string value;
 };
 
+class MDNSResponder;
+
 struct MDNSService {
   // service name _including_ underscore character prefix
   // as defined in RFC6763 Section 7
@@ -28,7 +31,7 @@ class MDNSComponent : public Component {
   void setup() override;
   void dump_config() override;
 
-#if (defined(USE_ESP8266) || defined(USE_RP2040)) && defined(USE_ARDUINO)
+#if ((defined(USE_ESP8266) || defined(USE_RP2040)) && defined(USE_ARDUINO)) || defined(USE_MDNS_BUILTIN_RESPONDER)
   void loop() override;
 #endif
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
@@ -41,6 +44,9 @@ class MDNSComponent : public Component {
   std::vector<MDNSService> services_extra_{};
   std::vector<MDNSService> services_{};
   std::string hostname_;
+#ifdef USE_MDNS_BUILTIN_RESPONDER
+  MDNSResponder *responder_{nullptr};
+#endif
   void compile_records_();
 };
 
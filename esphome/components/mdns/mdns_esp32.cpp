@@ -1,16 +1,34 @@
 #ifdef USE_ESP32
 
-#include <mdns.h>
 #include <cstring>
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "mdns_component.h"
+#ifdef USE_MDNS_BUILTIN_RESPONDER
+#include "mdns_responder.h"
+#else
+#include <mdns.h>
+#endif
 
 namespace esphome {
 namespace mdns {
 
 static const char *const TAG = "mdns";
 
+#ifdef USE_MDNS_BUILTIN_RESPONDER
+void MDNSComponent::setup() {
+  this->compile_records_();
+  this->responder_ = new MDNSResponder();  // NOLINT(cppcoreguidelines-owning-memory)
+  this->responder_->setup(this->hostname_, this->services_);
+}
+
+void MDNSComponent::loop() { this->responder_->loop(); }
+
+void MDNSComponent::on_shutdown() {
+  this->responder_->shutdown();
+  delay(40);  // Allow the goodbye packet to be sent
+}
+#else
 void MDNSComponent::setup() {
   this->compile_records_();
 
@@ -52,6 +70,7 @@ void MDNSComponent::on_shutdown() {
   mdns_free();
   delay(40);  // Allow the mdns packets announcing service removal to be sent
 }
+#endif  // USE_MDNS_BUILTIN_RESPONDER
 
 }  // namespace mdns
 }  // namespace esphome
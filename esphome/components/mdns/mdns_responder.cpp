@@ -0,0 +1,319 @@
+#include "mdns_responder.h"
+
+#ifdef USE_MDNS_BUILTIN_RESPONDER
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+
+#include "esphome/components/network/util.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace mdns {
+
+static const char *const TAG = "mdns";
+
+static const uint16_t MDNS_PORT = 5353;
+static const uint32_t MDNS_GROUP = 0xE00000FB;  // 224.0.0.251
+static const uint16_t TYPE_A = 1;
+static const uint16_t TYPE_PTR = 12;
+static const uint16_t TYPE_TXT = 16;
+static const uint16_t TYPE_SRV = 33;
+static const uint16_t TYPE_ANY = 255;
+static const uint16_t CLASS_IN = 1;
+/// Set on records only we have, receivers replace what they cached for the name.
+static const uint16_t CLASS_CACHE_FLUSH = 0x8000;
+/// RFC 6762 section 10, records with a hostname live shorter than the others.
+static const uint32_t TTL_HOST = 120;
+static const uint32_t TTL_OTHER = 4500;
+/// RFC 6762 section 6, a record is multicast at most once per second.
+static const uint32_t MIN_ANSWER_INTERVAL = 1000;
+static const uint32_t ADDRESS_CHECK_INTERVAL = 1000;
+static const uint8_t ANNOUNCEMENTS = 2;
+
+/// Append a name in wire format, each label prefixed by its length.
+static void append_name(std::string &out, std::initializer_list<const std::string *> labels) {
+  for (const auto *label : labels) {
+    out.push_back(static_cast<char>(std::min<size_t>(label->size(), 63)));
+    out.append(*label, 0, 63);
+  }
+  out.push_back(0);
+}
+
+static void append_u16(std::string &out, uint16_t value) {
+  out.push_back(static_cast<char>(value >> 8));
+  out.push_back(static_cast<char>(value));
+}
+
+static void append_u32(std::string &out, uint32_t value) {
+  append_u16(out, value >> 16);
+  append_u16(out, value);
+}
+
+static void append_record(std::string &out, const std::string &name, uint16_t type, uint16_t rr_class, uint32_t ttl,
+                          const std::string &data) {
+  out.append(name);
+  append_u16(out, type);
+  append_u16(out, rr_class);
+  append_u32(out, ttl);
+  append_u16(out, data.size());
+  out.append(data);
+}
+
+static std::string to_lower(std::string str) {
+  for (auto &c : str)
+    c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+  return str;
+}
+
+/// Read a possibly compressed name at pos into out in wire format and lower case, returns the position after it or 0.
+static size_t read_name(const uint8_t *data, size_t len, size_t pos, std::string &out) {
+  size_t end = 0;
+  // a bound on the pointers followed, against loops in malicious packets
+  for (int jumps = 0; pos < len && jumps < 16;) {
+    const uint8_t label = data[pos];
+    if (label == 0) {
+      out.push_back(0);
+      return end != 0 ? end : pos + 1;
+    }
+    if ((label & 0xC0) == 0xC0) {
+      if (pos + 1 >= len)
+        return 0;
+      if (end == 0)
+        end = pos + 2;
+      pos = ((label & 0x3F) << 8) | data[pos + 1];
+      jumps++;
+      continue;
+    }
+    if (pos + 1 + label > len || out.size() + 1 + label > 255)
+      return 0;
+    out.push_back(static_cast<char>(label));
+    for (size_t i = 0; i < label; i++)
+      out.push_back(static_cast<char>(tolower(data[pos + 1 + i])));
+    pos += 1 + label;
+  }
+  return 0;
+}
+
+void MDNSResponder::setup(const std::string &hostname, const std::vector<MDNSService> &services) {
+  this->hostname_ = hostname;
+  this->services_ = services;
+
+  const std::string local = "local";
+  const std::string dns_sd = "_services";
+  const std::string dns_sd_proto = "_dns-sd";
+  const std::string udp = "_udp";
+  std::string name;
+  append_name(name, {&this->hostname_, &local});
+  this->names_.push_back(to_lower(name));
+  name.clear();
+  append_name(name, {&dns_sd, &dns_sd_proto, &udp, &local});
+  this->names_.push_back(to_lower(name));
+  for (const auto &service : this->services_) {
+    name.clear();
+    append_name(name, {&service.service_type, &service.proto, &local});
+    this->names_.push_back(to_lower(name));
+    name.clear();
+    append_name(name, {&this->hostname_, &service.service_type, &service.proto, &local});
+    this->names_.push_back(to_lower(name));
+  }
+}
+
+void MDNSResponder::loop() {
+  const uint32_t now = millis();
+  if (now - this->last_check_ >= ADDRESS_CHECK_INTERVAL) {
+    this->last_check_ = now;
+    const network::IPAddress address = network::get_ip_address();
+    if (!(address == this->address_)) {
+      this->close_();
+      this->address_ = address;
+      if (uint32_t(address) != 0) {
+        if (this->open_()) {
+          this->render_(address, false);
+          this->announcements_ = ANNOUNCEMENTS;
+          ESP_LOGD(TAG, "Responding for %s.local at %s", this->hostname_.c_str(), address.str().c_str());
+        } else {
+          this->address_ = {};  // try again with the next check
+        }
+      }
+    }
+  }
+  if (this->socket_ == nullptr)
+    return;
+
+  if (this->announcements_ > 0 && now - this->last_sent_ >= MIN_ANSWER_INTERVAL) {
+    this->announcements_--;
+    this->send_();
+  }
+
+  if (!this->socket_->ready())
+    return;
+  uint8_t buffer[512];
+  while (true) {
+    const ssize_t len = this->socket_->read(buffer, sizeof(buffer));
+    if (len <= 0)
+      break;
+    if (!this->wants_answer_(buffer, len))
+      continue;
+    if (millis() - this->last_sent_ < MIN_ANSWER_INTERVAL) {
+      this->suppressed_++;
+      ESP_LOGVV(TAG, "Answer suppressed, %u so far", this->suppressed_);
+      continue;
+    }
+    this->send_();
+  }
+}
+
+void MDNSResponder::shutdown() {
+  if (this->socket_ == nullptr)
+    return;
+  this->render_(this->address_, true);
+  this->send_();
+  this->close_();
+}
+
+bool MDNSResponder::open_() {
+  this->socket_ = socket::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (this->socket_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create the socket");
+    return false;
+  }
+  int enable = 1;
+  this->socket_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+  this->socket_->setblocking(false);
+
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(MDNS_PORT);
+  addr.sin_addr.s_addr = INADDR_ANY;
+  if (this->socket_->bind(reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+    ESP_LOGW(TAG, "Could not bind to port %u, errno %d", MDNS_PORT, errno);
+    this->close_();
+    return false;
+  }
+
+  struct ip_mreq mreq {};
+  mreq.imr_multiaddr.s_addr = htonl(MDNS_GROUP);
+  mreq.imr_interface.s_addr = uint32_t(this->address_);
+  if (this->socket_->setsockopt(IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+    ESP_LOGW(TAG, "Could not join the mDNS group, errno %d", errno);
+    this->close_();
+    return false;
+  }
+  uint8_t ttl = 255;
+  this->socket_->setsockopt(IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+  return true;
+}
+
+void MDNSResponder::close_() {
+  if (this->socket_ == nullptr)
+    return;
+  this->socket_->close();
+  this->socket_ = nullptr;
+}
+
+void MDNSResponder::render_(network::IPAddress address, bool goodbye) {
+  const std::string local = "local";
+  const std::string dns_sd = "_services";
+  const std::string dns_sd_proto = "_dns-sd";
+  const std::string udp = "_udp";
+  const uint32_t ttl_host = goodbye ? 0 : TTL_HOST;
+  const uint32_t ttl_other = goodbye ? 0 : TTL_OTHER;
+
+  std::string host;
+  append_name(host, {&this->hostname_, &local});
+
+  std::string records;
+  std::string data;
+  uint16_t count = 0;
+
+  for (int i = 0; i < 4; i++)
+    data.push_back(static_cast<char>(address[i]));
+  append_record(records, host, TYPE_A, CLASS_IN | CLASS_CACHE_FLUSH, ttl_host, data);
+  count++;
+
+  for (const auto &service : this->services_) {
+    std::string type;
+    append_name(type, {&service.service_type, &service.proto, &local});
+    std::string instance;
+    append_name(instance, {&this->hostname_, &service.service_type, &service.proto, &local});
+
+    std::string services;
+    append_name(services, {&dns_sd, &dns_sd_proto, &udp, &local});
+    append_record(records, services, TYPE_PTR, CLASS_IN, ttl_other, type);
+    append_record(records, type, TYPE_PTR, CLASS_IN, ttl_other, instance);
+
+    data.clear();
+    append_u16(data, 0);  // priority
+    append_u16(data, 0);  // weight
+    append_u16(data, service.port);
+    data.append(host);
+    append_record(records, instance, TYPE_SRV, CLASS_IN | CLASS_CACHE_FLUSH, ttl_host, data);
+
+    data.clear();
+    for (const auto &record : service.txt_records) {
+      const std::string item = record.key + "=" + record.value;
+      data.push_back(static_cast<char>(std::min<size_t>(item.size(), 255)));
+      data.append(item, 0, 255);
+    }
+    if (data.empty())
+      data.push_back(0);  // RFC 6763 section 6.1, a TXT record is never empty
+    append_record(records, instance, TYPE_TXT, CLASS_IN | CLASS_CACHE_FLUSH, ttl_other, data);
+    count += 4;
+  }
+
+  this->packet_.clear();
+  this->packet_.reserve(12 + records.size());
+  append_u16(this->packet_, 0);       // id
+  append_u16(this->packet_, 0x8400);  // response, authoritative
+  append_u16(this->packet_, 0);       // questions
+  append_u16(this->packet_, count);   // answers
+  append_u16(this->packet_, 0);       // authority records
+  append_u16(this->packet_, 0);       // additional records
+  this->packet_.append(records);
+  if (this->packet_.size() > 1460)
+    ESP_LOGW(TAG, "The mDNS response is %u bytes, it may not fit in a single packet", this->packet_.size());
+}
+
+bool MDNSResponder::wants_answer_(const uint8_t *data, size_t len) const {
+  if (len < 12)
+    return false;
+  const uint16_t flags = (data[2] << 8) | data[3];
+  if (flags & 0x8000)  // a response
+    return false;
+  const uint16_t questions = (data[4] << 8) | data[5];
+  size_t pos = 12;
+  std::string name;
+  for (uint16_t i = 0; i < questions; i++) {
+    name.clear();
+    pos = read_name(data, len, pos, name);
+    if (pos == 0 || pos + 4 > len)
+      return false;
+    const uint16_t type = (data[pos] << 8) | data[pos + 1];
+    pos += 4;
+    if (type != TYPE_A && type != TYPE_PTR && type != TYPE_SRV && type != TYPE_TXT && type != TYPE_ANY)
+      continue;
+    for (const auto &ours : this->names_) {
+      if (name == ours)
+        return true;
+    }
+  }
+  return false;
+}
+
+void MDNSResponder::send_() {
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(MDNS_PORT);
+  addr.sin_addr.s_addr = htonl(MDNS_GROUP);
+  this->socket_->sendto(this->packet_.data(), this->packet_.size(), 0, reinterpret_cast<struct sockaddr *>(&addr),
+                        sizeof(addr));
+  this->last_sent_ = millis();
+}
+
+}  // namespace mdns
+}  // namespace esphome
+
+#endif  // USE_MDNS_BUILTIN_RESPONDER
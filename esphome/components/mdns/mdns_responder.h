@@ -0,0 +1,59 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MDNS_BUILTIN_RESPONDER
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "esphome/components/network/ip_address.h"
+#include "esphome/components/socket/socket.h"
+#include "mdns_component.h"
+
+namespace esphome {
+namespace mdns {
+
+/** A minimal mDNS responder for the hostname and the services of the node.
+ *
+ * All records, the A record of the hostname and the PTR, SRV and TXT records of every service, are rendered once into a
+ * single response packet, again only when the IP address changes. A query for any of these names is answered by
+ * multicasting that packet, at most once per second as RFC 6762 asks, so a busy network with many nodes querying
+ * costs little more than parsing the questions. There is no probing for name conflicts, no known-answer suppression
+ * and no unicast response, which the clients ESPHome is used with don't need.
+ */
+class MDNSResponder {
+ public:
+  void setup(const std::string &hostname, const std::vector<MDNSService> &services);
+  void loop();
+  /// Tell the network the records are gone, with a TTL of zero.
+  void shutdown();
+
+ protected:
+  bool open_();
+  void close_();
+  /// Render the response packet for the address, with the TTLs scaled down to zero for a goodbye.
+  void render_(network::IPAddress address, bool goodbye);
+  /// Whether the query asks for one of our names.
+  bool wants_answer_(const uint8_t *data, size_t len) const;
+  void send_();
+
+  std::string hostname_;
+  std::vector<MDNSService> services_;
+  /// Our names in wire format and lower case, the ones a query is matched against.
+  std::vector<std::string> names_;
+  std::string packet_;
+  network::IPAddress address_;
+  std::unique_ptr<socket::Socket> socket_;
+  uint32_t last_sent_{0};
+  uint32_t last_check_{0};
+  /// Announcements still to be sent, each one second after the previous.
+  uint8_t announcements_{0};
+  uint32_t suppressed_{0};
+};
+
+}  // namespace mdns
+}  // namespace esphome
+
+#endif  // USE_MDNS_BUILTIN_RESPONDER
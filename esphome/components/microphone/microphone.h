@@ -25,8 +25,12 @@ class Microphone {
   bool is_running() const { return this->state_ == STATE_RUNNING; }
   bool is_stopped() const { return this->state_ == STATE_STOPPED; }
 
+  /// Number of times captured samples had to be dropped because they were not read in time.
+  uint32_t get_overrun_count() const { return this->overrun_count_; }
+
  protected:
   State state_{STATE_STOPPED};
+  uint32_t overrun_count_{0};
 
   CallbackManager<void(const std::vector<int16_t> &)> data_callbacks_{};
 };
@@ -118,13 +118,18 @@ void MideaIR::control(const climate::ClimateCall &call) {
                                                     this->swing_mode == climate::CLIMATE_SWING_VERTICAL) ||
                                                    (*call.get_swing_mode() == climate::CLIMATE_SWING_VERTICAL &&
                                                     this->swing_mode == climate::CLIMATE_SWING_OFF))) {
+    // a toggle, sent on its own and right away
+    this->flush_transmit_();
     this->swing_ = true;
   } else if (call.get_preset().has_value() &&
              ((*call.get_preset() == climate::CLIMATE_PRESET_NONE && this->preset == climate::CLIMATE_PRESET_BOOST) ||
               (*call.get_preset() == climate::CLIMATE_PRESET_BOOST && this->preset == climate::CLIMATE_PRESET_NONE))) {
+    this->flush_transmit_();
     this->boost_ = true;
   }
   climate_ir::ClimateIR::control(call);
+  if (this->swing_ || this->boost_)
+    this->flush_transmit_();
 }
 
 void MideaIR::transmit_(MideaData &data) {
@@ -1,6 +1,7 @@
 #include "mlx90614.h"
 
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -50,20 +51,7 @@ bool MLX90614Component::write_emissivity_() {
   return true;
 }
 
-uint8_t MLX90614Component::crc8_pec_(const uint8_t *data, uint8_t len) {
-  uint8_t crc = 0;
-  for (uint8_t i = 0; i < len; i++) {
-    uint8_t in = data[i];
-    for (uint8_t j = 0; j < 8; j++) {
-      bool carry = (crc ^ in) & 0x80;
-      crc <<= 1;
-      if (carry)
-        crc ^= 0x07;
-      in <<= 1;
-    }
-  }
-  return crc;
-}
+uint8_t MLX90614Component::crc8_pec_(const uint8_t *data, uint8_t len) { return crc8(data, len, 0x00, 0x07, true); }
 
 bool MLX90614Component::write_bytes_(uint8_t reg, uint16_t data) {
   uint8_t buf[5];
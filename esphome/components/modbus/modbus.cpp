@@ -2,6 +2,9 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 namespace esphome {
 namespace modbus {
 
@@ -11,6 +14,9 @@ void Modbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+  // 3.5 characters of 11 bits, fixed at 1.75ms above 19200 baud as the spec says
+  const uint32_t baud_rate = this->parent_->get_baud_rate();
+  this->frame_gap_us_ = baud_rate > 19200 || baud_rate == 0 ? 1750 : 38500000UL / baud_rate;
 }
 void Modbus::loop() {
   const uint32_t now = millis();
@@ -21,20 +27,54 @@ void Modbus::loop() {
   }
   // stop blocking new send commands after send_wait_time_ ms regardless if a response has been received since then
   if (now - this->last_send_ > send_wait_time_) {
+    if (waiting_for_response != 0) {
+      ModbusDevice *device = this->find_device_(waiting_for_response);
+      if (device != nullptr)
+        device->timeout_count_++;
+      ESP_LOGV(TAG, "No response from device 0x%02X", waiting_for_response);
+    }
     waiting_for_response = 0;
   }
 
-  while (this->available()) {
-    uint8_t byte;
-    this->read_byte(&byte);
-    if (this->parse_modbus_byte_(byte)) {
-      this->last_modbus_byte_ = now;
-    } else {
-      this->rx_buffer_.clear();
+  // read in chunks, every UART access goes through the driver (and a lock on ESP-IDF)
+  uint8_t buf[64];
+  size_t len;
+  while ((len = this->read_available(buf, sizeof(buf))) > 0) {
+    this->last_activity_us_ = micros();
+    for (size_t i = 0; i < len; i++) {
+      if (this->parse_modbus_byte_(buf[i])) {
+        this->last_modbus_byte_ = now;
+      } else {
+        this->rx_buffer_.clear();
+      }
+    }
+  }
+
+  this->send_next_request_();
+}
+
+void Modbus::send_next_request_() {
+  if (waiting_for_response != 0 || this->devices_.empty() ||
+      micros() - this->last_activity_us_ < this->frame_gap_us_)
+    return;
+  // Round robin, the device after the one that sent last gets the first chance
+  for (size_t i = 0; i < this->devices_.size(); i++) {
+    const size_t index = (this->next_device_ + i) % this->devices_.size();
+    if (this->devices_[index]->send_next_request()) {
+      this->next_device_ = index + 1;
+      return;
     }
   }
 }
 
+ModbusDevice *Modbus::find_device_(uint8_t address) {
+  for (auto *device : this->devices_) {
+    if (device->address_ == address)
+      return device;
+  }
+  return nullptr;
+}
+
 bool Modbus::parse_modbus_byte_(uint8_t byte) {
   size_t at = this->rx_buffer_.size();
   this->rx_buffer_.push_back(byte);
@@ -126,6 +166,12 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
       } else {
         device->on_modbus_data(data);
       }
+      if (waiting_for_response == address) {
+        const uint32_t latency = millis() - this->last_send_;
+        device->response_count_++;
+        device->total_latency_ += latency;
+        device->max_latency_ = std::max(device->max_latency_, latency);
+      }
       found = true;
     }
   }
@@ -144,6 +190,7 @@ void Modbus::dump_config() {
   LOG_PIN("  Flow Control Pin: ", this->flow_control_pin_);
   ESP_LOGCONFIG(TAG, "  Send Wait Time: %d ms", this->send_wait_time_);
   ESP_LOGCONFIG(TAG, "  CRC Disabled: %s", YESNO(this->disable_crc_));
+  ESP_LOGCONFIG(TAG, "  Frame Gap: %" PRIu32 " us", this->frame_gap_us_);
 }
 float Modbus::get_setup_priority() const {
   // After UART bus
@@ -196,6 +243,10 @@ void Modbus::send(uint8_t address, uint8_t function_code, uint16_t start_address
     this->flow_control_pin_->digital_write(false);
   waiting_for_response = address;
   last_send_ = millis();
+  this->last_activity_us_ = micros();
+  ModbusDevice *device = this->find_device_(address);
+  if (device != nullptr)
+    device->request_count_++;
   ESP_LOGV(TAG, "Modbus write: %s", format_hex_pretty(data).c_str());
 }
 
@@ -219,6 +270,10 @@ void Modbus::send_raw(const std::vector<uint8_t> &payload) {
   waiting_for_response = payload[0];
   ESP_LOGV(TAG, "Modbus write raw: %s", format_hex_pretty(payload).c_str());
   last_send_ = millis();
+  this->last_activity_us_ = micros();
+  ModbusDevice *device = this->find_device_(payload[0]);
+  if (device != nullptr)
+    device->request_count_++;
 }
 
 }  // namespace modbus
@@ -10,6 +10,12 @@ namespace modbus {
 
 class ModbusDevice;
 
+/** Modbus RTU bus shared by several devices.
+ *
+ * Devices that implement ModbusDevice::send_next_request() are polled by the bus in turn, so they don't collide and
+ * one device with a long queue doesn't starve the others. The bus only offers a turn while no response is pending
+ * and the line was quiet for the inter-frame gap of 3.5 characters.
+ */
 class Modbus : public uart::UARTDevice, public Component {
  public:
   Modbus() = default;
@@ -36,12 +42,22 @@ class Modbus : public uart::UARTDevice, public Component {
   GPIOPin *flow_control_pin_{nullptr};
 
   bool parse_modbus_byte_(uint8_t byte);
+  /// Give the next device that has something to send its turn.
+  void send_next_request_();
+  /// The device with this address, nullptr if there is none.
+  ModbusDevice *find_device_(uint8_t address);
   uint16_t send_wait_time_{250};
   bool disable_crc_;
   std::vector<uint8_t> rx_buffer_;
   uint32_t last_modbus_byte_{0};
   uint32_t last_send_{0};
+  /// Last time a byte was sent or received, in us.
+  uint32_t last_activity_us_{0};
+  /// Silence required between frames, in us.
+  uint32_t frame_gap_us_{0};
   std::vector<ModbusDevice *> devices_;
+  /// Device that gets the first chance to send in the next round.
+  size_t next_device_{0};
 };
 
 class ModbusDevice {
@@ -57,12 +73,33 @@ class ModbusDevice {
   void send_raw(const std::vector<uint8_t> &payload) { this->parent_->send_raw(payload); }
   // If more than one device is connected block sending a new command before a response is received
   bool waiting_for_response() { return parent_->waiting_for_response != 0; }
+  /** Called by the bus when it is this device's turn and the line is free, send at most one request.
+   *
+   * Returns true if a request was sent. Devices that don't implement this send whenever they want.
+   */
+  virtual bool send_next_request() { return false; }
+
+  /// Requests sent to this device.
+  uint32_t get_request_count() const { return this->request_count_; }
+  /// Requests that got no response within the send wait time.
+  uint32_t get_timeout_count() const { return this->timeout_count_; }
+  /// Average time between a request and its response in ms, 0 before the first response.
+  float get_average_latency() const {
+    return this->response_count_ == 0 ? 0.0f : float(this->total_latency_) / this->response_count_;
+  }
+  /// Longest time between a request and its response in ms.
+  uint32_t get_max_latency() const { return this->max_latency_; }
 
  protected:
   friend Modbus;
 
   Modbus *parent_;
   uint8_t address_;
+  uint32_t request_count_{0};
+  uint32_t response_count_{0};
+  uint32_t timeout_count_{0};
+  uint32_t total_latency_{0};
+  uint32_t max_latency_{0};
 };
 
 }  // namespace modbus
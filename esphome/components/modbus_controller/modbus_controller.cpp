@@ -2,11 +2,28 @@
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace modbus_controller {
 
 static const char *const TAG = "modbus_controller";
 
+/// Maximum number of registers a single read request (function code 3 and 4) may return
+static const uint16_t MAX_READ_REGISTERS = 125;
+
+static bool is_write_command(const ModbusCommandItem &command) {
+  switch (command.function_code) {
+    case ModbusFunctionCode::WRITE_SINGLE_COIL:
+    case ModbusFunctionCode::WRITE_SINGLE_REGISTER:
+    case ModbusFunctionCode::WRITE_MULTIPLE_COILS:
+    case ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS:
+      return true;
+    default:
+      return false;
+  }
+}
+
 void ModbusController::setup() {
   // Modbus::setup();
   this->create_register_ranges_();
@@ -21,6 +38,7 @@ void ModbusController::setup() {
 bool ModbusController::send_next_command_() {
   uint32_t last_send = millis() - this->last_command_timestamp_;
 
+  bool sent = false;
   if ((last_send > this->command_throttle_) && !waiting_for_response() && !command_queue_.empty()) {
     auto &command = command_queue_.front();
 
@@ -46,6 +64,7 @@ bool ModbusController::send_next_command_() {
       ESP_LOGV(TAG, "Sending next modbus command to device %d register 0x%02X count %d", this->address_,
                command->register_address, command->register_count);
       command->send();
+      sent = true;
       this->last_command_timestamp_ = millis();
       // remove from queue if no handler is defined
       if (!command->on_data_func) {
@@ -53,7 +72,14 @@ bool ModbusController::send_next_command_() {
       }
     }
   }
-  return (!command_queue_.empty());
+  return sent;
+}
+
+bool ModbusController::send_next_request() {
+  // responses are processed first, the handlers may queue follow-up commands
+  if (!this->incoming_queue_.empty())
+    return false;
+  return this->send_next_command_();
 }
 
 // Queue incoming response
@@ -140,7 +166,14 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
       return;
     }
   }
-  command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  auto pos = command_queue_.end();
+  if (is_write_command(command) && !command_queue_.empty()) {
+    // writes skip ahead of the queued reads but keep their order. The front command might already be waiting for
+    // its response, so it is never overtaken.
+    pos = std::find_if(std::next(command_queue_.begin()), command_queue_.end(),
+                       [](const std::unique_ptr<ModbusCommandItem> &item) { return !is_write_command(*item); });
+  }
+  command_queue_.insert(pos, make_unique<ModbusCommandItem>(command));
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
@@ -180,6 +213,9 @@ void ModbusController::update() {
   } else {
     ESP_LOGV(TAG, "Updating modbus component");
   }
+  ESP_LOGV(TAG, "Device 0x%02X: %" PRIu32 " requests, %" PRIu32 " timeouts, latency %.1fms average, %" PRIu32 "ms max",
+           this->address_, this->get_request_count(), this->get_timeout_count(), this->get_average_latency(),
+           this->get_max_latency());
 
   for (auto &r : this->register_ranges_) {
     ESP_LOGVV(TAG, "Updating range 0x%X", r.start_address);
@@ -255,6 +291,31 @@ size_t ModbusController::create_register_ranges_() {
 
           ESP_LOGV(TAG, "Extend range - change to register: 0x%X %d offset=%u", curr->start_address,
                    curr->register_count, curr->offset);
+        } else if (this->max_register_gap_ > 0 &&
+                   (curr->register_type == ModbusRegisterType::HOLDING ||
+                    curr->register_type == ModbusRegisterType::READ) &&
+                   curr->skip_updates == r.skip_updates && buffer_offset == r.register_count * 2 &&
+                   curr->start_address > (r.start_address + r.register_count) &&
+                   curr->start_address - (r.start_address + r.register_count) <= this->max_register_gap_ &&
+                   curr->start_address + curr->register_count - r.start_address <= MAX_READ_REGISTERS) {
+          // reading a few unused registers is cheaper than another request, the gap is skipped in the response
+
+          uint16_t gap = curr->start_address - (r.start_address + r.register_count);
+          // remove this sensore because start_address is changed (sort-order)
+          ix = sensorset_.erase(ix);
+
+          curr->start_address = r.start_address;
+          buffer_offset += gap * 2;
+          curr->offset += buffer_offset;
+          buffer_offset += curr->get_register_size();
+          r.register_count += gap + curr->register_count;
+
+          sensorset_.insert(curr);
+          // move iterator backwards because it will be incremented later
+          ix--;
+
+          ESP_LOGV(TAG, "Extend range over %u unused registers - change to register: 0x%X %d offset=%u", gap,
+                   curr->start_address, curr->register_count, curr->offset);
         }
       }
     }
@@ -297,6 +358,9 @@ size_t ModbusController::create_register_ranges_() {
 void ModbusController::dump_config() {
   ESP_LOGCONFIG(TAG, "ModbusController:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
+  if (this->max_register_gap_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Max register gap: %u", this->max_register_gap_);
+  }
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   ESP_LOGCONFIG(TAG, "sensormap");
   for (auto &it : sensorset_) {
@@ -313,16 +377,12 @@ void ModbusController::dump_config() {
 }
 
 void ModbusController::loop() {
-  // Incoming data to process?
+  // Incoming data to process? Pending commands are sent when the bus gives us a turn, see send_next_request().
   if (!incoming_queue_.empty()) {
     auto &message = incoming_queue_.front();
     if (message != nullptr)
       process_modbus_data_(message.get());
     incoming_queue_.pop();
-
-  } else {
-    // all messages processed send pending commands
-    send_next_command_();
   }
 }
 
@@ -422,6 +422,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void on_modbus_data(const std::vector<uint8_t> &data) override;
   /// called when a modbus error response was received
   void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
+  /// called by the bus when it is this controller's turn to send
+  bool send_next_request() override;
   /// default delegate called by process_modbus_data when a response has retrieved from the incoming queue
   void on_register_data(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data);
   /// default delegate called by process_modbus_data when a response for a write response has retrieved from the
@@ -432,6 +434,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void set_command_throttle(uint16_t command_throttle) { this->command_throttle_ = command_throttle; }
   /// called by esphome generated code to set the offline_skip_updates
   void set_offline_skip_updates(uint16_t offline_skip_updates) { this->offline_skip_updates_ = offline_skip_updates; }
+  /// called by esphome generated code to set the max_register_gap
+  void set_max_register_gap(uint8_t max_register_gap) { this->max_register_gap_ = max_register_gap; }
   /// get the number of queued modbus commands (should be mostly empty)
   size_t get_command_queue_length() { return command_queue_.size(); }
   /// get if the module is offline, didn't respond the last command
@@ -446,7 +450,7 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void update_range_(RegisterRange &r);
   /// parse incoming modbus data
   void process_modbus_data_(const ModbusCommandItem *response);
-  /// send the next modbus command from the send queue
+  /// send the next modbus command from the send queue, returns true if one was sent
   bool send_next_command_();
   /// dump the parsed sensormap for diagnostics
   void dump_sensors_();
@@ -466,6 +470,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   bool module_offline_;
   /// how many updates to skip if module is offline
   uint16_t offline_skip_updates_;
+  /// how many unused registers may be read to merge two ranges into one request
+  uint8_t max_register_gap_{0};
 };
 
 /** Convert vector<uint8_t> response payload to float.
@@ -19,6 +19,7 @@ from esphome.const import (
     CONF_DISCOVERY_UNIQUE_ID_GENERATOR,
     CONF_DISCOVERY_OBJECT_ID_GENERATOR,
     CONF_ID,
+    CONF_INTERVAL,
     CONF_KEEPALIVE,
     CONF_LEVEL,
     CONF_LOG_TOPIC,
@@ -53,6 +54,8 @@ AUTO_LOAD = ["json"]
 
 CONF_IDF_SEND_ASYNC = "idf_send_async"
 CONF_SKIP_CERT_CN_CHECK = "skip_cert_cn_check"
+CONF_RESEND_RATE = "resend_rate"
+CONF_BATCH_STATE = "batch_state"
 
 
 def validate_message_just_topic(value):
@@ -97,6 +100,7 @@ MQTTDisconnectTrigger = mqtt_ns.class_(
     "MQTTDisconnectTrigger", automation.Trigger.template()
 )
 MQTTComponent = mqtt_ns.class_("MQTTComponent", cg.Component)
+MQTTBatchPublisher = mqtt_ns.class_("MQTTBatchPublisher", cg.PollingComponent)
 MQTTConnectedCondition = mqtt_ns.class_("MQTTConnectedCondition", Condition)
 
 MQTTBinarySensorComponent = mqtt_ns.class_("MQTTBinarySensorComponent", MQTTComponent)
@@ -156,6 +160,11 @@ def validate_config(value):
             CONF_QOS: 0,
             CONF_RETAIN: True,
         }
+    if CONF_BATCH_STATE in value and CONF_TOPIC not in value[CONF_BATCH_STATE]:
+        out[CONF_BATCH_STATE] = {
+            **value[CONF_BATCH_STATE],
+            CONF_TOPIC: f"{topic_prefix}/sensor/state",
+        }
     return out
 
 
@@ -218,6 +227,16 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_REBOOT_TIMEOUT, default="15min"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_RESEND_RATE, default=8192): cv.int_range(min=256),
+            cv.Optional(CONF_BATCH_STATE): cv.Schema(
+                {
+                    cv.GenerateID(): cv.declare_id(MQTTBatchPublisher),
+                    cv.Optional(CONF_TOPIC): cv.publish_topic,
+                    cv.Optional(
+                        CONF_INTERVAL, default="1s"
+                    ): cv.positive_time_period_milliseconds,
+                }
+            ),
             cv.Optional(CONF_ON_CONNECT): automation.validate_automation(
                 {
                     cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(MQTTConnectTrigger),
@@ -356,6 +375,16 @@ async def to_code(config):
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
 
+    cg.add(var.set_resend_rate(config[CONF_RESEND_RATE]))
+
+    if CONF_BATCH_STATE in config:
+        batch_config = config[CONF_BATCH_STATE]
+        batch = cg.new_Pvariable(batch_config[CONF_ID])
+        await cg.register_component(batch, batch_config)
+        cg.add(batch.set_topic(batch_config[CONF_TOPIC]))
+        cg.add(batch.set_update_interval(batch_config[CONF_INTERVAL]))
+        cg.add(var.set_batch_publisher(batch))
+
     # esp-idf only
     if CONF_CERTIFICATE_AUTHORITY in config:
         cg.add(var.set_ca_certificate(config[CONF_CERTIFICATE_AUTHORITY]))
@@ -0,0 +1,60 @@
+#include "mqtt_batch_publisher.h"
+
+#ifdef USE_MQTT
+
+#include "esphome/core/log.h"
+#include "mqtt_client.h"
+
+namespace esphome {
+namespace mqtt {
+
+static const char *const TAG = "mqtt.batch";
+
+size_t MQTTBatchPublisher::add_entry(const std::string &key) {
+  this->entries_.push_back(Entry{key, "null"});
+  return this->entries_.size() - 1;
+}
+
+void MQTTBatchPublisher::set_value(size_t index, std::string value) {
+  this->entries_[index].value = std::move(value);
+  this->dirty_ = true;
+}
+
+void MQTTBatchPublisher::update() {
+  if (!this->dirty_ || !global_mqtt_client->is_connected())
+    return;
+
+  // the values are already JSON, so the document is assembled without going through ArduinoJson
+  std::string payload;
+  size_t size = 2;
+  for (const Entry &entry : this->entries_)
+    size += entry.key.size() + entry.value.size() + 4;
+  payload.reserve(size);
+  payload += '{';
+  for (const Entry &entry : this->entries_) {
+    if (payload.size() > 1)
+      payload += ',';
+    payload += '"';
+    payload += entry.key;
+    payload += "\":";
+    payload += entry.value;
+  }
+  payload += '}';
+
+  if (global_mqtt_client->publish(this->topic_, payload.data(), payload.size(), 0, true))
+    this->dirty_ = false;
+}
+
+void MQTTBatchPublisher::dump_config() {
+  ESP_LOGCONFIG(TAG, "MQTT Batch Publisher:");
+  ESP_LOGCONFIG(TAG, "  Topic: '%s'", this->topic_.c_str());
+  ESP_LOGCONFIG(TAG, "  Entries: %u", (unsigned) this->entries_.size());
+  LOG_UPDATE_INTERVAL(this);
+}
+
+float MQTTBatchPublisher::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <string>
+#include <vector>
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace mqtt {
+
+/** Collects the states of MQTT sensors and publishes them as one JSON document.
+ *
+ * Sensors without a custom state topic add themselves in setup and then update their entry instead of publishing
+ * their own message. Every update interval with a changed entry, all entries are published to a single topic as
+ * `{"<object_id>": <state>, ...}`; the discovery of the sensors points their value_template into that document.
+ */
+class MQTTBatchPublisher : public PollingComponent {
+ public:
+  void set_topic(const std::string &topic) { this->topic_ = topic; }
+  const std::string &get_topic() const { return this->topic_; }
+
+  /// Add an entry with the given key, returns its index for set_value().
+  size_t add_entry(const std::string &key);
+  /// Set the value of an entry, a JSON number or null. It is published with the next update.
+  void set_value(size_t index, std::string value);
+
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+ protected:
+  struct Entry {
+    std::string key;
+    std::string value;
+  };
+
+  std::string topic_;
+  std::vector<Entry> entries_;
+  bool dirty_{false};
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -2,9 +2,12 @@
 
 #ifdef USE_MQTT
 
+#include <algorithm>
+#include <cinttypes>
 #include <utility>
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
+#include "esphome/core/heap.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/version.h"
@@ -26,6 +29,8 @@ namespace esphome {
 namespace mqtt {
 
 static const char *const TAG = "mqtt";
+/// Unacknowledged QoS>0 messages at which resending pauses.
+static const uint8_t MAX_INFLIGHT_RESENDS = 8;
 
 MQTTClientComponent::MQTTClientComponent() {
   global_mqtt_client = this;
@@ -37,32 +42,49 @@ void MQTTClientComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up MQTT...");
   this->mqtt_backend_.set_on_message(
       [this](const char *topic, const char *payload, size_t len, size_t index, size_t total) {
-        if (index == 0)
+        // most messages arrive in one piece and are dispatched straight from the backend's buffer
+        if (index == 0 && len == total) {
+          this->on_message(StringRef::from_maybe_nullptr(topic), StringRef(payload, len));
+          return;
+        }
+
+        if (index == 0) {
+          // later fragments don't repeat the topic on all backends
+          this->payload_topic_ = topic != nullptr ? topic : "";
+          this->payload_buffer_.clear();
           this->payload_buffer_.reserve(total);
+        }
 
         // append new payload, may contain incomplete MQTT message
-        this->payload_buffer_.append(payload, len);
+        this->payload_buffer_.insert(this->payload_buffer_.end(), payload, payload + len);
 
         // MQTT fully received
         if (len + index == total) {
-          this->on_message(topic, this->payload_buffer_);
+          this->on_message(StringRef(this->payload_topic_),
+                           StringRef(this->payload_buffer_.data(), this->payload_buffer_.size()));
           this->payload_buffer_.clear();
         }
       });
+  this->mqtt_backend_.set_on_publish([this](uint16_t packet_id) {
+    if (this->inflight_ > 0)
+      this->inflight_--;
+  });
   this->mqtt_backend_.set_on_disconnect([this](MQTTClientDisconnectReason reason) {
     this->state_ = MQTT_CLIENT_DISCONNECTED;
     this->disconnect_reason_ = reason;
   });
 #ifdef USE_LOGGER
   if (this->is_log_message_enabled() && logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      if (level <= this->log_level_ && this->is_connected()) {
-        this->publish({.topic = this->log_message_.topic,
-                       .payload = message,
-                       .qos = this->log_message_.qos,
-                       .retain = this->log_message_.retain});
-      }
-    });
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          if (level <= this->log_level_ && this->is_connected()) {
+            this->publish({.topic = this->log_message_.topic,
+                           .payload = message,
+                           .qos = this->log_message_.qos,
+                           .retain = this->log_message_.retain});
+          }
+        },
+        this->log_level_);
   }
 #endif
 
@@ -264,6 +286,10 @@ bool MQTTClientComponent::is_connected() {
   return this->state_ == MQTT_CLIENT_CONNECTED && this->mqtt_backend_.connected();
 }
 
+bool MQTTClientComponent::is_publish_complete() {
+  return this->is_connected() && this->resend_start_ == 0 && this->inflight_ == 0;
+}
+
 void MQTTClientComponent::check_connected() {
   if (!this->mqtt_backend_.connected()) {
     if (millis() - this->connect_begin_ > 60000) {
@@ -285,12 +311,31 @@ void MQTTClientComponent::check_connected() {
 
   for (MQTTComponent *component : this->children_)
     component->schedule_resend_state();
+  this->inflight_ = 0;
+  this->resend_start_ = millis() | 1;
+  this->resend_bytes_ = 0;
+  ESP_LOGD(TAG, "Resending discovery and state of %u components", (unsigned) this->children_.size());
 }
 
 void MQTTClientComponent::loop() {
+  HeapTagScope heap_tag(HeapTag::MQTT);
   // Call the backend loop first
   mqtt_backend_.loop();
 
+  const uint32_t now = millis();
+  const int32_t refill = int64_t(now - this->resend_budget_time_) * this->resend_rate_ / 1000;
+  if (refill > 0 || this->resend_budget_ >= int32_t(this->resend_rate_)) {
+    this->resend_budget_ = std::min<int64_t>(int64_t(this->resend_budget_) + refill, this->resend_rate_);
+    this->resend_budget_time_ = now;
+  }
+  if (this->resend_start_ != 0 &&
+      std::none_of(this->children_.begin(), this->children_.end(),
+                   [](MQTTComponent *component) { return component->is_resend_scheduled(); })) {
+    ESP_LOGD(TAG, "Resent discovery and state in %" PRIu32 " ms, %" PRIu32 " bytes", now - this->resend_start_,
+             this->resend_bytes_);
+    this->resend_start_ = 0;
+  }
+
   if (this->disconnect_reason_.has_value()) {
     const LogString *reason_s;
     switch (*this->disconnect_reason_) {
@@ -402,6 +447,11 @@ void MQTTClientComponent::resubscribe_subscriptions_() {
 }
 
 void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t callback, uint8_t qos) {
+  this->subscribe_ref(
+      topic, [callback](StringRef topic, StringRef payload) { callback(topic.str(), payload.str()); }, qos);
+}
+
+void MQTTClientComponent::subscribe_ref(const std::string &topic, mqtt_ref_callback_t callback, uint8_t qos) {
   MQTTSubscription subscription{
       .topic = topic,
       .qos = qos,
@@ -410,22 +460,16 @@ void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t ca
       .resubscribe_timeout = 0,
   };
   this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  // appending keeps the indices of the existing subscriptions, so the trie can be extended in place
+  this->subscription_trie_.insert(topic, this->subscriptions_.size());
+  this->subscriptions_.push_back(std::move(subscription));
 }
 
 void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos) {
-  auto f = [callback](const std::string &topic, const std::string &payload) {
-    json::parse_json(payload, [topic, callback](JsonObject root) { callback(topic, root); });
+  auto f = [callback](StringRef topic, StringRef payload) {
+    json::parse_json(payload.str(), [topic, callback](JsonObject root) { callback(topic.str(), root); });
   };
-  MQTTSubscription subscription{
-      .topic = topic,
-      .qos = qos,
-      .callback = f,
-      .subscribed = false,
-      .resubscribe_timeout = 0,
-  };
-  this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  this->subscribe_ref(topic, f, qos);
 }
 
 void MQTTClientComponent::unsubscribe(const std::string &topic) {
@@ -443,12 +487,18 @@ void MQTTClientComponent::unsubscribe(const std::string &topic) {
   while (it != subscriptions_.end()) {
     if (it->topic == topic) {
       it = subscriptions_.erase(it);
+      this->subscription_trie_dirty_ = true;
     } else {
       ++it;
     }
   }
 }
 
+bool MQTTClientComponent::take_resend_slot() {
+  // the budget may go negative with the last message let through, it is paid back before the next one
+  return this->resend_budget_ > 0 && this->inflight_ < MAX_INFLIGHT_RESENDS;
+}
+
 // Publish
 bool MQTTClientComponent::publish(const std::string &topic, const std::string &payload, uint8_t qos, bool retain) {
   return this->publish(topic, payload.data(), payload.size(), qos, retain);
@@ -456,113 +506,92 @@ bool MQTTClientComponent::publish(const std::string &topic, const std::string &p
 
 bool MQTTClientComponent::publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
                                   bool retain) {
-  return publish({.topic = topic, .payload = payload, .qos = qos, .retain = retain});
-}
-
-bool MQTTClientComponent::publish(const MQTTMessage &message) {
+  HeapTagScope heap_tag(HeapTag::MQTT);
   if (!this->is_connected()) {
     // critical components will re-transmit their messages
     return false;
   }
-  bool logging_topic = this->log_message_.topic == message.topic;
-  bool ret = this->mqtt_backend_.publish(message);
+  bool logging_topic = this->log_message_.topic == topic;
+  bool ret = this->mqtt_backend_.publish(topic.c_str(), payload, payload_length, qos, retain);
   delay(0);
   if (!ret && !logging_topic && this->is_connected()) {
     delay(0);
-    ret = this->mqtt_backend_.publish(message);
+    ret = this->mqtt_backend_.publish(topic.c_str(), payload, payload_length, qos, retain);
     delay(0);
   }
 
+  if (ret && !logging_topic) {
+    // state messages count against the resend budget too, so resending leaves room for them
+    const uint32_t size = topic.size() + payload_length;
+    this->resend_budget_ -= std::min<uint32_t>(size, INT32_MAX / 2);
+    if (this->resend_start_ != 0)
+      this->resend_bytes_ += size;
+    if (qos > 0 && this->inflight_ < UINT8_MAX)
+      this->inflight_++;
+  }
+
   if (!logging_topic) {
     if (ret) {
-      ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", message.topic.c_str(), message.payload.c_str(),
-               message.retain);
+      ESP_LOGV(TAG, "Publish(topic='%s' payload='%.*s' retain=%d)", topic.c_str(), (int) payload_length, payload,
+               retain);
     } else {
-      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", message.topic.c_str(),
-               message.payload.length());
+      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", topic.c_str(), payload_length);
       this->status_momentary_warning("publish", 1000);
     }
   }
   return ret != 0;
 }
+
+bool MQTTClientComponent::publish(const MQTTMessage &message) {
+  return this->publish(message.topic, message.payload.data(), message.payload.size(), message.qos, message.retain);
+}
 bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos,
                                        bool retain) {
-  std::string message = json::build_json(f);
-  return this->publish(topic, message, qos, retain);
-}
-
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
-
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
-    }
-    // after this, both pointers will point to a '/' or to the end of the string
-
-    return topic_match(message, subscription, is_normal, true);
-  }
-
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
-  }
-
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
-
-  return topic_match(message, subscription, is_normal, past_separator);
+  bool ret = false;
+  json::build_json(f, [&](const char *data, size_t length) { ret = this->publish(topic, data, length, qos, retain); });
+  return ret;
 }
 
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
+  this->on_message(StringRef(topic), StringRef(payload));
 }
 
-void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
+void MQTTClientComponent::on_message(StringRef topic, StringRef payload) {
 #ifdef USE_ESP8266
   // on ESP8266, this is called in lwIP/AsyncTCP task; some components do not like running
-  // from a different task.
-  this->defer([this, topic, payload]() {
-#endif
-    for (auto &subscription : this->subscriptions_) {
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
-    }
-#ifdef USE_ESP8266
-  });
+  // from a different task. The receive buffer doesn't outlive this call, so copy the message.
+  std::string topic_s = topic.str();
+  std::string payload_s = payload.str();
+  this->defer([this, topic_s, payload_s]() { this->dispatch_message_(StringRef(topic_s), StringRef(payload_s)); });
+#else
+  this->dispatch_message_(topic, payload);
 #endif
 }
 
+void MQTTClientComponent::dispatch_message_(StringRef topic, StringRef payload) {
+  if (this->subscription_trie_dirty_) {
+    this->subscription_trie_.clear();
+    for (size_t i = 0; i < this->subscriptions_.size(); i++)
+      this->subscription_trie_.insert(this->subscriptions_[i].topic, i);
+    this->subscription_trie_dirty_ = false;
+  }
+
+  // a callback may subscribe again, so take the match buffer while it is in use
+  std::vector<uint16_t> matched;
+  matched.swap(this->matched_subscriptions_);
+  this->subscription_trie_.match(topic.c_str(), topic.size(), matched);
+  // call back in subscription order, like before the trie
+  std::sort(matched.begin(), matched.end());
+  for (uint16_t index : matched) {
+    // unsubscribing shifts the indices, the remaining subscriptions are skipped for this message
+    if (this->subscription_trie_dirty_)
+      break;
+    this->subscriptions_[index].callback(topic, payload);
+  }
+  matched.clear();
+  this->matched_subscriptions_.swap(matched);
+}
+
 // Setters
 void MQTTClientComponent::disable_log_message() { this->log_message_.topic = ""; }
 bool MQTTClientComponent::is_log_message_enabled() const { return !this->log_message_.topic.empty(); }
@@ -7,6 +7,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/log.h"
+#include "esphome/core/string_ref.h"
 #include "esphome/components/json/json_util.h"
 #include "esphome/components/network/ip_address.h"
 #if defined(USE_ESP32)
@@ -14,6 +15,8 @@
 #elif defined(USE_ESP8266)
 #include "mqtt_backend_esp8266.h"
 #endif
+#include "mqtt_batch_publisher.h"
+#include "mqtt_topic_trie.h"
 #include "lwip/ip_addr.h"
 
 #include <vector>
@@ -32,12 +35,17 @@ using mqtt_on_disconnect_callback_t = std::function<MQTTBackend::on_disconnect_c
  */
 using mqtt_callback_t = std::function<void(const std::string &, const std::string &)>;
 using mqtt_json_callback_t = std::function<void(const std::string &, JsonObject)>;
+/** Callback for MQTT subscriptions that doesn't copy the message.
+ *
+ * The topic and payload reference the receive buffer and are only valid during the call.
+ */
+using mqtt_ref_callback_t = std::function<void(StringRef, StringRef)>;
 
 /// internal struct for MQTT subscriptions.
 struct MQTTSubscription {
   std::string topic;
   uint8_t qos;
-  mqtt_callback_t callback;
+  mqtt_ref_callback_t callback;
   bool subscribed;
   uint32_t resubscribe_timeout;
 };
@@ -175,6 +183,16 @@ class MQTTClientComponent : public Component {
    */
   void subscribe(const std::string &topic, mqtt_callback_t callback, uint8_t qos = 0);
 
+  /** Subscribe to an MQTT topic and call callback with references to the received message.
+   *
+   * Unlike subscribe(), the topic and payload are not copied into strings.
+   *
+   * @param topic The topic, may contain the '+' and '#' wildcards.
+   * @param callback The callback function.
+   * @param qos The QoS of this subscription.
+   */
+  void subscribe_ref(const std::string &topic, mqtt_ref_callback_t callback, uint8_t qos = 0);
+
   /** Subscribe to a MQTT topic and automatically parse JSON payload.
    *
    * If an invalid JSON payload is received, the callback will not be called.
@@ -229,6 +247,8 @@ class MQTTClientComponent : public Component {
   float get_setup_priority() const override;
 
   void on_message(const std::string &topic, const std::string &payload);
+  /// Dispatch a received message to the matching subscriptions.
+  void on_message(StringRef topic, StringRef payload);
 
   bool can_proceed() override;
 
@@ -236,10 +256,27 @@ class MQTTClientComponent : public Component {
 
   void set_reboot_timeout(uint32_t reboot_timeout);
 
+  /// Set the bytes per second that may be published while components resend their discovery and state.
+  void set_resend_rate(uint32_t resend_rate) { this->resend_rate_ = resend_rate; }
+
+  /// Publish the states of sensors combined through this publisher instead of one message per sensor.
+  void set_batch_publisher(MQTTBatchPublisher *batch_publisher) { this->batch_publisher_ = batch_publisher; }
+  MQTTBatchPublisher *get_batch_publisher() const { return this->batch_publisher_; }
+
   void register_mqtt_component(MQTTComponent *component);
 
   bool is_connected();
 
+  /// Whether the state of every component was resent since connecting and all QoS>0 messages are acknowledged.
+  bool is_publish_complete();
+
+  /** Whether a component may resend its discovery and state now.
+   *
+   * After a reconnect all components resend, paced so that the published bytes stay within the resend rate and the
+   * number of unacknowledged QoS>0 messages stays low, instead of queueing everything at once.
+   */
+  bool take_resend_slot();
+
   void on_shutdown() override;
 
   void set_broker_address(const std::string &address) { this->credentials_.address = address; }
@@ -269,6 +306,7 @@ class MQTTClientComponent : public Component {
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
+  void dispatch_message_(StringRef topic, StringRef payload);
 
   MQTTCredentials credentials_;
   /// The last will message. Disabled optional denotes it being default and
@@ -292,10 +330,26 @@ class MQTTClientComponent : public Component {
   };
   std::string topic_prefix_{};
   MQTTMessage log_message_;
-  std::string payload_buffer_;
+  /// Reassembles messages that the backend delivers in several fragments.
+  std::vector<char> payload_buffer_;
+  std::string payload_topic_;
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  /// Filters of subscriptions_ mapping to their index, rebuilt when subscriptions_ changes.
+  MQTTTopicTrie subscription_trie_;
+  bool subscription_trie_dirty_{false};
+  std::vector<uint16_t> matched_subscriptions_;
+  MQTTBatchPublisher *batch_publisher_{nullptr};
+  uint32_t resend_rate_{8192};
+  /// Bytes that may still be published, refilled at resend_rate_ up to one second worth.
+  int32_t resend_budget_{0};
+  uint32_t resend_budget_time_{0};
+  /// QoS>0 messages not acknowledged yet.
+  uint8_t inflight_{0};
+  /// When the resend after the last reconnect started, 0 once it is done.
+  uint32_t resend_start_{0};
+  uint32_t resend_bytes_{0};
 #if defined(USE_ESP32)
   MQTTBackendESP32 mqtt_backend_;
 #elif defined(USE_ESP8266)
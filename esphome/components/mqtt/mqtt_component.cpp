@@ -27,11 +27,7 @@ std::string MQTTComponent::get_default_topic_for_(const std::string &suffix) con
          "/" + suffix;
 }
 
-std::string MQTTComponent::get_state_topic_() const {
-  if (this->custom_state_topic_.empty())
-    return this->get_default_topic_for_("state");
-  return this->custom_state_topic_;
-}
+const std::string &MQTTComponent::get_state_topic_() const { return this->custom_state_topic_; }
 
 std::string MQTTComponent::get_command_topic_() const {
   if (this->custom_command_topic_.empty())
@@ -189,6 +185,9 @@ void MQTTComponent::call_setup() {
   if (this->is_internal())
     return;
 
+  if (this->custom_state_topic_.empty())
+    this->custom_state_topic_ = this->get_default_topic_for_("state");
+
   this->setup();
 
   global_mqtt_client->register_mqtt_component(this);
@@ -212,7 +211,7 @@ void MQTTComponent::call_loop() {
 
   this->loop();
 
-  if (!this->resend_state_ || !this->is_connected_()) {
+  if (!this->resend_state_ || !this->is_connected_() || !global_mqtt_client->take_resend_slot()) {
     return;
   }
 
@@ -107,6 +107,9 @@ class MQTTComponent : public Component {
   /// Internal method for the MQTT client base to schedule a resend of the state on reconnect.
   void schedule_resend_state();
 
+  /// Whether this component still has to resend its discovery and state.
+  bool is_resend_scheduled() const { return this->resend_state_; }
+
   /** Send a MQTT message.
    *
    * @param topic The topic.
@@ -172,8 +175,8 @@ class MQTTComponent : public Component {
   /// Get whether the underlying Entity is disabled by default
   virtual bool is_disabled_by_default() const;
 
-  /// Get the MQTT topic that new states will be shared to.
-  std::string get_state_topic_() const;
+  /// Get the MQTT topic that new states will be shared to, empty until the component is set up.
+  const std::string &get_state_topic_() const;
 
   /// Get the MQTT topic for listening to commands.
   std::string get_command_topic_() const;
@@ -188,6 +191,7 @@ class MQTTComponent : public Component {
   /// Generate the Home Assistant MQTT discovery object id by automatically transforming the friendly name.
   std::string get_default_object_id_() const;
 
+  /// The custom state topic, replaced with the default topic at setup so that it isn't rebuilt for every publish.
   std::string custom_state_topic_{};
   std::string custom_command_topic_{};
   bool command_retain_{false};
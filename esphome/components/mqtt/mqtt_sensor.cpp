@@ -1,4 +1,5 @@
 #include <cinttypes>
+#include <cmath>
 #include "mqtt_sensor.h"
 #include "esphome/core/log.h"
 
@@ -21,6 +22,10 @@ using namespace esphome::sensor;
 MQTTSensorComponent::MQTTSensorComponent(Sensor *sensor) : sensor_(sensor) {}
 
 void MQTTSensorComponent::setup() {
+  MQTTBatchPublisher *batch = global_mqtt_client->get_batch_publisher();
+  // a custom state topic keeps its own messages
+  if (batch != nullptr && this->get_state_topic_() == this->get_default_topic_for_("state"))
+    this->batch_index_ = batch->add_entry(this->get_default_object_id_());
   this->sensor_->add_on_state_callback([this](float state) { this->publish_state(state); });
 }
 
@@ -30,6 +35,9 @@ void MQTTSensorComponent::dump_config() {
     ESP_LOGCONFIG(TAG, "  Expire After: %" PRIu32 "s", this->get_expire_after() / 1000);
   }
   LOG_MQTT_COMPONENT(true, false)
+  if (this->batch_index_.has_value()) {
+    ESP_LOGCONFIG(TAG, "  Batched in: '%s'", global_mqtt_client->get_batch_publisher()->get_topic().c_str());
+  }
 }
 
 std::string MQTTSensorComponent::component_type() const { return "sensor"; }
@@ -59,6 +67,12 @@ void MQTTSensorComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryCon
   if (this->sensor_->get_state_class() != STATE_CLASS_NONE)
     root[MQTT_STATE_CLASS] = state_class_to_string(this->sensor_->get_state_class());
 
+  if (this->batch_index_.has_value()) {
+    root[MQTT_STATE_TOPIC] = global_mqtt_client->get_batch_publisher()->get_topic();
+    root[MQTT_VALUE_TEMPLATE] = "{{ value_json." + this->get_default_object_id_() + " }}";
+    config.state_topic = false;
+  }
+
   config.command_topic = false;
 }
 bool MQTTSensorComponent::send_initial_state() {
@@ -70,6 +84,11 @@ bool MQTTSensorComponent::send_initial_state() {
 }
 bool MQTTSensorComponent::publish_state(float value) {
   int8_t accuracy = this->sensor_->get_accuracy_decimals();
+  if (this->batch_index_.has_value()) {
+    global_mqtt_client->get_batch_publisher()->set_value(
+        *this->batch_index_, std::isfinite(value) ? value_accuracy_to_string(value, accuracy) : "null");
+    return true;
+  }
   return this->publish(this->get_state_topic_(), value_accuracy_to_string(value, accuracy));
 }
 std::string MQTTSensorComponent::unique_id() { return this->sensor_->unique_id(); }
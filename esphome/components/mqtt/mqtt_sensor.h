@@ -50,6 +50,8 @@ class MQTTSensorComponent : public mqtt::MQTTComponent {
 
   sensor::Sensor *sensor_;
   optional<uint32_t> expire_after_;  // Override the expire after advertised to Home Assistant
+  /// Entry in the batch publisher, if the state is published through it.
+  optional<size_t> batch_index_;
 };
 
 }  // namespace mqtt
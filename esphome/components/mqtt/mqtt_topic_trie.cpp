@@ -0,0 +1,105 @@
+#include "mqtt_topic_trie.h"
+
+#ifdef USE_MQTT
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace mqtt {
+
+void MQTTTopicTrie::clear() {
+  this->nodes_.clear();
+  this->nodes_.emplace_back();
+}
+
+void MQTTTopicTrie::insert(const std::string &filter, uint16_t value) {
+  uint16_t node = 0;
+  const char *level = filter.c_str();
+  const char *end = level + filter.size();
+  while (true) {
+    const char *separator = std::find(level, end, '/');
+    const size_t length = separator - level;
+    if (length == 1 && *level == '#') {
+      // multi level wildcard, MQTT mandates that this must be the last level
+      this->nodes_[node].multi_wildcard_values.push_back(value);
+      return;
+    }
+    if (length == 1 && *level == '+') {
+      if (this->nodes_[node].single_wildcard == 0) {
+        const uint16_t child = this->nodes_.size();
+        this->nodes_.emplace_back();
+        this->nodes_[child].level = "+";
+        this->nodes_[node].single_wildcard = child;
+      }
+      node = this->nodes_[node].single_wildcard;
+    } else {
+      uint16_t child = this->child_(node, level, length);
+      if (child == 0)
+        child = this->add_child_(node, level, length);
+      node = child;
+    }
+    if (separator == end)
+      break;
+    level = separator + 1;
+  }
+  this->nodes_[node].values.push_back(value);
+}
+
+void MQTTTopicTrie::match(const char *topic, size_t length, std::vector<uint16_t> &values) const {
+  this->match_(0, topic, topic + length, values);
+}
+
+static bool level_less(const std::string &a, const char *b, size_t b_length) {
+  return a.compare(0, std::string::npos, b, b_length) < 0;
+}
+
+uint16_t MQTTTopicTrie::child_(uint16_t node, const char *level, size_t length) const {
+  const std::vector<uint16_t> &children = this->nodes_[node].children;
+  auto it = std::lower_bound(children.begin(), children.end(), 0, [&](uint16_t child, int) {
+    return level_less(this->nodes_[child].level, level, length);
+  });
+  if (it == children.end())
+    return 0;
+  const std::string &found = this->nodes_[*it].level;
+  if (found.size() != length || memcmp(found.data(), level, length) != 0)
+    return 0;
+  return *it;
+}
+
+uint16_t MQTTTopicTrie::add_child_(uint16_t node, const char *level, size_t length) {
+  const uint16_t child = this->nodes_.size();
+  this->nodes_.emplace_back();
+  this->nodes_[child].level.assign(level, length);
+  std::vector<uint16_t> &children = this->nodes_[node].children;
+  auto it = std::lower_bound(children.begin(), children.end(), 0, [&](uint16_t other, int) {
+    return level_less(this->nodes_[other].level, level, length);
+  });
+  children.insert(it, child);
+  return child;
+}
+
+void MQTTTopicTrie::match_(uint16_t node, const char *level, const char *end, std::vector<uint16_t> &values) const {
+  const Node &current = this->nodes_[node];
+  // level is nullptr once all levels of the topic are consumed
+  const bool wildcards = node != 0 || level == nullptr || *level != '$';
+  if (wildcards)
+    values.insert(values.end(), current.multi_wildcard_values.begin(), current.multi_wildcard_values.end());
+  if (level == nullptr) {
+    values.insert(values.end(), current.values.begin(), current.values.end());
+    return;
+  }
+
+  const char *separator = std::find(level, end, '/');
+  const char *next = separator == end ? nullptr : separator + 1;
+  const uint16_t child = this->child_(node, level, separator - level);
+  if (child != 0)
+    this->match_(child, next, end, values);
+  if (wildcards && current.single_wildcard != 0)
+    this->match_(current.single_wildcard, next, end, values);
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
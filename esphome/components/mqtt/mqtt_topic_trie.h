@@ -0,0 +1,58 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/** Trie of MQTT topic filters, split at the '/' level separators.
+ *
+ * Matching a topic walks one path per level (plus the '+' and '#' branches), so the cost depends on the depth of the
+ * topic and not on the number of filters.
+ */
+class MQTTTopicTrie {
+ public:
+  void clear();
+
+  /// Add a topic filter, value is reported by match() for every topic the filter matches.
+  void insert(const std::string &filter, uint16_t value);
+
+  /** Collect the values of all filters that match a topic.
+   *
+   * Wildcards in the first level don't match topics starting with '$', as mandated by the MQTT spec.
+   *
+   * @param topic The topic of the received message, must not contain wildcards.
+   * @param length The length of topic.
+   * @param values Output, the values of the matching filters are appended in no particular order.
+   */
+  void match(const char *topic, size_t length, std::vector<uint16_t> &values) const;
+
+ protected:
+  struct Node {
+    std::string level;
+    /// Indices of the literal children in nodes_, sorted by level.
+    std::vector<uint16_t> children;
+    /// Index of the '+' child in nodes_, 0 if there is none (the root is never a child).
+    uint16_t single_wildcard{0};
+    /// Values of the filters ending at this node.
+    std::vector<uint16_t> values;
+    /// Values of the filters ending with a '#' after this node.
+    std::vector<uint16_t> multi_wildcard_values;
+  };
+
+  uint16_t child_(uint16_t node, const char *level, size_t length) const;
+  uint16_t add_child_(uint16_t node, const char *level, size_t length);
+  void match_(uint16_t node, const char *level, const char *end, std::vector<uint16_t> &values) const;
+
+  std::vector<Node> nodes_ = std::vector<Node>(1);
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -94,16 +94,19 @@ void MY9231OutputComponent::init_chips_(uint8_t command) {
   this->send_di_pulses_(16);
 }
 void MY9231OutputComponent::write_word_(uint16_t value, uint8_t bits) {
+  auto pin_di = FastGPIOPin::from(this->pin_di_);
+  auto pin_dcki = FastGPIOPin::from(this->pin_dcki_);
   for (uint8_t i = bits; i > 0; i--) {
-    this->pin_di_->digital_write(value & (1 << (i - 1)));
-    this->pin_dcki_->digital_write(!this->pin_dcki_->digital_read());
+    pin_di.digital_write(value & (1 << (i - 1)));
+    pin_dcki.digital_write(!pin_dcki.digital_read());
   }
 }
 void MY9231OutputComponent::send_di_pulses_(uint8_t count) {
+  auto pin_di = FastGPIOPin::from(this->pin_di_);
   delayMicroseconds(12);
   for (uint8_t i = 0; i < count; i++) {
-    this->pin_di_->digital_write(true);
-    this->pin_di_->digital_write(false);
+    pin_di.digital_write(true);
+    pin_di.digital_write(false);
   }
 }
 
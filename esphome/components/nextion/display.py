@@ -19,6 +19,7 @@ from .base_component import (
     CONF_TOUCH_SLEEP_TIMEOUT,
     CONF_WAKE_UP_PAGE,
     CONF_AUTO_WAKE_ON_TOUCH,
+    CONF_MAX_COMMANDS_IN_FLIGHT,
 )
 
 CODEOWNERS = ["@senexcrenshaw"]
@@ -60,6 +61,9 @@ CONFIG_SCHEMA = (
             cv.Optional(CONF_TOUCH_SLEEP_TIMEOUT): cv.int_range(min=3, max=65535),
             cv.Optional(CONF_WAKE_UP_PAGE): cv.positive_int,
             cv.Optional(CONF_AUTO_WAKE_ON_TOUCH, default=True): cv.boolean,
+            cv.Optional(CONF_MAX_COMMANDS_IN_FLIGHT, default=8): cv.int_range(
+                min=1, max=255
+            ),
         }
     )
     .extend(cv.polling_component_schema("5s"))
@@ -98,6 +102,8 @@ async def to_code(config):
     if CONF_AUTO_WAKE_ON_TOUCH in config:
         cg.add(var.set_auto_wake_on_touch_internal(config[CONF_AUTO_WAKE_ON_TOUCH]))
 
+    cg.add(var.set_max_commands_in_flight(config[CONF_MAX_COMMANDS_IN_FLIGHT]))
+
     await display.register_display(var, config)
 
     for conf in config.get(CONF_ON_SETUP, []):
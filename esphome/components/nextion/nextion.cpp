@@ -2,6 +2,7 @@
 #include "esphome/core/util.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
+#include <algorithm>
 
 namespace esphome {
 namespace nextion {
@@ -30,6 +31,10 @@ bool Nextion::send_command_(const std::string &command) {
     return false;
   }
 
+  // Queued assignments were requested before this command
+  if (!this->queued_sets_.empty())
+    this->send_queued_sets_(true);
+
   ESP_LOGN(TAG, "send_command %s", command.c_str());
 
   this->write_str(command.c_str());
@@ -111,6 +116,7 @@ void Nextion::reset_(bool reset_nextion) {
     this->read_byte(&d);
   };
   this->nextion_queue_.clear();
+  this->queued_sets_.clear();
 }
 
 void Nextion::dump_config() {
@@ -242,6 +248,7 @@ void Nextion::loop() {
 
   this->process_serial_();            // Receive serial data
   this->process_nextion_commands_();  // Process nextion return commands
+  this->send_queued_sets_(false);     // Send value updates as acknowledgements make room for them
 
   if (!this->nextion_reports_is_setup_) {
     if (this->started_ms_ == 0)
@@ -1021,8 +1028,8 @@ void Nextion::add_no_result_to_queue_with_set_internal_(const std::string &varia
   if ((!this->is_setup() && !this->ignore_is_setup_) || (!is_sleep_safe && this->is_sleeping()))
     return;
 
-  this->add_no_result_to_queue_with_ignore_sleep_printf_(variable_name, "%s=%d", variable_name_to_send.c_str(),
-                                                         state_value);
+  this->add_set_to_queue_(variable_name, variable_name_to_send,
+                          str_sprintf("%s=%d", variable_name_to_send.c_str(), state_value), is_sleep_safe);
 }
 
 /**
@@ -1049,8 +1056,53 @@ void Nextion::add_no_result_to_queue_with_set_internal_(const std::string &varia
   if ((!this->is_setup() && !this->ignore_is_setup_) || (!is_sleep_safe && this->is_sleeping()))
     return;
 
-  this->add_no_result_to_queue_with_printf_(variable_name, "%s=\"%s\"", variable_name_to_send.c_str(),
-                                            state_value.c_str());
+  this->add_set_to_queue_(variable_name, variable_name_to_send,
+                          str_sprintf("%s=\"%s\"", variable_name_to_send.c_str(), state_value.c_str()), is_sleep_safe);
+}
+
+void Nextion::add_set_to_queue_(const std::string &variable_name, const std::string &target, std::string command,
+                                bool is_sleep_safe) {
+  if ((!this->is_setup() && !this->ignore_is_setup_) || (!is_sleep_safe && this->is_sleeping()))
+    return;
+
+  // Before setup, the commands must go out in order right away
+  if (this->ignore_is_setup_) {
+    this->add_no_result_to_queue_with_command_(variable_name, command);
+    return;
+  }
+
+  for (auto &queued : this->queued_sets_) {
+    if (queued.target == target) {
+      ESP_LOGN(TAG, "Replacing queued set of %s", target.c_str());
+      queued.variable_name = variable_name;
+      queued.command = std::move(command);
+      return;
+    }
+  }
+  this->queued_sets_.push_back(QueuedSet{variable_name, target, std::move(command)});
+}
+
+void Nextion::send_queued_sets_(bool force) {
+  if (this->queued_sets_.empty())
+    return;
+
+  size_t count = this->queued_sets_.size();
+  if (!force) {
+    if (this->nextion_queue_.size() >= this->max_commands_in_flight_)
+      return;
+    count = std::min(count, this->max_commands_in_flight_ - this->nextion_queue_.size());
+  }
+
+  std::string batch;
+  for (size_t i = 0; i < count; i++) {
+    const QueuedSet &queued = this->queued_sets_[i];
+    ESP_LOGN(TAG, "send_command %s", queued.command.c_str());
+    batch += queued.command;
+    batch += "\xFF\xFF\xFF";
+    this->add_no_result_to_queue_(queued.variable_name);
+  }
+  this->write_array(reinterpret_cast<const uint8_t *>(batch.data()), batch.size());
+  this->queued_sets_.erase(this->queued_sets_.begin(), this->queued_sets_.begin() + count);
 }
 
 void Nextion::add_to_get_queue(NextionComponentBase *component) {
@@ -730,8 +730,18 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
   }
   void set_wake_up_page_internal(uint8_t wake_up_page) { this->wake_up_page_ = wake_up_page; }
   void set_auto_wake_on_touch_internal(bool auto_wake_on_touch) { this->auto_wake_on_touch_ = auto_wake_on_touch; }
+  /// Set how many commands may be sent before the Nextion acknowledged them, further value updates wait.
+  void set_max_commands_in_flight(uint8_t max_commands_in_flight) {
+    this->max_commands_in_flight_ = max_commands_in_flight;
+  }
 
  protected:
+  /// An assignment of a value to a component or variable that wasn't sent yet.
+  struct QueuedSet {
+    std::string variable_name;
+    std::string target;
+    std::string command;
+  };
   std::deque<NextionQueue *> nextion_queue_;
   uint16_t recv_ret_string_(std::string &response, uint32_t timeout, bool recv_flag);
   void all_components_send_state_(bool force_update = false);
@@ -773,6 +783,20 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
                                                  const std::string &variable_name_to_send,
                                                  const std::string &state_value, bool is_sleep_safe = false);
 
+  /** Queue a command that assigns a value to target, to be sent from the loop.
+   *
+   * Replaces the command of a queued assignment to the same target, so when a value changes faster than the Nextion
+   * can keep up with, only the last one is sent.
+   */
+  void add_set_to_queue_(const std::string &variable_name, const std::string &target, std::string command,
+                         bool is_sleep_safe = false);
+  /** Send the queued assignments in a single write.
+   *
+   * Without force, only as many are sent as fit in max_commands_in_flight_. With force all of them are sent, which is
+   * done before any other command so the order of the commands is kept.
+   */
+  void send_queued_sets_(bool force);
+
 #ifdef USE_NEXTION_TFT_UPLOAD
 #ifdef USE_ESP8266
   WiFiClient *wifi_client_{nullptr};
@@ -845,6 +869,8 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
   bool is_connected_ = false;
   uint32_t startup_override_ms_ = 8000;
   uint32_t max_q_age_ms_ = 8000;
+  std::vector<QueuedSet> queued_sets_;
+  uint8_t max_commands_in_flight_ = 8;
   uint32_t started_ms_ = 0;
   bool sent_setup_commands_ = false;
 };
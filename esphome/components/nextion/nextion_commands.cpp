@@ -148,11 +148,13 @@ void Nextion::set_component_picture(const char *component, const char *picture)
 }
 
 void Nextion::set_component_text(const char *component, const char *text) {
-  this->add_no_result_to_queue_with_printf_("set_component_text", "%s.txt=\"%s\"", component, text);
+  std::string target = std::string(component) + ".txt";
+  this->add_set_to_queue_("set_component_text", target, str_sprintf("%s=\"%s\"", target.c_str(), text));
 }
 
 void Nextion::set_component_value(const char *component, int value) {
-  this->add_no_result_to_queue_with_printf_("set_component_value", "%s.val=%d", component, value);
+  std::string target = std::string(component) + ".val";
+  this->add_set_to_queue_("set_component_value", target, str_sprintf("%s=%d", target.c_str(), value));
 }
 
 void Nextion::add_waveform_data(int component_id, uint8_t channel_number, uint8_t value) {
@@ -19,9 +19,14 @@ void NTC::process_(float value) {
     return;
   }
 
-  double lr = log(double(value));
-  double v = this->a_ + this->b_ * lr + this->c_ * lr * lr * lr;
-  auto temp = float(1.0 / v - 273.15);
+  float temp;
+  if (this->lookup_table_ != nullptr) {
+    temp = this->lookup_table_->evaluate(value);
+  } else {
+    double lr = log(double(value));
+    double v = this->a_ + this->b_ * lr + this->c_ * lr * lr * lr;
+    temp = float(1.0 / v - 273.15);
+  }
 
   ESP_LOGD(TAG, "'%s' - Temperature: %.1f°C", this->name_.c_str(), temp);
   this->publish_state(temp);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
 
@@ -12,6 +15,10 @@ class NTC : public Component, public sensor::Sensor {
   void set_a(double a) { a_ = a; }
   void set_b(double b) { b_ = b; }
   void set_c(double c) { c_ = c; }
+  /// Convert through a table of the temperature over the resistance range instead of the Steinhart–Hart equation.
+  void set_lookup_table(float r_min, float r_max, std::vector<float> values) {
+    this->lookup_table_ = make_unique<sensor::LookupTable>(r_min, r_max, std::move(values));
+  }
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override;
@@ -23,6 +30,7 @@ class NTC : public Component, public sensor::Sensor {
   double a_;
   double b_;
   double c_;
+  std::unique_ptr<sensor::LookupTable> lookup_table_;
 };
 
 }  // namespace ntc
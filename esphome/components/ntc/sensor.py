@@ -126,6 +126,7 @@ CONFIG_SCHEMA = (
         {
             cv.Required(CONF_SENSOR): cv.use_id(sensor.Sensor),
             cv.Required(CONF_CALIBRATION): process_calibration,
+            cv.Optional(sensor.CONF_LOOKUP_TABLE): sensor.LOOKUP_TABLE_SCHEMA,
         }
     )
     .extend(cv.COMPONENT_SCHEMA)
@@ -142,3 +143,17 @@ async def to_code(config):
     cg.add(var.set_a(calib[CONF_A]))
     cg.add(var.set_b(calib[CONF_B]))
     cg.add(var.set_c(calib[CONF_C]))
+    if sensor.CONF_LOOKUP_TABLE in config:
+
+        def temperature(resistance):
+            lr = log(resistance)
+            v = calib[CONF_A] + calib[CONF_B] * lr + calib[CONF_C] * lr * lr * lr
+            return 1 / v - ZERO_POINT
+
+        cg.add(
+            var.set_lookup_table(
+                *sensor.build_lookup_table(
+                    temperature, config[sensor.CONF_LOOKUP_TABLE]
+                )
+            )
+        )
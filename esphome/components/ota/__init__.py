@@ -3,6 +3,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.const import (
+    CONF_BUFFER_SIZE,
     CONF_ID,
     CONF_NUM_ATTEMPTS,
     CONF_PASSWORD,
@@ -14,6 +15,7 @@ from esphome.const import (
     KEY_PAST_SAFE_MODE,
 )
 from esphome.core import CORE, coroutine_with_priority
+from esphome.components.esp32 import add_idf_sdkconfig_option
 
 CODEOWNERS = ["@esphome/core"]
 DEPENDENCIES = ["network"]
@@ -24,6 +26,7 @@ CONF_ON_BEGIN = "on_begin"
 CONF_ON_PROGRESS = "on_progress"
 CONF_ON_END = "on_end"
 CONF_ON_ERROR = "on_error"
+CONF_TCP_RECEIVE_WINDOW = "tcp_receive_window"
 
 ota_ns = cg.esphome_ns.namespace("ota")
 OTAState = ota_ns.enum("OTAState")
@@ -54,6 +57,10 @@ CONFIG_SCHEMA = cv.Schema(
             CONF_REBOOT_TIMEOUT, default="5min"
         ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_NUM_ATTEMPTS, default="10"): cv.positive_not_null_int,
+        cv.Optional(CONF_BUFFER_SIZE, default=1024): cv.int_range(min=256, max=16384),
+        cv.SplitDefault(CONF_TCP_RECEIVE_WINDOW, esp32_idf=11488): cv.All(
+            cv.only_with_esp_idf, cv.int_range(min=2872, max=65535)
+        ),
         cv.Optional(CONF_ON_STATE_CHANGE): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(OTAStateChangeTrigger),
@@ -89,6 +96,7 @@ async def to_code(config):
 
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
     cg.add_define("USE_OTA")
     if CONF_PASSWORD in config:
         cg.add(var.set_auth_password(config[CONF_PASSWORD]))
@@ -106,6 +114,15 @@ async def to_code(config):
     if CORE.is_esp32 and CORE.using_arduino:
         cg.add_library("Update", None)
 
+    if CONF_TCP_RECEIVE_WINDOW in config:
+        # A wider window keeps the sender streaming while the flash writer is busy
+        window = config[CONF_TCP_RECEIVE_WINDOW]
+        add_idf_sdkconfig_option("CONFIG_LWIP_TCP_WND_DEFAULT", window)
+        # lwIP needs a receive mailbox entry for every segment that fits the window
+        add_idf_sdkconfig_option(
+            "CONFIG_LWIP_TCP_RECVMBOX_SIZE", max(6, -(-window // 1436))
+        )
+
     if CORE.is_rp2040 and CORE.using_arduino:
         cg.add_library("Updater", None)
 
@@ -8,6 +8,8 @@
 #include <esp_ota_ops.h>
 #include "esphome/components/md5/md5.h"
 
+#include <new>
+
 #if ESP_IDF_VERSION_MAJOR >= 5
 #include <spi_flash_mmap.h>
 #endif
@@ -40,7 +42,32 @@ OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
 #endif
 #endif
 
-  esp_err_t err = esp_ota_begin(this->partition_, image_size, &this->update_handle_);
+  size_t erase_size = image_size;
+#ifdef USE_OTA_IDF_INFLATE
+  if (this->compressed_) {
+    // The inflated size is unknown, erase the partition as the image is written instead of up front
+#ifdef OTA_WITH_SEQUENTIAL_WRITES
+    erase_size = OTA_WITH_SEQUENTIAL_WRITES;
+#else
+    erase_size = OTA_SIZE_UNKNOWN;
+#endif
+    this->inflator_.reset(new (std::nothrow) tinfl_decompressor);
+    this->window_.reset(new (std::nothrow) uint8_t[TINFL_LZ_DICT_SIZE]);
+    if (this->inflator_ == nullptr || this->window_ == nullptr) {
+      this->inflator_.reset();
+      this->window_.reset();
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+    }
+    tinfl_init(this->inflator_.get());
+    this->window_pos_ = 0;
+    this->header_skipped_ = false;
+    this->inflate_done_ = false;
+    this->image_size_ = image_size;
+    this->received_ = 0;
+  }
+#endif
+
+  esp_err_t err = esp_ota_begin(this->partition_, erase_size, &this->update_handle_);
 
 #if CONFIG_ESP_TASK_WDT_TIMEOUT_S < 15
   // Set the WDT back to the configured timeout
@@ -69,8 +96,16 @@ OTAResponseTypes IDFOTABackend::begin(size_t image_size) {
 void IDFOTABackend::set_update_md5(const char *expected_md5) { memcpy(this->expected_bin_md5_, expected_md5, 32); }
 
 OTAResponseTypes IDFOTABackend::write(uint8_t *data, size_t len) {
-  esp_err_t err = esp_ota_write(this->update_handle_, data, len);
   this->md5_.add(data, len);
+#ifdef USE_OTA_IDF_INFLATE
+  if (this->compressed_)
+    return this->inflate_(data, len);
+#endif
+  return this->write_flash_(data, len);
+}
+
+OTAResponseTypes IDFOTABackend::write_flash_(const uint8_t *data, size_t len) {
+  esp_err_t err = esp_ota_write(this->update_handle_, data, len);
   if (err != ESP_OK) {
     if (err == ESP_ERR_OTA_VALIDATE_FAILED) {
       return OTA_RESPONSE_ERROR_MAGIC;
@@ -82,8 +117,87 @@ OTAResponseTypes IDFOTABackend::write(uint8_t *data, size_t len) {
   return OTA_RESPONSE_OK;
 }
 
+#ifdef USE_OTA_IDF_INFLATE
+size_t IDFOTABackend::skip_gzip_header_(const uint8_t *data, size_t len) {
+  static const uint8_t GZIP_FHCRC = 0x02;
+  static const uint8_t GZIP_FEXTRA = 0x04;
+  static const uint8_t GZIP_FNAME = 0x08;
+  static const uint8_t GZIP_FCOMMENT = 0x10;
+
+  // The header is expected within the first chunk, which is at least as large as the receive buffer
+  if (len < 10 || data[0] != 0x1F || data[1] != 0x8B || data[2] != 8)
+    return 0;
+  const uint8_t flags = data[3];
+  size_t at = 10;
+  if (flags & GZIP_FEXTRA) {
+    if (at + 2 > len)
+      return 0;
+    at += 2 + (data[at] | (data[at + 1] << 8));
+  }
+  if (flags & GZIP_FNAME) {
+    while (at < len && data[at] != 0)
+      at++;
+    at++;
+  }
+  if (flags & GZIP_FCOMMENT) {
+    while (at < len && data[at] != 0)
+      at++;
+    at++;
+  }
+  if (flags & GZIP_FHCRC)
+    at += 2;
+  return at <= len ? at : 0;
+}
+
+OTAResponseTypes IDFOTABackend::inflate_(const uint8_t *data, size_t len) {
+  this->received_ += len;
+  if (!this->header_skipped_) {
+    size_t header = this->skip_gzip_header_(data, len);
+    if (header == 0)
+      return OTA_RESPONSE_ERROR_MAGIC;
+    this->header_skipped_ = true;
+    data += header;
+    len -= header;
+  }
+
+  const mz_uint32 flags = this->received_ < this->image_size_ ? TINFL_FLAG_HAS_MORE_INPUT : 0;
+  while (!this->inflate_done_) {
+    size_t in_bytes = len;
+    size_t out_bytes = TINFL_LZ_DICT_SIZE - this->window_pos_;
+    uint8_t *out = this->window_.get() + this->window_pos_;
+    tinfl_status status =
+        tinfl_decompress(this->inflator_.get(), data, &in_bytes, this->window_.get(), out, &out_bytes, flags);
+    data += in_bytes;
+    len -= in_bytes;
+    if (out_bytes != 0) {
+      OTAResponseTypes result = this->write_flash_(out, out_bytes);
+      if (result != OTA_RESPONSE_OK)
+        return result;
+      this->window_pos_ = (this->window_pos_ + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+    }
+    if (status < TINFL_STATUS_DONE)
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+    // the gzip trailer after the deflate stream is covered by the MD5 check already
+    if (status == TINFL_STATUS_DONE)
+      this->inflate_done_ = true;
+    else if (status == TINFL_STATUS_NEEDS_MORE_INPUT)
+      break;
+  }
+  return OTA_RESPONSE_OK;
+}
+#endif
+
 OTAResponseTypes IDFOTABackend::end() {
   this->md5_.calculate();
+#ifdef USE_OTA_IDF_INFLATE
+  const bool truncated = this->compressed_ && !this->inflate_done_;
+  this->inflator_.reset();
+  this->window_.reset();
+  if (truncated) {
+    this->abort();
+    return OTA_RESPONSE_ERROR_UPDATE_END;
+  }
+#endif
   if (!this->md5_.equals_hex(this->expected_bin_md5_)) {
     this->abort();
     return OTA_RESPONSE_ERROR_MD5_MISMATCH;
@@ -106,6 +220,10 @@ OTAResponseTypes IDFOTABackend::end() {
 }
 
 void IDFOTABackend::abort() {
+#ifdef USE_OTA_IDF_INFLATE
+  this->inflator_.reset();
+  this->window_.reset();
+#endif
   esp_ota_abort(this->update_handle_);
   this->update_handle_ = 0;
 }
@@ -7,6 +7,13 @@
 #include <esp_ota_ops.h>
 #include "esphome/components/md5/md5.h"
 
+#include <memory>
+
+#if __has_include(<rom/miniz.h>)
+#include <rom/miniz.h>
+#define USE_OTA_IDF_INFLATE
+#endif
+
 namespace esphome {
 namespace ota {
 
@@ -17,13 +24,37 @@ class IDFOTABackend : public OTABackend {
   OTAResponseTypes write(uint8_t *data, size_t len) override;
   OTAResponseTypes end() override;
   void abort() override;
+#ifdef USE_OTA_IDF_INFLATE
+  bool supports_compression() override { return true; }
+  void set_compressed(bool compressed) override { this->compressed_ = compressed; }
+#else
   bool supports_compression() override { return false; }
+#endif
 
  private:
+#ifdef USE_OTA_IDF_INFLATE
+  /// Skip the gzip member header at the start of the stream, returns the number of header bytes or 0 on error.
+  size_t skip_gzip_header_(const uint8_t *data, size_t len);
+  /// Inflate a chunk of the compressed stream and write the output to the partition.
+  OTAResponseTypes inflate_(const uint8_t *data, size_t len);
+#endif
+  OTAResponseTypes write_flash_(const uint8_t *data, size_t len);
+
   esp_ota_handle_t update_handle_{0};
   const esp_partition_t *partition_;
   md5::MD5Digest md5_{};
   char expected_bin_md5_[32];
+#ifdef USE_OTA_IDF_INFLATE
+  bool compressed_{false};
+  bool header_skipped_{false};
+  bool inflate_done_{false};
+  size_t image_size_{0};
+  size_t received_{0};
+  std::unique_ptr<tinfl_decompressor> inflator_;
+  /// Sliding window the inflater writes into, flushed to flash after every call.
+  std::unique_ptr<uint8_t[]> window_;
+  size_t window_pos_{0};
+#endif
 };
 
 }  // namespace ota
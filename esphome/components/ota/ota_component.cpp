@@ -12,9 +12,19 @@
 #include "esphome/core/util.h"
 #include "esphome/components/md5/md5.h"
 #include "esphome/components/network/util.h"
+#ifdef USE_WIFI
+#include "esphome/components/wifi/wifi_component.h"
+#endif
 
 #include <cerrno>
 #include <cstdio>
+#include <new>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif
 
 namespace esphome {
 namespace ota {
@@ -124,9 +134,7 @@ static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
 void OTAComponent::handle_() {
   OTAResponseTypes error_code = OTA_RESPONSE_ERROR_UNKNOWN;
   bool update_started = false;
-  size_t total = 0;
-  uint32_t last_progress = 0;
-  uint8_t buf[1024];
+  uint8_t buf[128];
   char *sbuf = reinterpret_cast<char *>(buf);
   size_t ota_size;
   uint8_t ota_features;
@@ -134,6 +142,8 @@ void OTAComponent::handle_() {
   (void) ota_features;
 
   if (client_ == nullptr) {
+    if (!server_->ready())
+      return;
     struct sockaddr_storage source_addr;
     socklen_t addr_len = sizeof(source_addr);
     client_ = server_->accept((struct sockaddr *) &source_addr, &addr_len);
@@ -150,6 +160,11 @@ void OTAComponent::handle_() {
 
   ESP_LOGD(TAG, "Starting OTA Update from %s...", this->client_->getpeername().c_str());
   this->status_set_warning();
+#ifdef USE_WIFI
+  // released on error, a successful update ends in a reboot
+  if (wifi::global_wifi_component != nullptr)
+    wifi::global_wifi_component->acquire_high_performance();
+#endif
 #ifdef USE_OTA_STATE_CALLBACK
   this->state_callback_.call(OTA_STARTED, 0.0f, 0);
 #endif
@@ -185,6 +200,7 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_HEADER_OK;
   if ((ota_features & FEATURE_SUPPORTS_COMPRESSION) != 0 && backend->supports_compression()) {
     buf[0] = OTA_RESPONSE_SUPPORTS_COMPRESSION;
+    backend->set_compressed(true);
   }
 
   this->writeall_(buf, 1);
@@ -286,46 +302,9 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_BIN_MD5_OK;
   this->writeall_(buf, 1);
 
-  while (total < ota_size) {
-    // TODO: timeout check
-    size_t requested = std::min(sizeof(buf), ota_size - total);
-    ssize_t read = this->client_->read(buf, requested);
-    if (read == -1) {
-      if (errno == EAGAIN || errno == EWOULDBLOCK) {
-        App.feed_wdt();
-        delay(1);
-        continue;
-      }
-      ESP_LOGW(TAG, "Error receiving data for update, errno: %d", errno);
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    } else if (read == 0) {
-      // $ man recv
-      // "When  a  stream socket peer has performed an orderly shutdown, the return value will
-      // be 0 (the traditional "end-of-file" return)."
-      ESP_LOGW(TAG, "Remote end closed connection");
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    }
-
-    error_code = backend->write(buf, read);
-    if (error_code != OTA_RESPONSE_OK) {
-      ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", error_code);
-      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
-    }
-    total += read;
-
-    uint32_t now = millis();
-    if (now - last_progress > 1000) {
-      last_progress = now;
-      float percentage = (total * 100.0f) / ota_size;
-      ESP_LOGD(TAG, "OTA in progress: %0.1f%%", percentage);
-#ifdef USE_OTA_STATE_CALLBACK
-      this->state_callback_.call(OTA_IN_PROGRESS, percentage, 0);
-#endif
-      // feed watchdog and give other tasks a chance to run
-      App.feed_wdt();
-      yield();
-    }
-  }
+  error_code = this->receive_(backend.get(), ota_size);
+  if (error_code != OTA_RESPONSE_OK)
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
 
   // Acknowledge receive OK - 1 byte
   buf[0] = OTA_RESPONSE_RECEIVE_OK;
@@ -367,6 +346,10 @@ error:
   if (backend != nullptr && update_started) {
     backend->abort();
   }
+#ifdef USE_WIFI
+  if (wifi::global_wifi_component != nullptr)
+    wifi::global_wifi_component->release_high_performance();
+#endif
 
   this->status_momentary_error("onerror", 5000);
 #ifdef USE_OTA_STATE_CALLBACK
@@ -374,6 +357,153 @@ error:
 #endif
 }
 
+#ifdef USE_ESP32
+namespace {
+/// A buffer handed to the flash writer task, data is nullptr to stop the task.
+struct OTAWriteJob {
+  uint8_t *data;
+  size_t len;
+};
+struct OTAWriter {
+  OTABackend *backend;
+  QueueHandle_t jobs;
+  /// One OTAResponseTypes per job, and a last one when the task exits.
+  QueueHandle_t results;
+};
+}  // namespace
+
+static void ota_writer_task(void *arg) {
+  auto *writer = static_cast<OTAWriter *>(arg);
+  OTAWriteJob job;
+  OTAResponseTypes result = OTA_RESPONSE_OK;
+  while (xQueueReceive(writer->jobs, &job, portMAX_DELAY) == pdTRUE && job.data != nullptr) {
+    result = writer->backend->write(job.data, job.len);
+    xQueueSend(writer->results, &result, portMAX_DELAY);
+  }
+  xQueueSend(writer->results, &result, portMAX_DELAY);
+  vTaskDelete(nullptr);
+}
+
+static OTAResponseTypes wait_for_writer(OTAWriter &writer) {
+  OTAResponseTypes result;
+  while (xQueueReceive(writer.results, &result, pdMS_TO_TICKS(50)) != pdTRUE)
+    App.feed_wdt();
+  return result;
+}
+#endif
+
+OTAResponseTypes OTAComponent::receive_(OTABackend *backend, size_t ota_size) {
+  /* On ESP32 the image is received into two buffers in turn: while the socket fills one, a writer task commits the
+   * other to flash, so flash erases don't stall the transfer. Elsewhere one buffer is written synchronously.
+   */
+#ifdef USE_ESP32
+  const size_t buffer_count = 2;
+#else
+  const size_t buffer_count = 1;
+#endif
+  std::unique_ptr<uint8_t[]> storage(new (std::nothrow) uint8_t[this->buffer_size_ * buffer_count]);
+  if (storage == nullptr) {
+    ESP_LOGW(TAG, "Could not allocate %u bytes for the receive buffer", (unsigned) (this->buffer_size_ * buffer_count));
+    return OTA_RESPONSE_ERROR_UNKNOWN;
+  }
+
+#ifdef USE_ESP32
+  OTAWriter writer{backend, xQueueCreate(1, sizeof(OTAWriteJob)), xQueueCreate(2, sizeof(OTAResponseTypes))};
+  bool writer_busy = false;
+  if (writer.jobs == nullptr || writer.results == nullptr ||
+      xTaskCreate(ota_writer_task, "ota_write", 4096, &writer, 5, nullptr) != pdPASS) {
+    if (writer.jobs != nullptr)
+      vQueueDelete(writer.jobs);
+    if (writer.results != nullptr)
+      vQueueDelete(writer.results);
+    ESP_LOGW(TAG, "Could not start the flash writer task");
+    return OTA_RESPONSE_ERROR_UNKNOWN;
+  }
+#endif
+
+  OTAResponseTypes error_code = OTA_RESPONSE_OK;
+  size_t total = 0;
+  size_t current = 0;
+  uint32_t last_progress = 0;
+  while (total < ota_size) {
+    uint8_t *buf = storage.get() + current * this->buffer_size_;
+    const size_t requested = std::min(this->buffer_size_, ota_size - total);
+    size_t filled = 0;
+    // TODO: timeout check
+    while (filled < requested) {
+      ssize_t read = this->client_->read(buf + filled, requested - filled);
+      if (read == -1) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          App.feed_wdt();
+          delay(1);
+          continue;
+        }
+        ESP_LOGW(TAG, "Error receiving data for update, errno: %d", errno);
+        error_code = OTA_RESPONSE_ERROR_UNKNOWN;
+        break;
+      } else if (read == 0) {
+        // $ man recv
+        // "When  a  stream socket peer has performed an orderly shutdown, the return value will
+        // be 0 (the traditional "end-of-file" return)."
+        ESP_LOGW(TAG, "Remote end closed connection");
+        error_code = OTA_RESPONSE_ERROR_UNKNOWN;
+        break;
+      }
+      filled += read;
+    }
+    if (error_code != OTA_RESPONSE_OK)
+      break;
+
+#ifdef USE_ESP32
+    if (writer_busy)
+      error_code = wait_for_writer(writer);
+    if (error_code == OTA_RESPONSE_OK) {
+      OTAWriteJob job{buf, filled};
+      xQueueSend(writer.jobs, &job, portMAX_DELAY);
+      writer_busy = true;
+      current = (current + 1) % buffer_count;
+    }
+#else
+    error_code = backend->write(buf, filled);
+#endif
+    if (error_code != OTA_RESPONSE_OK) {
+      ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", error_code);
+      break;
+    }
+    total += filled;
+
+    uint32_t now = millis();
+    if (now - last_progress > 1000) {
+      last_progress = now;
+      float percentage = (total * 100.0f) / ota_size;
+      ESP_LOGD(TAG, "OTA in progress: %0.1f%%", percentage);
+#ifdef USE_OTA_STATE_CALLBACK
+      this->state_callback_.call(OTA_IN_PROGRESS, percentage, 0);
+#endif
+      // feed watchdog and give other tasks a chance to run
+      App.feed_wdt();
+      yield();
+    }
+  }
+
+#ifdef USE_ESP32
+  if (writer_busy) {
+    OTAResponseTypes result = wait_for_writer(writer);
+    if (error_code == OTA_RESPONSE_OK && result != OTA_RESPONSE_OK) {
+      ESP_LOGW(TAG, "Error writing binary data to flash!, error_code: %d", result);
+      error_code = result;
+    }
+  }
+  // stop the writer and wait until it is done with the queues
+  OTAWriteJob stop{nullptr, 0};
+  xQueueSend(writer.jobs, &stop, portMAX_DELAY);
+  wait_for_writer(writer);
+  vQueueDelete(writer.jobs);
+  vQueueDelete(writer.results);
+#endif
+  return error_code;
+}
+
 bool OTAComponent::readall_(uint8_t *buf, size_t len) {
   uint32_t start = millis();
   uint32_t at = 0;
@@ -39,6 +39,8 @@ enum OTAResponseTypes {
 
 enum OTAState { OTA_COMPLETED = 0, OTA_STARTED, OTA_IN_PROGRESS, OTA_ERROR };
 
+class OTABackend;
+
 /// OTAComponent provides a simple way to integrate Over-the-Air updates into your app using ArduinoOTA.
 class OTAComponent : public Component {
  public:
@@ -50,6 +52,9 @@ class OTAComponent : public Component {
   /// Manually set the port OTA should listen on.
   void set_port(uint16_t port);
 
+  /// Set the size of the buffers the image is received into, ESP32 uses two of them.
+  void set_buffer_size(size_t buffer_size) { this->buffer_size_ = buffer_size; }
+
   bool should_enter_safe_mode(uint8_t num_attempts, uint32_t enable_time);
 
   /// Set to true if the next startup will enter safe mode
@@ -78,6 +83,8 @@ class OTAComponent : public Component {
   uint32_t read_rtc_();
 
   void handle_();
+  /// Receive the image and write it to the backend.
+  OTAResponseTypes receive_(OTABackend *backend, size_t ota_size);
   bool readall_(uint8_t *buf, size_t len);
   bool writeall_(const uint8_t *buf, size_t len);
 
@@ -86,6 +93,7 @@ class OTAComponent : public Component {
 #endif  // USE_OTA_PASSWORD
 
   uint16_t port_;
+  size_t buffer_size_{1024};
 
   std::unique_ptr<socket::Socket> server_;
   std::unique_ptr<socket::Socket> client_;
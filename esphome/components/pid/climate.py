@@ -3,6 +3,7 @@ import esphome.config_validation as cv
 from esphome import automation
 from esphome.components import climate, sensor, output
 from esphome.const import CONF_ID, CONF_SENSOR
+from esphome.core import CORE
 
 pid_ns = cg.esphome_ns.namespace("pid")
 PIDClimate = pid_ns.class_("PIDClimate", climate.Climate, cg.Component)
@@ -30,6 +31,8 @@ CONF_MIN_INTEGRAL = "min_integral"
 CONF_MAX_INTEGRAL = "max_integral"
 CONF_OUTPUT_AVERAGING_SAMPLES = "output_averaging_samples"
 CONF_DERIVATIVE_AVERAGING_SAMPLES = "derivative_averaging_samples"
+CONF_ANTI_WINDUP = "anti_windup"
+CONF_CONTROL_INTERVAL = "control_interval"
 
 # Deadband parameters
 CONF_DEADBAND_PARAMETERS = "deadband_parameters"
@@ -48,6 +51,10 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_DEFAULT_TARGET_TEMPERATURE): cv.temperature,
             cv.Optional(CONF_COOL_OUTPUT): cv.use_id(output.FloatOutput),
             cv.Optional(CONF_HEAT_OUTPUT): cv.use_id(output.FloatOutput),
+            cv.Optional(CONF_CONTROL_INTERVAL): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(milliseconds=10)),
+            ),
             cv.Optional(CONF_DEADBAND_PARAMETERS): cv.Schema(
                 {
                     cv.Required(CONF_THRESHOLD_HIGH): cv.temperature,
@@ -70,6 +77,7 @@ CONFIG_SCHEMA = cv.All(
                     cv.Optional(CONF_MAX_INTEGRAL, default=1): cv.float_,
                     cv.Optional(CONF_DERIVATIVE_AVERAGING_SAMPLES, default=1): cv.int_,
                     cv.Optional(CONF_OUTPUT_AVERAGING_SAMPLES, default=1): cv.int_,
+                    cv.Optional(CONF_ANTI_WINDUP, default=False): cv.boolean,
                 }
             ),
         }
@@ -100,6 +108,7 @@ async def to_code(config):
     cg.add(var.set_derivative_samples(params[CONF_DERIVATIVE_AVERAGING_SAMPLES]))
 
     cg.add(var.set_output_samples(params[CONF_OUTPUT_AVERAGING_SAMPLES]))
+    cg.add(var.set_anti_windup(params[CONF_ANTI_WINDUP]))
 
     if CONF_MIN_INTEGRAL in params:
         cg.add(var.set_min_integral(params[CONF_MIN_INTEGRAL]))
@@ -121,6 +130,11 @@ async def to_code(config):
 
     cg.add(var.set_default_target_temperature(config[CONF_DEFAULT_TARGET_TEMPERATURE]))
 
+    if CONF_CONTROL_INTERVAL in config:
+        cg.add(var.set_control_interval(config[CONF_CONTROL_INTERVAL]))
+        if CORE.is_esp32:
+            cg.add_define("USE_HIRES_INTERVAL")
+
 
 @automation.register_action(
     "climate.pid.reset_integral_term",
@@ -1,6 +1,8 @@
 #include "pid_autotuner.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 #ifndef M_PI
 #define M_PI 3.1415926535897932384626433
 #endif
@@ -187,7 +189,7 @@ void PIDAutotuner::dump_config() {
     ESP_LOGD(TAG, "  Status: Trying to reach %.2f °C", setpoint_ - relay_function_.current_target_error());
     ESP_LOGD(TAG, "  Stats so far:");
     ESP_LOGD(TAG, "    Phases: %u", relay_function_.phase_count);
-    ESP_LOGD(TAG, "    Detected %u zero-crossings", frequency_detector_.zerocrossing_intervals.size());  // NOLINT
+    ESP_LOGD(TAG, "    Detected %" PRIu32 " zero-crossings", frequency_detector_.zerocrossing_count);
     ESP_LOGD(TAG, "    Current Phase Min: %.2f, Max: %.2f", amplitude_detector_.phase_min,
              amplitude_detector_.phase_max);
   }
@@ -253,23 +255,23 @@ void PIDAutotuner::OscillationFrequencyDetector::update(uint32_t now, float erro
     // Had crossing above hysteresis threshold, record
     if (this->last_zerocross != 0) {
       uint32_t dt = now - this->last_zerocross;
-      this->zerocrossing_intervals.push_back(dt);
+      this->zerocrossing_count++;
+      this->zerocrossing_interval_sum += dt;
+      this->zerocrossing_interval_min = std::min(this->zerocrossing_interval_min, dt);
+      this->zerocrossing_interval_max = std::max(this->zerocrossing_interval_max, dt);
     }
     this->last_zerocross = now;
   }
 }
 bool PIDAutotuner::OscillationFrequencyDetector::has_enough_data() const {
   // Do we have enough data in this detector to generate PID values?
-  return this->zerocrossing_intervals.size() >= 2;
+  return this->zerocrossing_count >= 2;
 }
 float PIDAutotuner::OscillationFrequencyDetector::get_mean_oscillation_period() const {
   // Get the mean oscillation period in seconds
   // Only call if has_enough_data() has returned true.
-  float sum = 0.0f;
-  for (uint32_t v : this->zerocrossing_intervals)
-    sum += v;
   // zerocrossings are each half-period, multiply by 2
-  float mean_value = sum / this->zerocrossing_intervals.size();
+  float mean_value = float(this->zerocrossing_interval_sum) / this->zerocrossing_count;
   // divide by 1000 to get seconds, multiply by two because zc happens two times per period
   float mean_period = mean_value / 1000 * 2;
   return mean_period;
@@ -280,15 +282,9 @@ bool PIDAutotuner::OscillationFrequencyDetector::is_increase_decrease_symmetrica
   // not be very good and the function output values need to be adjusted
   // Happens for example with a well-insulated heating element.
   // We calculate this based on the zerocrossing interval.
-  if (zerocrossing_intervals.empty())
+  if (zerocrossing_count == 0)
     return false;
-  uint32_t max_interval = zerocrossing_intervals[0];
-  uint32_t min_interval = zerocrossing_intervals[0];
-  for (uint32_t interval : zerocrossing_intervals) {
-    max_interval = std::max(max_interval, interval);
-    min_interval = std::min(min_interval, interval);
-  }
-  float ratio = min_interval / float(max_interval);
+  float ratio = zerocrossing_interval_min / float(zerocrossing_interval_max);
   return ratio >= 0.66;
 }
 
@@ -79,7 +79,11 @@ class PIDAutotuner {
     } state;
     float noiseband = 0.05;
     uint32_t last_zerocross{0};
-    std::vector<uint32_t> zerocrossing_intervals;
+    /// Running statistics of the intervals between zero crossings, so they don't pile up over a long autotune.
+    uint32_t zerocrossing_count{0};
+    uint64_t zerocrossing_interval_sum{0};
+    uint32_t zerocrossing_interval_min{UINT32_MAX};
+    uint32_t zerocrossing_interval_max{0};
   } frequency_detector_;
   struct OscillationAmplitudeDetector {
     void update(float error, RelayFunction::RelayFunctionState relay_state);
@@ -1,6 +1,8 @@
 #include "pid_climate.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace pid {
 
@@ -11,9 +13,15 @@ void PIDClimate::setup() {
     // only publish if state/current temperature has changed in two digits of precision
     this->do_publish_ = roundf(state * 100) != roundf(this->current_temperature * 100);
     this->current_temperature = state;
-    this->update_pid_();
+    if (this->control_interval_ == 0) {
+      this->update_pid_();
+    }
   });
   this->current_temperature = this->sensor_->state;
+  this->controller_.output_min_ = this->supports_cool_() ? -1.0f : 0.0f;
+  this->controller_.output_max_ = this->supports_heat_() ? 1.0f : 0.0f;
+  if (this->control_interval_ != 0)
+    this->start_control_interval_();
   // restore set points
   auto restore = this->restore_state_();
   if (restore.has_value()) {
@@ -30,6 +38,24 @@ void PIDClimate::setup() {
     this->target_temperature = this->default_target_temperature_;
   }
 }
+void PIDClimate::start_control_interval_() {
+  this->controller_.fixed_dt_ = this->control_interval_ / 1000.0f;
+#ifdef USE_HIRES_INTERVAL
+  // Phase locked, so the steps don't drift with the main loop
+  this->control_timer_ = make_unique<HighResolutionInterval>([this]() {
+    const int64_t deadline = this->control_timer_->get_deadline();
+    // Steps the main loop was too busy for are skipped, the time step covers them
+    if (this->last_deadline_ != 0)
+      this->controller_.fixed_dt_ = (deadline - this->last_deadline_) / 1e6f;
+    this->last_deadline_ = deadline;
+    this->update_pid_();
+  });
+  if (this->control_timer_->start(uint64_t(this->control_interval_) * 1000))
+    return;
+  this->control_timer_.reset();
+#endif
+  this->set_interval("control", this->control_interval_, [this]() { this->update_pid_(); });
+}
 void PIDClimate::control(const climate::ClimateCall &call) {
   if (call.get_mode().has_value())
     this->mode = *call.get_mode();
@@ -63,6 +89,10 @@ void PIDClimate::dump_config() {
   ESP_LOGCONFIG(TAG, "  Control Parameters:");
   ESP_LOGCONFIG(TAG, "    kp: %.5f, ki: %.5f, kd: %.5f, output samples: %d", controller_.kp_, controller_.ki_,
                 controller_.kd_, controller_.output_samples_);
+  ESP_LOGCONFIG(TAG, "    Anti-windup: %s", YESNO(controller_.anti_windup_));
+  if (this->control_interval_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Control Interval: %" PRIu32 " ms", this->control_interval_);
+  }
 
   if (controller_.threshold_low_ == 0 && controller_.threshold_high_ == 0) {
     ESP_LOGCONFIG(TAG, "  Deadband disabled.");
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/hires_interval.h"
 #include "esphome/components/climate/climate.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/output/float_output.h"
@@ -37,6 +38,13 @@ class PIDClimate : public climate::Climate, public Component {
   void set_starting_integral_term(float in) { controller_.set_starting_integral_term(in); }
 
   void set_deadband_output_samples(int in) { controller_.deadband_output_samples_ = in; }
+  void set_anti_windup(bool anti_windup) { controller_.anti_windup_ = anti_windup; }
+  /** Run the controller at a fixed rate instead of whenever the sensor publishes.
+   *
+   * Every step takes the latest sensor value and writes the outputs, with a fixed time step for the integral and
+   * derivative terms, so the control latency no longer depends on how often the sensor publishes.
+   */
+  void set_control_interval(uint32_t control_interval) { control_interval_ = control_interval; }
 
   float get_output_value() const { return output_value_; }
   float get_error_value() const { return controller_.error_; }
@@ -77,6 +85,7 @@ class PIDClimate : public climate::Climate, public Component {
   climate::ClimateTraits traits() override;
 
   void update_pid_();
+  void start_control_interval_();
 
   bool supports_cool_() const { return this->cool_output_ != nullptr; }
   bool supports_heat_() const { return this->heat_output_ != nullptr; }
@@ -94,6 +103,12 @@ class PIDClimate : public climate::Climate, public Component {
   float default_target_temperature_;
   std::unique_ptr<PIDAutotuner> autotuner_;
   bool do_publish_ = false;
+  /// In milliseconds, 0 to update whenever the sensor publishes.
+  uint32_t control_interval_{0};
+#ifdef USE_HIRES_INTERVAL
+  std::unique_ptr<HighResolutionInterval> control_timer_;
+  int64_t last_deadline_{0};
+#endif
 };
 
 template<typename... Ts> class PIDAutotuneAction : public Action<Ts...> {
@@ -15,8 +15,9 @@ float PIDController::update(float setpoint, float process_value) {
   error_ = setpoint - process_value;
 
   calculate_proportional_term_();
-  calculate_integral_term_();
+  // the integral term comes last, anti-windup needs the other terms
   calculate_derivative_term_();
+  calculate_integral_term_();
 
   // u(t) := p(t) + i(t) + d(t)
   float output = proportional_term_ + integral_term_ + derivative_term_;
@@ -55,10 +56,16 @@ void PIDController::calculate_integral_term_() {
 
   if (in_deadband()) {
     // shallow the integral when in the deadband
-    accumulated_integral_ += new_integral * ki_multiplier_;
-  } else {
-    accumulated_integral_ += new_integral;
+    new_integral *= ki_multiplier_;
+  }
+
+  if (anti_windup_) {
+    // while the output is saturated, only integrate what brings it back into range
+    float output = proportional_term_ + derivative_term_ + accumulated_integral_;
+    if ((output >= output_max_ && new_integral > 0) || (output <= output_min_ && new_integral < 0))
+      new_integral = 0;
   }
+  accumulated_integral_ += new_integral;
 
   // constrain accumulated integral value
   if (!std::isnan(min_integral_) && accumulated_integral_ < min_integral_)
@@ -110,6 +117,8 @@ float PIDController::weighted_average_(std::deque<float> &list, float new_value,
 }
 
 float PIDController::calculate_relative_time_() {
+  if (fixed_dt_ > 0.0f)
+    return fixed_dt_;
   uint32_t now = millis();
   uint32_t dt = now - this->last_time_;
   if (last_time_ == 0) {
@@ -40,6 +40,14 @@ struct PIDController {
   float min_integral_ = NAN;
   float max_integral_ = NAN;
 
+  /// Stop integrating while the output is saturated in the direction the error pushes it (conditional integration).
+  bool anti_windup_ = false;
+  float output_min_ = -1.0f;
+  float output_max_ = 1.0f;
+
+  /// Time step in seconds for fixed rate control, 0 to measure the time between updates instead.
+  float fixed_dt_ = 0.0f;
+
   // Store computed values in struct so that values can be monitored through sensors
   float error_;
   float dt_;
@@ -3,55 +3,154 @@
 #include "prometheus_handler.h"
 #include "esphome/core/application.h"
 
+#include <memory>
+
 namespace esphome {
 namespace prometheus {
 
+void PrometheusHandler::setup() {
+  // Everything static about a row is formatted once here, a scrape only appends the states
+#ifdef USE_SENSOR
+  this->add_blocks_(METRIC_SENSOR, App.get_sensors());
+#endif
+#ifdef USE_BINARY_SENSOR
+  this->add_blocks_(METRIC_BINARY_SENSOR, App.get_binary_sensors());
+#endif
+#ifdef USE_FAN
+  this->add_blocks_(METRIC_FAN, App.get_fans());
+#endif
+#ifdef USE_LIGHT
+  this->add_blocks_(METRIC_LIGHT, App.get_lights());
+#endif
+#ifdef USE_COVER
+  this->add_blocks_(METRIC_COVER, App.get_covers());
+#endif
+#ifdef USE_SWITCH
+  this->add_blocks_(METRIC_SWITCH, App.get_switches());
+#endif
+#ifdef USE_LOCK
+  this->add_blocks_(METRIC_LOCK, App.get_locks());
+#endif
+  // the labels hold the relabeled values now
+  this->relabel_map_id_.clear();
+  this->relabel_map_name_.clear();
+
+  this->base_->init();
+  this->base_->add_handler(this);
+}
+
+template<typename T> void PrometheusHandler::add_blocks_(MetricType type, const std::vector<T *> &entities) {
+  this->blocks_.push_back(MetricBlock{type, nullptr, ""});
+  for (T *obj : entities) {
+    if (obj->is_internal() && !this->include_internal_)
+      continue;
+    this->blocks_.push_back(
+        MetricBlock{type, obj, "id=\"" + this->relabel_id_(obj) + "\",name=\"" + this->relabel_name_(obj) + "\""});
+  }
+}
+
+namespace {
+/// Progress of one streamed response.
+struct ResponseState {
+  size_t block{0};
+  std::string pending;
+  size_t offset{0};
+};
+}  // namespace
+
 void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+  // The exposition is streamed one block at a time, so memory use doesn't grow with the number of entities
+  auto state = std::make_shared<ResponseState>();
+  AsyncWebServerResponse *response = req->beginChunkedResponse(
+      "text/plain; version=0.0.4; charset=utf-8", [this, state](uint8_t *buffer, size_t max_len, size_t index) {
+        size_t written = 0;
+        while (written < max_len) {
+          if (state->offset == state->pending.size()) {
+            if (state->block == this->blocks_.size())
+              break;
+            state->pending.clear();
+            state->offset = 0;
+            this->render_block_(this->blocks_[state->block++], state->pending);
+            continue;
+          }
+          const size_t length = std::min(max_len - written, state->pending.size() - state->offset);
+          memcpy(buffer + written, state->pending.data() + state->offset, length);
+          state->offset += length;
+          written += length;
+        }
+        return written;
+      });
+  req->send(response);
+}
 
+void PrometheusHandler::render_block_(const MetricBlock &block, std::string &out) {
+  switch (block.type) {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
-  for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+    case METRIC_SENSOR:
+      if (block.obj == nullptr) {
+        this->sensor_type_(out);
+      } else {
+        this->sensor_row_(out, static_cast<sensor::Sensor *>(block.obj), block.labels);
+      }
+      break;
 #endif
-
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
-  for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+    case METRIC_BINARY_SENSOR:
+      if (block.obj == nullptr) {
+        this->binary_sensor_type_(out);
+      } else {
+        this->binary_sensor_row_(out, static_cast<binary_sensor::BinarySensor *>(block.obj), block.labels);
+      }
+      break;
 #endif
-
 #ifdef USE_FAN
-  this->fan_type_(stream);
-  for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+    case METRIC_FAN:
+      if (block.obj == nullptr) {
+        this->fan_type_(out);
+      } else {
+        this->fan_row_(out, static_cast<fan::Fan *>(block.obj), block.labels);
+      }
+      break;
 #endif
-
 #ifdef USE_LIGHT
-  this->light_type_(stream);
-  for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+    case METRIC_LIGHT:
+      if (block.obj == nullptr) {
+        this->light_type_(out);
+      } else {
+        this->light_row_(out, static_cast<light::LightState *>(block.obj), block.labels);
+      }
+      break;
 #endif
-
 #ifdef USE_COVER
-  this->cover_type_(stream);
-  for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+    case METRIC_COVER:
+      if (block.obj == nullptr) {
+        this->cover_type_(out);
+      } else {
+        this->cover_row_(out, static_cast<cover::Cover *>(block.obj), block.labels);
+      }
+      break;
 #endif
-
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
-  for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+    case METRIC_SWITCH:
+      if (block.obj == nullptr) {
+        this->switch_type_(out);
+      } else {
+        this->switch_row_(out, static_cast<switch_::Switch *>(block.obj), block.labels);
+      }
+      break;
 #endif
-
 #ifdef USE_LOCK
-  this->lock_type_(stream);
-  for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj);
+    case METRIC_LOCK:
+      if (block.obj == nullptr) {
+        this->lock_type_(out);
+      } else {
+        this->lock_row_(out, static_cast<lock::Lock *>(block.obj), block.labels);
+      }
+      break;
 #endif
-
-  req->send(stream);
+    default:
+      break;
+  }
 }
 
 std::string PrometheusHandler::relabel_id_(EntityBase *obj) {
@@ -64,289 +163,169 @@ std::string PrometheusHandler::relabel_name_(EntityBase *obj) {
   return item == relabel_map_name_.end() ? obj->get_name() : item->second;
 }
 
+/// Append a metric row, `<metric>{<labels><extra>} <value>`.
+static void append_row(std::string &out, const char *metric, const std::string &labels, const char *extra,
+                       const char *value) {
+  out += metric;
+  out += '{';
+  out += labels;
+  out += extra;
+  out += "} ";
+  out += value;
+  out += '\n';
+}
+static void append_row(std::string &out, const char *metric, const std::string &labels, const char *value) {
+  append_row(out, metric, labels, "", value);
+}
+/// Format like Arduino's Print::print(float), which the exporter used before
+static void append_row(std::string &out, const char *metric, const std::string &labels, const char *extra,
+                       float value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.2f", value);
+  append_row(out, metric, labels, extra, buf);
+}
+static void append_row(std::string &out, const char *metric, const std::string &labels, float value) {
+  append_row(out, metric, labels, "", value);
+}
+static void append_row(std::string &out, const char *metric, const std::string &labels, bool value) {
+  append_row(out, metric, labels, "", value ? "1" : "0");
+}
+
 // Type-specific implementation
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
+void PrometheusHandler::sensor_type_(std::string &out) {
+  out += "#TYPE esphome_sensor_value GAUGE\n";
+  out += "#TYPE esphome_sensor_failed GAUGE\n";
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels) {
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    append_row(out, "esphome_sensor_failed", labels, "0");
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print('\n');
+    std::string unit = ",unit=\"" + obj->get_unit_of_measurement() + "\"";
+    append_row(out, "esphome_sensor_value", labels, unit.c_str(),
+               value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    append_row(out, "esphome_sensor_failed", labels, "1");
   }
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
+void PrometheusHandler::binary_sensor_type_(std::string &out) {
+  out += "#TYPE esphome_binary_sensor_value GAUGE\n";
+  out += "#TYPE esphome_binary_sensor_failed GAUGE\n";
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj,
+                                           const std::string &labels) {
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    append_row(out, "esphome_binary_sensor_failed", labels, "0");
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print('\n');
+    append_row(out, "esphome_binary_sensor_value", labels, obj->state);
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    append_row(out, "esphome_binary_sensor_failed", labels, "1");
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_failed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
+void PrometheusHandler::fan_type_(std::string &out) {
+  out += "#TYPE esphome_fan_value GAUGE\n";
+  out += "#TYPE esphome_fan_failed GAUGE\n";
+  out += "#TYPE esphome_fan_speed GAUGE\n";
+  out += "#TYPE esphome_fan_oscillation GAUGE\n";
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::fan_row_(std::string &out, fan::Fan *obj, const std::string &labels) {
+  append_row(out, "esphome_fan_failed", labels, "0");
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  append_row(out, "esphome_fan_value", labels, obj->state);
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print('\n');
+    append_row(out, "esphome_fan_speed", labels, to_string(obj->speed).c_str());
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print('\n');
+    append_row(out, "esphome_fan_oscillation", labels, obj->oscillating);
   }
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_color GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
+void PrometheusHandler::light_type_(std::string &out) {
+  out += "#TYPE esphome_light_state GAUGE\n";
+  out += "#TYPE esphome_light_color GAUGE\n";
+  out += "#TYPE esphome_light_effect_active GAUGE\n";
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::light_row_(std::string &out, light::LightState *obj, const std::string &labels) {
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  append_row(out, "esphome_light_state", labels, obj->remote_values.is_on());
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  append_row(out, "esphome_light_color", labels, ",channel=\"brightness\"", brightness);
+  append_row(out, "esphome_light_color", labels, ",channel=\"r\"", r);
+  append_row(out, "esphome_light_color", labels, ",channel=\"g\"", g);
+  append_row(out, "esphome_light_color", labels, ",channel=\"b\"", b);
+  append_row(out, "esphome_light_color", labels, ",channel=\"w\"", w);
   // Effect
   std::string effect = obj->get_effect_name();
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    append_row(out, "esphome_light_effect_active", labels, ",effect=\"None\"", "0");
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
+    std::string extra = ",effect=\"" + effect + "\"";
+    append_row(out, "esphome_light_effect_active", labels, extra.c_str(), "1");
   }
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
+void PrometheusHandler::cover_type_(std::string &out) {
+  out += "#TYPE esphome_cover_value GAUGE\n";
+  out += "#TYPE esphome_cover_failed GAUGE\n";
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::cover_row_(std::string &out, cover::Cover *obj, const std::string &labels) {
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    append_row(out, "esphome_cover_failed", labels, "0");
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print('\n');
+    append_row(out, "esphome_cover_value", labels, obj->position);
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(relabel_id_(obj).c_str());
-      stream->print(F("\",name=\""));
-      stream->print(relabel_name_(obj).c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print('\n');
+      append_row(out, "esphome_cover_tilt", labels, obj->tilt);
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    append_row(out, "esphome_cover_failed", labels, "1");
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
+void PrometheusHandler::switch_type_(std::string &out) {
+  out += "#TYPE esphome_switch_value GAUGE\n";
+  out += "#TYPE esphome_switch_failed GAUGE\n";
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels) {
+  append_row(out, "esphome_switch_failed", labels, "0");
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  append_row(out, "esphome_switch_value", labels, obj->state);
 }
 #endif
 
 #ifdef USE_LOCK
-void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_lock_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_lock_failed GAUGE\n"));
+void PrometheusHandler::lock_type_(std::string &out) {
+  out += "#TYPE esphome_lock_value GAUGE\n";
+  out += "#TYPE esphome_lock_failed GAUGE\n";
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::lock_row_(std::string &out, lock::Lock *obj, const std::string &labels) {
+  append_row(out, "esphome_lock_failed", labels, "0");
   // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  append_row(out, "esphome_lock_value", labels, to_string((int) obj->state).c_str());
 }
 #endif
 
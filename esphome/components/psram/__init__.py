@@ -18,6 +18,26 @@ SPIRAM_MODES = {
     "octal": "CONFIG_SPIRAM_MODE_OCT",
 }
 
+CONF_PLACEMENT = "placement"
+
+HeapTag = cg.esphome_ns.enum("HeapTag", is_class=True)
+RAMPlacement = cg.esphome_ns.enum("RAMPlacement", is_class=True)
+set_ram_placement = cg.esphome_ns.set_ram_placement
+
+# The subsystems whose large buffers go through ExternalRAMAllocator
+PLACEMENT_TAGS = {
+    "display": HeapTag.DISPLAY,
+    "ble": HeapTag.BLE,
+    "light": HeapTag.LIGHT,
+    "audio": HeapTag.AUDIO,
+    "other": HeapTag.OTHER,
+}
+PLACEMENTS = {
+    "prefer_external": RAMPlacement.PREFER_EXTERNAL,
+    "prefer_internal": RAMPlacement.PREFER_INTERNAL,
+    "external": RAMPlacement.EXTERNAL,
+}
+
 SPIRAM_SPEEDS = {
     40e6: "CONFIG_SPIRAM_SPEED_40M",
     80e6: "CONFIG_SPIRAM_SPEED_80M",
@@ -30,6 +50,12 @@ CONFIG_SCHEMA = cv.All(
             cv.GenerateID(): cv.declare_id(PsramComponent),
             cv.Optional(CONF_MODE): cv.enum(SPIRAM_MODES, lower=True),
             cv.Optional(CONF_SPEED): cv.All(cv.frequency, cv.one_of(*SPIRAM_SPEEDS)),
+            cv.Optional(CONF_PLACEMENT, default={}): cv.Schema(
+                {
+                    cv.Optional(tag): cv.enum(PLACEMENTS, lower=True)
+                    for tag in PLACEMENT_TAGS
+                }
+            ),
         }
     ),
     cv.only_on_esp32,
@@ -54,5 +80,8 @@ async def to_code(config):
         if CONF_SPEED in config:
             add_idf_sdkconfig_option(f"{SPIRAM_SPEEDS[config[CONF_SPEED]]}", True)
 
+    for tag, placement in config[CONF_PLACEMENT].items():
+        cg.add(set_ram_placement(PLACEMENT_TAGS[tag], placement))
+
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
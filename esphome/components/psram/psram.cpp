@@ -2,6 +2,7 @@
 
 #ifdef USE_ESP32
 
+#include "esphome/core/heap.h"
 #include "esphome/core/log.h"
 
 #include <esp_heap_caps.h>
@@ -24,6 +25,14 @@ void PsramComponent::dump_config() {
     ESP_LOGCONFIG(TAG, "  Size: %d KB", heap_caps_get_total_size(MALLOC_CAP_SPIRAM) / 1024);
   }
 #endif
+  for (uint8_t i = 0; i < HEAP_TAG_COUNT; i++) {
+    const auto tag = static_cast<HeapTag>(i);
+    const RAMPlacementStats stats = get_ram_placement_stats(tag);
+    if (stats.internal == 0 && stats.external == 0)
+      continue;
+    ESP_LOGCONFIG(TAG, "  Buffers of %s: %s, %u B internal, %u B external", heap_tag_to_string(tag),
+                  ram_placement_to_string(get_ram_placement(tag)), stats.internal, stats.external);
+  }
 }
 
 }  // namespace psram
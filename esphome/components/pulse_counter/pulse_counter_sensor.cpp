@@ -1,5 +1,6 @@
 #include "pulse_counter_sensor.h"
 #include "esphome/core/log.h"
+#include "esphome/core/trace.h"
 
 namespace esphome {
 namespace pulse_counter {
@@ -18,6 +19,7 @@ PulseCounterStorageBase *get_storage(bool) { return new BasicPulseCounterStorage
 #endif
 
 void IRAM_ATTR BasicPulseCounterStorage::gpio_intr(BasicPulseCounterStorage *arg) {
+  ESPHOME_TRACE_INSTANT(trace::TRACE_CATEGORY_ISR, "pulse_counter");
   const uint32_t now = micros();
   const bool discard = now - arg->last_pulse < arg->filter_us;
   arg->last_pulse = now;
@@ -1,4 +1,6 @@
 #include "pulse_meter_sensor.h"
+#include <algorithm>
+#include <cinttypes>
 #include <utility>
 #include "esphome/core/log.h"
 
@@ -7,7 +9,18 @@ namespace pulse_meter {
 
 static const char *const TAG = "pulse_meter";
 
+/// Overflows of the edge queue are logged at most this often, in ms.
+static const uint32_t OVERFLOW_REPORT_INTERVAL = 60000;
+
 void PulseMeterSensor::setup() {
+#ifdef PULSE_METER_HAS_PCNT
+  if (this->use_pcnt_) {
+    if (!this->pcnt_setup_())
+      this->mark_failed();
+    return;
+  }
+#endif
+
   this->pin_->setup();
   this->isr_pin_ = pin_->to_isr();
 
@@ -19,20 +32,23 @@ void PulseMeterSensor::setup() {
 }
 
 void PulseMeterSensor::loop() {
-  // Reset the count in get before we pass it back to the ISR as set
-  this->get_->count_ = 0;
-
-  // Swap out set and get to get the latest state from the ISR
-  // The ISR could interrupt on any of these lines and the results would be consistent
-  auto *temp = this->set_;
-  this->set_ = this->get_;
-  this->get_ = temp;
+  uint32_t count = 0;
+  uint32_t last_detected_edge_us = 0;
+#ifdef PULSE_METER_HAS_PCNT
+  if (this->use_pcnt_) {
+    this->read_pcnt_(count, last_detected_edge_us);
+  } else {
+    this->read_edges_(count, last_detected_edge_us);
+  }
+#else
+  this->read_edges_(count, last_detected_edge_us);
+#endif
 
   // Check if we detected a pulse this loop
-  if (this->get_->count_ > 0) {
+  if (count > 0) {
     // Keep a running total of pulses if a total sensor is configured
     if (this->total_sensor_ != nullptr) {
-      this->total_pulses_ += this->get_->count_;
+      this->total_pulses_ += count;
       const uint32_t total = this->total_pulses_;
       this->total_sensor_->publish_state(total);
     }
@@ -41,12 +57,12 @@ void PulseMeterSensor::loop() {
     if (!this->initialized_) {
       this->initialized_ = true;
     } else {
-      uint32_t delta_us = this->get_->last_detected_edge_us_ - this->last_processed_edge_us_;
-      float pulse_width_us = delta_us / float(this->get_->count_);
+      uint32_t delta_us = last_detected_edge_us - this->last_processed_edge_us_;
+      float pulse_width_us = delta_us / float(count);
       this->publish_state((60.0f * 1000000.0f) / pulse_width_us);
     }
 
-    this->last_processed_edge_us_ = this->get_->last_detected_edge_us_;
+    this->last_processed_edge_us_ = last_detected_edge_us;
   }
   // No detected edges this loop
   else {
@@ -61,11 +77,47 @@ void PulseMeterSensor::loop() {
   }
 }
 
+void PulseMeterSensor::read_edges_(uint32_t &count, uint32_t &last_edge_us) {
+  // Drain the edges detected by the ISR since the last loop
+  uint32_t edge_us;
+  while (this->edges_.pop(edge_us)) {
+    last_edge_us = edge_us;
+    count++;
+  }
+
+  // Edges that didn't fit in the queue still count as pulses, and the newest of them may be the newest edge
+  uint32_t overflow_edges, overflow_edge_us;
+  do {
+    overflow_edges = this->overflow_edges_;
+    overflow_edge_us = this->overflow_edge_us_;
+  } while (overflow_edges != this->overflow_edges_);
+  const uint32_t missed = overflow_edges - this->last_overflow_edges_;
+  if (missed != 0) {
+    this->last_overflow_edges_ = overflow_edges;
+    if (count == 0 || int32_t(overflow_edge_us - last_edge_us) > 0)
+      last_edge_us = overflow_edge_us;
+    count += missed;
+    this->overflow_unreported_ += missed;
+  }
+
+  const uint32_t now = millis();
+  if (this->overflow_unreported_ != 0 && now - this->overflow_report_time_ >= OVERFLOW_REPORT_INTERVAL) {
+    ESP_LOGW(TAG, "Pulse queue overflowed, %" PRIu32 " pulses counted without their time", this->overflow_unreported_);
+    this->overflow_unreported_ = 0;
+    this->overflow_report_time_ = now;
+  }
+}
+
 float PulseMeterSensor::get_setup_priority() const { return setup_priority::DATA; }
 
 void PulseMeterSensor::dump_config() {
   LOG_SENSOR("", "Pulse Meter", this);
   LOG_PIN("  Pin: ", this->pin_);
+#ifdef PULSE_METER_HAS_PCNT
+  if (this->use_pcnt_) {
+    ESP_LOGCONFIG(TAG, "  PCNT Unit Number: %u", this->pcnt_unit_);
+  }
+#endif
   if (this->filter_mode_ == FILTER_EDGE) {
     ESP_LOGCONFIG(TAG, "  Filtering rising edges less than %u µs apart", this->filter_us_);
   } else {
@@ -81,8 +133,7 @@ void IRAM_ATTR PulseMeterSensor::edge_intr(PulseMeterSensor *sensor) {
 
   if ((now - sensor->last_edge_candidate_us_) >= sensor->filter_us_) {
     sensor->last_edge_candidate_us_ = now;
-    sensor->set_->last_detected_edge_us_ = now;
-    sensor->set_->count_++;
+    sensor->push_edge_(now);
   }
 }
 
@@ -109,8 +160,7 @@ void IRAM_ATTR PulseMeterSensor::pulse_intr(PulseMeterSensor *sensor) {
       }
       // Low pulse of filter length now rising (therefore last_intr_ was the falling edge)
       else if (sensor->in_pulse_ && !sensor->last_pin_val_) {
-        sensor->set_->last_detected_edge_us_ = sensor->last_edge_candidate_us_;
-        sensor->set_->count_++;
+        sensor->push_edge_(sensor->last_edge_candidate_us_);
         sensor->in_pulse_ = false;
       }
     }
@@ -120,5 +170,96 @@ void IRAM_ATTR PulseMeterSensor::pulse_intr(PulseMeterSensor *sensor) {
   }
 }
 
+#ifdef PULSE_METER_HAS_PCNT
+bool PulseMeterSensor::pcnt_setup_() {
+  // pulse_counter hands out units from the bottom, take them from the top to stay clear of it
+  static int next_pcnt_unit = PCNT_UNIT_MAX - 1;
+  if (next_pcnt_unit < 0) {
+    ESP_LOGE(TAG, "No free PCNT unit");
+    return false;
+  }
+  this->pcnt_unit_ = pcnt_unit_t(next_pcnt_unit--);
+  this->pin_->setup();
+
+  pcnt_config_t pcnt_config = {
+      .pulse_gpio_num = this->pin_->get_pin(),
+      .ctrl_gpio_num = PCNT_PIN_NOT_USED,
+      .lctrl_mode = PCNT_MODE_KEEP,
+      .hctrl_mode = PCNT_MODE_KEEP,
+      .pos_mode = PCNT_COUNT_INC,
+      .neg_mode = PCNT_COUNT_DIS,
+      .counter_h_lim = PCNT_HIGH_LIMIT,
+      .counter_l_lim = 0,
+      .unit = this->pcnt_unit_,
+      .channel = PCNT_CHANNEL_0,
+  };
+  esp_err_t error = pcnt_unit_config(&pcnt_config);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Configuring Pulse Counter failed: %s", esp_err_to_name(error));
+    return false;
+  }
+
+  if (this->filter_us_ != 0) {
+    uint16_t filter_val = std::min(static_cast<unsigned int>(this->filter_us_ * 80u), 1023u);
+    error = pcnt_set_filter_value(this->pcnt_unit_, filter_val);
+    if (error == ESP_OK)
+      error = pcnt_filter_enable(this->pcnt_unit_);
+    if (error != ESP_OK) {
+      ESP_LOGE(TAG, "Setting filter value failed: %s", esp_err_to_name(error));
+      return false;
+    }
+  }
+
+  // Another component may already have installed the shared ISR service
+  error = pcnt_isr_service_install(0);
+  if (error != ESP_OK && error != ESP_ERR_INVALID_STATE) {
+    ESP_LOGE(TAG, "Installing PCNT ISR service failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  error = pcnt_isr_handler_add(this->pcnt_unit_, PulseMeterSensor::pcnt_overflow_intr, this);
+  if (error == ESP_OK)
+    error = pcnt_event_enable(this->pcnt_unit_, PCNT_EVT_H_LIM);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Enabling PCNT overflow interrupt failed: %s", esp_err_to_name(error));
+    return false;
+  }
+
+  pcnt_counter_pause(this->pcnt_unit_);
+  pcnt_counter_clear(this->pcnt_unit_);
+  error = pcnt_counter_resume(this->pcnt_unit_);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Resuming pulse counter failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  return true;
+}
+
+void PulseMeterSensor::read_pcnt_(uint32_t &count, uint32_t &last_edge_us) {
+  // The hardware only counts, so the time of this read stands in for the time of the newest edge.
+  // It lags by at most one loop, which only matters at low pulse rates.
+  const uint32_t now = micros();
+  uint32_t overflows;
+  int16_t value;
+  do {
+    overflows = this->pcnt_overflows_;
+    pcnt_get_counter_value(this->pcnt_unit_, &value);
+  } while (overflows != this->pcnt_overflows_);
+
+  // Right after a wrap the counter can be read before the interrupt counted it, pick it up next loop
+  const uint32_t total = overflows * PCNT_HIGH_LIMIT + value;
+  if (int32_t(total - this->last_pcnt_total_) < 0)
+    return;
+  count = total - this->last_pcnt_total_;
+  this->last_pcnt_total_ = total;
+  if (count > 0)
+    last_edge_us = now;
+}
+
+void IRAM_ATTR PulseMeterSensor::pcnt_overflow_intr(void *arg) {
+  auto *sensor = static_cast<PulseMeterSensor *>(arg);
+  sensor->pcnt_overflows_++;
+}
+#endif
+
 }  // namespace pulse_meter
 }  // namespace esphome
@@ -5,6 +5,11 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 
+#if defined(USE_ESP32) && !defined(USE_ESP32_VARIANT_ESP32C2) && !defined(USE_ESP32_VARIANT_ESP32C3)
+#include <driver/pcnt.h>
+#define PULSE_METER_HAS_PCNT
+#endif
+
 namespace esphome {
 namespace pulse_meter {
 
@@ -21,6 +26,9 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
   void set_total_sensor(sensor::Sensor *sensor) { this->total_sensor_ = sensor; }
   void set_filter_mode(InternalFilterMode mode) { this->filter_mode_ = mode; }
   void set_total_pulses(uint32_t pulses) { this->total_pulses_ = pulses; }
+#ifdef PULSE_METER_HAS_PCNT
+  void set_use_pcnt(bool use_pcnt) { this->use_pcnt_ = use_pcnt; }
+#endif
 
   void setup() override;
   void loop() override;
@@ -30,6 +38,21 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
  protected:
   static void edge_intr(PulseMeterSensor *sensor);
   static void pulse_intr(PulseMeterSensor *sensor);
+  /// Queue an edge from the ISR, one that doesn't fit is only counted.
+  inline void push_edge_(uint32_t edge_us) ALWAYS_INLINE {
+    if (!this->edges_.push(edge_us)) {
+      this->overflow_edge_us_ = edge_us;
+      this->overflow_edges_ = this->overflow_edges_ + 1;
+    }
+  }
+
+  /// Number of edges detected since the last call and the time of the newest one.
+  void read_edges_(uint32_t &count, uint32_t &last_edge_us);
+#ifdef PULSE_METER_HAS_PCNT
+  bool pcnt_setup_();
+  void read_pcnt_(uint32_t &count, uint32_t &last_edge_us);
+  static void pcnt_overflow_intr(void *arg);
+#endif
 
   InternalGPIOPin *pin_{nullptr};
   uint32_t filter_us_ = 0;
@@ -42,18 +65,16 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
   uint32_t total_pulses_ = 0;
   uint32_t last_processed_edge_us_ = 0;
 
-  // This struct (and the two pointers) are used to pass data between the ISR and loop.
-  // These two pointers are exchanged each loop.
-  // Therefore you can't use data in the pointer to loop receives to set values in the pointer to loop sends.
-  // As a result it's easiest if you only use these pointers to send data from the ISR to the loop.
-  // (except for resetting the values)
-  struct State {
-    uint32_t last_detected_edge_us_ = 0;
-    uint32_t count_ = 0;
-  };
-  State state_[2];
-  volatile State *set_ = state_;
-  volatile State *get_ = state_ + 1;
+  uint32_t last_overflow_edges_ = 0;
+  uint32_t overflow_unreported_ = 0;
+  uint32_t overflow_report_time_ = 0;
+
+  // Timestamps of the detected edges, pushed by the ISR and drained in the loop.
+  // At 1 kHz this holds about 64 ms worth of edges.
+  LockFreeQueue<uint32_t, 64> edges_;
+  // Edges that didn't fit in the queue and the time of the newest of them, written by the ISR
+  volatile uint32_t overflow_edges_ = 0;
+  volatile uint32_t overflow_edge_us_ = 0;
 
   // Only use these variables in the ISR
   ISRInternalGPIOPin isr_pin_;
@@ -61,6 +82,15 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
   uint32_t last_intr_ = 0;
   bool in_pulse_ = false;
   bool last_pin_val_ = false;
+
+#ifdef PULSE_METER_HAS_PCNT
+  // The hardware counter counts up to PCNT_HIGH_LIMIT, wraps to 0 and raises an interrupt that counts the wrap
+  static const int16_t PCNT_HIGH_LIMIT = 32000;
+  bool use_pcnt_ = false;
+  pcnt_unit_t pcnt_unit_;
+  volatile uint32_t pcnt_overflows_ = 0;
+  uint32_t last_pcnt_total_ = 0;
+#endif
 };
 
 }  // namespace pulse_meter
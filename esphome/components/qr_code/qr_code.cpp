@@ -27,10 +27,28 @@ void QrCode::generate_qr_code() {
   ESP_LOGV(TAG, "Generating QR code...");
   uint8_t tempbuffer[qrcodegen_BUFFER_LEN_MAX];
 
+  this->spans_.clear();
   if (!qrcodegen_encodeText(this->value_.c_str(), tempbuffer, this->qr_, this->ecc_, qrcodegen_VERSION_MIN,
                             qrcodegen_VERSION_MAX, qrcodegen_Mask_AUTO, true)) {
     ESP_LOGE(TAG, "Failed to generate QR code");
+    return;
   }
+
+  const int size = qrcodegen_getSize(this->qr_);
+  for (int y = 0; y < size; y++) {
+    int x = 0;
+    while (x < size) {
+      if (!qrcodegen_getModule(this->qr_, x, y)) {
+        x++;
+        continue;
+      }
+      const int start = x;
+      while (x < size && qrcodegen_getModule(this->qr_, x, y))
+        x++;
+      this->spans_.push_back(Span{uint8_t(y), uint8_t(start), uint8_t(x - start)});
+    }
+  }
+  this->spans_.shrink_to_fit();
 }
 
 void QrCode::draw(display::Display *buff, uint16_t x_offset, uint16_t y_offset, Color color, int scale) {
@@ -41,14 +59,11 @@ void QrCode::draw(display::Display *buff, uint16_t x_offset, uint16_t y_offset,
     this->needs_update_ = false;
   }
 
-  uint8_t qrcode_width = qrcodegen_getSize(this->qr_);
-
-  for (int y = 0; y < qrcode_width * scale; y++) {
-    for (int x = 0; x < qrcode_width * scale; x++) {
-      if (qrcodegen_getModule(this->qr_, x / scale, y / scale)) {
-        buff->draw_pixel_at(x_offset + x, y_offset + y, color);
-      }
-    }
+  for (const Span &span : this->spans_) {
+    const int x = x_offset + span.x * scale;
+    const int y = y_offset + span.y * scale;
+    for (int row = 0; row < scale; row++)
+      buff->fill_span(x, y + row, span.width * scale, color);
   }
 }
 }  // namespace qr_code
@@ -3,6 +3,7 @@
 #include "esphome/core/color.h"
 
 #include <cstdint>
+#include <vector>
 
 #include "qrcodegen.h"
 
@@ -25,10 +26,19 @@ class QrCode : public Component {
   void generate_qr_code();
 
  protected:
+  /// Horizontal run of dark modules, drawn with a single Display::fill_span() per pixel row.
+  struct Span {
+    uint8_t y;
+    uint8_t x;
+    uint8_t width;
+  };
+
   std::string value_;
   qrcodegen_Ecc ecc_;
   bool needs_update_ = true;
   uint8_t qr_[qrcodegen_BUFFER_LEN_MAX];
+  /// The dark modules of qr_, only recomputed when the value changes.
+  std::vector<Span> spans_;
 };
 }  // namespace qr_code
 }  // namespace esphome
@@ -101,20 +101,29 @@ void RemoteReceiverBase::register_dumper(RemoteReceiverDumperBase *dumper) {
   }
 }
 
+// Shared by all receivers, so a cached decode is never reused for another receiver's frame.
+static uint32_t last_frame_id = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void RemoteReceiverBase::start_frame_() {
+  if (++last_frame_id == 0)
+    last_frame_id = 1;
+  this->frame_id_ = last_frame_id;
+}
+
 void RemoteReceiverBase::call_listeners_() {
   for (auto *listener : this->listeners_)
-    listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_));
+    listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_, this->frame_id_));
 }
 
 void RemoteReceiverBase::call_dumpers_() {
   bool success = false;
   for (auto *dumper : this->dumpers_) {
-    if (dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_)))
+    if (dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->frame_id_)))
       success = true;
   }
   if (!success) {
     for (auto *dumper : this->secondary_dumpers_)
-      dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_));
+      dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->frame_id_));
   }
 }
 
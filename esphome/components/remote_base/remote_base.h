@@ -42,11 +42,13 @@ class RemoteTransmitData {
 
 class RemoteReceiveData {
  public:
-  explicit RemoteReceiveData(const RawTimings &data, uint8_t tolerance)
-      : data_(data), index_(0), tolerance_(tolerance) {}
+  explicit RemoteReceiveData(const RawTimings &data, uint8_t tolerance, uint32_t frame_id = 0)
+      : data_(data), index_(0), tolerance_(tolerance), frame_id_(frame_id) {}
 
   const RawTimings &get_raw_data() const { return this->data_; }
   uint32_t get_index() const { return index_; }
+  /// Identifies the received frame, 0 if the data isn't a frame from a receiver.
+  uint32_t get_frame_id() const { return this->frame_id_; }
   int32_t operator[](uint32_t index) const { return this->data_[index]; }
   int32_t size() const { return this->data_.size(); }
   bool is_valid(uint32_t offset) const { return this->index_ + offset < this->data_.size(); }
@@ -72,6 +74,7 @@ class RemoteReceiveData {
   const RawTimings &data_;
   uint32_t index_;
   uint8_t tolerance_;
+  uint32_t frame_id_;
 };
 
 class RemoteComponentBase {
@@ -158,7 +161,9 @@ class RemoteReceiverBase : public RemoteComponentBase {
  protected:
   void call_listeners_();
   void call_dumpers_();
+  void start_frame_();
   void call_listeners_dumpers_() {
+    this->start_frame_();
     this->call_listeners_();
     this->call_dumpers_();
   }
@@ -168,6 +173,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   RawTimings temp_;
   uint8_t tolerance_;
+  uint32_t frame_id_{0};
 };
 
 class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitiallyOff,
@@ -189,14 +195,27 @@ template<typename T> class RemoteProtocol {
   virtual void dump(const T &data) = 0;
 };
 
+/// Decode src with protocol T at most once per received frame.
+///
+/// All binary sensors, triggers and dumpers of one protocol share the result, so a frame costs one decode per
+/// protocol instead of one per listener.
+template<typename T, typename D> const optional<D> &decode_cached(RemoteReceiveData src) {
+  static uint32_t frame_id = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  static optional<D> result;     // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  if (src.get_frame_id() == 0 || src.get_frame_id() != frame_id) {
+    result = T().decode(src);
+    frame_id = src.get_frame_id();
+  }
+  return result;
+}
+
 template<typename T, typename D> class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    const auto &res = decode_cached<T, D>(src);
     return res.has_value() && *res == this->data_;
   }
 
@@ -210,8 +229,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 template<typename T, typename D> class RemoteReceiverTrigger : public Trigger<D>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    const auto &res = decode_cached<T, D>(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -244,11 +262,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public Action<Ts...
 template<typename T, typename D> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    const auto &decoded = decode_cached<T, D>(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
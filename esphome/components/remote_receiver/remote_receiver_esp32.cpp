@@ -69,26 +69,24 @@ void RemoteReceiverComponent::dump_config() {
 }
 
 void RemoteReceiverComponent::loop() {
+  // Frames that arrived back to back are all handled now instead of one per loop iteration
   size_t len = 0;
-  auto *item = (rmt_item32_t *) xRingbufferReceive(this->ringbuf_, &len, 0);
-  if (item != nullptr) {
+  rmt_item32_t *item;
+  while ((item = (rmt_item32_t *) xRingbufferReceive(this->ringbuf_, &len, 0)) != nullptr) {
     this->decode_rmt_(item, len);
     vRingbufferReturnItem(this->ringbuf_, item);
 
     if (this->temp_.empty())
-      return;
+      continue;
 
     this->temp_.push_back(-this->idle_us_);
     this->call_listeners_dumpers_();
   }
 }
 void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
-  bool prev_level = false;
-  uint32_t prev_length = 0;
-  this->temp_.clear();
-  int32_t multiplier = this->pin_->is_inverted() ? -1 : 1;
   size_t item_count = len / sizeof(rmt_item32_t);
 
+#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
   ESP_LOGVV(TAG, "START:");
   for (size_t i = 0; i < item_count; i++) {
     if (item[i].level0) {
@@ -103,48 +101,38 @@ void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
     }
   }
   ESP_LOGVV(TAG, "\n");
+#endif
 
-  this->temp_.reserve(item_count * 2);  // each RMT item has 2 pulses
-  for (size_t i = 0; i < item_count; i++) {
-    if (item[i].duration0 == 0u) {
-      // Do nothing
-    } else if (bool(item[i].level0) == prev_level) {
-      prev_length += item[i].duration0;
-    } else {
-      if (prev_length > 0) {
-        if (prev_level) {
-          this->temp_.push_back(this->to_microseconds_(prev_length) * multiplier);
-        } else {
-          this->temp_.push_back(-int32_t(this->to_microseconds_(prev_length)) * multiplier);
-        }
-      }
-      prev_level = bool(item[i].level0);
-      prev_length = item[i].duration0;
+  // Each RMT item has 2 pulses and runs of the same level are merged, so this is an upper bound. Writing into the
+  // reused buffer directly converts the frame in a single pass without per-pulse capacity checks.
+  this->temp_.resize(item_count * 2);
+  int32_t *out = this->temp_.data();
+  const int32_t multiplier = this->pin_->is_inverted() ? -1 : 1;
+  bool prev_level = false;
+  uint32_t prev_length = 0;
+  auto add_pulse = [&](bool level, uint32_t duration) {
+    if (duration == 0u)
+      return;
+    if (level == prev_level) {
+      prev_length += duration;
+      return;
     }
-
-    if (item[i].duration1 == 0u) {
-      // Do nothing
-    } else if (bool(item[i].level1) == prev_level) {
-      prev_length += item[i].duration1;
-    } else {
-      if (prev_length > 0) {
-        if (prev_level) {
-          this->temp_.push_back(this->to_microseconds_(prev_length) * multiplier);
-        } else {
-          this->temp_.push_back(-int32_t(this->to_microseconds_(prev_length)) * multiplier);
-        }
-      }
-      prev_level = bool(item[i].level1);
-      prev_length = item[i].duration1;
+    if (prev_length > 0) {
+      int32_t value = this->to_microseconds_(prev_length);
+      *out++ = (prev_level ? value : -value) * multiplier;
     }
+    prev_level = level;
+    prev_length = duration;
+  };
+  for (size_t i = 0; i < item_count; i++) {
+    add_pulse(item[i].level0, item[i].duration0);
+    add_pulse(item[i].level1, item[i].duration1);
   }
   if (prev_length > 0) {
-    if (prev_level) {
-      this->temp_.push_back(this->to_microseconds_(prev_length) * multiplier);
-    } else {
-      this->temp_.push_back(-int32_t(this->to_microseconds_(prev_length)) * multiplier);
-    }
+    int32_t value = this->to_microseconds_(prev_length);
+    *out++ = (prev_level ? value : -value) * multiplier;
   }
+  this->temp_.resize(out - this->temp_.data());
 }
 
 }  // namespace remote_receiver
@@ -45,6 +45,8 @@ class RemoteTransmitterComponent : public remote_base::RemoteTransmitterBase,
   uint32_t current_carrier_frequency_{UINT32_MAX};
   bool initialized_{false};
   std::vector<rmt_item32_t> rmt_temp_;
+  /// The timings rmt_temp_ was converted from
+  remote_base::RawTimings rmt_source_;
   esp_err_t error_code_{ESP_OK};
   bool inverted_{false};
 #endif
@@ -80,37 +80,41 @@ void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t sen
     this->configure_rmt_();
   }
 
-  this->rmt_temp_.clear();
-  this->rmt_temp_.reserve((this->temp_.get_data().size() + 1) / 2);
-  uint32_t rmt_i = 0;
-  rmt_item32_t rmt_item;
-
-  for (int32_t val : this->temp_.get_data()) {
-    bool level = val >= 0;
-    if (!level)
-      val = -val;
-    val = this->from_microseconds_(static_cast<uint32_t>(val));
-
-    do {
-      int32_t item = std::min(val, int32_t(32767));
-      val -= item;
-
-      if (rmt_i % 2 == 0) {
-        rmt_item.level0 = static_cast<uint32_t>(level ^ this->inverted_);
-        rmt_item.duration0 = static_cast<uint32_t>(item);
-      } else {
-        rmt_item.level1 = static_cast<uint32_t>(level ^ this->inverted_);
-        rmt_item.duration1 = static_cast<uint32_t>(item);
-        this->rmt_temp_.push_back(rmt_item);
-      }
-      rmt_i++;
-    } while (val != 0);
-  }
+  // Climate and repeated button presses often send exactly the same timings again, reuse the RMT items then
+  if (this->rmt_source_ != this->temp_.get_data()) {
+    this->rmt_source_ = this->temp_.get_data();
+    this->rmt_temp_.clear();
+    this->rmt_temp_.reserve((this->temp_.get_data().size() + 1) / 2);
+    uint32_t rmt_i = 0;
+    rmt_item32_t rmt_item;
+
+    for (int32_t val : this->temp_.get_data()) {
+      bool level = val >= 0;
+      if (!level)
+        val = -val;
+      val = this->from_microseconds_(static_cast<uint32_t>(val));
+
+      do {
+        int32_t item = std::min(val, int32_t(32767));
+        val -= item;
+
+        if (rmt_i % 2 == 0) {
+          rmt_item.level0 = static_cast<uint32_t>(level ^ this->inverted_);
+          rmt_item.duration0 = static_cast<uint32_t>(item);
+        } else {
+          rmt_item.level1 = static_cast<uint32_t>(level ^ this->inverted_);
+          rmt_item.duration1 = static_cast<uint32_t>(item);
+          this->rmt_temp_.push_back(rmt_item);
+        }
+        rmt_i++;
+      } while (val != 0);
+    }
 
-  if (rmt_i % 2 == 1) {
-    rmt_item.level1 = 0;
-    rmt_item.duration1 = 0;
-    this->rmt_temp_.push_back(rmt_item);
+    if (rmt_i % 2 == 1) {
+      rmt_item.level1 = 0;
+      rmt_item.duration1 = 0;
+      this->rmt_temp_.push_back(rmt_item);
+    }
   }
 
   if ((this->rmt_temp_.data() == nullptr) || this->rmt_temp_.empty()) {
@@ -1,4 +1,7 @@
 #include "rotary_encoder.h"
+
+#include <cinttypes>
+
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
@@ -104,19 +107,12 @@ void IRAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensorStore
   }
 
   if (rotation_dir != 0 && !arg->first_read) {
-    auto *first_zero = std::find(arg->rotation_events.begin(), arg->rotation_events.end(), 0);  // find first zero
-    if (first_zero == arg->rotation_events.begin()  // are we at the start (first event this loop iteration)
-        || std::signbit(*std::prev(first_zero)) !=
-               std::signbit(rotation_dir)  // or is the last stored event the wrong direction
-        || *std::prev(first_zero) == std::numeric_limits<int8_t>::lowest()  // or the last event slot is full (negative)
-        || *std::prev(first_zero) == std::numeric_limits<int8_t>::max()) {  // or the last event slot is full (positive)
-      if (first_zero != arg->rotation_events.end()) {                       // we have a free rotation slot
-        *first_zero += rotation_dir;                                        // store the rotation into a new slot
-      } else {
-        arg->rotation_events_overflow = true;
-      }
+    const uint32_t head = arg->events_head.load(std::memory_order_relaxed);
+    if (head - arg->events_tail.load(std::memory_order_acquire) < RotaryEncoderSensorStore::EVENT_RING_SIZE) {
+      arg->events[head % RotaryEncoderSensorStore::EVENT_RING_SIZE] = rotation_dir;
+      arg->events_head.store(head + 1, std::memory_order_release);
     } else {
-      *std::prev(first_zero) += rotation_dir;  // store the rotation into the previous slot
+      arg->events_dropped = arg->events_dropped + 1;
     }
   }
   arg->first_read = false;
@@ -144,6 +140,8 @@ void RotaryEncoderSensor::setup() {
   this->store_.counter = initial_value;
   this->store_.last_read = initial_value;
 
+  this->last_velocity_counter_ = initial_value;
+
   this->pin_a_->setup();
   this->store_.pin_a = this->pin_a_->to_isr();
   this->pin_b_->setup();
@@ -153,14 +151,141 @@ void RotaryEncoderSensor::setup() {
     this->pin_i_->setup();
   }
 
+#ifdef HAS_PCNT
+  if (this->use_pcnt_) {
+    if (!this->setup_pcnt_())
+      this->mark_failed();
+    return;
+  }
+#endif
   this->pin_a_->attach_interrupt(RotaryEncoderSensorStore::gpio_intr, &this->store_, gpio::INTERRUPT_ANY_EDGE);
   this->pin_b_->attach_interrupt(RotaryEncoderSensorStore::gpio_intr, &this->store_, gpio::INTERRUPT_ANY_EDGE);
 }
+
+#ifdef HAS_PCNT
+bool RotaryEncoderSensor::setup_pcnt_() {
+  // pulse_counter hands out units from the first one up, so take them from the last one down
+  static int next_pcnt_unit = PCNT_UNIT_MAX - 1;
+  if (next_pcnt_unit < PCNT_UNIT_0) {
+    ESP_LOGE(TAG, "No PCNT unit left");
+    return false;
+  }
+  this->pcnt_unit_ = pcnt_unit_t(next_pcnt_unit--);
+
+  // Full quadrature decoding, every edge of either pin counts, with the other pin giving the direction. Moving
+  // clockwise means A leads B, which counts up like the interrupt based decoder does.
+  pcnt_config_t pcnt_config = {
+      .pulse_gpio_num = this->pin_a_->get_pin(),
+      .ctrl_gpio_num = this->pin_b_->get_pin(),
+      .lctrl_mode = PCNT_MODE_KEEP,
+      .hctrl_mode = PCNT_MODE_REVERSE,
+      .pos_mode = PCNT_COUNT_INC,
+      .neg_mode = PCNT_COUNT_DEC,
+      .counter_h_lim = INT16_MAX,
+      .counter_l_lim = INT16_MIN,
+      .unit = this->pcnt_unit_,
+      .channel = PCNT_CHANNEL_0,
+  };
+  esp_err_t error = pcnt_unit_config(&pcnt_config);
+  if (error == ESP_OK) {
+    pcnt_config.pulse_gpio_num = this->pin_b_->get_pin();
+    pcnt_config.ctrl_gpio_num = this->pin_a_->get_pin();
+    pcnt_config.pos_mode = PCNT_COUNT_DEC;
+    pcnt_config.neg_mode = PCNT_COUNT_INC;
+    pcnt_config.channel = PCNT_CHANNEL_1;
+    error = pcnt_unit_config(&pcnt_config);
+  }
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Configuring PCNT unit %u failed: %s", this->pcnt_unit_, esp_err_to_name(error));
+    return false;
+  }
+  // Ignore contact bounce shorter than about 12us (1023 APB cycles, the longest the filter takes)
+  pcnt_set_filter_value(this->pcnt_unit_, 1023);
+  pcnt_filter_enable(this->pcnt_unit_);
+  pcnt_counter_pause(this->pcnt_unit_);
+  pcnt_counter_clear(this->pcnt_unit_);
+  pcnt_counter_resume(this->pcnt_unit_);
+  return true;
+}
+
+void RotaryEncoderSensor::read_pcnt_() {
+  int16_t value;
+  if (pcnt_get_counter_value(this->pcnt_unit_, &value) != ESP_OK)
+    return;
+  // The hardware counts four times per cycle and wraps around at its limits, a loop iteration never sees half of that
+  this->pcnt_remainder_ += int16_t(value - this->pcnt_last_);
+  this->pcnt_last_ = value;
+  int32_t per_step = 4;
+  if (this->store_.resolution == ROTARY_ENCODER_2_PULSES_PER_CYCLE) {
+    per_step = 2;
+  } else if (this->store_.resolution == ROTARY_ENCODER_4_PULSES_PER_CYCLE) {
+    per_step = 1;
+  }
+  const int32_t steps = this->pcnt_remainder_ / per_step;
+  this->pcnt_remainder_ -= steps * per_step;
+  this->apply_steps_(steps);
+}
+#endif
+
+void RotaryEncoderSensor::apply_steps_(int32_t steps) {
+  const int32_t counter = this->store_.counter;
+  this->store_.counter = clamp<int64_t>(int64_t(counter) + steps, this->store_.min_value, this->store_.max_value);
+  for (; steps > 0; steps--)
+    this->on_clockwise_callback_.call();
+  for (; steps < 0; steps++)
+    this->on_anticlockwise_callback_.call();
+}
+
+void RotaryEncoderSensor::process_events_() {
+  // Everything the interrupt recorded since the previous loop iteration, in one go
+  const uint32_t head = this->store_.events_head.load(std::memory_order_acquire);
+  uint32_t tail = this->store_.events_tail.load(std::memory_order_relaxed);
+  for (; tail != head; tail++) {
+    if (this->store_.events[tail % RotaryEncoderSensorStore::EVENT_RING_SIZE] > 0) {
+      this->on_clockwise_callback_.call();
+    } else {
+      this->on_anticlockwise_callback_.call();
+    }
+  }
+  this->store_.events_tail.store(tail, std::memory_order_release);
+
+  const uint32_t dropped = this->store_.events_dropped;
+  if (dropped != this->last_dropped_) {
+    ESP_LOGW(TAG, "Missed %" PRIu32 " rotation events, the loop didn't keep up", dropped - this->last_dropped_);
+    this->last_dropped_ = dropped;
+  }
+}
+
+void RotaryEncoderSensor::update_velocity_() {
+  const uint32_t now = millis();
+  const uint32_t elapsed = now - this->last_velocity_time_;
+  if (elapsed < VELOCITY_WINDOW_MS)
+    return;
+  const int32_t counter = this->store_.counter;
+  const float velocity = (counter - this->last_velocity_counter_) * 1000.0f / elapsed;
+  const float acceleration = (velocity - this->last_velocity_) * 1000.0f / elapsed;
+  this->last_velocity_time_ = now;
+  this->last_velocity_counter_ = counter;
+  // Only publish while something changes, and once more when it comes to rest
+  if (velocity == this->last_velocity_ && velocity == 0.0f)
+    return;
+  this->last_velocity_ = velocity;
+  if (this->velocity_sensor_ != nullptr)
+    this->velocity_sensor_->publish_state(velocity);
+  if (this->acceleration_sensor_ != nullptr)
+    this->acceleration_sensor_->publish_state(acceleration);
+}
 void RotaryEncoderSensor::dump_config() {
   LOG_SENSOR("", "Rotary Encoder", this);
   LOG_PIN("  Pin A: ", this->pin_a_);
   LOG_PIN("  Pin B: ", this->pin_b_);
   LOG_PIN("  Pin I: ", this->pin_i_);
+#ifdef HAS_PCNT
+  if (this->use_pcnt_)
+    ESP_LOGCONFIG(TAG, "  PCNT Unit Number: %u", this->pcnt_unit_);
+#endif
+  LOG_SENSOR("  ", "Velocity", this->velocity_sensor_);
+  LOG_SENSOR("  ", "Acceleration", this->acceleration_sensor_);
 
   const LogString *restore_mode = LOG_STR("");
   switch (this->restore_mode_) {
@@ -186,35 +311,15 @@ void RotaryEncoderSensor::dump_config() {
   }
 }
 void RotaryEncoderSensor::loop() {
-  std::array<int8_t, 8> rotation_events;
-  bool rotation_events_overflow;
-  {
-    InterruptLock lock;
-    rotation_events = this->store_.rotation_events;
-    rotation_events_overflow = this->store_.rotation_events_overflow;
-
-    this->store_.rotation_events.fill(0);
-    this->store_.rotation_events_overflow = false;
-  }
-
-  if (rotation_events_overflow) {
-    ESP_LOGW(TAG, "Captured more rotation events than expected");
-  }
-
-  for (auto events : rotation_events) {
-    if (events == 0)  // we are at the end of the recorded events
-      break;
-
-    if (events > 0) {
-      while (events--) {
-        this->on_clockwise_callback_.call();
-      }
-    } else {
-      while (events++) {
-        this->on_anticlockwise_callback_.call();
-      }
-    }
+#ifdef HAS_PCNT
+  if (this->use_pcnt_) {
+    this->read_pcnt_();
+  } else {
+    this->process_events_();
   }
+#else
+  this->process_events_();
+#endif
 
   if (this->pin_i_ != nullptr && this->pin_i_->digital_read()) {
     this->store_.counter = 0;
@@ -228,6 +333,8 @@ void RotaryEncoderSensor::loop() {
     this->publish_state(counter);
     this->publish_initial_value_ = false;
   }
+  if (this->velocity_sensor_ != nullptr || this->acceleration_sensor_ != nullptr)
+    this->update_velocity_();
 }
 
 float RotaryEncoderSensor::get_setup_priority() const { return setup_priority::DATA; }
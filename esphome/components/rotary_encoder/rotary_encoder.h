@@ -1,12 +1,18 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/automation.h"
 #include "esphome/components/sensor/sensor.h"
 
+#if defined(USE_ESP32) && !defined(USE_ESP32_VARIANT_ESP32C3)
+#include <driver/pcnt.h>
+#define HAS_PCNT
+#endif
+
 namespace esphome {
 namespace rotary_encoder {
 
@@ -36,8 +42,16 @@ struct RotaryEncoderSensorStore {
   uint8_t state{0};
   bool first_read{true};
 
-  std::array<int8_t, 8> rotation_events{};
-  bool rotation_events_overflow{false};
+  /** Steps for the clockwise and anticlockwise triggers, +1 or -1 each, in the order they happened.
+   *
+   * A single producer ring: only the interrupt writes the slots and `events_head`, only the loop writes `events_tail`,
+   * so neither side needs a lock. When the loop doesn't keep up, further steps still count but don't trigger.
+   */
+  static const uint32_t EVENT_RING_SIZE = 64;  // power of two, so the indices can wrap around
+  std::array<int8_t, EVENT_RING_SIZE> events{};
+  std::atomic<uint32_t> events_head{0};
+  std::atomic<uint32_t> events_tail{0};
+  volatile uint32_t events_dropped{0};
 
   static void gpio_intr(RotaryEncoderSensorStore *arg);
 };
@@ -75,6 +89,15 @@ class RotaryEncoderSensor : public sensor::Sensor, public Component {
   void set_min_value(int32_t min_value);
   void set_max_value(int32_t max_value);
   void set_publish_initial_value(bool publish_initial_value) { publish_initial_value_ = publish_initial_value; }
+  /// Publish the speed of the counter in steps per second and its change per second.
+  void set_velocity_sensor(sensor::Sensor *velocity_sensor) { this->velocity_sensor_ = velocity_sensor; }
+  void set_acceleration_sensor(sensor::Sensor *acceleration_sensor) {
+    this->acceleration_sensor_ = acceleration_sensor;
+  }
+#ifdef HAS_PCNT
+  /// Decode the quadrature signal with a hardware pulse counter instead of an interrupt per edge.
+  void set_use_pcnt(bool use_pcnt) { this->use_pcnt_ = use_pcnt; }
+#endif
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -100,7 +123,33 @@ class RotaryEncoderSensor : public sensor::Sensor, public Component {
   ESPPreferenceObject rtc_;
   RotaryEncoderRestoreMode restore_mode_{ROTARY_ENCODER_RESTORE_DEFAULT_ZERO};
 
+  /// Velocity and acceleration are worked out over this window, shorter ones are mostly noise from the detents.
+  static const uint32_t VELOCITY_WINDOW_MS = 100;
+
+  void process_events_();
+  /// Apply steps counted outside of the interrupt to the counter and the triggers.
+  void apply_steps_(int32_t steps);
+  void update_velocity_();
+#ifdef HAS_PCNT
+  bool setup_pcnt_();
+  void read_pcnt_();
+#endif
+
   RotaryEncoderSensorStore store_{};
+  uint32_t last_dropped_{0};
+
+  sensor::Sensor *velocity_sensor_{nullptr};
+  sensor::Sensor *acceleration_sensor_{nullptr};
+  uint32_t last_velocity_time_{0};
+  int32_t last_velocity_counter_{0};
+  float last_velocity_{0.0f};
+#ifdef HAS_PCNT
+  bool use_pcnt_{false};
+  pcnt_unit_t pcnt_unit_;
+  int16_t pcnt_last_{0};
+  /// Hardware counts not yet worth a whole step at the configured resolution.
+  int32_t pcnt_remainder_{0};
+#endif
 
   CallbackManager<void()> on_clockwise_callback_;
   CallbackManager<void()> on_anticlockwise_callback_;
@@ -2,6 +2,8 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins, automation
 from esphome.components import sensor
+from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import VARIANT_ESP32C3
 from esphome.const import (
     CONF_ID,
     CONF_RESOLUTION,
@@ -14,7 +16,10 @@ from esphome.const import (
     CONF_PIN_B,
     CONF_TRIGGER_ID,
     CONF_RESTORE_MODE,
+    CONF_ACCELERATION,
+    STATE_CLASS_MEASUREMENT,
 )
+from esphome.core import CORE
 
 rotary_encoder_ns = cg.esphome_ns.namespace("rotary_encoder")
 
@@ -35,6 +40,11 @@ CONF_PIN_RESET = "pin_reset"
 CONF_ON_CLOCKWISE = "on_clockwise"
 CONF_ON_ANTICLOCKWISE = "on_anticlockwise"
 CONF_PUBLISH_INITIAL_VALUE = "publish_initial_value"
+CONF_USE_PCNT = "use_pcnt"
+CONF_VELOCITY = "velocity"
+
+UNIT_STEPS_PER_SECOND = "steps/s"
+UNIT_STEPS_PER_SECOND_SQUARED = "steps/s²"
 
 RotaryEncoderSensor = rotary_encoder_ns.class_(
     "RotaryEncoderSensor", sensor.Sensor, cg.Component
@@ -62,6 +72,17 @@ def validate_min_max_value(config):
     return config
 
 
+def validate_use_pcnt(config):
+    if config[CONF_USE_PCNT] and (
+        not CORE.is_esp32 or get_esp32_variant() == VARIANT_ESP32C3
+    ):
+        raise cv.Invalid(
+            "Using hardware PCNT is only available on ESP32 variants that have it",
+            [CONF_USE_PCNT],
+        )
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     sensor.sensor_schema(
         RotaryEncoderSensor,
@@ -78,6 +99,17 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_MIN_VALUE): cv.int_,
             cv.Optional(CONF_MAX_VALUE): cv.int_,
             cv.Optional(CONF_PUBLISH_INITIAL_VALUE, default=False): cv.boolean,
+            cv.Optional(CONF_USE_PCNT, default=False): cv.boolean,
+            cv.Optional(CONF_VELOCITY): sensor.sensor_schema(
+                unit_of_measurement=UNIT_STEPS_PER_SECOND,
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
+            cv.Optional(CONF_ACCELERATION): sensor.sensor_schema(
+                unit_of_measurement=UNIT_STEPS_PER_SECOND_SQUARED,
+                accuracy_decimals=1,
+                state_class=STATE_CLASS_MEASUREMENT,
+            ),
             cv.Optional(CONF_RESTORE_MODE, default="RESTORE_DEFAULT_ZERO"): cv.enum(
                 RESTORE_MODES, upper=True, space="_"
             ),
@@ -99,6 +131,7 @@ CONFIG_SCHEMA = cv.All(
     )
     .extend(cv.COMPONENT_SCHEMA),
     validate_min_max_value,
+    validate_use_pcnt,
 )
 
 
@@ -121,6 +154,14 @@ async def to_code(config):
         cg.add(var.set_min_value(config[CONF_MIN_VALUE]))
     if CONF_MAX_VALUE in config:
         cg.add(var.set_max_value(config[CONF_MAX_VALUE]))
+    if config[CONF_USE_PCNT]:
+        cg.add(var.set_use_pcnt(True))
+    if CONF_VELOCITY in config:
+        sens = await sensor.new_sensor(config[CONF_VELOCITY])
+        cg.add(var.set_velocity_sensor(sens))
+    if CONF_ACCELERATION in config:
+        sens = await sensor.new_sensor(config[CONF_ACCELERATION])
+        cg.add(var.set_acceleration_sensor(sens))
 
     for conf in config.get(CONF_ON_CLOCKWISE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
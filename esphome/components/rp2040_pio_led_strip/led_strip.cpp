@@ -6,6 +6,8 @@
 #include "esphome/core/log.h"
 
 #include <hardware/clocks.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
 #include <hardware/pio.h>
 #include <pico/stdlib.h>
 
@@ -14,12 +16,32 @@ namespace rp2040_pio_led_strip {
 
 static const char *TAG = "rp2040_pio_led_strip";
 
+/// Shifting out the up to 8 words left in the joined FIFO when DMA completes, plus the reset time of the strips.
+static const uint32_t LATCH_TIME_US = 8 * 40 + 300;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+/// Set by the DMA interrupt when the transfer on a channel completed, with the time it did.
+static volatile bool dma_done[NUM_DMA_CHANNELS];
+static volatile uint32_t dma_done_time[NUM_DMA_CHANNELS];
+static bool dma_irq_installed = false;
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+void RP2040PIOLEDStripLightOutput::dma_irq_handler() {
+  for (uint chan = 0; chan < NUM_DMA_CHANNELS; chan++) {
+    if (!dma_channel_get_irq0_status(chan) || !dma_channel_is_claimed(chan))
+      continue;
+    dma_channel_acknowledge_irq0(chan);
+    dma_done_time[chan] = time_us_32();
+    dma_done[chan] = true;
+  }
+}
+
 void RP2040PIOLEDStripLightOutput::setup() {
   ESP_LOGCONFIG(TAG, "Setting up RP2040 LED Strip...");
 
   size_t buffer_size = this->get_buffer_size_();
 
-  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  ExternalRAMAllocator<uint8_t> allocator(HeapTag::LIGHT, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   this->buf_ = allocator.allocate(buffer_size);
   if (this->buf_ == nullptr) {
     ESP_LOGE(TAG, "Failed to allocate buffer of size %u", buffer_size);
@@ -34,8 +56,14 @@ void RP2040PIOLEDStripLightOutput::setup() {
     return;
   }
 
-  // Select PIO instance to use (0 or 1)
-  this->pio_ = pio0;
+  this->dma_buf_ = allocator.allocate(this->num_leds_ * sizeof(uint32_t));
+  if (this->dma_buf_ == nullptr) {
+    ESP_LOGE(TAG, "Failed to allocate DMA buffer of size %u", this->num_leds_ * sizeof(uint32_t));
+    this->mark_failed();
+    return;
+  }
+
+  // The PIO instance (0 or 1) was selected by set_pio()
   if (this->pio_ == nullptr) {
     ESP_LOGE(TAG, "Failed to claim PIO instance");
     this->mark_failed();
@@ -53,6 +81,40 @@ void RP2040PIOLEDStripLightOutput::setup() {
     return;
   }
   this->init_(this->pio_, this->sm_, offset, this->pin_, this->max_refresh_rate_);
+
+  this->dma_chan_ = dma_claim_unused_channel(false);
+  if (this->dma_chan_ < 0) {
+    ESP_LOGE(TAG, "Failed to claim DMA channel");
+    this->mark_failed();
+    return;
+  }
+  // Words from the buffer to the TX FIFO of the state machine, paced by its data request
+  dma_channel_config config = dma_channel_get_default_config(this->dma_chan_);
+  channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+  channel_config_set_read_increment(&config, true);
+  channel_config_set_write_increment(&config, false);
+  channel_config_set_dreq(&config, pio_get_dreq(this->pio_, this->sm_, true));
+  dma_channel_configure(this->dma_chan_, &config, &this->pio_->txf[this->sm_], this->dma_buf_, this->num_leds_,
+                        false);
+
+  dma_done[this->dma_chan_] = true;
+  dma_done_time[this->dma_chan_] = time_us_32() - LATCH_TIME_US;
+  // Shared with the other strips and whatever else uses DMA_IRQ_0
+  if (!dma_irq_installed) {
+    irq_add_shared_handler(DMA_IRQ_0, dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    dma_irq_installed = true;
+  }
+  dma_channel_set_irq0_enabled(this->dma_chan_, true);
+}
+
+void RP2040PIOLEDStripLightOutput::loop() {
+  if (this->pending_ && this->is_ready_())
+    this->transmit_();
+}
+
+bool RP2040PIOLEDStripLightOutput::is_ready_() const {
+  return dma_done[this->dma_chan_] && time_us_32() - dma_done_time[this->dma_chan_] >= LATCH_TIME_US;
 }
 
 void RP2040PIOLEDStripLightOutput::write_state(light::LightState *state) {
@@ -68,15 +130,26 @@ void RP2040PIOLEDStripLightOutput::write_state(light::LightState *state) {
     return;
   }
 
+  // The previous frame is still being sent, send this one from loop() once it is out
+  if (!this->is_ready_()) {
+    this->pending_ = true;
+    return;
+  }
+  this->transmit_();
+}
+
+void RP2040PIOLEDStripLightOutput::transmit_() {
+  this->pending_ = false;
   // assemble bits in buffer to 32 bit words with ex for GBR: 0bGGGGGGGGRRRRRRRRBBBBBBBB00000000
-  for (int i = 0; i < this->num_leds_; i++) {
-    uint8_t c1 = this->buf_[(i * 3) + 0];
-    uint8_t c2 = this->buf_[(i * 3) + 1];
-    uint8_t c3 = this->buf_[(i * 3) + 2];
-    uint8_t w = this->is_rgbw_ ? this->buf_[(i * 4) + 3] : 0;
-    uint32_t color = encode_uint32(c1, c2, c3, w);
-    pio_sm_put_blocking(this->pio_, this->sm_, color);
+  const uint8_t multiplier = this->is_rgbw_ ? 4 : 3;
+  const uint8_t *pixel = this->buf_;
+  for (uint32_t i = 0; i < this->num_leds_; i++, pixel += multiplier) {
+    uint8_t w = this->is_rgbw_ ? pixel[3] : 0;
+    this->dma_buf_[i] = encode_uint32(pixel[0], pixel[1], pixel[2], w);
   }
+  dma_done[this->dma_chan_] = false;
+  // Runs in the background, the loop goes on while the state machine shifts the words out
+  dma_channel_set_read_addr(this->dma_chan_, this->dma_buf_, true);
 }
 
 light::ESPColorView RP2040PIOLEDStripLightOutput::get_view_internal(int32_t index) const {
@@ -49,6 +49,7 @@ using init_fn = void (*)(PIO pio, uint sm, uint offset, uint pin, float freq);
 class RP2040PIOLEDStripLightOutput : public light::AddressableLight {
  public:
   void setup() override;
+  void loop() override;
   void write_state(light::LightState *state) override;
   float get_setup_priority() const override;
 
@@ -82,9 +83,19 @@ class RP2040PIOLEDStripLightOutput : public light::AddressableLight {
   light::ESPColorView get_view_internal(int32_t index) const override;
 
   size_t get_buffer_size_() const { return this->num_leds_ * (3 + this->is_rgbw_); }
+  /// Whether the previous frame is out and the strip latched it, so the next one can start.
+  bool is_ready_() const;
+  /// Encode the pixels into the DMA buffer and start the transfer to the PIO.
+  void transmit_();
+  static void dma_irq_handler();
 
   uint8_t *buf_{nullptr};
   uint8_t *effect_data_{nullptr};
+  /// One word per LED as the PIO program pulls them, read by DMA while the effects change buf_.
+  uint32_t *dma_buf_{nullptr};
+  int dma_chan_{-1};
+  /// A write_state() that came while the previous frame was still being sent.
+  bool pending_{false};
 
   uint8_t pin_;
   uint32_t num_leds_;
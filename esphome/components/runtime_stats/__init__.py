@@ -0,0 +1,27 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+DEPENDENCIES = ["logger"]
+
+CONF_LOG_TOP = "log_top"
+CONF_RUNTIME_STATS_ID = "runtime_stats_id"
+
+runtime_stats_ns = cg.esphome_ns.namespace("runtime_stats")
+RuntimeStatsComponent = runtime_stats_ns.class_(
+    "RuntimeStatsComponent", cg.PollingComponent
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(RuntimeStatsComponent),
+        cv.Optional(CONF_LOG_TOP, default=5): cv.int_range(min=0, max=255),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_log_top(config[CONF_LOG_TOP]))
+    cg.add_define("USE_RUNTIME_STATS")
@@ -0,0 +1,152 @@
+#include "runtime_stats.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace esphome {
+namespace runtime_stats {
+
+static const char *const TAG = "runtime_stats";
+
+RuntimeStatsComponent *global_runtime_stats = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void DurationHistogram::reset() {
+  for (auto &bucket : this->buckets_)
+    bucket = 0;
+  this->count_ = 0;
+  this->total_us_ = 0;
+  this->max_us_ = 0;
+  this->reset_window();
+}
+
+RuntimeStatsComponent::RuntimeStatsComponent() { global_runtime_stats = this; }
+
+void RuntimeStatsComponent::setup() { this->last_loop_started_us_ = micros(); }
+
+void RuntimeStatsComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Runtime Stats:");
+  LOG_UPDATE_INTERVAL(this);
+  ESP_LOGCONFIG(TAG, "  Log Top Components: %u", this->log_top_);
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Loop Active Time", this->active_time_sensor_);
+  LOG_SENSOR("  ", "Loop Jitter", this->jitter_sensor_);
+  LOG_SENSOR("  ", "Loop Load", this->load_sensor_);
+#endif
+}
+
+float RuntimeStatsComponent::get_setup_priority() const { return setup_priority::LATE; }
+
+ComponentStats *RuntimeStatsComponent::add_component_(Component *component) {
+  auto *stats = new ComponentStats();  // NOLINT(cppcoreguidelines-owning-memory)
+  stats->component = component;
+  component->set_runtime_stats(stats);
+  this->components_.push_back(stats);
+  return stats;
+}
+
+void RuntimeStatsComponent::record_scheduled(Component *component, const std::string &name, uint32_t id,
+                                             uint32_t duration_us) {
+  if (component != nullptr) {
+    ComponentStats *stats = component->get_runtime_stats();
+    if (stats == nullptr)
+      stats = this->add_component_(component);
+    stats->scheduled.record(duration_us);
+  }
+
+  // Anonymous items can't be told apart, they are only accounted for in the component totals
+  if (id == 0 && name.empty())
+    return;
+
+  for (auto *item : this->scheduled_) {
+    if (item->component == component && item->id == id && item->name == name) {
+      item->histogram.record(duration_us);
+      return;
+    }
+  }
+  auto *item = new ScheduledItemStats();  // NOLINT(cppcoreguidelines-owning-memory)
+  item->component = component;
+  item->name = name;
+  item->id = id;
+  item->histogram.record(duration_us);
+  this->scheduled_.push_back(item);
+}
+
+void RuntimeStatsComponent::record_app_loop(uint32_t started_us, uint32_t active_us) {
+  const uint32_t period_us = started_us - this->last_loop_started_us_;
+  this->last_loop_started_us_ = started_us;
+
+  this->app_loop_.record(active_us);
+  this->window_period_us_ += period_us;
+
+  const uint32_t target_us = HighFrequencyLoopRequester::is_high_frequency() ? 0 : App.get_loop_interval() * 1000;
+  this->jitter_.record(period_us > target_us ? period_us - target_us : 0);
+}
+
+void RuntimeStatsComponent::update() {
+#ifdef USE_SENSOR
+  if (this->active_time_sensor_ != nullptr)
+    this->active_time_sensor_->publish_state(this->app_loop_.get_window_max_us() / 1000.0f);
+  if (this->jitter_sensor_ != nullptr)
+    this->jitter_sensor_->publish_state(this->jitter_.get_window_max_us() / 1000.0f);
+  if (this->load_sensor_ != nullptr && this->window_period_us_ != 0)
+    this->load_sensor_->publish_state(this->app_loop_.get_window_total_us() * 100.0f / this->window_period_us_);
+  if (this->deferred_sensor_ != nullptr)
+    this->deferred_sensor_->publish_state(this->window_deferred_);
+#endif
+
+  if (this->window_deferred_ != 0) {
+    ESP_LOGD(TAG, "Deferred by the loop budget since last update: %" PRIu32, this->window_deferred_);
+    for (auto *stats : this->components_) {
+      if (stats->window_deferred != 0)
+        ESP_LOGD(TAG, "  %s: %" PRIu32, stats->component->get_component_source(), stats->window_deferred);
+    }
+  }
+
+  if (this->log_top_ != 0 && !this->components_.empty()) {
+    std::vector<ComponentStats *> sorted = this->components_;
+    auto window_total = [](const ComponentStats *stats) {
+      return stats->loop.get_window_total_us() + stats->scheduled.get_window_total_us();
+    };
+    std::sort(sorted.begin(), sorted.end(), [window_total](const ComponentStats *a, const ComponentStats *b) {
+      return window_total(a) > window_total(b);
+    });
+    ESP_LOGD(TAG, "Busiest components since last update (total / max loop / max scheduled):");
+    for (size_t i = 0; i < sorted.size() && i < this->log_top_; i++) {
+      const ComponentStats *stats = sorted[i];
+      ESP_LOGD(TAG, "  %s: %.1fms / %.2fms / %.2fms", stats->component->get_component_source(),
+               window_total(stats) / 1000.0f, stats->loop.get_window_max_us() / 1000.0f,
+               stats->scheduled.get_window_max_us() / 1000.0f);
+    }
+  }
+
+  for (auto *stats : this->components_) {
+    stats->loop.reset_window();
+    stats->scheduled.reset_window();
+    stats->window_deferred = 0;
+  }
+  for (auto *item : this->scheduled_)
+    item->histogram.reset_window();
+  this->app_loop_.reset_window();
+  this->jitter_.reset_window();
+  this->window_period_us_ = 0;
+  this->window_deferred_ = 0;
+}
+
+void RuntimeStatsComponent::reset() {
+  for (auto *stats : this->components_) {
+    stats->loop.reset();
+    stats->scheduled.reset();
+  }
+  for (auto *item : this->scheduled_)
+    item->histogram.reset();
+  this->app_loop_.reset();
+  this->jitter_.reset();
+  this->window_period_us_ = 0;
+}
+
+}  // namespace runtime_stats
+}  // namespace esphome
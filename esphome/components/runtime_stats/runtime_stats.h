@@ -0,0 +1,156 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
+
+#include <string>
+#include <vector>
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+namespace esphome {
+namespace runtime_stats {
+
+/** Histogram of durations in microseconds with power-of-two bucket boundaries.
+ *
+ * Bucket 0 counts durations below 2^BASE_SHIFT us, bucket i (i >= 1) durations in
+ * [2^(BASE_SHIFT + i - 1), 2^(BASE_SHIFT + i)) us and the last bucket everything above.
+ * Recording a sample is a handful of integer operations, so this is cheap enough for every loop() call.
+ */
+class DurationHistogram {
+ public:
+  static const uint8_t BUCKET_COUNT = 12;
+  static const uint8_t BASE_SHIFT = 5;
+
+  void record(uint32_t duration_us) {
+    uint8_t bucket = 0;
+    if (duration_us >= (1UL << BASE_SHIFT)) {
+      bucket = 32 - __builtin_clz(duration_us) - BASE_SHIFT;
+      if (bucket >= BUCKET_COUNT)
+        bucket = BUCKET_COUNT - 1;
+    }
+    this->buckets_[bucket]++;
+    this->count_++;
+    this->total_us_ += duration_us;
+    if (duration_us > this->max_us_)
+      this->max_us_ = duration_us;
+    this->window_total_us_ += duration_us;
+    if (duration_us > this->window_max_us_)
+      this->window_max_us_ = duration_us;
+  }
+  /// Reset all cumulative counters.
+  void reset();
+  /// Reset the counters of the current reporting window only.
+  void reset_window() {
+    this->window_total_us_ = 0;
+    this->window_max_us_ = 0;
+  }
+
+  uint32_t get_count() const { return this->count_; }
+  uint64_t get_total_us() const { return this->total_us_; }
+  uint32_t get_max_us() const { return this->max_us_; }
+  uint32_t get_bucket(uint8_t bucket) const { return this->buckets_[bucket]; }
+  uint32_t get_window_total_us() const { return this->window_total_us_; }
+  uint32_t get_window_max_us() const { return this->window_max_us_; }
+
+ protected:
+  uint32_t buckets_[BUCKET_COUNT]{};
+  uint32_t count_{0};
+  uint64_t total_us_{0};
+  uint32_t max_us_{0};
+  uint32_t window_total_us_{0};
+  uint32_t window_max_us_{0};
+};
+
+/// Timing of one component, attached to it with Component::set_runtime_stats().
+struct ComponentStats {
+  Component *component;
+  /// Time spent in Component::loop().
+  DurationHistogram loop;
+  /// Time spent in scheduler callbacks of this component, including PollingComponent::update().
+  DurationHistogram scheduled;
+  /// loop() and scheduler callbacks postponed by the loop budget, since the last update.
+  uint32_t window_deferred{0};
+};
+
+/// Timing of one named timeout or interval.
+struct ScheduledItemStats {
+  Component *component;
+  std::string name;
+  uint32_t id;
+  DurationHistogram histogram;
+};
+
+class RuntimeStatsComponent : public PollingComponent {
+ public:
+  RuntimeStatsComponent();
+
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+#ifdef USE_SENSOR
+  void set_active_time_sensor(sensor::Sensor *active_time_sensor) { this->active_time_sensor_ = active_time_sensor; }
+  void set_jitter_sensor(sensor::Sensor *jitter_sensor) { this->jitter_sensor_ = jitter_sensor; }
+  void set_load_sensor(sensor::Sensor *load_sensor) { this->load_sensor_ = load_sensor; }
+  void set_deferred_sensor(sensor::Sensor *deferred_sensor) { this->deferred_sensor_ = deferred_sensor; }
+#endif
+  void set_log_top(uint8_t log_top) { this->log_top_ = log_top; }
+
+  /// Called by Application::loop() after each Component::loop() call.
+  void record_loop(Component *component, uint32_t duration_us) {
+    ComponentStats *stats = component->get_runtime_stats();
+    if (stats == nullptr)
+      stats = this->add_component_(component);
+    stats->loop.record(duration_us);
+  }
+  /// Called by the Scheduler after each timeout or interval callback.
+  void record_scheduled(Component *component, const std::string &name, uint32_t id, uint32_t duration_us);
+  /// Called by Application::loop() and the Scheduler when the loop budget postponed work of a component.
+  void record_deferred(Component *component) {
+    ComponentStats *stats = component->get_runtime_stats();
+    if (stats == nullptr)
+      stats = this->add_component_(component);
+    stats->window_deferred++;
+    this->window_deferred_++;
+  }
+  /// Called by Application::loop() once per iteration, before sleeping.
+  void record_app_loop(uint32_t started_us, uint32_t active_us);
+
+  void reset();
+
+  const std::vector<ComponentStats *> &get_component_stats() const { return this->components_; }
+  const std::vector<ScheduledItemStats *> &get_scheduled_stats() const { return this->scheduled_; }
+  /// Active (non-sleeping) time of each App.loop() iteration.
+  const DurationHistogram &get_app_loop_stats() const { return this->app_loop_; }
+  /// How much later than the configured loop interval each App.loop() iteration started.
+  const DurationHistogram &get_jitter_stats() const { return this->jitter_; }
+
+ protected:
+  ComponentStats *add_component_(Component *component);
+
+  std::vector<ComponentStats *> components_;
+  std::vector<ScheduledItemStats *> scheduled_;
+  DurationHistogram app_loop_;
+  DurationHistogram jitter_;
+  uint32_t last_loop_started_us_{0};
+  uint32_t window_period_us_{0};
+  uint32_t window_deferred_{0};
+  uint8_t log_top_{5};
+
+#ifdef USE_SENSOR
+  sensor::Sensor *active_time_sensor_{nullptr};
+  sensor::Sensor *jitter_sensor_{nullptr};
+  sensor::Sensor *load_sensor_{nullptr};
+  sensor::Sensor *deferred_sensor_{nullptr};
+#endif
+};
+
+extern RuntimeStatsComponent *global_runtime_stats;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace runtime_stats
+}  // namespace esphome
@@ -0,0 +1,69 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+    UNIT_PERCENT,
+)
+from . import CONF_RUNTIME_STATS_ID, RuntimeStatsComponent
+
+DEPENDENCIES = ["runtime_stats"]
+
+CONF_ACTIVE_TIME = "active_time"
+CONF_JITTER = "jitter"
+CONF_LOAD = "load"
+CONF_DEFERRED = "deferred"
+
+CONFIG_SCHEMA = {
+    cv.GenerateID(CONF_RUNTIME_STATS_ID): cv.use_id(RuntimeStatsComponent),
+    cv.Optional(CONF_ACTIVE_TIME): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        icon=ICON_TIMER,
+        accuracy_decimals=2,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_JITTER): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        icon=ICON_TIMER,
+        accuracy_decimals=2,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_LOAD): sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        icon=ICON_TIMER,
+        accuracy_decimals=1,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_DEFERRED): sensor.sensor_schema(
+        icon=ICON_TIMER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+}
+
+
+async def to_code(config):
+    runtime_stats = await cg.get_variable(config[CONF_RUNTIME_STATS_ID])
+
+    if active_time_conf := config.get(CONF_ACTIVE_TIME):
+        sens = await sensor.new_sensor(active_time_conf)
+        cg.add(runtime_stats.set_active_time_sensor(sens))
+
+    if jitter_conf := config.get(CONF_JITTER):
+        sens = await sensor.new_sensor(jitter_conf)
+        cg.add(runtime_stats.set_jitter_sensor(sens))
+
+    if load_conf := config.get(CONF_LOAD):
+        sens = await sensor.new_sensor(load_conf)
+        cg.add(runtime_stats.set_load_sensor(sens))
+
+    if deferred_conf := config.get(CONF_DEFERRED):
+        sens = await sensor.new_sensor(deferred_conf)
+        cg.add(runtime_stats.set_deferred_sensor(sens))
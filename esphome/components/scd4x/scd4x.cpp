@@ -213,24 +213,19 @@ bool SCD4XComponent::perform_forced_calibration(uint16_t current_co2_concentrati
     this->status_set_warning();
   }
   this->set_timeout(500, [this, current_co2_concentration]() {
-    if (this->write_command(SCD4X_CMD_PERFORM_FORCED_CALIBRATION, current_co2_concentration)) {
-      ESP_LOGD(TAG, "setting forced calibration Co2 level %d ppm", current_co2_concentration);
-      // frc takes 400 ms
-      // because this method will be used very rarly
-      // the simple approach with delay is ok
-      delay(400);  // NOLINT'
-      if (!this->start_measurement_()) {
-        return false;
-      } else {
-        ESP_LOGD(TAG, "forced calibration complete");
-      }
-      return true;
-    } else {
-      ESP_LOGE(TAG, "force calibration failed");
-      this->error_code_ = FRC_FAILED;
-      this->status_set_warning();
-      return false;
-    }
+    ESP_LOGD(TAG, "setting forced calibration Co2 level %d ppm", current_co2_concentration);
+    // frc takes 400 ms, then the sensor reports the correction it applied, 0xFFFF if it failed
+    this->read_register_async(this, SCD4X_CMD_PERFORM_FORCED_CALIBRATION, &current_co2_concentration, 1, 1, 400,
+                              [this](const uint16_t *correction) {
+                                if (correction == nullptr || *correction == 0xFFFF) {
+                                  ESP_LOGE(TAG, "force calibration failed");
+                                  this->error_code_ = FRC_FAILED;
+                                  this->status_set_warning();
+                                  return;
+                                }
+                                if (this->start_measurement_())
+                                  ESP_LOGD(TAG, "forced calibration complete");
+                              });
   });
   return true;
 }
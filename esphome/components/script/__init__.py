@@ -23,6 +23,9 @@ CONF_RESTART = "restart"
 CONF_QUEUED = "queued"
 CONF_PARALLEL = "parallel"
 CONF_MAX_RUNS = "max_runs"
+CONF_OVERFLOW = "overflow"
+CONF_DROP_NEWEST = "drop_newest"
+CONF_DROP_OLDEST = "drop_oldest"
 
 SCRIPT_MODES = {
     CONF_SINGLE: SingleScript,
@@ -56,6 +59,17 @@ def check_max_runs(value):
     return value
 
 
+def check_overflow(value):
+    if CONF_OVERFLOW not in value:
+        return value
+    if value[CONF_MODE] != CONF_QUEUED or CONF_MAX_RUNS not in value:
+        raise cv.Invalid(
+            "The option 'overflow' is only valid in 'queued' mode with 'max_runs'.",
+            path=[CONF_OVERFLOW],
+        )
+    return value
+
+
 def assign_declare_id(value):
     value = value.copy()
     value[CONF_ID] = cv.declare_id(SCRIPT_MODES[value[CONF_MODE]])(value[CONF_ID])
@@ -108,13 +122,16 @@ CONFIG_SCHEMA = automation.validate_automation(
             *SCRIPT_MODES, lower=True
         ),
         cv.Optional(CONF_MAX_RUNS): cv.positive_int,
+        cv.Optional(CONF_OVERFLOW): cv.one_of(
+            CONF_DROP_NEWEST, CONF_DROP_OLDEST, lower=True
+        ),
         cv.Optional(CONF_PARAMETERS, default={}): cv.Schema(
             {
                 validate_parameter_name: validate_parameter_type,
             }
         ),
     },
-    extra_validators=cv.All(check_max_runs, assign_declare_id),
+    extra_validators=cv.All(check_max_runs, check_overflow, assign_declare_id),
 )
 
 
@@ -130,6 +147,9 @@ async def to_code(config):
         if CONF_MAX_RUNS in conf:
             cg.add(trigger.set_max_runs(conf[CONF_MAX_RUNS]))
 
+        if conf.get(CONF_OVERFLOW) == CONF_DROP_OLDEST:
+            cg.add(trigger.set_drop_oldest(True))
+
         if conf[CONF_MODE] == CONF_QUEUED:
             await cg.register_component(trigger, conf)
 
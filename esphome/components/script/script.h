@@ -4,7 +4,10 @@
 #include "esphome/core/component.h"
 #include "esphome/core/log.h"
 
-#include <queue>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 namespace esphome {
 namespace script {
 
@@ -84,7 +87,8 @@ template<typename... Ts> class RestartScript : public Script<Ts...> {
 
 /** A script type that queues new instances that are created.
  *
- * Only one instance of the script can be active at a time.
+ * Only one instance of the script can be active at a time. The arguments of queued instances are moved into a ring
+ * that is allocated once for max_runs, and only grows without max_runs, so queueing doesn't allocate.
  */
 template<typename... Ts> class QueueingScript : public Script<Ts...>, public Component {
  public:
@@ -93,13 +97,18 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
       // num_runs_ is the number of *queued* instances, so total number of instances is
       // num_runs_ + 1
       if (this->max_runs_ != 0 && this->num_runs_ + 1 >= this->max_runs_) {
-        this->esp_logw_(__LINE__, "Script '%s' maximum number of queued runs exceeded!", this->name_.c_str());
-        return;
+        this->dropped_runs_++;
+        if (!this->drop_oldest_ || this->num_runs_ == 0) {
+          this->esp_logw_(__LINE__, "Script '%s' maximum number of queued runs exceeded!", this->name_.c_str());
+          return;
+        }
+        this->esp_logw_(__LINE__, "Script '%s' maximum number of queued runs exceeded, dropping the oldest!",
+                        this->name_.c_str());
+        this->pop_();
       }
 
       this->esp_logd_(__LINE__, "Script '%s' queueing new instance (mode: queued)", this->name_.c_str());
-      this->num_runs_++;
-      this->var_queue_.push(std::make_tuple(x...));
+      this->push_(std::tuple<Ts...>(std::move(x)...));
       return;
     }
 
@@ -115,23 +124,52 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
 
   void loop() override {
     if (this->num_runs_ != 0 && !this->is_action_running()) {
-      this->num_runs_--;
-      auto &vars = this->var_queue_.front();
-      this->var_queue_.pop();
+      std::tuple<Ts...> vars = this->pop_();
       this->trigger_tuple_(vars, typename gens<sizeof...(Ts)>::type());
     }
   }
 
-  void set_max_runs(int max_runs) { max_runs_ = max_runs; }
+  void set_max_runs(int max_runs) {
+    max_runs_ = max_runs;
+    this->var_queue_.resize(max_runs > 1 ? max_runs - 1 : 0);
+  }
+  /// When the queue is full, drop the oldest queued instance instead of the new one.
+  void set_drop_oldest(bool drop_oldest) { drop_oldest_ = drop_oldest; }
+  /// Number of instances dropped because the queue was full.
+  uint32_t get_dropped_runs() const { return this->dropped_runs_; }
 
  protected:
-  template<int... S> void trigger_tuple_(const std::tuple<Ts...> &tuple, seq<S...> /*unused*/) {
-    this->trigger(std::get<S>(tuple)...);
+  template<int... S> void trigger_tuple_(std::tuple<Ts...> &tuple, seq<S...> /*unused*/) {
+    this->trigger(std::move(std::get<S>(tuple))...);
+  }
+
+  void push_(std::tuple<Ts...> &&vars) {
+    if (size_t(this->num_runs_) == this->var_queue_.size()) {
+      // Only without max_runs, unroll the ring into a larger one
+      std::vector<std::tuple<Ts...>> queue(std::max<size_t>(this->var_queue_.size() * 2, 4));
+      for (int i = 0; i < this->num_runs_; i++)
+        queue[i] = std::move(this->var_queue_[(this->queue_head_ + i) % this->var_queue_.size()]);
+      this->var_queue_ = std::move(queue);
+      this->queue_head_ = 0;
+    }
+    this->var_queue_[(this->queue_head_ + this->num_runs_) % this->var_queue_.size()] = std::move(vars);
+    this->num_runs_++;
+  }
+
+  std::tuple<Ts...> pop_() {
+    std::tuple<Ts...> vars = std::move(this->var_queue_[this->queue_head_]);
+    this->queue_head_ = (this->queue_head_ + 1) % this->var_queue_.size();
+    this->num_runs_--;
+    return vars;
   }
 
   int num_runs_ = 0;
   int max_runs_ = 0;
-  std::queue<std::tuple<Ts...>> var_queue_;
+  bool drop_oldest_{false};
+  uint32_t dropped_runs_{0};
+  /// Ring of the arguments of queued instances, num_runs_ of them starting at queue_head_.
+  std::vector<std::tuple<Ts...>> var_queue_;
+  size_t queue_head_{0};
 };
 
 /** A script type that executes new instances in parallel.
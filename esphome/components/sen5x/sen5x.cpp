@@ -314,17 +314,10 @@ void SEN5XComponent::update() {
     }
   }
 
-  if (!this->write_command(SEN5X_CMD_READ_MEASUREMENT)) {
-    this->status_set_warning();
-    ESP_LOGD(TAG, "write error read measurement (%d)", this->last_error_);
-    return;
-  }
-  this->set_timeout(20, [this]() {
-    uint16_t measurements[8];
-
-    if (!this->read_data(measurements, 8)) {
+  this->read_register_async(this, SEN5X_CMD_READ_MEASUREMENT, 8, 20, [this](const uint16_t *measurements) {
+    if (measurements == nullptr) {
       this->status_set_warning();
-      ESP_LOGD(TAG, "read data error (%d)", this->last_error_);
+      ESP_LOGD(TAG, "read measurement error (%d)", this->last_error_);
       return;
     }
     float pm_1_0 = measurements[0] / 10.0;
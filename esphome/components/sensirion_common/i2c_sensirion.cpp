@@ -1,4 +1,6 @@
 #include "i2c_sensirion.h"
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include <cinttypes>
@@ -9,12 +11,21 @@ namespace sensirion_common {
 static const char *const TAG = "sensirion_i2c";
 // To avoid memory allocations for small writes a stack buffer is used
 static const size_t BUFFER_STACK_SIZE = 16;
+// Replies up to this many words are read into a stack buffer
+static const size_t READ_STACK_WORDS = 24;
+static const uint32_t ASYNC_READ_ID = fnv1_hash_constexpr("sensirion_read");
 
 bool SensirionI2CDevice::read_data(uint16_t *data, uint8_t len) {
-  const uint8_t num_bytes = len * 3;
-  std::vector<uint8_t> buf(num_bytes);
+  const size_t num_bytes = len * 3;
+  uint8_t buf_stack[READ_STACK_WORDS * 3];
+  std::unique_ptr<uint8_t[]> buf_heap;
+  uint8_t *buf = buf_stack;
+  if (len > READ_STACK_WORDS) {
+    buf_heap = std::unique_ptr<uint8_t[]>(new uint8_t[num_bytes]);
+    buf = buf_heap.get();
+  }
 
-  last_error_ = this->read(buf.data(), num_bytes);
+  last_error_ = this->read(buf, num_bytes);
   if (last_error_ != i2c::ERROR_OK) {
     return false;
   }
@@ -31,6 +42,24 @@ bool SensirionI2CDevice::read_data(uint16_t *data, uint8_t len) {
   }
   return true;
 }
+void SensirionI2CDevice::read_register_async(Component *owner, uint16_t command, const uint16_t *args,
+                                             uint8_t args_len, uint8_t len, uint32_t delay,
+                                             std::function<void(const uint16_t *data)> &&callback) {
+  if (len > MAX_ASYNC_READ_WORDS) {
+    this->last_error_ = i2c::ERROR_TOO_LARGE;
+    callback(nullptr);
+    return;
+  }
+  if (!this->write_command_(command, ADDR_16_BIT, args, args_len)) {
+    callback(nullptr);
+    return;
+  }
+  App.scheduler.set_timeout(owner, ASYNC_READ_ID, delay, [this, len, callback = std::move(callback)]() {
+    uint16_t data[MAX_ASYNC_READ_WORDS];
+    callback(this->read_data(data, len) ? data : nullptr);
+  });
+}
+
 /***
  * write command with parameters and insert crc
  * use stack array for less than 4 parameters. Most sensirion i2c commands have less parameters
@@ -95,33 +124,8 @@ bool SensirionI2CDevice::get_register_(uint16_t reg, CommandLen command_len, uin
 
 // The 8-bit CRC checksum is transmitted after each data word
 uint8_t SensirionI2CDevice::sht_crc_(uint16_t data) {
-  uint8_t bit;
-  uint8_t crc = 0xFF;
-#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-  crc ^= data >> 8;
-#else
-  crc ^= data & 0xFF;
-#endif
-  for (bit = 8; bit > 0; --bit) {
-    if (crc & 0x80) {
-      crc = (crc << 1) ^ crc_polynomial_;
-    } else {
-      crc = (crc << 1);
-    }
-  }
-#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-  crc ^= data & 0xFF;
-#else
-  crc ^= data >> 8;
-#endif
-  for (bit = 8; bit > 0; --bit) {
-    if (crc & 0x80) {
-      crc = (crc << 1) ^ crc_polynomial_;
-    } else {
-      crc = (crc << 1);
-    }
-  }
-  return crc;
+  const uint8_t bytes[2] = {static_cast<uint8_t>(data >> 8), static_cast<uint8_t>(data & 0xFF)};
+  return crc8(bytes, 2, 0xFF, this->crc_polynomial_, true);
 }
 
 }  // namespace sensirion_common
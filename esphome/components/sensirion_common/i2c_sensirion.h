@@ -1,6 +1,8 @@
 #pragma once
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/core/component.h"
 
+#include <functional>
 #include <vector>
 
 namespace esphome {
@@ -75,6 +77,24 @@ class SensirionI2CDevice : public i2c::I2CDevice {
     return this->get_register_(i2c_register, ADDR_8_BIT, &data, 1, delay);
   }
 
+  /** Send a 16 bit command and read its reply once the device had time to prepare it, without blocking the loop.
+   * The wait is a timeout of \p owner under a fixed id, so a new read replaces a pending one instead of adding a timer.
+   * @param owner component the timeout belongs to, usually the driver itself
+   * @param command i2c command to send
+   * @param args arguments for the i2c command
+   * @param args_len number of arguments (words)
+   * @param len number of words to read, at most MAX_ASYNC_READ_WORDS
+   * @param delay milliseconds to wait between sending the i2c command and reading the result
+   * @param callback gets the words, or nullptr if writing or reading failed with last_error_ telling why
+   */
+  void read_register_async(Component *owner, uint16_t command, const uint16_t *args, uint8_t args_len, uint8_t len,
+                           uint32_t delay, std::function<void(const uint16_t *data)> &&callback);
+  void read_register_async(Component *owner, uint16_t command, uint8_t len, uint32_t delay,
+                           std::function<void(const uint16_t *data)> &&callback) {
+    this->read_register_async(owner, command, nullptr, 0, len, delay, std::move(callback));
+  }
+  static const uint8_t MAX_ASYNC_READ_WORDS = 32;
+
   /** Write a command to the i2c device.
    * @param command i2c command to send
    * @return true if reading succeeded
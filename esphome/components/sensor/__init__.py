@@ -23,8 +23,10 @@ from esphome.const import (
     CONF_SEND_EVERY,
     CONF_SEND_FIRST_AT,
     CONF_STATE_CLASS,
+    CONF_SUPPRESS_UNCHANGED,
     CONF_TIMEOUT,
     CONF_TO,
+    CONF_TYPE_ID,
     CONF_TRIGGER_ID,
     CONF_TYPE,
     CONF_UNIT_OF_MEASUREMENT,
@@ -86,7 +88,7 @@ from esphome.const import (
     DEVICE_CLASS_WEIGHT,
     DEVICE_CLASS_WIND_SPEED,
 )
-from esphome.core import CORE, coroutine_with_priority
+from esphome.core import CORE, ID, EsphomeError, coroutine_with_priority
 from esphome.cpp_generator import MockObjClass
 from esphome.cpp_helpers import setup_entity
 from esphome.util import Registry
@@ -232,6 +234,7 @@ CalibrateLinearFilter = sensor_ns.class_("CalibrateLinearFilter", Filter)
 CalibratePolynomialFilter = sensor_ns.class_("CalibratePolynomialFilter", Filter)
 SensorInRangeCondition = sensor_ns.class_("SensorInRangeCondition", Filter)
 ClampFilter = sensor_ns.class_("ClampFilter", Filter)
+AffineClampFilter = sensor_ns.class_("AffineClampFilter", Filter)
 
 validate_unit_of_measurement = cv.string_strict
 validate_accuracy_decimals = cv.int_
@@ -250,6 +253,7 @@ SENSOR_SCHEMA = cv.ENTITY_BASE_SCHEMA.extend(cv.MQTT_COMPONENT_SCHEMA).extend(
             "last_reset_type has been removed since 2021.9.0. state_class: total_increasing should be used for total values."
         ),
         cv.Optional(CONF_FORCE_UPDATE, default=False): cv.boolean,
+        cv.Optional(CONF_SUPPRESS_UNCHANGED): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_EXPIRE_AFTER): cv.All(
             cv.requires_component("mqtt"),
             cv.Any(None, cv.positive_time_period_milliseconds),
@@ -570,6 +574,70 @@ async def debounce_filter_to_code(config, filter_id):
 
 
 CONF_DATAPOINTS = "datapoints"
+CONF_LOOKUP_TABLE = "lookup_table"
+CONF_MAX_ERROR = "max_error"
+
+# 4kB of floats, enough for any smooth function over a sensible range
+MAX_LOOKUP_TABLE_SIZE = 1025
+# Points checked between every two points of a lookup table
+LOOKUP_TABLE_CHECKS = 8
+
+
+def validate_lookup_table(config):
+    if config[CONF_MIN_VALUE] >= config[CONF_MAX_VALUE]:
+        raise cv.Invalid("The 'min_value' must be smaller than the 'max_value'.")
+    return config
+
+
+LOOKUP_TABLE_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_MIN_VALUE): cv.float_,
+            cv.Required(CONF_MAX_VALUE): cv.float_,
+            cv.Optional(CONF_MAX_ERROR, default=0.01): cv.positive_float,
+        }
+    ),
+    validate_lookup_table,
+)
+
+
+def build_lookup_table(func, config):
+    """Sample func at the fewest evenly spaced points that interpolate it within the error bound.
+
+    Returns the arguments for set_lookup_table() of LookupTable users.
+    """
+    x_min = config[CONF_MIN_VALUE]
+    x_max = config[CONF_MAX_VALUE]
+    max_error = config[CONF_MAX_ERROR]
+
+    def sample(size):
+        step = (x_max - x_min) / (size - 1)
+        return [func(x_min + i * step) for i in range(size)]
+
+    def fits(values):
+        step = (x_max - x_min) / (len(values) - 1)
+        for i in range(len(values) - 1):
+            for j in range(1, LOOKUP_TABLE_CHECKS):
+                t = j / LOOKUP_TABLE_CHECKS
+                approx = values[i] + (values[i + 1] - values[i]) * t
+                if abs(approx - func(x_min + (i + t) * step)) > max_error:
+                    return False
+        return True
+
+    if not fits(sample(MAX_LOOKUP_TABLE_SIZE)):
+        raise EsphomeError(
+            f"A lookup table of {MAX_LOOKUP_TABLE_SIZE} points can't reach a "
+            f"'{CONF_MAX_ERROR}' of {max_error} between {x_min} and {x_max}, "
+            "narrow the range or allow a larger error."
+        )
+    low, high = 2, MAX_LOOKUP_TABLE_SIZE
+    while low < high:
+        mid = (low + high) // 2
+        if fits(sample(mid)):
+            high = mid
+        else:
+            low = mid + 1
+    return x_min, x_max, sample(high)
 
 
 def validate_calibrate_linear(config):
@@ -605,6 +673,7 @@ def validate_calibrate_linear(config):
             cv.Optional(CONF_METHOD, default="least_squares"): cv.one_of(
                 "least_squares", "exact", lower=True
             ),
+            cv.Optional(CONF_LOOKUP_TABLE): LOOKUP_TABLE_SCHEMA,
         },
         validate_calibrate_linear,
         key=CONF_DATAPOINTS,
@@ -620,7 +689,21 @@ async def calibrate_linear_filter_to_code(config, filter_id):
         linear_functions = [[k, b, float("NaN")]]
     elif config[CONF_METHOD] == "exact":
         linear_functions = map_linear(x, y)
-    return cg.new_Pvariable(filter_id, linear_functions)
+    var = cg.new_Pvariable(filter_id, linear_functions)
+    if CONF_LOOKUP_TABLE in config:
+
+        def calibrate(value):
+            for k, b, limit in linear_functions:
+                if not math.isfinite(limit) or value < limit:
+                    return value * k + b
+            return float("NaN")
+
+        cg.add(
+            var.set_lookup_table(
+                *build_lookup_table(calibrate, config[CONF_LOOKUP_TABLE])
+            )
+        )
+    return var
 
 
 CONF_DEGREE = "degree"
@@ -645,6 +728,7 @@ def validate_calibrate_polynomial(config):
                     cv.ensure_list(validate_datapoint), cv.Length(min=1)
                 ),
                 cv.Required(CONF_DEGREE): cv.positive_int,
+                cv.Optional(CONF_LOOKUP_TABLE): LOOKUP_TABLE_SCHEMA,
             }
         ),
         validate_calibrate_polynomial,
@@ -658,7 +742,18 @@ async def calibrate_polynomial_filter_to_code(config, filter_id):
     # Column vector
     b = [[v] for v in y]
     res = [v[0] for v in _lstsq(a, b)]
-    return cg.new_Pvariable(filter_id, res)
+    var = cg.new_Pvariable(filter_id, res)
+    if CONF_LOOKUP_TABLE in config:
+
+        def calibrate(value):
+            return sum(coefficient * value**i for i, coefficient in enumerate(res))
+
+        cg.add(
+            var.set_lookup_table(
+                *build_lookup_table(calibrate, config[CONF_LOOKUP_TABLE])
+            )
+        )
+    return var
 
 
 def validate_clamp(config):
@@ -691,8 +786,68 @@ async def clamp_filter_to_code(config, filter_id):
     )
 
 
+def _affine_clamp_step(conf):
+    """Return the AffineClampFilter step [multiplier, offset, min, max] for a filter.
+
+    None if the filter can't be merged.
+    """
+    if CONF_TYPE_ID not in conf or conf[CONF_TYPE_ID].is_manual:
+        return None
+    nan = float("NaN")
+    if "offset" in conf:
+        return [1.0, conf["offset"], nan, nan]
+    if "multiply" in conf:
+        return [conf["multiply"], 0.0, nan, nan]
+    if "calibrate_linear" in conf:
+        calibrate = conf["calibrate_linear"]
+        if calibrate[CONF_METHOD] != "least_squares":
+            return None
+        k, b = fit_linear(
+            [point[CONF_FROM] for point in calibrate[CONF_DATAPOINTS]],
+            [point[CONF_TO] for point in calibrate[CONF_DATAPOINTS]],
+        )
+        return [k, b, nan, nan]
+    if "clamp" in conf:
+        clamp = conf["clamp"]
+        return [1.0, 0.0, clamp[CONF_MIN_VALUE], clamp[CONF_MAX_VALUE]]
+    return None
+
+
 async def build_filters(config):
-    return await cg.build_registry_list(FILTER_REGISTRY, config)
+    # Runs of two or more stateless linear filters become a single AffineClampFilter,
+    # saving an object and a virtual call per stage for every value.
+    filters = []
+    i = 0
+    while i < len(config):
+        steps = []
+        end = i
+        while end < len(config):
+            step = _affine_clamp_step(config[end])
+            if step is None:
+                break
+            prev = steps[-1] if steps else None
+            if (
+                prev is not None
+                and step[:2] == [1.0, 0.0]
+                and math.isnan(prev[2])
+                and math.isnan(prev[3])
+            ):
+                # a clamp right after an affine step shares that step
+                prev[2:] = step[2:]
+            else:
+                steps.append(step)
+            end += 1
+        if end - i >= 2:
+            first_id = config[i][CONF_TYPE_ID]
+            filter_id = ID(
+                f"{first_id.id}_affine", is_declaration=True, type=AffineClampFilter
+            )
+            filters.append(cg.new_Pvariable(filter_id, steps))
+            i = end
+        else:
+            filters.append(await cg.build_registry_entry(FILTER_REGISTRY, config[i]))
+            i += 1
+    return filters
 
 
 async def setup_sensor_core_(var, config):
@@ -707,6 +862,8 @@ async def setup_sensor_core_(var, config):
     if CONF_ACCURACY_DECIMALS in config:
         cg.add(var.set_accuracy_decimals(config[CONF_ACCURACY_DECIMALS]))
     cg.add(var.set_force_update(config[CONF_FORCE_UPDATE]))
+    if CONF_SUPPRESS_UNCHANGED in config:
+        cg.add(var.set_suppress_unchanged(config[CONF_SUPPRESS_UNCHANGED]))
     if config.get(CONF_FILTERS):  # must exist and not be empty
         filters = await build_filters(config[CONF_FILTERS])
         cg.add(var.set_filters(filters))
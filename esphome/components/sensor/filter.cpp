@@ -2,6 +2,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "sensor.h"
+#include <algorithm>
 #include <cmath>
 
 namespace esphome {
@@ -31,40 +32,49 @@ void Filter::initialize(Sensor *parent, Filter *next) {
   this->next_ = next;
 }
 
+// Keep a sorted copy of the non-NaN window values, so median and quantile don't sort on every send.
+static void sorted_window_insert(std::vector<float> &sorted, float value) {
+  if (!std::isnan(value))
+    sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), value), value);
+}
+static void sorted_window_erase(std::vector<float> &sorted, float value) {
+  if (std::isnan(value))
+    return;
+  auto it = std::lower_bound(sorted.begin(), sorted.end(), value);
+  if (it != sorted.end() && *it == value)
+    sorted.erase(it);
+}
+
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : queue_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->queue_.set_capacity(window_size);
+  this->sorted_.clear();
+  for (auto v : this->queue_)
+    sorted_window_insert(this->sorted_, v);
+}
 optional<float> MedianFilter::new_value(float value) {
   while (this->queue_.size() >= this->window_size_) {
+    sorted_window_erase(this->sorted_, this->queue_.front());
     this->queue_.pop_front();
   }
   this->queue_.push_back(value);
+  sorted_window_insert(this->sorted_, value);
   ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float median = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> median_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          median_queue.push_back(v);
-        }
-      }
-
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size) {
-        if (queue_size % 2) {
-          median = median_queue[queue_size / 2];
-        } else {
-          median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-        }
+    size_t queue_size = this->sorted_.size();
+    if (queue_size) {
+      if (queue_size % 2) {
+        median = this->sorted_[queue_size / 2];
+      } else {
+        median = (this->sorted_[queue_size / 2] + this->sorted_[(queue_size / 2) - 1]) / 2.0f;
       }
     }
 
@@ -89,38 +99,38 @@ optional<float> SkipInitialFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
+    : queue_(window_size),
+      send_every_(send_every),
+      send_at_(send_every - send_first_at),
+      window_size_(window_size),
+      quantile_(quantile) {}
 void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void QuantileFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->queue_.set_capacity(window_size);
+  this->sorted_.clear();
+  for (auto v : this->queue_)
+    sorted_window_insert(this->sorted_, v);
+}
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
   while (this->queue_.size() >= this->window_size_) {
+    sorted_window_erase(this->sorted_, this->queue_.front());
     this->queue_.pop_front();
   }
   this->queue_.push_back(value);
+  sorted_window_insert(this->sorted_, value);
   ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float result = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> quantile_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          quantile_queue.push_back(v);
-        }
-      }
-
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      if (queue_size) {
-        size_t position = ceilf(queue_size * this->quantile_) - 1;
-        ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
-        result = quantile_queue[position];
-      }
+    size_t queue_size = this->sorted_.size();
+    if (queue_size) {
+      size_t position = ceilf(queue_size * this->quantile_) - 1;
+      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
+      result = this->sorted_[position];
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING %f", this, value, result);
@@ -131,25 +141,31 @@ optional<float> QuantileFilter::new_value(float value) {
 
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : queue_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->queue_.set_capacity(window_size);
+}
 optional<float> MinFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
+  // Monotonic queue of (index, value): a value is dropped as soon as a newer one is at least as small,
+  // it can't become the minimum again. The front is the minimum of the window.
+  size_t index = this->count_++;
+  while (!this->queue_.empty() && index - this->queue_.front().first >= this->window_size_) {
     this->queue_.pop_front();
   }
-  this->queue_.push_back(value);
+  if (!std::isnan(value)) {
+    while (!this->queue_.empty() && this->queue_.back().second >= value) {
+      this->queue_.pop_back();
+    }
+    this->queue_.push_back({index, value});
+  }
   ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float min = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        min = std::isnan(min) ? v : std::min(min, v);
-      }
-    }
+    float min = this->queue_.empty() ? NAN : this->queue_.front().second;
 
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING %f", this, value, min);
     return min;
@@ -159,25 +175,31 @@ optional<float> MinFilter::new_value(float value) {
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : queue_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->queue_.set_capacity(window_size);
+}
 optional<float> MaxFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
+  // Monotonic queue of (index, value): a value is dropped as soon as a newer one is at least as large,
+  // it can't become the maximum again. The front is the maximum of the window.
+  size_t index = this->count_++;
+  while (!this->queue_.empty() && index - this->queue_.front().first >= this->window_size_) {
     this->queue_.pop_front();
   }
-  this->queue_.push_back(value);
+  if (!std::isnan(value)) {
+    while (!this->queue_.empty() && this->queue_.back().second <= value) {
+      this->queue_.pop_back();
+    }
+    this->queue_.push_back({index, value});
+  }
   ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float max = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        max = std::isnan(max) ? v : std::max(max, v);
-      }
-    }
+    float max = this->queue_.empty() ? NAN : this->queue_.front().second;
 
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING %f", this, value, max);
     return max;
@@ -188,9 +210,12 @@ optional<float> MaxFilter::new_value(float value) {
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : queue_(window_size), send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->queue_.set_capacity(window_size);
+}
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
   while (this->queue_.size() >= this->window_size_) {
     this->queue_.pop_front();
@@ -374,8 +399,11 @@ void OrFilter::initialize(Sensor *parent, Filter *next) {
 }
 
 // TimeoutFilter
+// Re-armed on every sample, use numeric ids so the scheduler can reuse the pending timeout in place
+static const uint32_t TIMEOUT_ID = fnv1_hash_constexpr("timeout");
+
 optional<float> TimeoutFilter::new_value(float value) {
-  this->set_timeout("timeout", this->time_period_, [this]() { this->output(this->value_); });
+  this->set_timeout(TIMEOUT_ID, this->time_period_, [this]() { this->output(this->value_); });
   this->output(value);
 
   return {};
@@ -385,8 +413,10 @@ TimeoutFilter::TimeoutFilter(uint32_t time_period, float new_value) : time_perio
 float TimeoutFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
 
 // DebounceFilter
+static const uint32_t DEBOUNCE_ID = fnv1_hash_constexpr("debounce");
+
 optional<float> DebounceFilter::new_value(float value) {
-  this->set_timeout("debounce", this->time_period_, [this, value]() { this->output(value); });
+  this->set_timeout(DEBOUNCE_ID, this->time_period_, [this, value]() { this->output(value); });
 
   return {};
 }
@@ -416,7 +446,23 @@ void HeartbeatFilter::setup() {
 }
 float HeartbeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
 
+float LookupTable::evaluate(float x) const {
+  if (std::isnan(x))
+    return NAN;
+  const float pos = (x - this->x_min_) * this->inv_step_;
+  if (pos <= 0.0f)
+    return this->values_.front();
+  const size_t last = this->values_.size() - 1;
+  if (pos >= last)
+    return this->values_.back();
+  const size_t index = static_cast<size_t>(pos);
+  const float y0 = this->values_[index];
+  return y0 + (this->values_[index + 1] - y0) * (pos - index);
+}
+
 optional<float> CalibrateLinearFilter::new_value(float value) {
+  if (this->lookup_table_ != nullptr)
+    return this->lookup_table_->evaluate(value);
   for (std::array<float, 3> f : this->linear_functions_) {
     if (!std::isfinite(f[2]) || value < f[2])
       return (value * f[0]) + f[1];
@@ -425,6 +471,8 @@ optional<float> CalibrateLinearFilter::new_value(float value) {
 }
 
 optional<float> CalibratePolynomialFilter::new_value(float value) {
+  if (this->lookup_table_ != nullptr)
+    return this->lookup_table_->evaluate(value);
   float res = 0.0f;
   float x = 1.0f;
   for (float coefficient : this->coefficients_) {
@@ -445,5 +493,20 @@ optional<float> ClampFilter::new_value(float value) {
   return value;
 }
 
+optional<float> AffineClampFilter::new_value(float value) {
+  for (const auto &step : this->steps_) {
+    value = value * step[0] + step[1];
+    if (std::isfinite(value)) {
+      // NaN bounds are unset, the comparisons are false for them
+      if (value < step[2]) {
+        value = step[2];
+      } else if (value > step[3]) {
+        value = step[3];
+      }
+    }
+  }
+  return value;
+}
+
 }  // namespace sensor
 }  // namespace esphome
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -67,7 +68,9 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  RingBuffer<float> queue_;
+  /// Non-NaN values of queue_ in ascending order.
+  std::vector<float> sorted_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -96,7 +99,9 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  RingBuffer<float> queue_;
+  /// Non-NaN values of queue_ in ascending order.
+  std::vector<float> sorted_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -142,7 +147,9 @@ class MinFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  /// (sample index, value) pairs, see new_value().
+  RingBuffer<std::pair<size_t, float>> queue_;
+  size_t count_{0};
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -170,7 +177,9 @@ class MaxFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  /// (sample index, value) pairs, see new_value().
+  RingBuffer<std::pair<size_t, float>> queue_;
+  size_t count_{0};
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -199,7 +208,7 @@ class SlidingWindowMovingAverageFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  RingBuffer<float> queue_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -390,23 +399,50 @@ class OrFilter : public Filter {
   PhiNode phi_;
 };
 
+/** A function sampled by codegen at evenly spaced points between x_min and x_max, interpolated linearly in between.
+ *
+ * Codegen picks the number of points so the interpolation stays within an error bound over the range, so evaluating
+ * it is one index computation and one interpolation instead of the float math of the function itself. Inputs outside
+ * of the range are clamped to it.
+ */
+class LookupTable {
+ public:
+  LookupTable(float x_min, float x_max, std::vector<float> values)
+      : x_min_(x_min), inv_step_((values.size() - 1) / (x_max - x_min)), values_(std::move(values)) {}
+  float evaluate(float x) const;
+
+ protected:
+  float x_min_;
+  /// Points per unit of input, so the index is a multiplication away.
+  float inv_step_;
+  std::vector<float> values_;
+};
+
 class CalibrateLinearFilter : public Filter {
  public:
   CalibrateLinearFilter(std::vector<std::array<float, 3>> linear_functions)
       : linear_functions_(std::move(linear_functions)) {}
+  void set_lookup_table(float x_min, float x_max, std::vector<float> values) {
+    this->lookup_table_ = make_unique<LookupTable>(x_min, x_max, std::move(values));
+  }
   optional<float> new_value(float value) override;
 
  protected:
   std::vector<std::array<float, 3>> linear_functions_;
+  std::unique_ptr<LookupTable> lookup_table_;
 };
 
 class CalibratePolynomialFilter : public Filter {
  public:
   CalibratePolynomialFilter(std::vector<float> coefficients) : coefficients_(std::move(coefficients)) {}
+  void set_lookup_table(float x_min, float x_max, std::vector<float> values) {
+    this->lookup_table_ = make_unique<LookupTable>(x_min, x_max, std::move(values));
+  }
   optional<float> new_value(float value) override;
 
  protected:
   std::vector<float> coefficients_;
+  std::unique_ptr<LookupTable> lookup_table_;
 };
 
 class ClampFilter : public Filter {
@@ -419,5 +455,19 @@ class ClampFilter : public Filter {
   float max_{NAN};
 };
 
+/** Consecutive offset, multiply, least squares calibrate_linear and clamp filters in a single filter.
+ *
+ * The code generator emits this for chains of those filters. Each step is {multiplier, offset, min, max}: it computes
+ * value * multiplier + offset and then clamps finite values like ClampFilter, so results match the separate filters.
+ */
+class AffineClampFilter : public Filter {
+ public:
+  AffineClampFilter(std::vector<std::array<float, 4>> steps) : steps_(std::move(steps)) {}
+  optional<float> new_value(float value) override;
+
+ protected:
+  std::vector<std::array<float, 4>> steps_;
+};
+
 }  // namespace sensor
 }  // namespace esphome
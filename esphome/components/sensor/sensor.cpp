@@ -1,5 +1,9 @@
 #include "sensor.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
+#include "esphome/core/worker.h"
+
+#include <cmath>
 
 namespace esphome {
 namespace sensor {
@@ -37,6 +41,12 @@ StateClass Sensor::get_state_class() {
 }
 
 void Sensor::publish_state(float state) {
+#ifdef USE_COMPONENT_WORKER
+  if (worker::in_worker()) {
+    worker::run_in_main([this, state]() { this->publish_state(state); });
+    return;
+  }
+#endif
   this->raw_state = state;
   this->raw_callback_.call(state);
 
@@ -49,11 +59,6 @@ void Sensor::publish_state(float state) {
   }
 }
 
-void Sensor::add_on_state_callback(std::function<void(float)> &&callback) { this->callback_.add(std::move(callback)); }
-void Sensor::add_on_raw_state_callback(std::function<void(float)> &&callback) {
-  this->raw_callback_.add(std::move(callback));
-}
-
 void Sensor::add_filter(Filter *filter) {
   // inefficient, but only happens once on every sensor setup and nobody's going to have massive amounts of
   // filters
@@ -87,7 +92,24 @@ float Sensor::get_state() const { return this->state; }
 float Sensor::get_raw_state() const { return this->raw_state; }
 std::string Sensor::unique_id() { return ""; }
 
+/// Whether a and b round to the same value with the accuracy decimals, or are both NAN.
+static bool equal_with_accuracy(float a, float b, int8_t accuracy_decimals) {
+  if (std::isnan(a) || std::isnan(b))
+    return std::isnan(a) && std::isnan(b);
+  const float multiplier = powf(10.0f, accuracy_decimals);
+  return roundf(a * multiplier) == roundf(b * multiplier);
+}
+
 void Sensor::internal_send_state_to_frontend(float state) {
+  if (this->suppress_unchanged_max_age_ != 0) {
+    const uint32_t now = millis();
+    if (this->has_state_ && now - this->last_sent_time_ < this->suppress_unchanged_max_age_ &&
+        equal_with_accuracy(state, this->state, this->get_accuracy_decimals())) {
+      ESP_LOGV(TAG, "'%s': Suppressing unchanged state %.5f", this->get_name().c_str(), state);
+      return;
+    }
+    this->last_sent_time_ = now;
+  }
   this->has_state_ = true;
   this->state = state;
   ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy", this->get_name().c_str(), state,
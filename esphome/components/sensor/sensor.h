@@ -6,6 +6,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/components/sensor/filter.h"
 
+#include <cinttypes>
 #include <vector>
 
 namespace esphome {
@@ -29,6 +30,9 @@ namespace sensor {
     if ((obj)->get_force_update()) { \
       ESP_LOGV(TAG, "%s  Force Update: YES", prefix); \
     } \
+    if ((obj)->get_suppress_unchanged() != 0) { \
+      ESP_LOGV(TAG, "%s  Suppress Unchanged: %" PRIu32 " ms", prefix, (obj)->get_suppress_unchanged()); \
+    } \
   }
 
 #define SUB_SENSOR(name) \
@@ -78,6 +82,12 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   bool get_force_update() const { return force_update_; }
   /// Set force update mode.
   void set_force_update(bool force_update) { force_update_ = force_update; }
+  /** Don't send states that round to the same value as the last sent state with the accuracy decimals.
+   *
+   * Unchanged states are still sent once the last one was sent at least max_age ms ago, 0 sends all states.
+   */
+  void set_suppress_unchanged(uint32_t max_age) { suppress_unchanged_max_age_ = max_age; }
+  uint32_t get_suppress_unchanged() const { return suppress_unchanged_max_age_; }
 
   /// Add a filter to the filter chain. Will be appended to the back.
   void add_filter(Filter *filter);
@@ -117,9 +127,11 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Add a callback that will be called every time a filtered value arrives.
-  void add_on_state_callback(std::function<void(float)> &&callback);
+  template<typename F> void add_on_state_callback(F &&callback) { this->callback_.add(std::forward<F>(callback)); }
   /// Add a callback that will be called every time the sensor sends a raw value.
-  void add_on_raw_state_callback(std::function<void(float)> &&callback);
+  template<typename F> void add_on_raw_state_callback(F &&callback) {
+    this->raw_callback_.add(std::forward<F>(callback));
+  }
 
   /** This member variable stores the last state that has passed through all filters.
    *
@@ -157,6 +169,8 @@ class Sensor : public EntityBase, public EntityBase_DeviceClass, public EntityBa
   optional<StateClass> state_class_{STATE_CLASS_NONE};  ///< State class override
   bool force_update_{false};                            ///< Force update mode
   bool has_state_{false};
+  uint32_t suppress_unchanged_max_age_{0};
+  uint32_t last_sent_time_{0};
 };
 
 }  // namespace sensor
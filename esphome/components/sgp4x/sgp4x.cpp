@@ -147,25 +147,19 @@ void SGP4xComponent::self_test_() {
 
 /**
  * @brief Combined the measured gasses, temperature, and humidity
- * to calculate the VOC Index
+ * to calculate the VOC and NOx Index
  *
- * @param temperature The measured temperature in degrees C
- * @param humidity The measured relative humidity in % rH
- * @return int32_t The VOC Index
+ * @param voc_sraw The raw VOC ticks
+ * @param nox_sraw The raw NOx ticks, 0 without NOx sensor
  */
-bool SGP4xComponent::measure_gas_indices_(int32_t &voc, int32_t &nox) {
-  uint16_t voc_sraw;
-  uint16_t nox_sraw;
-  if (!measure_raw_(voc_sraw, nox_sraw))
-    return false;
-
+void SGP4xComponent::process_raw_(uint16_t voc_sraw, uint16_t nox_sraw) {
   this->status_clear_warning();
 
-  voc = voc_algorithm_.process(voc_sraw);
+  this->voc_index_ = voc_algorithm_.process(voc_sraw);
   if (nox_sensor_) {
-    nox = nox_algorithm_.process(nox_sraw);
+    this->nox_index_ = nox_algorithm_.process(nox_sraw);
   }
-  ESP_LOGV(TAG, "VOC = %d, NOx = %d", voc, nox);
+  ESP_LOGV(TAG, "VOC = %d, NOx = %d", this->voc_index_, this->nox_index_);
   // Store baselines after defined interval or if the difference between current and stored baseline becomes too
   // much
   if (this->store_baseline_ && this->seconds_since_last_store_ > SHORTEST_BASELINE_STORE_INTERVAL) {
@@ -185,22 +179,22 @@ bool SGP4xComponent::measure_gas_indices_(int32_t &voc, int32_t &nox) {
     }
   }
 
-  return true;
+  if (this->samples_read_ < this->samples_to_stabilize_) {
+    this->samples_read_++;
+    ESP_LOGD(TAG, "Sensor has not collected enough samples yet. (%d/%d) VOC index is: %u", this->samples_read_,
+             this->samples_to_stabilize_, this->voc_index_);
+  }
 }
 /**
- * @brief Return the raw gas measurement
- *
- * @param temperature The measured temperature in degrees C
- * @param humidity The measured relative humidity in % rH
- * @return uint16_t The current raw gas measurement
+ * @brief Start the raw gas measurement, compensated with the humidity and temperature sensors
  */
-bool SGP4xComponent::measure_raw_(uint16_t &voc_raw, uint16_t &nox_raw) {
+void SGP4xComponent::measure_raw_() {
   float humidity = NAN;
   static uint32_t nox_conditioning_start = millis();
 
   if (!this->self_test_complete_) {
     ESP_LOGD(TAG, "Self-test not yet complete");
-    return false;
+    return;
   }
   if (this->humidity_sensor_ != nullptr) {
     humidity = this->humidity_sensor_->state;
@@ -219,7 +213,7 @@ bool SGP4xComponent::measure_raw_(uint16_t &voc_raw, uint16_t &nox_raw) {
 
   uint16_t command;
   uint16_t data[2];
-  size_t response_words;
+  uint8_t response_words;
   // Use SGP40 measure command if we don't care about NOx
   if (nox_sensor_ == nullptr) {
     command = SGP40_CMD_MEASURE_RAW;
@@ -241,22 +235,23 @@ bool SGP4xComponent::measure_raw_(uint16_t &voc_raw, uint16_t &nox_raw) {
   // secomd parameter are the temperature ticks
   data[1] = tempticks;
 
-  if (!this->write_command(command, data, 2)) {
-    this->status_set_warning();
-    ESP_LOGD(TAG, "write error (%d)", this->last_error_);
-    return false;
-  }
-  delay(measure_time_);
-  uint16_t raw_data[2];
-  raw_data[1] = 0;
-  if (!this->read_data(raw_data, response_words)) {
-    this->status_set_warning();
-    ESP_LOGD(TAG, "read error (%d)", this->last_error_);
-    return false;
-  }
-  voc_raw = raw_data[0];
-  nox_raw = raw_data[1];  // either 0 or the measured NOx ticks
-  return true;
+  this->read_register_async(this, command, data, 2, response_words, this->measure_time_,
+                            [this, response_words](const uint16_t *raw_data) {
+                              if (raw_data == nullptr) {
+                                ESP_LOGD(TAG, "measure error (%d)", this->last_error_);
+                                this->measure_failed_();
+                                return;
+                              }
+                              // NOx is either 0 or the measured ticks
+                              this->process_raw_(raw_data[0], response_words == 2 ? raw_data[1] : 0);
+                            });
+}
+
+void SGP4xComponent::measure_failed_() {
+  this->status_set_warning();
+  // Set values to UINT16_MAX to indicate failure
+  this->voc_index_ = this->nox_index_ = UINT16_MAX;
+  ESP_LOGE(TAG, "measure gas indices failed");
 }
 
 void SGP4xComponent::update_gas_indices() {
@@ -264,18 +259,7 @@ void SGP4xComponent::update_gas_indices() {
     return;
 
   this->seconds_since_last_store_ += 1;
-  if (!this->measure_gas_indices_(this->voc_index_, this->nox_index_)) {
-    // Set values to UINT16_MAX to indicate failure
-    this->voc_index_ = this->nox_index_ = UINT16_MAX;
-    ESP_LOGE(TAG, "measure gas indices failed");
-    return;
-  }
-  if (this->samples_read_ < this->samples_to_stabilize_) {
-    this->samples_read_++;
-    ESP_LOGD(TAG, "Sensor has not collected enough samples yet. (%d/%d) VOC index is: %u", this->samples_read_,
-             this->samples_to_stabilize_, this->voc_index_);
-    return;
-  }
+  this->measure_raw_();
 }
 
 void SGP4xComponent::update() {
@@ -107,8 +107,11 @@ class SGP4xComponent : public PollingComponent, public sensor::Sensor, public se
   sensor::Sensor *temperature_sensor_{nullptr};
   int16_t sensirion_init_sensors_();
 
-  bool measure_gas_indices_(int32_t &voc, int32_t &nox);
-  bool measure_raw_(uint16_t &voc_raw, uint16_t &nox_raw);
+  /// Feed a raw measurement to the gas index algorithms and store their baselines when due.
+  void process_raw_(uint16_t voc_raw, uint16_t nox_raw);
+  /// Start a raw measurement, process_raw_() gets its result measure_time_ later.
+  void measure_raw_();
+  void measure_failed_();
 
   SgpType sgp_type_{SGP40};
   uint64_t serial_number_;
@@ -54,37 +54,36 @@ void Sml::loop() {
   }
 }
 
-void Sml::process_sml_file_(const bytes &sml_data) {
-  SmlFile sml_file = SmlFile(sml_data);
-  std::vector<ObisInfo> obis_info = sml_file.get_obis_info();
-  this->publish_obis_info_(obis_info);
-
-  this->log_obis_info_(obis_info);
-}
-
-void Sml::log_obis_info_(const std::vector<ObisInfo> &obis_info_vec) {
+void Sml::process_sml_file_(const BytesView &sml_data) {
   ESP_LOGD(TAG, "OBIS info:");
-  for (auto const &obis_info : obis_info_vec) {
-    std::string info;
-    info += "  (" + bytes_repr(obis_info.server_id) + ") ";
-    info += obis_info.code_repr();
-    info += " [0x" + bytes_repr(obis_info.value) + "]";
-    ESP_LOGD(TAG, "%s", info.c_str());
-  }
+  SmlFile(sml_data).for_each_obis_info([this](const ObisInfo &obis_info) {
+    this->publish_value_(obis_info);
+    this->log_obis_info_(obis_info);
+  });
 }
 
-void Sml::publish_obis_info_(const std::vector<ObisInfo> &obis_info_vec) {
-  for (auto const &obis_info : obis_info_vec) {
-    this->publish_value_(obis_info);
-  }
+void Sml::log_obis_info_(const ObisInfo &obis_info) {
+#if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_DEBUG
+  std::string info;
+  info += "  (" + bytes_repr(obis_info.server_id) + ") ";
+  info += obis_info.code_repr();
+  info += " [0x" + bytes_repr(obis_info.value) + "]";
+  ESP_LOGD(TAG, "%s", info.c_str());
+#endif
 }
 
 void Sml::publish_value_(const ObisInfo &obis_info) {
+  std::string code = obis_info.code_repr();
+  std::string server_id;
   for (auto const &sml_listener : sml_listeners_) {
-    if ((!sml_listener->server_id.empty()) && (bytes_repr(obis_info.server_id) != sml_listener->server_id))
-      continue;
-    if (obis_info.code_repr() != sml_listener->obis_code)
+    if (code != sml_listener->obis_code)
       continue;
+    if (!sml_listener->server_id.empty()) {
+      if (server_id.empty())
+        server_id = bytes_repr(obis_info.server_id);
+      if (server_id != sml_listener->server_id)
+        continue;
+    }
     sml_listener->publish_val(obis_info);
   }
 }
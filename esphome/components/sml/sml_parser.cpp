@@ -5,77 +5,156 @@
 namespace esphome {
 namespace sml {
 
-SmlFile::SmlFile(bytes buffer) : buffer_(std::move(buffer)) {
-  // extract messages
+SmlFile::SmlFile(BytesView buffer) : buffer_(buffer) {}
+
+void SmlFile::for_each_obis_info(const std::function<void(const ObisInfo &)> &callback) {
   this->pos_ = 0;
   while (this->pos_ < this->buffer_.size()) {
     if (this->buffer_[this->pos_] == 0x00)
       break;  // fill byte detected -> no more messages
 
-    SmlNode message = SmlNode();
-    if (!this->setup_node(&message))
+    // find the end of the message first, so a message with an unexpected layout can simply be skipped
+    size_t start = this->pos_;
+    if (!this->skip_node_())
       break;
-    this->messages.emplace_back(message);
+    size_t end = this->pos_;
+    this->pos_ = start;
+    this->parse_message_(callback);
+    this->pos_ = end;
   }
 }
 
-bool SmlFile::setup_node(SmlNode *node) {
-  uint8_t type = this->buffer_[this->pos_] >> 4;      // type including overlength info
-  uint8_t length = this->buffer_[this->pos_] & 0x0f;  // length including TL bytes
-  bool is_list = (type & 0x07) == SML_LIST;
-  bool has_extended_length = type & 0x08;  // we have a long list/value (>15 entries)
-  uint8_t parse_length = length;
+bool SmlFile::read_tl_(uint8_t *type, size_t *length, bool *is_end) {
+  if (this->pos_ >= this->buffer_.size())
+    return false;
+  uint8_t tl_type = this->buffer_[this->pos_] >> 4;      // type including overlength info
+  uint8_t tl_length = this->buffer_[this->pos_] & 0x0f;  // length including TL bytes
+  bool has_extended_length = tl_type & 0x08;              // we have a long list/value (>15 entries)
+  uint8_t parse_length = tl_length;
+  *is_end = this->buffer_[this->pos_] == 0x00;
   if (has_extended_length) {
-    length = (length << 4) + (this->buffer_[this->pos_ + 1] & 0x0f);
-    parse_length = length - 1;
+    if (this->pos_ + 1 >= this->buffer_.size())
+      return false;
+    tl_length = (tl_length << 4) + (this->buffer_[this->pos_ + 1] & 0x0f);
+    parse_length = tl_length - 1;
     this->pos_ += 1;
+    *is_end = false;
   }
 
   if (this->pos_ + parse_length >= this->buffer_.size())
     return false;
 
-  node->type = type & 0x07;
-  node->nodes.clear();
-  node->value_bytes.clear();
-  if (this->buffer_[this->pos_] == 0x00) {  // end of message
+  *type = tl_type & 0x07;
+  *length = parse_length;
+  return true;
+}
+
+bool SmlFile::skip_node_() {
+  BytesView value;
+  uint8_t type;
+  return this->read_value_(&value, &type);
+}
+
+bool SmlFile::read_value_(BytesView *value, uint8_t *type) {
+  size_t length;
+  bool is_end;
+  if (!this->read_tl_(type, &length, &is_end))
+    return false;
+
+  *value = BytesView();
+  if (is_end) {  // end of message
     this->pos_ += 1;
-  } else if (is_list) {  // list
+  } else if (*type == SML_LIST) {
     this->pos_ += 1;
-    node->nodes.reserve(parse_length);
-    for (size_t i = 0; i != parse_length; i++) {
-      SmlNode child_node = SmlNode();
-      if (!this->setup_node(&child_node))
+    for (size_t i = 0; i != length; i++) {
+      if (!this->skip_node_())
         return false;
-      node->nodes.emplace_back(child_node);
     }
-  } else {  // value
-    node->value_bytes =
-        bytes(this->buffer_.begin() + this->pos_ + 1, this->buffer_.begin() + this->pos_ + parse_length);
-    this->pos_ += parse_length;
+  } else {
+    *value = BytesView(this->buffer_.begin() + this->pos_ + 1, length > 0 ? length - 1 : 0);
+    this->pos_ += length > 0 ? length : 1;
   }
   return true;
 }
 
-std::vector<ObisInfo> SmlFile::get_obis_info() {
-  std::vector<ObisInfo> obis_info;
-  for (auto const &message : messages) {
-    SmlNode message_body = message.nodes[3];
-    uint16_t message_type = bytes_to_uint(message_body.nodes[0].value_bytes);
-    if (message_type != SML_GET_LIST_RES)
-      continue;
+bool SmlFile::enter_list_(size_t *count) {
+  uint8_t type;
+  bool is_end;
+  if (!this->read_tl_(&type, count, &is_end) || is_end || type != SML_LIST)
+    return false;
+  this->pos_ += 1;
+  return true;
+}
+
+bool SmlFile::parse_message_(const std::function<void(const ObisInfo &)> &callback) {
+  BytesView value;
+  uint8_t type;
+  size_t count;
 
-    SmlNode get_list_response = message_body.nodes[1];
-    bytes server_id = get_list_response.nodes[1].value_bytes;
-    SmlNode val_list = get_list_response.nodes[4];
+  // transaction id, group number, abort on error, message body, crc, end of message
+  if (!this->enter_list_(&count) || count < 4)
+    return false;
+  for (int i = 0; i < 3; i++) {
+    if (!this->skip_node_())
+      return false;
+  }
 
-    for (auto const &val_list_entry : val_list.nodes) {
-      obis_info.emplace_back(server_id, val_list_entry);
+  // message body: type, content
+  if (!this->enter_list_(&count) || count < 2)
+    return false;
+  BytesView message_type;
+  if (!this->read_value_(&message_type, &type))
+    return false;
+  if (bytes_to_uint(message_type) != SML_GET_LIST_RES)
+    return true;
+
+  // get list response: client id, server id, list name, sensor time, value list, ...
+  if (!this->enter_list_(&count) || count < 5)
+    return false;
+  BytesView server_id;
+  if (!this->skip_node_() || !this->read_value_(&server_id, &type) || !this->skip_node_() || !this->skip_node_())
+    return false;
+
+  size_t entries;
+  if (!this->enter_list_(&entries))
+    return false;
+  for (size_t entry = 0; entry != entries; entry++) {
+    // object name, status, value time, unit, scaler, value, signature
+    if (!this->enter_list_(&count))
+      return false;
+    BytesView code, status, unit, scaler, val;
+    uint8_t value_type = SML_UNDEFINED;
+    for (size_t i = 0; i != count; i++) {
+      if (!this->read_value_(&value, &type))
+        return false;
+      switch (i) {
+        case 0:
+          code = value;
+          break;
+        case 1:
+          status = value;
+          break;
+        case 3:
+          unit = value;
+          break;
+        case 4:
+          scaler = value;
+          break;
+        case 5:
+          val = value;
+          value_type = type;
+          break;
+        default:
+          break;
+      }
     }
+    if (count >= 6)
+      callback(ObisInfo(server_id, code, status, bytes_to_uint(unit), bytes_to_int(scaler), val, value_type));
   }
-  return obis_info;
+  return true;
 }
 
-std::string bytes_repr(const bytes &buffer) {
+std::string bytes_repr(const BytesView &buffer) {
   std::string repr;
   for (auto const value : buffer) {
     repr += str_sprintf("%02x", value & 0xff);
@@ -83,7 +162,7 @@ std::string bytes_repr(const bytes &buffer) {
   return repr;
 }
 
-uint64_t bytes_to_uint(const bytes &buffer) {
+uint64_t bytes_to_uint(const BytesView &buffer) {
   uint64_t val = 0;
   for (auto const value : buffer) {
     val = (val << 8) + value;
@@ -96,7 +175,7 @@ uint64_t bytes_to_uint(const bytes &buffer) {
   return val;
 }
 
-int64_t bytes_to_int(const bytes &buffer) {
+int64_t bytes_to_int(const BytesView &buffer) {
   uint64_t tmp = bytes_to_uint(buffer);
   int64_t val;
 
@@ -116,17 +195,17 @@ int64_t bytes_to_int(const bytes &buffer) {
   return val;
 }
 
-std::string bytes_to_string(const bytes &buffer) { return std::string(buffer.begin(), buffer.end()); }
-
-ObisInfo::ObisInfo(bytes server_id, SmlNode val_list_entry) : server_id(std::move(server_id)) {
-  this->code = val_list_entry.nodes[0].value_bytes;
-  this->status = val_list_entry.nodes[1].value_bytes;
-  this->unit = bytes_to_uint(val_list_entry.nodes[3].value_bytes);
-  this->scaler = bytes_to_int(val_list_entry.nodes[4].value_bytes);
-  SmlNode value_node = val_list_entry.nodes[5];
-  this->value = value_node.value_bytes;
-  this->value_type = value_node.type;
-}
+std::string bytes_to_string(const BytesView &buffer) { return std::string(buffer.begin(), buffer.end()); }
+
+ObisInfo::ObisInfo(BytesView server_id, BytesView code, BytesView status, char unit, char scaler, BytesView value,
+                   uint16_t value_type)
+    : server_id(server_id),
+      code(code),
+      status(status),
+      unit(unit),
+      scaler(scaler),
+      value(value),
+      value_type(value_type) {}
 
 std::string ObisInfo::code_repr() const {
   return str_sprintf("%d-%d:%d.%d.%d", this->code[0], this->code[1], this->code[2], this->code[3], this->code[4]);
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <functional>
 #include <string>
 #include <vector>
 #include "constants.h"
@@ -11,44 +12,67 @@ namespace sml {
 
 using bytes = std::vector<uint8_t>;
 
-class SmlNode {
+/// Non-owning view of a range of bytes, e.g. a value inside a received SML file.
+class BytesView {
  public:
-  uint8_t type;
-  bytes value_bytes;
-  std::vector<SmlNode> nodes;
+  BytesView() = default;
+  BytesView(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+  BytesView(const bytes &buffer) : data_(buffer.data()), size_(buffer.size()) {}  // NOLINT(google-explicit-constructor)
+
+  const uint8_t *begin() const { return this->data_; }
+  const uint8_t *end() const { return this->data_ + this->size_; }
+  size_t size() const { return this->size_; }
+  bool empty() const { return this->size_ == 0; }
+  uint8_t operator[](size_t index) const { return this->data_[index]; }
+
+ protected:
+  const uint8_t *data_{nullptr};
+  size_t size_{0};
 };
 
+/// One entry of a get list response. The views point into the SML file and are only valid while it is parsed.
 class ObisInfo {
  public:
-  ObisInfo(bytes server_id, SmlNode val_list_entry);
-  bytes server_id;
-  bytes code;
-  bytes status;
+  ObisInfo(BytesView server_id, BytesView code, BytesView status, char unit, char scaler, BytesView value,
+           uint16_t value_type);
+  BytesView server_id;
+  BytesView code;
+  BytesView status;
   char unit;
   char scaler;
-  bytes value;
+  BytesView value;
   uint16_t value_type;
   std::string code_repr() const;
 };
 
+/// Reads the OBIS entries of an SML file in a single pass, without building a tree of its nodes.
 class SmlFile {
  public:
-  SmlFile(bytes buffer);
-  bool setup_node(SmlNode *node);
-  std::vector<SmlNode> messages;
-  std::vector<ObisInfo> get_obis_info();
+  SmlFile(BytesView buffer);
+  /// Call callback for every entry of the get list responses in the file.
+  void for_each_obis_info(const std::function<void(const ObisInfo &)> &callback);
 
  protected:
-  const bytes buffer_;
-  size_t pos_;
+  /// Read the type-length field at the current position. Returns false if the node doesn't fit in the buffer.
+  bool read_tl_(uint8_t *type, size_t *length, bool *is_end);
+  /// Move past the node at the current position, including all its children.
+  bool skip_node_();
+  /// Read the node at the current position. For lists only the type is returned and the list is skipped.
+  bool read_value_(BytesView *value, uint8_t *type);
+  /// Move into the list at the current position and return its number of children.
+  bool enter_list_(size_t *count);
+  bool parse_message_(const std::function<void(const ObisInfo &)> &callback);
+
+  const BytesView buffer_;
+  size_t pos_{0};
 };
 
-std::string bytes_repr(const bytes &buffer);
+std::string bytes_repr(const BytesView &buffer);
 
-uint64_t bytes_to_uint(const bytes &buffer);
+uint64_t bytes_to_uint(const BytesView &buffer);
 
-int64_t bytes_to_int(const bytes &buffer);
+int64_t bytes_to_int(const BytesView &buffer);
 
-std::string bytes_to_string(const bytes &buffer);
+std::string bytes_to_string(const BytesView &buffer);
 }  // namespace sml
 }  // namespace esphome
@@ -39,15 +39,18 @@ void SN74HC595Component::digital_write_(uint16_t pin, bool value) {
 }
 
 void SN74HC595Component::write_gpio_() {
+  auto data_pin = FastGPIOPin::from(this->data_pin_);
+  auto clock_pin = FastGPIOPin::from(this->clock_pin_);
   for (auto bit = this->output_bits_.rbegin(); bit != this->output_bits_.rend(); bit++) {
-    this->data_pin_->digital_write(*bit);
-    this->clock_pin_->digital_write(true);
-    this->clock_pin_->digital_write(false);
+    data_pin.digital_write(*bit);
+    clock_pin.digital_write(true);
+    clock_pin.digital_write(false);
   }
 
   // pulse latch to activate new values
-  this->latch_pin_->digital_write(true);
-  this->latch_pin_->digital_write(false);
+  auto latch_pin = FastGPIOPin::from(this->latch_pin_);
+  latch_pin.digital_write(true);
+  latch_pin.digital_write(false);
 
   // enable output if configured
   if (this->have_oe_pin_) {
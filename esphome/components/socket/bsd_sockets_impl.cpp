@@ -1,10 +1,14 @@
 #include "socket.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
+#include <sys/select.h>
 
 #ifdef USE_ESP32
 #include <esp_idf_version.h>
@@ -38,9 +42,20 @@ std::string format_sockaddr(const struct sockaddr_storage &storage) {
   return {};
 }
 
+// Open sockets, watched together by wait_for_data()
+static std::vector<int> monitored_fds;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Readable sockets as of the last select(), new sockets count as readable until then
+static fd_set ready_fds;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
 class BSDSocketImpl : public Socket {
  public:
-  BSDSocketImpl(int fd) : fd_(fd) {}
+  BSDSocketImpl(int fd) : fd_(fd) {
+    if (fd_ >= 0 && fd_ < FD_SETSIZE) {
+      monitored_fds.push_back(fd_);
+      FD_SET(fd_, &ready_fds);
+      monitored_ = true;
+    }
+  }
   ~BSDSocketImpl() override {
     if (!closed_) {
       close();  // NOLINT(clang-analyzer-optin.cplusplus.VirtualCall)
@@ -54,6 +69,11 @@ class BSDSocketImpl : public Socket {
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
   int close() override {
+    if (monitored_) {
+      monitored_fds.erase(std::remove(monitored_fds.begin(), monitored_fds.end(), fd_), monitored_fds.end());
+      FD_CLR(fd_, &ready_fds);
+      monitored_ = false;
+    }
     int ret = ::close(fd_);
     closed_ = true;
     return ret;
@@ -117,12 +137,40 @@ class BSDSocketImpl : public Socket {
     ::fcntl(fd_, F_SETFL, fl);
     return 0;
   }
+  bool ready() const override { return !monitored_ || FD_ISSET(fd_, &ready_fds); }
 
  protected:
   int fd_;
   bool closed_ = false;
+  bool monitored_ = false;
 };
 
+bool wait_for_data(uint32_t timeout_ms) {
+  if (monitored_fds.empty()) {
+    delay(timeout_ms);
+    return false;
+  }
+  fd_set read_fds;
+  FD_ZERO(&read_fds);
+  int max_fd = -1;
+  for (int fd : monitored_fds) {
+    FD_SET(fd, &read_fds);
+    max_fd = std::max(max_fd, fd);
+  }
+  struct timeval tv;
+  tv.tv_sec = timeout_ms / 1000;
+  tv.tv_usec = (timeout_ms % 1000) * 1000;
+  int ret = ::select(max_fd + 1, &read_fds, nullptr, nullptr, &tv);
+  if (ret < 0) {
+    // e.g. interrupted, let every socket be polled again
+    for (int fd : monitored_fds)
+      FD_SET(fd, &ready_fds);
+    return false;
+  }
+  ready_fds = read_fds;
+  return ret > 0;
+}
+
 std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
   int ret = ::socket(domain, type, protocol);
   if (ret == -1)
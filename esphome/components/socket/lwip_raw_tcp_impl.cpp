@@ -380,7 +380,8 @@ class LWIPRawImpl : public Socket {
     }
     return ret;
   }
-  ssize_t internal_write(const void *buf, size_t len) {
+  /// Queue data in lwIP without sending it, more signals that the caller has more data for the same segment.
+  ssize_t internal_write(const void *buf, size_t len, bool more = false) {
     if (pcb_ == nullptr) {
       errno = ECONNRESET;
       return -1;
@@ -398,7 +399,10 @@ class LWIPRawImpl : public Socket {
     }
     size_t to_send = std::min((size_t) space, len);
     LWIP_LOG("tcp_write(%p buf=%p %u)", pcb_, buf, to_send);
-    err_t err = tcp_write(pcb_, buf, to_send, TCP_WRITE_FLAG_COPY);
+    uint8_t flags = TCP_WRITE_FLAG_COPY;
+    if (more || to_send != len)
+      flags |= TCP_WRITE_FLAG_MORE;
+    err_t err = tcp_write(pcb_, buf, to_send, flags);
     if (err == ERR_MEM) {
       LWIP_LOG("  -> err ERR_MEM");
       errno = EWOULDBLOCK;
@@ -446,7 +450,8 @@ class LWIPRawImpl : public Socket {
   ssize_t writev(const struct iovec *iov, int iovcnt) override {
     ssize_t written = 0;
     for (int i = 0; i < iovcnt; i++) {
-      ssize_t err = internal_write(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len);
+      // all iovecs are queued before a single tcp_output(), so they share segments
+      ssize_t err = internal_write(reinterpret_cast<uint8_t *>(iov[i].iov_base), iov[i].iov_len, i + 1 < iovcnt);
       if (err == -1) {
         if (written != 0)
           // if we already read some don't return an error
@@ -471,6 +476,10 @@ class LWIPRawImpl : public Socket {
     // return ::sendto(fd_, buf, len, flags, to, tolen);
     return 0;
   }
+  // the lwIP callbacks fill these, so readiness is known without polling
+  bool ready() const override {
+    return pcb_ == nullptr || rx_buf_ != nullptr || rx_closed_ || !accepted_sockets_.empty();
+  }
   int setblocking(bool blocking) override {
     if (pcb_ == nullptr) {
       errno = ECONNRESET;
@@ -38,6 +38,11 @@ class Socket {
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+  /** Returns false if read() or accept() would certainly block, so polling them can be skipped.
+   *
+   * Implementations that don't track readiness always return true.
+   */
+  virtual bool ready() const { return true; }
 };
 
 /// Create a socket of the given domain, type and protocol.
@@ -52,5 +57,13 @@ socklen_t set_sockaddr(struct sockaddr *addr, socklen_t addrlen, const std::stri
 /// Set a sockaddr to the any address and specified port for the IP version used by socket_ip().
 socklen_t set_sockaddr_any(struct sockaddr *addr, socklen_t addrlen, uint16_t port);
 
+#ifdef USE_SOCKET_SELECT_SUPPORT
+/** Wait up to timeout_ms until one of the open sockets is readable, with a single select() call.
+ *
+ * Updates what Socket::ready() returns until the next call. Returns true if a socket is readable.
+ */
+bool wait_for_data(uint32_t timeout_ms);
+#endif
+
 }  // namespace socket
 }  // namespace esphome
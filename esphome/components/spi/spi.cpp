@@ -79,7 +79,7 @@ void SPIDelegateDummy::begin_transaction() { ESP_LOGE(TAG, "SPIDevice not initia
 
 uint8_t SPIDelegateBitBash::transfer(uint8_t data) {
   // Clock starts out at idle level
-  this->clk_pin_->digital_write(clock_polarity_);
+  this->clk_pin_.digital_write(clock_polarity_);
   uint8_t out_data = 0;
 
   for (uint8_t i = 0; i < 8; i++) {
@@ -92,20 +92,20 @@ uint8_t SPIDelegateBitBash::transfer(uint8_t data) {
 
     if (clock_phase_ == CLOCK_PHASE_LEADING) {
       // sampling on leading edge
-      this->sdo_pin_->digital_write(data & (1 << shift));
+      this->sdo_pin_.digital_write(data & (1 << shift));
       this->cycle_clock_();
-      out_data |= uint8_t(this->sdi_pin_->digital_read()) << shift;
-      this->clk_pin_->digital_write(!this->clock_polarity_);
+      out_data |= uint8_t(this->sdi_pin_.digital_read()) << shift;
+      this->clk_pin_.digital_write(!this->clock_polarity_);
       this->cycle_clock_();
-      this->clk_pin_->digital_write(this->clock_polarity_);
+      this->clk_pin_.digital_write(this->clock_polarity_);
     } else {
       // sampling on trailing edge
       this->cycle_clock_();
-      this->clk_pin_->digital_write(!this->clock_polarity_);
-      this->sdo_pin_->digital_write(data & (1 << shift));
+      this->clk_pin_.digital_write(!this->clock_polarity_);
+      this->sdo_pin_.digital_write(data & (1 << shift));
       this->cycle_clock_();
-      out_data |= uint8_t(this->sdi_pin_->digital_read()) << shift;
-      this->clk_pin_->digital_write(this->clock_polarity_);
+      out_data |= uint8_t(this->sdi_pin_.digital_read()) << shift;
+      this->clk_pin_.digital_write(this->clock_polarity_);
     }
   }
   App.feed_wdt();
@@ -222,6 +222,37 @@ class SPIDelegate {
       this->transfer(ptr[i]);
   }
 
+  // write the contents of a buffer in the background where supported. The buffer must stay valid and unchanged
+  // until wait_async() returns, which is also done by any other transfer and by ending the transaction.
+  virtual void write_array_async(const uint8_t *ptr, size_t length) { this->write_array(ptr, length); }
+
+  // wait until at most max_pending of the background writes are still in progress.
+  virtual void wait_async(size_t max_pending = 0) {}
+
+  // send a command and an address, then transfer length bytes, as a single bus transaction where supported.
+  // cmd_bits (up to 16) and addr_bits (up to 32) are multiples of 8 and may be zero to skip that phase; both are sent
+  // most significant byte first. Either txbuf or rxbuf may be null.
+  virtual void transfer_cmd_addr(uint8_t cmd_bits, uint16_t cmd, uint8_t addr_bits, uint32_t addr,
+                                 const uint8_t *txbuf, uint8_t *rxbuf, size_t length) {
+    uint8_t header[6];
+    size_t header_len = 0;
+    for (int shift = cmd_bits - 8; shift >= 0; shift -= 8)
+      header[header_len++] = cmd >> shift;
+    for (int shift = addr_bits - 8; shift >= 0; shift -= 8)
+      header[header_len++] = addr >> shift;
+    if (header_len != 0)
+      this->write_array(header, header_len);
+    if (length == 0)
+      return;
+    if (rxbuf == nullptr) {
+      this->write_array(txbuf, length);
+    } else if (txbuf == nullptr) {
+      this->read_array(rxbuf, length);
+    } else {
+      this->transfer(txbuf, rxbuf, length);
+    }
+  }
+
   // read into a buffer, write nulls
   virtual void read_array(uint8_t *ptr, size_t length) {
     for (size_t i = 0; i != length; i++)
@@ -260,7 +291,10 @@ class SPIDelegateBitBash : public SPIDelegate {
  public:
   SPIDelegateBitBash(uint32_t clock, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin, GPIOPin *clk_pin,
                      GPIOPin *sdo_pin, GPIOPin *sdi_pin)
-      : SPIDelegate(clock, bit_order, mode, cs_pin), clk_pin_(clk_pin), sdo_pin_(sdo_pin), sdi_pin_(sdi_pin) {
+      : SPIDelegate(clock, bit_order, mode, cs_pin),
+        clk_pin_(FastGPIOPin::from(clk_pin)),
+        sdo_pin_(FastGPIOPin::from(sdo_pin)),
+        sdi_pin_(FastGPIOPin::from(sdi_pin)) {
     // this calculation is pretty meaningless except at very low bit rates.
     this->wait_cycle_ = uint32_t(arch_get_cpu_freq_hz()) / this->data_rate_ / 2ULL;
     this->clock_polarity_ = Utility::get_polarity(this->mode_);
@@ -270,9 +304,9 @@ class SPIDelegateBitBash : public SPIDelegate {
   uint8_t transfer(uint8_t data) override;
 
  protected:
-  GPIOPin *clk_pin_;
-  GPIOPin *sdo_pin_;
-  GPIOPin *sdi_pin_;
+  FastGPIOPin clk_pin_;
+  FastGPIOPin sdo_pin_;
+  FastGPIOPin sdi_pin_;
   uint32_t last_transition_{0};
   uint32_t wait_cycle_;
   SPIClockPolarity clock_polarity_;
@@ -427,6 +461,18 @@ class SPIDevice : public SPIClient {
 
   void write_array(const uint8_t *data, size_t length) { this->delegate_->write_array(data, length); }
 
+  /// Write \p data while the CPU carries on, it must not be touched until wait_async() or disable().
+  void write_array_async(const uint8_t *data, size_t length) { this->delegate_->write_array_async(data, length); }
+
+  /// Wait for the writes started with write_array_async(), until at most \p max_pending are still queued.
+  void wait_async(size_t max_pending = 0) { this->delegate_->wait_async(max_pending); }
+
+  /// Send a command and an address followed by \p length data bytes; on ESP-IDF this is one DMA transaction.
+  void transfer_cmd_addr(uint8_t cmd_bits, uint16_t cmd, uint8_t addr_bits, uint32_t addr, const uint8_t *txbuf,
+                         uint8_t *rxbuf, size_t length) {
+    this->delegate_->transfer_cmd_addr(cmd_bits, cmd, addr_bits, addr, txbuf, rxbuf, length);
+  }
+
   template<size_t N> void write_array(const std::array<uint8_t, N> &data) { this->write_array(data.data(), N); }
 
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
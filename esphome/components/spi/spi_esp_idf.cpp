@@ -7,18 +7,22 @@ namespace spi {
 #ifdef USE_ESP_IDF
 static const char *const TAG = "spi-esp-idf";
 static const size_t MAX_TRANSFER_SIZE = 4092;  // dictated by ESP-IDF API.
+static const size_t ASYNC_QUEUE_SIZE = 4;
 
 class SPIDelegateHw : public SPIDelegate {
  public:
   SPIDelegateHw(SPIInterface channel, uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin,
-                bool write_only)
-      : SPIDelegate(data_rate, bit_order, mode, cs_pin), channel_(channel), write_only_(write_only) {
+                bool write_only, SPIDelegateHw **bus_owner)
+      : SPIDelegate(data_rate, bit_order, mode, cs_pin),
+        channel_(channel),
+        write_only_(write_only),
+        bus_owner_(bus_owner) {
     spi_device_interface_config_t config = {};
     config.mode = static_cast<uint8_t>(mode);
     config.clock_speed_hz = static_cast<int>(data_rate);
     config.spics_io_num = -1;
     config.flags = 0;
-    config.queue_size = 1;
+    config.queue_size = ASYNC_QUEUE_SIZE;
     config.pre_cb = nullptr;
     config.post_cb = nullptr;
     if (bit_order == BIT_ORDER_LSB_FIRST)
@@ -34,8 +38,7 @@ class SPIDelegateHw : public SPIDelegate {
 
   void begin_transaction() override {
     if (this->is_ready()) {
-      if (spi_device_acquire_bus(this->handle_, portMAX_DELAY) != ESP_OK)
-        ESP_LOGE(TAG, "Failed to acquire SPI bus");
+      this->acquire_bus_();
       SPIDelegate::begin_transaction();
     } else {
       ESP_LOGW(TAG, "spi_setup called before initialisation");
@@ -44,12 +47,15 @@ class SPIDelegateHw : public SPIDelegate {
 
   void end_transaction() override {
     if (this->is_ready()) {
+      this->wait_async();
       SPIDelegate::end_transaction();
-      spi_device_release_bus(this->handle_);
     }
   }
 
   ~SPIDelegateHw() override {
+    this->wait_async();
+    if (*this->bus_owner_ == this)
+      this->release_bus_();
     esp_err_t const err = spi_bus_remove_device(this->handle_);
     if (err != ESP_OK)
       ESP_LOGE(TAG, "Remove device failed - err %X", err);
@@ -57,13 +63,14 @@ class SPIDelegateHw : public SPIDelegate {
 
   // do a transfer. either txbuf or rxbuf (but not both) may be null.
   // transfers above the maximum size will be split.
-  // TODO - make use of the queue for interrupt transfers to provide a (short) pipeline of blocks
-  // when splitting is required.
   void transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length) override {
     if (rxbuf != nullptr && this->write_only_) {
       ESP_LOGE(TAG, "Attempted read from write-only channel");
       return;
     }
+    // keep the order of bytes on the bus
+    this->wait_async();
+    this->acquire_bus_();
     spi_transaction_t desc = {};
     desc.flags = 0;
     while (length != 0) {
@@ -104,6 +111,39 @@ class SPIDelegateHw : public SPIDelegate {
 
   void write_array(const uint8_t *ptr, size_t length) override { this->transfer(ptr, nullptr, length); }
 
+  // queue interrupt driven DMA transfers, splitting them like transfer() does.
+  void write_array_async(const uint8_t *ptr, size_t length) override {
+    this->acquire_bus_();
+    while (length != 0) {
+      size_t const partial = std::min(length, MAX_TRANSFER_SIZE);
+      // the descriptors are reused in order, so the oldest one has to be done first
+      this->wait_async(ASYNC_QUEUE_SIZE - 1);
+      spi_transaction_t &desc = this->async_desc_[this->async_next_];
+      desc = {};
+      desc.length = partial * 8;
+      desc.tx_buffer = ptr;
+      esp_err_t const err = spi_device_queue_trans(this->handle_, &desc, portMAX_DELAY);
+      if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Queue transmit failed - err %X", err);
+        break;
+      }
+      this->async_next_ = (this->async_next_ + 1) % ASYNC_QUEUE_SIZE;
+      this->async_pending_++;
+      length -= partial;
+      ptr += partial;
+    }
+  }
+
+  void wait_async(size_t max_pending = 0) override {
+    while (this->async_pending_ > max_pending) {
+      spi_transaction_t *desc;
+      esp_err_t const err = spi_device_get_trans_result(this->handle_, &desc, portMAX_DELAY);
+      if (err != ESP_OK)
+        ESP_LOGE(TAG, "Transmit failed - err %X", err);
+      this->async_pending_--;
+    }
+  }
+
   void write_array16(const uint16_t *data, size_t length) override {
     if (this->bit_order_ == BIT_ORDER_LSB_FIRST) {
       this->write_array((uint8_t *) data, length * 2);
@@ -122,10 +162,64 @@ class SPIDelegateHw : public SPIDelegate {
 
   void read_array(uint8_t *ptr, size_t length) override { this->transfer(nullptr, ptr, length); }
 
+  // the command and address phases of the controller send the header in the same transaction as the data.
+  void transfer_cmd_addr(uint8_t cmd_bits, uint16_t cmd, uint8_t addr_bits, uint32_t addr, const uint8_t *txbuf,
+                         uint8_t *rxbuf, size_t length) override {
+    if (this->bit_order_ == BIT_ORDER_LSB_FIRST || (rxbuf != nullptr && this->write_only_)) {
+      SPIDelegate::transfer_cmd_addr(cmd_bits, cmd, addr_bits, addr, txbuf, rxbuf, length);
+      return;
+    }
+    this->wait_async();
+    this->acquire_bus_();
+    size_t const partial = std::min(length, MAX_TRANSFER_SIZE);
+    spi_transaction_ext_t desc = {};
+    desc.base.flags = SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR;
+    desc.base.cmd = cmd;
+    desc.base.addr = addr;
+    desc.base.length = partial * 8;
+    desc.base.rxlength = this->write_only_ ? 0 : partial * 8;
+    desc.base.tx_buffer = txbuf;
+    desc.base.rx_buffer = rxbuf;
+    desc.command_bits = cmd_bits;
+    desc.address_bits = addr_bits;
+    esp_err_t const err = spi_device_transmit(this->handle_, &desc.base);
+    if (err != ESP_OK) {
+      ESP_LOGE(TAG, "Transmit failed - err %X", err);
+      return;
+    }
+    if (partial != length)
+      this->transfer(txbuf == nullptr ? nullptr : txbuf + partial, rxbuf == nullptr ? nullptr : rxbuf + partial,
+                     length - partial);
+  }
+
  protected:
+  // The bus stays acquired by the device that used it last, so that consecutive transactions of the same device
+  // don't have to take the bus lock and reconfigure the controller. It is handed over when another device needs it.
+  void acquire_bus_() {
+    if (*this->bus_owner_ == this)
+      return;
+    if (*this->bus_owner_ != nullptr)
+      (*this->bus_owner_)->release_bus_();
+    if (spi_device_acquire_bus(this->handle_, portMAX_DELAY) != ESP_OK) {
+      ESP_LOGE(TAG, "Failed to acquire SPI bus");
+      return;
+    }
+    *this->bus_owner_ = this;
+  }
+
+  void release_bus_() {
+    this->wait_async();
+    spi_device_release_bus(this->handle_);
+    *this->bus_owner_ = nullptr;
+  }
+
   SPIInterface channel_{};
   spi_device_handle_t handle_{};
   bool write_only_{false};
+  SPIDelegateHw **bus_owner_;
+  spi_transaction_t async_desc_[ASYNC_QUEUE_SIZE]{};
+  size_t async_next_{0};
+  size_t async_pending_{0};
 };
 
 class SPIBusHw : public SPIBus {
@@ -145,11 +239,12 @@ class SPIBusHw : public SPIBus {
 
   SPIDelegate *get_delegate(uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin) override {
     return new SPIDelegateHw(this->channel_, data_rate, bit_order, mode, cs_pin,
-                             Utility::get_pin_no(this->sdi_pin_) == -1);
+                             Utility::get_pin_no(this->sdi_pin_) == -1, &this->bus_owner_);
   }
 
  protected:
   SPIInterface channel_{};
+  SPIDelegateHw *bus_owner_{nullptr};
 
   bool is_hw() override { return true; }
 };
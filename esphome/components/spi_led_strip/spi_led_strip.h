@@ -24,7 +24,7 @@ class SpiLedStrip : public light::AddressableLight,
   }
   void set_num_leds(uint16_t num_leds) {
     this->num_leds_ = num_leds;
-    ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    ExternalRAMAllocator<uint8_t> allocator(HeapTag::LIGHT, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
     this->buffer_size_ = num_leds * 4 + 8;
     this->buf_ = allocator.allocate(this->buffer_size_);
     if (this->buf_ == nullptr) {
@@ -41,6 +41,18 @@ class SpiLedStrip : public light::AddressableLight,
     }
     memset(this->buf_, 0xFF, this->buffer_size_);
     memset(this->buf_, 0, 4);
+
+#ifdef USE_ESP32
+    // buf_ may be in PSRAM, which the SPI DMA can't read
+    this->tx_buf_ = static_cast<uint8_t *>(heap_caps_malloc(this->buffer_size_, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL));
+#else
+    this->tx_buf_ = allocator.allocate(this->buffer_size_);
+#endif
+    if (this->tx_buf_ == nullptr) {
+      esph_log_e(TAG, "Failed to allocate transmit buffer of size %u", this->buffer_size_);
+      this->mark_failed();
+      return;
+    }
   }
 
   void dump_config() {
@@ -64,8 +76,11 @@ class SpiLedStrip : public light::AddressableLight,
       }
       esph_log_v(TAG, "write_state: buf = %s", strbuf);
     }
+    // the start frame, the brightness bytes and the end frame are constant in buf_, so this is one plain copy
+    memcpy(this->tx_buf_, this->buf_, this->buffer_size_);
+    // the transaction ends before returning, an open one would hold the bus for every other device on it
     this->enable();
-    this->write_array(this->buf_, this->buffer_size_);
+    this->write_array(this->tx_buf_, this->buffer_size_);
     this->disable();
   }
 
@@ -84,6 +99,8 @@ class SpiLedStrip : public light::AddressableLight,
   size_t buffer_size_{};
   uint8_t *effect_data_{nullptr};
   uint8_t *buf_{nullptr};
+  /// A copy of buf_ in DMA capable memory that is sent.
+  uint8_t *tx_buf_{nullptr};
   uint16_t num_leds_;
 };
 
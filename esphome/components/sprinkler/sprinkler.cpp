@@ -387,8 +387,10 @@ SprinklerValveOperator *SprinklerValveRunRequest::valve_operator() { return this
 SprinklerValveRunRequestOrigin SprinklerValveRunRequest::request_is_from() { return this->origin_; }
 
 void Sprinkler::setup() {
-  this->timer_.push_back({this->name_ + "sm", false, 0, 0, std::bind(&Sprinkler::sm_timer_callback_, this)});
-  this->timer_.push_back({this->name_ + "vs", false, 0, 0, std::bind(&Sprinkler::valve_selection_callback_, this)});
+  this->timer_.push_back({fnv1_hash_constexpr("sprinkler_sm"), false, 0, 0,
+                          std::bind(&Sprinkler::sm_timer_callback_, this), SCHEDULER_INVALID_HANDLE});
+  this->timer_.push_back({fnv1_hash_constexpr("sprinkler_vs"), false, 0, 0,
+                          std::bind(&Sprinkler::valve_selection_callback_, this), SCHEDULER_INVALID_HANDLE});
   this->all_valves_off_(true);
 }
 
@@ -738,7 +740,11 @@ uint32_t Sprinkler::valve_run_duration_adjusted(const size_t valve_number) {
   if (this->is_a_valid_valve(valve_number)) {
     run_duration = this->valve_run_duration(valve_number);
   }
-  run_duration = static_cast<uint32_t>(roundf(run_duration * this->multiplier()));
+  return this->adjust_run_duration_(run_duration, this->multiplier());
+}
+
+uint32_t Sprinkler::adjust_run_duration_(uint32_t run_duration, const float multiplier) {
+  run_duration = static_cast<uint32_t>(roundf(run_duration * multiplier));
   // run_duration must not be less than any of these
   if ((run_duration < this->start_delay_) || (run_duration < this->stop_delay_) ||
       (run_duration < this->switching_delay_.value_or(0) * 2)) {
@@ -1107,64 +1113,9 @@ uint32_t Sprinkler::total_cycle_time_all_valves() {
   return total_time_remaining;
 }
 
-uint32_t Sprinkler::total_cycle_time_enabled_valves() {
-  uint32_t total_time_remaining = 0;
-  uint32_t valve_count = 0;
-
-  for (size_t valve = 0; valve < this->number_of_valves(); valve++) {
-    if (this->valve_is_enabled_(valve)) {
-      total_time_remaining += this->valve_run_duration_adjusted(valve);
-      valve_count++;
-    }
-  }
-
-  if (valve_count) {
-    if (this->valve_overlap_) {
-      total_time_remaining -= this->switching_delay_.value_or(0) * (valve_count - 1);
-    } else {
-      total_time_remaining += this->switching_delay_.value_or(0) * (valve_count - 1);
-    }
-  }
-
-  return total_time_remaining;
-}
-
-uint32_t Sprinkler::total_cycle_time_enabled_incomplete_valves() {
-  uint32_t total_time_remaining = 0;
-  uint32_t enabled_valve_count = 0;
-  uint32_t incomplete_valve_count = 0;
-
-  for (size_t valve = 0; valve < this->number_of_valves(); valve++) {
-    if (this->valve_is_enabled_(valve)) {
-      enabled_valve_count++;
-      if (!this->valve_cycle_complete_(valve)) {
-        if (!this->active_valve().has_value() || (valve != this->active_valve().value())) {
-          total_time_remaining += this->valve_run_duration_adjusted(valve);
-          incomplete_valve_count++;
-        } else {
-          // to get here, there must be an active valve and this valve must be equal to 'valve'
-          if (this->active_req_.valve_operator() == nullptr) {  // no SVO has been assigned yet so it hasn't started
-            total_time_remaining += this->valve_run_duration_adjusted(valve);
-            incomplete_valve_count++;
-          }
-        }
-      }
-    }
-  }
-
-  if (incomplete_valve_count >= enabled_valve_count) {
-    incomplete_valve_count--;
-  }
-  if (incomplete_valve_count) {
-    if (this->valve_overlap_) {
-      total_time_remaining -= this->switching_delay_.value_or(0) * incomplete_valve_count;
-    } else {
-      total_time_remaining += this->switching_delay_.value_or(0) * incomplete_valve_count;
-    }
-  }
+uint32_t Sprinkler::total_cycle_time_enabled_valves() { return this->plan_cycle_().enabled_valves_time; }
 
-  return total_time_remaining;
-}
+uint32_t Sprinkler::total_cycle_time_enabled_incomplete_valves() { return this->plan_cycle_().incomplete_valves_time; }
 
 uint32_t Sprinkler::total_queue_time() {
   uint32_t total_time_remaining = 0;
@@ -1211,10 +1162,11 @@ optional<uint32_t> Sprinkler::time_remaining_current_operation() {
 
   auto total_time_remaining = this->time_remaining_active_valve().value_or(0);
   if (this->auto_advance()) {
-    total_time_remaining += this->total_cycle_time_enabled_incomplete_valves();
+    const SprinklerCyclePlan plan = this->plan_cycle_();
+    total_time_remaining += plan.incomplete_valves_time;
     if (this->repeat().value_or(0) > 0) {
       total_time_remaining +=
-          (this->total_cycle_time_enabled_valves() * (this->repeat().value_or(0) - this->repeat_count().value_or(0)));
+          (plan.enabled_valves_time * (this->repeat().value_or(0) - this->repeat_count().value_or(0)));
     }
   }
 
@@ -1463,6 +1415,47 @@ void Sprinkler::reset_cycle_states_() {
   }
 }
 
+SprinklerCyclePlan Sprinkler::plan_cycle_() {
+  const float multiplier = this->multiplier();
+  const optional<size_t> active_valve = this->active_valve();
+  // the active valve still counts as incomplete until a valve operator has started it
+  const bool active_started = this->active_req_.valve_operator() != nullptr;
+  uint32_t enabled_time = 0;
+  uint32_t incomplete_time = 0;
+  uint32_t enabled_valve_count = 0;
+  uint32_t incomplete_valve_count = 0;
+
+  for (size_t valve = 0; valve < this->number_of_valves(); valve++) {
+    if (!this->valve_is_enabled_(valve)) {
+      continue;
+    }
+    const uint32_t run_duration = this->adjust_run_duration_(this->valve_run_duration(valve), multiplier);
+    enabled_time += run_duration;
+    enabled_valve_count++;
+    if (!this->valve_[valve].valve_cycle_complete &&
+        (!active_valve.has_value() || valve != active_valve.value() || !active_started)) {
+      incomplete_time += run_duration;
+      incomplete_valve_count++;
+    }
+  }
+
+  if (incomplete_valve_count >= enabled_valve_count && incomplete_valve_count) {
+    incomplete_valve_count--;
+  }
+  return {
+      .enabled_valves_time =
+          enabled_valve_count ? this->apply_switching_delay_(enabled_time, enabled_valve_count - 1) : enabled_time,
+      .incomplete_valves_time = this->apply_switching_delay_(incomplete_time, incomplete_valve_count),
+  };
+}
+
+uint32_t Sprinkler::apply_switching_delay_(const uint32_t time, const uint32_t valve_count) {
+  if (this->valve_overlap_) {
+    return time - this->switching_delay_.value_or(0) * valve_count;
+  }
+  return time + this->switching_delay_.value_or(0) * valve_count;
+}
+
 void Sprinkler::fsm_request_(size_t requested_valve, uint32_t requested_run_duration) {
   this->next_req_.set_valve(requested_valve);
   this->next_req_.set_run_duration(requested_run_duration);
@@ -1635,8 +1628,8 @@ std::string Sprinkler::state_as_str_(SprinklerState state) {
 
 void Sprinkler::start_timer_(const SprinklerTimerIndex timer_index) {
   if (this->timer_duration_(timer_index) > 0) {
-    this->set_timeout(this->timer_[timer_index].name, this->timer_duration_(timer_index),
-                      this->timer_cbf_(timer_index));
+    SprinklerTimer &timer = this->timer_[timer_index];
+    timer.handle = this->set_timeout(timer.id, this->timer_duration_(timer_index), this->timer_cbf_(timer_index));
     this->timer_[timer_index].start_time = millis();
     this->timer_[timer_index].active = true;
   }
@@ -1646,7 +1639,7 @@ void Sprinkler::start_timer_(const SprinklerTimerIndex timer_index) {
 
 bool Sprinkler::cancel_timer_(const SprinklerTimerIndex timer_index) {
   this->timer_[timer_index].active = false;
-  return this->cancel_timeout(this->timer_[timer_index].name);
+  return this->cancel_scheduled(this->timer_[timer_index].handle);
 }
 
 bool Sprinkler::timer_active_(const SprinklerTimerIndex timer_index) { return this->timer_[timer_index].active; }
@@ -78,11 +78,18 @@ struct SprinklerQueueItem {
 };
 
 struct SprinklerTimer {
-  const std::string name;
+  const uint32_t id;
   bool active;
   uint32_t time;
   uint32_t start_time;
   std::function<void()> func;
+  SchedulerHandle handle;
+};
+
+/// Run times of one cycle, worked out in a single pass over the valves
+struct SprinklerCyclePlan {
+  uint32_t enabled_valves_time;     // all enabled valves, including switching delays
+  uint32_t incomplete_valves_time;  // enabled valves still to run in this cycle, not including the active valve
 };
 
 struct SprinklerValve {
@@ -472,6 +479,15 @@ class Sprinkler : public Component {
   /// resets the cycle state for all valves
   void reset_cycle_states_();
 
+  /// returns the run times of the current cycle, adjusted by the multiplier and with the switching delays applied
+  SprinklerCyclePlan plan_cycle_();
+
+  /// returns run_duration adjusted by the multiplier and raised to the minimum the delays require
+  uint32_t adjust_run_duration_(uint32_t run_duration, float multiplier);
+
+  /// returns time with the switching delays between valve_count valves applied
+  uint32_t apply_switching_delay_(uint32_t time, uint32_t valve_count);
+
   /// make a request of the state machine
   void fsm_request_(size_t requested_valve, uint32_t requested_run_duration = 0);
 
@@ -147,15 +147,8 @@ void SPS30Component::update() {
     return;
   }
 
-  if (!this->write_command(SPS30_CMD_READ_MEASUREMENT)) {
-    ESP_LOGW(TAG, "Error reading measurement status!");
-    this->status_set_warning();
-    return;
-  }
-
-  this->set_timeout(50, [this]() {
-    uint16_t raw_data[20];
-    if (!this->read_data(raw_data, 20)) {
+  this->read_register_async(this, SPS30_CMD_READ_MEASUREMENT, 20, 50, [this](const uint16_t *raw_data) {
+    if (raw_data == nullptr) {
       ESP_LOGW(TAG, "Error reading measurement data!");
       this->status_set_warning();
       return;
@@ -90,14 +90,40 @@ void SSD1351::setup() {
   this->turn_on();           // display ON
 }
 void SSD1351::display() {
-  this->command(SSD1351_SETCOLUMN);  // set column address
-  this->data(0x00);                  // set column start address
-  this->data(0x7F);                  // set column end address
-  this->command(SSD1351_SETROW);     // set row address
-  this->data(0x00);                  // set row start address
-  this->data(0x7F);                  // set last row
-  this->command(SSD1351_WRITERAM);
-  this->write_display_data();
+  // Send the rows of the changed regions, full rows are contiguous in the buffer
+  uint8_t count = this->get_dirty_count_();
+  int16_t first[display::DISPLAY_MAX_DIRTY_RECTS], last[display::DISPLAY_MAX_DIRTY_RECTS];
+  // sort the row ranges by their first row
+  for (uint8_t i = 0; i < count; i++) {
+    const display::Rect &rect = this->get_dirty_rects_()[i];
+    uint8_t j = i;
+    for (; j > 0 && first[j - 1] > rect.y; j--) {
+      first[j] = first[j - 1];
+      last[j] = last[j - 1];
+    }
+    first[j] = rect.y;
+    last[j] = rect.y2() - 1;
+  }
+  this->clear_dirty_();
+
+  const size_t row_size = this->get_width_internal() * SSD1351_BYTESPERPIXEL;
+  uint8_t i = 0;
+  while (i < count) {
+    // merge the row ranges that overlap or touch
+    int16_t row_start = first[i];
+    int16_t row_end = last[i++];
+    while (i < count && first[i] <= row_end + 1)
+      row_end = std::max(row_end, last[i++]);
+
+    this->command(SSD1351_SETCOLUMN);  // set column address
+    this->data(0x00);                  // set column start address
+    this->data(0x7F);                  // set column end address
+    this->command(SSD1351_SETROW);     // set row address
+    this->data(row_start);             // set row start address
+    this->data(row_end);               // set last row
+    this->command(SSD1351_WRITERAM);
+    this->write_display_data(this->buffer_ + row_start * row_size, (row_end - row_start + 1) * row_size);
+  }
 }
 void SSD1351::update() {
   this->do_update_();
@@ -153,17 +179,24 @@ void HOT SSD1351::draw_absolute_pixel_internal(int x, int y, Color color) {
   const uint32_t color565 = display::ColorUtil::color_to_565(color);
   // where should the bits go in the big buffer array? math...
   uint16_t pos = (x + y * this->get_width_internal()) * SSD1351_BYTESPERPIXEL;
+  if (this->buffer_[pos] == ((color565 >> 8) & 0xff) && this->buffer_[pos + 1] == (color565 & 0xff))
+    return;
   this->buffer_[pos++] = (color565 >> 8) & 0xff;
   this->buffer_[pos] = color565 & 0xff;
+  this->mark_dirty_(x, y);
 }
 void SSD1351::fill(Color color) {
   const uint32_t color565 = display::ColorUtil::color_to_565(color);
-  for (uint32_t i = 0; i < this->get_buffer_length_(); i++) {
-    if (i & 1) {
-      this->buffer_[i] = color565 & 0xff;
-    } else {
-      this->buffer_[i] = (color565 >> 8) & 0xff;
-    }
+  const uint8_t high = (color565 >> 8) & 0xff;
+  const uint8_t low = color565 & 0xff;
+  const int width = this->get_width_internal();
+  for (uint32_t i = 0; i < this->get_buffer_length_(); i += SSD1351_BYTESPERPIXEL) {
+    if (this->buffer_[i] == high && this->buffer_[i + 1] == low)
+      continue;
+    this->buffer_[i] = high;
+    this->buffer_[i + 1] = low;
+    uint32_t pixel = i / SSD1351_BYTESPERPIXEL;
+    this->mark_dirty_(pixel % width, pixel / width);
   }
 }
 void SSD1351::init_reset_() {
@@ -36,7 +36,8 @@ class SSD1351 : public PollingComponent, public display::DisplayBuffer {
  protected:
   virtual void command(uint8_t value) = 0;
   virtual void data(uint8_t value) = 0;
-  virtual void write_display_data() = 0;
+  /// Write \p len bytes of pixel data after the RAM write command.
+  virtual void write_display_data(const uint8_t *data, size_t len) = 0;
   void init_reset_();
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
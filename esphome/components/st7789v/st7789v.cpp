@@ -1,4 +1,7 @@
 #include "st7789v.h"
+
+#include <utility>
+
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -25,7 +28,7 @@ void ST7789V::setup() {
 
   // *** display and color format setting ***
   this->write_command_(ST7789_MADCTL);
-  this->write_data_(ST7789_MADCTL_COLOR_ORDER);
+  this->write_data_(this->apply_rotation_());
 
   // JLX240 display datasheet
   this->write_command_(0xB6);
@@ -145,13 +148,47 @@ void ST7789V::update() {
   this->write_display_data();
 }
 
+uint8_t ST7789V::apply_rotation_() {
+  // Let the controller rotate, so the buffer is kept in the rotated orientation and pixels aren't transformed one by
+  // one. A panel smaller than the frame memory moves to its other end along the axes that get mirrored.
+  uint8_t madctl = display::rotate_madctl(ST7789_MADCTL_COLOR_ORDER, this->rotation_);
+  bool swap = madctl & ST7789_MADCTL_MV;
+  // with the axes swapped, the column address runs along the rows of the panel and MX mirrors those
+  bool mirror_columns = madctl & (swap ? ST7789_MADCTL_MY : ST7789_MADCTL_MX);
+  bool mirror_rows = madctl & (swap ? ST7789_MADCTL_MX : ST7789_MADCTL_MY);
+  uint16_t column_offset = this->offset_height_;
+  if (mirror_columns)
+    column_offset = ST7789_MEMORY_COLUMNS - this->width_ - this->offset_height_;
+  uint16_t row_offset = this->offset_width_;
+  if (mirror_rows)
+    row_offset = ST7789_MEMORY_ROWS - this->height_ - this->offset_width_;
+
+  if (swap) {
+    this->column_offset_ = row_offset;
+    this->row_offset_ = column_offset;
+    std::swap(this->width_, this->height_);
+  } else {
+    this->column_offset_ = column_offset;
+    this->row_offset_ = row_offset;
+  }
+  this->set_hardware_rotation_();
+  return madctl;
+}
+
 void ST7789V::set_model_str(const char *model_str) { this->model_str_ = model_str; }
 
 void ST7789V::write_display_data() {
-  uint16_t x1 = this->offset_height_;
-  uint16_t x2 = x1 + get_width_internal() - 1;
-  uint16_t y1 = this->offset_width_;
-  uint16_t y2 = y1 + get_height_internal() - 1;
+  // only the regions that changed since the last transfer are sent
+  for (uint8_t i = 0; i < this->get_dirty_count_(); i++)
+    this->write_display_window_(this->get_dirty_rects_()[i]);
+  this->clear_dirty_();
+}
+
+void ST7789V::write_display_window_(const display::Rect &window) {
+  uint16_t x1 = this->column_offset_ + window.x;
+  uint16_t x2 = x1 + window.w - 1;
+  uint16_t y1 = this->row_offset_ + window.y;
+  uint16_t y2 = y1 + window.h - 1;
 
   this->enable();
 
@@ -170,13 +207,14 @@ void ST7789V::write_display_data() {
   this->write_byte(ST7789_RAMWR);
   this->dc_pin_->digital_write(true);
 
+  const size_t width = this->get_width_internal();
   if (this->eightbitcolor_) {
     uint8_t temp_buffer[TEMP_BUFFER_SIZE];
     size_t temp_index = 0;
-    for (int line = 0; line < this->get_buffer_length_(); line = line + this->get_width_internal()) {
-      for (int index = 0; index < this->get_width_internal(); ++index) {
+    for (int line = window.y; line < window.y2(); line++) {
+      for (int index = window.x; index < window.x2(); ++index) {
         auto color = display::ColorUtil::color_to_565(
-            display::ColorUtil::to_color(this->buffer_[index + line], display::ColorOrder::COLOR_ORDER_RGB,
+            display::ColorUtil::to_color(this->buffer_[index + line * width], display::ColorOrder::COLOR_ORDER_RGB,
                                          display::ColorBitness::COLOR_BITNESS_332, true));
         temp_buffer[temp_index++] = (uint8_t) (color >> 8);
         temp_buffer[temp_index++] = (uint8_t) color;
@@ -188,8 +226,12 @@ void ST7789V::write_display_data() {
     }
     if (temp_index != 0)
       this->write_array(temp_buffer, temp_index);
+  } else if (size_t(window.w) == width) {
+    // full rows are contiguous in the buffer
+    this->write_array(this->buffer_ + window.y * width * 2, window.h * width * 2);
   } else {
-    this->write_array(this->buffer_, this->get_buffer_length_());
+    for (int line = window.y; line < window.y2(); line++)
+      this->write_array(this->buffer_ + (window.x + line * width) * 2, window.w * 2);
   }
 
   this->disable();
@@ -295,13 +337,18 @@ void HOT ST7789V::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (this->eightbitcolor_) {
     auto color332 = display::ColorUtil::color_to_332(color);
     uint32_t pos = (x + y * this->get_width_internal());
+    if (this->buffer_[pos] == color332)
+      return;
     this->buffer_[pos] = color332;
   } else {
     auto color565 = display::ColorUtil::color_to_565(color);
     uint32_t pos = (x + y * this->get_width_internal()) * 2;
+    if (this->buffer_[pos] == ((color565 >> 8) & 0xff) && this->buffer_[pos + 1] == (color565 & 0xff))
+      return;
     this->buffer_[pos++] = (color565 >> 8) & 0xff;
     this->buffer_[pos] = color565 & 0xff;
   }
+  this->mark_dirty_(x, y);
 }
 
 }  // namespace st7789v
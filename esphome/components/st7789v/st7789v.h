@@ -107,6 +107,10 @@ static const uint8_t ST7789_MADCTL_GS = 0x01;
 
 static const uint8_t ST7789_MADCTL_COLOR_ORDER = ST7789_MADCTL_BGR;
 
+// Size of the frame memory, smaller panels show a part of it
+static const uint16_t ST7789_MEMORY_COLUMNS = 240;
+static const uint16_t ST7789_MEMORY_ROWS = 320;
+
 class ST7789V : public PollingComponent,
                 public display::DisplayBuffer,
                 public spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW, spi::CLOCK_PHASE_LEADING,
@@ -150,8 +154,11 @@ class ST7789V : public PollingComponent,
   uint16_t width_{0};
   uint16_t offset_height_{0};
   uint16_t offset_width_{0};
+  uint16_t column_offset_{0};  ///< Column address of the panel's first pixel, with the rotation applied
+  uint16_t row_offset_{0};     ///< Row address of the panel's first pixel, with the rotation applied
 
   void init_reset_();
+  uint8_t apply_rotation_();
   void backlight_(bool onoff);
   void write_command_(uint8_t value);
   void write_data_(uint8_t value);
@@ -162,6 +169,8 @@ class ST7789V : public PollingComponent,
   int get_width_internal() override { return this->width_; }
   size_t get_buffer_length_();
 
+  void write_display_window_(const display::Rect &window);
+
   void draw_filled_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
@@ -14,11 +14,13 @@ TCA9548AChannel = tca9548a_ns.class_("TCA9548AChannel", i2c.I2CBus)
 MULTI_CONF = True
 
 CONF_BUS_ID = "bus_id"
+CONF_KEEP_CHANNEL_OPEN = "keep_channel_open"
 CONFIG_SCHEMA = (
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(TCA9548AComponent),
             cv.Optional(CONF_SCAN): cv.invalid("This option has been removed"),
+            cv.Optional(CONF_KEEP_CHANNEL_OPEN, default=False): cv.boolean,
             cv.Optional(CONF_CHANNELS, default=[]): cv.ensure_list(
                 {
                     cv.Required(CONF_BUS_ID): cv.declare_id(TCA9548AChannel),
@@ -36,6 +38,7 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await i2c.register_i2c_device(var, config)
+    cg.add(var.set_keep_channel_open(config[CONF_KEEP_CHANNEL_OPEN]))
 
     for conf in config[CONF_CHANNELS]:
         chan = cg.new_Pvariable(conf[CONF_BUS_ID])
@@ -1,4 +1,7 @@
 #include "tca9548a.h"
+
+#include <algorithm>
+
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -6,12 +9,18 @@ namespace tca9548a {
 
 static const char *const TAG = "tca9548a";
 
+/// All multiplexers, so one that leaves a channel open can close the others on its bus first.
+static std::vector<TCA9548AComponent *> &multiplexers() {
+  static std::vector<TCA9548AComponent *> multiplexers;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  return multiplexers;
+}
+
 i2c::ErrorCode TCA9548AChannel::readv(uint8_t address, i2c::ReadBuffer *buffers, size_t cnt) {
   auto err = this->parent_->switch_to_channel(channel_);
   if (err != i2c::ERROR_OK)
     return err;
   err = this->parent_->bus_->readv(address, buffers, cnt);
-  this->parent_->disable_all_channels();
+  this->parent_->release_channel();
   return err;
 }
 i2c::ErrorCode TCA9548AChannel::writev(uint8_t address, i2c::WriteBuffer *buffers, size_t cnt, bool stop) {
@@ -19,9 +28,16 @@ i2c::ErrorCode TCA9548AChannel::writev(uint8_t address, i2c::WriteBuffer *buffer
   if (err != i2c::ERROR_OK)
     return err;
   err = this->parent_->bus_->writev(address, buffers, cnt, stop);
-  this->parent_->disable_all_channels();
+  this->parent_->release_channel();
   return err;
 }
+void TCA9548AChannel::transfer_async(uint8_t address, const uint8_t *write_data, size_t write_len,
+                                     uint8_t *read_data, size_t read_len, TransactionCallback &&callback) {
+  this->parent_->queue_transfer(this->channel_, address, write_data, write_len, read_data, read_len,
+                                std::move(callback));
+}
+
+TCA9548AComponent::TCA9548AComponent() { multiplexers().push_back(this); }
 
 void TCA9548AComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up TCA9548A...");
@@ -32,25 +48,89 @@ void TCA9548AComponent::setup() {
     return;
   }
   ESP_LOGD(TAG, "Channels currently open: %d", status);
+  if (status == 0)
+    this->active_channel_ = NO_CHANNEL;
+  this->disable_loop();
 }
 void TCA9548AComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "TCA9548A:");
   LOG_I2C_DEVICE(this);
+  ESP_LOGCONFIG(TAG, "  Keep Channel Open: %s", YESNO(this->keep_channel_open_));
+}
+
+void TCA9548AComponent::loop() {
+  if (this->pending_.empty()) {
+    this->disable_loop();
+    return;
+  }
+  // Callbacks may queue further transactions, those run in the next iteration
+  std::vector<PendingTransfer> pending;
+  pending.swap(this->pending_);
+  std::stable_sort(pending.begin(), pending.end(),
+                   [](const PendingTransfer &a, const PendingTransfer &b) { return a.channel < b.channel; });
+
+  // One switch per channel, its transactions go out back to back
+  for (size_t i = 0; i < pending.size(); i++) {
+    PendingTransfer &transfer = pending[i];
+    transfer.result = this->switch_to_channel(transfer.channel);
+    if (transfer.result == i2c::ERROR_OK && !transfer.write_data.empty())
+      transfer.result = this->bus_->write(transfer.address, transfer.write_data.data(), transfer.write_data.size());
+    if (transfer.result == i2c::ERROR_OK && transfer.read_len > 0)
+      transfer.result = this->bus_->read(transfer.address, transfer.read_data, transfer.read_len);
+    if (i + 1 == pending.size() || pending[i + 1].channel != transfer.channel)
+      this->release_channel();
+  }
+  for (auto &transfer : pending)
+    transfer.callback(transfer.result);
+}
+
+void TCA9548AComponent::queue_transfer(uint8_t channel, uint8_t address, const uint8_t *write_data, size_t write_len,
+                                       uint8_t *read_data, size_t read_len,
+                                       i2c::I2CBus::TransactionCallback &&callback) {
+  if (this->is_failed()) {
+    callback(i2c::ERROR_NOT_INITIALIZED);
+    return;
+  }
+  this->pending_.push_back(PendingTransfer{channel, address, std::vector<uint8_t>(write_data, write_data + write_len),
+                                           read_data, read_len, std::move(callback), i2c::ERROR_OK});
+  this->enable_loop();
 }
 
 i2c::ErrorCode TCA9548AComponent::switch_to_channel(uint8_t channel) {
   if (this->is_failed())
     return i2c::ERROR_NOT_INITIALIZED;
+  if (this->active_channel_ == channel)
+    return i2c::ERROR_OK;
+
+  if (this->keep_channel_open_) {
+    // Another multiplexer on this bus may have left a channel open that would clash with this one
+    for (auto *other : multiplexers()) {
+      if (other != this && other->bus_ == this->bus_)
+        other->disable_all_channels();
+    }
+  }
 
   uint8_t channel_val = 1 << channel;
-  return this->write(&channel_val, 1);
+  auto err = this->write(&channel_val, 1);
+  this->active_channel_ = err == i2c::ERROR_OK ? channel : UNKNOWN_CHANNEL;
+  return err;
 }
 
 void TCA9548AComponent::disable_all_channels() {
+  if (this->active_channel_ == NO_CHANNEL)
+    return;
   if (this->write(&TCA9548A_DISABLE_CHANNELS_COMMAND, 1) != i2c::ERROR_OK) {
     ESP_LOGE(TAG, "Failed to disable all channels.");
     this->status_set_error();  // couldn't disable channels, set error status
+    this->active_channel_ = UNKNOWN_CHANNEL;
+    return;
   }
+  this->active_channel_ = NO_CHANNEL;
+}
+
+void TCA9548AComponent::release_channel() {
+  if (!this->keep_channel_open_)
+    this->disable_all_channels();
 }
 
 }  // namespace tca9548a
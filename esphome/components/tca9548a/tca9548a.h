@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "esphome/core/component.h"
 #include "esphome/components/i2c/i2c.h"
 
@@ -16,6 +18,9 @@ class TCA9548AChannel : public i2c::I2CBus {
 
   i2c::ErrorCode readv(uint8_t address, i2c::ReadBuffer *buffers, size_t cnt) override;
   i2c::ErrorCode writev(uint8_t address, i2c::WriteBuffer *buffers, size_t cnt, bool stop) override;
+  /// Queued on the multiplexer, which runs the transactions of each channel back to back in its loop().
+  void transfer_async(uint8_t address, const uint8_t *write_data, size_t write_len, uint8_t *read_data,
+                      size_t read_len, TransactionCallback &&callback) override;
 
  protected:
   uint8_t channel_;
@@ -24,16 +29,53 @@ class TCA9548AChannel : public i2c::I2CBus {
 
 class TCA9548AComponent : public Component, public i2c::I2CDevice {
  public:
+  TCA9548AComponent();
   void setup() override;
   void dump_config() override;
+  void loop() override;
   float get_setup_priority() const override { return setup_priority::IO; }
   void update();
 
+  /** Leave the channel of the last transaction open instead of closing it after every transaction.
+   *
+   * Saves the write to close it, and the write to open it again when the next transaction is on the same channel. The
+   * devices behind the open channel stay on the bus though, so none of them may share an address with a device on the
+   * upstream bus. Other multiplexers on the same bus close their channel before this one opens one.
+   */
+  void set_keep_channel_open(bool keep_channel_open) { this->keep_channel_open_ = keep_channel_open; }
+
+  /// Open the channel, does nothing if it already is.
   i2c::ErrorCode switch_to_channel(uint8_t channel);
+  /// Close all channels, does nothing if they already are.
   void disable_all_channels();
+  /// Called after a transaction on a channel.
+  void release_channel();
+
+  void queue_transfer(uint8_t channel, uint8_t address, const uint8_t *write_data, size_t write_len,
+                      uint8_t *read_data, size_t read_len, i2c::I2CBus::TransactionCallback &&callback);
 
  protected:
   friend class TCA9548AChannel;
+
+  /// active_channel_ when all channels are closed.
+  static const uint8_t NO_CHANNEL = 0xFF;
+  /// active_channel_ when it isn't known which channels are open, the next switch or disable always writes.
+  static const uint8_t UNKNOWN_CHANNEL = 0xFE;
+
+  struct PendingTransfer {
+    uint8_t channel;
+    uint8_t address;
+    std::vector<uint8_t> write_data;
+    uint8_t *read_data;
+    size_t read_len;
+    i2c::I2CBus::TransactionCallback callback;
+    i2c::ErrorCode result;
+  };
+
+  uint8_t active_channel_{UNKNOWN_CHANNEL};
+  bool keep_channel_open_{false};
+  std::vector<PendingTransfer> pending_;
 };
+
 }  // namespace tca9548a
 }  // namespace esphome
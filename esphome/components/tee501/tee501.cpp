@@ -1,4 +1,5 @@
 #include "tee501.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -63,22 +64,7 @@ void TEE501Component::update() {
 }
 
 unsigned char TEE501Component::calc_crc8_(const unsigned char buf[], unsigned char from, unsigned char to) {
-  unsigned char crc_val = 0xFF;
-  unsigned char i = 0;
-  unsigned char j = 0;
-  for (i = from; i <= to; i++) {
-    int cur_val = buf[i];
-    for (j = 0; j < 8; j++) {
-      if (((crc_val ^ cur_val) & 0x80) != 0)  // If MSBs are not equal
-      {
-        crc_val = ((crc_val << 1) ^ 0x31);
-      } else {
-        crc_val = (crc_val << 1);
-      }
-      cur_val = cur_val << 1;
-    }
-  }
-  return crc_val;
+  return crc8(buf + from, to - from + 1, 0xFF, 0x31, true);
 }
 
 }  // namespace tee501
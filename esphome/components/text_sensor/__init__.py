@@ -14,6 +14,7 @@ from esphome.const import (
     CONF_STATE,
     CONF_FROM,
     CONF_TO,
+    CONF_SUPPRESS_UNCHANGED,
 )
 from esphome.core import CORE, coroutine_with_priority
 from esphome.cpp_generator import MockObjClass
@@ -117,6 +118,7 @@ TEXT_SENSOR_SCHEMA = cv.ENTITY_BASE_SCHEMA.extend(cv.MQTT_COMPONENT_SCHEMA).exte
         cv.OnlyWith(CONF_MQTT_ID, "mqtt"): cv.declare_id(mqtt.MQTTTextSensor),
         cv.GenerateID(): cv.declare_id(TextSensor),
         cv.Optional(CONF_FILTERS): validate_filters,
+        cv.Optional(CONF_SUPPRESS_UNCHANGED): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_ON_VALUE): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(TextSensorStateTrigger),
@@ -167,6 +169,8 @@ async def setup_text_sensor_core_(var, config):
     if config.get(CONF_FILTERS):  # must exist and not be empty
         filters = await build_filters(config[CONF_FILTERS])
         cg.add(var.set_filters(filters))
+    if CONF_SUPPRESS_UNCHANGED in config:
+        cg.add(var.set_suppress_unchanged(config[CONF_SUPPRESS_UNCHANGED]))
 
     for conf in config.get(CONF_ON_VALUE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
@@ -1,5 +1,7 @@
 #include "text_sensor.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
+#include "esphome/core/worker.h"
 
 namespace esphome {
 namespace text_sensor {
@@ -7,15 +9,34 @@ namespace text_sensor {
 static const char *const TAG = "text_sensor";
 
 void TextSensor::publish_state(const std::string &state) {
+#ifdef USE_COMPONENT_WORKER
+  if (worker::in_worker()) {
+    worker::run_in_main([this, state]() { this->publish_state(state); });
+    return;
+  }
+#endif
   this->raw_state = state;
-  this->raw_callback_.call(state);
+  this->publish_raw_state_();
+}
+void TextSensor::publish_state(const char *state, size_t len) {
+#ifdef USE_COMPONENT_WORKER
+  if (worker::in_worker()) {
+    worker::run_in_main([this, value = std::string(state, len)]() { this->publish_state(value); });
+    return;
+  }
+#endif
+  this->raw_state.assign(state, len);
+  this->publish_raw_state_();
+}
+void TextSensor::publish_raw_state_() {
+  this->raw_callback_.call(this->raw_state);
 
-  ESP_LOGV(TAG, "'%s': Received new state %s", this->name_.c_str(), state.c_str());
+  ESP_LOGV(TAG, "'%s': Received new state %s", this->name_.c_str(), this->raw_state.c_str());
 
   if (this->filter_list_ == nullptr) {
-    this->internal_send_state_to_frontend(state);
+    this->internal_send_state_to_frontend(this->raw_state);
   } else {
-    this->filter_list_->input(state);
+    this->filter_list_->input(this->raw_state);
   }
 }
 
@@ -49,16 +70,17 @@ void TextSensor::clear_filters() {
   this->filter_list_ = nullptr;
 }
 
-void TextSensor::add_on_state_callback(std::function<void(std::string)> callback) {
-  this->callback_.add(std::move(callback));
-}
-void TextSensor::add_on_raw_state_callback(std::function<void(std::string)> callback) {
-  this->raw_callback_.add(std::move(callback));
-}
-
 std::string TextSensor::get_state() const { return this->state; }
 std::string TextSensor::get_raw_state() const { return this->raw_state; }
 void TextSensor::internal_send_state_to_frontend(const std::string &state) {
+  if (this->suppress_unchanged_max_age_ != 0) {
+    const uint32_t now = millis();
+    if (this->has_state_ && now - this->last_sent_time_ < this->suppress_unchanged_max_age_ && state == this->state) {
+      ESP_LOGV(TAG, "'%s': Suppressing unchanged state '%s'", this->name_.c_str(), state.c_str());
+      return;
+    }
+    this->last_sent_time_ = now;
+  }
   this->state = state;
   this->has_state_ = true;
   ESP_LOGD(TAG, "'%s': Sending state '%s'", this->name_.c_str(), state.c_str());
@@ -5,6 +5,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/components/text_sensor/filter.h"
 
+#include <cstring>
 #include <vector>
 
 namespace esphome {
@@ -36,6 +37,13 @@ class TextSensor : public EntityBase {
   std::string get_raw_state() const;
 
   void publish_state(const std::string &state);
+  /** Publish a state from a character buffer, without creating a temporary std::string.
+   *
+   * The state is copied into the storage of raw_state and state, which only allocates when it is longer than any
+   * state before, so text sensors that are updated often don't churn the heap.
+   */
+  void publish_state(const char *state, size_t len);
+  void publish_state(const char *state) { this->publish_state(state, strlen(state)); }
 
   /// Add a filter to the filter chain. Will be appended to the back.
   void add_filter(Filter *filter);
@@ -49,9 +57,17 @@ class TextSensor : public EntityBase {
   /// Clear the entire filter chain.
   void clear_filters();
 
-  void add_on_state_callback(std::function<void(std::string)> callback);
+  /** Don't send states that are equal to the last sent state.
+   *
+   * Unchanged states are still sent once the last one was sent at least max_age ms ago, 0 sends all states.
+   */
+  void set_suppress_unchanged(uint32_t max_age) { suppress_unchanged_max_age_ = max_age; }
+
+  template<typename F> void add_on_state_callback(F &&callback) { this->callback_.add(std::forward<F>(callback)); }
   /// Add a callback that will be called every time the sensor sends a raw value.
-  void add_on_raw_state_callback(std::function<void(std::string)> callback);
+  template<typename F> void add_on_raw_state_callback(F &&callback) {
+    this->raw_callback_.add(std::forward<F>(callback));
+  }
 
   std::string state;
   std::string raw_state;
@@ -69,12 +85,16 @@ class TextSensor : public EntityBase {
   void internal_send_state_to_frontend(const std::string &state);
 
  protected:
-  CallbackManager<void(std::string)> raw_callback_;  ///< Storage for raw state callbacks.
-  CallbackManager<void(std::string)> callback_;      ///< Storage for filtered state callbacks.
+  void publish_raw_state_();
+
+  CallbackManager<void(const std::string &)> raw_callback_;  ///< Storage for raw state callbacks.
+  CallbackManager<void(const std::string &)> callback_;      ///< Storage for filtered state callbacks.
 
   Filter *filter_list_{nullptr};  ///< Store all active filters.
 
   bool has_state_{false};
+  uint32_t suppress_unchanged_max_age_{0};
+  uint32_t last_sent_time_{0};
 };
 
 }  // namespace text_sensor
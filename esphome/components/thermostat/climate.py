@@ -72,6 +72,7 @@ from esphome.const import (
 CONF_PRESET_CHANGE = "preset_change"
 CONF_DEFAULT_PRESET = "default_preset"
 CONF_ON_BOOT_RESTORE_FROM = "on_boot_restore_from"
+CONF_EVALUATION_INTERVAL = "evaluation_interval"
 
 CODEOWNERS = ["@kbx81"]
 
@@ -617,6 +618,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_FAN_WITH_COOLING, default=False): cv.boolean,
             cv.Optional(CONF_FAN_WITH_HEATING, default=False): cv.boolean,
             cv.Optional(CONF_STARTUP_DELAY, default=False): cv.boolean,
+            cv.Optional(CONF_EVALUATION_INTERVAL): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_AWAY_CONFIG): cv.Schema(
                 {
                     cv.Optional(CONF_DEFAULT_TARGET_TEMPERATURE_HIGH): cv.temperature,
@@ -728,6 +730,8 @@ async def to_code(config):
     cg.add(var.set_supports_fan_with_heating(config[CONF_FAN_WITH_HEATING]))
 
     cg.add(var.set_use_startup_delay(config[CONF_STARTUP_DELAY]))
+    if CONF_EVALUATION_INTERVAL in config:
+        cg.add(var.set_evaluation_interval(config[CONF_EVALUATION_INTERVAL]))
 
     await automation.build_automation(
         var.get_idle_action_trigger(), [], config[CONF_IDLE_ACTION]
@@ -1,6 +1,8 @@
 #include "thermostat_climate.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace thermostat {
 
@@ -18,12 +20,21 @@ void ThermostatClimate::setup() {
   // add a callback so that whenever the sensor state changes we can take action
   this->sensor_->add_on_state_callback([this](float state) {
     this->current_temperature = state;
-    // required action may have changed, recompute, refresh, we'll publish_state() later
-    this->switch_to_action_(this->compute_action_(), false);
-    this->switch_to_supplemental_action_(this->compute_supplemental_action_());
-    // current temperature and possibly action changed, so publish the new state
-    this->publish_state();
+    if (this->evaluation_interval_ > 0) {
+      // batch updates of fast sensors, the interval below picks this up
+      this->evaluation_pending_ = true;
+      return;
+    }
+    this->evaluate_();
   });
+  if (this->evaluation_interval_ > 0) {
+    this->set_interval(this->evaluation_interval_, [this]() {
+      if (!this->evaluation_pending_)
+        return;
+      this->evaluation_pending_ = false;
+      this->evaluate_();
+    });
+  }
   this->current_temperature = this->sensor_->state;
 
   auto use_default_preset = true;
@@ -68,6 +79,14 @@ void ThermostatClimate::refresh() {
   this->publish_state();
 }
 
+void ThermostatClimate::evaluate_() {
+  // required action may have changed, recompute, refresh, we'll publish_state() later
+  this->switch_to_action_(this->compute_action_(), false);
+  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  // current temperature and possibly action changed, so publish the new state
+  this->publish_state();
+}
+
 bool ThermostatClimate::climate_action_change_delayed() {
   bool state_mismatch = this->action != this->compute_action_(true);
 
@@ -739,15 +758,20 @@ bool ThermostatClimate::heating_action_ready_() {
 
 void ThermostatClimate::start_timer_(const ThermostatClimateTimerIndex timer_index) {
   if (this->timer_duration_(timer_index) > 0) {
-    this->set_timeout(this->timer_[timer_index].name, this->timer_duration_(timer_index),
-                      this->timer_cbf_(timer_index));
-    this->timer_[timer_index].active = true;
+    auto &timer = this->timer_[timer_index];
+    // restarting a running timer replaces it, like a named timeout would
+    this->cancel_scheduled(timer.handle);
+    timer.handle = this->set_timeout(this->timer_duration_(timer_index), this->timer_cbf_(timer_index));
+    timer.active = true;
   }
 }
 
 bool ThermostatClimate::cancel_timer_(ThermostatClimateTimerIndex timer_index) {
-  this->timer_[timer_index].active = false;
-  return this->cancel_timeout(this->timer_[timer_index].name);
+  auto &timer = this->timer_[timer_index];
+  timer.active = false;
+  bool cancelled = this->cancel_scheduled(timer.handle);
+  timer.handle = SCHEDULER_INVALID_HANDLE;
+  return cancelled;
 }
 
 bool ThermostatClimate::timer_active_(ThermostatClimateTimerIndex timer_index) {
@@ -1167,6 +1191,9 @@ void ThermostatClimate::set_idle_minimum_time_in_sec(uint32_t time) {
 }
 void ThermostatClimate::set_sensor(sensor::Sensor *sensor) { this->sensor_ = sensor; }
 void ThermostatClimate::set_use_startup_delay(bool use_startup_delay) { this->use_startup_delay_ = use_startup_delay; }
+void ThermostatClimate::set_evaluation_interval(uint32_t evaluation_interval) {
+  this->evaluation_interval_ = evaluation_interval;
+}
 void ThermostatClimate::set_supports_heat_cool(bool supports_heat_cool) {
   this->supports_heat_cool_ = supports_heat_cool;
 }
@@ -1275,6 +1302,9 @@ void ThermostatClimate::dump_config() {
     ESP_LOGCONFIG(TAG, "  Minimum Set Point Differential: %.1f°C", this->set_point_minimum_differential_);
   }
   ESP_LOGCONFIG(TAG, "  Start-up Delay Enabled: %s", YESNO(this->use_startup_delay_));
+  if (this->evaluation_interval_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Evaluation Interval: %" PRIu32 "ms", this->evaluation_interval_);
+  }
   if (this->supports_cool_) {
     ESP_LOGCONFIG(TAG, "  Cooling Parameters:");
     ESP_LOGCONFIG(TAG, "    Deadband: %.1f°C", this->cooling_deadband_);
@@ -26,10 +26,12 @@ enum ThermostatClimateTimerIndex : size_t {
 
 enum OnBootRestoreFrom : size_t { MEMORY = 0, DEFAULT_PRESET = 1 };
 struct ThermostatClimateTimer {
-  const std::string name;
+  const char *name;
   bool active;
   uint32_t time;
   std::function<void()> func;
+  /// Handle of the scheduled timeout while the timer runs, so it can be restarted and cancelled without a name lookup
+  SchedulerHandle handle{SCHEDULER_INVALID_HANDLE};
 };
 
 struct ThermostatClimateTargetTempConfig {
@@ -81,6 +83,7 @@ class ThermostatClimate : public climate::Climate, public Component {
   void set_heating_minimum_run_time_in_sec(uint32_t time);
   void set_idle_minimum_time_in_sec(uint32_t time);
   void set_sensor(sensor::Sensor *sensor);
+  void set_evaluation_interval(uint32_t evaluation_interval);
   void set_use_startup_delay(bool use_startup_delay);
   void set_supports_auto(bool supports_auto);
   void set_supports_heat_cool(bool supports_heat_cool);
@@ -182,6 +185,9 @@ class ThermostatClimate : public climate::Climate, public Component {
   climate::ClimateAction compute_action_(bool ignore_timers = false);
   climate::ClimateAction compute_supplemental_action_();
 
+  /// Re-compute the actions after the current temperature changed and publish the new state.
+  void evaluate_();
+
   /// Switch the climate device to the given climate action.
   void switch_to_action_(climate::ClimateAction action, bool publish_state = true);
   void switch_to_supplemental_action_(climate::ClimateAction action);
@@ -304,6 +310,11 @@ class ThermostatClimate : public climate::Climate, public Component {
   /// setup_complete_ blocks modifying/resetting the temps immediately after boot
   bool setup_complete_{false};
 
+  /// With an evaluation interval, sensor updates only mark the controller dirty and the actions are re-computed at
+  /// most once per interval. 0 re-computes them on every sensor update.
+  uint32_t evaluation_interval_{0};
+  bool evaluation_pending_{false};
+
   /// The trigger to call when the controller should switch to cooling action/mode.
   ///
   /// A null value for this attribute means that the controller has no cooling action
@@ -2,7 +2,9 @@
 
 #include "esphome/core/log.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <sys/time.h>
 
 namespace esphome {
 namespace time {
@@ -10,6 +12,10 @@ namespace time {
 static const char *const TAG = "automation";
 static const int MAX_TIMESTAMP_DRIFT = 900;  // how far can the clock drift before we consider
                                              // there has been a drastic time synchronization
+static const uint32_t INVALID_TIME_RETRY_MS = 1000;
+static const uint32_t MAX_WAIT_MS = 3600000;
+// Enough to find the next February 29th on a given day of the week
+static const uint16_t MAX_SEARCH_STEPS = 4000;
 
 void CronTrigger::add_second(uint8_t second) { this->seconds_[second] = true; }
 void CronTrigger::add_minute(uint8_t minute) { this->minutes_[minute] = true; }
@@ -21,36 +27,32 @@ bool CronTrigger::matches(const ESPTime &time) {
   return time.is_valid() && this->seconds_[time.second] && this->minutes_[time.minute] && this->hours_[time.hour] &&
          this->days_of_month_[time.day_of_month] && this->months_[time.month] && this->days_of_week_[time.day_of_week];
 }
-void CronTrigger::loop() {
-  ESPTime time = this->rtc_->now();
-  if (!time.is_valid())
+void CronTrigger::setup() {
+  this->rtc_->add_on_time_sync_callback([this]() { this->check_(); });
+  this->check_();
+}
+void CronTrigger::check_() {
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+  ESPTime time = ESPTime::from_epoch_local(now.tv_sec);
+  if (!time.is_valid()) {
+    this->set_timeout("cron", INVALID_TIME_RETRY_MS, [this]() { this->check_(); });
     return;
+  }
 
-  if (this->last_check_.has_value()) {
-    if (*this->last_check_ > time && this->last_check_->timestamp - time.timestamp > MAX_TIMESTAMP_DRIFT) {
-      // We went back in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped back!");
-    } else if (*this->last_check_ >= time) {
-      // already handled this one
-      return;
-    } else if (time > *this->last_check_ && time.timestamp - this->last_check_->timestamp > MAX_TIMESTAMP_DRIFT) {
-      // We went ahead in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped ahead!");
-      this->last_check_ = time;
-      return;
-    }
-
-    while (true) {
-      this->last_check_->increment_second();
-      if (*this->last_check_ >= time)
-        break;
-
-      if (this->matches(*this->last_check_))
-        this->trigger();
-    }
+  if (this->last_check_ == 0) {
+    // Also fire for the current second
+    this->last_check_ = now.tv_sec - 1;
+  } else if (this->last_check_ > now.tv_sec && this->last_check_ - now.tv_sec > MAX_TIMESTAMP_DRIFT) {
+    // We went back in time (a lot), probably caused by time synchronization
+    ESP_LOGW(TAG, "Time has jumped back!");
+    this->last_check_ = now.tv_sec - 1;
+  } else if (now.tv_sec > this->last_check_ && now.tv_sec - this->last_check_ > MAX_TIMESTAMP_DRIFT) {
+    // We went ahead in time (a lot), probably caused by time synchronization
+    ESP_LOGW(TAG, "Time has jumped ahead!");
+    this->last_check_ = now.tv_sec;
   }
 
-  this->last_check_ = time;
   if (!time.fields_in_range()) {
     ESP_LOGW(TAG, "Time is out of range!");
     ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%" PRId64,
@@ -58,8 +60,53 @@ void CronTrigger::loop() {
              (int64_t) time.timestamp);
   }
 
-  if (this->matches(time))
+  time_t next = this->next_match_(this->last_check_);
+  while (next != 0 && next <= now.tv_sec) {
+    this->last_check_ = next;
     this->trigger();
+    next = this->next_match_(next);
+  }
+  this->last_check_ = std::max(this->last_check_, now.tv_sec);
+
+  // Wake up at the start of the matching second. Long waits are split up, so that the wake up stays accurate if the
+  // clock the scheduler runs on drifts against the time
+  uint32_t delay = MAX_WAIT_MS;
+  if (next != 0 && next - now.tv_sec <= static_cast<time_t>(MAX_WAIT_MS / 1000))
+    delay = (next - now.tv_sec) * 1000 - now.tv_usec / 1000;
+  this->set_timeout("cron", delay, [this]() { this->check_(); });
+}
+/// UTC timestamp of the start of a local day, the fields may be past the end of the month or year.
+static time_t local_day_start(int year, int month, int day_of_month) {
+  struct tm c_tm {};
+  c_tm.tm_year = year - 1900;
+  c_tm.tm_mon = month - 1;
+  c_tm.tm_mday = day_of_month;
+  c_tm.tm_isdst = -1;
+  return mktime(&c_tm);
+}
+time_t CronTrigger::next_match_(time_t after) {
+  time_t timestamp = after + 1;
+  // Skip over the months, days, hours and minutes that can't match instead of checking every second, in local time so
+  // that the matches move with daylight saving time
+  for (uint16_t i = 0; i < MAX_SEARCH_STEPS; i++) {
+    ESPTime time = ESPTime::from_epoch_local(timestamp);
+    time_t skip_to;
+    if (!this->months_[time.month]) {
+      skip_to = local_day_start(time.year, time.month + 1, 1);
+    } else if (!this->days_of_month_[time.day_of_month] || !this->days_of_week_[time.day_of_week]) {
+      skip_to = local_day_start(time.year, time.month, time.day_of_month + 1);
+    } else if (!this->hours_[time.hour]) {
+      skip_to = timestamp + 3600 - time.minute * 60 - time.second;
+    } else if (!this->minutes_[time.minute]) {
+      skip_to = timestamp + 60 - time.second;
+    } else if (!this->seconds_[time.second]) {
+      skip_to = timestamp + 1;
+    } else {
+      return timestamp;
+    }
+    timestamp = std::max(skip_to, timestamp + 1);
+  }
+  return 0;
 }
 CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) {}
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
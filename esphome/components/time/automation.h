@@ -27,10 +27,15 @@ class CronTrigger : public Trigger<>, public Component {
   void add_day_of_week(uint8_t day_of_week);
   void add_days_of_week(const std::vector<uint8_t> &days_of_week);
   bool matches(const ESPTime &time);
-  void loop() override;
+  void setup() override;
   float get_setup_priority() const override;
 
  protected:
+  /// The first local time after the UTC timestamp after that matches, 0 if there is none in the next few years.
+  time_t next_match_(time_t after);
+  /// Fire for the matches that were reached since the last check, and wait for the next one.
+  void check_();
+
   std::bitset<61> seconds_;
   std::bitset<60> minutes_;
   std::bitset<24> hours_;
@@ -38,7 +43,8 @@ class CronTrigger : public Trigger<>, public Component {
   std::bitset<13> months_;
   std::bitset<8> days_of_week_;
   RealTimeClock *rtc_;
-  optional<ESPTime> last_check_;
+  /// UTC timestamp up to which all matches have been handled, 0 before the time was valid.
+  time_t last_check_{0};
 };
 
 class SyncTrigger : public Trigger<>, public Component {
@@ -17,6 +17,7 @@ from esphome.core.entity_helpers import inherit_property_from
 DEPENDENCIES = ["time"]
 
 CONF_POWER_ID = "power_id"
+CONF_SAVE_INTERVAL = "save_interval"
 total_daily_energy_ns = cg.esphome_ns.namespace("total_daily_energy")
 TotalDailyEnergyMethod = total_daily_energy_ns.enum("TotalDailyEnergyMethod")
 TOTAL_DAILY_ENERGY_METHODS = {
@@ -48,6 +49,9 @@ CONFIG_SCHEMA = (
             cv.GenerateID(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
             cv.Required(CONF_POWER_ID): cv.use_id(sensor.Sensor),
             cv.Optional(CONF_RESTORE, default=True): cv.boolean,
+            cv.Optional(
+                CONF_SAVE_INTERVAL, default="0s"
+            ): cv.positive_time_period_milliseconds,
             cv.Optional("min_save_interval"): cv.invalid(
                 "`min_save_interval` was removed in 2022.6.0. Please use the `preferences` -> `flash_write_interval` to adjust."
             ),
@@ -90,3 +94,4 @@ async def to_code(config):
     cg.add(var.set_time(time_))
     cg.add(var.set_restore(config[CONF_RESTORE]))
     cg.add(var.set_method(config[CONF_METHOD]))
+    cg.add(var.set_save_interval(config[CONF_SAVE_INTERVAL]))
@@ -13,14 +13,26 @@ void TotalDailyEnergy::setup() {
     this->pref_ = global_preferences->make_preference<float>(this->get_object_id_hash());
     this->pref_.load(&initial_value);
   }
-  this->publish_state_and_save(initial_value);
+  this->total_energy_ = initial_value;
+  this->publish_state(initial_value);
 
   this->last_update_ = millis();
 
   this->parent_->add_on_state_callback([this](float state) { this->process_new_state_(state); });
 }
 
-void TotalDailyEnergy::dump_config() { LOG_SENSOR("", "Total Daily Energy", this); }
+void TotalDailyEnergy::dump_config() {
+  LOG_SENSOR("", "Total Daily Energy", this);
+  if (this->restore_ && this->save_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Save Interval: %ums", this->save_interval_);
+}
+
+void TotalDailyEnergy::on_shutdown() {
+  if (this->restore_) {
+    float state = this->total_energy_;
+    this->pref_.save(&state);
+  }
+}
 
 void TotalDailyEnergy::loop() {
   auto t = this->time_->now();
@@ -34,16 +46,20 @@ void TotalDailyEnergy::loop() {
 
   if (t.day_of_year != this->last_day_of_year_) {
     this->last_day_of_year_ = t.day_of_year;
-    this->total_energy_ = 0;
-    this->publish_state_and_save(0);
+    this->publish_and_save_(0.0, true);
   }
 }
 
-void TotalDailyEnergy::publish_state_and_save(float state) {
-  this->total_energy_ = state;
-  this->publish_state(state);
-  if (this->restore_) {
+void TotalDailyEnergy::publish_state_and_save(float state) { this->publish_and_save_(state, true); }
+
+void TotalDailyEnergy::publish_and_save_(double total, bool force_save) {
+  this->total_energy_ = total;
+  this->publish_state(total);
+  const uint32_t now = millis();
+  if (this->restore_ && (force_save || now - this->last_save_ >= this->save_interval_)) {
+    float state = total;
     this->pref_.save(&state);
+    this->last_save_ = now;
   }
 }
 
@@ -51,10 +67,10 @@ void TotalDailyEnergy::process_new_state_(float state) {
   if (std::isnan(state))
     return;
   const uint32_t now = millis();
-  const float old_state = this->last_power_state_;
-  const float new_state = state;
-  float delta_hours = (now - this->last_update_) / 1000.0f / 60.0f / 60.0f;
-  float delta_energy = 0.0f;
+  const double old_state = this->last_power_state_;
+  const double new_state = state;
+  const double delta_hours = (now - this->last_update_) / 1000.0 / 60.0 / 60.0;
+  double delta_energy = 0.0;
   switch (this->method_) {
     case TOTAL_DAILY_ENERGY_METHOD_TRAPEZOID:
       delta_energy = delta_hours * (old_state + new_state) / 2.0;
@@ -68,7 +84,7 @@ void TotalDailyEnergy::process_new_state_(float state) {
   }
   this->last_power_state_ = new_state;
   this->last_update_ = now;
-  this->publish_state_and_save(this->total_energy_ + delta_energy);
+  this->publish_and_save_(this->total_energy_ + delta_energy, false);
 }
 
 }  // namespace total_daily_energy
@@ -21,15 +21,19 @@ class TotalDailyEnergy : public sensor::Sensor, public Component {
   void set_time(time::RealTimeClock *time) { time_ = time; }
   void set_parent(Sensor *parent) { parent_ = parent; }
   void set_method(TotalDailyEnergyMethod method) { method_ = method; }
+  /// Save the total at most this often, 0 saves on every update.
+  void set_save_interval(uint32_t save_interval) { save_interval_ = save_interval; }
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
   void loop() override;
+  void on_shutdown() override;
 
   void publish_state_and_save(float state);
 
  protected:
   void process_new_state_(float state);
+  void publish_and_save_(double total, bool force_save);
 
   ESPPreferenceObject pref_;
   time::RealTimeClock *time_;
@@ -38,7 +42,10 @@ class TotalDailyEnergy : public sensor::Sensor, public Component {
   uint16_t last_day_of_year_{};
   uint32_t last_update_{0};
   bool restore_;
-  float total_energy_{0.0f};
+  uint32_t save_interval_{0};
+  uint32_t last_save_{0};
+  /// In double, float loses the small increments of frequent samples once the total grows.
+  double total_energy_{0.0};
   float last_power_state_{0.0f};
 };
 
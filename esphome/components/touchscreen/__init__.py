@@ -20,12 +20,14 @@ TouchListener = touchscreen_ns.class_("TouchListener")
 
 CONF_DISPLAY = "display"
 CONF_TOUCHSCREEN_ID = "touchscreen_id"
+CONF_COALESCE_INTERVAL = "coalesce_interval"
 
 
 TOUCHSCREEN_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_DISPLAY): cv.use_id(display.DisplayBuffer),
         cv.Optional(CONF_ON_TOUCH): automation.validate_automation(single=True),
+        cv.Optional(CONF_COALESCE_INTERVAL): cv.positive_time_period_milliseconds,
     }
 )
 
@@ -33,6 +35,8 @@ TOUCHSCREEN_SCHEMA = cv.Schema(
 async def register_touchscreen(var, config):
     disp = await cg.get_variable(config[CONF_DISPLAY])
     cg.add(var.set_display(disp))
+    if CONF_COALESCE_INTERVAL in config:
+        cg.add(var.set_coalesce_interval(config[CONF_COALESCE_INTERVAL]))
 
     if CONF_ON_TOUCH in config:
         await automation.build_automation(
@@ -2,6 +2,8 @@
 
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace touchscreen {
 
@@ -25,5 +27,53 @@ void Touchscreen::send_touch_(TouchPoint tp) {
     listener->touch(tp);
 }
 
+void Touchscreen::add_touch_(TouchPoint tp) {
+  const uint32_t now = millis();
+  if (this->coalesce_interval_ == 0 || !this->is_touched_) {
+    this->is_touched_ = true;
+    this->last_report_ = now;
+    this->send_touch_(tp);
+    return;
+  }
+
+  auto it = std::find_if(this->pending_touches_.begin(), this->pending_touches_.end(),
+                         [&tp](const PendingTouch &pending) { return pending.tp.id == tp.id; });
+  if (it == this->pending_touches_.end()) {
+    this->pending_touches_.push_back(PendingTouch{tp, tp.x, tp.y, 1});
+  } else {
+    it->tp = tp;
+    it->x_sum += tp.x;
+    it->y_sum += tp.y;
+    it->count++;
+  }
+  this->flush_touches_();
+}
+
+void Touchscreen::release_touches_() {
+  this->send_pending_touches_();
+  this->is_touched_ = false;
+  ESP_LOGV(TAG, "Release");
+  for (auto *listener : this->touch_listeners_)
+    listener->release();
+}
+
+void Touchscreen::flush_touches_() {
+  if (!this->pending_touches_.empty() && millis() - this->last_report_ >= this->coalesce_interval_)
+    this->send_pending_touches_();
+}
+
+void Touchscreen::send_pending_touches_() {
+  if (this->pending_touches_.empty())
+    return;
+  this->last_report_ = millis();
+  for (auto &pending : this->pending_touches_) {
+    TouchPoint tp = pending.tp;
+    tp.x = pending.x_sum / pending.count;
+    tp.y = pending.y_sum / pending.count;
+    this->send_touch_(tp);
+  }
+  this->pending_touches_.clear();
+}
+
 }  // namespace touchscreen
 }  // namespace esphome
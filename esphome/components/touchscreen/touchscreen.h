@@ -16,6 +16,10 @@ struct TouchPoint {
   uint8_t state;
 };
 
+/** Receives the touches of a Touchscreen.
+ *
+ * The first touch() after a release is the press, following calls are moves until release() is called.
+ */
 class TouchListener {
  public:
   virtual void touch(TouchPoint tp) = 0;
@@ -38,16 +42,42 @@ class Touchscreen {
 
   void register_listener(TouchListener *listener) { this->touch_listeners_.push_back(listener); }
 
+  /** Set the minimum time between two reports of a moving touch, 0 reports every sample.
+   *
+   * The samples of each touch point in between are averaged into one report, so listeners that redraw the display
+   * don't do so for every sample during a drag. Presses and releases are always reported right away.
+   */
+  void set_coalesce_interval(uint32_t coalesce_interval) { this->coalesce_interval_ = coalesce_interval; }
+
  protected:
   /// Call this function to send touch points to the `on_touch` listener and the binary_sensors.
   void send_touch_(TouchPoint tp);
 
+  /// Call this for every sample of a touch point read from the hardware, moves are coalesced.
+  void add_touch_(TouchPoint tp);
+  /// Call this when all touch points were released, reports the last position of pending moves first.
+  void release_touches_();
+  /// Call this from the loop() of the driver to report coalesced moves once the interval has passed.
+  void flush_touches_();
+  void send_pending_touches_();
+
+  struct PendingTouch {
+    TouchPoint tp;
+    uint32_t x_sum;
+    uint32_t y_sum;
+    uint16_t count;
+  };
+
   uint16_t display_width_;
   uint16_t display_height_;
   display::Display *display_;
   TouchRotation rotation_;
   Trigger<TouchPoint> touch_trigger_;
   std::vector<TouchListener *> touch_listeners_;
+  std::vector<PendingTouch> pending_touches_;
+  uint32_t coalesce_interval_{0};
+  uint32_t last_report_{0};
+  bool is_touched_{false};
 };
 
 }  // namespace touchscreen
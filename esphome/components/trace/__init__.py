@@ -0,0 +1,25 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_BUFFER_SIZE
+
+CODEOWNERS = ["@esphome/core"]
+
+
+def validate_power_of_two(value):
+    value = cv.int_range(min=16, max=16384)(value)
+    if value & (value - 1) != 0:
+        raise cv.Invalid("The trace buffer size must be a power of 2")
+    return value
+
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_BUFFER_SIZE, default=256): validate_power_of_two,
+    }
+)
+
+
+async def to_code(config):
+    # The recorder lives in core/trace.h, this only compiles it in
+    cg.add_define("USE_TRACE")
+    cg.add_define("USE_TRACE_BUFFER_SIZE", config[CONF_BUFFER_SIZE])
@@ -74,6 +74,7 @@ void TT21100Touchscreen::setup() {
 }
 
 void TT21100Touchscreen::loop() {
+  this->flush_touches_();
   if (!this->store_.touch)
     return;
   this->store_.touch = false;
@@ -112,8 +113,7 @@ void TT21100Touchscreen::loop() {
       uint8_t touch_count = (data_len - (sizeof(*report) - sizeof(report->touch_record))) / sizeof(TT21100TouchRecord);
 
       if (touch_count == 0) {
-        for (auto *listener : this->touch_listeners_)
-          listener->release();
+        this->release_touches_();
         return;
       }
 
@@ -149,7 +149,7 @@ void TT21100Touchscreen::loop() {
         tp.id = touch->tip;
         tp.state = touch->pressure;
 
-        this->defer([this, tp]() { this->send_touch_(tp); });
+        this->add_touch_(tp);
       }
     }
   }
@@ -20,6 +20,8 @@ static const char *const TAG = "tuya";
 static const int COMMAND_DELAY = 10;
 static const int RECEIVE_TIMEOUT = 300;
 static const int MAX_RETRIES = 5;
+/// Largest payload of a datapoint command that more datapoints are added to, MCUs have small receive buffers.
+static const size_t MAX_PACKED_DATAPOINT_PAYLOAD = 128;
 
 void Tuya::setup() {
   this->set_interval("heartbeat", 15000, [this] { this->send_empty_command_(TuyaCommandType::HEARTBEAT); });
@@ -29,10 +31,11 @@ void Tuya::setup() {
 }
 
 void Tuya::loop() {
-  while (this->available()) {
-    uint8_t c;
-    this->read_byte(&c);
-    this->handle_char_(c);
+  uint8_t buf[64];
+  size_t len;
+  while ((len = this->read_available(buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < len; i++)
+      this->handle_char_(buf[i]);
   }
   process_command_queue_();
 }
@@ -384,7 +387,7 @@ void Tuya::handle_datapoints_(const uint8_t *buffer, size_t len) {
   }
 }
 
-void Tuya::send_raw_command_(TuyaCommand command) {
+void Tuya::send_raw_command_(const TuyaCommand &command) {
   uint8_t len_hi = (uint8_t) (command.payload.size() >> 8);
   uint8_t len_lo = (uint8_t) (command.payload.size() & 0xFF);
   uint8_t version = 0;
@@ -601,7 +604,7 @@ void Tuya::set_numeric_datapoint_value_(uint8_t datapoint_id, TuyaDatapointType
   } else if (datapoint->type != datapoint_type) {
     ESP_LOGE(TAG, "Attempt to set datapoint %u with incorrect type", datapoint_id);
     return;
-  } else if (!forced && datapoint->value_uint == value) {
+  } else if (!forced && datapoint->value_uint == value && !this->is_datapoint_queued_(datapoint_id)) {
     ESP_LOGV(TAG, "Not sending unchanged value");
     return;
   }
@@ -631,7 +634,7 @@ void Tuya::set_raw_datapoint_value_(uint8_t datapoint_id, const std::vector<uint
   } else if (datapoint->type != TuyaDatapointType::RAW) {
     ESP_LOGE(TAG, "Attempt to set datapoint %u with incorrect type", datapoint_id);
     return;
-  } else if (!forced && datapoint->value_raw == value) {
+  } else if (!forced && datapoint->value_raw == value && !this->is_datapoint_queued_(datapoint_id)) {
     ESP_LOGV(TAG, "Not sending unchanged value");
     return;
   }
@@ -646,7 +649,7 @@ void Tuya::set_string_datapoint_value_(uint8_t datapoint_id, const std::string &
   } else if (datapoint->type != TuyaDatapointType::STRING) {
     ESP_LOGE(TAG, "Attempt to set datapoint %u with incorrect type", datapoint_id);
     return;
-  } else if (!forced && datapoint->value_string == value) {
+  } else if (!forced && datapoint->value_string == value && !this->is_datapoint_queued_(datapoint_id)) {
     ESP_LOGV(TAG, "Not sending unchanged value");
     return;
   }
@@ -657,15 +660,74 @@ void Tuya::set_string_datapoint_value_(uint8_t datapoint_id, const std::string &
   this->send_datapoint_command_(datapoint_id, TuyaDatapointType::STRING, data);
 }
 
-void Tuya::send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, std::vector<uint8_t> data) {
-  std::vector<uint8_t> buffer;
-  buffer.push_back(datapoint_id);
-  buffer.push_back(static_cast<uint8_t>(datapoint_type));
-  buffer.push_back(data.size() >> 8);
-  buffer.push_back(data.size() >> 0);
-  buffer.insert(buffer.end(), data.begin(), data.end());
+/// Find the datapoint in the payload of a datapoint command, returns the offset of its header or -1.
+static int find_datapoint_in_payload(const std::vector<uint8_t> &payload, uint8_t datapoint_id) {
+  size_t offset = 0;
+  while (offset + 4 <= payload.size()) {
+    if (payload[offset] == datapoint_id)
+      return offset;
+    offset += 4 + encode_uint16(payload[offset + 2], payload[offset + 3]);
+  }
+  return -1;
+}
+
+static void append_datapoint_to_payload(std::vector<uint8_t> &payload, uint8_t datapoint_id,
+                                        TuyaDatapointType datapoint_type, const std::vector<uint8_t> &data) {
+  payload.push_back(datapoint_id);
+  payload.push_back(static_cast<uint8_t>(datapoint_type));
+  payload.push_back(data.size() >> 8);
+  payload.push_back(data.size() >> 0);
+  payload.insert(payload.end(), data.begin(), data.end());
+}
+
+size_t Tuya::first_unsent_command_() const {
+  // While a response is expected, the first command is the one that was sent
+  return this->expected_response_.has_value() ? 1 : 0;
+}
+
+bool Tuya::is_datapoint_queued_(uint8_t datapoint_id) {
+  for (size_t i = this->first_unsent_command_(); i < this->command_queue_.size(); i++) {
+    const TuyaCommand &command = this->command_queue_[i];
+    if (command.cmd == TuyaCommandType::DATAPOINT_DELIVER &&
+        find_datapoint_in_payload(command.payload, datapoint_id) >= 0)
+      return true;
+  }
+  return false;
+}
+
+void Tuya::send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type,
+                                   const std::vector<uint8_t> &data) {
+  // The link to the MCU is slow, so commands that weren't sent yet are updated in place. A new value for a datapoint
+  // replaces the queued one, other datapoints are added to a datapoint command at the end of the queue, as the MCU
+  // accepts multiple datapoints in one frame.
+  const size_t first_unsent = this->first_unsent_command_();
+  for (size_t i = first_unsent; i < this->command_queue_.size(); i++) {
+    TuyaCommand &command = this->command_queue_[i];
+    if (command.cmd != TuyaCommandType::DATAPOINT_DELIVER)
+      continue;
+    int offset = find_datapoint_in_payload(command.payload, datapoint_id);
+    if (offset >= 0) {
+      ESP_LOGV(TAG, "Replacing queued value of datapoint %u", datapoint_id);
+      auto begin = command.payload.begin() + offset;
+      command.payload.erase(begin, begin + 4 + encode_uint16(begin[2], begin[3]));
+      append_datapoint_to_payload(command.payload, datapoint_id, datapoint_type, data);
+      return;
+    }
+  }
+
+  if (this->command_queue_.size() > first_unsent) {
+    TuyaCommand &last = this->command_queue_.back();
+    if (last.cmd == TuyaCommandType::DATAPOINT_DELIVER &&
+        last.payload.size() + 4 + data.size() <= MAX_PACKED_DATAPOINT_PAYLOAD) {
+      append_datapoint_to_payload(last.payload, datapoint_id, datapoint_type, data);
+      return;
+    }
+  }
 
-  this->send_command_(TuyaCommand{.cmd = TuyaCommandType::DATAPOINT_DELIVER, .payload = buffer});
+  TuyaCommand command{.cmd = TuyaCommandType::DATAPOINT_DELIVER, .payload = {}};
+  append_datapoint_to_payload(command.payload, datapoint_id, datapoint_type, data);
+  this->command_queue_.push_back(std::move(command));
+  this->process_command_queue_();
 }
 
 void Tuya::register_listener(uint8_t datapoint_id, const std::function<void(TuyaDatapoint)> &func) {
@@ -113,7 +113,7 @@ class Tuya : public Component, public uart::UARTDevice {
   bool validate_message_();
 
   void handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len);
-  void send_raw_command_(TuyaCommand command);
+  void send_raw_command_(const TuyaCommand &command);
   void process_command_queue_();
   void send_command_(const TuyaCommand &command);
   void send_empty_command_(TuyaCommandType command);
@@ -121,7 +121,12 @@ class Tuya : public Component, public uart::UARTDevice {
                                     uint8_t length, bool forced);
   void set_string_datapoint_value_(uint8_t datapoint_id, const std::string &value, bool forced);
   void set_raw_datapoint_value_(uint8_t datapoint_id, const std::vector<uint8_t> &value, bool forced);
-  void send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, std::vector<uint8_t> data);
+  void send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type,
+                               const std::vector<uint8_t> &data);
+  /// Index of the first command in command_queue_ that wasn't sent to the MCU yet.
+  size_t first_unsent_command_() const;
+  /// Whether a value for the datapoint is queued, but wasn't sent to the MCU yet.
+  bool is_datapoint_queued_(uint8_t datapoint_id);
   void set_status_pin_();
   void send_wifi_status_();
   uint8_t get_wifi_status_code_();
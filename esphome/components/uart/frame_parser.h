@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace uart {
+
+/// The framing of one kind of frame: header, length field, payload, footer.
+struct FrameFormat {
+  const uint8_t *header;
+  uint8_t header_len;
+  /// Offset of the length field from the start of the frame.
+  uint8_t length_offset;
+  /// Size of the length field, 1 or 2 bytes.
+  uint8_t length_size;
+  bool length_big_endian;
+  /// Added to the value of the length field to get the size of the whole frame.
+  uint8_t length_adjust;
+  /// Checked at the end of the frame, may be nullptr.
+  const uint8_t *footer;
+  uint8_t footer_len;
+  /// Checks the checksum of a whole frame, may be nullptr.
+  bool (*validate)(const uint8_t *frame, size_t len);
+};
+
+/** Splits a stream of bytes from a UART into frames of one or more FrameFormats.
+ *
+ * Feed it whatever read_available() returned. It hunts for a header, and from there copies the frame in bulk, up to the
+ * length field and then up to the end of the frame, so each byte is touched once. Frames with the right footer and
+ * checksum are handed to the callback as pointer and length into the internal buffer, valid during the call. After a
+ * bad frame it hunts for the next header.
+ *
+ * @tparam MAX_FRAME The size of the largest frame, longer ones are dropped.
+ */
+template<size_t MAX_FRAME> class FrameParser {
+ public:
+  FrameParser(const FrameFormat *formats, uint8_t format_count) : formats_(formats), format_count_(format_count) {}
+
+  /// Parse len bytes, calls on_frame(const uint8_t *frame, size_t len) for every valid frame completed.
+  template<typename F> void feed(const uint8_t *data, size_t len, F &&on_frame) {
+    while (len > 0) {
+      if (this->format_ == nullptr) {
+        this->hunt_(*data++);
+        len--;
+        continue;
+      }
+      const size_t target = this->expected_ != 0 ? this->expected_
+                                                 : this->format_->length_offset + this->format_->length_size;
+      const size_t count = std::min(target - this->pos_, len);
+      memcpy(this->buffer_ + this->pos_, data, count);
+      this->pos_ += count;
+      data += count;
+      len -= count;
+      if (this->pos_ < target)
+        continue;
+
+      if (this->expected_ == 0) {
+        this->expected_ = this->frame_size_();
+        if (this->expected_ <= this->pos_ || this->expected_ > MAX_FRAME) {
+          this->errors_++;
+          this->reset_();
+        }
+        continue;
+      }
+      if (this->frame_valid_()) {
+        this->frames_++;
+        on_frame(const_cast<const uint8_t *>(this->buffer_), this->pos_);
+      } else {
+        this->errors_++;
+      }
+      this->reset_();
+    }
+  }
+
+  /// Drop a partly received frame, for example after reconfiguring the device.
+  void reset() { this->reset_(); }
+
+  uint32_t get_frames() const { return this->frames_; }
+  /// Frames dropped for a bad length, footer or checksum.
+  uint32_t get_errors() const { return this->errors_; }
+
+ protected:
+  void hunt_(uint8_t byte) {
+    this->buffer_[this->pos_++] = byte;
+    while (this->pos_ > 0) {
+      for (uint8_t i = 0; i < this->format_count_; i++) {
+        const FrameFormat &format = this->formats_[i];
+        if (this->pos_ > format.header_len || memcmp(this->buffer_, format.header, this->pos_) != 0)
+          continue;
+        // a prefix of this header so far
+        if (this->pos_ == format.header_len)
+          this->format_ = &format;
+        return;
+      }
+      // not the start of a header, maybe a later byte is
+      this->pos_--;
+      memmove(this->buffer_, this->buffer_ + 1, this->pos_);
+    }
+  }
+
+  size_t frame_size_() const {
+    const uint8_t *field = this->buffer_ + this->format_->length_offset;
+    size_t value = field[0];
+    if (this->format_->length_size == 2)
+      value = this->format_->length_big_endian ? (value << 8) | field[1] : value | (field[1] << 8);
+    return value + this->format_->length_adjust;
+  }
+
+  bool frame_valid_() const {
+    const FrameFormat &format = *this->format_;
+    if (format.footer_len != 0 &&
+        memcmp(this->buffer_ + this->pos_ - format.footer_len, format.footer, format.footer_len) != 0)
+      return false;
+    return format.validate == nullptr || format.validate(this->buffer_, this->pos_);
+  }
+
+  void reset_() {
+    this->format_ = nullptr;
+    this->pos_ = 0;
+    this->expected_ = 0;
+  }
+
+  const FrameFormat *formats_;
+  uint8_t format_count_;
+  /// Format of the frame being received, nullptr while hunting for a header.
+  const FrameFormat *format_{nullptr};
+  uint8_t buffer_[MAX_FRAME];
+  size_t pos_{0};
+  /// Size of the frame being received, 0 until its length field is in.
+  size_t expected_{0};
+  uint32_t frames_{0};
+  uint32_t errors_{0};
+};
+
+}  // namespace uart
+}  // namespace esphome
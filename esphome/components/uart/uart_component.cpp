@@ -5,6 +5,16 @@ namespace uart {
 
 static const char *const TAG = "uart";
 
+size_t UARTComponent::read_available(uint8_t *data, size_t max_len) {
+  int available = this->available();
+  if (available <= 0)
+    return 0;
+  size_t len = std::min(max_len, size_t(available));
+  if (len == 0 || !this->read_array(data, len))
+    return 0;
+  return len;
+}
+
 bool UARTComponent::check_read_timeout_(size_t len) {
   if (this->available() >= int(len))
     return true;
@@ -43,6 +43,8 @@ class UARTComponent {
   bool read_byte(uint8_t *data) { return this->read_array(data, 1); };
   virtual bool peek_byte(uint8_t *data) = 0;
   virtual bool read_array(uint8_t *data, size_t len) = 0;
+  /// Read up to max_len of the bytes that are already buffered without waiting. Returns the number of bytes read.
+  virtual size_t read_available(uint8_t *data, size_t max_len);
 
   /// Return available number of bytes.
   virtual int available() = 0;
@@ -10,6 +10,7 @@ from esphome.const import (
 from esphome import automation
 from esphome.automation import register_action, register_condition
 from esphome.components import microphone, speaker, media_player
+from esphome.components.api import api_ns
 
 AUTO_LOAD = ["socket"]
 DEPENDENCIES = ["api", "microphone"]
@@ -17,6 +18,11 @@ DEPENDENCIES = ["api", "microphone"]
 CODEOWNERS = ["@jesserockz"]
 
 CONF_SILENCE_DETECTION = "silence_detection"
+CONF_AUDIO_FORMAT = "audio_format"
+CONF_VAD = "vad"
+CONF_ENERGY_THRESHOLD = "energy_threshold"
+CONF_HANGOVER = "hangover"
+CONF_SILENCE_TIMEOUT = "silence_timeout"
 CONF_ON_LISTENING = "on_listening"
 CONF_ON_START = "on_start"
 CONF_ON_STT_END = "on_stt_end"
@@ -42,6 +48,12 @@ IsRunningCondition = voice_assistant_ns.class_(
     "IsRunningCondition", automation.Condition, cg.Parented.template(VoiceAssistant)
 )
 
+api_enums = api_ns.namespace("enums")
+AUDIO_FORMATS = {
+    "PCM": api_enums.VOICE_ASSISTANT_AUDIO_FORMAT_PCM,
+    "IMA_ADPCM": api_enums.VOICE_ASSISTANT_AUDIO_FORMAT_IMA_ADPCM,
+}
+
 
 CONFIG_SCHEMA = cv.Schema(
     {
@@ -50,6 +62,23 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Exclusive(CONF_SPEAKER, "output"): cv.use_id(speaker.Speaker),
         cv.Exclusive(CONF_MEDIA_PLAYER, "output"): cv.use_id(media_player.MediaPlayer),
         cv.Optional(CONF_SILENCE_DETECTION, default=True): cv.boolean,
+        cv.Optional(CONF_AUDIO_FORMAT, default="PCM"): cv.enum(
+            AUDIO_FORMATS, upper=True, space="_"
+        ),
+        cv.Optional(CONF_VAD): cv.Schema(
+            {
+                # dBFS
+                cv.Optional(CONF_ENERGY_THRESHOLD, default=-50): cv.float_range(
+                    min=-90, max=0
+                ),
+                cv.Optional(
+                    CONF_HANGOVER, default="300ms"
+                ): cv.positive_time_period_milliseconds,
+                cv.Optional(
+                    CONF_SILENCE_TIMEOUT, default="1s"
+                ): cv.positive_time_period_milliseconds,
+            }
+        ),
         cv.Optional(CONF_ON_LISTENING): automation.validate_automation(single=True),
         cv.Optional(CONF_ON_START): automation.validate_automation(single=True),
         cv.Optional(CONF_ON_STT_END): automation.validate_automation(single=True),
@@ -77,6 +106,15 @@ async def to_code(config):
         cg.add(var.set_media_player(mp))
 
     cg.add(var.set_silence_detection(config[CONF_SILENCE_DETECTION]))
+    cg.add(var.set_audio_format(config[CONF_AUDIO_FORMAT]))
+
+    if CONF_VAD in config:
+        vad = config[CONF_VAD]
+        cg.add(
+            var.set_vad(
+                vad[CONF_ENERGY_THRESHOLD], vad[CONF_HANGOVER], vad[CONF_SILENCE_TIMEOUT]
+            )
+        )
 
     if CONF_ON_LISTENING in config:
         await automation.build_automation(
@@ -0,0 +1,65 @@
+#include "ima_adpcm.h"
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace voice_assistant {
+
+static const int16_t STEP_TABLE[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,    25,    28,
+    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,   337,   371,   408,   449,   494,
+    544,   598,   658,   724,   796,   876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,
+    9493,  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+};
+static const int8_t INDEX_TABLE[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+uint8_t ImaAdpcmEncoder::encode_sample_(int16_t sample) {
+  int32_t step = STEP_TABLE[this->index_];
+  int32_t diff = sample - this->predictor_;
+  uint8_t nibble = 0;
+  if (diff < 0) {
+    nibble = 8;
+    diff = -diff;
+  }
+
+  // Same rounding as the decoder, so both predict the same sample
+  int32_t delta = step >> 3;
+  if (diff >= step) {
+    nibble |= 4;
+    diff -= step;
+    delta += step;
+  }
+  step >>= 1;
+  if (diff >= step) {
+    nibble |= 2;
+    diff -= step;
+    delta += step;
+  }
+  step >>= 1;
+  if (diff >= step) {
+    nibble |= 1;
+    delta += step;
+  }
+
+  this->predictor_ = clamp<int32_t>(this->predictor_ + ((nibble & 8) ? -delta : delta), INT16_MIN, INT16_MAX);
+  this->index_ = clamp<int32_t>(this->index_ + INDEX_TABLE[nibble & 7], 0, 88);
+  return nibble;
+}
+
+size_t ImaAdpcmEncoder::encode_block(const int16_t *samples, size_t count, uint8_t *out) {
+  out[0] = this->predictor_ & 0xFF;
+  out[1] = (this->predictor_ >> 8) & 0xFF;
+  out[2] = this->index_;
+  out[3] = 0;
+  uint8_t *data = out + HEADER_SIZE;
+  for (size_t i = 0; i + 1 < count; i += 2) {
+    uint8_t low = this->encode_sample_(samples[i]);
+    *data++ = low | (this->encode_sample_(samples[i + 1]) << 4);
+  }
+  return data - out;
+}
+
+}  // namespace voice_assistant
+}  // namespace esphome
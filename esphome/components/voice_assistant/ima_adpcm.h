@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace voice_assistant {
+
+/** IMA ADPCM encoder for 16 bit mono audio, turns every sample into 4 bits.
+ *
+ * Each encoded block starts with a header of the state before its first sample, the predicted sample as int16 little
+ * endian, the index into the step table and a zero byte, followed by the samples as nibbles, low nibble first. The
+ * state carries over from one block to the next, but thanks to the header a lost block only loses its own samples.
+ */
+class ImaAdpcmEncoder {
+ public:
+  static const size_t HEADER_SIZE = 4;
+
+  /// Encoded size of a block of count samples, count has to be even.
+  static constexpr size_t encoded_size(size_t count) { return HEADER_SIZE + count / 2; }
+
+  void reset() {
+    this->predictor_ = 0;
+    this->index_ = 0;
+  }
+  /// Encode count samples into out, which needs room for encoded_size(count) bytes, returns the bytes written.
+  size_t encode_block(const int16_t *samples, size_t count, uint8_t *out);
+
+ protected:
+  uint8_t encode_sample_(int16_t sample);
+
+  int32_t predictor_{0};
+  uint8_t index_{0};
+};
+
+}  // namespace voice_assistant
+}  // namespace esphome
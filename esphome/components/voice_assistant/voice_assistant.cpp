@@ -4,6 +4,9 @@
 
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
 #include <cstdio>
 
 namespace esphome {
@@ -57,17 +60,106 @@ void VoiceAssistant::setup() {
     }
   }
 #endif
+}
 
-  this->mic_->add_data_callback([this](const std::vector<int16_t> &data) {
-    if (!this->running_) {
-      return;
+void VoiceAssistant::set_vad(float energy_threshold_db, uint32_t hangover_ms, uint32_t silence_timeout_ms) {
+  this->vad_ = true;
+  // dBFS to the mean square of 16 bit samples
+  this->vad_energy_threshold_ = static_cast<uint32_t>(powf(10.0f, energy_threshold_db / 10.0f) * 32768.0f * 32768.0f);
+  this->vad_hangover_frames_ = hangover_ms / SEND_FRAME_DURATION_MS;
+  this->vad_silence_timeout_frames_ = silence_timeout_ms / SEND_FRAME_DURATION_MS;
+}
+
+void VoiceAssistant::send_audio_() {
+  // The microphone buffers what it captured, send it on in frames of a fixed size so the
+  // pipeline sees a steady packet rate no matter how late this loop runs.
+  while (this->running_) {
+    size_t len = this->mic_->read(reinterpret_cast<int16_t *>(this->frame_ + this->frame_len_),
+                                  SEND_FRAME_SIZE - this->frame_len_);
+    if (len == 0)
+      break;
+    this->frame_len_ += len;
+    if (this->frame_len_ < SEND_FRAME_SIZE)
+      break;
+    this->frame_len_ = 0;
+    if (this->vad_ && !this->vad_process_frame_())
+      continue;
+    this->send_frame_(this->frame_);
+  }
+}
+
+void VoiceAssistant::send_frame_(const uint8_t *frame) {
+  if (this->stream_format_ == api::enums::VOICE_ASSISTANT_AUDIO_FORMAT_IMA_ADPCM) {
+    static const size_t SAMPLES = SEND_FRAME_SIZE / sizeof(int16_t);
+    uint8_t encoded[ImaAdpcmEncoder::encoded_size(SAMPLES)];
+    size_t len = this->adpcm_encoder_.encode_block(reinterpret_cast<const int16_t *>(frame), SAMPLES, encoded);
+    this->socket_->sendto(encoded, len, 0, (struct sockaddr *) &this->dest_addr_, sizeof(this->dest_addr_));
+  } else {
+    this->socket_->sendto(frame, SEND_FRAME_SIZE, 0, (struct sockaddr *) &this->dest_addr_, sizeof(this->dest_addr_));
+  }
+  this->sent_frames_++;
+}
+
+bool VoiceAssistant::vad_is_speech_(const int16_t *samples, size_t count) {
+  uint64_t sum = 0;
+  size_t crossings = 0;
+  for (size_t i = 0; i < count; i++) {
+    sum += int32_t(samples[i]) * samples[i];
+    if (i > 0 && (samples[i] < 0) != (samples[i - 1] < 0))
+      crossings++;
+  }
+  const uint32_t energy = sum / count;
+  const uint64_t threshold = std::max<uint64_t>(this->vad_energy_threshold_, uint64_t(this->vad_noise_floor_) * 4);
+  if (energy > threshold || (energy > threshold / 4 && crossings > count / 4))
+    return true;
+
+  // Drops to quiet stretches right away, rises slowly so speech doesn't raise it
+  if (energy < this->vad_noise_floor_) {
+    this->vad_noise_floor_ = energy;
+  } else {
+    this->vad_noise_floor_ += (energy - this->vad_noise_floor_) / 64;
+  }
+  return false;
+}
+
+bool VoiceAssistant::vad_process_frame_() {
+  if (this->vad_is_speech_(reinterpret_cast<const int16_t *>(this->frame_), SEND_FRAME_SIZE / sizeof(int16_t))) {
+    if (!this->vad_speech_detected_) {
+      this->vad_speech_detected_ = true;
+      size_t first = (this->vad_pre_roll_next_ + VAD_PRE_ROLL_FRAMES - this->vad_pre_roll_count_) % VAD_PRE_ROLL_FRAMES;
+      for (size_t i = 0; i < this->vad_pre_roll_count_; i++) {
+        this->send_frame_(&this->vad_pre_roll_[((first + i) % VAD_PRE_ROLL_FRAMES) * SEND_FRAME_SIZE]);
+        this->dropped_frames_--;
+      }
+      this->vad_pre_roll_count_ = 0;
     }
-    this->socket_->sendto(data.data(), data.size() * sizeof(int16_t), 0, (struct sockaddr *) &this->dest_addr_,
-                          sizeof(this->dest_addr_));
-  });
+    this->vad_silent_frames_ = 0;
+    return true;
+  }
+
+  this->vad_silent_frames_++;
+  if (this->vad_speech_detected_) {
+    if (this->vad_silent_frames_ <= this->vad_hangover_frames_)
+      return true;
+    if (this->vad_silent_frames_ >= this->vad_silence_timeout_frames_) {
+      ESP_LOGD(TAG, "End of speech detected");
+      this->signal_stop();
+    }
+    this->dropped_frames_++;
+    return false;
+  }
+
+  // Still waiting for speech, keep the frame in case speech starts with the next one
+  memcpy(&this->vad_pre_roll_[this->vad_pre_roll_next_ * SEND_FRAME_SIZE], this->frame_, SEND_FRAME_SIZE);
+  this->vad_pre_roll_next_ = (this->vad_pre_roll_next_ + 1) % VAD_PRE_ROLL_FRAMES;
+  this->vad_pre_roll_count_ = std::min(this->vad_pre_roll_count_ + 1, VAD_PRE_ROLL_FRAMES);
+  this->dropped_frames_++;
+  return false;
 }
 
 void VoiceAssistant::loop() {
+  if (this->running_ && this->mic_->is_running())
+    this->send_audio_();
 #ifdef USE_SPEAKER
   if (this->speaker_ != nullptr) {
     uint8_t buf[1024];
@@ -107,7 +199,8 @@ void VoiceAssistant::loop() {
   });
 }
 
-void VoiceAssistant::start(struct sockaddr_storage *addr, uint16_t port) {
+void VoiceAssistant::start(struct sockaddr_storage *addr, uint16_t port,
+                           api::enums::VoiceAssistantAudioFormat audio_format) {
   ESP_LOGD(TAG, "Starting...");
 
   memcpy(&this->dest_addr_, addr, sizeof(this->dest_addr_));
@@ -123,7 +216,25 @@ void VoiceAssistant::start(struct sockaddr_storage *addr, uint16_t port) {
     ESP_LOGW(TAG, "Unknown address family: %d", this->dest_addr_.ss_family);
     return;
   }
+  // Only what was offered, an older Home Assistant answers PCM
+  this->stream_format_ = api::enums::VOICE_ASSISTANT_AUDIO_FORMAT_PCM;
+  if (audio_format == this->audio_format_)
+    this->stream_format_ = audio_format;
+  if (this->stream_format_ == api::enums::VOICE_ASSISTANT_AUDIO_FORMAT_IMA_ADPCM) {
+    ESP_LOGD(TAG, "Sending IMA ADPCM audio");
+    this->adpcm_encoder_.reset();
+  }
   this->running_ = true;
+  this->frame_len_ = 0;
+  this->sent_frames_ = 0;
+  this->dropped_frames_ = 0;
+  if (this->vad_) {
+    this->vad_pre_roll_.resize(VAD_PRE_ROLL_FRAMES * SEND_FRAME_SIZE);
+    this->vad_pre_roll_count_ = 0;
+    this->vad_speech_detected_ = false;
+    this->vad_silent_frames_ = 0;
+    this->vad_noise_floor_ = 0;
+  }
   this->mic_->start();
   this->listening_trigger_->trigger();
 }
@@ -142,6 +253,10 @@ void VoiceAssistant::request_start(bool continuous) {
 
 void VoiceAssistant::signal_stop() {
   ESP_LOGD(TAG, "Signaling stop...");
+  if (this->vad_ && this->running_) {
+    ESP_LOGD(TAG, "Sent %" PRIu32 " frames, dropped %" PRIu32 " silent frames", this->sent_frames_,
+             this->dropped_frames_);
+  }
   this->mic_->stop();
   this->running_ = false;
   api::global_api_server->stop_voice_assistant();
@@ -19,6 +19,8 @@
 #endif
 #include "esphome/components/socket/socket.h"
 
+#include "ima_adpcm.h"
+
 namespace esphome {
 namespace voice_assistant {
 
@@ -28,12 +30,18 @@ namespace voice_assistant {
 static const uint32_t INITIAL_VERSION = 1;
 static const uint32_t SPEAKER_SUPPORT = 2;
 
+/// Bytes of audio per UDP packet, 16 ms of 16 kHz 16 bit mono.
+static const size_t SEND_FRAME_SIZE = 512;
+static const uint32_t SEND_FRAME_DURATION_MS = 16;
+/// Silent frames kept while waiting for speech and sent ahead of it, so the start of the first word isn't cut off.
+static const size_t VAD_PRE_ROLL_FRAMES = 4;
+
 class VoiceAssistant : public Component {
  public:
   void setup() override;
   void loop() override;
   float get_setup_priority() const override;
-  void start(struct sockaddr_storage *addr, uint16_t port);
+  void start(struct sockaddr_storage *addr, uint16_t port, api::enums::VoiceAssistantAudioFormat audio_format);
 
   void set_microphone(microphone::Microphone *mic) { this->mic_ = mic; }
 #ifdef USE_SPEAKER
@@ -43,6 +51,10 @@ class VoiceAssistant : public Component {
   void set_media_player(media_player::MediaPlayer *media_player) { this->media_player_ = media_player; }
 #endif
 
+  /// Format to offer Home Assistant for the microphone audio, it falls back to PCM if Home Assistant doesn't know it.
+  void set_audio_format(api::enums::VoiceAssistantAudioFormat audio_format) { this->audio_format_ = audio_format; }
+  api::enums::VoiceAssistantAudioFormat get_audio_format() const { return this->audio_format_; }
+
   uint32_t get_version() const {
 #ifdef USE_SPEAKER
     if (this->speaker_ != nullptr) {
@@ -63,6 +75,17 @@ class VoiceAssistant : public Component {
 
   void set_silence_detection(bool silence_detection) { this->silence_detection_ = silence_detection; }
 
+  /** Only stream frames with speech in them and end the stream once the speaker stopped talking.
+   *
+   * A frame counts as speech when its mean energy is above both the threshold and 6 dB above the tracked noise floor,
+   * or, for unvoiced sounds like "s" and "f", when it is above a quarter of that and the signal crosses zero often.
+   * Frames within the hangover after speech are still sent, after that silent frames are dropped and the stream
+   * ends once there was no speech for the silence timeout.
+   */
+  void set_vad(float energy_threshold_db, uint32_t hangover_ms, uint32_t silence_timeout_ms);
+  uint32_t get_sent_frames() const { return this->sent_frames_; }
+  uint32_t get_dropped_frames() const { return this->dropped_frames_; }
+
   Trigger<> *get_listening_trigger() const { return this->listening_trigger_; }
   Trigger<> *get_start_trigger() const { return this->start_trigger_; }
   Trigger<std::string> *get_stt_end_trigger() const { return this->stt_end_trigger_; }
@@ -72,6 +95,12 @@ class VoiceAssistant : public Component {
   Trigger<std::string, std::string> *get_error_trigger() const { return this->error_trigger_; }
 
  protected:
+  void send_audio_();
+  /// Run the VAD on the complete frame, returns whether to send it.
+  bool vad_process_frame_();
+  bool vad_is_speech_(const int16_t *samples, size_t count);
+  void send_frame_(const uint8_t *frame);
+
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   struct sockaddr_storage dest_addr_;
 
@@ -84,6 +113,12 @@ class VoiceAssistant : public Component {
   Trigger<std::string, std::string> *error_trigger_ = new Trigger<std::string, std::string>();
 
   microphone::Microphone *mic_{nullptr};
+  uint8_t frame_[SEND_FRAME_SIZE];
+  size_t frame_len_{0};
+  api::enums::VoiceAssistantAudioFormat audio_format_{api::enums::VOICE_ASSISTANT_AUDIO_FORMAT_PCM};
+  /// Format agreed on for the running stream.
+  api::enums::VoiceAssistantAudioFormat stream_format_{api::enums::VOICE_ASSISTANT_AUDIO_FORMAT_PCM};
+  ImaAdpcmEncoder adpcm_encoder_;
 #ifdef USE_SPEAKER
   speaker::Speaker *speaker_{nullptr};
 #endif
@@ -97,6 +132,21 @@ class VoiceAssistant : public Component {
   bool running_{false};
   bool continuous_{false};
   bool silence_detection_;
+
+  bool vad_{false};
+  /// Mean square of the samples a speech frame needs at least.
+  uint32_t vad_energy_threshold_{0};
+  uint32_t vad_hangover_frames_{0};
+  uint32_t vad_silence_timeout_frames_{0};
+  uint32_t vad_noise_floor_{0};
+  bool vad_speech_detected_{false};
+  /// Frames since the last one with speech.
+  uint32_t vad_silent_frames_{0};
+  std::vector<uint8_t> vad_pre_roll_;
+  size_t vad_pre_roll_count_{0};
+  size_t vad_pre_roll_next_{0};
+  uint32_t sent_frames_{0};
+  uint32_t dropped_frames_{0};
 };
 
 template<typename... Ts> class StartAction : public Action<Ts...>, public Parented<VoiceAssistant> {
@@ -2,6 +2,8 @@
 
 #include "esphome/core/component.h"
 
+#include <functional>
+
 namespace esphome {
 namespace voltage_sampler {
 
@@ -10,6 +12,14 @@ class VoltageSampler {
  public:
   /// Get a voltage reading, in V.
   virtual float sample() = 0;
+
+  /** Register a callback for the blocks of readings, in V, of a source that samples continuously.
+   *
+   * @return false if this source can only be sampled on demand with sample().
+   */
+  virtual bool add_on_samples_callback(std::function<void(const float *samples, size_t count)> &&callback) {
+    return false;
+  }
 };
 
 }  // namespace voltage_sampler
@@ -3,6 +3,7 @@
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include <cinttypes>
+#include <cstring>
 
 namespace esphome {
 namespace waveshare_epaper {
@@ -124,7 +125,31 @@ bool WaveshareEPaper::wait_until_idle_() {
   }
   return true;
 }
+void WaveshareEPaper::wait_until_idle_async_(std::function<void()> &&f) {
+  if (this->busy_pin_ == nullptr || !this->busy_pin_->digital_read()) {
+    f();
+    return;
+  }
+
+  const uint32_t start = millis();
+  this->waiting_for_idle_ = true;
+  this->set_interval("busy", 10, [this, start, f = std::move(f)]() mutable {
+    if (this->busy_pin_->digital_read()) {
+      if (millis() - start <= this->idle_timeout_())
+        return;
+      ESP_LOGE(TAG, "Timeout while displaying image!");
+    }
+    auto callback = std::move(f);
+    this->cancel_interval("busy");
+    this->waiting_for_idle_ = false;
+    callback();
+  });
+}
 void WaveshareEPaper::update() {
+  if (this->waiting_for_idle_) {
+    ESP_LOGW(TAG, "Display is still refreshing, skipping update");
+    return;
+  }
   this->do_update_();
   this->display();
 }
@@ -160,6 +185,53 @@ void WaveshareEPaper::start_data_() {
   this->enable();
 }
 void WaveshareEPaper::end_data_() { this->disable(); }
+void WaveshareEPaper::write_repeated_(uint8_t value, uint32_t length) {
+  uint8_t chunk[64];
+  memset(chunk, value, sizeof(chunk));
+  while (length > 0) {
+    const uint32_t len = std::min<uint32_t>(length, sizeof(chunk));
+    this->write_array_async(chunk, len);
+    length -= len;
+  }
+  this->wait_async();
+}
+void WaveshareEPaper::write_buffer_inverted_() {
+  // Two chunks, one is converted while the other one is sent in the background
+  uint8_t chunks[2][64];
+  const uint32_t buf_len = this->get_buffer_length_();
+  uint8_t current = 0;
+  for (uint32_t i = 0; i < buf_len; i += sizeof(chunks[0])) {
+    const uint32_t len = std::min<uint32_t>(buf_len - i, sizeof(chunks[0]));
+    this->wait_async(1);
+    for (uint32_t j = 0; j < len; j++)
+      chunks[current][j] = ~this->buffer_[i + j];
+    this->write_array_async(chunks[current], len);
+    current ^= 1;
+  }
+  this->wait_async();
+}
+void WaveshareEPaper::write_buffer_4bpp_() {
+  uint8_t chunks[2][64];
+  const uint32_t buf_len = this->get_buffer_length_();
+  uint8_t current = 0;
+  for (uint32_t i = 0; i < buf_len; i += sizeof(chunks[0]) / 4) {
+    const uint32_t len = std::min<uint32_t>(buf_len - i, sizeof(chunks[0]) / 4);
+    this->wait_async(1);
+    for (uint32_t j = 0; j < len; j++) {
+      uint8_t eight_pixels = this->buffer_[i + j];
+      for (uint8_t k = 0; k < 4; k++) {
+        uint8_t left_nibble = (eight_pixels & 0x80) ? 0x30 : 0x00;
+        uint8_t right_nibble = (eight_pixels & 0x40) ? 0x03 : 0x00;
+        chunks[current][j * 4 + k] = left_nibble | right_nibble;
+        eight_pixels <<= 2;
+      }
+    }
+    this->write_array_async(chunks[current], len * 4);
+    current ^= 1;
+    App.feed_wdt();
+  }
+  this->wait_async();
+}
 void WaveshareEPaper::on_safe_shutdown() { this->deep_sleep(); }
 
 // ========================================================
@@ -261,6 +333,22 @@ void HOT WaveshareEPaperTypeA::display() {
   bool full_update = this->at_update_ == 0;
   bool prev_full_update = this->at_update_ == 1;
 
+  // Partial updates only send the rows that changed since the last frame, and nothing if none did
+  const uint32_t row_len = this->get_width_controller() / 8u;
+  int first_row = 0;
+  int last_row = this->get_height_internal() - 1;
+  if (!full_update && this->previous_buffer_ != nullptr) {
+    while (first_row <= last_row &&
+           memcmp(this->buffer_ + first_row * row_len, this->previous_buffer_ + first_row * row_len, row_len) == 0)
+      first_row++;
+    if (first_row > last_row) {
+      ESP_LOGV(TAG, "Frame didn't change, skipping partial update");
+      return;
+    }
+    while (memcmp(this->buffer_ + last_row * row_len, this->previous_buffer_ + last_row * row_len, row_len) == 0)
+      last_row--;
+  }
+
   if (!this->wait_until_idle_()) {
     this->status_set_warning();
     return;
@@ -324,18 +412,18 @@ void HOT WaveshareEPaperTypeA::display() {
       this->data((this->get_width_internal() - 1) >> 3);
       // COMMAND SET RAM Y ADDRESS START END POSITION
       this->command(0x45);
-      this->data(0x00);
-      this->data(0x00);
-      this->data(this->get_height_internal() - 1);
-      this->data((this->get_height_internal() - 1) >> 8);
+      this->data(first_row);
+      this->data(first_row >> 8);
+      this->data(last_row);
+      this->data(last_row >> 8);
 
       // COMMAND SET RAM X ADDRESS COUNTER
       this->command(0x4E);
       this->data(0x00);
       // COMMAND SET RAM Y ADDRESS COUNTER
       this->command(0x4F);
-      this->data(0x00);
-      this->data(0x00);
+      this->data(first_row);
+      this->data(first_row >> 8);
   }
 
   if (!this->wait_until_idle_()) {
@@ -349,19 +437,25 @@ void HOT WaveshareEPaperTypeA::display() {
   switch (this->model_) {
     case TTGO_EPAPER_2_13_IN_B1: {  // block needed because of variable initializations
       int16_t wb = ((this->get_width_internal()) >> 3);
-      for (int i = 0; i < this->get_height_internal(); i++) {
-        for (int j = 0; j < wb; j++) {
-          int idx = j + (this->get_height_internal() - 1 - i) * wb;
-          this->write_byte(this->buffer_[idx]);
-        }
-      }
+      for (int i = 0; i < this->get_height_internal(); i++)
+        this->write_array(this->buffer_ + (this->get_height_internal() - 1 - i) * wb, wb);
       break;
     }
     default:
-      this->write_array(this->buffer_, this->get_buffer_length_());
+      this->write_array(this->buffer_ + first_row * row_len, (last_row - first_row + 1) * row_len);
   }
   this->end_data_();
 
+  // The RAM of the B1 is written bottom up, it always gets the whole frame
+  if (this->full_update_every_ > 1 && this->model_ != TTGO_EPAPER_2_13_IN_B1) {
+    if (this->previous_buffer_ == nullptr) {
+      ExternalRAMAllocator<uint8_t> allocator(HeapTag::DISPLAY, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+      this->previous_buffer_ = allocator.allocate(this->get_buffer_length_());
+    }
+    if (this->previous_buffer_ != nullptr)
+      memcpy(this->previous_buffer_, this->buffer_, this->get_buffer_length_());
+  }
+
   // COMMAND DISPLAY UPDATE CONTROL 2
   this->command(0x22);
   switch (this->model_) {
@@ -575,17 +669,17 @@ void HOT WaveshareEPaper2P7In::display() {
   // COMMAND DATA START TRANSMISSION 1
   this->command(0x10);
   delay(2);
-  for (uint32_t i = 0; i < buf_len; i++) {
-    this->data(this->buffer_[i]);
-  }
+  this->start_data_();
+  this->write_array(this->buffer_, buf_len);
+  this->end_data_();
   delay(2);
 
   // COMMAND DATA START TRANSMISSION 2
   this->command(0x13);
   delay(2);
-  for (uint32_t i = 0; i < buf_len; i++) {
-    this->data(this->buffer_[i]);
-  }
+  this->start_data_();
+  this->write_array(this->buffer_, buf_len);
+  this->end_data_();
 
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
@@ -655,19 +749,18 @@ void HOT WaveshareEPaper2P9InB::display() {
   this->command(0x13);
   delay(2);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++)
-    this->write_byte(0x00);
+  this->write_repeated_(0x00, this->get_buffer_length_());
   this->end_data_();
   delay(2);
 
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
   delay(2);
-  this->wait_until_idle_();
-
-  // COMMAND POWER OFF
-  // NOTE: power off < deep sleep
-  this->command(0x02);
+  this->wait_until_idle_async_([this]() {
+    // COMMAND POWER OFF
+    // NOTE: power off < deep sleep
+    this->command(0x02);
+  });
 }
 int WaveshareEPaper2P9InB::get_width_internal() { return 128; }
 int WaveshareEPaper2P9InB::get_height_internal() { return 296; }
@@ -738,20 +831,18 @@ void HOT GDEY029T94::display() {
   this->command(0x13);
   delay(2);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++) {
-    this->write_byte(this->buffer_[i]);
-  }
+  this->write_array(this->buffer_, this->get_buffer_length_());
   this->end_data_();
   delay(2);
 
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
   delay(2);
-  this->wait_until_idle_();
-
-  // COMMAND POWER OFF
-  // NOTE: power off < deep sleep
-  this->command(0x02);
+  this->wait_until_idle_async_([this]() {
+    // COMMAND POWER OFF
+    // NOTE: power off < deep sleep
+    this->command(0x02);
+  });
 }
 int GDEY029T94::get_width_internal() { return 128; }
 int GDEY029T94::get_height_internal() { return 296; }
@@ -779,7 +870,7 @@ void GDEY029T94::dump_config() {
 
 void GDEW0154M09::initialize() {
   this->init_internal_();
-  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  ExternalRAMAllocator<uint8_t> allocator(HeapTag::DISPLAY, ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   this->lastbuff_ = allocator.allocate(this->get_buffer_length_());
   if (this->lastbuff_ != nullptr) {
     memset(this->lastbuff_, 0xff, sizeof(uint8_t) * this->get_buffer_length_());
@@ -854,13 +945,13 @@ void GDEW0154M09::clear_() {
   uint32_t pixsize = this->get_buffer_length_();
   for (uint8_t j = 0; j < 2; j++) {
     this->command(CMD_DTM1_DATA_START_TRANS);
-    for (int count = 0; count < pixsize; count++) {
-      this->data(0x00);
-    }
+    this->start_data_();
+    this->write_repeated_(0x00, pixsize);
+    this->end_data_();
     this->command(CMD_DTM2_DATA_START_TRANS2);
-    for (int count = 0; count < pixsize; count++) {
-      this->data(0xff);
-    }
+    this->start_data_();
+    this->write_repeated_(0xff, pixsize);
+    this->end_data_();
     this->command(CMD_DISPLAY_REFRESH);
     delay(10);
     this->wait_until_idle_();
@@ -871,17 +962,16 @@ void HOT GDEW0154M09::display() {
   this->init_internal_();
   // "Mode 0 display" for now
   this->command(CMD_DTM1_DATA_START_TRANS);
-  for (int i = 0; i < this->get_buffer_length_(); i++) {
-    this->data(0xff);
-  }
+  this->start_data_();
+  this->write_repeated_(0xff, this->get_buffer_length_());
+  this->end_data_();
   this->command(CMD_DTM2_DATA_START_TRANS2);  // write 'new' data to SRAM
-  for (int i = 0; i < this->get_buffer_length_(); i++) {
-    this->data(this->buffer_[i]);
-  }
+  this->start_data_();
+  this->write_array(this->buffer_, this->get_buffer_length_());
+  this->end_data_();
   this->command(CMD_DISPLAY_REFRESH);
   delay(10);
-  this->wait_until_idle_();
-  this->deep_sleep();
+  this->wait_until_idle_async_([this]() { this->deep_sleep(); });
 }
 
 void GDEW0154M09::deep_sleep() {
@@ -1058,18 +1148,17 @@ void HOT WaveshareEPaper4P2InBV2::display() {
   // COMMAND DATA START TRANSMISSION 2 (RED data)
   this->command(0x13);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++)
-    this->write_byte(0xFF);
+  this->write_repeated_(0xFF, this->get_buffer_length_());
   this->end_data_();
   delay(2);
 
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
-  this->wait_until_idle_();
-
-  // COMMAND POWER OFF
-  // NOTE: power off < deep sleep
-  this->command(0x02);
+  this->wait_until_idle_async_([this]() {
+    // COMMAND POWER OFF
+    // NOTE: power off < deep sleep
+    this->command(0x02);
+  });
 }
 int WaveshareEPaper4P2InBV2::get_width_internal() { return 400; }
 int WaveshareEPaper4P2InBV2::get_height_internal() { return 300; }
@@ -1139,30 +1228,7 @@ void HOT WaveshareEPaper5P8In::display() {
   this->command(0x10);
 
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++) {
-    uint8_t temp1 = this->buffer_[i];
-    for (uint8_t j = 0; j < 8; j++) {
-      uint8_t temp2;
-      if (temp1 & 0x80) {
-        temp2 = 0x03;
-      } else {
-        temp2 = 0x00;
-      }
-
-      temp2 <<= 4;
-      temp1 <<= 1;
-      j++;
-      if (temp1 & 0x80) {
-        temp2 |= 0x03;
-      } else {
-        temp2 |= 0x00;
-      }
-      temp1 <<= 1;
-      this->write_byte(temp2);
-    }
-
-    App.feed_wdt();
-  }
+  this->write_buffer_4bpp_();
   this->end_data_();
 
   // COMMAND DISPLAY REFRESH
@@ -1308,15 +1374,14 @@ void HOT WaveshareEPaper7P5InBV2::display() {
   this->command(0x13);
   delay(2);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++)
-    this->write_byte(0x00);
+  this->write_repeated_(0x00, this->get_buffer_length_());
   this->end_data_();
   delay(2);
 
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
   delay(100);  // NOLINT
-  this->wait_until_idle_();
+  this->wait_until_idle_async_([]() {});
 }
 int WaveshareEPaper7P5InBV2::get_width_internal() { return 800; }
 int WaveshareEPaper7P5InBV2::get_height_internal() { return 480; }
@@ -1451,18 +1516,16 @@ void WaveshareEPaper7P5InBV3::initialize() {
     this->data(lut_bb_7_i_n5_v2[count]);
 
   this->command(0x10);
-  for (uint32_t i = 0; i < 800 * 480 / 8; i++) {
-    this->data(0xFF);
-  }
+  this->start_data_();
+  this->write_repeated_(0xFF, 800 * 480 / 8);
+  this->end_data_();
 };
 void HOT WaveshareEPaper7P5InBV3::display() {
-  uint32_t buf_len = this->get_buffer_length_();
-
   this->command(0x13);  // Start Transmission
   delay(2);
-  for (uint32_t i = 0; i < buf_len; i++) {
-    this->data(~(this->buffer_[i]));
-  }
+  this->start_data_();
+  this->write_buffer_inverted_();
+  this->end_data_();
 
   this->command(0x12);  // Display Refresh
   delay(100);           // NOLINT
@@ -1525,28 +1588,7 @@ void HOT WaveshareEPaper7P5In::display() {
   // COMMAND DATA START TRANSMISSION 1
   this->command(0x10);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++) {
-    uint8_t temp1 = this->buffer_[i];
-    for (uint8_t j = 0; j < 8; j++) {
-      uint8_t temp2;
-      if (temp1 & 0x80) {
-        temp2 = 0x03;
-      } else {
-        temp2 = 0x00;
-      }
-      temp2 <<= 4;
-      temp1 <<= 1;
-      j++;
-      if (temp1 & 0x80) {
-        temp2 |= 0x03;
-      } else {
-        temp2 |= 0x00;
-      }
-      temp1 <<= 1;
-      this->write_byte(temp2);
-    }
-    App.feed_wdt();
-  }
+  this->write_buffer_4bpp_();
   this->end_data_();
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
@@ -1594,18 +1636,17 @@ void WaveshareEPaper7P5InV2::initialize() {
   this->data(0x22);
 }
 void HOT WaveshareEPaper7P5InV2::display() {
-  uint32_t buf_len = this->get_buffer_length_();
   // COMMAND DATA START TRANSMISSION NEW DATA
   this->command(0x13);
   delay(2);
-  for (uint32_t i = 0; i < buf_len; i++) {
-    this->data(~(this->buffer_[i]));
-  }
+  this->start_data_();
+  this->write_buffer_inverted_();
+  this->end_data_();
 
   // COMMAND DISPLAY REFRESH
   this->command(0x12);
   delay(100);  // NOLINT
-  this->wait_until_idle_();
+  this->wait_until_idle_async_([]() {});
 }
 
 int WaveshareEPaper7P5InV2::get_width_internal() { return 800; }
@@ -1807,23 +1848,9 @@ void HOT WaveshareEPaper7P5InBC::display() {
   // COMMAND DATA START TRANSMISSION 1
   this->command(0x10);
   this->start_data_();
-
-  for (size_t i = 0; i < this->get_buffer_length_(); i++) {
-    // A line of eight source pixels (each a bit in this byte)
-    uint8_t eight_pixels = this->buffer_[i];
-
-    for (uint8_t j = 0; j < 8; j += 2) {
-      /* For bichromatic displays, each byte represents two pixels. Each nibble encodes a pixel: 0=white, 3=black,
-      4=color. Therefore, e.g. 0x44 = two adjacent color pixels, 0x33 is two adjacent black pixels, etc. If you want
-      to draw using the color pixels, change '0x30' with '0x40' and '0x03' with '0x04' below. */
-      uint8_t left_nibble = (eight_pixels & 0x80) ? 0x30 : 0x00;
-      eight_pixels <<= 1;
-      uint8_t right_nibble = (eight_pixels & 0x80) ? 0x03 : 0x00;
-      eight_pixels <<= 1;
-      this->write_byte(left_nibble | right_nibble);
-    }
-    App.feed_wdt();
-  }
+  /* For bichromatic displays, each byte represents two pixels. Each nibble encodes a pixel: 0=white, 3=black,
+  4=color. Therefore, e.g. 0x44 = two adjacent color pixels, 0x33 is two adjacent black pixels, etc. */
+  this->write_buffer_4bpp_();
   this->end_data_();
 
   // Unlike the 7P5In display, we send the "power on" command here rather than during initialization
@@ -1925,8 +1952,7 @@ void HOT WaveshareEPaper7P5InHDB::display() {
   // RED
   this->command(0x26);
   this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++)
-    this->write_byte(0x00);
+  this->write_repeated_(0x00, this->get_buffer_length_());
   this->end_data_();
 
   this->command(0x22);
@@ -42,6 +42,11 @@ class WaveshareEPaper : public PollingComponent,
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
 
   bool wait_until_idle_();
+  /** Call f once the BUSY pin reports the display as idle, without blocking the loop during a refresh.
+   *
+   * Updates are skipped while waiting, f is also called after the idle timeout like after wait_until_idle_().
+   */
+  void wait_until_idle_async_(std::function<void()> &&f);
 
   void setup_pins_();
 
@@ -64,10 +69,19 @@ class WaveshareEPaper : public PollingComponent,
   void start_data_();
   void end_data_();
 
+  /// Write length bytes of value, call between start_data_() and end_data_().
+  void write_repeated_(uint8_t value, uint32_t length);
+  /// Write the buffer with every bit inverted, call between start_data_() and end_data_().
+  void write_buffer_inverted_();
+  /// Write the buffer with every pixel expanded to a nibble (0x0 white, 0x3 black), call between start_data_() and
+  /// end_data_().
+  void write_buffer_4bpp_();
+
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *dc_pin_;
   GPIOPin *busy_pin_{nullptr};
   virtual uint32_t idle_timeout_() { return 1000u; }  // NOLINT(readability-identifier-naming)
+  bool waiting_for_idle_{false};
 };
 
 enum WaveshareEPaperTypeAModel {
@@ -117,6 +131,8 @@ class WaveshareEPaperTypeA : public WaveshareEPaper {
 
   uint32_t full_update_every_{30};
   uint32_t at_update_{0};
+  /// The last frame sent to the display, partial updates only send the rows that changed since.
+  uint8_t *previous_buffer_{nullptr};
   WaveshareEPaperTypeAModel model_;
   uint32_t idle_timeout_() override;
 };
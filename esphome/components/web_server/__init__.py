@@ -1,4 +1,6 @@
 import gzip
+import hashlib
+from pathlib import Path
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import web_server_base
@@ -20,6 +22,7 @@ from esphome.const import (
     CONF_LOCAL,
 )
 from esphome.core import CORE, coroutine_with_priority
+from esphome.helpers import cpp_string_escape
 
 AUTO_LOAD = ["json", "web_server_base"]
 
@@ -130,6 +133,14 @@ def add_resource_as_progmem(
     )
     cg.add_global(cg.RawExpression(uint8_t))
     cg.add_global(cg.RawExpression(size_t))
+    add_resource_etag(resource_name, content_encoded)
+
+
+def add_resource_etag(resource_name: str, content: bytes) -> None:
+    """Add a strong ETag for a resource, derived from its content."""
+    etag = cpp_string_escape(f'"{hashlib.sha256(content).hexdigest()[:16]}"')
+    etag_def = f"const char ESPHOME_WEBSERVER_{resource_name}_ETAG[] = {etag}"
+    cg.add_global(cg.RawExpression(etag_def))
 
 
 @coroutine_with_priority(40.0)
@@ -170,3 +181,6 @@ async def to_code(config):
     cg.add(var.set_include_internal(config[CONF_INCLUDE_INTERNAL]))
     if CONF_LOCAL in config and config[CONF_LOCAL]:
         cg.add_define("USE_WEBSERVER_LOCAL")
+        add_resource_etag(
+            "INDEX_GZ", (Path(__file__).parent / "server_index.h").read_bytes()
+        )
@@ -4,7 +4,9 @@
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
 #include "esphome/core/entity_base.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include "esphome/core/trace.h"
 #include "esphome/core/util.h"
 
 #ifdef USE_ARDUINO
@@ -33,6 +35,9 @@ namespace esphome {
 namespace web_server {
 
 static const char *const TAG = "web_server";
+// State events are held back while the clients have this many events queued on average. Only the latest state of
+// each entity is kept meanwhile, so slow clients don't make the queues grow with every update.
+static const size_t EVENTS_MAX_PACKETS_WAITING = 4;
 
 #if USE_WEBSERVER_VERSION == 1
 void write_row(AsyncResponseStream *stream, EntityBase *obj, const std::string &klass, const std::string &action,
@@ -75,9 +80,11 @@ UrlMatch match_url(const std::string &url, bool only_domain = false) {
   match.valid = true;
   if (id_end == std::string::npos) {
     match.id = url.substr(id_begin, url.length() - id_begin);
+    match.key = fnv1_hash(match.id);
     return match;
   }
   match.id = url.substr(id_begin, id_end - id_begin);
+  match.key = fnv1_hash(match.id);
   size_t method_begin = id_end + 1;
   match.method = url.substr(method_begin, url.length() - method_begin);
   return match;
@@ -155,7 +162,40 @@ void WebServer::loop() {
     }
   }
 #endif
-  this->entities_iterator_.advance();
+#ifdef USE_ESP_IDF
+  this->events_.loop();
+#endif
+  if (this->events_.count() == 0) {
+    this->pending_states_.clear();
+    return;
+  }
+  while (!this->pending_states_.empty() && !this->events_backlogged_()) {
+    this->events_.send(this->pending_states_.front().second().c_str(), "state");
+    this->pending_states_.erase(this->pending_states_.begin());
+    this->states_sent_++;
+  }
+  if (!this->events_backlogged_())
+    this->entities_iterator_.advance();
+}
+bool WebServer::events_backlogged_() { return this->events_.avgPacketsWaiting() >= EVENTS_MAX_PACKETS_WAITING; }
+void WebServer::send_state_(EntityBase *obj, std::function<std::string()> &&json) {
+  // nobody to tell, a client that connects later gets all states when it does
+  if (this->events_.count() == 0)
+    return;
+  if (this->pending_states_.empty() && !this->events_backlogged_()) {
+    this->events_.send(json().c_str(), "state");
+    this->states_sent_++;
+    return;
+  }
+  // the JSON is built when the event is sent, so an entity already waiting will go out with its latest state
+  for (auto &pending : this->pending_states_) {
+    if (pending.first == obj) {
+      this->states_coalesced_++;
+      return;
+    }
+  }
+  this->states_deferred_++;
+  this->pending_states_.emplace_back(obj, std::move(json));
 }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
@@ -165,9 +205,7 @@ float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f
 
 #ifdef USE_WEBSERVER_LOCAL
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
-  AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", INDEX_GZ, sizeof(INDEX_GZ));
-  response->addHeader("Content-Encoding", "gzip");
-  request->send(response);
+  this->send_asset_(request, "text/html", INDEX_GZ, sizeof(INDEX_GZ), ESPHOME_WEBSERVER_INDEX_GZ_ETAG, true);
 }
 #elif USE_WEBSERVER_VERSION == 1
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
@@ -326,31 +364,57 @@ void WebServer::handle_index_request(AsyncWebServerRequest *request) {
 }
 #elif USE_WEBSERVER_VERSION == 2
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
-  AsyncWebServerResponse *response =
-      request->beginResponse_P(200, "text/html", ESPHOME_WEBSERVER_INDEX_HTML, ESPHOME_WEBSERVER_INDEX_HTML_SIZE);
   // No gzip header here because the HTML file is so small
-  request->send(response);
+  this->send_asset_(request, "text/html", ESPHOME_WEBSERVER_INDEX_HTML, ESPHOME_WEBSERVER_INDEX_HTML_SIZE,
+                    ESPHOME_WEBSERVER_INDEX_HTML_ETAG, false);
 }
 #endif
 
 #ifdef USE_WEBSERVER_CSS_INCLUDE
 void WebServer::handle_css_request(AsyncWebServerRequest *request) {
-  AsyncWebServerResponse *response =
-      request->beginResponse_P(200, "text/css", ESPHOME_WEBSERVER_CSS_INCLUDE, ESPHOME_WEBSERVER_CSS_INCLUDE_SIZE);
-  response->addHeader("Content-Encoding", "gzip");
-  request->send(response);
+  this->send_asset_(request, "text/css", ESPHOME_WEBSERVER_CSS_INCLUDE, ESPHOME_WEBSERVER_CSS_INCLUDE_SIZE,
+                    ESPHOME_WEBSERVER_CSS_INCLUDE_ETAG, true);
 }
 #endif
 
 #ifdef USE_WEBSERVER_JS_INCLUDE
 void WebServer::handle_js_request(AsyncWebServerRequest *request) {
-  AsyncWebServerResponse *response =
-      request->beginResponse_P(200, "text/javascript", ESPHOME_WEBSERVER_JS_INCLUDE, ESPHOME_WEBSERVER_JS_INCLUDE_SIZE);
-  response->addHeader("Content-Encoding", "gzip");
-  request->send(response);
+  this->send_asset_(request, "text/javascript", ESPHOME_WEBSERVER_JS_INCLUDE, ESPHOME_WEBSERVER_JS_INCLUDE_SIZE,
+                                      ESPHOME_WEBSERVER_JS_INCLUDE_ETAG, true);
+}
+#endif
+
+#ifdef USE_TRACE
+void WebServer::handle_trace_request(AsyncWebServerRequest *request) {
+  AsyncResponseStream *stream = request->beginResponseStream("application/json");
+  trace::dump_chrome_trace([stream](const char *chunk) { stream->print(chunk); });
+  request->send(stream);
 }
 #endif
 
+void WebServer::send_asset_(AsyncWebServerRequest *request, const char *content_type, const uint8_t *data,
+                            size_t size, const char *etag, bool gzip) {
+  // The ETag is a hash of the content, so browsers can cache the asset and only revalidate it on each load.
+#ifdef USE_ARDUINO
+  AsyncWebHeader *if_none_match = request->getHeader("If-None-Match");
+  const bool not_modified = if_none_match != nullptr && if_none_match->value() == etag;
+#else
+  auto if_none_match = request->get_header("If-None-Match");
+  const bool not_modified = if_none_match.has_value() && *if_none_match == etag;
+#endif
+  AsyncWebServerResponse *response;
+  if (not_modified) {
+    response = request->beginResponse(304, content_type);
+  } else {
+    response = request->beginResponse_P(200, content_type, data, size);
+    if (gzip)
+      response->addHeader("Content-Encoding", "gzip");
+  }
+  response->addHeader("ETag", etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
 #define set_json_id(root, obj, sensor, start_config) \
   (root)["id"] = sensor; \
   if (((start_config) == DETAIL_ALL)) \
@@ -369,12 +433,11 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->sensor_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
+  sensor::Sensor *obj = App.get_sensor_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     std::string data = this->sensor_json(obj, obj->state, DETAIL_STATE);
     request->send(200, "application/json", data.c_str());
     return;
@@ -398,12 +461,11 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->text_sensor_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
+  text_sensor::TextSensor *obj = App.get_text_sensor_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     std::string data = this->text_sensor_json(obj, obj->state, DETAIL_STATE);
     request->send(200, "application/json", data.c_str());
     return;
@@ -420,7 +482,7 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->switch_json(obj, obj->state, DETAIL_STATE); });
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
@@ -431,10 +493,8 @@ std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail
   });
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  switch_::Switch *obj = App.get_switch_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->switch_json(obj, obj->state, DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
@@ -463,9 +523,8 @@ std::string WebServer::button_json(button::Button *obj, JsonDetail start_config)
 }
 
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (button::Button *obj : App.get_buttons()) {
-    if (obj->get_object_id() != match.id)
-      continue;
+  button::Button *obj = App.get_button_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_POST && match.method == "press") {
       this->schedule_([obj]() { obj->press(); });
       request->send(200);
@@ -481,7 +540,7 @@ void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlM
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->binary_sensor_json(obj, obj->state, DETAIL_STATE); });
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
@@ -489,9 +548,8 @@ std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool
   });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
+  binary_sensor::BinarySensor *obj = App.get_binary_sensor_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     std::string data = this->binary_sensor_json(obj, obj->state, DETAIL_STATE);
     request->send(200, "application/json", data.c_str());
     return;
@@ -501,7 +559,9 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::Fan *obj) { this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state"); }
+void WebServer::on_fan_update(fan::Fan *obj) {
+  this->send_state_(obj, [this, obj]() { return this->fan_json(obj, DETAIL_STATE); });
+}
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
   return json::build_json([obj, start_config](JsonObject root) {
     set_json_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state, start_config);
@@ -515,10 +575,8 @@ std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
   });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (fan::Fan *obj : App.get_fans()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  fan::Fan *obj = App.get_fan_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->fan_json(obj, DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
@@ -570,13 +628,11 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
 
 #ifdef USE_LIGHT
 void WebServer::on_light_update(light::LightState *obj) {
-  this->events_.send(this->light_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->light_json(obj, DETAIL_STATE); });
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (light::LightState *obj : App.get_lights()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  light::LightState *obj = App.get_light_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->light_json(obj, DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
@@ -676,17 +732,15 @@ std::string WebServer::light_json(light::LightState *obj, JsonDetail start_confi
 
 #ifdef USE_COVER
 void WebServer::on_cover_update(cover::Cover *obj) {
-  this->events_.send(this->cover_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->cover_json(obj, DETAIL_STATE); });
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (cover::Cover *obj : App.get_covers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  cover::Cover *obj = App.get_cover_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->cover_json(obj, DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
-      continue;
+      return;
     }
 
     auto call = obj->make_call();
@@ -741,13 +795,11 @@ std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  this->events_.send(this->number_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->number_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_numbers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  auto *obj = App.get_number_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->number_json(obj, obj->state, DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
@@ -797,13 +849,11 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  this->events_.send(this->select_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->select_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_selects()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  auto *obj = App.get_select_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->select_json(obj, obj->state, DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
@@ -846,14 +896,12 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 
 #ifdef USE_CLIMATE
 void WebServer::on_climate_update(climate::Climate *obj) {
-  this->events_.send(this->climate_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->climate_json(obj, DETAIL_STATE); });
 }
 
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_climates()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  auto *obj = App.get_climate_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->climate_json(obj, DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
@@ -987,7 +1035,7 @@ std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_conf
 
 #ifdef USE_LOCK
 void WebServer::on_lock_update(lock::Lock *obj) {
-  this->events_.send(this->lock_json(obj, obj->state, DETAIL_STATE).c_str(), "state");
+  this->send_state_(obj, [this, obj]() { return this->lock_json(obj, obj->state, DETAIL_STATE); });
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
   return json::build_json([obj, value, start_config](JsonObject root) {
@@ -996,10 +1044,8 @@ std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDet
   });
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (lock::Lock *obj : App.get_locks()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  lock::Lock *obj = App.get_lock_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->lock_json(obj, obj->state, DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
@@ -1023,7 +1069,8 @@ void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMat
 
 #ifdef USE_ALARM_CONTROL_PANEL
 void WebServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
-  this->events_.send(this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE).c_str(), "state");
+  this->send_state_(
+      obj, [this, obj]() { return this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE); });
 }
 std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
                                                 alarm_control_panel::AlarmControlPanelState value,
@@ -1035,10 +1082,8 @@ std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmContro
   });
 }
 void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (alarm_control_panel::AlarmControlPanel *obj : App.get_alarm_control_panels()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
+  alarm_control_panel::AlarmControlPanel *obj = App.get_alarm_control_panel_by_key(match.key, true);
+  if (obj != nullptr && obj->get_object_id() == match.id) {
     if (request->method() == HTTP_GET) {
       std::string data = this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE);
       request->send(200, "application/json", data.c_str());
@@ -1050,6 +1095,10 @@ void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *reques
 #endif
 
 bool WebServer::canHandle(AsyncWebServerRequest *request) {
+#ifdef USE_ARDUINO
+  // needed to answer requests for the static assets with 304 Not Modified
+  request->addInterestingHeader("If-None-Match");
+#endif
   if (request->url() == "/")
     return true;
 
@@ -1063,6 +1112,11 @@ bool WebServer::canHandle(AsyncWebServerRequest *request) {
     return true;
 #endif
 
+#ifdef USE_TRACE
+  if (request->method() == HTTP_GET && request->url() == "/trace.json")
+    return true;
+#endif
+
   UrlMatch match = match_url(request->url().c_str(), true);
   if (!match.valid)
     return false;
@@ -1153,6 +1207,13 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   }
 #endif
 
+#ifdef USE_TRACE
+  if (request->url() == "/trace.json") {
+    this->handle_trace_request(request);
+    return;
+  }
+#endif
+
   UrlMatch match = match_url(request->url().c_str());
 #ifdef USE_SENSOR
   if (match.domain == "sensor") {
@@ -16,16 +16,23 @@
 #if USE_WEBSERVER_VERSION == 2
 extern const uint8_t ESPHOME_WEBSERVER_INDEX_HTML[] PROGMEM;
 extern const size_t ESPHOME_WEBSERVER_INDEX_HTML_SIZE;
+extern const char ESPHOME_WEBSERVER_INDEX_HTML_ETAG[];
+#endif
+
+#ifdef USE_WEBSERVER_LOCAL
+extern const char ESPHOME_WEBSERVER_INDEX_GZ_ETAG[];
 #endif
 
 #ifdef USE_WEBSERVER_CSS_INCLUDE
 extern const uint8_t ESPHOME_WEBSERVER_CSS_INCLUDE[] PROGMEM;
 extern const size_t ESPHOME_WEBSERVER_CSS_INCLUDE_SIZE;
+extern const char ESPHOME_WEBSERVER_CSS_INCLUDE_ETAG[];
 #endif
 
 #ifdef USE_WEBSERVER_JS_INCLUDE
 extern const uint8_t ESPHOME_WEBSERVER_JS_INCLUDE[] PROGMEM;
 extern const size_t ESPHOME_WEBSERVER_JS_INCLUDE_SIZE;
+extern const char ESPHOME_WEBSERVER_JS_INCLUDE_ETAG[];
 #endif
 
 namespace esphome {
@@ -35,6 +42,7 @@ namespace web_server {
 struct UrlMatch {
   std::string domain;  ///< The domain of the component, for example "sensor"
   std::string id;      ///< The id of the device that's being accessed, for example "living_room_fan"
+  uint32_t key;        ///< The object ID hash of id, to look the entity up by key
   std::string method;  ///< The method that's being called, for example "turn_on"
   bool valid;          ///< Whether this match is valid
 };
@@ -103,6 +111,14 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    */
   void set_expose_log(bool expose_log) { this->expose_log_ = expose_log; }
 
+  /// State events sent since boot.
+  uint32_t get_states_sent() const { return this->states_sent_; }
+  /// States that had to wait for backlogged clients, and those that then replaced a waiting state of the same entity.
+  uint32_t get_states_deferred() const { return this->states_deferred_; }
+  uint32_t get_states_coalesced() const { return this->states_coalesced_; }
+  /// States waiting for backlogged clients right now.
+  size_t get_pending_states() const { return this->pending_states_.size(); }
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Setup the internal web server and register handlers.
@@ -130,6 +146,11 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   void handle_js_request(AsyncWebServerRequest *request);
 #endif
 
+#ifdef USE_TRACE
+  /// Handle a trace dump request under '/trace.json'.
+  void handle_trace_request(AsyncWebServerRequest *request);
+#endif
+
 #ifdef USE_SENSOR
   void on_sensor_update(sensor::Sensor *obj, float state) override;
   /// Handle a sensor request under '/sensor/<id>'.
@@ -264,9 +285,20 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
  protected:
   void schedule_(std::function<void()> &&f);
+  /// Send a static asset, or just 304 Not Modified if the client already has this version of it.
+  void send_asset_(AsyncWebServerRequest *request, const char *content_type, const uint8_t *data, size_t size,
+                   const char *etag, bool gzip);
+  /// Whether the event clients are behind, so that state events should wait.
+  bool events_backlogged_();
+  /// Send the state event built by \p json for \p obj now, or as soon as the clients have caught up.
+  void send_state_(EntityBase *obj, std::function<std::string()> &&json);
+  uint32_t states_sent_{0};
+  uint32_t states_deferred_{0};
+  uint32_t states_coalesced_{0};
   friend ListEntitiesIterator;
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
+  std::vector<std::pair<EntityBase *, std::function<std::string()>>> pending_states_;
   ListEntitiesIterator entities_iterator_;
 #if USE_WEBSERVER_VERSION == 1
   const char *css_url_{nullptr};
@@ -1,7 +1,11 @@
 #ifdef USE_ESP_IDF
 
+#include <cerrno>
 #include <cstdarg>
 
+#include <freertos/task.h>
+#include <sys/socket.h>
+
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
@@ -16,11 +20,22 @@ namespace web_server_idf {
 #define HTTPD_409 "409 Conflict"
 #endif
 
+#ifndef HTTPD_304
+#define HTTPD_304 "304 Not Modified"
+#endif
+
 #define CRLF_STR "\r\n"
 #define CRLF_LEN (sizeof(CRLF_STR) - 1)
 
 static const char *const TAG = "web_server_idf";
 
+#ifdef USE_WEBSERVER_IDF_ASYNC
+static const uint8_t ASYNC_WORKERS = 2;
+static const uint8_t ASYNC_QUEUE_SIZE = 4;
+#endif
+/// Events queued for a client before it is disconnected.
+static const size_t MAX_QUEUED_EVENTS = 32;
+
 void AsyncWebServer::end() {
   if (this->server_) {
     httpd_stop(this->server_);
@@ -35,6 +50,20 @@ void AsyncWebServer::begin() {
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.server_port = this->port_;
   config.uri_match_fn = [](const char * /*unused*/, const char * /*unused*/, size_t /*unused*/) { return true; };
+  // event source clients keep their socket, make room for new clients by closing the least recently used one
+  config.lru_purge_enable = true;
+#ifdef USE_WEBSERVER_IDF_ASYNC
+  if (this->async_queue_ == nullptr) {
+    this->async_queue_ = xQueueCreate(ASYNC_QUEUE_SIZE, sizeof(AsyncRequest));
+    for (uint8_t i = 0; i < ASYNC_WORKERS && this->async_queue_ != nullptr; i++) {
+      if (xTaskCreate(AsyncWebServer::worker_task_, "httpd_worker", config.stack_size, this, config.task_priority,
+                      nullptr) != pdPASS) {
+        ESP_LOGW(TAG, "Could not start the request workers");
+        break;
+      }
+    }
+  }
+#endif
   if (httpd_start(&this->server_, &config) == ESP_OK) {
     const httpd_uri_t handler_get = {
         .uri = "",
@@ -56,23 +85,59 @@ void AsyncWebServer::begin() {
 
 esp_err_t AsyncWebServer::request_handler(httpd_req_t *r) {
   ESP_LOGV(TAG, "Enter AsyncWebServer::request_handler. method=%u, uri=%s", r->method, r->uri);
-  AsyncWebServerRequest req(r);
   auto *server = static_cast<AsyncWebServer *>(r->user_ctx);
-  for (auto *handler : server->handlers_) {
-    if (handler->canHandle(&req)) {
-      // At now process only basic requests.
-      // OTA requires multipart request support and handleUpload for it
-      handler->handleRequest(&req);
+  AsyncWebHandler *handler = nullptr;
+  {
+    AsyncWebServerRequest req(r);
+    for (auto *candidate : server->handlers_) {
+      if (candidate->canHandle(&req)) {
+        handler = candidate;
+        break;
+      }
+    }
+  }
+#ifdef USE_WEBSERVER_IDF_ASYNC
+  // only the httpd task queues, so a free slot stays free
+  if (handler != nullptr && !handler->isRequestHandlerTrivial() && server->async_queue_ != nullptr &&
+      uxQueueSpacesAvailable(server->async_queue_) > 0) {
+    AsyncRequest request{nullptr, handler};
+    if (httpd_req_async_handler_begin(r, &request.req) == ESP_OK) {
+      xQueueSend(server->async_queue_, &request, 0);
       return ESP_OK;
     }
   }
-  if (server->on_not_found_) {
-    server->on_not_found_(&req);
+#endif
+  return server->handle_request_(r, handler);
+}
+
+esp_err_t AsyncWebServer::handle_request_(httpd_req_t *r, AsyncWebHandler *handler) {
+  AsyncWebServerRequest req(r);
+  if (handler != nullptr) {
+    // At now process only basic requests.
+    // OTA requires multipart request support and handleUpload for it
+    handler->handleRequest(&req);
+    return ESP_OK;
+  }
+  if (this->on_not_found_) {
+    this->on_not_found_(&req);
     return ESP_OK;
   }
   return ESP_ERR_NOT_FOUND;
 }
 
+#ifdef USE_WEBSERVER_IDF_ASYNC
+void AsyncWebServer::worker_task_(void *arg) {
+  auto *server = static_cast<AsyncWebServer *>(arg);
+  while (true) {
+    AsyncRequest request;
+    if (xQueueReceive(server->async_queue_, &request, portMAX_DELAY) != pdTRUE)
+      continue;
+    server->handle_request_(request.req, request.handler);
+    httpd_req_async_handler_complete(request.req);
+  }
+}
+#endif
+
 AsyncWebServerRequest::~AsyncWebServerRequest() {
   delete this->rsp_;
   for (const auto &pair : this->params_) {
@@ -127,6 +192,7 @@ void AsyncWebServerRequest::redirect(const std::string &url) {
 
 void AsyncWebServerRequest::init_response_(AsyncWebServerResponse *rsp, int code, const char *content_type) {
   httpd_resp_set_status(*this, code == 200   ? HTTPD_200
+                               : code == 304 ? HTTPD_304
                                : code == 404 ? HTTPD_404
                                : code == 409 ? HTTPD_409
                                              : to_string(code).c_str());
@@ -277,6 +343,7 @@ void AsyncResponseStream::printf(const char *fmt, ...) {
 }
 
 AsyncEventSource::~AsyncEventSource() {
+  LockGuard guard(this->lock_);
   for (auto *ses : this->sessions_) {
     delete ses;  // NOLINT(cppcoreguidelines-owning-memory)
   }
@@ -284,16 +351,77 @@ AsyncEventSource::~AsyncEventSource() {
 
 void AsyncEventSource::handleRequest(AsyncWebServerRequest *request) {
   auto *rsp = new AsyncEventSourceResponse(request, this);  // NOLINT(cppcoreguidelines-owning-memory)
+  this->hd_ = rsp->hd_;
   if (this->on_connect_) {
     this->on_connect_(rsp);
   }
+  LockGuard guard(this->lock_);
   this->sessions_.insert(rsp);
 }
 
 void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
-  for (auto *ses : this->sessions_) {
-    ses->send(message, event, id, reconnect);
+  if (this->sessions_.empty())
+    return;
+  // formatted once for all clients
+  const std::string ev = AsyncEventSourceResponse::build_event_(message, event, id, reconnect);
+  if (ev.empty())
+    return;
+  {
+    LockGuard guard(this->lock_);
+    for (auto *ses : this->sessions_) {
+      ses->send_event_(ev);
+    }
   }
+  this->schedule_flush_();
+}
+
+size_t AsyncEventSource::avgPacketsWaiting() {
+  LockGuard guard(this->lock_);
+  if (this->sessions_.empty())
+    return 0;
+  size_t queued = 0;
+  for (auto *ses : this->sessions_)
+    queued += ses->queue_.size();
+  return queued / this->sessions_.size();
+}
+
+void AsyncEventSource::loop() {
+  if (this->sessions_.empty() || this->flush_pending_)
+    return;
+  bool queued = false;
+  {
+    LockGuard guard(this->lock_);
+    for (auto *ses : this->sessions_)
+      queued |= !ses->queue_.empty() || (ses->closing_ && ses->fd_ != 0);
+  }
+  if (queued)
+    this->schedule_flush_();
+}
+
+void AsyncEventSource::schedule_flush_() {
+  if (this->hd_ == nullptr || this->flush_pending_.exchange(true))
+    return;
+  if (httpd_queue_work(this->hd_, AsyncEventSource::flush_, this) != ESP_OK)
+    this->flush_pending_ = false;
+}
+
+void AsyncEventSource::flush_(void *arg) {
+  auto *source = static_cast<AsyncEventSource *>(arg);
+  source->flush_pending_ = false;
+  std::vector<int> to_close;
+  {
+    LockGuard guard(source->lock_);
+    for (auto *ses : source->sessions_) {
+      ses->write_();
+      if (ses->closing_ && ses->fd_ != 0) {
+        to_close.push_back(ses->fd_);
+        ses->fd_ = 0;
+      }
+    }
+  }
+  // outside of the lock, closing may log and logs are sent as events
+  for (int fd : to_close)
+    httpd_sess_trigger_close(source->hd_, fd);
 }
 
 AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server)
@@ -316,15 +444,26 @@ AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *
 
 void AsyncEventSourceResponse::destroy(void *ptr) {
   auto *rsp = static_cast<AsyncEventSourceResponse *>(ptr);
-  rsp->server_->sessions_.erase(rsp);
+  {
+    LockGuard guard(rsp->server_->lock_);
+    rsp->server_->sessions_.erase(rsp);
+  }
   delete rsp;  // NOLINT(cppcoreguidelines-owning-memory)
 }
 
 void AsyncEventSourceResponse::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
-  if (this->fd_ == 0) {
+  const std::string ev = AsyncEventSourceResponse::build_event_(message, event, id, reconnect);
+  if (ev.empty())
     return;
+  {
+    LockGuard guard(this->server_->lock_);
+    this->send_event_(ev);
   }
+  this->server_->schedule_flush_();
+}
 
+std::string AsyncEventSourceResponse::build_event_(const char *message, const char *event, uint32_t id,
+                                                  uint32_t reconnect) {
   std::string ev;
 
   if (reconnect) {
@@ -352,20 +491,55 @@ void AsyncEventSourceResponse::send(const char *message, const char *event, uint
   }
 
   if (ev.empty()) {
-    return;
+    return ev;
   }
 
   ev.append(CRLF_STR, CRLF_LEN);
+  return ev;
+}
 
-  // Sending chunked content prelude
-  auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
-  httpd_socket_send(this->hd_, this->fd_, cs.c_str(), cs.size(), 0);
+void AsyncEventSourceResponse::send_event_(const std::string &ev) {
+  if (this->fd_ == 0 || this->closing_) {
+    return;
+  }
+  if (this->queue_.size() >= MAX_QUEUED_EVENTS) {
+    // Not logged, this may run from the log callback. The browser reconnects and gets all states again.
+    this->close_();
+    return;
+  }
 
-  // Sendiing content chunk
-  httpd_socket_send(this->hd_, this->fd_, ev.c_str(), ev.size(), 0);
+  // chunked content prelude, content and end of chunk
+  std::string chunk = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
+  chunk.reserve(chunk.size() + ev.size() + CRLF_LEN);
+  chunk.append(ev);
+  chunk.append(CRLF_STR, CRLF_LEN);
+  this->queue_.push_back(std::move(chunk));
+}
+
+void AsyncEventSourceResponse::close_() {
+  this->closing_ = true;
+  this->queue_.clear();
+  this->sent_ = 0;
+}
 
-  // Indicate end of chunk
-  httpd_socket_send(this->hd_, this->fd_, CRLF_STR, CRLF_LEN, 0);
+void AsyncEventSourceResponse::write_() {
+  while (this->fd_ != 0 && !this->closing_ && !this->queue_.empty()) {
+    const std::string &chunk = this->queue_.front();
+    // Straight to the socket rather than httpd_socket_send(), which logs a warning whenever the socket is full
+    int sent = ::send(this->fd_, chunk.data() + this->sent_, chunk.size() - this->sent_, MSG_DONTWAIT);
+    if (sent < 0) {
+      // socket buffer full, the rest goes out on a later flush
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        return;
+      this->close_();
+      return;
+    }
+    this->sent_ += sent;
+    if (this->sent_ == chunk.size()) {
+      this->queue_.pop_front();
+      this->sent_ = 0;
+    }
+  }
 }
 
 }  // namespace web_server_idf
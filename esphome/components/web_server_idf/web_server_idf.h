@@ -2,16 +2,28 @@
 #ifdef USE_ESP_IDF
 
 #include <esp_http_server.h>
+#include <esp_idf_version.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 
+#include <atomic>
+#include <deque>
 #include <string>
 #include <functional>
 #include <vector>
 #include <map>
 #include <set>
 
+#include "esphome/core/helpers.h"
+
 namespace esphome {
 namespace web_server_idf {
 
+// Handing a request over to another task needs httpd_req_async_handler_begin()
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2)
+#define USE_WEBSERVER_IDF_ASYNC
+#endif
+
 #define F(string_literal) (string_literal)
 #define PGM_P const char *
 #define strncpy_P strncpy
@@ -117,7 +129,7 @@ class AsyncWebServerRequest {
   // NOLINTNEXTLINE(readability-identifier-naming)
   AsyncWebServerResponse *beginResponse(int code, const char *content_type) {
     auto *res = new AsyncWebServerResponseEmpty(this);  // NOLINT(cppcoreguidelines-owning-memory)
-    this->init_response_(res, 200, content_type);
+    this->init_response_(res, code, content_type);
     return res;
   }
   // NOLINTNEXTLINE(readability-identifier-naming)
@@ -168,6 +180,14 @@ class AsyncWebServerRequest {
 
 class AsyncWebHandler;
 
+/** Wraps esp_http_server, which serves all sockets from a single task.
+ *
+ * So a request that takes a while doesn't hold up the other clients, requests for handlers that aren't trivial (see
+ * AsyncWebHandler::isRequestHandlerTrivial()) are handed over to a small pool of worker tasks with
+ * httpd_req_async_handler_begin(), where the IDF supports it. The httpd task goes on serving the other sockets
+ * meanwhile. Trivial handlers, the event source among them, and all requests when the workers are busy are still
+ * handled in the httpd task.
+ */
 class AsyncWebServer {
  public:
   AsyncWebServer(uint16_t port) : port_(port){};
@@ -189,8 +209,19 @@ class AsyncWebServer {
   uint16_t port_{};
   httpd_handle_t server_{};
   static esp_err_t request_handler(httpd_req_t *r);
+  /// Run the handler for a request, in the httpd task or a worker.
+  esp_err_t handle_request_(httpd_req_t *r, AsyncWebHandler *handler);
   std::vector<AsyncWebHandler *> handlers_;
   std::function<void(AsyncWebServerRequest *request)> on_not_found_{};
+#ifdef USE_WEBSERVER_IDF_ASYNC
+  struct AsyncRequest {
+    httpd_req_t *req;
+    AsyncWebHandler *handler;
+  };
+  static void worker_task_(void *arg);
+  /// Requests handed over to the workers, created along with them on the first begin().
+  QueueHandle_t async_queue_{};
+#endif
 };
 
 class AsyncWebHandler {
@@ -211,6 +242,12 @@ class AsyncWebHandler {
 
 class AsyncEventSource;
 
+/** A client of an AsyncEventSource.
+ *
+ * Events are queued per client as chunks of the response and written to the socket by the httpd task without
+ * blocking, so a slow client only falls behind itself. A client that has too many events waiting is disconnected, the
+ * browser reconnects and gets all states again.
+ */
 class AsyncEventSourceResponse {
   friend class AsyncEventSource;
 
@@ -220,9 +257,21 @@ class AsyncEventSourceResponse {
  protected:
   AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server);
   static void destroy(void *p);
+  /// Format an event in the text/event-stream format, empty if there's nothing to send.
+  static std::string build_event_(const char *message, const char *event, uint32_t id, uint32_t reconnect);
+  /// Queue an event built with build_event_() as a chunk of the response, with the lock of the server held.
+  void send_event_(const std::string &ev);
+  /// Write as much of the queued chunks as the socket takes, runs in the httpd task with the lock of the server held.
+  void write_();
+  /// Drop the queue and have the next flush disconnect the client.
+  void close_();
   AsyncEventSource *server_;
   httpd_handle_t hd_{};
   int fd_{};
+  std::deque<std::string> queue_;
+  /// Bytes of the first queued chunk already written.
+  size_t sent_{0};
+  bool closing_{false};
 };
 
 using AsyncEventSourceClient = AsyncEventSourceResponse;
@@ -246,10 +295,28 @@ class AsyncEventSource : public AsyncWebHandler {
 
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
 
+  size_t count() const { return this->sessions_.size(); }
+
+  /// Average number of events queued per client.
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  size_t avgPacketsWaiting();
+
+  /// Retry writing to clients whose socket was full, called from the main loop.
+  void loop();
+
  protected:
+  /// Have the httpd task write the queued events, unless that's already pending.
+  void schedule_flush_();
+  static void flush_(void *arg);
+
   std::string url_;
+  /// Guards the clients and their queues, clients come and go in the httpd task while events are sent from the main
+  /// loop.
+  Mutex lock_;
   std::set<AsyncEventSourceResponse *> sessions_;
   connect_handler_t on_connect_{};
+  httpd_handle_t hd_{};
+  std::atomic<bool> flush_pending_{false};
 };
 
 class DefaultHeaders {
@@ -51,6 +51,7 @@ WIFI_POWER_SAVE_MODES = {
     "NONE": WiFiPowerSaveMode.WIFI_POWER_SAVE_NONE,
     "LIGHT": WiFiPowerSaveMode.WIFI_POWER_SAVE_LIGHT,
     "HIGH": WiFiPowerSaveMode.WIFI_POWER_SAVE_HIGH,
+    "ADAPTIVE": WiFiPowerSaveMode.WIFI_POWER_SAVE_ADAPTIVE,
 }
 WiFiConnectedCondition = wifi_ns.class_("WiFiConnectedCondition", Condition)
 WiFiEnabledCondition = wifi_ns.class_("WiFiEnabledCondition", Condition)
@@ -162,7 +163,7 @@ def final_validate(config):
 def final_validate_power_esp32_ble(value):
     if not CORE.is_esp32:
         return
-    if value != "NONE":
+    if value not in ("NONE", "ADAPTIVE"):
         # WiFi should be in modem sleep (!=NONE) with BLE coexistence
         # https://docs.espressif.com/projects/esp-idf/en/v3.3.5/api-guides/wifi.html#station-sleep
         return
@@ -185,7 +186,7 @@ def final_validate_power_esp32_ble(value):
             pass
         else:
             raise cv.Invalid(
-                f"power_save_mode NONE is incompatible with {conflicting}. "
+                f"power_save_mode {value} is incompatible with {conflicting}. "
                 f"Please remove the power save mode. See also "
                 f"https://github.com/esphome/issues/issues/2141#issuecomment-865688582"
             )
@@ -256,7 +257,9 @@ def _validate(config):
 
 CONF_OUTPUT_POWER = "output_power"
 CONF_PASSIVE_SCAN = "passive_scan"
+CONF_FAST_RECONNECT = "fast_reconnect"
 CONF_ENABLE_ON_BOOT = "enable_on_boot"
+CONF_POWER_SAVE_IDLE_TIMEOUT = "power_save_idle_timeout"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -279,7 +282,11 @@ CONFIG_SCHEMA = cv.All(
                 bk72xx="none",
                 rtl87xx="none",
             ): cv.enum(WIFI_POWER_SAVE_MODES, upper=True),
+            cv.Optional(
+                CONF_POWER_SAVE_IDLE_TIMEOUT, default="10s"
+            ): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_FAST_CONNECT, default=False): cv.boolean,
+            cv.Optional(CONF_FAST_RECONNECT, default=False): cv.boolean,
             cv.Optional(CONF_USE_ADDRESS): cv.string_strict,
             cv.SplitDefault(CONF_OUTPUT_POWER, esp8266=20.0): cv.All(
                 cv.decibel, cv.float_range(min=8.5, max=20.5)
@@ -390,7 +397,9 @@ async def to_code(config):
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
     cg.add(var.set_power_save_mode(config[CONF_POWER_SAVE_MODE]))
+    cg.add(var.set_power_save_idle_timeout(config[CONF_POWER_SAVE_IDLE_TIMEOUT]))
     cg.add(var.set_fast_connect(config[CONF_FAST_CONNECT]))
+    cg.add(var.set_fast_reconnect(config[CONF_FAST_RECONNECT]))
     cg.add(var.set_passive_scan(config[CONF_PASSIVE_SCAN]))
     if CONF_OUTPUT_POWER in config:
         cg.add(var.set_output_power(config[CONF_OUTPUT_POWER]))
@@ -412,6 +421,9 @@ async def to_code(config):
             cg.add(var.set_btm(config[CONF_ENABLE_BTM]))
         if config[CONF_ENABLE_RRM]:
             cg.add(var.set_rrm(config[CONF_ENABLE_RRM]))
+        if config[CONF_FAST_RECONNECT]:
+            # Ask DHCP for the previous lease first, which skips the discover round trip
+            add_idf_sdkconfig_option("CONFIG_LWIP_DHCP_RESTORE_LAST_IP", True)
 
     cg.add_define("USE_WIFI")
 
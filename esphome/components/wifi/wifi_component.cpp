@@ -76,10 +76,14 @@ void WiFiComponent::start() {
       ESP_LOGV(TAG, "Setting Power Save Option failed!");
     }
 
+    if (this->fast_reconnect_) {
+      this->fast_reconnect_pref_ = global_preferences->make_preference<SavedFastReconnect>(hash ^ 0x4B3A7F21UL, false);
+    }
+
     if (this->fast_connect_) {
       this->selected_ap_ = this->sta_[0];
       this->start_connecting(this->selected_ap_, false);
-    } else {
+    } else if (!this->fast_reconnect_ || !this->start_fast_reconnect_()) {
       this->start_scanning();
     }
   } else if (this->has_ap()) {
@@ -141,6 +145,7 @@ void WiFiComponent::loop() {
         } else {
           this->status_clear_warning();
           this->last_connected_ = now;
+          this->update_adaptive_power_save_();
         }
         break;
       }
@@ -423,6 +428,49 @@ void WiFiComponent::disable() {
 
 bool WiFiComponent::is_disabled() { return this->state_ == WIFI_COMPONENT_STATE_DISABLED; }
 
+bool WiFiComponent::start_fast_reconnect_() {
+  if (!this->fast_reconnect_pref_.load(&this->fast_reconnect_saved_) ||
+      this->fast_reconnect_saved_.sta_index >= this->sta_.size())
+    return false;
+
+  const WiFiAP &config = this->sta_[this->fast_reconnect_saved_.sta_index];
+  WiFiAP connect_params = config;
+  if (!config.get_hidden()) {
+    bssid_t bssid;
+    std::copy(std::begin(this->fast_reconnect_saved_.bssid), std::end(this->fast_reconnect_saved_.bssid),
+              bssid.begin());
+    connect_params.set_bssid(bssid);
+    connect_params.set_channel(this->fast_reconnect_saved_.channel);
+  }
+  ESP_LOGD(TAG, "Connecting to the access point of the last connection without scanning");
+  this->fast_reconnect_attempt_ = true;
+  this->selected_ap_ = connect_params;
+  this->start_connecting(connect_params, false);
+  return true;
+}
+
+void WiFiComponent::save_fast_reconnect_() {
+  SavedFastReconnect save{};
+  bssid_t bssid = wifi_bssid();
+  std::copy(bssid.begin(), bssid.end(), std::begin(save.bssid));
+  save.channel = this->wifi_channel_();
+  save.sta_index = this->sta_.size();
+  const std::string ssid = wifi_ssid();
+  for (size_t i = 0; i < this->sta_.size(); i++) {
+    if (this->sta_[i].get_ssid() == ssid) {
+      save.sta_index = i;
+      break;
+    }
+  }
+  if (save.sta_index >= this->sta_.size())
+    return;
+  // only write when the access point changed, which is rare
+  if (memcmp(&save, &this->fast_reconnect_saved_, sizeof(save)) == 0)
+    return;
+  this->fast_reconnect_saved_ = save;
+  this->fast_reconnect_pref_.save(&save);
+}
+
 void WiFiComponent::start_scanning() {
   this->action_started_ = millis();
   ESP_LOGD(TAG, "Starting scan...");
@@ -577,6 +625,9 @@ void WiFiComponent::check_connecting_finished() {
 
     this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTED;
     this->num_retried_ = 0;
+    this->fast_reconnect_attempt_ = false;
+    if (this->fast_reconnect_)
+      this->save_fast_reconnect_();
     return;
   }
 
@@ -614,6 +665,15 @@ void WiFiComponent::check_connecting_finished() {
 }
 
 void WiFiComponent::retry_connect() {
+  if (this->fast_reconnect_attempt_) {
+    // the access point of the last connection is gone or moved, find one with a scan right away
+    ESP_LOGD(TAG, "Saved access point not reachable, scanning");
+    this->fast_reconnect_attempt_ = false;
+    this->error_from_callback_ = false;
+    this->start_scanning();
+    return;
+  }
+
   if (this->selected_ap_.get_bssid()) {
     auto bssid = *this->selected_ap_.get_bssid();
     float priority = this->get_sta_priority(bssid);
@@ -656,6 +716,27 @@ bool WiFiComponent::is_connected() {
 }
 void WiFiComponent::set_power_save_mode(WiFiPowerSaveMode power_save) { this->power_save_ = power_save; }
 
+WiFiPowerSaveMode WiFiComponent::effective_power_save_() const {
+  if (this->power_save_ != WIFI_POWER_SAVE_ADAPTIVE)
+    return this->power_save_;
+  // modem sleep wakes up for every DTIM beacon, so idle the node still sees broadcasts and buffered traffic
+  return this->power_save_awake_ ? WIFI_POWER_SAVE_NONE : WIFI_POWER_SAVE_LIGHT;
+}
+
+void WiFiComponent::update_adaptive_power_save_() {
+  if (this->power_save_ != WIFI_POWER_SAVE_ADAPTIVE)
+    return;
+  const bool awake = this->high_performance_holders_ > 0 ||
+                     (this->last_activity_ != 0 && millis() - this->last_activity_ < this->power_save_idle_timeout_);
+  if (awake == this->power_save_awake_)
+    return;
+  this->power_save_awake_ = awake;
+  ESP_LOGV(TAG, "Adaptive power save: %s", awake ? "awake" : "idle");
+  if (!this->wifi_apply_power_save_()) {
+    ESP_LOGV(TAG, "Setting Power Save Option failed!");
+  }
+}
+
 void WiFiComponent::set_passive_scan(bool passive) { this->passive_scan_ = passive; }
 
 std::string WiFiComponent::format_mac_addr(const uint8_t *mac) {
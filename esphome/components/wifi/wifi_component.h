@@ -3,9 +3,11 @@
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/network/ip_address.h"
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -48,6 +50,14 @@ struct SavedWifiSettings {
   char password[65];
 } PACKED;  // NOLINT
 
+/// The access point of the last successful connection, tried first on the next start.
+struct SavedFastReconnect {
+  uint8_t bssid[6];
+  uint8_t channel;
+  /// Index into the configured networks, whose credentials and manual IP are used.
+  uint8_t sta_index;
+} PACKED;  // NOLINT
+
 enum WiFiComponentState {
   /** Nothing has been initialized yet. Internal AP, if configured, is disabled at this point. */
   WIFI_COMPONENT_STATE_OFF = 0,
@@ -178,6 +188,8 @@ enum WiFiPowerSaveMode {
   WIFI_POWER_SAVE_NONE = 0,
   WIFI_POWER_SAVE_LIGHT,
   WIFI_POWER_SAVE_HIGH,
+  /// LIGHT while idle, NONE while something needs low latency, see WiFiComponent::acquire_high_performance().
+  WIFI_POWER_SAVE_ADAPTIVE,
 };
 
 #ifdef USE_ESP_IDF
@@ -211,6 +223,7 @@ class WiFiComponent : public Component {
   void check_scanning_finished();
   void start_connecting(const WiFiAP &ap, bool two);
   void set_fast_connect(bool fast_connect);
+  void set_fast_reconnect(bool fast_reconnect) { this->fast_reconnect_ = fast_reconnect; }
   void set_ap_timeout(uint32_t ap_timeout) { ap_timeout_ = ap_timeout; }
 
   void check_connecting_finished();
@@ -224,6 +237,19 @@ class WiFiComponent : public Component {
   bool is_connected();
 
   void set_power_save_mode(WiFiPowerSaveMode power_save);
+  /// How long the radio stays awake after the last mark_activity() with power save mode ADAPTIVE.
+  void set_power_save_idle_timeout(uint32_t idle_timeout) { this->power_save_idle_timeout_ = idle_timeout; }
+  /** Keep the radio awake until release_high_performance(), for a stream like an OTA upload or a camera.
+   *
+   * Only has an effect with power save mode ADAPTIVE. Calls nest, and both may be made from any task.
+   */
+  void acquire_high_performance() { this->high_performance_holders_++; }
+  void release_high_performance() { this->high_performance_holders_--; }
+  /** Keep the radio awake for the idle timeout, for requests like API commands that are likely followed by more.
+   *
+   * The request that calls this has already paid the latency of the power save mode, the ones following it won't.
+   */
+  void mark_activity() { this->last_activity_ = millis(); }
   void set_output_power(float output_power) { output_power_ = output_power; }
 
   void set_passive_scan(bool passive);
@@ -298,12 +324,19 @@ class WiFiComponent : public Component {
   static std::string format_mac_addr(const uint8_t mac[6]);
   void setup_ap_config_();
   void print_connect_params_();
+  /// Start connecting to the access point saved by the last connection, returns false if there is none.
+  bool start_fast_reconnect_();
+  void save_fast_reconnect_();
 
   void wifi_loop_();
   bool wifi_mode_(optional<bool> sta, optional<bool> ap);
   bool wifi_sta_pre_setup_();
   bool wifi_apply_output_power_(float output_power);
   bool wifi_apply_power_save_();
+  /// The power save mode to apply now, ADAPTIVE resolved to NONE or LIGHT.
+  WiFiPowerSaveMode effective_power_save_() const;
+  /// Switch between the two modes of ADAPTIVE, called from loop().
+  void update_adaptive_power_save_();
   bool wifi_sta_ip_config_(optional<ManualIP> manual_ip);
   bool wifi_apply_hostname_();
   bool wifi_sta_connect_(const WiFiAP &ap);
@@ -350,6 +383,11 @@ class WiFiComponent : public Component {
   std::vector<WiFiSTAPriority> sta_priorities_;
   WiFiAP selected_ap_;
   bool fast_connect_{false};
+  bool fast_reconnect_{false};
+  /// Connecting to the saved access point without a scan, a failure falls back to scanning.
+  bool fast_reconnect_attempt_{false};
+  ESPPreferenceObject fast_reconnect_pref_;
+  SavedFastReconnect fast_reconnect_saved_{};
 
   bool has_ap_{false};
   WiFiAP ap_;
@@ -360,6 +398,11 @@ class WiFiComponent : public Component {
   uint32_t reboot_timeout_{};
   uint32_t ap_timeout_{};
   WiFiPowerSaveMode power_save_{WIFI_POWER_SAVE_NONE};
+  uint32_t power_save_idle_timeout_{10000};
+  std::atomic<uint32_t> high_performance_holders_{0};
+  std::atomic<uint32_t> last_activity_{0};
+  /// Whether ADAPTIVE currently applies NONE.
+  bool power_save_awake_{false};
   bool error_from_callback_{false};
   std::vector<WiFiScanResult> scan_result_;
   bool scan_done_{false};
@@ -86,7 +86,7 @@ bool WiFiComponent::wifi_mode_(optional<bool> sta, optional<bool> ap) {
 }
 bool WiFiComponent::wifi_apply_power_save_() {
   sleep_type_t power_save;
-  switch (this->power_save_) {
+  switch (this->effective_power_save_()) {
     case WIFI_POWER_SAVE_LIGHT:
       power_save = LIGHT_SLEEP_T;
       break;
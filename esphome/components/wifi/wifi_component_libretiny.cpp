@@ -66,7 +66,9 @@ bool WiFiComponent::wifi_sta_pre_setup_() {
   delay(10);
   return true;
 }
-bool WiFiComponent::wifi_apply_power_save_() { return WiFi.setSleep(this->power_save_ != WIFI_POWER_SAVE_NONE); }
+bool WiFiComponent::wifi_apply_power_save_() {
+  return WiFi.setSleep(this->effective_power_save_() != WIFI_POWER_SAVE_NONE);
+}
 bool WiFiComponent::wifi_sta_ip_config_(optional<ManualIP> manual_ip) {
   // enable STA
   if (!this->wifi_mode_(true, {}))
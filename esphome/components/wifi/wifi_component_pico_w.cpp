@@ -34,8 +34,9 @@ bool WiFiComponent::wifi_mode_(optional<bool> sta, optional<bool> ap) {
 
 bool WiFiComponent::wifi_apply_power_save_() {
   uint32_t pm;
-  switch (this->power_save_) {
+  switch (this->effective_power_save_()) {
     case WIFI_POWER_SAVE_NONE:
+    default:
       pm = CYW43_PERFORMANCE_PM;
       break;
     case WIFI_POWER_SAVE_LIGHT:
@@ -4,6 +4,7 @@
 
 #ifdef USE_ESP32
 
+#include <memory>
 #include <vector>
 #include "mbedtls/ccm.h"
 
@@ -231,6 +232,32 @@ optional<XiaomiParseResult> parse_xiaomi_header(const esp32_ble_tracker::Service
   return result;
 }
 
+/// CCM context with the key schedule of one bindkey done, kept for as long as the firmware runs.
+struct XiaomiCCMContext {
+  uint8_t key[16];
+  mbedtls_ccm_context ctx;
+};
+
+static mbedtls_ccm_context *get_ccm_context(const uint8_t *bindkey) {
+  // One per configured sensor, so a linear search is fine
+  static std::vector<std::unique_ptr<XiaomiCCMContext>> contexts;  // NOLINT
+  for (auto &cached : contexts) {
+    if (memcmp(cached->key, bindkey, sizeof(cached->key)) == 0)
+      return &cached->ctx;
+  }
+
+  auto cached = make_unique<XiaomiCCMContext>();
+  memcpy(cached->key, bindkey, sizeof(cached->key));
+  mbedtls_ccm_init(&cached->ctx);
+  if (mbedtls_ccm_setkey(&cached->ctx, MBEDTLS_CIPHER_ID_AES, cached->key, sizeof(cached->key) * 8) != 0) {
+    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): mbedtls_ccm_setkey() failed.");
+    mbedtls_ccm_free(&cached->ctx);
+    return nullptr;
+  }
+  contexts.push_back(std::move(cached));
+  return &contexts.back()->ctx;
+}
+
 bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, const uint64_t &address) {
   if (!((raw.size() == 19) || ((raw.size() >= 22) && (raw.size() <= 24)))) {
     ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): data packet has wrong size (%d)!", raw.size());
@@ -238,84 +265,50 @@ bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, c
     return false;
   }
 
-  uint8_t mac_reverse[6] = {0};
-  mac_reverse[5] = (uint8_t) (address >> 40);
-  mac_reverse[4] = (uint8_t) (address >> 32);
-  mac_reverse[3] = (uint8_t) (address >> 24);
-  mac_reverse[2] = (uint8_t) (address >> 16);
-  mac_reverse[1] = (uint8_t) (address >> 8);
-  mac_reverse[0] = (uint8_t) (address >> 0);
-
-  XiaomiAESVector vector{.key = {0},
-                         .plaintext = {0},
-                         .ciphertext = {0},
-                         .authdata = {0x11},
-                         .iv = {0},
-                         .tag = {0},
-                         .keysize = 16,
-                         .authsize = 1,
-                         .datasize = 0,
-                         .tagsize = 4,
-                         .ivsize = 12};
-
-  vector.datasize = (raw.size() == 19) ? raw.size() - 12 : raw.size() - 18;
-  int cipher_pos = (raw.size() == 19) ? 5 : 11;
+  mbedtls_ccm_context *ctx = get_ccm_context(bindkey);
+  if (ctx == nullptr)
+    return false;
 
+  static const uint8_t AUTHDATA[1] = {0x11};
+  static const size_t TAG_SIZE = 4;
+  const size_t datasize = (raw.size() == 19) ? raw.size() - 12 : raw.size() - 18;
+  const int cipher_pos = (raw.size() == 19) ? 5 : 11;
   const uint8_t *v = raw.data();
 
-  memcpy(vector.key, bindkey, vector.keysize);
-  memcpy(vector.ciphertext, v + cipher_pos, vector.datasize);
-  memcpy(vector.tag, v + raw.size() - vector.tagsize, vector.tagsize);
-  memcpy(vector.iv, mac_reverse, 6);             // MAC address reverse
-  memcpy(vector.iv + 6, v + 2, 3);               // sensor type (2) + packet id (1)
-  memcpy(vector.iv + 9, v + raw.size() - 7, 3);  // payload counter
-
-  mbedtls_ccm_context ctx;
-  mbedtls_ccm_init(&ctx);
-
-  int ret = mbedtls_ccm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, vector.key, vector.keysize * 8);
+  uint8_t iv[12];
+  for (int i = 0; i < 6; i++)
+    iv[i] = (uint8_t) (address >> (8 * i));  // MAC address reverse
+  memcpy(iv + 6, v + 2, 3);                   // sensor type (2) + packet id (1)
+  memcpy(iv + 9, v + raw.size() - 7, 3);      // payload counter
+
+  // Ciphertext and tag are read straight from the packet, only the plaintext needs a buffer, the packet is left alone
+  // if authentication fails
+  uint8_t plaintext[16];
+  int ret = mbedtls_ccm_auth_decrypt(ctx, datasize, iv, sizeof(iv), AUTHDATA, sizeof(AUTHDATA), v + cipher_pos,
+                                     plaintext, v + raw.size() - TAG_SIZE, TAG_SIZE);
   if (ret) {
-    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): mbedtls_ccm_setkey() failed.");
-    mbedtls_ccm_free(&ctx);
-    return false;
-  }
-
-  ret = mbedtls_ccm_auth_decrypt(&ctx, vector.datasize, vector.iv, vector.ivsize, vector.authdata, vector.authsize,
-                                 vector.ciphertext, vector.plaintext, vector.tag, vector.tagsize);
-  if (ret) {
-    uint8_t mac_address[6] = {0};
-    memcpy(mac_address, mac_reverse + 5, 1);
-    memcpy(mac_address + 1, mac_reverse + 4, 1);
-    memcpy(mac_address + 2, mac_reverse + 3, 1);
-    memcpy(mac_address + 3, mac_reverse + 2, 1);
-    memcpy(mac_address + 4, mac_reverse + 1, 1);
-    memcpy(mac_address + 5, mac_reverse, 1);
+    uint8_t mac_address[6];
+    for (int i = 0; i < 6; i++)
+      mac_address[i] = iv[5 - i];
     ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): authenticated decryption failed.");
     ESP_LOGVV(TAG, "  MAC address : %s", format_hex_pretty(mac_address, 6).c_str());
     ESP_LOGVV(TAG, "       Packet : %s", format_hex_pretty(raw.data(), raw.size()).c_str());
-    ESP_LOGVV(TAG, "          Key : %s", format_hex_pretty(vector.key, vector.keysize).c_str());
-    ESP_LOGVV(TAG, "           Iv : %s", format_hex_pretty(vector.iv, vector.ivsize).c_str());
-    ESP_LOGVV(TAG, "       Cipher : %s", format_hex_pretty(vector.ciphertext, vector.datasize).c_str());
-    ESP_LOGVV(TAG, "          Tag : %s", format_hex_pretty(vector.tag, vector.tagsize).c_str());
-    mbedtls_ccm_free(&ctx);
+    ESP_LOGVV(TAG, "          Key : %s", format_hex_pretty(bindkey, 16).c_str());
+    ESP_LOGVV(TAG, "           Iv : %s", format_hex_pretty(iv, sizeof(iv)).c_str());
+    ESP_LOGVV(TAG, "       Cipher : %s", format_hex_pretty(v + cipher_pos, datasize).c_str());
+    ESP_LOGVV(TAG, "          Tag : %s", format_hex_pretty(v + raw.size() - TAG_SIZE, TAG_SIZE).c_str());
     return false;
   }
 
   // replace encrypted payload with plaintext
-  uint8_t *p = vector.plaintext;
-  for (std::vector<uint8_t>::iterator it = raw.begin() + cipher_pos; it != raw.begin() + cipher_pos + vector.datasize;
-       ++it) {
-    *it = *(p++);
-  }
+  memcpy(raw.data() + cipher_pos, plaintext, datasize);
 
   // clear encrypted flag
   raw[0] &= ~0x08;
 
   ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): authenticated decryption passed.");
-  ESP_LOGVV(TAG, "  Plaintext : %s, Packet : %d", format_hex_pretty(raw.data() + cipher_pos, vector.datasize).c_str(),
+  ESP_LOGVV(TAG, "  Plaintext : %s, Packet : %d", format_hex_pretty(raw.data() + cipher_pos, datasize).c_str(),
             static_cast<int>(raw[4]));
-
-  mbedtls_ccm_free(&ctx);
   return true;
 }
 
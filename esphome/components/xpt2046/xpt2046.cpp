@@ -27,6 +27,7 @@ void XPT2046Component::setup() {
 }
 
 void XPT2046Component::loop() {
+  this->flush_touches_();
   if ((this->irq_pin_ != nullptr) && (this->store_.touch || this->touched)) {
     this->store_.touch = false;
     check_touch_();
@@ -110,7 +111,7 @@ void XPT2046Component::check_touch_() {
     if (!this->touched || (now - this->last_pos_ms_) >= this->report_millis_) {
       ESP_LOGV(TAG, "Touching at [%03X, %03X] => [%3d, %3d]", this->x_raw, this->y_raw, touchpoint.x, touchpoint.y);
 
-      this->defer([this, touchpoint]() { this->send_touch_(touchpoint); });
+      this->add_touch_(touchpoint);
 
       this->x = touchpoint.x;
       this->y = touchpoint.y;
@@ -123,8 +124,7 @@ void XPT2046Component::check_touch_() {
     this->x_raw = this->y_raw = this->z_raw = 0;
     ESP_LOGV(TAG, "Released [%d, %d]", this->x, this->y);
     this->touched = false;
-    for (auto *listener : this->touch_listeners_)
-      listener->release();
+    this->release_touches_();
   }
 }
 
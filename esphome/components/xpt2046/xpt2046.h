@@ -49,7 +49,7 @@ class XPT2046Component : public Touchscreen,
    *
    * If the touch is detected and the component does not already know about it
    * the update() is called immediately. If the irq pin is not specified
-   * the loop() is a no-op.
+   * the loop() only reports the coalesced moves.
    */
   void loop() override;
 
@@ -29,7 +29,10 @@ from esphome.const import (
     CONF_PAYLOAD_AVAILABLE,
     CONF_PAYLOAD_NOT_AVAILABLE,
     CONF_RETAIN,
+    CONF_SETUP_AFTER,
     CONF_SETUP_PRIORITY,
+    CONF_DEFERRABLE,
+    CONF_THREAD_SAFE,
     CONF_STATE_TOPIC,
     CONF_TOPIC,
     CONF_HOUR,
@@ -1726,7 +1729,15 @@ ENTITY_BASE_SCHEMA = Schema(
 
 ENTITY_BASE_SCHEMA.add_extra(_entity_base_validator)
 
-COMPONENT_SCHEMA = Schema({Optional(CONF_SETUP_PRIORITY): float_})
+COMPONENT_SCHEMA = Schema(
+    {
+        Optional(CONF_SETUP_PRIORITY): float_,
+        # May wait for the next loop iteration when the loop budget is used up
+        Optional(CONF_DEFERRABLE): boolean,
+        # Set up once these components are ready instead of after all components with a higher priority
+        Optional(CONF_SETUP_AFTER): ensure_list(use_id(cg.Component)),
+    }
+)
 
 
 def polling_component_schema(default_update_interval):
@@ -1747,6 +1758,8 @@ def polling_component_schema(default_update_interval):
             Optional(
                 CONF_UPDATE_INTERVAL, default=default_update_interval
             ): update_interval,
+            # Run update() on a worker task on the other core
+            Optional(CONF_THREAD_SAFE): All(boolean, only_on_esp32),
         }
     )
 
@@ -181,6 +181,8 @@ CONF_DEFAULT_MODE = "default_mode"
 CONF_DEFAULT_TARGET_TEMPERATURE_HIGH = "default_target_temperature_high"
 CONF_DEFAULT_TARGET_TEMPERATURE_LOW = "default_target_temperature_low"
 CONF_DEFAULT_TRANSITION_LENGTH = "default_transition_length"
+CONF_DEFERRABLE = "deferrable"
+CONF_DEFERRED_FORMAT = "deferred_format"
 CONF_DELAY = "delay"
 CONF_DELIMITER = "delimiter"
 CONF_DELTA = "delta"
@@ -674,6 +676,7 @@ CONF_SERVICE = "service"
 CONF_SERVICE_UUID = "service_uuid"
 CONF_SERVICES = "services"
 CONF_SET_POINT_MINIMUM_DIFFERENTIAL = "set_point_minimum_differential"
+CONF_SETUP_AFTER = "setup_after"
 CONF_SETUP_MODE = "setup_mode"
 CONF_SETUP_PRIORITY = "setup_priority"
 CONF_SHOW_LINES = "show_lines"
@@ -706,6 +709,7 @@ CONF_STARTUP_DELAY = "startup_delay"
 CONF_STATE = "state"
 CONF_STATE_CLASS = "state_class"
 CONF_STATE_TOPIC = "state_topic"
+CONF_STATIC_ALLOCATION = "static_allocation"
 CONF_STATIC_IP = "static_ip"
 CONF_STATUS = "status"
 CONF_STB_PIN = "stb_pin"
@@ -728,6 +732,7 @@ CONF_SUPPORTED_PRESETS = "supported_presets"
 CONF_SUPPORTED_SWING_MODES = "supported_swing_modes"
 CONF_SUPPORTS_COOL = "supports_cool"
 CONF_SUPPORTS_HEAT = "supports_heat"
+CONF_SUPPRESS_UNCHANGED = "suppress_unchanged"
 CONF_SWING_BOTH_ACTION = "swing_both_action"
 CONF_SWING_HORIZONTAL_ACTION = "swing_horizontal_action"
 CONF_SWING_MODE = "swing_mode"
@@ -756,6 +761,7 @@ CONF_TEMPERATURE_SOURCE = "temperature_source"
 CONF_TEMPERATURE_STEP = "temperature_step"
 CONF_TEXT_SENSORS = "text_sensors"
 CONF_THEN = "then"
+CONF_THREAD_SAFE = "thread_safe"
 CONF_THRESHOLD = "threshold"
 CONF_THROTTLE = "throttle"
 CONF_TILT = "tilt"
@@ -2,15 +2,33 @@
 #include "esphome/core/log.h"
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/trace.h"
+#include "esphome/core/preference_saver.h"
+#include "esphome/core/worker.h"
+#include "esphome/core/hires_interval.h"
+#include <algorithm>
 
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#ifdef USE_RUNTIME_STATS
+#include "esphome/components/runtime_stats/runtime_stats.h"
+#endif
+
+#ifdef USE_SOCKET_SELECT_SUPPORT
+#include "esphome/components/socket/socket.h"
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
 
+#ifdef USE_EVENT_DRIVEN_LOOP
+/// Upper bound for sleeping with nothing scheduled, so that the watchdog and status LED are still serviced.
+static const uint32_t MAX_EVENT_LOOP_SLEEP_MS = 1000;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,61 +45,202 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_ESP32)
+  this->loop_task_handle_ = xTaskGetCurrentTaskHandle();
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
   });
 
-  for (uint32_t i = 0; i < this->components_.size(); i++) {
-    Component *component = this->components_[i];
+  // Components are set up in priority order. One that declared its setup dependencies only waits for those, all
+  // others wait until every component before them can proceed. While waiting, the components set up so far loop.
+  std::vector<Component *> started;
+  started.reserve(this->components_.size());
+  // Components before this index were set up before a wait and keep the loop priority order they ran in
+  size_t loop_sorted_end = 0;
+  while (true) {
+    bool blocked = false;
+    bool waiting_for_started = false;
+    size_t started_before = started.size();
+    size_t started_end = 0;
+    for (size_t i = 0; i < this->components_.size(); i++) {
+      Component *component = this->components_[i];
+      if (!component->is_setup_started_()) {
+        bool may_start =
+            component->has_setup_dependencies_() ? component->are_setup_dependencies_ready_() : !blocked;
+        if (!may_start) {
+          blocked = true;
+          continue;
+        }
+        component->call();
+        this->scheduler.process_to_add();
+        this->feed_wdt();
+        started.push_back(component);
+      }
+      started_end = i + 1;
+      if (!component->can_proceed()) {
+        blocked = true;
+        waiting_for_started = true;
+      }
+    }
+    if (!blocked)
+      break;
 
-    component->call();
-    this->scheduler.process_to_add();
-    this->feed_wdt();
-    if (component->can_proceed())
+    if (!waiting_for_started && started.size() == started_before) {
+      // Only dependencies that are set up after their dependents are left, resolve this by priority
+      for (auto *component : this->components_) {
+        if (component->is_setup_started_())
+          continue;
+        ESP_LOGW(TAG, "Setup dependencies of %s can't be met, setting it up anyway", component->get_component_source());
+        component->setup_dependencies_->clear();
+        break;
+      }
       continue;
+    }
 
-    std::stable_sort(this->components_.begin(), this->components_.begin() + i + 1,
-                     [](Component *a, Component *b) { return a->get_loop_priority() > b->get_loop_priority(); });
+    loop_sorted_end = std::max(loop_sorted_end, started_end);
+    if (started.size() != started_before) {
+      std::stable_sort(started.begin(), started.end(),
+                       [](Component *a, Component *b) { return a->get_loop_priority() > b->get_loop_priority(); });
+    }
 
-    do {
-      uint32_t new_app_state = STATUS_LED_WARNING;
-      this->scheduler.call();
+    uint32_t new_app_state = STATUS_LED_WARNING;
+    this->scheduler.call();
+    this->feed_wdt();
+    for (auto *component : started) {
+      component->call();
+      new_app_state |= component->get_component_state();
+      this->app_state_ |= new_app_state;
       this->feed_wdt();
-      for (uint32_t j = 0; j <= i; j++) {
-        this->components_[j]->call();
-        new_app_state |= this->components_[j]->get_component_state();
-        this->app_state_ |= new_app_state;
-        this->feed_wdt();
-      }
-      this->app_state_ = new_app_state;
-      yield();
-    } while (!component->can_proceed());
+    }
+    this->app_state_ = new_app_state;
+    yield();
   }
+  std::stable_sort(this->components_.begin(), this->components_.begin() + loop_sorted_end,
+                   [](Component *a, Component *b) { return a->get_loop_priority() > b->get_loop_priority(); });
 
   ESP_LOGI(TAG, "setup() finished successfully!");
   this->schedule_dump_config();
   this->calculate_looping_components_();
+  this->build_key_indexes_();
+}
+void Application::build_key_indexes_() {
+#ifdef USE_BINARY_SENSOR
+  build_key_index_(this->binary_sensors_, this->binary_sensors_by_key_);
+#endif
+#ifdef USE_SWITCH
+  build_key_index_(this->switches_, this->switches_by_key_);
+#endif
+#ifdef USE_BUTTON
+  build_key_index_(this->buttons_, this->buttons_by_key_);
+#endif
+#ifdef USE_SENSOR
+  build_key_index_(this->sensors_, this->sensors_by_key_);
+#endif
+#ifdef USE_TEXT_SENSOR
+  build_key_index_(this->text_sensors_, this->text_sensors_by_key_);
+#endif
+#ifdef USE_FAN
+  build_key_index_(this->fans_, this->fans_by_key_);
+#endif
+#ifdef USE_COVER
+  build_key_index_(this->covers_, this->covers_by_key_);
+#endif
+#ifdef USE_CLIMATE
+  build_key_index_(this->climates_, this->climates_by_key_);
+#endif
+#ifdef USE_LIGHT
+  build_key_index_(this->lights_, this->lights_by_key_);
+#endif
+#ifdef USE_NUMBER
+  build_key_index_(this->numbers_, this->numbers_by_key_);
+#endif
+#ifdef USE_SELECT
+  build_key_index_(this->selects_, this->selects_by_key_);
+#endif
+#ifdef USE_LOCK
+  build_key_index_(this->locks_, this->locks_by_key_);
+#endif
+#ifdef USE_MEDIA_PLAYER
+  build_key_index_(this->media_players_, this->media_players_by_key_);
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+  build_key_index_(this->alarm_control_panels_, this->alarm_control_panels_by_key_);
+#endif
+  this->key_indexes_built_.store(true, std::memory_order_release);
 }
 void Application::loop() {
   uint32_t new_app_state = 0;
+#ifdef USE_RUNTIME_STATS
+  const uint32_t loop_started_us = micros();
+#endif
+
+#ifdef USE_LOOP_BUDGET
+  this->loop_started_ = millis();
+#endif
+
+  if (this->has_pending_enable_loop_requests_)
+    this->enable_pending_loops_();
 
   this->scheduler.call();
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+#ifdef USE_COMPONENT_WORKER
+  worker::process_main_queue();
+#endif
+#ifdef USE_HIRES_INTERVAL
+  HighResolutionInterval::process_pending();
+#endif
+  this->in_loop_ = true;
+  // Components can disable their own loop (or another one) from loop(), which rearranges the list and adjusts
+  // current_loop_index_, so this has to iterate by index.
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;
+       this->current_loop_index_++) {
+    Component *component = this->looping_components_[this->current_loop_index_];
+#ifdef USE_LOOP_BUDGET
+    if (!component->loop_deferred_ && component->is_deferrable() && this->is_loop_budget_exceeded()) {
+      component->loop_deferred_ = true;
+#ifdef USE_RUNTIME_STATS
+      runtime_stats::global_runtime_stats->record_deferred(component);
+#endif
+      new_app_state |= component->get_component_state();
+      continue;
+    }
+    component->loop_deferred_ = false;
+#endif
     {
       WarnIfComponentBlockingGuard guard{component};
-      component->call();
+      ESPHOME_TRACE_SCOPE(trace::TRACE_CATEGORY_LOOP, component->get_component_source());
+#ifdef USE_RUNTIME_STATS
+      const uint32_t started_us = micros();
+#endif
+      // Components past their first loop() don't need the state machine in call()
+      if ((component->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP) {
+        component->call_loop();
+      } else {
+        component->call();
+      }
+#ifdef USE_RUNTIME_STATS
+      runtime_stats::global_runtime_stats->record_loop(component, micros() - started_us);
+#endif
     }
     new_app_state |= component->get_component_state();
     this->app_state_ |= new_app_state;
     this->feed_wdt();
   }
+  this->in_loop_ = false;
   this->app_state_ = new_app_state;
 
+#ifdef USE_RUNTIME_STATS
+  runtime_stats::global_runtime_stats->record_app_loop(loop_started_us, micros() - loop_started_us);
+#endif
+
   const uint32_t now = millis();
 
   if (HighFrequencyLoopRequester::is_high_frequency()) {
+#ifdef USE_SOCKET_SELECT_SUPPORT
+    socket::wait_for_data(0);
+#endif
     yield();
   } else {
     uint32_t delay_time = this->loop_interval_;
@@ -93,7 +252,19 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
+#ifdef USE_EVENT_DRIVEN_LOOP
+    if (this->looping_components_active_end_ == 0 && this->dump_config_at_ >= this->components_.size()) {
+      // Nothing needs loop(): sleep until the next scheduled item is due or someone wakes the loop
+      next_schedule = this->scheduler.next_schedule_in().value_or(MAX_EVENT_LOOP_SLEEP_MS);
+      delay_time = std::min(std::max(next_schedule, this->loop_interval_ / 2), MAX_EVENT_LOOP_SLEEP_MS);
+    }
+    this->sleep_until_woken_(delay_time);
+#elif defined(USE_SOCKET_SELECT_SUPPORT)
+    // returns early when network data arrives
+    socket::wait_for_data(delay_time);
+#else
     delay(delay_time);
+#endif
   }
   this->last_loop_ = now;
 
@@ -125,6 +296,7 @@ void IRAM_ATTR HOT Application::feed_wdt() {
 }
 void Application::reboot() {
   ESP_LOGI(TAG, "Forcing a reboot...");
+  global_preference_saver.flush();
   for (auto it = this->components_.rbegin(); it != this->components_.rend(); ++it) {
     (*it)->on_shutdown();
   }
@@ -137,6 +309,8 @@ void Application::safe_reboot() {
 }
 
 void Application::run_safe_shutdown_hooks() {
+  // Before the components shut down, as that syncs the preferences to flash
+  global_preference_saver.flush();
   for (auto it = this->components_.rbegin(); it != this->components_.rend(); ++it) {
     (*it)->on_safe_shutdown();
   }
@@ -150,6 +324,78 @@ void Application::calculate_looping_components_() {
     if (obj->has_overridden_loop())
       this->looping_components_.push_back(obj);
   }
+  // Components that failed or disabled their loop during setup start out in the inactive part
+  auto active_end =
+      std::stable_partition(this->looping_components_.begin(), this->looping_components_.end(), [](Component *c) {
+        uint32_t state = c->get_component_state() & COMPONENT_STATE_MASK;
+        return state != COMPONENT_STATE_FAILED && state != COMPONENT_STATE_LOOP_DONE;
+      });
+  this->looping_components_active_end_ = active_end - this->looping_components_.begin();
+}
+
+void Application::disable_component_loop_(Component *component) {
+  for (uint16_t i = 0; i < this->looping_components_active_end_; i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Keep the order of the remaining active components by rotating this one to the end of the active part
+    auto it = this->looping_components_.begin() + i;
+    std::rotate(it, it + 1, this->looping_components_.begin() + this->looping_components_active_end_);
+    this->looping_components_active_end_--;
+    // The next component to run moved down by one. Unsigned wrap-around of the index is intended, the loop
+    // increments it right after.
+    if (this->in_loop_ && i <= this->current_loop_index_)
+      this->current_loop_index_--;
+    return;
+  }
+}
+
+void Application::enable_component_loop_(Component *component) {
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    if (this->looping_components_[i] != component)
+      continue;
+    // Append it to the active part, it runs in this iteration if the loop hasn't passed the end yet
+    std::swap(this->looping_components_[i], this->looping_components_[this->looping_components_active_end_]);
+    this->looping_components_active_end_++;
+    return;
+  }
+}
+
+void Application::enable_pending_loops_() {
+  this->has_pending_enable_loop_requests_ = false;
+  for (size_t i = this->looping_components_active_end_; i < this->looping_components_.size(); i++) {
+    Component *component = this->looping_components_[i];
+    if (component->pending_enable_loop_)
+      component->enable_loop();  // moves it to the active part, the element now at i was already checked
+  }
+}
+
+void IRAM_ATTR Application::wake_loop_any_context() {
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_ESP32)
+  if (this->loop_task_handle_ == nullptr)
+    return;
+  if (xPortInIsrContext()) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(this->loop_task_handle_, &higher_priority_task_woken);
+    if (higher_priority_task_woken == pdTRUE)
+      portYIELD_FROM_ISR();
+  } else {
+    xTaskNotifyGive(this->loop_task_handle_);
+  }
+#endif
+}
+
+void Application::sleep_until_woken_(uint32_t delay_ms) {
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_ESP32)
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(delay_ms));
+#ifdef USE_SOCKET_SELECT_SUPPORT
+  // a notification can't interrupt select(), so only refresh the socket readiness here
+  socket::wait_for_data(0);
+#endif
+#elif defined(USE_SOCKET_SELECT_SUPPORT)
+  socket::wait_for_data(delay_ms);
+#else
+  delay(delay_ms);
+#endif
 }
 
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
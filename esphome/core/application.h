@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <vector>
 #include "esphome/core/component.h"
@@ -9,6 +11,11 @@
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -175,6 +182,29 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  uint32_t get_loop_interval() const { return this->loop_interval_; }
+
+#ifdef USE_LOOP_BUDGET
+  /** Set the time in milliseconds one loop iteration should take.
+   *
+   * Once the scheduler and the loop() calls of an iteration took that long, components that are deferrable (see
+   * Component::is_deferrable()) wait for the next iteration, so a slow display redraw doesn't hold up the API or the
+   * BLE tracker. Deferred work is never postponed twice in a row, so it runs at least every other iteration.
+   */
+  void set_loop_budget(uint32_t loop_budget) { this->loop_budget_ = loop_budget; }
+  uint32_t get_loop_budget() const { return this->loop_budget_; }
+  /// Whether the current loop iteration used up its budget.
+  bool is_loop_budget_exceeded() const { return millis() - this->loop_started_ >= this->loop_budget_; }
+#endif
+
+  /** Wake up the main loop if it is sleeping. Safe to call from ISRs and other tasks.
+   *
+   * Only has an effect with the event-driven loop on ESP32, where the main loop blocks on a task notification
+   * until the next scheduled item is due. Call this after handing data to a component from another context so that
+   * it is processed right away instead of after the sleep.
+   */
+  void wake_loop_any_context();
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -190,118 +220,79 @@ class Application {
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->binary_sensors_, this->binary_sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->switches_, this->switches_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->buttons_, this->buttons_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->sensors_, this->sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->text_sensors_, this->text_sensors_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::Fan *> &get_fans() { return this->fans_; }
   fan::Fan *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->fans_, this->fans_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->covers_, this->covers_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->lights_, this->lights_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->climates_, this->climates_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->numbers_, this->numbers_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->selects_, this->selects_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_LOCK
   const std::vector<lock::Lock *> &get_locks() { return this->locks_; }
   lock::Lock *get_lock_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->locks_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->locks_, this->locks_by_key_, key, include_internal);
   }
 #endif
 #ifdef USE_MEDIA_PLAYER
   const std::vector<media_player::MediaPlayer *> &get_media_players() { return this->media_players_; }
   media_player::MediaPlayer *get_media_player_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->media_players_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->media_players_, this->media_players_by_key_, key, include_internal);
   }
 #endif
 
@@ -310,10 +301,7 @@ class Application {
     return this->alarm_control_panels_;
   }
   alarm_control_panel::AlarmControlPanel *get_alarm_control_panel_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->alarm_control_panels_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return this->find_by_key_(this->alarm_control_panels_, this->alarm_control_panels_by_key_, key, include_internal);
   }
 #endif
 
@@ -325,55 +313,123 @@ class Application {
   void register_component_(Component *comp);
 
   void calculate_looping_components_();
+  /// Move a component out of the active part of looping_components_, see Component::disable_loop().
+  void disable_component_loop_(Component *component);
+  /// Move a component back into the active part of looping_components_, see Component::enable_loop().
+  void enable_component_loop_(Component *component);
+  void enable_pending_loops_();
+  /// Block until the given time has passed or wake_loop_any_context() is called.
+  void sleep_until_woken_(uint32_t delay_ms);
 
   void feed_wdt_arch_();
 
+  /// Sort the entities of every domain by object ID hash for find_by_key_(), at the end of setup().
+  void build_key_indexes_();
+  template<typename T> static void build_key_index_(const std::vector<T *> &entities, std::vector<T *> &index) {
+    index = entities;
+    std::stable_sort(index.begin(), index.end(),
+                     [](T *a, T *b) { return a->get_object_id_hash() < b->get_object_id_hash(); });
+  }
+
+  /** Binary search the entities of one domain for a key.
+   *
+   * \p index holds the entities sorted by object ID hash, keeping registration order between entities with the same
+   * hash. It is only read here, so the web server and worker tasks can look up entities while the main loop does.
+   * Before setup() built the indexes, or for entities registered since, this falls back to a linear search.
+   */
+  template<typename T>
+  T *find_by_key_(const std::vector<T *> &entities, const std::vector<T *> &index, uint32_t key,
+                  bool include_internal) const {
+    if (!this->key_indexes_built_.load(std::memory_order_acquire) || index.size() != entities.size()) {
+      for (T *obj : entities) {
+        if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
+          return obj;
+      }
+      return nullptr;
+    }
+    auto it = std::lower_bound(index.begin(), index.end(), key,
+                               [](T *obj, uint32_t key) { return obj->get_object_id_hash() < key; });
+    for (; it != index.end() && (*it)->get_object_id_hash() == key; ++it) {
+      if (include_internal || !(*it)->is_internal())
+        return *it;
+    }
+    return nullptr;
+  }
+
   std::vector<Component *> components_{};
+  /** Components that override loop(). Those in [0, looping_components_active_end_) get their loop() called,
+   * the rest have disabled it or failed.
+   */
   std::vector<Component *> looping_components_{};
+  uint16_t looping_components_active_end_{0};
+  /// Index into looping_components_ of the component whose loop() is running, adjusted if the list is rearranged.
+  uint16_t current_loop_index_{0};
+  bool in_loop_{false};
+  volatile bool has_pending_enable_loop_requests_{false};
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_ESP32)
+  TaskHandle_t loop_task_handle_{nullptr};
+#endif
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
+  std::vector<binary_sensor::BinarySensor *> binary_sensors_by_key_{};
 #endif
 #ifdef USE_SWITCH
   std::vector<switch_::Switch *> switches_{};
+  std::vector<switch_::Switch *> switches_by_key_{};
 #endif
 #ifdef USE_BUTTON
   std::vector<button::Button *> buttons_{};
+  std::vector<button::Button *> buttons_by_key_{};
 #endif
 #ifdef USE_SENSOR
   std::vector<sensor::Sensor *> sensors_{};
+  std::vector<sensor::Sensor *> sensors_by_key_{};
 #endif
 #ifdef USE_TEXT_SENSOR
   std::vector<text_sensor::TextSensor *> text_sensors_{};
+  std::vector<text_sensor::TextSensor *> text_sensors_by_key_{};
 #endif
 #ifdef USE_FAN
   std::vector<fan::Fan *> fans_{};
+  std::vector<fan::Fan *> fans_by_key_{};
 #endif
 #ifdef USE_COVER
   std::vector<cover::Cover *> covers_{};
+  std::vector<cover::Cover *> covers_by_key_{};
 #endif
 #ifdef USE_CLIMATE
   std::vector<climate::Climate *> climates_{};
+  std::vector<climate::Climate *> climates_by_key_{};
 #endif
 #ifdef USE_LIGHT
   std::vector<light::LightState *> lights_{};
+  std::vector<light::LightState *> lights_by_key_{};
 #endif
 #ifdef USE_NUMBER
   std::vector<number::Number *> numbers_{};
+  std::vector<number::Number *> numbers_by_key_{};
 #endif
 #ifdef USE_SELECT
   std::vector<select::Select *> selects_{};
+  std::vector<select::Select *> selects_by_key_{};
 #endif
 #ifdef USE_LOCK
   std::vector<lock::Lock *> locks_{};
+  std::vector<lock::Lock *> locks_by_key_{};
 #endif
 #ifdef USE_MEDIA_PLAYER
   std::vector<media_player::MediaPlayer *> media_players_{};
+  std::vector<media_player::MediaPlayer *> media_players_by_key_{};
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   std::vector<alarm_control_panel::AlarmControlPanel *> alarm_control_panels_{};
+  std::vector<alarm_control_panel::AlarmControlPanel *> alarm_control_panels_by_key_{};
 #endif
 
+  /// Set once the *_by_key_ indexes are built, they are never written again after that.
+  std::atomic<bool> key_indexes_built_{false};
+
   std::string name_;
   std::string friendly_name_;
   const char *comment_{nullptr};
@@ -381,6 +437,10 @@ class Application {
   bool name_add_mac_suffix_;
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
+#ifdef USE_LOOP_BUDGET
+  uint32_t loop_budget_{UINT32_MAX};
+  uint32_t loop_started_{0};
+#endif
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
 };
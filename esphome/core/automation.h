@@ -1,5 +1,6 @@
 #pragma once
 
+#include <utility>
 #include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
@@ -22,6 +23,51 @@ template<int... S> struct gens<0, S...> { using type = seq<S...>; };  // NOLINT
 
 #define TEMPLATABLE_VALUE(type, name) TEMPLATABLE_VALUE_(type, name)
 
+/** A callable that is stored as a plain function pointer if it captures nothing, and as a std::function otherwise.
+ *
+ * Codegen emits automation lambdas without captures where it can, so those are called directly instead of through
+ * std::function's type erasure and take two pointers instead of a whole std::function.
+ */
+template<typename T, typename... X> class LambdaFunction {
+ public:
+  using function_ptr_t = T (*)(X...);
+
+  LambdaFunction() = default;
+
+  template<typename F, enable_if_t<std::is_convertible<F, function_ptr_t>::value, int> = 0>
+  LambdaFunction(F f) : ptr_(f) {}
+
+  template<typename F, enable_if_t<!std::is_convertible<F, function_ptr_t>::value &&
+                                       !std::is_same<typename std::decay<F>::type, LambdaFunction>::value,
+                                   int> = 0>
+  LambdaFunction(F f) : function_(new std::function<T(X...)>(std::move(f))) {}  // NOLINT
+
+  LambdaFunction(const LambdaFunction &other) : ptr_(other.ptr_) {
+    if (other.function_ != nullptr)
+      this->function_ = new std::function<T(X...)>(*other.function_);  // NOLINT
+  }
+  LambdaFunction(LambdaFunction &&other) noexcept : ptr_(other.ptr_), function_(other.function_) {
+    other.ptr_ = nullptr;
+    other.function_ = nullptr;
+  }
+  LambdaFunction &operator=(LambdaFunction other) noexcept {
+    std::swap(this->ptr_, other.ptr_);
+    std::swap(this->function_, other.function_);
+    return *this;
+  }
+  ~LambdaFunction() { delete this->function_; }  // NOLINT
+
+  T operator()(X... x) const {
+    if (this->ptr_ != nullptr)
+      return this->ptr_(x...);
+    return (*this->function_)(x...);
+  }
+
+ protected:
+  function_ptr_t ptr_{nullptr};
+  std::function<T(X...)> *function_{nullptr};
+};
+
 template<typename T, typename... X> class TemplatableValue {
  public:
   TemplatableValue() : type_(EMPTY) {}
@@ -64,7 +110,7 @@ template<typename T, typename... X> class TemplatableValue {
   } type_;
 
   T value_{};
-  std::function<T(X...)> f_{};
+  LambdaFunction<T, X...> f_{};
 };
 
 /** Base class for all automation conditions.
@@ -50,11 +50,11 @@ template<typename... Ts> class NotCondition : public Condition<Ts...> {
 
 template<typename... Ts> class LambdaCondition : public Condition<Ts...> {
  public:
-  explicit LambdaCondition(std::function<bool(Ts...)> &&f) : f_(std::move(f)) {}
+  template<typename F> explicit LambdaCondition(F f) : f_(std::move(f)) {}
   bool check(Ts... x) override { return this->f_(x...); }
 
  protected:
-  std::function<bool(Ts...)> f_;
+  LambdaFunction<bool, Ts...> f_;
 };
 
 template<typename... Ts> class ForCondition : public Condition<Ts...>, public Component {
@@ -130,12 +130,12 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
  public:
-  explicit LambdaAction(std::function<void(Ts...)> &&f) : f_(std::move(f)) {}
+  template<typename F> explicit LambdaAction(F f) : f_(std::move(f)) {}
 
   void play(Ts... x) override { this->f_(x...); }
 
  protected:
-  std::function<void(Ts...)> f_;
+  LambdaFunction<void, Ts...> f_;
 };
 
 template<typename... Ts> class IfAction : public Action<Ts...> {
@@ -4,6 +4,8 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include "esphome/core/trace.h"
+#include "esphome/core/worker.h"
 #include <utility>
 
 namespace esphome {
@@ -33,6 +35,7 @@ const uint32_t COMPONENT_STATE_CONSTRUCTION = 0x00;
 const uint32_t COMPONENT_STATE_SETUP = 0x01;
 const uint32_t COMPONENT_STATE_LOOP = 0x02;
 const uint32_t COMPONENT_STATE_FAILED = 0x03;
+const uint32_t COMPONENT_STATE_LOOP_DONE = 0x04;
 const uint32_t STATUS_LED_MASK = 0xFF00;
 const uint32_t STATUS_LED_OK = 0x0000;
 const uint32_t STATUS_LED_WARNING = 0x0100;
@@ -48,8 +51,9 @@ void Component::setup() {}
 
 void Component::loop() {}
 
-void Component::set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, name, interval, std::move(f));
+SchedulerHandle Component::set_interval(const std::string &name, uint32_t interval,
+                                       std::function<void()> &&f) {  // NOLINT
+  return App.scheduler.set_interval(this, name, interval, std::move(f));
 }
 
 bool Component::cancel_interval(const std::string &name) {  // NOLINT
@@ -65,7 +69,8 @@ bool Component::cancel_retry(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_retry(this, name);
 }
 
-void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+SchedulerHandle Component::set_timeout(const std::string &name, uint32_t timeout,
+                                      std::function<void()> &&f) {  // NOLINT
   return App.scheduler.set_timeout(this, name, timeout, std::move(f));
 }
 
@@ -73,6 +78,26 @@ bool Component::cancel_timeout(const std::string &name) {  // NOLINT
   return App.scheduler.cancel_timeout(this, name);
 }
 
+SchedulerHandle Component::set_timeout(uint32_t id, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  return App.scheduler.set_timeout(this, id, timeout, std::move(f));
+}
+
+bool Component::cancel_timeout(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_timeout(this, id);
+}
+
+SchedulerHandle Component::set_interval(uint32_t id, uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  return App.scheduler.set_interval(this, id, interval, std::move(f));
+}
+
+bool Component::cancel_interval(uint32_t id) {  // NOLINT
+  return App.scheduler.cancel_interval(this, id);
+}
+
+bool Component::cancel_scheduled(SchedulerHandle handle) {  // NOLINT
+  return App.scheduler.cancel(handle);
+}
+
 void Component::call_loop() { this->loop(); }
 void Component::call_setup() { this->setup(); }
 void Component::call_dump_config() { this->dump_config(); }
@@ -100,6 +125,9 @@ void Component::call() {
     case COMPONENT_STATE_FAILED:  // NOLINT(bugprone-branch-clone)
       // State failed: Do nothing
       break;
+    case COMPONENT_STATE_LOOP_DONE:  // NOLINT(bugprone-branch-clone)
+      // State loop done: loop() was disabled, do nothing
+      break;
     default:
       break;
   }
@@ -114,6 +142,31 @@ void Component::mark_failed() {
   this->component_state_ &= ~COMPONENT_STATE_MASK;
   this->component_state_ |= COMPONENT_STATE_FAILED;
   this->status_set_error();
+  App.disable_component_loop_(this);
+}
+void Component::disable_loop() {
+  uint32_t state = this->component_state_ & COMPONENT_STATE_MASK;
+  if (state != COMPONENT_STATE_SETUP && state != COMPONENT_STATE_LOOP)
+    return;
+  ESP_LOGVV(TAG, "%s loop disabled", this->get_component_source());
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP_DONE;
+  App.disable_component_loop_(this);
+}
+void Component::enable_loop() {
+  this->pending_enable_loop_ = false;
+  if ((this->component_state_ & COMPONENT_STATE_MASK) != COMPONENT_STATE_LOOP_DONE)
+    return;
+  ESP_LOGVV(TAG, "%s loop enabled", this->get_component_source());
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP;
+  App.enable_component_loop_(this);
+}
+void IRAM_ATTR Component::enable_loop_soon_any_context() {
+  // Only touch volatile flags here, the lists are rearranged by the main loop
+  this->pending_enable_loop_ = true;
+  App.has_pending_enable_loop_requests_ = true;
+  App.wake_loop_any_context();
 }
 void Component::defer(std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, "", 0, std::move(f));
@@ -124,11 +177,11 @@ bool Component::cancel_defer(const std::string &name) {  // NOLINT
 void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
-void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", timeout, std::move(f));
+SchedulerHandle Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  return App.scheduler.set_timeout(this, "", timeout, std::move(f));
 }
-void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_interval(this, "", interval, std::move(f));
+SchedulerHandle Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
+  return App.scheduler.set_interval(this, "", interval, std::move(f));
 }
 void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std::function<RetryResult(uint8_t)> &&f,
                           float backoff_increase_factor) {  // NOLINT
@@ -137,9 +190,25 @@ void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std:
 bool Component::is_failed() { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::is_ready() {
   return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP ||
+         (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP_DONE ||
          (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_SETUP;
 }
 bool Component::can_proceed() { return true; }
+void Component::add_setup_dependency(Component *dependency) {
+  this->set_setup_independent();
+  this->setup_dependencies_->push_back(dependency);
+}
+void Component::set_setup_independent() {
+  if (this->setup_dependencies_ == nullptr)
+    this->setup_dependencies_ = new std::vector<Component *>();  // NOLINT(cppcoreguidelines-owning-memory)
+}
+bool Component::are_setup_dependencies_ready_() const {
+  for (auto *dependency : *this->setup_dependencies_) {
+    if (!dependency->is_setup_started_() || !dependency->can_proceed())
+      return false;
+  }
+  return true;
+}
 bool Component::status_has_warning() { return this->component_state_ & STATUS_LED_WARNING; }
 bool Component::status_has_error() { return this->component_state_ & STATUS_LED_ERROR; }
 void Component::status_set_warning() {
@@ -189,7 +258,22 @@ void PollingComponent::call_setup() {
   this->setup();
 
   // Register interval.
-  this->set_interval("update", this->get_update_interval(), [this]() { this->update(); });
+#ifdef USE_STAGGERED_POLLING
+  App.scheduler.set_staggered_interval(this, "update", this->get_update_interval(), [this]() { this->call_update_(); });
+#else
+  this->set_interval("update", this->get_update_interval(), [this]() { this->call_update_(); });
+#endif
+}
+
+void PollingComponent::call_update_() {
+#ifdef USE_COMPONENT_WORKER
+  if (this->thread_safe_) {
+    worker::submit_update(this);
+    return;
+  }
+#endif
+  ESPHOME_TRACE_SCOPE(trace::TRACE_CATEGORY_UPDATE, this->get_component_source());
+  this->update();
 }
 
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
@@ -3,11 +3,23 @@
 #include <string>
 #include <functional>
 #include <cmath>
+#include <vector>
 
+#include "esphome/core/defines.h"
 #include "esphome/core/optional.h"
 
+#ifdef USE_COMPONENT_WORKER
+#include <atomic>
+#endif
+
 namespace esphome {
 
+#ifdef USE_RUNTIME_STATS
+namespace runtime_stats {
+struct ComponentStats;
+}  // namespace runtime_stats
+#endif
+
 /** Default setup priorities for components of different types.
  *
  * Components should return one of these setup priorities in get_setup_priority.
@@ -43,6 +55,10 @@ extern const float LATE;
 
 static const uint32_t SCHEDULER_DONT_RUN = 4294967295UL;
 
+/// Opaque identifier of a scheduled timeout or interval, see Scheduler::cancel().
+using SchedulerHandle = uint32_t;
+static const SchedulerHandle SCHEDULER_INVALID_HANDLE = 0;
+
 #define LOG_UPDATE_INTERVAL(this) \
   if (this->get_update_interval() == SCHEDULER_DONT_RUN) { \
     ESP_LOGCONFIG(TAG, "  Update Interval: never"); \
@@ -57,6 +73,7 @@ extern const uint32_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint32_t COMPONENT_STATE_SETUP;
 extern const uint32_t COMPONENT_STATE_LOOP;
 extern const uint32_t COMPONENT_STATE_FAILED;
+extern const uint32_t COMPONENT_STATE_LOOP_DONE;
 extern const uint32_t STATUS_LED_MASK;
 extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
@@ -102,6 +119,14 @@ class Component {
    */
   virtual float get_loop_priority() const;
 
+  /** Whether loop() and the timeouts and intervals of this component, like update(), may wait for the next loop
+   * iteration when the loop budget is used up, see Application::set_loop_budget().
+   *
+   * For components doing slow work that nothing else waits for, like redrawing a display. Defaults to false.
+   */
+  bool is_deferrable() const { return this->deferrable_; }
+  void set_deferrable(bool deferrable) { this->deferrable_ = deferrable; }
+
   void call();
 
   virtual void on_shutdown() {}
@@ -123,6 +148,18 @@ class Component {
 
   virtual bool can_proceed();
 
+  /** Declare a component that has to be set up and able to proceed before this one is set up.
+   *
+   * A component without declared setup dependencies waits until every component with a higher setup priority
+   * can proceed. One that declared them (possibly none, see set_setup_independent()) is set up as soon as those are
+   * ready, even while an unrelated component is still busy. Setups that take long should return early, finish in
+   * loop() and report that through can_proceed(), so that independent components are set up in the meantime.
+   */
+  void add_setup_dependency(Component *dependency);
+
+  /// Set this component up without waiting for any other component.
+  void set_setup_independent();
+
   bool status_has_warning();
 
   bool status_has_error();
@@ -141,6 +178,23 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() for this component until enable_loop() is called.
+   *
+   * Components that only have work to do in loop() now and then should disable it while idle. This takes them
+   * out of the list of components the application iterates over, and with the event-driven main loop allows it to
+   * sleep until the next scheduled item instead of polling. Timeouts and intervals keep running.
+   */
+  void disable_loop();
+
+  /// Resume calling loop() after disable_loop(). Must be called from the main loop task.
+  void enable_loop();
+
+  /** Resume calling loop() after disable_loop() from any context, including ISRs and other tasks.
+   *
+   * The component is re-enabled at the start of the next main loop iteration, which is woken up if it is sleeping.
+   */
+  void enable_loop_soon_any_context();
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -152,6 +206,12 @@ class Component {
    */
   const char *get_component_source() const;
 
+#ifdef USE_RUNTIME_STATS
+  /// Timing statistics collected by the runtime_stats component, nullptr until this component first ran.
+  runtime_stats::ComponentStats *get_runtime_stats() const { return this->runtime_stats_; }
+  void set_runtime_stats(runtime_stats::ComponentStats *runtime_stats) { this->runtime_stats_ = runtime_stats; }
+#endif
+
  protected:
   friend class Application;
 
@@ -159,6 +219,13 @@ class Component {
   virtual void call_setup();
   virtual void call_dump_config();
 
+  bool is_setup_started_() const {
+    return (this->component_state_ & COMPONENT_STATE_MASK) != COMPONENT_STATE_CONSTRUCTION;
+  }
+  bool has_setup_dependencies_() const { return this->setup_dependencies_ != nullptr; }
+  /// Whether all declared setup dependencies were set up and can proceed.
+  bool are_setup_dependencies_ready_() const;
+
   /** Set an interval function with a unique name. Empty name means no cancelling possible.
    *
    * This will call f every interval ms. Can be cancelled via CancelInterval().
@@ -171,12 +238,20 @@ class Component {
    * @param name The identifier for this interval function.
    * @param interval The interval in ms.
    * @param f The function (or lambda) that should be called
+   * @return A handle that can be passed to cancel_scheduled() to cancel this interval in O(log n).
    *
    * @see cancel_interval()
    */
-  void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
+  SchedulerHandle set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
 
-  void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
+  SchedulerHandle set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
+
+  /** Set an interval function identified by a numeric id instead of a name.
+   *
+   * Behaves like set_interval() with a name, but never allocates a string. Use fnv1_hash_constexpr() to derive
+   * the id from a literal at compile time. An id of 0 means no cancelling possible.
+   */
+  SchedulerHandle set_interval(uint32_t id, uint32_t interval, std::function<void()> &&f);  // NOLINT
 
   /** Cancel an interval function.
    *
@@ -185,6 +260,9 @@ class Component {
    */
   bool cancel_interval(const std::string &name);  // NOLINT
 
+  /// Cancel an interval function set with a numeric id.
+  bool cancel_interval(uint32_t id);  // NOLINT
+
   /** Set an retry function with a unique name. Empty name means no cancelling possible.
    *
    * This will call the retry function f on the next scheduler loop. f should return RetryResult::DONE if
@@ -239,12 +317,21 @@ class Component {
    * @param name The identifier for this timeout function.
    * @param timeout The timeout in ms.
    * @param f The function (or lambda) that should be called
+   * @return A handle that can be passed to cancel_scheduled() to cancel this timeout in O(log n).
    *
    * @see cancel_timeout()
    */
-  void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+  SchedulerHandle set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
-  void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
+  SchedulerHandle set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
+  /** Set a timeout function identified by a numeric id instead of a name.
+   *
+   * Behaves like set_timeout() with a name, but never allocates a string. Re-arming a pending timeout with the
+   * same id reuses it in place. Use fnv1_hash_constexpr() to derive the id from a literal at compile time.
+   * An id of 0 means no cancelling possible.
+   */
+  SchedulerHandle set_timeout(uint32_t id, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
   /** Cancel a timeout function.
    *
@@ -253,6 +340,18 @@ class Component {
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
 
+  /// Cancel a timeout function set with a numeric id.
+  bool cancel_timeout(uint32_t id);  // NOLINT
+
+  /** Cancel a timeout or interval using the handle returned by set_timeout() or set_interval().
+   *
+   * Unlike cancelling by name this does not need to search all scheduled items. Stale handles are ignored.
+   *
+   * @param handle The handle of the timeout or interval.
+   * @return Whether a timeout or interval was cancelled.
+   */
+  bool cancel_scheduled(SchedulerHandle handle);  // NOLINT
+
   /** Defer a callback to the next loop() call.
    *
    * If name is specified and a defer() object with the same name exists, the old one is first removed.
@@ -271,6 +370,18 @@ class Component {
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+  /// Components that have to be ready before this one is set up, nullptr if not declared.
+  std::vector<Component *> *setup_dependencies_{nullptr};
+  /// Set by enable_loop_soon_any_context(), consumed by the main loop.
+  volatile bool pending_enable_loop_{false};
+  bool deferrable_{false};
+#ifdef USE_LOOP_BUDGET
+  /// loop() was deferred in the previous iteration, it runs in this one whatever the budget.
+  bool loop_deferred_{false};
+#endif
+#ifdef USE_RUNTIME_STATS
+  runtime_stats::ComponentStats *runtime_stats_{nullptr};
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -308,8 +419,23 @@ class PollingComponent : public Component {
   /// Get the update interval in ms of this sensor
   virtual uint32_t get_update_interval() const;
 
+#ifdef USE_COMPONENT_WORKER
+  /// Run update() on the worker task instead of the main loop, see worker.h.
+  void set_thread_safe(bool thread_safe) { this->thread_safe_ = thread_safe; }
+  /// Claim the component for one update() on the worker, false while the previous one is still queued or running.
+  bool claim_worker_update() { return !this->worker_update_pending_.exchange(true); }
+  void release_worker_update() { this->worker_update_pending_ = false; }
+#endif
+
  protected:
+  /// Run update() from the update interval.
+  void call_update_();
+
   uint32_t update_interval_;
+#ifdef USE_COMPONENT_WORKER
+  bool thread_safe_{false};
+  std::atomic<bool> worker_update_pending_{false};
+#endif
 };
 
 class WarnIfComponentBlockingGuard {
@@ -12,20 +12,29 @@ namespace esphome {
 void ComponentIterator::begin(bool include_internal) {
   this->state_ = IteratorState::BEGIN;
   this->at_ = 0;
+  this->entities_done_ = 0;
+  this->started_ = millis();
   this->include_internal_ = include_internal;
 }
-void ComponentIterator::advance() {
+void ComponentIterator::advance_for(uint32_t budget_us) {
+  const uint32_t start = micros();
+  while (this->advance() && this->is_active()) {
+    if (micros() - start >= budget_us)
+      break;
+  }
+}
+bool ComponentIterator::advance() {
   bool advance_platform = false;
   bool success = true;
   switch (this->state_) {
     case IteratorState::NONE:
       // not started
-      return;
+      return false;
     case IteratorState::BEGIN:
       if (this->on_begin()) {
         advance_platform = true;
       } else {
-        return;
+        return false;
       }
       break;
 #ifdef USE_BINARY_SENSOR
@@ -265,8 +274,9 @@ void ComponentIterator::advance() {
     case IteratorState::MAX:
       if (this->on_end()) {
         this->state_ = IteratorState::NONE;
+        return true;
       }
-      return;
+      return false;
   }
 
   if (advance_platform) {
@@ -274,7 +284,9 @@ void ComponentIterator::advance() {
     this->at_ = 0;
   } else if (success) {
     this->at_++;
+    this->entities_done_++;
   }
+  return advance_platform || success;
 }
 bool ComponentIterator::on_end() { return true; }
 bool ComponentIterator::on_begin() { return true; }
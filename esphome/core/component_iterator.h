@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 
 #ifdef USE_ESP32_CAMERA
@@ -19,7 +20,15 @@ class UserServiceDescriptor;
 class ComponentIterator {
  public:
   void begin(bool include_internal = false);
-  void advance();
+  /// Process one step, returns false if the iterator is idle or a callback asked to retry later.
+  bool advance();
+  /// Process steps until done, a callback asks to retry later or budget_us microseconds have passed.
+  void advance_for(uint32_t budget_us);
+  bool is_active() const { return this->state_ != IteratorState::NONE; }
+  /// Number of entities handled since begin().
+  uint32_t get_entities_done() const { return this->entities_done_; }
+  /// Milliseconds since begin().
+  uint32_t get_elapsed_ms() const { return millis() - this->started_; }
   virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
   virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
@@ -126,6 +135,8 @@ class ComponentIterator {
     MAX,
   } state_{IteratorState::NONE};
   size_t at_{0};
+  uint32_t entities_done_{0};
+  uint32_t started_{0};
   bool include_internal_{false};
 };
 
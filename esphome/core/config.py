@@ -28,6 +28,7 @@ from esphome.const import (
     CONF_PRIORITY,
     CONF_PROJECT,
     CONF_SOURCE,
+    CONF_STATIC_ALLOCATION,
     CONF_TRIGGER_ID,
     CONF_TYPE,
     CONF_VERSION,
@@ -55,6 +56,9 @@ LoopTrigger = cg.esphome_ns.class_(
 VERSION_REGEX = re.compile(r"^[0-9]+\.[0-9]+\.[0-9]+(?:[ab]\d+)?$")
 
 CONF_NAME_ADD_MAC_SUFFIX = "name_add_mac_suffix"
+CONF_EVENT_DRIVEN_LOOP = "event_driven_loop"
+CONF_LOOP_BUDGET = "loop_budget"
+CONF_STAGGER_INTERVALS = "stagger_intervals"
 
 
 VALID_INCLUDE_EXTS = {".h", ".hpp", ".tcc", ".ino", ".cpp", ".c"}
@@ -153,6 +157,10 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
             cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
             cv.Optional(CONF_NAME_ADD_MAC_SUFFIX, default=False): cv.boolean,
+            cv.Optional(CONF_EVENT_DRIVEN_LOOP, default=False): cv.boolean,
+            cv.Optional(CONF_LOOP_BUDGET): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_STAGGER_INTERVALS, default=False): cv.boolean,
+            cv.Optional(CONF_STATIC_ALLOCATION, default=False): cv.boolean,
             cv.Optional(CONF_PROJECT): cv.Schema(
                 {
                     cv.Required(CONF_NAME): cv.All(
@@ -358,6 +366,16 @@ async def to_code(config):
 
     CORE.add_job(_add_automations, config)
 
+    if config[CONF_EVENT_DRIVEN_LOOP]:
+        cg.add_define("USE_EVENT_DRIVEN_LOOP")
+
+    if config[CONF_STAGGER_INTERVALS]:
+        cg.add_define("USE_STAGGERED_POLLING")
+
+    if CONF_LOOP_BUDGET in config:
+        cg.add(cg.App.set_loop_budget(config[CONF_LOOP_BUDGET]))
+        cg.add_define("USE_LOOP_BUDGET")
+
     cg.add_build_flag("-fno-exceptions")
 
     # Libraries
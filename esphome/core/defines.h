@@ -15,17 +15,25 @@
 
 // Feature flags
 #define USE_API
+#define USE_API_LIST_ENTITIES_CACHE
+#define USE_API_MAX_FRAME_SIZE 8192  // NOLINT
 #define USE_API_NOISE
 #define USE_API_PLAINTEXT
+#define USE_API_STATE_BROADCAST
 #define USE_ALARM_CONTROL_PANEL
 #define USE_BINARY_SENSOR
 #define USE_BUTTON
 #define USE_CLIMATE
 #define USE_COVER
 #define USE_DEEP_SLEEP
+#define USE_EVENT_DRIVEN_LOOP
+#define USE_LOOP_BUDGET
+#define USE_STAGGERED_POLLING
 #define USE_FAN
 #define USE_GRAPH
+#define USE_HEAP_TRACKING
 #define USE_HOMEASSISTANT_TIME
+#define USE_I2C
 #define USE_JSON
 #define USE_LIGHT
 #define USE_LOCK
@@ -39,6 +47,7 @@
 #define USE_OTA_STATE_CALLBACK
 #define USE_POWER_SUPPLY
 #define USE_QR_CODE
+#define USE_RUNTIME_STATS
 #define USE_SELECT
 #define USE_SENSOR
 #define USE_STATUS_LED
@@ -46,6 +55,8 @@
 #define USE_TEXT_SENSOR
 #define USE_TIME
 #define USE_TOUCHSCREEN
+#define USE_TRACE
+#define USE_TRACE_BUFFER_SIZE 256
 #define USE_UART_DEBUGGER
 #define USE_WIFI
 
@@ -66,11 +77,17 @@
 
 // ESP32-specific feature flags
 #ifdef USE_ESP32
+#define USE_ADC_SENSOR_CONTINUOUS
+#define USE_COMPONENT_WORKER
 #define USE_ESP32_BLE_CLIENT
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
+#define USE_HIRES_INTERVAL
 #define USE_IMPROV
+#define USE_LOGGER_ASYNC
+#define USE_LOGGER_DEFERRED_FORMAT
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #define USE_WIFI_11KV_SUPPORT
 #define USE_BLUETOOTH_PROXY
 #define USE_VOICE_ASSISTANT
@@ -92,6 +109,7 @@
 #define USE_ADC_SENSOR_VCC
 #define USE_ARDUINO_VERSION_CODE VERSION_CODE(3, 0, 2)
 #define USE_ESP8266_PREFERENCES_FLASH
+#define USE_ESP8266_PREFERENCES_SECTORS 1
 #define USE_HTTP_REQUEST_ESP8266_HTTPS
 #define USE_SOCKET_IMPL_LWIP_TCP
 
@@ -114,6 +132,7 @@
 
 #ifdef USE_HOST
 #define USE_SOCKET_IMPL_BSD_SOCKETS
+#define USE_SOCKET_SELECT_SUPPORT
 #endif
 
 // Disabled feature flags
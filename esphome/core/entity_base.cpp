@@ -57,6 +57,15 @@ void EntityBase::set_object_id(const char *object_id) {
   this->object_id_c_str_ = object_id;
   this->calc_object_id_();
 }
+void EntityBase::set_object_id(const char *object_id, uint32_t object_id_hash) {
+  this->object_id_c_str_ = object_id;
+  // The precomputed hash doesn't cover an object ID derived from the name with the MAC suffix added at runtime
+  if (!this->has_own_name_ && App.is_name_add_mac_suffix_enabled()) {
+    this->calc_object_id_();
+  } else {
+    this->object_id_hash_ = object_id_hash;
+  }
+}
 
 // Calculate Object ID Hash from Entity Name
 void EntityBase::calc_object_id_() {
@@ -25,6 +25,8 @@ class EntityBase {
   // Get the sanitized name of this Entity as an ID.
   std::string get_object_id() const;
   void set_object_id(const char *object_id);
+  // Set the object ID with its hash computed by codegen, which saves hashing it at boot.
+  void set_object_id(const char *object_id, uint32_t object_id_hash);
 
   // Get the unique Object ID of this Entity
   uint32_t get_object_id_hash();
@@ -76,6 +76,46 @@ class ISRInternalGPIOPin {
   void *arg_{nullptr};
 };
 
+/** Handle to write and read a pin with as little overhead as possible, for bit-banged protocols.
+ *
+ * Internal pins of platforms that support it are accessed through their set, clear and input registers directly,
+ * so a write is a single store instead of a virtual call into the framework. All other pins fall back to the
+ * methods of GPIOPin. The handle only writes and reads, setup() and pin_mode() still go through the pin.
+ */
+class FastGPIOPin {
+ public:
+  FastGPIOPin() = default;
+  explicit FastGPIOPin(GPIOPin *pin) : pin_(pin) {}
+  FastGPIOPin(volatile uint32_t *set_reg, volatile uint32_t *clear_reg, const volatile uint32_t *in_reg, uint32_t mask,
+              bool inverted)
+      : set_reg_(set_reg), clear_reg_(clear_reg), in_reg_(in_reg), mask_(mask), inverted_(inverted) {}
+
+  /// Get the fastest handle for pin, pin may be nullptr.
+  static FastGPIOPin from(GPIOPin *pin);
+
+  void digital_write(bool value) const {
+    if (this->mask_ == 0) {
+      this->pin_->digital_write(value);
+      return;
+    }
+    *(value != this->inverted_ ? this->set_reg_ : this->clear_reg_) = this->mask_;
+  }
+  bool digital_read() const {
+    if (this->mask_ == 0)
+      return this->pin_->digital_read();
+    return ((*this->in_reg_ & this->mask_) != 0) != this->inverted_;
+  }
+
+ protected:
+  GPIOPin *pin_{nullptr};
+  volatile uint32_t *set_reg_{nullptr};
+  volatile uint32_t *clear_reg_{nullptr};
+  const volatile uint32_t *in_reg_{nullptr};
+  /// Bit of the pin in the registers, 0 if the pin is accessed through pin_
+  uint32_t mask_{0};
+  bool inverted_{false};
+};
+
 class InternalGPIOPin : public GPIOPin {
  public:
   template<typename T> void attach_interrupt(void (*func)(T *), T *arg, gpio::InterruptType type) const {
@@ -86,6 +126,9 @@ class InternalGPIOPin : public GPIOPin {
 
   virtual ISRInternalGPIOPin to_isr() const = 0;
 
+  /// Get a handle that accesses the registers of this pin directly, if the platform supports it.
+  virtual FastGPIOPin to_fast() { return FastGPIOPin(this); }
+
   virtual uint8_t get_pin() const = 0;
 
   bool is_internal() override { return true; }
@@ -96,4 +139,10 @@ class InternalGPIOPin : public GPIOPin {
   virtual void attach_interrupt(void (*func)(void *), void *arg, gpio::InterruptType type) const = 0;
 };
 
+inline FastGPIOPin FastGPIOPin::from(GPIOPin *pin) {
+  if (pin != nullptr && pin->is_internal())
+    return static_cast<InternalGPIOPin *>(pin)->to_fast();
+  return FastGPIOPin(pin);
+}
+
 }  // namespace esphome
@@ -0,0 +1,263 @@
+#include "esphome/core/heap.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "esphome/core/helpers.h"
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#include <esp_idf_version.h>
+#include <freertos/FreeRTOS.h>
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include <esp_memory_utils.h>
+#else
+#include <soc/soc_memory_layout.h>
+#endif
+#endif
+#if defined(USE_ESP8266) && defined(USE_ARDUINO)
+#include <Esp.h>
+#endif
+#if defined(USE_RP2040) || defined(USE_LIBRETINY)
+#include <Arduino.h>
+#endif
+#ifdef USE_HOST
+#include <mutex>
+#endif
+
+namespace esphome {
+
+const char *heap_tag_to_string(HeapTag tag) {
+  switch (tag) {
+    case HeapTag::API:
+      return "api";
+    case HeapTag::BLE:
+      return "ble";
+    case HeapTag::JSON:
+      return "json";
+    case HeapTag::DISPLAY:
+      return "display";
+    case HeapTag::MQTT:
+      return "mqtt";
+    case HeapTag::LIGHT:
+      return "light";
+    case HeapTag::AUDIO:
+      return "audio";
+    default:
+      return "other";
+  }
+}
+
+const char *ram_placement_to_string(RAMPlacement placement) {
+  switch (placement) {
+    case RAMPlacement::PREFER_INTERNAL:
+      return "prefer internal";
+    case RAMPlacement::EXTERNAL:
+      return "external";
+    default:
+      return "prefer external";
+  }
+}
+
+uint32_t get_free_heap() {
+#if defined(USE_ESP8266)
+  return ESP.getFreeHeap();  // NOLINT(readability-static-accessed-through-instance)
+#elif defined(USE_ESP32)
+  return heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+#elif defined(USE_RP2040)
+  return rp2040.getFreeHeap();
+#elif defined(USE_LIBRETINY)
+  return lt_heap_get_free();
+#else
+  return 0;
+#endif
+}
+
+uint32_t get_largest_free_heap_block() {
+#if defined(USE_ESP8266)
+  return ESP.getMaxFreeBlockSize();  // NOLINT(readability-static-accessed-through-instance)
+#elif defined(USE_ESP32)
+  return heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+#elif defined(USE_LIBRETINY)
+  return lt_heap_get_max_alloc();
+#else
+  return get_free_heap();
+#endif
+}
+
+float get_heap_fragmentation() {
+  uint32_t free_heap = get_free_heap();
+  if (free_heap == 0)
+    return 0.0f;
+  return 100.0f - get_largest_free_heap_block() * 100.0f / free_heap;
+}
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+#ifdef USE_ESP32
+static portMUX_TYPE heap_stats_mux = portMUX_INITIALIZER_UNLOCKED;
+#elif defined(USE_HOST)
+static std::mutex heap_stats_mutex;
+#endif
+static RAMPlacement ram_placements[HEAP_TAG_COUNT] = {
+    RAMPlacement::PREFER_EXTERNAL, RAMPlacement::PREFER_EXTERNAL, RAMPlacement::PREFER_EXTERNAL,
+    RAMPlacement::PREFER_EXTERNAL, RAMPlacement::PREFER_EXTERNAL, RAMPlacement::PREFER_EXTERNAL,
+    RAMPlacement::PREFER_EXTERNAL, RAMPlacement::PREFER_INTERNAL,
+};
+static RAMPlacementStats ram_placement_stats[HEAP_TAG_COUNT];
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Guards the heap statistics against allocations in other tasks, without allocating itself.
+class HeapStatsLock {
+ public:
+#ifdef USE_ESP32
+  HeapStatsLock() { portENTER_CRITICAL_SAFE(&heap_stats_mux); }
+  ~HeapStatsLock() { portEXIT_CRITICAL_SAFE(&heap_stats_mux); }
+#elif defined(USE_HOST)
+  HeapStatsLock() { heap_stats_mutex.lock(); }
+  ~HeapStatsLock() { heap_stats_mutex.unlock(); }
+#else
+ protected:
+  InterruptLock lock_;
+#endif
+};
+
+void set_ram_placement(HeapTag tag, RAMPlacement placement) { ram_placements[static_cast<uint8_t>(tag)] = placement; }
+
+RAMPlacement get_ram_placement(HeapTag tag) { return ram_placements[static_cast<uint8_t>(tag)]; }
+
+RAMPlacementStats get_ram_placement_stats(HeapTag tag) {
+  HeapStatsLock lock;
+  return ram_placement_stats[static_cast<uint8_t>(tag)];
+}
+
+static bool is_external_ram(void *ptr) {
+#ifdef USE_ESP32
+  return esp_ptr_external_ram(ptr);
+#else
+  return false;
+#endif
+}
+
+void *ram_placement_alloc(HeapTag tag, size_t size, bool refuse_internal) {
+  const RAMPlacement placement = refuse_internal ? RAMPlacement::EXTERNAL : get_ram_placement(tag);
+  void *ptr = nullptr;
+#ifdef USE_ESP32
+  if (placement == RAMPlacement::PREFER_INTERNAL)
+    ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (ptr == nullptr)
+    ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#endif
+  if (ptr == nullptr && placement != RAMPlacement::EXTERNAL)
+    ptr = malloc(size);  // NOLINT(cppcoreguidelines-owning-memory,cppcoreguidelines-no-malloc)
+  if (ptr == nullptr)
+    return nullptr;
+  HeapStatsLock lock;
+  RAMPlacementStats &stats = ram_placement_stats[static_cast<uint8_t>(tag)];
+  (is_external_ram(ptr) ? stats.external : stats.internal) += size;
+  return ptr;
+}
+
+void ram_placement_free(HeapTag tag, void *ptr, size_t size) {
+  if (ptr == nullptr)
+    return;
+  {
+    HeapStatsLock lock;
+    RAMPlacementStats &stats = ram_placement_stats[static_cast<uint8_t>(tag)];
+    (is_external_ram(ptr) ? stats.external : stats.internal) -= size;
+  }
+  free(ptr);  // NOLINT(cppcoreguidelines-owning-memory,cppcoreguidelines-no-malloc)
+}
+
+#ifdef USE_HEAP_TRACKING
+
+/// Put in front of every allocation, keeps the returned memory aligned like malloc() does.
+struct alignas(alignof(std::max_align_t)) HeapAllocationHeader {
+  uint32_t size;
+  HeapTag tag;
+};
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+static HeapTagStats heap_tag_stats[HEAP_TAG_COUNT];
+#if defined(USE_ESP32) || defined(USE_HOST)
+// BLE and network callbacks run in their own tasks, each of them keeps its own tag
+static thread_local HeapTag current_heap_tag = HeapTag::OTHER;
+#else
+static HeapTag current_heap_tag = HeapTag::OTHER;
+#endif
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+HeapTagStats get_heap_tag_stats(HeapTag tag) {
+  HeapStatsLock lock;
+  return heap_tag_stats[static_cast<uint8_t>(tag)];
+}
+
+void reset_heap_tag_peaks() {
+  HeapStatsLock lock;
+  for (auto &stats : heap_tag_stats)
+    stats.peak = stats.allocated;
+}
+
+HeapTag set_current_heap_tag(HeapTag tag) {
+  HeapTag previous = current_heap_tag;
+  current_heap_tag = tag;
+  return previous;
+}
+
+static void *heap_tracked_alloc(size_t size) {
+  auto *header = static_cast<HeapAllocationHeader *>(malloc(sizeof(HeapAllocationHeader) + size));  // NOLINT
+  if (header == nullptr)
+    return nullptr;
+  header->size = size;
+  header->tag = current_heap_tag;
+  {
+    HeapStatsLock lock;
+    HeapTagStats &stats = heap_tag_stats[static_cast<uint8_t>(header->tag)];
+    stats.allocated += size;
+    stats.allocations++;
+    stats.peak = std::max(stats.peak, stats.allocated);
+  }
+  return header + 1;
+}
+
+static void heap_tracked_free(void *ptr) {
+  if (ptr == nullptr)
+    return;
+  auto *header = static_cast<HeapAllocationHeader *>(ptr) - 1;
+  {
+    HeapStatsLock lock;
+    HeapTagStats &stats = heap_tag_stats[static_cast<uint8_t>(header->tag)];
+    stats.allocated -= header->size;
+    stats.allocations--;
+  }
+  free(header);  // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+static void *heap_tracked_new(size_t size) {
+  void *ptr = heap_tracked_alloc(size);
+  // Like the operator new of the toolchains, which are built without exceptions
+  if (ptr == nullptr)
+    abort();  // NOLINT(concurrency-mt-unsafe)
+  return ptr;
+}
+
+#endif  // USE_HEAP_TRACKING
+
+}  // namespace esphome
+
+#ifdef USE_HEAP_TRACKING
+
+// The replaceable global allocation functions, the aligned variants keep their default implementation.
+void *operator new(size_t size) { return esphome::heap_tracked_new(size); }
+void *operator new[](size_t size) { return esphome::heap_tracked_new(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return esphome::heap_tracked_alloc(size); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return esphome::heap_tracked_alloc(size); }
+void operator delete(void *ptr) noexcept { esphome::heap_tracked_free(ptr); }
+void operator delete[](void *ptr) noexcept { esphome::heap_tracked_free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { esphome::heap_tracked_free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { esphome::heap_tracked_free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { esphome::heap_tracked_free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { esphome::heap_tracked_free(ptr); }
+
+#endif  // USE_HEAP_TRACKING
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esphome/core/defines.h"
+
+namespace esphome {
+
+/// Subsystems whose heap usage is accounted separately when USE_HEAP_TRACKING is defined.
+enum class HeapTag : uint8_t {
+  OTHER = 0,
+  API,
+  BLE,
+  JSON,
+  DISPLAY,
+  MQTT,
+  LIGHT,
+  AUDIO,
+};
+static const uint8_t HEAP_TAG_COUNT = 8;
+
+const char *heap_tag_to_string(HeapTag tag);
+
+/// Heap usage of one subsystem.
+struct HeapTagStats {
+  /// Bytes currently allocated.
+  uint32_t allocated;
+  /// Most bytes that were allocated at the same time since the last reset.
+  uint32_t peak;
+  /// Number of allocations that weren't freed yet.
+  uint32_t allocations;
+};
+
+/// Free bytes on the internal heap.
+uint32_t get_free_heap();
+/// Size of the largest block that can be allocated from the internal heap, the free heap if the platform can't tell.
+uint32_t get_largest_free_heap_block();
+/** How much the free heap is split up, in percent.
+ *
+ * 0 when all free memory is one contiguous block, approaching 100 the more the largest block falls behind the total
+ * free memory. A value that keeps growing over days points to a fragmentation leak.
+ */
+float get_heap_fragmentation();
+
+#ifdef USE_HEAP_TRACKING
+/** Allocation accounting per subsystem.
+ *
+ * With USE_HEAP_TRACKING defined, the global operator new and delete are replaced with versions that keep a small
+ * header in front of every allocation, holding its size and the tag that was current when it was made. This costs
+ * that header on every allocation, so it is only enabled when something reports the statistics. Memory allocated
+ * with malloc() directly, like the buffers of the network stack, isn't accounted.
+ */
+HeapTagStats get_heap_tag_stats(HeapTag tag);
+/// Start tracking the peak usage of every tag again from its current usage.
+void reset_heap_tag_peaks();
+/// Set the tag for allocations of the calling task, returns the previous one.
+HeapTag set_current_heap_tag(HeapTag tag);
+#endif
+
+/// Where ExternalRAMAllocator puts the buffers of a subsystem.
+enum class RAMPlacement : uint8_t {
+  /// External RAM, internal RAM when it is full or missing.
+  PREFER_EXTERNAL = 0,
+  /// Internal RAM, external RAM when it is full. For hot buffers, read on every loop or by DMA.
+  PREFER_INTERNAL,
+  /// Only external RAM, the allocation fails without it.
+  EXTERNAL,
+};
+
+const char *ram_placement_to_string(RAMPlacement placement);
+
+/// Bytes of the buffers of a subsystem that ExternalRAMAllocator currently has in internal and external RAM.
+struct RAMPlacementStats {
+  uint32_t internal;
+  uint32_t external;
+};
+
+/** The placement policy for the large buffers of the subsystems, set by the psram component.
+ *
+ * Every subsystem prefers external RAM, except audio, whose ring buffers are written from a task and stay internal.
+ */
+void set_ram_placement(HeapTag tag, RAMPlacement placement);
+RAMPlacement get_ram_placement(HeapTag tag);
+RAMPlacementStats get_ram_placement_stats(HeapTag tag);
+/// Allocate size bytes where the policy of tag says, or only in external RAM. Returns nullptr when that fails.
+void *ram_placement_alloc(HeapTag tag, size_t size, bool refuse_internal);
+/// Free memory from ram_placement_alloc(), size and tag as passed to it.
+void ram_placement_free(HeapTag tag, void *ptr, size_t size);
+
+/** Attribute the heap allocations the calling task makes in this scope to a subsystem.
+ *
+ * Scopes nest, the innermost one wins. Does nothing without USE_HEAP_TRACKING.
+ *
+ * \code
+ * void APIServer::loop() {
+ *   HeapTagScope heap_tag(HeapTag::API);
+ *   ...
+ * }
+ * \endcode
+ */
+class HeapTagScope {
+ public:
+#ifdef USE_HEAP_TRACKING
+  explicit HeapTagScope(HeapTag tag) : previous_(set_current_heap_tag(tag)) {}
+  ~HeapTagScope() { set_current_heap_tag(this->previous_); }
+
+ protected:
+  HeapTag previous_;
+#else
+  explicit HeapTagScope(HeapTag tag) {}
+#endif
+};
+
+}  // namespace esphome
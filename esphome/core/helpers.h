@@ -1,13 +1,17 @@
 #pragma once
 
 #include <cmath>
+#include <atomic>
+#include <cstddef>
 #include <cstring>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <vector>
 
+#include "esphome/core/heap.h"
 #include "esphome/core/optional.h"
 
 #ifdef USE_ESP32
@@ -154,8 +158,13 @@ template<typename T, typename U> T remap(U value, U min, U max, T min_out, T max
   return (value - min) * (max_out - min_out) / (max - min) + min_out;
 }
 
-/// Calculate a CRC-8 checksum of \p data with size \p len.
-uint8_t crc8(uint8_t *data, uint8_t len);
+/** Calculate a CRC-8 checksum of \p data with size \p len.
+ *
+ * The default is the Dallas/Maxim CRC of 1-Wire devices. With \p msb_first the bits are shifted in from the most
+ * significant bit, and \p poly is given in that order too, like 0x31 with an initial \p crc of 0xFF for Sensirion.
+ * These two are computed with a lookup table, other polynomials bit by bit.
+ */
+uint8_t crc8(const uint8_t *data, uint8_t len, uint8_t crc = 0x00, uint8_t poly = 0x8C, bool msb_first = false);
 
 /// Calculate a CRC-16 checksum of \p data with size \p len.
 uint16_t crc16(const uint8_t *data, uint16_t len, uint16_t crc = 0xffff, uint16_t reverse_poly = 0xa001,
@@ -166,6 +175,11 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc = 0, uint16_t p
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
 
+/// Calculate a FNV-1 hash of \p str at compile time, giving the same result as fnv1_hash().
+constexpr uint32_t fnv1_hash_constexpr(const char *str, uint32_t hash = 2166136261UL) {
+  return *str == '\0' ? hash : fnv1_hash_constexpr(str + 1, (hash * 16777619UL) ^ *str);
+}
+
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
 /// Return a random float between 0 and 1.
@@ -465,6 +479,110 @@ constexpr float fahrenheit_to_celsius(float value) { return (value - 32.0f) / 1.
 /// @name Utilities
 /// @{
 
+/** A void callable stored in place: a function pointer to call it plus a small buffer holding the callable itself.
+ *
+ * Callables up to the size of a std::function are kept in the buffer. Trivially copyable ones, like lambdas capturing
+ * `this` and a few pointers, are called through a single function pointer and copied with memcpy. Larger callables
+ * are moved to the heap once.
+ */
+template<typename... Ts> class InlineCallback {
+ public:
+  template<typename F, enable_if_t<!std::is_same<typename std::decay<F>::type, InlineCallback>::value, int> = 0>
+  InlineCallback(F &&f) {  // NOLINT
+    this->init_<typename std::decay<F>::type>(std::forward<F>(f));
+  }
+  InlineCallback(const InlineCallback &other) : invoke_(other.invoke_), manage_(other.manage_) {
+    if (this->manage_ == nullptr) {
+      memcpy(this->storage_, other.storage_, sizeof(this->storage_));
+    } else {
+      this->manage_(MANAGE_COPY, this->storage_, const_cast<uint8_t *>(other.storage_));
+    }
+  }
+  InlineCallback(InlineCallback &&other) noexcept : invoke_(other.invoke_), manage_(other.manage_) {
+    if (this->manage_ == nullptr) {
+      memcpy(this->storage_, other.storage_, sizeof(this->storage_));
+    } else {
+      this->manage_(MANAGE_MOVE, this->storage_, other.storage_);
+    }
+  }
+  InlineCallback &operator=(const InlineCallback &other) {
+    if (this != &other) {
+      this->~InlineCallback();
+      new (this) InlineCallback(other);
+    }
+    return *this;
+  }
+  InlineCallback &operator=(InlineCallback &&other) noexcept {
+    if (this != &other) {
+      this->~InlineCallback();
+      new (this) InlineCallback(std::move(other));
+    }
+    return *this;
+  }
+  ~InlineCallback() {
+    if (this->manage_ != nullptr)
+      this->manage_(MANAGE_DESTROY, this->storage_, nullptr);
+  }
+
+  void operator()(Ts... args) { this->invoke_(this->storage_, args...); }
+
+ protected:
+  enum ManageOp : uint8_t { MANAGE_COPY, MANAGE_MOVE, MANAGE_DESTROY };
+  static constexpr size_t STORAGE_SIZE = sizeof(std::function<void(Ts...)>);
+
+  template<typename F>
+  using fits_inline = std::integral_constant<bool, sizeof(F) <= STORAGE_SIZE && alignof(F) <= alignof(void *)>;
+
+  // trivially copyable and small: stored in place without a manager
+  template<typename F, enable_if_t<fits_inline<F>::value && std::is_trivially_copyable<F>::value, int> = 0>
+  void init_(F f) {
+    new (this->storage_) F(f);
+    this->invoke_ = [](uint8_t *storage, Ts... args) { (*reinterpret_cast<F *>(storage))(args...); };
+  }
+  // small but needs its copy constructor and destructor run, such as a std::function
+  template<typename F, enable_if_t<fits_inline<F>::value && !std::is_trivially_copyable<F>::value, int> = 0>
+  void init_(F f) {
+    new (this->storage_) F(std::move(f));
+    this->invoke_ = [](uint8_t *storage, Ts... args) { (*reinterpret_cast<F *>(storage))(args...); };
+    this->manage_ = [](ManageOp op, uint8_t *dst, uint8_t *src) {
+      switch (op) {
+        case MANAGE_COPY:
+          new (dst) F(*reinterpret_cast<const F *>(src));
+          break;
+        case MANAGE_MOVE:
+          new (dst) F(std::move(*reinterpret_cast<F *>(src)));
+          break;
+        case MANAGE_DESTROY:
+          reinterpret_cast<F *>(dst)->~F();
+          break;
+      }
+    };
+  }
+  // too large: the buffer holds a pointer to a heap allocated copy
+  template<typename F, enable_if_t<!fits_inline<F>::value, int> = 0> void init_(F f) {
+    *reinterpret_cast<F **>(this->storage_) = new F(std::move(f));  // NOLINT(cppcoreguidelines-owning-memory)
+    this->invoke_ = [](uint8_t *storage, Ts... args) { (**reinterpret_cast<F **>(storage))(args...); };
+    this->manage_ = [](ManageOp op, uint8_t *dst, uint8_t *src) {
+      switch (op) {
+        case MANAGE_COPY:
+          *reinterpret_cast<F **>(dst) = new F(**reinterpret_cast<F **>(src));  // NOLINT
+          break;
+        case MANAGE_MOVE:
+          *reinterpret_cast<F **>(dst) = *reinterpret_cast<F **>(src);
+          *reinterpret_cast<F **>(src) = nullptr;
+          break;
+        case MANAGE_DESTROY:
+          delete *reinterpret_cast<F **>(dst);  // NOLINT(cppcoreguidelines-owning-memory)
+          break;
+      }
+    };
+  }
+
+  alignas(void *) uint8_t storage_[STORAGE_SIZE];
+  void (*invoke_)(uint8_t *storage, Ts... args){nullptr};
+  void (*manage_)(ManageOp op, uint8_t *dst, uint8_t *src){nullptr};
+};
+
 template<typename... X> class CallbackManager;
 
 /** Helper class to allow having multiple subscribers to a callback.
@@ -473,8 +591,8 @@ template<typename... X> class CallbackManager;
  */
 template<typename... Ts> class CallbackManager<void(Ts...)> {
  public:
-  /// Add a callback to the list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  /// Add a callback to the list. Pass lambdas directly instead of wrapping them in a std::function first.
+  template<typename F> void add(F &&callback) { this->callbacks_.emplace_back(std::forward<F>(callback)); }
 
   /// Call all callbacks in this manager.
   void call(Ts... args) {
@@ -487,7 +605,7 @@ template<typename... Ts> class CallbackManager<void(Ts...)> {
   void operator()(Ts... args) { call(args...); }
 
  protected:
-  std::vector<std::function<void(Ts...)>> callbacks_;
+  std::vector<InlineCallback<Ts...>> callbacks_;
 };
 
 /// Helper class to deduplicate items in a series of values.
@@ -526,6 +644,157 @@ template<typename T> class Parented {
   T *parent_{nullptr};
 };
 
+/** First-in first-out buffer with a fixed capacity.
+ *
+ * All storage is allocated once when the capacity is set, unlike std::deque which allocates large chunks as it grows.
+ * Pushing to a full buffer discards the oldest element. Pass ExternalRAMAllocator<T> to place the storage in SPI RAM.
+ */
+template<typename T, class Allocator = std::allocator<T>> class RingBuffer {
+ public:
+  class const_iterator {  // NOLINT(readability-identifier-naming)
+   public:
+    const_iterator(const RingBuffer *buffer, size_t index) : buffer_(buffer), index_(index) {}
+    const T &operator*() const { return (*this->buffer_)[this->index_]; }
+    const_iterator &operator++() {
+      this->index_++;
+      return *this;
+    }
+    bool operator!=(const const_iterator &other) const { return this->index_ != other.index_; }
+
+   protected:
+    const RingBuffer *buffer_;
+    size_t index_;
+  };
+
+  explicit RingBuffer(size_t capacity = 0, const Allocator &allocator = Allocator()) : allocator_(allocator) {
+    this->set_capacity(capacity);
+  }
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer &operator=(const RingBuffer &) = delete;
+  ~RingBuffer() { this->free_(); }
+
+  size_t size() const { return this->size_; }
+  size_t capacity() const { return this->capacity_; }
+  bool empty() const { return this->size_ == 0; }
+  bool full() const { return this->size_ == this->capacity_; }
+
+  /// Element \p i, counting from the oldest one.
+  T &operator[](size_t i) { return this->data_[this->index_(i)]; }
+  const T &operator[](size_t i) const { return this->data_[this->index_(i)]; }
+  T &front() { return (*this)[0]; }
+  const T &front() const { return (*this)[0]; }
+  T &back() { return (*this)[this->size_ - 1]; }
+  const T &back() const { return (*this)[this->size_ - 1]; }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, this->size_); }
+
+  /// Append \p value, discarding the oldest element if the buffer is full.
+  void push_back(const T &value) {
+    if (this->capacity_ == 0)
+      return;
+    if (this->full())
+      this->pop_front();
+    this->data_[this->index_(this->size_)] = value;
+    this->size_++;
+  }
+  void pop_front() {
+    this->head_ = this->index_(1);
+    this->size_--;
+  }
+  void pop_back() { this->size_--; }
+  void clear() {
+    this->head_ = 0;
+    this->size_ = 0;
+  }
+
+  /// Change the capacity, keeping the newest elements that still fit.
+  void set_capacity(size_t capacity) {
+    if (capacity == this->capacity_)
+      return;
+    T *data = nullptr;
+    if (capacity > 0) {
+      data = this->allocator_.allocate(capacity);
+      for (size_t i = 0; i < capacity; i++)
+        std::allocator_traits<Allocator>::construct(this->allocator_, data + i);
+    }
+    size_t keep = this->size_ < capacity ? this->size_ : capacity;
+    for (size_t i = 0; i < keep; i++)
+      data[i] = (*this)[this->size_ - keep + i];
+    this->free_();
+    this->data_ = data;
+    this->capacity_ = capacity;
+    this->head_ = 0;
+    this->size_ = keep;
+  }
+
+ protected:
+  size_t index_(size_t i) const {
+    size_t index = this->head_ + i;
+    return index >= this->capacity_ ? index - this->capacity_ : index;
+  }
+  void free_() {
+    if (this->data_ == nullptr)
+      return;
+    for (size_t i = 0; i < this->capacity_; i++)
+      std::allocator_traits<Allocator>::destroy(this->allocator_, this->data_ + i);
+    this->allocator_.deallocate(this->data_, this->capacity_);
+    this->data_ = nullptr;
+  }
+
+  Allocator allocator_;
+  T *data_{nullptr};
+  size_t capacity_{0};
+  size_t head_{0};
+  size_t size_{0};
+};
+
+/** Lock-free first-in first-out queue for passing data from an interrupt handler to the main loop.
+ *
+ * Exactly one producer (usually an ISR) may call push() and exactly one consumer (usually loop()) may call pop(), so
+ * neither side ever needs to disable interrupts. The storage is part of the object and \p N must be a power of two.
+ * Elements pushed while the queue is full are discarded and counted in get_dropped().
+ */
+template<typename T, size_t N> class LockFreeQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "LockFreeQueue size must be a power of two");
+
+ public:
+  /// Append \p value, returns false if the queue is full. Only call this from the producer.
+  inline bool push(const T &value) ALWAYS_INLINE {
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (head - this->tail_.load(std::memory_order_acquire) >= N) {
+      this->dropped_.store(this->dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+    this->data_[head & (N - 1)] = value;
+    this->head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+  /// Remove the oldest element and store it in \p value, returns false if the queue is empty. Only call this from the
+  /// consumer.
+  bool pop(T &value) {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (this->head_.load(std::memory_order_acquire) == tail)
+      return false;
+    value = this->data_[tail & (N - 1)];
+    this->tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const {
+    return this->head_.load(std::memory_order_acquire) - this->tail_.load(std::memory_order_relaxed);
+  }
+  bool empty() const { return this->size() == 0; }
+  static constexpr size_t capacity() { return N; }
+  /// Total number of elements discarded because the queue was full. The counter wraps around and is never reset.
+  uint32_t get_dropped() const { return this->dropped_.load(std::memory_order_relaxed); }
+
+ protected:
+  T data_[N]{};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
 /// @}
 
 /// @name System APIs
@@ -654,27 +923,27 @@ template<class T> class ExternalRAMAllocator {
 
   ExternalRAMAllocator() = default;
   ExternalRAMAllocator(Flags flags) : flags_{flags} {}
-  template<class U> constexpr ExternalRAMAllocator(const ExternalRAMAllocator<U> &other) : flags_{other.flags_} {}
+  /// Allocate where the RAM placement policy of the subsystem says, see set_ram_placement().
+  ExternalRAMAllocator(HeapTag tag, Flags flags = Flags::NONE) : flags_{flags}, tag_{tag} {}
+  template<class U>
+  constexpr ExternalRAMAllocator(const ExternalRAMAllocator<U> &other)
+      : flags_{static_cast<Flags>(other.flags_)}, tag_{other.tag_} {}
 
   T *allocate(size_t n) {
-    size_t size = n * sizeof(T);
-    T *ptr = nullptr;
-#ifdef USE_ESP32
-    ptr = static_cast<T *>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
-#endif
-    if (ptr == nullptr && (this->flags_ & Flags::REFUSE_INTERNAL) == 0)
-      ptr = static_cast<T *>(malloc(size));  // NOLINT(cppcoreguidelines-owning-memory,cppcoreguidelines-no-malloc)
+    T *ptr =
+        static_cast<T *>(ram_placement_alloc(this->tag_, n * sizeof(T), (this->flags_ & Flags::REFUSE_INTERNAL) != 0));
     if (ptr == nullptr && (this->flags_ & Flags::ALLOW_FAILURE) == 0)
       abort();
     return ptr;
   }
 
-  void deallocate(T *p, size_t n) {
-    free(p);  // NOLINT(cppcoreguidelines-owning-memory,cppcoreguidelines-no-malloc)
-  }
+  void deallocate(T *p, size_t n) { ram_placement_free(this->tag_, p, n * sizeof(T)); }
 
  private:
+  template<class U> friend class ExternalRAMAllocator;
+
   Flags flags_{Flags::NONE};
+  HeapTag tag_{HeapTag::OTHER};
 };
 
 /// @}
@@ -0,0 +1,105 @@
+#include "esphome/core/hires_interval.h"
+
+#ifdef USE_HIRES_INTERVAL
+
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+
+static const char *const TAG = "hires_interval";
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+static HighResolutionInterval *main_loop_intervals = nullptr;
+/// Set by the esp_timer task when a main loop interval became due, so the main loop can skip the walk otherwise.
+static std::atomic<bool> main_loop_pending{false};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+HighResolutionInterval::HighResolutionInterval(std::function<void()> &&callback, Dispatch dispatch)
+    : callback_(std::move(callback)), dispatch_(dispatch) {
+  if (dispatch == DISPATCH_MAIN_LOOP) {
+    this->next_ = main_loop_intervals;
+    main_loop_intervals = this;
+  }
+}
+
+HighResolutionInterval::~HighResolutionInterval() {
+  this->stop();
+  if (this->timer_ != nullptr)
+    esp_timer_delete(this->timer_);
+  for (HighResolutionInterval **it = &main_loop_intervals; *it != nullptr; it = &(*it)->next_) {
+    if (*it == this) {
+      *it = this->next_;
+      break;
+    }
+  }
+}
+
+bool HighResolutionInterval::start(uint64_t period_us) {
+  if (this->timer_ == nullptr) {
+    esp_timer_create_args_t args{};
+    args.callback = &HighResolutionInterval::timer_callback_;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "hires_interval";
+    esp_err_t err = esp_timer_create(&args, &this->timer_);
+    if (err != ESP_OK) {
+      ESP_LOGE(TAG, "Could not create the timer: %s", esp_err_to_name(err));
+      this->timer_ = nullptr;
+      return false;
+    }
+  }
+  this->stop();
+  this->ticks_.store(0, std::memory_order_relaxed);
+  this->handled_ticks_ = 0;
+  this->missed_ = 0;
+  // A periodic esp_timer sets each alarm to the previous alarm plus the period, which is the phase lock
+  this->start_us_ = esp_timer_get_time();
+  esp_err_t err = esp_timer_start_periodic(this->timer_, period_us);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Could not start the timer: %s", esp_err_to_name(err));
+    return false;
+  }
+  this->period_us_ = period_us;
+  return true;
+}
+
+void HighResolutionInterval::stop() {
+  if (this->period_us_ == 0)
+    return;
+  esp_timer_stop(this->timer_);
+  this->period_us_ = 0;
+}
+
+void HighResolutionInterval::timer_callback_(void *arg) {
+  auto *interval = static_cast<HighResolutionInterval *>(arg);
+  const uint32_t ticks = interval->ticks_.fetch_add(1, std::memory_order_release) + 1;
+  if (interval->dispatch_ == DISPATCH_TIMER_TASK) {
+    interval->deadline_us_ = interval->start_us_ + int64_t(ticks) * int64_t(interval->period_us_);
+    interval->handled_ticks_ = ticks;
+    interval->callback_();
+    return;
+  }
+  main_loop_pending.store(true, std::memory_order_release);
+  App.wake_loop_any_context();
+}
+
+void HighResolutionInterval::process_pending() {
+  if (!main_loop_pending.exchange(false, std::memory_order_acquire))
+    return;
+  for (HighResolutionInterval *interval = main_loop_intervals; interval != nullptr; interval = interval->next_) {
+    if (interval->period_us_ == 0)
+      continue;
+    const uint32_t ticks = interval->ticks_.load(std::memory_order_acquire);
+    if (ticks == interval->handled_ticks_)
+      continue;
+    interval->missed_ += ticks - interval->handled_ticks_ - 1;
+    interval->handled_ticks_ = ticks;
+    interval->deadline_us_ = interval->start_us_ + int64_t(ticks) * int64_t(interval->period_us_);
+    interval->callback_();
+  }
+}
+
+}  // namespace esphome
+
+#endif  // USE_HIRES_INTERVAL
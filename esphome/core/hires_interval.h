@@ -0,0 +1,77 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_HIRES_INTERVAL
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include <esp_timer.h>
+
+namespace esphome {
+
+/** An interval in microseconds driven by an esp_timer instead of the Scheduler.
+ *
+ * The Scheduler works in milliseconds and sets the next run of an interval relative to when the previous one actually
+ * ran, so its intervals drift and jitter by whole loop iterations. This interval is phase locked: every deadline is the
+ * previous deadline plus the period, so however late a single run is, the runs don't drift over time.
+ *
+ * The callback runs either on the main loop, which wakes up for it but can still be held up by other components, or
+ * straight from the esp_timer task, which is on time to a few microseconds but runs concurrently with the main loop.
+ * A callback on the esp_timer task has to be short and must not touch anything the main loop uses without a lock.
+ *
+ * When the main loop doesn't get to the callback before the next deadline, the deadlines in between are skipped and
+ * counted as missed, get_deadline() tells the callback which deadline it runs for.
+ */
+class HighResolutionInterval {
+ public:
+  enum Dispatch : uint8_t {
+    /// Run the callback on the main loop.
+    DISPATCH_MAIN_LOOP,
+    /// Run the callback on the esp_timer task.
+    DISPATCH_TIMER_TASK,
+  };
+
+  explicit HighResolutionInterval(std::function<void()> &&callback, Dispatch dispatch = DISPATCH_MAIN_LOOP);
+  ~HighResolutionInterval();
+  HighResolutionInterval(const HighResolutionInterval &) = delete;
+  HighResolutionInterval &operator=(const HighResolutionInterval &) = delete;
+
+  /// Start, or restart with another period. The first deadline is one period from now. Returns false on failure.
+  bool start(uint64_t period_us);
+  void stop();
+  bool is_running() const { return this->period_us_ != 0; }
+  uint64_t get_period() const { return this->period_us_; }
+
+  /// The esp_timer time in microseconds of the deadline the callback is running for.
+  int64_t get_deadline() const { return this->deadline_us_; }
+  /// Deadlines skipped because the main loop was still busy when the next one came.
+  uint32_t get_missed() const { return this->missed_; }
+
+  /// Run the callbacks of the main loop intervals that are due, called by Application::loop().
+  static void process_pending();
+
+ protected:
+  static void timer_callback_(void *arg);
+
+  std::function<void()> callback_;
+  Dispatch dispatch_;
+  esp_timer_handle_t timer_{nullptr};
+  uint64_t period_us_{0};
+  /// esp_timer time the timer was started at, the deadlines are counted from it.
+  int64_t start_us_{0};
+  int64_t deadline_us_{0};
+  /// Deadlines that passed since start(), counted on the esp_timer task.
+  std::atomic<uint32_t> ticks_{0};
+  /// Deadlines the callback was run or skipped for.
+  uint32_t handled_ticks_{0};
+  uint32_t missed_{0};
+  /// Intervals dispatched to the main loop, linked so process_pending() doesn't need an allocation.
+  HighResolutionInterval *next_{nullptr};
+};
+
+}  // namespace esphome
+
+#endif  // USE_HIRES_INTERVAL
@@ -0,0 +1,59 @@
+#include "esphome/core/preference_saver.h"
+
+#include <algorithm>
+
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+PreferenceSaver global_preference_saver;
+
+void PreferenceSaver::save(ESPPreferenceObject *pref, const uint8_t *data, size_t len) {
+  const uint32_t now = millis();
+  auto it = std::find_if(this->pending_.begin(), this->pending_.end(),
+                         [pref](const PendingSave &pending) { return pending.pref == pref; });
+  if (it == this->pending_.end()) {
+    this->pending_.push_back(PendingSave{pref, now, now, {}});
+    it = this->pending_.end() - 1;
+  }
+  it->last_change = now;
+  it->data.assign(data, data + len);
+
+  if (!this->scheduled_)
+    this->schedule_(this->settle_time_);
+}
+
+void PreferenceSaver::flush() {
+  for (auto &pending : this->pending_)
+    pending.pref->save(pending.data.data(), pending.data.size());
+  this->pending_.clear();
+}
+
+void PreferenceSaver::write_settled_() {
+  this->scheduled_ = false;
+  const uint32_t now = millis();
+  uint32_t next_check = UINT32_MAX;
+  auto it = this->pending_.begin();
+  while (it != this->pending_.end()) {
+    const uint32_t settled_at = it->last_change + this->settle_time_;
+    const uint32_t deadline = it->first_change + this->max_delay_;
+    if (static_cast<int32_t>(now - settled_at) >= 0 || static_cast<int32_t>(now - deadline) >= 0) {
+      it->pref->save(it->data.data(), it->data.size());
+      it = this->pending_.erase(it);
+      continue;
+    }
+    next_check = std::min(next_check, std::min(settled_at - now, deadline - now));
+    ++it;
+  }
+  if (!this->pending_.empty())
+    this->schedule_(next_check);
+}
+
+void PreferenceSaver::schedule_(uint32_t delay) {
+  this->scheduled_ = true;
+  App.scheduler.set_timeout(nullptr, "preference_saver", delay, [this]() { this->write_settled_(); });
+}
+
+}  // namespace esphome
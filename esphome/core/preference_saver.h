@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+
+/** Writes the restore state of entities once it stopped changing.
+ *
+ * Entities like lights, fans and climate devices save their state whenever it changes, which happens dozens of times
+ * per second while a slider is dragged in the frontend. Saves passed to this class are kept in RAM and only written to
+ * the preference object once there was no new save for the same object for the settle time, or at the latest after the
+ * maximum delay if the state keeps changing. Pending saves are written when the device shuts down.
+ */
+class PreferenceSaver {
+ public:
+  /// Save the data to pref once it settled, replacing a pending save for the same preference object.
+  template<typename T> void save(ESPPreferenceObject *pref, const T *src) {
+    this->save(pref, reinterpret_cast<const uint8_t *>(src), sizeof(T));
+  }
+  void save(ESPPreferenceObject *pref, const uint8_t *data, size_t len);
+
+  /// Write all pending saves now.
+  void flush();
+
+  void set_settle_time(uint32_t settle_time) { this->settle_time_ = settle_time; }
+  void set_max_delay(uint32_t max_delay) { this->max_delay_ = max_delay; }
+
+ protected:
+  struct PendingSave {
+    ESPPreferenceObject *pref;
+    uint32_t first_change;
+    uint32_t last_change;
+    std::vector<uint8_t> data;
+  };
+
+  /// Write the saves that are due and schedule the next check.
+  void write_settled_();
+  void schedule_(uint32_t delay);
+
+  std::vector<PendingSave> pending_;
+  uint32_t settle_time_{1000};
+  uint32_t max_delay_{10000};
+  bool scheduled_{false};
+};
+
+extern PreferenceSaver global_preference_saver;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace esphome
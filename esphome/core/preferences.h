@@ -24,6 +24,12 @@ class ESPPreferenceObject {
     return backend_->save(reinterpret_cast<const uint8_t *>(src), sizeof(T));
   }
 
+  bool save(const uint8_t *data, size_t len) {
+    if (backend_ == nullptr)
+      return false;
+    return backend_->save(data, len);
+  }
+
   template<typename T> bool load(T *dest) {
     if (backend_ == nullptr)
       return false;
@@ -1,82 +1,145 @@
 #include "scheduler.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/trace.h"
 #include <algorithm>
 #include <cinttypes>
 
+#ifdef USE_RUNTIME_STATS
+#include "esphome/components/runtime_stats/runtime_stats.h"
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "scheduler";
-
-static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+static const std::string EMPTY_NAME;  // NOLINT(cert-err58-cpp)
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
-// A note on locking: the `lock_` lock protects the `items_` and `to_add_` containers. It must be taken when writing to
-// them (i.e. when adding/removing items, but not when changing items). As items are only deleted from the loop task,
-// iterating over them from the loop task is fine; but iterating from any other context requires the lock to be held to
-// avoid the main thread modifying the list while it is being accessed.
-
-void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
-                                std::function<void()> func) {
-  const uint32_t now = this->millis_();
-
-  if (!name.empty())
-    this->cancel_timeout(component, name);
-
-  if (timeout == SCHEDULER_DONT_RUN)
-    return;
+// A note on locking: the `lock_` lock protects the `items_`, `to_add_` and `slots_` containers as well as `running_`.
+// Cancelling removes an item from the heap right away, which can happen from any context, so the lock must be held
+// whenever these containers are read or written. Callbacks are always invoked without the lock held.
 
+SchedulerHandle HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
+                                           std::function<void()> func) {
   ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
-
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
-  item->timeout = timeout;
-  item->last_execution = now;
-  item->last_execution_major = this->millis_major_;
-  item->callback = std::move(func);
-  item->remove = false;
-  this->push_(std::move(item));
+  return this->set_item_(component, name, 0, SchedulerItem::TIMEOUT, timeout, std::move(func));
+}
+SchedulerHandle HOT Scheduler::set_timeout(Component *component, uint32_t id, uint32_t timeout,
+                                           std::function<void()> func) {
+  ESP_LOGVV(TAG, "set_timeout(id=0x%08" PRIX32 ", timeout=%" PRIu32 ")", id, timeout);
+  return this->set_item_(component, EMPTY_NAME, id, SchedulerItem::TIMEOUT, timeout, std::move(func));
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+  return this->cancel_item_(component, name, 0, SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, uint32_t id) {
+  return this->cancel_item_(component, EMPTY_NAME, id, SchedulerItem::TIMEOUT);
+}
+SchedulerHandle HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+                                            std::function<void()> func) {
+  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ")", name.c_str(), interval);
+  return this->set_item_(component, name, 0, SchedulerItem::INTERVAL, interval, std::move(func));
+}
+SchedulerHandle HOT Scheduler::set_interval(Component *component, uint32_t id, uint32_t interval,
+                                            std::function<void()> func) {
+  ESP_LOGVV(TAG, "set_interval(id=0x%08" PRIX32 ", interval=%" PRIu32 ")", id, interval);
+  return this->set_item_(component, EMPTY_NAME, id, SchedulerItem::INTERVAL, interval, std::move(func));
+}
+#ifdef USE_STAGGERED_POLLING
+SchedulerHandle Scheduler::set_staggered_interval(Component *component, const std::string &name, uint32_t interval,
+                                                  std::function<void()> func) {
+  uint32_t phase = 0;
+  if (interval != 0 && interval != SCHEDULER_DONT_RUN) {
+    auto it = std::find_if(this->staggered_counts_.begin(), this->staggered_counts_.end(),
+                           [interval](const std::pair<uint32_t, uint32_t> &count) { return count.first == interval; });
+    if (it == this->staggered_counts_.end())
+      it = this->staggered_counts_.insert(it, {interval, 0});
+    // Multiples of the golden ratio keep any number of phases evenly spread, without knowing how many there will be
+    const uint32_t fraction = it->second * 2654435769UL;
+    phase = (uint64_t(fraction) * interval) >> 32;
+    it->second++;
+  }
+  ESP_LOGVV(TAG, "set_staggered_interval(name='%s', interval=%" PRIu32 ", phase=%" PRIu32 ")", name.c_str(),
+            interval, phase);
+  return this->set_item_(component, name, 0, SchedulerItem::INTERVAL, interval, std::move(func), phase);
+}
+#endif
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name, 0, SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel_interval(Component *component, uint32_t id) {
+  return this->cancel_item_(component, EMPTY_NAME, id, SchedulerItem::INTERVAL);
 }
-void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
-                                 std::function<void()> func) {
+SchedulerHandle HOT Scheduler::set_item_(Component *component, const std::string &name, uint32_t id,
+                                         SchedulerItem::Type type, uint32_t delay, std::function<void()> func,
+                                         uint32_t phase) {
   const uint32_t now = this->millis_();
+  const bool has_key = id != 0 || !name.empty();
 
-  if (!name.empty())
-    this->cancel_interval(component, name);
-
-  if (interval == SCHEDULER_DONT_RUN)
-    return;
-
-  // only put offset in lower half
-  uint32_t offset = 0;
-  if (interval != 0)
-    offset = (random_uint32() % interval) / 2;
-
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
+  LockGuard guard{this->lock_};
+  // An existing item with the same key is re-armed in place, which saves allocating a new item (and name)
+  SchedulerItem *reuse = nullptr;
+  if (has_key)
+    this->cancel_items_locked_(component, name, id, type, delay == SCHEDULER_DONT_RUN ? nullptr : &reuse);
+
+  if (delay == SCHEDULER_DONT_RUN)
+    return SCHEDULER_INVALID_HANDLE;
+
+  std::unique_ptr<SchedulerItem> new_item;
+  SchedulerItem *item = reuse;
+  if (item == nullptr) {
+    new_item = this->make_item_(component, name, id);
+    if (new_item == nullptr)
+      return SCHEDULER_INVALID_HANDLE;
+    item = new_item.get();
+  } else {
+    // Invalidate handles to the previous schedule
+    this->rotate_handle_(item);
+  }
 
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
-  item->interval = interval;
-  item->last_execution = now - offset - interval;
+  item->type = type;
+  item->interval = delay;
+#ifdef USE_LOOP_BUDGET
+  item->deferred = false;
+#endif
   item->last_execution_major = this->millis_major_;
-  if (item->last_execution > now)
-    item->last_execution_major--;
+  if (type == SchedulerItem::TIMEOUT) {
+    item->last_execution = now;
+  } else if (phase != RANDOM_PHASE) {
+    // first execution after phase
+    item->last_execution = now - (delay - phase);
+    if (item->last_execution > now)
+      item->last_execution_major--;
+  } else {
+    // only put offset in lower half
+    uint32_t offset = 0;
+    if (delay != 0)
+      offset = (random_uint32() % delay) / 2;
+    item->last_execution = now - offset - delay;
+    if (item->last_execution > now)
+      item->last_execution_major--;
+  }
   item->callback = std::move(func);
-  item->remove = false;
-  this->push_(std::move(item));
+
+  if (new_item != nullptr) {
+    this->to_add_.push_back(std::move(new_item));
+  } else if (item->heap_index != NOT_IN_HEAP) {
+    // The deadline changed in either direction
+    this->sift_up_(item->heap_index);
+    this->sift_down_(item->heap_index);
+  }
+  return item->handle;
 }
-bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
-  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+bool HOT Scheduler::cancel(SchedulerHandle handle) {
+  LockGuard guard{this->lock_};
+  SchedulerItem *item = this->find_item_(handle);
+  if (item == nullptr)
+    return false;
+  return this->cancel_item_locked_(item);
 }
 
 struct RetryArgs {
@@ -135,6 +198,7 @@ bool HOT Scheduler::cancel_retry(Component *component, const std::string &name)
 }
 
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  LockGuard guard{this->lock_};
   if (this->empty_())
     return {};
   auto &item = this->items_[0];
@@ -153,117 +217,99 @@ void HOT Scheduler::call() {
 
   if (now - last_print > 2000) {
     last_print = now;
-    std::vector<std::unique_ptr<SchedulerItem>> old_items;
-    ESP_LOGVV(TAG, "Items: count=%u, now=%" PRIu32, this->items_.size(), now);
-    while (!this->empty_()) {
-      this->lock_.lock();
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      this->lock_.unlock();
-
+    LockGuard guard{this->lock_};
+    ESP_LOGVV(TAG, "Items: count=%u, slots=%u, now=%" PRIu32, this->items_.size(), this->slots_.size(), now);
+    for (auto &item : this->items_) {
       ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
                 item->get_type_str(), item->name.c_str(), item->interval, item->last_execution,
                 item->last_execution_major, item->next_execution(), item->next_execution_major());
-
-      old_items.push_back(std::move(item));
     }
     ESP_LOGVV(TAG, "\n");
-
-    {
-      LockGuard guard{this->lock_};
-      this->items_ = std::move(old_items);
-    }
   }
 #endif  // ESPHOME_DEBUG_SCHEDULER
 
-  auto to_remove_was = to_remove_;
-  auto items_was = this->items_.size();
-  // If we have too many items to remove
-  if (to_remove_ > MAX_LOGICALLY_DELETED_ITEMS) {
-    std::vector<std::unique_ptr<SchedulerItem>> valid_items;
-    while (!this->empty_()) {
-      LockGuard guard{this->lock_};
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
-      valid_items.push_back(std::move(item));
-    }
-
+  while (true) {
+    std::unique_ptr<SchedulerItem> item;
     {
       LockGuard guard{this->lock_};
-      this->items_ = std::move(valid_items);
-    }
-
-    // The following should not happen unless I'm missing something
-    if (to_remove_ != 0) {
-      ESP_LOGW(TAG, "to_remove_ was %" PRIu32 " now: %" PRIu32 " items where %zu now %zu. Please report this",
-               to_remove_was, to_remove_, items_was, items_.size());
-      to_remove_ = 0;
-    }
-  }
+      if (this->empty_())
+        break;
 
-  while (!this->empty_()) {
-    // use scoping to indicate visibility of `item` variable
-    {
-      // Don't copy-by value yet
-      auto &item = this->items_[0];
-      if ((now - item->last_execution) < item->interval) {
+      auto &top = this->items_[0];
+      if ((now - top->last_execution) < top->interval) {
         // Not reached timeout yet, done for this call
         break;
       }
-      uint8_t major = item->next_execution_major();
+      uint8_t major = top->next_execution_major();
       if (this->millis_major_ - major > 1)
         break;
 
+      item = this->pop_raw_();
+
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
-        LockGuard guard{this->lock_};
-        this->pop_raw_();
+        this->release_item_(std::move(item));
         continue;
       }
 
-#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
-      ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+#ifdef USE_LOOP_BUDGET
+      if (!item->deferred && item->component != nullptr && item->component->is_deferrable() &&
+          App.is_loop_budget_exceeded()) {
+        // Still due, so it runs in the next call()
+        item->deferred = true;
+#ifdef USE_RUNTIME_STATS
+        runtime_stats::global_runtime_stats->record_deferred(item->component);
 #endif
-
-      // Warning: During callback(), a lot of stuff can happen, including:
-      //  - timeouts/intervals get added, potentially invalidating vector pointers
-      //  - timeouts/intervals get cancelled
-      {
-        WarnIfComponentBlockingGuard guard{item->component};
-        item->callback();
+        this->to_add_.push_back(std::move(item));
+        continue;
       }
-    }
+      item->deferred = false;
+#endif
 
-    {
-      this->lock_.lock();
+      // The item stays reachable through its handle while it runs, so it can still be cancelled by the callback.
+      this->running_ = item.get();
+    }
 
-      // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
+#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+    ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
+              item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+#endif
 
-      // Only pop after function call, this ensures we were reachable
-      // during the function call and know if we were cancelled.
-      this->pop_raw_();
+    // Warning: During callback(), a lot of stuff can happen, including:
+    //  - timeouts/intervals get added
+    //  - timeouts/intervals get cancelled, including this one
+    {
+      WarnIfComponentBlockingGuard guard{item->component};
+      ESPHOME_TRACE_SCOPE(trace::TRACE_CATEGORY_SCHEDULER,
+                          item->component == nullptr ? "<null>" : item->component->get_component_source(), item->id);
+#ifdef USE_RUNTIME_STATS
+      const uint32_t started_us = micros();
+      item->callback();
+      runtime_stats::global_runtime_stats->record_scheduled(item->component, item->name, item->id,
+                                                            micros() - started_us);
+#else
+      item->callback();
+#endif
+    }
 
-      this->lock_.unlock();
+    LockGuard guard{this->lock_};
+    this->running_ = nullptr;
 
-      if (item->remove) {
-        // We were removed/cancelled in the function call, stop
-        to_remove_--;
-        continue;
-      }
+    if (item->remove || item->type == SchedulerItem::TIMEOUT) {
+      // Timeouts only run once; intervals that were cancelled in the function call stop here
+      this->release_item_(std::move(item));
+      continue;
+    }
 
-      if (item->type == SchedulerItem::INTERVAL) {
-        if (item->interval != 0) {
-          const uint32_t before = item->last_execution;
-          const uint32_t amount = (now - item->last_execution) / item->interval;
-          item->last_execution += amount * item->interval;
-          if (item->last_execution < before)
-            item->last_execution_major++;
-        }
-        this->push_(std::move(item));
-      }
+    if (item->interval != 0) {
+      const uint32_t before = item->last_execution;
+      const uint32_t amount = (now - item->last_execution) / item->interval;
+      item->last_execution += amount * item->interval;
+      if (item->last_execution < before)
+        item->last_execution_major++;
     }
+    // Re-added through to_add_ so that an interval of 0 runs at most once per call()
+    this->to_add_.push_back(std::move(item));
   }
 
   this->process_to_add();
@@ -272,53 +318,174 @@ void HOT Scheduler::process_to_add() {
   LockGuard guard{this->lock_};
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      this->release_item_(std::move(it));
       continue;
     }
 
+    it->heap_index = this->items_.size();
     this->items_.push_back(std::move(it));
-    std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+    this->sift_up_(this->items_.size() - 1);
   }
   this->to_add_.clear();
 }
-void HOT Scheduler::cleanup_() {
-  while (!this->items_.empty()) {
-    auto &item = this->items_[0];
-    if (!item->remove)
-      return;
-
-    to_remove_--;
-
-    {
-      LockGuard guard{this->lock_};
-      this->pop_raw_();
-    }
+std::unique_ptr<Scheduler::SchedulerItem> Scheduler::make_item_(Component *component, const std::string &name,
+                                                                uint32_t id) {
+  // lock_ must be held by the caller
+  uint16_t index;
+  if (!this->free_slots_.empty()) {
+    index = this->free_slots_.back();
+    this->free_slots_.pop_back();
+  } else if (this->slots_.size() < UINT16_MAX) {
+    index = this->slots_.size();
+    this->slots_.push_back(Slot{nullptr, 1});
+  } else {
+    ESP_LOGE(TAG, "Too many scheduled items, dropping '%s' (0x%08" PRIX32 ")", name.c_str(), id);
+    return nullptr;
   }
+
+  auto item = make_unique<SchedulerItem>();
+  item->component = component;
+  item->name = name;
+  item->id = id;
+  item->remove = false;
+  item->heap_index = NOT_IN_HEAP;
+  item->handle = (static_cast<uint32_t>(this->slots_[index].generation) << 16) | index;
+  this->slots_[index].item = item.get();
+  return item;
+}
+void Scheduler::rotate_handle_(SchedulerItem *item) {
+  // lock_ must be held by the caller
+  uint16_t index = item->handle & 0xFFFF;
+  Slot &slot = this->slots_[index];
+  // generation 0 is never handed out, so that no valid handle equals SCHEDULER_INVALID_HANDLE
+  if (++slot.generation == 0)
+    slot.generation = 1;
+  item->handle = (static_cast<uint32_t>(slot.generation) << 16) | index;
+}
+void HOT Scheduler::release_item_(std::unique_ptr<SchedulerItem> item) {
+  // lock_ must be held by the caller
+  uint16_t index = item->handle & 0xFFFF;
+  Slot &slot = this->slots_[index];
+  slot.item = nullptr;
+  if (++slot.generation == 0)
+    slot.generation = 1;
+  this->free_slots_.push_back(index);
+}
+Scheduler::SchedulerItem *HOT Scheduler::find_item_(SchedulerHandle handle) {
+  // lock_ must be held by the caller
+  uint16_t index = handle & 0xFFFF;
+  if (handle == SCHEDULER_INVALID_HANDLE || index >= this->slots_.size())
+    return nullptr;
+  const Slot &slot = this->slots_[index];
+  if (slot.item == nullptr || slot.generation != (handle >> 16))
+    return nullptr;
+  return slot.item;
 }
-void HOT Scheduler::pop_raw_() {
-  std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::pop_raw_() { return this->remove_at_(0); }
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::remove_at_(size_t index) {
+  // lock_ must be held by the caller
+  const size_t last = this->items_.size() - 1;
+  if (index != last)
+    this->swap_(index, last);
+  auto item = std::move(this->items_.back());
   this->items_.pop_back();
+  item->heap_index = NOT_IN_HEAP;
+  if (index < this->items_.size()) {
+    // The former last item may have to move in either direction
+    this->sift_up_(index);
+    this->sift_down_(index);
+  }
+  return item;
 }
-void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
-  LockGuard guard{this->lock_};
-  this->to_add_.push_back(std::move(item));
+void HOT Scheduler::sift_up_(size_t index) {
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!SchedulerItem::cmp(this->items_[parent], this->items_[index]))
+      break;
+    this->swap_(parent, index);
+    index = parent;
+  }
+}
+void HOT Scheduler::sift_down_(size_t index) {
+  const size_t size = this->items_.size();
+  while (true) {
+    size_t smallest = index;
+    size_t left = 2 * index + 1;
+    size_t right = left + 1;
+    if (left < size && SchedulerItem::cmp(this->items_[smallest], this->items_[left]))
+      smallest = left;
+    if (right < size && SchedulerItem::cmp(this->items_[smallest], this->items_[right]))
+      smallest = right;
+    if (smallest == index)
+      break;
+    this->swap_(index, smallest);
+    index = smallest;
+  }
+}
+void HOT Scheduler::swap_(size_t a, size_t b) {
+  std::swap(this->items_[a], this->items_[b]);
+  this->items_[a]->heap_index = a;
+  this->items_[b]->heap_index = b;
 }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+bool HOT Scheduler::cancel_item_locked_(SchedulerItem *item) {
+  // lock_ must be held by the caller
+  if (item->remove)
+    return false;
+  if (item->heap_index != NOT_IN_HEAP) {
+    // Scheduled and not running: can be dropped right away
+    this->release_item_(this->remove_at_(item->heap_index));
+    return true;
+  }
+  // Pending in to_add_ or currently running; disposed of by process_to_add() or call()
+  item->remove = true;
+  return true;
+}
+bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, uint32_t id,
+                                 Scheduler::SchedulerItem::Type type) {
+  if (id == 0 && name.empty())
+    return false;
   // obtain lock because this function iterates and can be called from non-loop task context
   LockGuard guard{this->lock_};
+  return this->cancel_items_locked_(component, name, id, type, nullptr);
+}
+bool HOT Scheduler::cancel_items_locked_(Component *component, const std::string &name, uint32_t id,
+                                         Scheduler::SchedulerItem::Type type, SchedulerItem **reuse) {
+  // lock_ must be held by the caller
+  auto matches = [&](SchedulerItem *it) {
+    // compare the cheap fields first, the name is only checked for items without an id
+    return it->component == component && it->type == type && it->id == id && !it->remove && it->name == name;
+  };
   bool ret = false;
-  for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
-      to_remove_++;
-      it->remove = true;
+  size_t i = 0;
+  while (i < this->items_.size()) {
+    auto *it = this->items_[i].get();
+    if (matches(it)) {
       ret = true;
+      if (reuse != nullptr && *reuse == nullptr) {
+        *reuse = it;
+      } else {
+        this->cancel_item_locked_(it);
+        // removing an item reorders the heap, rescan to not miss duplicates
+        i = 0;
+        continue;
+      }
     }
+    i++;
   }
   for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
-      it->remove = true;
+    if (matches(it.get())) {
       ret = true;
+      if (reuse != nullptr && *reuse == nullptr) {
+        *reuse = it.get();
+      } else {
+        this->cancel_item_locked_(it.get());
+      }
     }
   }
+  // A running item can never be re-armed in place, its callback is still executing
+  auto *running = this->running_;
+  if (running != nullptr && matches(running))
+    ret |= this->cancel_item_locked_(running);
 
   return ret;
 }
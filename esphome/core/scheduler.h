@@ -10,17 +10,50 @@ namespace esphome {
 
 class Component;
 
+/** Scheduler for timeouts, intervals and retries.
+ *
+ * Pending items are kept in a binary min-heap which tracks the position of every item. Together with a slot table
+ * that maps a SchedulerHandle to its item, this allows cancelling an item in O(log n) without having to leave
+ * logically deleted items in the heap.
+ *
+ * Items can be keyed either by a string name or by a numeric id (see fnv1_hash_constexpr()). Scheduling an item with
+ * the key of a pending one re-arms the pending item in place, so timers that are re-armed often don't allocate.
+ */
 class Scheduler {
  public:
-  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
+  SchedulerHandle set_timeout(Component *component, const std::string &name, uint32_t timeout,
+                              std::function<void()> func);
+  SchedulerHandle set_timeout(Component *component, uint32_t id, uint32_t timeout, std::function<void()> func);
   bool cancel_timeout(Component *component, const std::string &name);
-  void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> func);
+  bool cancel_timeout(Component *component, uint32_t id);
+  SchedulerHandle set_interval(Component *component, const std::string &name, uint32_t interval,
+                               std::function<void()> func);
+  SchedulerHandle set_interval(Component *component, uint32_t id, uint32_t interval, std::function<void()> func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, uint32_t id);
+#ifdef USE_STAGGERED_POLLING
+  /** Like set_interval(), but instead of running right away the first execution is delayed by a phase.
+   *
+   * The phases of all intervals with the same length that are registered this way are spread evenly over the
+   * interval, so that they don't all run in the same loop iteration.
+   */
+  SchedulerHandle set_staggered_interval(Component *component, const std::string &name, uint32_t interval,
+                                         std::function<void()> func);
+#endif
 
   void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                  std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
   bool cancel_retry(Component *component, const std::string &name);
 
+  /** Cancel a timeout or interval by the handle returned when it was scheduled.
+   *
+   * Handles of items that already ran or were cancelled are detected and ignored, so it is always safe to call this
+   * with a stale handle.
+   *
+   * @return Whether an item was cancelled.
+   */
+  bool cancel(SchedulerHandle handle);
+
   optional<uint32_t> next_schedule_in();
 
   void call();
@@ -31,6 +64,8 @@ class Scheduler {
   struct SchedulerItem {
     Component *component;
     std::string name;
+    /// Numeric key used instead of `name`, 0 for items keyed by name.
+    uint32_t id;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
@@ -39,7 +74,14 @@ class Scheduler {
     uint32_t last_execution;
     std::function<void()> callback;
     bool remove;
+#ifdef USE_LOOP_BUDGET
+    /// Postponed by the loop budget in the previous call(), runs in the next one whatever the budget.
+    bool deferred;
+#endif
     uint8_t last_execution_major;
+    /// Position of this item in `items_`, or NOT_IN_HEAP while it is pending in `to_add_` or running.
+    size_t heap_index;
+    SchedulerHandle handle;
 
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
     inline uint8_t next_execution_major() {
@@ -63,22 +105,47 @@ class Scheduler {
     }
   };
 
+  /// Entry of the handle table. The generation is bumped each time the slot is reused to detect stale handles.
+  struct Slot {
+    SchedulerItem *item;
+    uint16_t generation;
+  };
+
+  static const size_t NOT_IN_HEAP = SIZE_MAX;
+  /// Phase for set_item_() to pick a random offset in the first half of the interval
+  static const uint32_t RANDOM_PHASE = UINT32_MAX;
+
   uint32_t millis_();
-  void cleanup_();
-  void pop_raw_();
-  void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
-  bool empty_() {
-    this->cleanup_();
-    return this->items_.empty();
-  }
+  SchedulerHandle set_item_(Component *component, const std::string &name, uint32_t id, SchedulerItem::Type type,
+                            uint32_t delay, std::function<void()> func, uint32_t phase = RANDOM_PHASE);
+  std::unique_ptr<SchedulerItem> make_item_(Component *component, const std::string &name, uint32_t id);
+  void rotate_handle_(SchedulerItem *item);
+  void release_item_(std::unique_ptr<SchedulerItem> item);
+  SchedulerItem *find_item_(SchedulerHandle handle);
+  std::unique_ptr<SchedulerItem> pop_raw_();
+  std::unique_ptr<SchedulerItem> remove_at_(size_t index);
+  void sift_up_(size_t index);
+  void sift_down_(size_t index);
+  void swap_(size_t a, size_t b);
+  bool cancel_item_locked_(SchedulerItem *item);
+  bool cancel_item_(Component *component, const std::string &name, uint32_t id, SchedulerItem::Type type);
+  bool cancel_items_locked_(Component *component, const std::string &name, uint32_t id, SchedulerItem::Type type,
+                            SchedulerItem **reuse);
+  bool empty_() { return this->items_.empty(); }
 
   Mutex lock_;
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  std::vector<Slot> slots_;
+  std::vector<uint16_t> free_slots_;
+  /// The item whose callback is currently being executed, owned by call() while it runs.
+  SchedulerItem *running_{nullptr};
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
-  uint32_t to_remove_{0};
+#ifdef USE_STAGGERED_POLLING
+  /// How many staggered intervals were registered for each interval length
+  std::vector<std::pair<uint32_t, uint32_t>> staggered_counts_;
+#endif
 };
 
 }  // namespace esphome
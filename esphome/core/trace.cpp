@@ -0,0 +1,69 @@
+#include "esphome/core/trace.h"
+
+#ifdef USE_TRACE
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+namespace esphome {
+namespace trace {
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+TraceEvent trace_buffer[USE_TRACE_BUFFER_SIZE];
+uint32_t trace_count = 0;
+bool trace_paused = false;
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+static const char *const CATEGORY_NAMES[] = {"loop", "update", "scheduler", "api", "isr", "other"};
+static const char PHASE_CHARS[] = {'B', 'E', 'i'};
+
+/// CPU cycles per microsecond, measured against micros() as the cycle counter frequency isn't always known.
+static uint32_t measure_cycles_per_us() {
+  const uint32_t start_us = micros();
+  const uint32_t start_cycles = arch_get_cpu_cycle_count();
+  while (micros() - start_us < 1000) {
+  }
+  const uint32_t cycles_per_us = (arch_get_cpu_cycle_count() - start_cycles) / (micros() - start_us);
+  return cycles_per_us == 0 ? 1 : cycles_per_us;
+}
+
+void dump_chrome_trace(const std::function<void(const char *)> &write) {
+  trace_paused = true;
+  const uint32_t cycles_per_us = measure_cycles_per_us();
+  const uint32_t count = std::min<uint32_t>(trace_count, USE_TRACE_BUFFER_SIZE);
+  const uint32_t first = trace_count - count;
+
+  write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  // The cycle counter wraps after a few seconds, so sum up the differences between consecutive events
+  uint64_t elapsed_cycles = 0;
+  uint32_t last_cycles = count == 0 ? 0 : trace_buffer[first & (USE_TRACE_BUFFER_SIZE - 1)].cycles;
+  char line[160];
+  for (uint32_t i = 0; i < count; i++) {
+    const TraceEvent &event = trace_buffer[(first + i) & (USE_TRACE_BUFFER_SIZE - 1)];
+    elapsed_cycles += event.cycles - last_cycles;
+    last_cycles = event.cycles;
+    const uint64_t ts_us = elapsed_cycles / cycles_per_us;
+    int len = snprintf(line, sizeof(line),
+                       "%s{\"name\":\"%.48s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRIu32 ".%03" PRIu32
+                       ",\"pid\":0,\"tid\":0",
+                       i == 0 ? "" : ",", event.name == nullptr ? "" : event.name, CATEGORY_NAMES[event.category],
+                       PHASE_CHARS[event.phase], static_cast<uint32_t>(ts_us),
+                       static_cast<uint32_t>((elapsed_cycles % cycles_per_us) * 1000 / cycles_per_us));
+    // Thread scoped instant events, and only the events that have an argument carry it
+    const char *suffix = event.phase == TRACE_PHASE_INSTANT ? ",\"s\":\"t\"" : "";
+    if (event.arg != 0) {
+      snprintf(line + len, sizeof(line) - len, "%s,\"args\":{\"arg\":%" PRIu32 "}}", suffix, event.arg);
+    } else {
+      snprintf(line + len, sizeof(line) - len, "%s}", suffix);
+    }
+    write(line);
+  }
+  write("]}");
+  trace_paused = false;
+}
+
+}  // namespace trace
+}  // namespace esphome
+
+#endif  // USE_TRACE
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace trace {
+
+/** Ring buffer recorder for what the device was doing, to find out what caused a loop stall in the field.
+ *
+ * Events are recorded with the macros below, which compile to nothing without USE_TRACE. With it, recording an event
+ * reads the CPU cycle counter and stores one entry in a static ring buffer of USE_TRACE_BUFFER_SIZE entries (a power
+ * of two), so the last few seconds before a stall can be reconstructed. dump_chrome_trace() writes the buffer in the
+ * Chrome trace event format, which can be loaded into chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Names must be string literals or otherwise outlive the buffer, only the pointer is stored. Events recorded from
+ * other tasks or interrupts while the main loop records one may overwrite each other, which only loses that event.
+ */
+enum TraceCategory : uint8_t {
+  TRACE_CATEGORY_LOOP = 0,
+  TRACE_CATEGORY_UPDATE,
+  TRACE_CATEGORY_SCHEDULER,
+  TRACE_CATEGORY_API,
+  TRACE_CATEGORY_ISR,
+  TRACE_CATEGORY_OTHER,
+};
+
+enum TracePhase : uint8_t {
+  TRACE_PHASE_BEGIN = 0,
+  TRACE_PHASE_END,
+  TRACE_PHASE_INSTANT,
+};
+
+#ifdef USE_TRACE
+
+struct TraceEvent {
+  uint32_t cycles;
+  const char *name;
+  /// Free form value shown with the event, like the type of an API message.
+  uint32_t arg;
+  TracePhase phase;
+  TraceCategory category;
+};
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+extern TraceEvent trace_buffer[USE_TRACE_BUFFER_SIZE];
+/// Number of events recorded since boot, the next one goes to trace_buffer[trace_count % USE_TRACE_BUFFER_SIZE].
+extern uint32_t trace_count;
+extern bool trace_paused;
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+static_assert((USE_TRACE_BUFFER_SIZE & (USE_TRACE_BUFFER_SIZE - 1)) == 0, "The trace buffer size must be a power of 2");
+
+inline void IRAM_ATTR record(TracePhase phase, TraceCategory category, const char *name, uint32_t arg = 0) {
+  if (trace_paused)
+    return;
+  TraceEvent &event = trace_buffer[trace_count++ & (USE_TRACE_BUFFER_SIZE - 1)];
+  event.cycles = arch_get_cpu_cycle_count();
+  event.name = name;
+  event.arg = arg;
+  event.phase = phase;
+  event.category = category;
+}
+
+/// Records a begin event now and the matching end event when it goes out of scope.
+class TraceScope {
+ public:
+  TraceScope(TraceCategory category, const char *name, uint32_t arg = 0) : category_(category), name_(name) {
+    record(TRACE_PHASE_BEGIN, category, name, arg);
+  }
+  ~TraceScope() { record(TRACE_PHASE_END, this->category_, this->name_); }
+
+ protected:
+  TraceCategory category_;
+  const char *name_;
+};
+
+/** Write the recorded events in the Chrome trace event JSON format, in chunks passed to write.
+ *
+ * Recording is paused while this runs, timestamps are in microseconds relative to the oldest event.
+ */
+void dump_chrome_trace(const std::function<void(const char *)> &write);
+
+#define ESPHOME_TRACE_CONCAT_(a, b) a##b
+#define ESPHOME_TRACE_CONCAT(a, b) ESPHOME_TRACE_CONCAT_(a, b)
+/// Trace the rest of the enclosing scope, ESPHOME_TRACE_SCOPE(category, name[, arg]).
+#define ESPHOME_TRACE_SCOPE(...) \
+  ::esphome::trace::TraceScope ESPHOME_TRACE_CONCAT(trace_scope_, __LINE__)(__VA_ARGS__)
+#define ESPHOME_TRACE_BEGIN(...) ::esphome::trace::record(::esphome::trace::TRACE_PHASE_BEGIN, __VA_ARGS__)
+#define ESPHOME_TRACE_END(...) ::esphome::trace::record(::esphome::trace::TRACE_PHASE_END, __VA_ARGS__)
+#define ESPHOME_TRACE_INSTANT(...) ::esphome::trace::record(::esphome::trace::TRACE_PHASE_INSTANT, __VA_ARGS__)
+
+#else
+
+#define ESPHOME_TRACE_SCOPE(...)
+#define ESPHOME_TRACE_BEGIN(...)
+#define ESPHOME_TRACE_END(...)
+#define ESPHOME_TRACE_INSTANT(...)
+
+#endif  // USE_TRACE
+
+}  // namespace trace
+}  // namespace esphome
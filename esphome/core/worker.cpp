@@ -0,0 +1,108 @@
+#include "esphome/core/worker.h"
+
+#if defined(USE_COMPONENT_WORKER) && defined(USE_ESP32)
+
+#include <atomic>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+#include "esphome/core/application.h"
+#include "esphome/core/component.h"
+#include "esphome/core/log.h"
+#include "esphome/core/trace.h"
+
+namespace esphome {
+namespace worker {
+
+static const char *const TAG = "worker";
+
+static const uint32_t UPDATE_QUEUE_SIZE = 16;
+/// Power of two, so the indices can wrap around.
+static const uint32_t MAIN_QUEUE_SIZE = 32;
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-non-const-global-variables)
+static TaskHandle_t worker_task = nullptr;
+static QueueHandle_t update_queue = nullptr;
+static std::function<void()> main_queue[MAIN_QUEUE_SIZE];
+/// Only written by the worker.
+static std::atomic<uint32_t> main_queue_head{0};
+/// Only written by the main loop.
+static std::atomic<uint32_t> main_queue_tail{0};
+// NOLINTEND(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void worker_task_fn(void *arg) {
+  while (true) {
+    PollingComponent *component;
+    if (xQueueReceive(update_queue, &component, portMAX_DELAY) != pdTRUE)
+      continue;
+    {
+      ESPHOME_TRACE_SCOPE(trace::TRACE_CATEGORY_UPDATE, component->get_component_source());
+      component->update();
+    }
+    component->release_worker_update();
+  }
+}
+
+static bool start_worker() {
+  update_queue = xQueueCreate(UPDATE_QUEUE_SIZE, sizeof(PollingComponent *));
+  if (update_queue == nullptr)
+    return false;
+  // Below the main loop, so on a single core it only takes the time the main loop leaves
+  const UBaseType_t priority = uxTaskPriorityGet(nullptr) > 1 ? uxTaskPriorityGet(nullptr) - 1 : 1;
+#if portNUM_PROCESSORS > 1
+  const BaseType_t core = 1 - xPortGetCoreID();
+#else
+  const BaseType_t core = tskNO_AFFINITY;
+#endif
+  if (xTaskCreatePinnedToCore(worker_task_fn, "worker", 8192, nullptr, priority, &worker_task, core) != pdPASS) {
+    vQueueDelete(update_queue);
+    update_queue = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void submit_update(PollingComponent *component) {
+  if (!component->claim_worker_update())
+    return;
+  if (worker_task == nullptr && !start_worker()) {
+    ESP_LOGE(TAG, "Could not start the worker task, running update() on the main loop");
+    component->release_worker_update();
+    component->update();
+    return;
+  }
+  if (xQueueSend(update_queue, &component, 0) != pdTRUE)
+    component->release_worker_update();
+}
+
+bool in_worker() { return worker_task != nullptr && xTaskGetCurrentTaskHandle() == worker_task; }
+
+void run_in_main(std::function<void()> &&f) {
+  if (!in_worker()) {
+    f();
+    return;
+  }
+  const uint32_t head = main_queue_head.load(std::memory_order_relaxed);
+  while (head - main_queue_tail.load(std::memory_order_acquire) >= MAIN_QUEUE_SIZE)
+    vTaskDelay(1);
+  main_queue[head % MAIN_QUEUE_SIZE] = std::move(f);
+  main_queue_head.store(head + 1, std::memory_order_release);
+  App.wake_loop_any_context();
+}
+
+void process_main_queue() {
+  uint32_t tail = main_queue_tail.load(std::memory_order_relaxed);
+  while (tail != main_queue_head.load(std::memory_order_acquire)) {
+    std::function<void()> f = std::move(main_queue[tail % MAIN_QUEUE_SIZE]);
+    main_queue[tail % MAIN_QUEUE_SIZE] = nullptr;
+    main_queue_tail.store(++tail, std::memory_order_release);
+    f();
+  }
+}
+
+}  // namespace worker
+}  // namespace esphome
+
+#endif  // USE_COMPONENT_WORKER && USE_ESP32
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_COMPONENT_WORKER
+
+#include <functional>
+
+namespace esphome {
+
+class PollingComponent;
+
+/** Runs update() of components configured with `thread_safe: true` on a worker task on the other core.
+ *
+ * The interval of such a component only queues it for the worker, so a slow update() like a display redraw or heavy
+ * filtering doesn't hold up the main loop. update() then runs concurrently with the main loop, so it must not touch
+ * anything the main loop uses without a lock, which includes buses shared with other components. States it publishes
+ * through Sensor, BinarySensor or TextSensor are handed back to the main loop with run_in_main() and published there.
+ *
+ * On chips with a single core, the worker runs on it at a lower priority than the main loop.
+ */
+namespace worker {
+
+/// Queue update() of the component for the worker, does nothing while the previous update() hasn't finished yet.
+void submit_update(PollingComponent *component);
+/// Whether the calling code runs on the worker task.
+bool in_worker();
+/** Run f on the main loop, right away when called from there.
+ *
+ * Passes f from the worker to the main loop through a lock-free single producer queue, waits while that is full.
+ */
+void run_in_main(std::function<void()> &&f);
+/// Run what the worker queued with run_in_main(), called by Application::loop().
+void process_main_queue();
+
+}  // namespace worker
+}  // namespace esphome
+
+#endif  // USE_COMPONENT_WORKER
@@ -5,6 +5,7 @@ import re
 from collections.abc import Generator, Sequence
 from typing import Any, Callable, Optional, Union
 
+from esphome.const import CONF_ESPHOME, CONF_STATIC_ALLOCATION
 from esphome.core import (
     CORE,
     ID,
@@ -538,6 +539,15 @@ def new_variable(id_: ID, rhs: SafeExpType, type_: "MockObj" = None) -> "MockObj
     return obj
 
 
+STATIC_STORAGE_SUFFIX = "__pstorage"
+
+
+def _static_allocation() -> bool:
+    if CORE.config is None:
+        return False
+    return CORE.config.get(CONF_ESPHOME, {}).get(CONF_STATIC_ALLOCATION, False)
+
+
 def Pvariable(id_: ID, rhs: SafeExpType, type_: "MockObj" = None) -> "MockObj":
     """Declare a new pointer variable in the code generation.
 
@@ -573,7 +583,17 @@ def new_Pvariable(id_: ID, *args: SafeExpType) -> Pvariable:
         id_ = id_.copy()
         id_.type = id_.type.template(args[0])
         args = args[1:]
-    rhs = id_.type.new(*args)
+    if _static_allocation():
+        # Placement new into storage of its own, reserved in .bss by the linker
+        storage = f"{id_.id}{STATIC_STORAGE_SUFFIX}"
+        CORE.add_global(
+            RawStatement(
+                f"alignas({id_.type}) static uint8_t {storage}[sizeof({id_.type})];"
+            )
+        )
+        rhs = MockObj(f"new ({storage}) {id_.type}", "->")(*args)
+    else:
+        rhs = id_.type.new(*args)
     return Pvariable(id_, rhs)
 
 
@@ -646,6 +666,22 @@ async def get_variable_with_full_id(id_: ID) -> tuple[ID, "MockObj"]:
     return await CORE.get_variable_with_full_id(id_)
 
 
+async def lambda_capture(value: Lambda) -> str:
+    """Return the smallest capture for the given lambda.
+
+    IDs declared with Pvariable are globals and don't need to be captured. A lambda that
+    only uses those captures nothing, so it converts to a plain function pointer that
+    automations call without going through std::function.
+
+    This is a coroutine, you need to await it with a 'await' expression!
+    """
+    for id_ in value.requires_ids:
+        var = await get_variable(id_)
+        if not isinstance(var, MockObj) or var.op != "->":
+            return "="
+    return ""
+
+
 async def process_lambda(
     value: Lambda,
     parameters: list[tuple[SafeExpType, str]],
@@ -723,7 +759,10 @@ async def templatable(
     :return: The potentially templated value.
     """
     if is_template(value):
-        return await process_lambda(value, args, return_type=output_type)
+        capture = await lambda_capture(value)
+        return await process_lambda(
+            value, args, capture=capture, return_type=output_type
+        )
     if to_exp is None:
         return value
     if isinstance(to_exp, dict):
@@ -6,7 +6,10 @@ from esphome.const import (
     CONF_ICON,
     CONF_INTERNAL,
     CONF_NAME,
+    CONF_SETUP_AFTER,
     CONF_SETUP_PRIORITY,
+    CONF_DEFERRABLE,
+    CONF_THREAD_SAFE,
     CONF_UPDATE_INTERVAL,
     CONF_TYPE_ID,
     CONF_OTA,
@@ -17,10 +20,10 @@ from esphome.const import (
 from esphome.core import coroutine, ID, CORE
 from esphome.coroutine import FakeAwaitable
 from esphome.types import ConfigType, ConfigFragmentType
-from esphome.cpp_generator import add, get_variable
+from esphome.cpp_generator import add, add_define, get_variable
 from esphome.cpp_types import App
 from esphome.util import Registry, RegistryEntry
-from esphome.helpers import snake_case, sanitize
+from esphome.helpers import fnv1_hash, snake_case, sanitize
 
 
 _LOGGER = logging.getLogger(__name__)
@@ -61,6 +64,16 @@ async def register_component(var, config):
         add(var.set_setup_priority(config[CONF_SETUP_PRIORITY]))
     if CONF_UPDATE_INTERVAL in config:
         add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+    if CONF_DEFERRABLE in config:
+        add(var.set_deferrable(config[CONF_DEFERRABLE]))
+    if config.get(CONF_THREAD_SAFE):
+        add(var.set_thread_safe(True))
+        add_define("USE_COMPONENT_WORKER")
+    if CONF_SETUP_AFTER in config:
+        add(var.set_setup_independent())
+        for dependency_id in config[CONF_SETUP_AFTER]:
+            dependency = await get_variable(dependency_id)
+            add(var.add_setup_dependency(dependency))
 
     # Set component source by inspecting the stack and getting the callee module
     # https://stackoverflow.com/a/1095621
@@ -103,9 +116,10 @@ async def setup_entity(var, config):
     """Set up generic properties of an Entity"""
     add(var.set_name(config[CONF_NAME]))
     if not config[CONF_NAME]:
-        add(var.set_object_id(sanitize(snake_case(CORE.friendly_name))))
+        object_id = sanitize(snake_case(CORE.friendly_name))
     else:
-        add(var.set_object_id(sanitize(snake_case(config[CONF_NAME]))))
+        object_id = sanitize(snake_case(config[CONF_NAME]))
+    add(var.set_object_id(object_id, fnv1_hash(object_id)))
     add(var.set_disabled_by_default(config[CONF_DISABLED_BY_DEFAULT]))
     if CONF_INTERNAL in config:
         add(var.set_internal(config[CONF_INTERNAL]))
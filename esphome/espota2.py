@@ -259,6 +259,7 @@ def perform_ota(sock, password, file_handle, filename):
     sock.settimeout(20.0)
 
     offset = 0
+    start = time.perf_counter()
     progress = ProgressBar()
     while True:
         chunk = upload_contents[offset : offset + 1024]
@@ -274,6 +275,13 @@ def perform_ota(sock, password, file_handle, filename):
 
         progress.update(offset / upload_size)
     progress.done()
+    duration = time.perf_counter() - start
+    _LOGGER.info(
+        "Sent %s bytes in %.1fs (%.1f kB/s)",
+        upload_size,
+        duration,
+        upload_size / 1024 / max(duration, 0.001),
+    )
 
     # Enable nodelay for last checks
     sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
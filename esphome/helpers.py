@@ -360,3 +360,11 @@ def snake_case(value):
 def sanitize(value):
     """Same behaviour as `helpers.cpp` method `str_sanitize`."""
     return re.sub("[^-_0-9a-zA-Z]", r"", value)
+
+
+def fnv1_hash(value):
+    """Same behaviour as `helpers.cpp` method `fnv1_hash` for ASCII strings."""
+    hash_ = 2166136261
+    for char in value.encode():
+        hash_ = ((hash_ * 16777619) & 0xFFFFFFFF) ^ char
+    return hash_
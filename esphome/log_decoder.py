@@ -0,0 +1,166 @@
+"""Decoder for the logger's deferred format records.
+
+With ``logger: deferred_format: true`` the device sends base64 encoded binary
+records over the serial port instead of formatted text. A record references
+the tag and format string by their address in flash, so the firmware ELF is
+needed to turn it back into a log line.
+"""
+import base64
+import binascii
+import logging
+import re
+import struct
+from typing import Callable, Optional
+
+_LOGGER = logging.getLogger(__name__)
+
+DEFERRED_MARKER = "\x02"
+
+LOG_LEVEL_COLORS = [
+    "",
+    "\033[1;31m",  # ERROR
+    "\033[0;33m",  # WARNING
+    "\033[0;32m",  # INFO
+    "\033[0;35m",  # CONFIG
+    "\033[0;36m",  # DEBUG
+    "\033[0;37m",  # VERBOSE
+    "\033[0;38m",  # VERY_VERBOSE
+]
+LOG_LEVEL_LETTERS = ["", "E", "W", "I", "C", "D", "V", "VV"]
+RESET_COLOR = "\033[0m"
+
+# flags, width, precision, length, conversion
+FORMAT_SPEC_RE = re.compile(
+    r"%([-+ #0]*)(\*|\d*)(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t)?([diuxXocsfFeEgGaAp%])"
+)
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+
+class ElfImage:
+    """Memory image of the allocated sections of a 32-bit little endian ELF file."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError(f"{path} is not a 32-bit little endian ELF file")
+        shoff, _, _, _, _, shentsize, shnum, _ = struct.unpack_from(
+            "<IIHHHHHH", data, 0x20
+        )
+        self.sections = []
+        for i in range(shnum):
+            (_, sh_type, flags, addr, offset, size) = struct.unpack_from(
+                "<IIIIII", data, shoff + i * shentsize
+            )
+            if not flags & SHF_ALLOC or sh_type == SHT_NOBITS or size == 0:
+                continue
+            self.sections.append((addr, data[offset : offset + size]))
+
+    def read_string(self, addr: int) -> Optional[str]:
+        for start, content in self.sections:
+            if start <= addr < start + len(content):
+                end = content.find(b"\0", addr - start)
+                if end < 0:
+                    end = len(content)
+                return content[addr - start : end].decode("utf8", "backslashreplace")
+        return None
+
+
+class _Reader:
+    def __init__(self, data: bytes):
+        self.data = data
+        self.pos = 0
+
+    def take(self, fmt: str):
+        value = struct.unpack_from(fmt, self.data, self.pos)[0]
+        self.pos += struct.calcsize(fmt)
+        return value
+
+    def take_string(self) -> str:
+        length = self.take("<B")
+        value = self.data[self.pos : self.pos + length]
+        self.pos += length
+        return value.decode("utf8", "backslashreplace")
+
+
+def _format(fmt: str, reader: _Reader) -> str:
+    def replace(match):
+        flags, width, precision, length, conv = match.groups()
+        if conv == "%":
+            return "%"
+        if width == "*":
+            width = str(reader.take("<i"))
+        if precision == "*":
+            precision = str(reader.take("<i"))
+        spec = "%" + flags + width + ("" if precision is None else "." + precision)
+        wide = length in ("ll", "j")
+        if conv in "di":
+            value = reader.take("<q" if wide else "<i")
+            if length == "h":
+                value = struct.unpack("<h", struct.pack("<H", value & 0xFFFF))[0]
+            elif length == "hh":
+                value = struct.unpack("<b", struct.pack("<B", value & 0xFF))[0]
+            return (spec + "d") % value
+        if conv in "uxXo":
+            value = reader.take("<Q" if wide else "<I")
+            if length == "h":
+                value &= 0xFFFF
+            elif length == "hh":
+                value &= 0xFF
+            return (spec + ("d" if conv == "u" else conv)) % value
+        if conv == "c":
+            return (spec + "c") % chr(reader.take("<i") & 0xFF)
+        if conv in "fFeEgGaA":
+            value = reader.take("<d")
+            if conv in "aA":
+                return value.hex()
+            return (spec + conv) % value
+        if conv == "s":
+            return (spec + "s") % reader.take_string()
+        # p
+        return (spec + "s") % hex(reader.take("<I"))
+
+    return FORMAT_SPEC_RE.sub(replace, fmt)
+
+
+def decode_record(
+    line: str, read_string: Callable[[int], Optional[str]]
+) -> Optional[str]:
+    """Rebuild the text of a deferred record.
+
+    Returns None if the line isn't a record or can't be decoded.
+    """
+    if not line.startswith(DEFERRED_MARKER):
+        return None
+    try:
+        reader = _Reader(base64.b64decode(line[len(DEFERRED_MARKER) :].strip()))
+        level = min(reader.take("<B"), 7)
+        line_no = reader.take("<H")
+        tag = read_string(reader.take("<I"))
+        fmt = read_string(reader.take("<I"))
+        if tag is None or fmt is None:
+            return None
+        message = _format(fmt, reader)
+    except (binascii.Error, struct.error, ValueError, TypeError):
+        return None
+    return (
+        f"{LOG_LEVEL_COLORS[level]}[{LOG_LEVEL_LETTERS[level]}][{tag}:{line_no:03}]: "
+        f"{message}{RESET_COLOR}"
+    )
+
+
+def load_elf_decoder(config) -> Optional[Callable[[str], Optional[str]]]:
+    """Return a line decoder for the firmware built from config, if its ELF exists."""
+    from esphome import platformio_api
+
+    try:
+        image = ElfImage(platformio_api.get_idedata(config).firmware_elf_path)
+    except Exception:  # pylint: disable=broad-except
+        _LOGGER.warning(
+            "Could not load the firmware ELF, deferred log lines won't be decoded",
+            exc_info=True,
+        )
+        return None
+    return lambda line: decode_record(line, image.read_string)
@@ -225,6 +225,31 @@ def _parse_register(config, regex, line):
         _decode_pc(config, match.group(1))
 
 
+def report_static_allocation(idedata: "IDEData"):
+    """Log the static storage the config-time objects were placed in, read from the
+    symbol sizes in the firmware ELF."""
+    from esphome.cpp_generator import STATIC_STORAGE_SUFFIX
+
+    command = [idedata.nm_path, "--print-size", idedata.firmware_elf_path]
+    try:
+        output = subprocess.check_output(command).decode()
+    except Exception:  # pylint: disable=broad-except
+        _LOGGER.debug("Caught exception for command %s", command, exc_info=1)
+        return
+
+    count = 0
+    size = 0
+    for line in output.splitlines():
+        # address, size, type, name
+        parts = line.split()
+        if len(parts) == 4 and parts[3].endswith(STATIC_STORAGE_SUFFIX):
+            count += 1
+            size += int(parts[1], 16)
+    _LOGGER.info(
+        "Static allocation: %d objects in %d bytes of static storage", count, size
+    )
+
+
 STACKTRACE_ESP8266_EXCEPTION_TYPE_RE = re.compile(r"[eE]xception \((\d+)\):")
 STACKTRACE_ESP8266_PC_RE = re.compile(r"epc1=0x(4[0-9a-fA-F]{7})")
 STACKTRACE_ESP8266_EXCVADDR_RE = re.compile(r"excvaddr=0x(4[0-9a-fA-F]{7})")
@@ -332,3 +357,10 @@ class IDEData:
             return f"{self.cc_path[:-7]}addr2line.exe"
 
         return f"{self.cc_path[:-3]}addr2line"
+
+    @property
+    def nm_path(self) -> str:
+        if self.cc_path.endswith(".exe"):
+            return f"{self.cc_path[:-7]}nm.exe"
+
+        return f"{self.cc_path[:-3]}nm"
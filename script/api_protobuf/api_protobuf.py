@@ -191,6 +191,40 @@ class TypeInfo:
 
     dump = None
 
+    # Wire type of the field, used to precompute the size of its tag
+    wire_type = 0
+
+    @property
+    def field_id_size(self):
+        return varint_size((self.number << 3) | self.wire_type)
+
+    size_func = None
+
+    def get_size_calculation(self, name, force=False):
+        force_str = "true" if force else "false"
+        return f"ProtoSize::{self.size_func}(total_size, {self.field_id_size}, {name}, {force_str});"
+
+    @property
+    def size_content(self):
+        return self.get_size_calculation(f"this->{self.field_name}")
+
+    # Largest encoded size of the value (without the tag), None if it is unbounded
+    max_value_size = None
+
+    @property
+    def max_size(self):
+        if self.max_value_size is None:
+            return None
+        return self.field_id_size + self.max_value_size
+
+
+def varint_size(value):
+    size = 1
+    while value >= 0x80:
+        value >>= 7
+        size += 1
+    return size
+
 
 TYPE_INFO = {}
 
@@ -210,6 +244,9 @@ class DoubleType(TypeInfo):
     decode_64bit = "value.as_double()"
     encode_func = "encode_double"
 
+    max_value_size = 8
+    wire_type = 1
+
     def dump(self, name):
         o = f'sprintf(buffer, "%g", {name});\n'
         o += f"out.append(buffer);"
@@ -223,6 +260,10 @@ class FloatType(TypeInfo):
     decode_32bit = "value.as_float()"
     encode_func = "encode_float"
 
+    max_value_size = 4
+    wire_type = 5
+    size_func = "add_float_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%g", {name});\n'
         o += f"out.append(buffer);"
@@ -236,6 +277,10 @@ class Int64Type(TypeInfo):
     decode_varint = "value.as_int64()"
     encode_func = "encode_int64"
 
+    max_value_size = 10
+    wire_type = 0
+    size_func = "add_int64_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
         o += f"out.append(buffer);"
@@ -249,6 +294,10 @@ class UInt64Type(TypeInfo):
     decode_varint = "value.as_uint64()"
     encode_func = "encode_uint64"
 
+    max_value_size = 10
+    wire_type = 0
+    size_func = "add_uint64_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%llu", {name});\n'
         o += f"out.append(buffer);"
@@ -262,6 +311,10 @@ class Int32Type(TypeInfo):
     decode_varint = "value.as_int32()"
     encode_func = "encode_int32"
 
+    max_value_size = 10
+    wire_type = 0
+    size_func = "add_int32_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%d", {name});\n'
         o += f"out.append(buffer);"
@@ -275,6 +328,10 @@ class Fixed64Type(TypeInfo):
     decode_64bit = "value.as_fixed64()"
     encode_func = "encode_fixed64"
 
+    max_value_size = 8
+    wire_type = 1
+    size_func = "add_fixed64_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%llu", {name});\n'
         o += f"out.append(buffer);"
@@ -288,6 +345,10 @@ class Fixed32Type(TypeInfo):
     decode_32bit = "value.as_fixed32()"
     encode_func = "encode_fixed32"
 
+    max_value_size = 4
+    wire_type = 5
+    size_func = "add_fixed32_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%u", {name});\n'
         o += f"out.append(buffer);"
@@ -301,6 +362,10 @@ class BoolType(TypeInfo):
     decode_varint = "value.as_bool()"
     encode_func = "encode_bool"
 
+    max_value_size = 1
+    wire_type = 0
+    size_func = "add_bool_field"
+
     def dump(self, name):
         o = f"out.append(YESNO({name}));"
         return o
@@ -315,6 +380,9 @@ class StringType(TypeInfo):
     decode_length = "value.as_string()"
     encode_func = "encode_string"
 
+    wire_type = 2
+    size_func = "add_string_field"
+
     def dump(self, name):
         o = f'out.append("\'").append({name}).append("\'");'
         return o
@@ -344,6 +412,12 @@ class MessageType(TypeInfo):
     def decode_length(self):
         return f"value.as_message<{self.cpp_type}>()"
 
+    wire_type = 2
+
+    def get_size_calculation(self, name, force=False):
+        # Nested messages are always encoded, even when empty
+        return f"ProtoSize::add_message_object(total_size, {self.field_id_size}, {name});"
+
     def dump(self, name):
         o = f"{name}.dump_to(out);"
         return o
@@ -358,11 +432,32 @@ class BytesType(TypeInfo):
     decode_length = "value.as_string()"
     encode_func = "encode_string"
 
+    wire_type = 2
+    size_func = "add_string_field"
+
     def dump(self, name):
         o = f'out.append("\'").append({name}).append("\'");'
         return o
 
 
+class BytesRefType(BytesType):
+    """Bytes of a message only the client sends, decoded as a view into the receive
+    buffer.
+
+    The view is only valid while the message is being handled, handlers have to copy
+    what they keep.
+    """
+
+    cpp_type = "StringRef"
+    reference_type = "StringRef &"
+    const_reference_type = "const StringRef &"
+    decode_length = "value.as_string_ref()"
+
+    def dump(self, name):
+        o = f'out.append("\'").append({name}.c_str(), {name}.size()).append("\'");'
+        return o
+
+
 @register_type(13)
 class UInt32Type(TypeInfo):
     cpp_type = "uint32_t"
@@ -370,6 +465,10 @@ class UInt32Type(TypeInfo):
     decode_varint = "value.as_uint32()"
     encode_func = "encode_uint32"
 
+    max_value_size = 5
+    wire_type = 0
+    size_func = "add_uint32_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%u", {name});\n'
         o += f"out.append(buffer);"
@@ -392,6 +491,10 @@ class EnumType(TypeInfo):
     def encode_func(self):
         return f"encode_enum<{self.cpp_type}>"
 
+    max_value_size = 5
+    wire_type = 0
+    size_func = "add_enum_field"
+
     def dump(self, name):
         o = f"out.append(proto_enum_to_string<{self.cpp_type}>({name}));"
         return o
@@ -404,6 +507,9 @@ class SFixed32Type(TypeInfo):
     decode_32bit = "value.as_sfixed32()"
     encode_func = "encode_sfixed32"
 
+    max_value_size = 4
+    wire_type = 5
+
     def dump(self, name):
         o = f'sprintf(buffer, "%d", {name});\n'
         o += f"out.append(buffer);"
@@ -417,6 +523,9 @@ class SFixed64Type(TypeInfo):
     decode_64bit = "value.as_sfixed64()"
     encode_func = "encode_sfixed64"
 
+    max_value_size = 8
+    wire_type = 1
+
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
         o += f"out.append(buffer);"
@@ -430,6 +539,10 @@ class SInt32Type(TypeInfo):
     decode_varint = "value.as_sint32()"
     encode_func = "encode_sint32"
 
+    max_value_size = 5
+    wire_type = 0
+    size_func = "add_sint32_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%d", {name});\n'
         o += f"out.append(buffer);"
@@ -443,6 +556,10 @@ class SInt64Type(TypeInfo):
     decode_varint = "value.as_sint64()"
     encode_func = "encode_sint64"
 
+    max_value_size = 10
+    wire_type = 0
+    size_func = "add_sint64_field"
+
     def dump(self, name):
         o = f'sprintf(buffer, "%lld", {name});\n'
         o += f"out.append(buffer);"
@@ -530,6 +647,15 @@ class RepeatedTypeInfo(TypeInfo):
         o += f"}}"
         return o
 
+    max_size = None
+
+    @property
+    def size_content(self):
+        o = f"for (const auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{\n"
+        o += f"  {self._ti.get_size_calculation('it', True)}\n"
+        o += f"}}"
+        return o
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -570,16 +696,26 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    size = []
+    max_size = 0
     dump = []
 
+    # Received messages are handled before the receive buffer is reused, so their
+    # payloads aren't copied
+    source = get_opt(desc, pb.source, 0)
     for field in desc.field:
         if field.label == 3:
             ti = RepeatedTypeInfo(field)
+        elif field.type == 12 and source == SOURCE_CLIENT:
+            ti = BytesRefType(field)
         else:
             ti = TYPE_INFO[field.type](field)
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        size.append(ti.size_content)
+        if max_size is not None:
+            max_size = None if ti.max_size is None else max_size + ti.max_size
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -646,6 +782,22 @@ def build_message_type(desc):
     prot = "void encode(ProtoWriteBuffer buffer) const override;"
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{"
+    if size:
+        if len(size) == 1 and len(size[0]) + len(o) + 3 < 120:
+            o += f" {size[0]} "
+        else:
+            o += "\n"
+            o += indent("\n".join(size)) + "\n"
+    o += "}\n"
+    cpp += o
+    prot = "void calculate_size(uint32_t &total_size) const override;"
+    public_content.append(prot)
+    if max_size is not None:
+        # Messages without strings, repeated or nested fields can be encoded into a fixed buffer, e.g. on the stack
+        prot = f"static constexpr uint32_t MAX_ENCODED_SIZE = {max_size};"
+        public_content.insert(0, prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{"
     if dump:
         if len(dump) == 1 and len(dump[0]) + len(o) + 3 < 120:
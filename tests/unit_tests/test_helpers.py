@@ -267,3 +267,17 @@ def test_sanitize(text, expected):
     actual = helpers.sanitize(text)
 
     assert actual == expected
+
+
+@pytest.mark.parametrize(
+    "text, expected",
+    (
+        ("", 2166136261),
+        ("a", 84696446),
+        ("living_room_temperature", 1578816251),
+    ),
+)
+def test_fnv1_hash(text, expected):
+    actual = helpers.fnv1_hash(text)
+
+    assert actual == expected
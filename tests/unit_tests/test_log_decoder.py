@@ -0,0 +1,66 @@
+import base64
+import struct
+
+import pytest
+
+from esphome import log_decoder
+
+TAG_ADDR = 0x3F400010
+FORMAT_ADDR = 0x3F400020
+
+
+def _record(level, line, fmt_args=b""):
+    raw = struct.pack("<BHII", level, line, TAG_ADDR, FORMAT_ADDR) + fmt_args
+    return log_decoder.DEFERRED_MARKER + base64.b64encode(raw).decode()
+
+
+@pytest.mark.parametrize(
+    "fmt, args, expected",
+    (
+        ("Hello", b"", "Hello"),
+        ("%d%%", struct.pack("<i", -5), "-5%"),
+        ("%u %08X", struct.pack("<II", 4000000000, 0xBEEF), "4000000000 0000BEEF"),
+        ("%lld", struct.pack("<q", -(2**40)), str(-(2**40))),
+        ("%.2f", struct.pack("<d", 23.456), "23.46"),
+        ("'%s'", b"\x04Temp", "'Temp'"),
+        ("%*d|%.*s", struct.pack("<iii", 4, 7, 2) + b"\x02ab", "   7|ab"),
+        ("%c %hhu", struct.pack("<ii", ord("x"), 0x1FF), "x 255"),
+    ),
+)
+def test_decode_record(fmt, args, expected):
+    strings = {TAG_ADDR: "sensor", FORMAT_ADDR: fmt}
+
+    actual = log_decoder.decode_record(_record(5, 94, args), strings.get)
+
+    assert actual == f"\033[0;36m[D][sensor:094]: {expected}\033[0m"
+
+
+def test_decode_record__not_a_record():
+    assert log_decoder.decode_record("[D][sensor:094]: text", {}.get) is None
+
+
+def test_decode_record__unknown_address():
+    assert log_decoder.decode_record(_record(5, 1), {TAG_ADDR: "sensor"}.get) is None
+
+
+def test_decode_record__truncated():
+    strings = {TAG_ADDR: "sensor", FORMAT_ADDR: "%d"}
+
+    assert log_decoder.decode_record(_record(5, 1, b"\x01"), strings.get) is None
+
+
+def test_elf_image(tmp_path):
+    content = b"xx\0sensor\0"
+    # ELF header, one allocated PROGBITS section at 0x3F400000 and its contents
+    header = b"\x7fELF\x01\x01\x01" + b"\0" * 9
+    header += struct.pack("<HHIIIIIHHHHHH", 2, 94, 1, 0, 0, 52, 0, 52, 0, 0, 40, 1, 0)
+    section = struct.pack(
+        "<IIIIIIIIII", 0, 1, 0x2, 0x3F400000, 92, len(content), 0, 0, 1, 0
+    )
+    path = tmp_path / "firmware.elf"
+    path.write_bytes(header + section + content)
+
+    image = log_decoder.ElfImage(str(path))
+
+    assert image.read_string(0x3F400003) == "sensor"
+    assert image.read_string(0x3F500000) is None